@@ -225,6 +225,8 @@ let package = Package(
                     if useYams { defs.append(.define("OPENAPI_USE_YAMS")) }
                     // If system SDL3 is not available, compile in headless mode to avoid referencing SDL types.
                     if !hasSDL3 { defs.append(.define("HEADLESS_CI")) }
+                    // Compile CPU profiler zones out entirely.
+                    if envIsTruthy(env["SDLKIT_PROFILER_DISABLED"]) { defs.append(.define("SDLKIT_PROFILER_DISABLED")) }
                     return defs
                 }(),
                 linkerSettings: {
@@ -354,6 +356,20 @@ let package = Package(
             )
         )
 
+        // Loopback load generator for SDLKitNIO (per-endpoint throughput and latency as JSON)
+        targets.append(
+            .executableTarget(
+                name: "SDLKitLoad",
+                dependencies: [
+                    "SDLKit",
+                    .product(name: "NIOCore", package: "swift-nio"),
+                    .product(name: "NIOPosix", package: "swift-nio"),
+                    .product(name: "NIOHTTP1", package: "swift-nio")
+                ],
+                path: "Sources/SDLKitLoad"
+            )
+        )
+
         // Placeholder adapter that will conform to generated server interfaces and
         // delegate to SDLKitJSONAgent. Not required by default builds.
         targets.append(
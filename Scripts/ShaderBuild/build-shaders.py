@@ -6,6 +6,9 @@ import sys
 from pathlib import Path
 from typing import Optional
 
+sys.path.insert(0, str(Path(__file__).resolve().parent))
+from pack_shaders import write_archive  # noqa: E402
+
 MODULES = [
     {
         "name": "unlit_triangle",
@@ -424,6 +427,7 @@ def main() -> int:
 
     if not messages:
         messages.append("Shader compilation completed")
+    messages.append(write_archive(generated_root))
     write_summary(messages, output_dir)
     return 0
 
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Packs the generated shader artifacts into Generated/shaders.pack.
+
+The archive is what ShaderLibrary memory-maps at runtime (see ShaderArchive.swift):
+
+    header   "SDLS"  u32 version  u32 entryCount  u32 reserved
+    index    entryCount x { name[56] (UTF-8, NUL padded)  u64 offset  u64 length  u64 fnv1a64 }
+    blobs    raw artifact bytes, each starting 16-byte aligned
+
+All integers are little-endian; offsets are from the start of the file. Names are paths
+relative to Generated/, e.g. "spirv/basic_lit.vert.spv". An artifact is taken from the
+compiled file when it is at least as new as its committed .b64 payload, otherwise from the
+decoded payload. --from-payloads ignores compiled files, so the archive depends only on the
+committed payloads.
+"""
+import base64
+import struct
+import sys
+from pathlib import Path
+from typing import Optional
+
+MAGIC = b"SDLS"
+VERSION = 1
+HEADER_SIZE = 16
+NAME_SIZE = 56
+ENTRY_SIZE = NAME_SIZE + 24
+ALIGNMENT = 16
+ARCHIVE_NAME = "shaders.pack"
+ARTIFACT_DIRS = ("dxil", "spirv", "metal")
+ARTIFACT_SUFFIXES = (".dxil", ".spv", ".metallib")
+
+
+def fnv1a64(data: bytes) -> int:
+    value = 0xCBF29CE484222325
+    for byte in data:
+        value ^= byte
+        value = (value * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return value
+
+
+def read_artifact(path: Path, payloads_only: bool = False) -> Optional[bytes]:
+    encoded = path.with_name(path.name + ".b64")
+    compiled_is_current = path.exists() and (not encoded.exists() or path.stat().st_mtime >= encoded.stat().st_mtime)
+    if compiled_is_current and not payloads_only:
+        return path.read_bytes()
+    if encoded.exists():
+        return base64.b64decode("".join(encoded.read_text().split()))
+    return None
+
+
+def collect(generated_root: Path, payloads_only: bool = False) -> dict[str, bytes]:
+    artifacts: dict[str, bytes] = {}
+    for directory in ARTIFACT_DIRS:
+        root = generated_root / directory
+        if not root.is_dir():
+            continue
+        names = set()
+        for child in root.iterdir():
+            name = child.name[:-4] if child.name.endswith(".b64") else child.name
+            if name.endswith(ARTIFACT_SUFFIXES):
+                names.add(name)
+        for name in sorted(names):
+            data = read_artifact(root / name, payloads_only)
+            if data:
+                artifacts[f"{directory}/{name}"] = data
+    return artifacts
+
+
+def encode(artifacts: dict[str, bytes]) -> bytes:
+    def aligned(value: int) -> int:
+        return (value + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+
+    offset = aligned(HEADER_SIZE + ENTRY_SIZE * len(artifacts))
+    header = bytearray(struct.pack("<4sIII", MAGIC, VERSION, len(artifacts), 0))
+    blobs = bytearray()
+    for name, data in artifacts.items():
+        encoded_name = name.encode("utf-8")
+        if len(encoded_name) >= NAME_SIZE:
+            raise ValueError(f"shader artifact name too long for the archive index: {name}")
+        header += struct.pack(f"<{NAME_SIZE}sQQQ", encoded_name, offset, len(data), fnv1a64(data))
+        blobs += data
+        blobs += bytes(aligned(len(data)) - len(data))
+        offset += aligned(len(data))
+    header += bytes(aligned(len(header)) - len(header))
+    return bytes(header + blobs)
+
+
+def write_archive(generated_root: Path, payloads_only: bool = False) -> str:
+    """Writes the archive if its contents changed; returns a line for the build summary."""
+    artifacts = collect(generated_root, payloads_only)
+    archive_path = generated_root / ARCHIVE_NAME
+    if not artifacts:
+        return f"No shader artifacts under {generated_root}; {ARCHIVE_NAME} not written"
+    packed = encode(artifacts)
+    try:
+        if archive_path.exists() and archive_path.read_bytes() == packed:
+            return f"{ARCHIVE_NAME} up to date ({len(artifacts)} artifacts)"
+        temporary = archive_path.with_name(ARCHIVE_NAME + ".tmp")
+        temporary.write_bytes(packed)
+        temporary.replace(archive_path)
+    except OSError as error:
+        return f"Failed to write {archive_path}: {error}"
+    return f"Packed {len(artifacts)} shader artifacts into {archive_path} ({len(packed)} bytes)"
+
+
+def main() -> int:
+    args = sys.argv[1:]
+    payloads_only = "--from-payloads" in args
+    paths = [arg for arg in args if arg != "--from-payloads"]
+    if len(paths) != 1:
+        sys.stderr.write("Usage: pack_shaders.py [--from-payloads] <package-root>\n")
+        return 1
+    print(write_archive(Path(paths[0]) / "Sources" / "SDLKit" / "Generated", payloads_only))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -29,6 +29,7 @@ typedef struct SDLKit_Event {
   int32_t y;       // mouse position if applicable
   int32_t keycode; // platform keycode if applicable
   int32_t button;  // mouse button if applicable
+  uint32_t window_id; // SDL window id, 0 for application-wide events (quit)
 } SDLKit_Event;
 
 #if __has_include(<SDL3/SDL.h>)
@@ -78,6 +79,7 @@ typedef struct SDLKit_Event {
   static inline int SDLKit_SetWindowOpacity(void *window, float opacity) { return SDL_SetWindowOpacity((SDL_Window *)window, opacity) ? 0 : -1; }
   static inline int SDLKit_SetWindowAlwaysOnTop(void *window, int enabled) { return SDL_SetWindowAlwaysOnTop((SDL_Window *)window, enabled != 0) ? 0 : -1; }
   static inline void SDLKit_CenterWindow(void *window) { SDL_SetWindowPosition((SDL_Window *)window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED); }
+  static inline uint32_t SDLKit_GetWindowID(void *window) { return (uint32_t)SDL_GetWindowID((SDL_Window *)window); }
 
   // Clipboard
   static inline int SDLKit_SetClipboardText(const char *text) { return SDL_SetClipboardText(text); }
@@ -147,6 +149,45 @@ typedef struct SDLKit_Event {
   static inline int SDLKit_RenderLine(void *renderer, float x1, float y1, float x2, float y2) {
     return SDL_RenderLine((SDL_Renderer *)renderer, x1, y1, x2, y2) ? 0 : -1;
   }
+  // Connected polyline through `count` points.
+  static inline int SDLKit_RenderLines(void *renderer, const struct SDL_FPoint *points, int count) {
+    return SDL_RenderLines((SDL_Renderer *)renderer, points, count) ? 0 : -1;
+  }
+  // Vertices are interleaved x, y, r, g, b, a, u, v floats (the SDL_Vertex layout); colors in 0...1.
+  static inline int SDLKit_RenderGeometry(void *renderer, void *texture, const float *vertices, int num_vertices,
+                                          const int *indices, int num_indices) {
+    return SDL_RenderGeometry((SDL_Renderer *)renderer, (SDL_Texture *)texture, (const SDL_Vertex *)vertices, num_vertices,
+                              indices, num_indices) ? 0 : -1;
+  }
+  // Static RGBA32 texture with alpha blending enabled (atlases, uploaded pixel data).
+  static inline void *SDLKit_CreateTextureRGBA32(void *renderer, int w, int h) {
+    SDL_Texture *tex = SDL_CreateTexture((SDL_Renderer *)renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, w, h);
+    if (tex) { SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND); }
+    return (void *)tex;
+  }
+  static inline int SDLKit_UpdateTexture(void *tex, int x, int y, int w, int h, const void *pixels, int pitch) {
+    SDL_Rect r = { x, y, w, h };
+    return SDL_UpdateTexture((SDL_Texture *)tex, &r, pixels, pitch) ? 0 : -1;
+  }
+  static inline void SDLKit_GetSurfaceSize(void *surface, int *w, int *h) {
+    SDL_Surface *s = (SDL_Surface *)surface;
+    if (w) *w = s ? s->w : 0; if (h) *h = s ? s->h : 0;
+  }
+  // Copies a whole surface into a texture region at (x, y), converting to RGBA32 first if needed.
+  static inline int SDLKit_UpdateTextureFromSurface(void *tex, int x, int y, void *surface) {
+    SDL_Surface *src = (SDL_Surface *)surface;
+    if (!src) { return -1; }
+    SDL_Surface *conv = NULL;
+    if (src->format != SDL_PIXELFORMAT_RGBA32) {
+      conv = SDL_ConvertSurface(src, SDL_PIXELFORMAT_RGBA32);
+      if (!conv) { return -1; }
+      src = conv;
+    }
+    SDL_Rect r = { x, y, src->w, src->h };
+    bool ok = SDL_UpdateTexture((SDL_Texture *)tex, &r, src->pixels, src->pitch);
+    if (conv) SDL_DestroySurface(conv);
+    return ok ? 0 : -1;
+  }
   static inline void SDLKit_RenderPresent(void *renderer) { SDL_RenderPresent((SDL_Renderer *)renderer); }
   // Render state helpers
   static inline void SDLKit_GetRenderOutputSize(void *renderer, int *w, int *h) { SDL_GetRenderOutputSize((SDL_Renderer *)renderer, w, h); }
@@ -232,23 +273,29 @@ typedef struct SDLKit_Event {
     out->type = SDLKIT_EVENT_NONE;
     out->x = out->y = 0;
     out->keycode = out->button = 0;
+    out->window_id = 0;
     switch (ev->type) {
       case SDL_EVENT_QUIT:
         out->type = SDLKIT_EVENT_QUIT; break;
       case SDL_EVENT_WINDOW_CLOSE_REQUESTED:
-        out->type = SDLKIT_EVENT_WINDOW_CLOSED; break;
+        out->type = SDLKIT_EVENT_WINDOW_CLOSED;
+        out->window_id = (uint32_t)ev->window.windowID; break;
       case SDL_EVENT_KEY_DOWN:
         out->type = SDLKIT_EVENT_KEY_DOWN;
+        out->window_id = (uint32_t)ev->key.windowID;
         out->keycode = (int32_t)ev->key.key; break;
       case SDL_EVENT_KEY_UP:
         out->type = SDLKIT_EVENT_KEY_UP;
+        out->window_id = (uint32_t)ev->key.windowID;
         out->keycode = (int32_t)ev->key.key; break;
       case SDL_EVENT_MOUSE_MOTION:
         out->type = SDLKIT_EVENT_MOUSE_MOVE;
+        out->window_id = (uint32_t)ev->motion.windowID;
         out->x = (int32_t)ev->motion.x;
         out->y = (int32_t)ev->motion.y; break;
       case SDL_EVENT_MOUSE_BUTTON_DOWN:
         out->type = SDLKIT_EVENT_MOUSE_DOWN;
+        out->window_id = (uint32_t)ev->button.windowID;
         {
           float fx = 0.0f, fy = 0.0f; SDL_GetMouseState(&fx, &fy);
           out->x = (int32_t)fx; out->y = (int32_t)fy;
@@ -256,6 +303,7 @@ typedef struct SDLKit_Event {
         }
       case SDL_EVENT_MOUSE_BUTTON_UP:
         out->type = SDLKIT_EVENT_MOUSE_UP;
+        out->window_id = (uint32_t)ev->button.windowID;
         {
           float fx = 0.0f, fy = 0.0f; SDL_GetMouseState(&fx, &fy);
           out->x = (int32_t)fx; out->y = (int32_t)fy;
@@ -272,6 +320,16 @@ typedef struct SDLKit_Event {
   static inline int SDLKit_WaitEventTimeout(SDLKit_Event *out, int timeout_ms) {
     SDL_Event ev; if (!SDL_WaitEventTimeout(&ev, timeout_ms)) return 0; SDLKit__FillEvent(out, &ev); return 1;
   }
+  // Drains up to `max` pending events in one call, skipping kinds SDLKit does not normalize.
+  // Returns the number written to `out`; fewer than `max` means the queue is empty.
+  static inline int SDLKit_PollEvents(SDLKit_Event *out, int max) {
+    int count = 0; SDL_Event ev;
+    while (count < max && SDL_PollEvent(&ev)) {
+      SDLKit__FillEvent(&out[count], &ev);
+      if (out[count].type != SDLKIT_EVENT_NONE) { count++; }
+    }
+    return count;
+  }
 
   // Optional: SDL_ttf availability probe
   #if __has_include(<SDL3_ttf/SDL_ttf.h>)
@@ -287,6 +345,21 @@ typedef struct SDLKit_Event {
       size_t len = text ? strlen(text) : 0;
       return TTF_RenderText_Blended((TTF_Font *)font, text, len, c);
     }
+    // Per-glyph helpers for atlas text: a glyph renders into a surface one line tall with the
+    // pen at its left edge, so glyphs place like single-character strings.
+    static inline SDL_Surface *SDLKit_TTF_RenderGlyph_Blended(void *font, uint32_t ch,
+                                                              uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+      SDL_Color c = { r, g, b, a };
+      return TTF_RenderGlyph_Blended((TTF_Font *)font, ch, c);
+    }
+    static inline int SDLKit_TTF_GlyphAdvance(void *font, uint32_t ch, int *advance) {
+      return TTF_GetGlyphMetrics((TTF_Font *)font, ch, NULL, NULL, NULL, NULL, advance) ? 0 : -1;
+    }
+    static inline int SDLKit_TTF_GlyphKerning(void *font, uint32_t previous, uint32_t ch) {
+      int kerning = 0;
+      return TTF_GetGlyphKerning((TTF_Font *)font, previous, ch, &kerning) ? kerning : 0;
+    }
+    static inline int SDLKit_TTF_FontHeight(void *font) { return TTF_GetFontHeight((TTF_Font *)font); }
   static inline void *SDLKit_CreateTextureFromSurface(void *renderer, void *surface) {
       return (void *)SDL_CreateTextureFromSurface((SDL_Renderer *)renderer, (SDL_Surface *)surface);
     }
@@ -343,6 +416,15 @@ typedef struct SDLKit_Event {
                                                              uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
       (void)font; (void)text; (void)r; (void)g; (void)b; (void)a; return NULL;
     }
+    static inline SDL_Surface *SDLKit_TTF_RenderGlyph_Blended(void *font, uint32_t ch,
+                                                              uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+      (void)font; (void)ch; (void)r; (void)g; (void)b; (void)a; return NULL;
+    }
+    static inline int SDLKit_TTF_GlyphAdvance(void *font, uint32_t ch, int *advance) {
+      (void)font; (void)ch; if (advance) *advance = 0; return -1;
+    }
+    static inline int SDLKit_TTF_GlyphKerning(void *font, uint32_t previous, uint32_t ch) { (void)font; (void)previous; (void)ch; return 0; }
+    static inline int SDLKit_TTF_FontHeight(void *font) { (void)font; return 0; }
   #endif
   static inline void SDLKit_Quit(void) { SDL_Quit(); }
   // --- Audio (SDL3) ---
@@ -492,6 +574,7 @@ typedef struct SDLKit_Event {
   int SDLKit_SetWindowOpacity(SDL_Window *window, float opacity);
   int SDLKit_SetWindowAlwaysOnTop(SDL_Window *window, int enabled);
   void SDLKit_CenterWindow(SDL_Window *window);
+  uint32_t SDLKit_GetWindowID(SDL_Window *window);
   // Clipboard
   int SDLKit_SetClipboardText(const char *text);
   char *SDLKit_GetClipboardText(void);
@@ -511,6 +594,13 @@ typedef struct SDLKit_Event {
   int SDLKit_RenderRects(void *renderer, const struct SDL_FRect *rects, int count);
   int SDLKit_RenderPoints(void *renderer, const struct SDL_FPoint *points, int count);
   int SDLKit_RenderLine(void *renderer, float x1, float y1, float x2, float y2);
+  int SDLKit_RenderLines(void *renderer, const struct SDL_FPoint *points, int count);
+  int SDLKit_RenderGeometry(void *renderer, void *texture, const float *vertices, int num_vertices,
+                            const int *indices, int num_indices);
+  void *SDLKit_CreateTextureRGBA32(void *renderer, int w, int h);
+  int SDLKit_UpdateTexture(void *tex, int x, int y, int w, int h, const void *pixels, int pitch);
+  void SDLKit_GetSurfaceSize(void *surface, int *w, int *h);
+  int SDLKit_UpdateTextureFromSurface(void *tex, int x, int y, void *surface);
   void SDLKit_RenderPresent(void *renderer);
   void SDLKit_GetRenderOutputSize(void *renderer, int *w, int *h);
   void SDLKit_GetRenderScale(void *renderer, float *sx, float *sy);
@@ -523,6 +613,7 @@ typedef struct SDLKit_Event {
   void SDLKit_GetRenderClipRect(void *renderer, int *x, int *y, int *w, int *h);
   int SDLKit_PollEvent(SDLKit_Event *out);
   int SDLKit_WaitEventTimeout(SDLKit_Event *out, int timeout_ms);
+  int SDLKit_PollEvents(SDLKit_Event *out, int max);
   static inline int SDLKit_TTF_Available(void) { return 0; }
   int SDLKit_TTF_Init(void);
   SDLKit_TTF_Font *SDLKit_TTF_OpenFont(const char *path, int ptsize);
@@ -532,6 +623,11 @@ typedef struct SDLKit_Event {
   struct SDL_Texture;
   struct SDL_Surface *SDLKit_TTF_RenderUTF8_Blended(SDLKit_TTF_Font *font, const char *text,
                                              uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+  struct SDL_Surface *SDLKit_TTF_RenderGlyph_Blended(void *font, uint32_t ch,
+                                                     uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+  int SDLKit_TTF_GlyphAdvance(void *font, uint32_t ch, int *advance);
+  int SDLKit_TTF_GlyphKerning(void *font, uint32_t previous, uint32_t ch);
+  int SDLKit_TTF_FontHeight(void *font);
   void *SDLKit_CreateTextureFromSurface(void *renderer, void *surface);
   void SDLKit_DestroySurface(void *surface);
   void SDLKit_DestroyTexture(void *tex);
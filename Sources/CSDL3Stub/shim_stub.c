@@ -102,6 +102,11 @@ void SDLKit_CenterWindow(SDL_Window *window) {
     (void)window;
 }
 
+uint32_t SDLKit_GetWindowID(SDL_Window *window) {
+    (void)window;
+    return 0;
+}
+
 int SDLKit_SetClipboardText(const char *text) {
     (void)text;
     return -1;
@@ -178,11 +183,43 @@ int SDLKit_RenderPoints(void *renderer, const struct SDL_FPoint *points, int cou
     return -1;
 }
 
+int SDLKit_RenderGeometry(void *renderer, void *texture, const float *vertices, int num_vertices,
+                          const int *indices, int num_indices) {
+    (void)renderer; (void)texture; (void)vertices; (void)num_vertices; (void)indices; (void)num_indices;
+    return -1;
+}
+
+void *SDLKit_CreateTextureRGBA32(void *renderer, int w, int h) {
+    (void)renderer; (void)w; (void)h;
+    return NULL;
+}
+
+int SDLKit_UpdateTexture(void *tex, int x, int y, int w, int h, const void *pixels, int pitch) {
+    (void)tex; (void)x; (void)y; (void)w; (void)h; (void)pixels; (void)pitch;
+    return -1;
+}
+
+void SDLKit_GetSurfaceSize(void *surface, int *w, int *h) {
+    (void)surface;
+    if (w) { *w = 0; }
+    if (h) { *h = 0; }
+}
+
+int SDLKit_UpdateTextureFromSurface(void *tex, int x, int y, void *surface) {
+    (void)tex; (void)x; (void)y; (void)surface;
+    return -1;
+}
+
 int SDLKit_RenderLine(void *renderer, float x1, float y1, float x2, float y2) {
     (void)renderer; (void)x1; (void)y1; (void)x2; (void)y2;
     return -1;
 }
 
+int SDLKit_RenderLines(void *renderer, const struct SDL_FPoint *points, int count) {
+    (void)renderer; (void)points; (void)count;
+    return -1;
+}
+
 void SDLKit_RenderPresent(void *renderer) {
     (void)renderer;
 }
@@ -258,6 +295,11 @@ int SDLKit_WaitEventTimeout(SDLKit_Event *out, int timeout_ms) {
     return 0;
 }
 
+int SDLKit_PollEvents(SDLKit_Event *out, int max) {
+    (void)out; (void)max;
+    return 0;
+}
+
 int SDLKit_TTF_Init(void) {
     return -1;
 }
@@ -277,6 +319,28 @@ struct SDL_Surface *SDLKit_TTF_RenderUTF8_Blended(SDLKit_TTF_Font *font, const c
     return NULL;
 }
 
+struct SDL_Surface *SDLKit_TTF_RenderGlyph_Blended(void *font, uint32_t ch,
+                                                    uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    (void)font; (void)ch; (void)r; (void)g; (void)b; (void)a;
+    return NULL;
+}
+
+int SDLKit_TTF_GlyphAdvance(void *font, uint32_t ch, int *advance) {
+    (void)font; (void)ch;
+    if (advance) { *advance = 0; }
+    return -1;
+}
+
+int SDLKit_TTF_GlyphKerning(void *font, uint32_t previous, uint32_t ch) {
+    (void)font; (void)previous; (void)ch;
+    return 0;
+}
+
+int SDLKit_TTF_FontHeight(void *font) {
+    (void)font;
+    return 0;
+}
+
 void *SDLKit_CreateTextureFromSurface(void *renderer, void *surface) {
     (void)renderer; (void)surface;
     return NULL;
@@ -0,0 +1,110 @@
+import Foundation
+
+// Binary bodies for the bulk endpoints (`application/octet-stream`).
+//
+// Capture reads, mel feature reads, playback enqueues and screenshots carry sample or pixel
+// buffers that JSON would base64 (a third larger, plus an encode and decode of the whole
+// buffer). A client that sends `Accept: application/octet-stream` gets them as a short
+// prefix followed by the raw bytes; enqueue bodies in the same framing are recognized by
+// their magic, like `DrawBatch`. Errors are always JSON.
+//
+//     "SDLP"  u32 metadataLength (little-endian)  metadata  payload
+//
+// The metadata is the endpoint's JSON response (or request) minus its base64 field, padded
+// with spaces so the payload starts 4-byte aligned. Samples are little-endian f32;
+// screenshot pixels are the window's ABGR8888 rows, `pitch` bytes apart.
+
+public struct BinaryPayload: Sendable {
+    public static let contentType = "application/octet-stream"
+    public static let magic: [UInt8] = Array("SDLP".utf8)
+    public static let maxMetadataBytes = 1 << 16
+
+    public let metadata: Data
+    /// A slice of the decoded body; no bytes are copied.
+    public let payload: Data
+
+    public init(metadata: Data, payload: Data) {
+        self.metadata = metadata
+        self.payload = payload
+    }
+
+    public init<M: Encodable>(metadata: M, payload: Data) throws {
+        self.init(metadata: try JSONEncoder().encode(metadata), payload: payload)
+    }
+
+    /// Whether `data` is in this framing rather than JSON.
+    public static func isBinary(_ data: Data) -> Bool { data.starts(with: magic) }
+
+    /// Whether an `Accept` header value asks for binary bodies.
+    public static func accepts(_ accept: String?) -> Bool {
+        guard let accept else { return false }
+        return accept.split(separator: ",").contains {
+            $0.split(separator: ";").first?.trimmingCharacters(in: .whitespaces).lowercased() == contentType
+        }
+    }
+
+    public static func decode(_ data: Data) throws -> BinaryPayload {
+        guard isBinary(data), data.count >= 8 else { throw AgentError.invalidArgument("not a binary payload") }
+        let lengthBytes = data[(data.startIndex + 4)..<(data.startIndex + 8)]
+        let length = Int(lengthBytes.reversed().reduce(UInt32(0)) { $0 << 8 | UInt32($1) })
+        guard length <= maxMetadataBytes, length <= data.count - 8 else {
+            throw AgentError.invalidArgument("binary payload declares \(length) metadata bytes but has \(data.count - 8)")
+        }
+        let metaStart = data.startIndex + 8
+        return BinaryPayload(metadata: data[metaStart..<(metaStart + length)],
+                             payload: data[(metaStart + length)...])
+    }
+
+    public func decodeMetadata<M: Decodable>(_ type: M.Type) throws -> M {
+        try JSONDecoder().decode(type, from: metadata)
+    }
+
+    public func encoded() -> Data {
+        var out = Self.prefix(metadata: metadata)
+        out.append(payload)
+        return out
+    }
+
+    /// The magic, length and padded metadata; the payload follows directly. `length`, when
+    /// given, pads the whole prefix out to that many bytes so it can fill a reserved slot.
+    public static func prefix(metadata: Data, length: Int = 0) -> Data {
+        let padding = max((4 - (8 + metadata.count) % 4) % 4, length - 8 - metadata.count)
+        var out = Data(magic)
+        withUnsafeBytes(of: UInt32(metadata.count + padding).littleEndian) { out.append(contentsOf: $0) }
+        out.append(metadata)
+        out.append(contentsOf: repeatElement(UInt8(ascii: " "), count: padding))
+        return out
+    }
+
+    /// Calls `body` with the payload as f32 samples, in place when it is aligned.
+    public func withFloats<R>(_ body: (UnsafeBufferPointer<Float>) throws -> R) rethrows -> R {
+        try payload.withUnsafeBytes { raw in
+            let count = raw.count / MemoryLayout<Float>.size
+            if let base = raw.baseAddress, Int(bitPattern: base) % MemoryLayout<Float>.alignment == 0 {
+                return try body(UnsafeBufferPointer(start: base.assumingMemoryBound(to: Float.self), count: count))
+            }
+            var copy = [Float](repeating: 0, count: count)
+            _ = copy.withUnsafeMutableBytes { raw.copyBytes(to: $0) }
+            return try copy.withUnsafeBufferPointer(body)
+        }
+    }
+}
+
+/// A growable byte buffer that binary responses are written into directly, so sample data
+/// goes from ring memory to the transport's buffer without an intermediate copy. SDLKitNIO
+/// conforms `ByteBuffer`.
+public protocol BinaryPayloadSink {
+    /// Reserves `capacity` bytes, lets `body` fill a prefix of them and keeps the number of
+    /// bytes it returns.
+    mutating func append(capacity: Int, _ body: (UnsafeMutableRawBufferPointer) throws -> Int) rethrows
+}
+
+extension Data: BinaryPayloadSink {
+    public mutating func append(capacity: Int, _ body: (UnsafeMutableRawBufferPointer) throws -> Int) rethrows {
+        let start = count
+        count += capacity
+        var written = 0
+        defer { count = start + written }
+        written = try withUnsafeMutableBytes { try body(UnsafeMutableRawBufferPointer(rebasing: $0[start...])) }
+    }
+}
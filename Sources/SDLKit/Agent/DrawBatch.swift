@@ -0,0 +1,391 @@
+import Foundation
+
+// Batched 2D drawing for `/agent/gui/batch`.
+//
+// A batch is an ordered list of draw commands for one window, executed in a single main
+// actor hop with one present at the end. Decoding and coalescing are pure and run wherever
+// the request arrives (the NIO event loop, for SDLKitNIO); consecutive same-color rects,
+// points and lines merge into one `SDLKit_RenderFillRects` / `RenderRects` / `RenderPoints`
+// call, and connected same-color segments into one `SDLKit_RenderLines` polyline.
+//
+// Compact JSON — commands are arrays, colors ARGB numbers or color strings:
+//
+//     { "window_id": 1, "present": true, "commands": [
+//         ["clear", color], ["rect", x, y, w, h, color], ["stroke_rect", x, y, w, h, color],
+//         ["line", x1, y1, x2, y2, color], ["point", x, y, color], ["circle", cx, cy, r, color],
+//         ["texture", id, x, y, w?, h?], ["text", string, x, y, color?, size?, font?] ] }
+//
+// Binary (`DrawBatch.magic` first), little-endian:
+//
+//     "SDLB"  u32 windowId  u8 flags (bit 0: present)  u32 commandCount, then per command
+//     u8 opcode and its fields: i32 coordinates, u32 ARGB colors, strings as u16 length +
+//     UTF-8. Opcodes follow `Command.Opcode`; texture sizes < 0 and text size <= 0 mean
+//     "natural" / default.
+
+public struct DrawBatch: Sendable {
+    public enum Command: Sendable, Equatable {
+        case clear(color: UInt32)
+        case fillRect(x: Int, y: Int, width: Int, height: Int, color: UInt32)
+        case strokeRect(x: Int, y: Int, width: Int, height: Int, color: UInt32)
+        case line(x1: Int, y1: Int, x2: Int, y2: Int, color: UInt32)
+        case point(x: Int, y: Int, color: UInt32)
+        case circle(cx: Int, cy: Int, radius: Int, color: UInt32)
+        case texture(id: String, x: Int, y: Int, width: Int?, height: Int?)
+        case text(String, x: Int, y: Int, color: UInt32, size: Int?, font: String?)
+
+        public enum Opcode: UInt8, Sendable {
+            case clear = 1, fillRect, strokeRect, line, point, circle, texture, text
+        }
+    }
+
+    public struct Point: Sendable, Equatable {
+        public let x: Float
+        public let y: Float
+    }
+
+    public struct Rect: Sendable, Equatable {
+        public let x: Float
+        public let y: Float
+        public let width: Float
+        public let height: Float
+    }
+
+    /// What the renderer executes: one call (or one color change) per op.
+    public enum Op: Sendable, Equatable {
+        case clear(UInt32)
+        case fillRects(UInt32, [Rect])
+        case strokeRects(UInt32, [Rect])
+        case points(UInt32, [Point])
+        /// Polylines of one color; each is a single `RenderLines` call.
+        case lines(UInt32, [[Point]])
+        case texture(id: String, x: Int, y: Int, width: Int?, height: Int?)
+        case text(String, x: Int, y: Int, color: UInt32, size: Int?, font: String?)
+    }
+
+    public static let magic: [UInt8] = Array("SDLB".utf8)
+    /// Upper bound on commands per batch, so one request cannot monopolize the main thread.
+    public static let maxCommands = 1 << 16
+    /// Largest render target a batch draws into. Circles are rasterized into spans while
+    /// decoding, so radii are capped at this and spans outside it are dropped.
+    public static let maxTargetExtent = 16384
+    /// Upper bound on rects, points and line segments a batch coalesces into. A circle
+    /// emits one span per visible row, so the command cap alone does not bound the work.
+    public static let maxPrimitives = 1 << 20
+
+    public let windowId: Int
+    public let present: Bool
+    public let commands: [Command]
+    public let ops: [Op]
+
+    public init(windowId: Int, commands: [Command], present: Bool = true) throws {
+        guard commands.count <= Self.maxCommands else {
+            throw AgentError.invalidArgument("batch has \(commands.count) commands (max \(Self.maxCommands))")
+        }
+        self.windowId = windowId
+        self.present = present
+        self.commands = commands
+        self.ops = try Self.coalesce(commands)
+    }
+
+    /// Decodes either encoding; binary bodies are recognised by `magic`.
+    public static func decode(_ data: Data) throws -> DrawBatch {
+        let profile = SDLProfiler.begin("batch.decode", detail: "\(data.count) bytes")
+        defer { profile.end() }
+        if data.starts(with: magic) { return try decodeBinary(data) }
+        return try decodeJSON(data)
+    }
+
+    // MARK: - Coalescing
+
+    static func coalesce(_ commands: [Command]) throws -> [Op] {
+        // Counted before anything is emitted, so an oversized batch allocates nothing.
+        var primitives = 0
+        for command in commands {
+            if case let .circle(cx, cy, radius, _) = command {
+                try checkRadius(radius)
+                primitives += circleRows(cx: cx, cy: cy, radius: radius)?.count ?? 0
+            } else {
+                primitives += 1
+            }
+            guard primitives <= maxPrimitives else {
+                throw AgentError.invalidArgument("batch expands to more than \(maxPrimitives) primitives")
+            }
+        }
+        var ops: [Op] = []
+        ops.reserveCapacity(commands.count)
+        for command in commands {
+            switch command {
+            case .clear(let color):
+                ops.append(.clear(color))
+            case let .fillRect(x, y, w, h, color):
+                appendRect(Rect(x: Float(x), y: Float(y), width: Float(w), height: Float(h)), color: color, filled: true, to: &ops)
+            case let .strokeRect(x, y, w, h, color):
+                appendRect(Rect(x: Float(x), y: Float(y), width: Float(w), height: Float(h)), color: color, filled: false, to: &ops)
+            case let .point(x, y, color):
+                if case .points(color, var points)? = ops.last {
+                    ops.removeLast()
+                    points.append(Point(x: Float(x), y: Float(y)))
+                    ops.append(.points(color, points))
+                } else {
+                    ops.append(.points(color, [Point(x: Float(x), y: Float(y))]))
+                }
+            case let .line(x1, y1, x2, y2, color):
+                let start = Point(x: Float(x1), y: Float(y1)), end = Point(x: Float(x2), y: Float(y2))
+                if case .lines(color, var polylines)? = ops.last {
+                    ops.removeLast()
+                    if polylines[polylines.count - 1].last == start {
+                        polylines[polylines.count - 1].append(end)
+                    } else {
+                        polylines.append([start, end])
+                    }
+                    ops.append(.lines(color, polylines))
+                } else {
+                    ops.append(.lines(color, [[start, end]]))
+                }
+            case let .circle(cx, cy, radius, color):
+                for span in circleSpans(cx: cx, cy: cy, radius: radius) {
+                    appendRect(span, color: color, filled: true, to: &ops)
+                }
+            case let .texture(id, x, y, w, h):
+                ops.append(.texture(id: id, x: x, y: y, width: w, height: h))
+            case let .text(text, x, y, color, size, font):
+                ops.append(.text(text, x: x, y: y, color: color, size: size, font: font))
+            }
+        }
+        return ops
+    }
+
+    private static func appendRect(_ rect: Rect, color: UInt32, filled: Bool, to ops: inout [Op]) {
+        switch ops.last {
+        case .fillRects(color, var rects)? where filled:
+            ops.removeLast()
+            rects.append(rect)
+            ops.append(.fillRects(color, rects))
+        case .strokeRects(color, var rects)? where !filled:
+            ops.removeLast()
+            rects.append(rect)
+            ops.append(.strokeRects(color, rects))
+        default:
+            ops.append(filled ? .fillRects(color, [rect]) : .strokeRects(color, [rect]))
+        }
+    }
+
+    static func checkRadius(_ radius: Int, context: String = "circle") throws {
+        guard (0...maxTargetExtent).contains(radius) else {
+            throw AgentError.invalidArgument("\(context): radius must be in 0...\(maxTargetExtent)")
+        }
+    }
+
+    /// One horizontal span per row of a filled circle, so blended colors cover each pixel once.
+    /// Spans are clipped to `0..<maxTargetExtent` on both axes; `radius` must pass `checkRadius`.
+    static func circleSpans(cx: Int, cy: Int, radius: Int) -> [Rect] {
+        guard let rows = circleRows(cx: cx, cy: cy, radius: radius) else { return [] }
+        let cx = clampCenter(cx), cy = clampCenter(cy)
+        var spans: [Rect] = []
+        spans.reserveCapacity(rows.count)
+        for y in rows {
+            let dy = y - cy
+            let half = Int(Double(radius * radius - dy * dy).squareRoot())
+            let left = max(cx - half, 0), right = min(cx + half, maxTargetExtent - 1)
+            guard left <= right else { continue }
+            spans.append(Rect(x: Float(left), y: Float(y), width: Float(right - left + 1), height: 1))
+        }
+        return spans
+    }
+
+    /// The target rows a circle covers: an upper bound on its span count.
+    static func circleRows(cx: Int, cy: Int, radius: Int) -> ClosedRange<Int>? {
+        let cy = clampCenter(cy)
+        let top = max(cy - radius, 0), bottom = min(cy + radius, maxTargetExtent - 1)
+        return top <= bottom ? top...bottom : nil
+    }
+
+    // Centers this far out only produce spans off the target; clamping keeps the math in range.
+    private static func clampCenter(_ c: Int) -> Int {
+        let reach = 2 * maxTargetExtent
+        return min(max(c, -reach), reach)
+    }
+
+    // MARK: - Compact JSON
+
+    private static func decodeJSON(_ data: Data) throws -> DrawBatch {
+        guard let root = (try? JSONSerialization.jsonObject(with: data)) as? [String: Any] else {
+            throw AgentError.invalidArgument("batch body must be a JSON object or binary SDLB")
+        }
+        guard let windowId = int(root["window_id"]) else { throw AgentError.invalidArgument("window_id is required") }
+        guard let list = root["commands"] as? [Any] else { throw AgentError.invalidArgument("commands must be an array") }
+        guard list.count <= maxCommands else {
+            throw AgentError.invalidArgument("batch has \(list.count) commands (max \(maxCommands))")
+        }
+        var commands: [Command] = []
+        commands.reserveCapacity(list.count)
+        for (index, entry) in list.enumerated() {
+            guard let fields = entry as? [Any], let name = fields.first as? String else {
+                throw AgentError.invalidArgument("command \(index) must be an array starting with its name")
+            }
+            let args = Array(fields.dropFirst())
+            func i(_ n: Int) throws -> Int {
+                guard n < args.count, let value = int(args[n]) else { throw AgentError.invalidArgument("command \(index) (\(name)): argument \(n + 1) must be an integer") }
+                return value
+            }
+            func optionalInt(_ n: Int) -> Int? { n < args.count ? int(args[n]) : nil }
+            func color(_ n: Int, default fallback: UInt32? = nil) throws -> UInt32 {
+                if n >= args.count || args[n] is NSNull, let fallback { return fallback }
+                if n < args.count, let text = args[n] as? String { return try SDLColor.parse(text) }
+                if n < args.count, let value = int(args[n]), (0...Int(UInt32.max)).contains(value) { return UInt32(value) }
+                throw AgentError.invalidArgument("command \(index) (\(name)): argument \(n + 1) must be a color")
+            }
+            func string(_ n: Int) throws -> String {
+                guard n < args.count, let value = args[n] as? String else { throw AgentError.invalidArgument("command \(index) (\(name)): argument \(n + 1) must be a string") }
+                return value
+            }
+            switch name {
+            case "clear": commands.append(.clear(color: try color(0)))
+            case "rect": commands.append(.fillRect(x: try i(0), y: try i(1), width: try i(2), height: try i(3), color: try color(4)))
+            case "stroke_rect": commands.append(.strokeRect(x: try i(0), y: try i(1), width: try i(2), height: try i(3), color: try color(4)))
+            case "line": commands.append(.line(x1: try i(0), y1: try i(1), x2: try i(2), y2: try i(3), color: try color(4)))
+            case "point": commands.append(.point(x: try i(0), y: try i(1), color: try color(2)))
+            case "circle":
+                let radius = try i(2)
+                try checkRadius(radius, context: "command \(index) (circle)")
+                commands.append(.circle(cx: try i(0), cy: try i(1), radius: radius, color: try color(3)))
+            case "texture": commands.append(.texture(id: try string(0), x: try i(1), y: try i(2), width: optionalInt(3), height: optionalInt(4)))
+            case "text":
+                let font = args.count > 5 ? args[5] as? String : nil
+                commands.append(.text(try string(0), x: try i(1), y: try i(2), color: try color(3, default: 0xFFFFFFFF), size: optionalInt(4), font: font))
+            default:
+                throw AgentError.invalidArgument("command \(index): unknown command '\(name)'")
+            }
+        }
+        let present = root["present"] as? Bool ?? true
+        return try DrawBatch(windowId: windowId, commands: commands, present: present)
+    }
+
+    private static func int(_ value: Any?) -> Int? {
+        switch value {
+        case let v as Int: return v
+        case let v as Double where v.rounded() == v && abs(v) < 1e15: return Int(v)
+        case let v as NSNumber: return v.intValue
+        default: return nil
+        }
+    }
+
+    // MARK: - Binary
+
+    /// The binary encoding of this batch's commands.
+    public func encoded() -> Data {
+        var out = Data(Self.magic)
+        out.appendLittleEndian(UInt32(truncatingIfNeeded: windowId))
+        out.append(present ? 1 : 0)
+        out.appendLittleEndian(UInt32(commands.count))
+        for command in commands {
+            switch command {
+            case .clear(let color):
+                out.append(Command.Opcode.clear.rawValue); out.appendLittleEndian(color)
+            case let .fillRect(x, y, w, h, color):
+                out.append(Command.Opcode.fillRect.rawValue); out.appendInt32s([x, y, w, h]); out.appendLittleEndian(color)
+            case let .strokeRect(x, y, w, h, color):
+                out.append(Command.Opcode.strokeRect.rawValue); out.appendInt32s([x, y, w, h]); out.appendLittleEndian(color)
+            case let .line(x1, y1, x2, y2, color):
+                out.append(Command.Opcode.line.rawValue); out.appendInt32s([x1, y1, x2, y2]); out.appendLittleEndian(color)
+            case let .point(x, y, color):
+                out.append(Command.Opcode.point.rawValue); out.appendInt32s([x, y]); out.appendLittleEndian(color)
+            case let .circle(cx, cy, r, color):
+                out.append(Command.Opcode.circle.rawValue); out.appendInt32s([cx, cy, r]); out.appendLittleEndian(color)
+            case let .texture(id, x, y, w, h):
+                out.append(Command.Opcode.texture.rawValue); out.appendString(id); out.appendInt32s([x, y, w ?? -1, h ?? -1])
+            case let .text(text, x, y, color, size, _):
+                out.append(Command.Opcode.text.rawValue); out.appendString(text); out.appendInt32s([x, y])
+                out.appendLittleEndian(color); out.appendInt32s([size ?? 0])
+            }
+        }
+        return out
+    }
+
+    private static func decodeBinary(_ data: Data) throws -> DrawBatch {
+        var reader = ByteReader(bytes: [UInt8](data))
+        reader.offset = magic.count
+        let windowId = Int(try reader.u32())
+        let flags = try reader.u8()
+        let count = Int(try reader.u32())
+        // Every command is at least 5 bytes; reject counts the body cannot hold before allocating.
+        guard count <= maxCommands, count * 5 <= reader.remaining else {
+            throw AgentError.invalidArgument("batch declares \(count) commands but has \(reader.remaining) bytes")
+        }
+        var commands: [Command] = []
+        commands.reserveCapacity(count)
+        for index in 0..<count {
+            let raw = try reader.u8()
+            guard let opcode = Command.Opcode(rawValue: raw) else {
+                throw AgentError.invalidArgument("command \(index): unknown opcode \(raw)")
+            }
+            switch opcode {
+            case .clear:
+                commands.append(.clear(color: try reader.u32()))
+            case .fillRect:
+                commands.append(.fillRect(x: try reader.i32(), y: try reader.i32(), width: try reader.i32(), height: try reader.i32(), color: try reader.u32()))
+            case .strokeRect:
+                commands.append(.strokeRect(x: try reader.i32(), y: try reader.i32(), width: try reader.i32(), height: try reader.i32(), color: try reader.u32()))
+            case .line:
+                commands.append(.line(x1: try reader.i32(), y1: try reader.i32(), x2: try reader.i32(), y2: try reader.i32(), color: try reader.u32()))
+            case .point:
+                commands.append(.point(x: try reader.i32(), y: try reader.i32(), color: try reader.u32()))
+            case .circle:
+                let cx = try reader.i32(), cy = try reader.i32(), radius = try reader.i32()
+                try checkRadius(radius, context: "command \(index) (circle)")
+                commands.append(.circle(cx: cx, cy: cy, radius: radius, color: try reader.u32()))
+            case .texture:
+                let id = try reader.string()
+                let x = try reader.i32(), y = try reader.i32(), w = try reader.i32(), h = try reader.i32()
+                commands.append(.texture(id: id, x: x, y: y, width: w < 0 ? nil : w, height: h < 0 ? nil : h))
+            case .text:
+                let text = try reader.string()
+                let x = try reader.i32(), y = try reader.i32(), color = try reader.u32(), size = try reader.i32()
+                commands.append(.text(text, x: x, y: y, color: color, size: size > 0 ? size : nil, font: nil))
+            }
+        }
+        return try DrawBatch(windowId: windowId, commands: commands, present: flags & 1 != 0)
+    }
+
+    private struct ByteReader {
+        let bytes: [UInt8]
+        var offset = 0
+
+        var remaining: Int { bytes.count - offset }
+
+        mutating func take(_ n: Int) throws -> ArraySlice<UInt8> {
+            guard n <= remaining else { throw AgentError.invalidArgument("batch truncated at byte \(offset)") }
+            defer { offset += n }
+            return bytes[offset..<(offset + n)]
+        }
+
+        mutating func u8() throws -> UInt8 { try take(1).reduce(0) { $1 } }
+
+        mutating func u32() throws -> UInt32 {
+            try take(4).reversed().reduce(0) { $0 << 8 | UInt32($1) }
+        }
+
+        mutating func i32() throws -> Int { Int(Int32(bitPattern: try u32())) }
+
+        mutating func string() throws -> String {
+            let length = try take(2).reversed().reduce(0) { $0 << 8 | Int($1) }
+            return String(decoding: try take(length), as: UTF8.self)
+        }
+    }
+}
+
+private extension Data {
+    mutating func appendLittleEndian<T: FixedWidthInteger>(_ value: T) {
+        withUnsafeBytes(of: value.littleEndian) { append(contentsOf: $0) }
+    }
+
+    mutating func appendInt32s(_ values: [Int]) {
+        for value in values { appendLittleEndian(Int32(truncatingIfNeeded: value)) }
+    }
+
+    mutating func appendString(_ value: String) {
+        let utf8 = Array(value.utf8.prefix(Int(UInt16.max)))
+        appendLittleEndian(UInt16(utf8.count))
+        append(contentsOf: utf8)
+    }
+}
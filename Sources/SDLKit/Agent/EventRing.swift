@@ -0,0 +1,66 @@
+import Foundation
+
+/// One window's input events, numbered by a cursor that only moves forward.
+///
+/// `SDLKitGUIAgent.pumpEvents()` drains SDL's queue into these rings, so a reader takes
+/// everything that arrived since its cursor in one call. A mouse move that directly follows
+/// another replaces it under a new cursor: a reader that falls behind on motion gets the latest
+/// position, not every intermediate one. When the ring is full the oldest event is evicted.
+struct AgentEventRing {
+    struct Batch: Equatable {
+        var events: [SDLKitGUIAgent.Event]
+        /// Pass back as `since` to continue after the last returned event.
+        var cursor: UInt64
+        /// Events after `since` were evicted before this read.
+        var gap: Bool
+    }
+
+    static let defaultCapacity = 1024
+
+    let capacity: Int
+    private var storage: [(cursor: UInt64, event: SDLKitGUIAgent.Event)] = []
+    /// Index of the oldest entry once `storage` is full.
+    private var head = 0
+    private var evictedThrough: UInt64 = 0
+    private(set) var lastCursor: UInt64 = 0
+    private(set) var coalescedMoves = 0
+
+    init(capacity: Int = defaultCapacity) {
+        self.capacity = max(1, capacity)
+    }
+
+    var count: Int { storage.count }
+
+    mutating func append(_ event: SDLKitGUIAgent.Event) {
+        lastCursor += 1
+        if event.type == .mouseMove, !storage.isEmpty {
+            let last = (head + storage.count - 1) % storage.count
+            if storage[last].event.type == .mouseMove {
+                storage[last] = (lastCursor, event)
+                coalescedMoves += 1
+                return
+            }
+        }
+        if storage.count < capacity {
+            storage.append((lastCursor, event))
+        } else {
+            evictedThrough = storage[head].cursor
+            storage[head] = (lastCursor, event)
+            head = (head + 1) % capacity
+        }
+    }
+
+    /// Up to `limit` events newer than `since`, oldest first.
+    func events(since cursor: UInt64, limit: Int = .max) -> Batch {
+        var events: [SDLKitGUIAgent.Event] = []
+        var next = lastCursor
+        for offset in 0..<storage.count {
+            let entry = storage[(head + offset) % storage.count]
+            guard entry.cursor > cursor else { continue }
+            guard events.count < limit else { break }
+            events.append(entry.event)
+            next = entry.cursor
+        }
+        return Batch(events: events, cursor: next, gap: cursor < evictedThrough)
+    }
+}
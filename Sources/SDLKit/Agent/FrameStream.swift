@@ -0,0 +1,248 @@
+import Foundation
+
+// Continuous frame streaming for remote monitoring.
+//
+// A `FrameStreamSession` captures a window at a target rate and `FrameDeltaEncoder` diffs
+// each capture against the last frame it sent, tile by tile, so only tiles that changed go
+// on the wire (raw RGBA8, or PNG when that is smaller). Frames without changes produce no
+// message at all. The transport — a persistent SDLKitNIO connection — decides when to ask
+// for the next message and skips frames while the previous one is still being written, so
+// slow clients see a lower frame rate rather than a growing queue.
+//
+// Wire format, little-endian, one message per frame:
+//
+//     "SDLF"  u32 byteCount (of everything after this field)
+//     u32 sequence   u32 droppedFrames (skipped since the previous message)
+//     u32 width      u32 height      u8 flags (bit 0: keyframe)   u8 reserved
+//     u32 tileCount, then per tile:
+//         u16 x  u16 y  u16 width  u16 height  u8 encoding (0 raw RGBA8, 1 PNG)  u32 byteCount  bytes
+//
+// Raw tiles are tightly packed rows of `width * 4` bytes. A keyframe covers every tile and is
+// sent first and whenever the window size changes.
+
+public struct FrameDeltaEncoder {
+    public enum TileEncoding: UInt8, Sendable {
+        case raw = 0
+        case png = 1
+    }
+
+    public struct Tile: Sendable {
+        public let x: Int
+        public let y: Int
+        public let width: Int
+        public let height: Int
+        public let encoding: TileEncoding
+        public let payload: Data
+    }
+
+    public struct Delta: Sendable {
+        public let sequence: UInt32
+        public let width: Int
+        public let height: Int
+        public let isKeyframe: Bool
+        public let tiles: [Tile]
+
+        /// The message as it goes on the wire.
+        public func serialized(droppedFrames: Int = 0) -> Data {
+            var body = Data()
+            body.reserveCapacity(24 + tiles.reduce(0) { $0 + 13 + $1.payload.count })
+            body.appendLittleEndian(sequence)
+            body.appendLittleEndian(UInt32(clamping: droppedFrames))
+            body.appendLittleEndian(UInt32(width))
+            body.appendLittleEndian(UInt32(height))
+            body.append(contentsOf: [isKeyframe ? 1 : 0, 0])
+            body.appendLittleEndian(UInt32(tiles.count))
+            for tile in tiles {
+                body.appendLittleEndian(UInt16(tile.x))
+                body.appendLittleEndian(UInt16(tile.y))
+                body.appendLittleEndian(UInt16(tile.width))
+                body.appendLittleEndian(UInt16(tile.height))
+                body.append(tile.encoding.rawValue)
+                body.appendLittleEndian(UInt32(tile.payload.count))
+                body.append(tile.payload)
+            }
+            var message = Data(FrameDeltaEncoder.magic)
+            message.appendLittleEndian(UInt32(body.count))
+            message.append(body)
+            return message
+        }
+    }
+
+    public static let magic: [UInt8] = Array("SDLF".utf8)
+
+    public let tileSize: Int
+    public let encoding: TileEncoding
+    private var previous: [UInt8] = []
+    private var width = 0
+    private var height = 0
+    private var sequence: UInt32 = 0
+
+    public init(tileSize: Int = 64, encoding: TileEncoding = .png) {
+        self.tileSize = max(8, min(tileSize, 1024))
+        self.encoding = encoding
+    }
+
+    /// Forgets the reference frame; the next `encode` produces a keyframe.
+    public mutating func reset() {
+        previous = []
+    }
+
+    /// Diffs an RGBA8 frame against the last one encoded. Returns nil when nothing changed;
+    /// otherwise the changed tiles, which also become the new reference. Tile bands are
+    /// compared and encoded in parallel.
+    public mutating func encode(pixels: UnsafeRawBufferPointer, width: Int, height: Int, bytesPerRow: Int) throws -> Delta? {
+        let profile = SDLProfiler.begin("stream.delta", detail: "\(width)x\(height)")
+        defer { profile.end() }
+        guard width > 0, height > 0, width <= Int(UInt16.max), height <= Int(UInt16.max) else {
+            throw AgentError.invalidArgument("Frame size \(width)x\(height) is out of range for streaming")
+        }
+        guard bytesPerRow >= width * 4, pixels.count >= bytesPerRow * (height - 1) + width * 4,
+              let source = pixels.baseAddress else {
+            throw AgentError.invalidArgument("Pixel buffer too small for \(width)x\(height) with \(bytesPerRow) bytes per row")
+        }
+
+        let isKeyframe = previous.isEmpty || width != self.width || height != self.height
+        if isKeyframe {
+            previous = [UInt8](repeating: 0, count: width * height * 4)
+            self.width = width
+            self.height = height
+        }
+        let tileSize = self.tileSize
+        let encoding = self.encoding
+        let tilesX = (width + tileSize - 1) / tileSize
+        let tilesY = (height + tileSize - 1) / tileSize
+        var bands = [[Tile]](repeating: [], count: tilesY)
+        previous.withUnsafeMutableBytes { reference in
+            guard let referenceBase = reference.baseAddress else { return }
+            bands.withUnsafeMutableBufferPointer { buffer in
+                let out = buffer
+                DispatchQueue.concurrentPerform(iterations: tilesY) { ty in
+                    var tiles: [Tile] = []
+                    for tx in 0..<tilesX {
+                        let x0 = tx * tileSize, y0 = ty * tileSize
+                        let w = min(tileSize, width - x0), h = min(tileSize, height - y0)
+                        let rowBytes = w * 4
+                        var dirty = isKeyframe
+                        var row = 0
+                        while !dirty && row < h {
+                            dirty = memcmp(source + (y0 + row) * bytesPerRow + x0 * 4,
+                                           referenceBase + ((y0 + row) * width + x0) * 4, rowBytes) != 0
+                            row += 1
+                        }
+                        guard dirty else { continue }
+                        var texels = Data(count: rowBytes * h)
+                        texels.withUnsafeMutableBytes { tile in
+                            for row in 0..<h {
+                                let src = source + (y0 + row) * bytesPerRow + x0 * 4
+                                (tile.baseAddress! + row * rowBytes).copyMemory(from: src, byteCount: rowBytes)
+                                (referenceBase + ((y0 + row) * width + x0) * 4).copyMemory(from: src, byteCount: rowBytes)
+                            }
+                        }
+                        tiles.append(Self.encodeTile(texels, x: x0, y: y0, width: w, height: h, encoding: encoding))
+                    }
+                    out[ty] = tiles
+                }
+            }
+        }
+
+        let tiles = bands.flatMap { $0 }
+        guard isKeyframe || !tiles.isEmpty else { return nil }
+        sequence &+= 1
+        return Delta(sequence: sequence, width: width, height: height, isKeyframe: isKeyframe, tiles: tiles)
+    }
+
+    private static func encodeTile(_ texels: Data, x: Int, y: Int, width: Int, height: Int, encoding: TileEncoding) -> Tile {
+        if encoding == .png,
+           let png = try? texels.withUnsafeBytes({
+               try PNGEncoder.encode(width: width, height: height, bytesPerRow: width * 4, layout: .rgba8Unorm, pixels: $0)
+           }),
+           png.count < texels.count {
+            return Tile(x: x, y: y, width: width, height: height, encoding: .png, payload: png)
+        }
+        return Tile(x: x, y: y, width: width, height: height, encoding: .raw, payload: texels)
+    }
+}
+
+/// Stream parameters, as posted to `/agent/gui/stream/frames`.
+public struct FrameStreamRequest: Codable, Sendable {
+    public var window_id: Int
+    /// Target capture rate; defaults to 10.
+    public var fps: Double?
+    /// Tile edge in pixels; defaults to 64.
+    public var tile_size: Int?
+    /// "png" (default) or "raw".
+    public var encoding: String?
+
+    public init(window_id: Int, fps: Double? = nil, tile_size: Int? = nil, encoding: String? = nil) {
+        self.window_id = window_id
+        self.fps = fps
+        self.tile_size = tile_size
+        self.encoding = encoding
+    }
+}
+
+/// One window's frame stream. The first frame is captured when the session opens, so a
+/// missing window or renderer fails before the transport commits to a streaming response.
+@MainActor
+public final class FrameStreamSession {
+    public let windowId: Int
+    /// Seconds between captures.
+    public let interval: Double
+    public private(set) var messagesSent = 0
+
+    private let agent: SDLKitGUIAgent
+    private var encoder: FrameDeltaEncoder
+    private var pending: FrameDeltaEncoder.Delta?
+
+    public init(agent: SDLKitGUIAgent, request: FrameStreamRequest) throws {
+        let fps = request.fps ?? 10
+        guard fps > 0, fps <= 120 else { throw AgentError.invalidArgument("fps must be in (0, 120]") }
+        let encoding: FrameDeltaEncoder.TileEncoding
+        switch request.encoding?.lowercased() ?? "png" {
+        case "png": encoding = .png
+        case "raw": encoding = .raw
+        case let other: throw AgentError.invalidArgument("Unknown frame encoding '\(other)' (expected png or raw)")
+        }
+        let tileSize = request.tile_size ?? 64
+        guard (8...1024).contains(tileSize) else { throw AgentError.invalidArgument("tile_size must be in 8...1024") }
+        self.agent = agent
+        self.windowId = request.window_id
+        self.interval = 1 / fps
+        self.encoder = FrameDeltaEncoder(tileSize: tileSize, encoding: encoding)
+        self.pending = try captureDelta()
+    }
+
+    /// Captures the window and returns the next message, or nil when nothing changed since
+    /// the last one. `droppedFrames` is reported to the client in the message header.
+    public func nextMessage(droppedFrames: Int = 0) throws -> Data? {
+        let delta: FrameDeltaEncoder.Delta?
+        if let pending {
+            delta = pending
+            self.pending = nil
+        } else {
+            delta = try captureDelta()
+        }
+        guard let delta else { return nil }
+        messagesSent += 1
+        return delta.serialized(droppedFrames: droppedFrames)
+    }
+
+    /// Sends a full keyframe with the next message (e.g. after a client reported loss).
+    public func requestKeyframe() {
+        pending = nil
+        encoder.reset()
+    }
+
+    private func captureDelta() throws -> FrameDeltaEncoder.Delta? {
+        let frame = try agent.captureFramePixels(windowId: windowId)
+        return try frame.pixels.withUnsafeBytes {
+            try encoder.encode(pixels: $0, width: frame.width, height: frame.height, bytesPerRow: frame.pitch)
+        }
+    }
+}
+
+private extension Data {
+    mutating func appendLittleEndian<T: FixedWidthInteger>(_ value: T) {
+        withUnsafeBytes(of: value.littleEndian) { append(contentsOf: $0) }
+    }
+}
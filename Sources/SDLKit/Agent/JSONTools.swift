@@ -74,6 +74,7 @@ public struct SDLKitJSONAgent {
         case drawCircleFilled = "/agent/gui/drawCircleFilled"
         case drawText = "/agent/gui/drawText"
         case captureEvent = "/agent/gui/captureEvent"
+        case events = "/agent/gui/events"
         case openapiYAML = "/openapi.yaml"
         case openapiJSON = "/openapi.json"
         case health = "/health"
@@ -89,7 +90,10 @@ public struct SDLKitJSONAgent {
         case textureFree = "/agent/gui/texture/free"
         case textureDrawTiled = "/agent/gui/texture/drawTiled"
         case textureDrawRotated = "/agent/gui/texture/drawRotated"
+        case textureCache = "/agent/gui/texture/cache"
         case screenshot = "/agent/gui/screenshot/capture"
+        case screenshotPNG = "/agent/gui/screenshot/png"
+        case frameStream = "/agent/gui/stream/frames"
         case renderGetOutputSize = "/agent/gui/render/getOutputSize"
         case renderGetScale = "/agent/gui/render/getScale"
         case renderSetScale = "/agent/gui/render/setScale"
@@ -103,6 +107,7 @@ public struct SDLKitJSONAgent {
         case drawPoints = "/agent/gui/drawPoints"
         case drawLines = "/agent/gui/drawLines"
         case drawRects = "/agent/gui/drawRects"
+        case drawBatch = "/agent/gui/batch"
         // Audio (preview)
         case audioDevices = "/agent/audio/devices"
         case audioCaptureOpen = "/agent/audio/capture/open"
@@ -128,6 +133,10 @@ public struct SDLKitJSONAgent {
         case audioPlaybackPlayWAV = "/agent/audio/playback/play_wav"
         case audioMonitorStart = "/agent/audio/monitor/start"
         case audioMonitorStop = "/agent/audio/monitor/stop"
+        // GPU diagnostics
+        case gpuTimings = "/agent/gpu/timings"
+        // CPU profiler
+        case profilerTrace = "/agent/profiler/trace"
     }
 
     private struct CacheSignature: Equatable {
@@ -168,17 +177,205 @@ public struct SDLKitJSONAgent {
         }
     }
 
-    private static var cachedOpenAPIEnvPath: String?
-    private static var externalYAMLCache: CachedFile?
-    private static var externalJSONCache: CachedFile?
-    private static var yamlConversionCache: CachedConversion?
-    internal static var _openAPIConversionObserver: (() -> Void)?
+    // OpenAPI documents are served off the main actor; `openAPILock` guards these caches.
+    nonisolated private static let openAPILock = NSLock()
+    nonisolated(unsafe) private static var cachedOpenAPIEnvPath: String?
+    nonisolated(unsafe) private static var externalYAMLCache: CachedFile?
+    nonisolated(unsafe) private static var externalJSONCache: CachedFile?
+    nonisolated(unsafe) private static var yamlConversionCache: CachedConversion?
+    nonisolated(unsafe) internal static var _openAPIConversionObserver: (() -> Void)?
 
-    public func handle(path: String, body: Data) -> Data {
-        guard let ep = Endpoint(rawValue: path) else {
-            if path.hasPrefix("/agent/gui/") { return Self.errorJSON(code: "not_implemented", details: path) }
-            return Self.errorJSON(code: "invalid_endpoint", details: path)
+    /// A response body with its media type.
+    public struct Response: Sendable {
+        public let body: Data
+        public let contentType: String
+    }
+
+    /// Like `handle(path:body:)`, but labels binary bodies: `/agent/gui/screenshot/png`
+    /// answers with the PNG file itself (`image/png`); errors and everything else are JSON.
+    public func respond(path: String, body: Data) -> Response {
+        let data = handle(path: path, body: body)
+        if path == Endpoint.screenshotPNG.rawValue, data.starts(with: PNGEncoder.signature) {
+            return Response(body: data, contentType: "image/png")
+        }
+        return Response(body: data, contentType: "application/json")
+    }
+
+    /// Like `respond(path:body:)`, but honors an `Accept` header: when it asks for
+    /// `application/octet-stream`, capture reads, mel reads and raw or PNG screenshots answer
+    /// with a `BinaryPayload` instead of base64 in JSON.
+    public func respond(path: String, body: Data, accept: String?) -> Response {
+        guard BinaryPayload.accepts(accept), let ep = Endpoint(rawValue: path) else { return respond(path: path, body: body) }
+        let profile = SDLProfiler.begin("agent.handleBinary", detail: path)
+        defer { profile.end() }
+        do {
+            switch ep {
+            case .audioCaptureRead:
+                return Self.respondOffMain(path: path, body: body, accept: accept)
+            case .audioFeaturesReadMel:
+                struct Req: Codable { let audio_id: Int; let frames: Int; let mel_bands: Int }
+                struct Meta: Codable { let frames: Int; let mel_bands: Int; let format: String }
+                let req = try JSONDecoder().decode(Req.self, from: body)
+                let (got, mel, onset) = try readMel(audioId: req.audio_id, frames: req.frames, melBands: req.mel_bands)
+                // Mel frames, then one onset strength per frame.
+                var samples = Data(capacity: (mel.count + onset.count) * MemoryLayout<Float>.size)
+                mel.withUnsafeBufferPointer { samples.append($0) }
+                onset.withUnsafeBufferPointer { samples.append($0) }
+                return try Self.binaryResponse(Meta(frames: got, mel_bands: req.mel_bands, format: "f32"), samples)
+            case .screenshot:
+                let req = try JSONDecoder().decode(ScreenshotReq.self, from: body)
+                switch req.format {
+                case .raw:
+                    struct Meta: Codable { let width: Int; let height: Int; let pitch: Int; let format: String }
+                    let shot = try agent.captureFramePixels(windowId: req.window_id)
+                    return try Self.binaryResponse(Meta(width: shot.width, height: shot.height, pitch: shot.pitch, format: "ABGR8888"), Data(shot.pixels))
+                case .png:
+                    struct Meta: Codable { let format: String }
+                    return try Self.binaryResponse(Meta(format: "PNG"), agent.screenshotPNGData(windowId: req.window_id))
+                }
+            default:
+                return respond(path: path, body: body)
+            }
+        } catch {
+            return Self.errorResponse(error)
+        }
+    }
+
+    /// Like `respondOffMain(path:body:)`, but answers capture reads with a `BinaryPayload`
+    /// when `accept` asks for `application/octet-stream`.
+    public nonisolated static func respondOffMain(path: String, body: Data, accept: String?) -> Response {
+        guard BinaryPayload.accepts(accept), path == Endpoint.audioCaptureRead.rawValue else {
+            return respondOffMain(path: path, body: body)
+        }
+        var out = Data()
+        do {
+            try writeCaptureRead(body: body, into: &out)
+            return Response(body: out, contentType: BinaryPayload.contentType)
+        } catch {
+            return errorResponse(error)
+        }
+    }
+
+    /// Answers a `/agent/audio/capture/read` body in binary, reading samples from the
+    /// session's ring straight into `sink` after the prefix. Run on the session's queue;
+    /// the metadata's `frames` is the count actually read.
+    public nonisolated static func writeCaptureRead<Sink: BinaryPayloadSink>(body: Data, into sink: inout Sink) throws {
+        struct Req: Codable { let audio_id: Int; let frames: Int }
+        struct Meta: Codable { let frames: Int; let channels: Int; let format: String }
+        let req = try JSONDecoder().decode(Req.self, from: body)
+        guard let sess = AudioSessionLanes.shared.capture(req.audio_id) else { throw AgentError.invalidArgument("unknown audio_id") }
+        // Other consumers (feature extraction, the A2M stream) drain the same ring, so the read
+        // may come up short: reserve a prefix sized for the upper bound, read the samples in
+        // behind it, then fill it in with the count actually read.
+        let upper = min(max(0, req.frames), sess.pump.availableFrames)
+        func prefix(frames: Int, length: Int = 0) throws -> Data {
+            BinaryPayload.prefix(metadata: try JSONEncoder().encode(Meta(frames: frames, channels: sess.channels, format: "f32")), length: length)
+        }
+        let reserved = try prefix(frames: upper).count
+        let sampleCount = upper * sess.channels
+        try sink.append(capacity: reserved + sampleCount * MemoryLayout<Float>.size) { dst in
+            let samplesDst = UnsafeMutableRawBufferPointer(rebasing: dst[reserved...])
+            var framesRead = 0
+            if let base = samplesDst.baseAddress, sampleCount > 0 {
+                if Int(bitPattern: base) % MemoryLayout<Float>.alignment == 0 {
+                    let samples = UnsafeMutableBufferPointer(start: base.bindMemory(to: Float.self, capacity: sampleCount), count: sampleCount)
+                    framesRead = sess.pump.readFrames(into: samples)
+                } else {
+                    var staging = [Float](repeating: 0, count: sampleCount)
+                    framesRead = staging.withUnsafeMutableBufferPointer { sess.pump.readFrames(into: $0) }
+                    let bytes = framesRead * sess.channels * MemoryLayout<Float>.size
+                    staging.withUnsafeBytes { samplesDst.copyMemory(from: UnsafeRawBufferPointer(rebasing: $0.prefix(bytes))) }
+                }
+            }
+            // A shorter count never encodes longer, so the actual prefix fits the reserved slot.
+            _ = try prefix(frames: framesRead, length: reserved).copyBytes(to: dst)
+            return reserved + framesRead * sess.channels * MemoryLayout<Float>.size
+        }
+    }
+
+    private nonisolated static func binaryResponse<M: Encodable>(_ metadata: M, _ payload: Data) throws -> Response {
+        Response(body: try BinaryPayload(metadata: metadata, payload: payload).encoded(), contentType: BinaryPayload.contentType)
+    }
+
+    /// Opens a frame stream for a `/agent/gui/stream/frames` request body; the transport
+    /// keeps the connection open and pulls messages from the session.
+    public func openFrameStream(body: Data) throws -> FrameStreamSession {
+        let req = try JSONDecoder().decode(FrameStreamRequest.self, from: body)
+        return try FrameStreamSession(agent: agent, request: req)
+    }
+
+    /// Executes an already-decoded `/agent/gui/batch` body. Transports decode with
+    /// `DrawBatch.decode` off the main thread and hop here once per batch.
+    public func executeBatch(_ batch: DrawBatch) -> Response {
+        do {
+            let calls = try agent.executeBatch(batch)
+            struct R: Codable { let ok: Bool; let commands: Int; let calls: Int }
+            return Response(body: try JSONEncoder().encode(R(ok: true, commands: batch.commands.count, calls: calls)),
+                            contentType: "application/json")
+        } catch {
+            return Self.errorResponse(error)
+        }
+    }
+
+    /// The JSON error body `handle(path:body:)` would return for `error`.
+    public nonisolated static func errorResponse(_ error: Error) -> Response {
+        let body = (error as? AgentError).map { errorJSON(from: $0) }
+            ?? errorJSON(code: "invalid_argument", details: String(describing: error))
+        return Response(body: body, contentType: "application/json")
+    }
+
+    /// Pulls up to `frames` mel frames (and their onset strengths) for a feature session,
+    /// from the CPU extractor or, when the GPU path is active, straight from the capture pump.
+    private func readMel(audioId: Int, frames: Int, melBands: Int) throws -> (frames: Int, mel: [Float], onset: [Float]) {
+        guard let sess = Self._capStore[audioId] else { throw AgentError.invalidArgument("features not started for audio_id") }
+        var got = 0
+        var mel: [Float] = []
+        var onset: [Float] = []
+        if let feat = sess.feat {
+            let res = feat.readMel(frames: frames, melBands: melBands)
+            got = res.frames; mel = res.mel; onset = res.onset
+        } else if let g = GPUStore.get(audioId) {
+            // GPU path on-demand: pull raw frames from pump and window them
+            let fs = g.frameSize, hs = g.hopSize, mb = g.melBands
+            let framesToMake = min(frames, 64)
+            // read framesToMake * hs frames
+            var raw = Array(repeating: Float(0), count: framesToMake * hs * sess.cap.spec.channels)
+            let read = sess.pump.readFrames(into: &raw)
+            if read > 0 {
+                // downmix
+                let chans = sess.cap.spec.channels
+                let frameCount = read
+                var mono = [Float](); mono.reserveCapacity(frameCount)
+                for i in 0..<frameCount {
+                    var acc: Float = 0
+                    for c in 0..<chans { acc += raw[i*chans + c] }
+                    mono.append(acc / Float(chans))
+                }
+                // build windows from overlap store
+                let windows = GPUStore.buildWindowsAppend(audioId: audioId, mono: mono, frameSize: fs, hopSize: hs, maxFrames: framesToMake)
+                let melFrames = (try? g.gpu.process(frames: windows)) ?? []
+                // flatten mel and compute onset via GPU if available
+                mel.reserveCapacity(melFrames.count * mb)
+                var prev = GPUStore.getPrevMel(audioId)
+                let onsetFrames = (try? g.gpu.onsetFlux(melFrames: melFrames, prevMel: prev)) ?? []
+                for (idx, mf) in melFrames.enumerated() {
+                    mel.append(contentsOf: mf)
+                    if idx < onsetFrames.count { onset.append(onsetFrames[idx]) } else { onset.append(0) }
+                    prev = mf
+                }
+                GPUStore.setPrevMel(audioId, prev: prev)
+                got = melFrames.count
+            }
+        } else {
+            throw AgentError.invalidArgument("features not started for audio_id")
         }
+        return (got, mel, onset)
+    }
+
+    public func handle(path: String, body: Data) -> Data {
+        let profile = SDLProfiler.begin("agent.handle", detail: path)
+        defer { profile.end() }
+        guard let ep = Endpoint(rawValue: path) else { return Self.unknownEndpointJSON(path) }
         do {
             switch ep {
             case .audioDevices:
@@ -196,17 +393,11 @@ public struct SDLKitJSONAgent {
                 // Choose a generous ring buffer (0.5s) for now
                 let pump = SDLAudioChunkedCapturePump(capture: cap, bufferFrames: max(2048, spec.sampleRate / 2))
                 let aid = Self._nextAudioId; Self._nextAudioId += 1; Self._capStore[aid] = CaptureSession(cap: cap, pump: pump, feat: nil, a2m: nil, featureFrameCursor: 0)
+                AudioSessionLanes.shared.setCapture(.init(pump: pump, channels: cap.spec.channels), for: aid)
                 return try JSONEncoder().encode(Res(audio_id: aid))
-            case .audioCaptureRead:
-                struct Req: Codable { let audio_id: Int; let frames: Int }
-                struct Res: Codable { let frames: Int; let channels: Int; let format: String; let data_base64: String }
-                let req = try JSONDecoder().decode(Req.self, from: body)
-                guard let sess = Self._capStore[req.audio_id] else { throw AgentError.invalidArgument("unknown audio_id") }
-                var framesBuf = Array(repeating: Float(0), count: max(0, req.frames) * sess.cap.spec.channels)
-                let gotFrames = sess.pump.readFrames(into: &framesBuf)
-                let data = Data(bytes: framesBuf, count: gotFrames * sess.cap.spec.channels * MemoryLayout<Float>.size)
-                let out = Res(frames: gotFrames, channels: sess.cap.spec.channels, format: "f32", data_base64: data.base64EncodedString())
-                return try JSONEncoder().encode(out)
+            case .audioCaptureRead, .audioPlaybackQueueEnqueue, .audioA2MTest, .audioA2MStreamPoll,
+                 .openapiYAML, .openapiJSON, .profilerTrace, .health, .version:
+                return try Self.handleOffMain(ep, body: body)
             case .audioPlaybackOpen:
                 struct Req: Codable { let device_id: UInt64?; let sample_rate: Int?; let channels: Int?; let format: String? }
                 struct Res: Codable { let audio_id: Int }
@@ -262,48 +453,7 @@ public struct SDLKitJSONAgent {
                 struct Req: Codable { let audio_id: Int; let frames: Int; let mel_bands: Int }
                 struct Res: Codable { let frames: Int; let mel_bands: Int; let mel_base64: String; let onset_base64: String }
                 let req = try JSONDecoder().decode(Req.self, from: body)
-                guard let sess = Self._capStore[req.audio_id] else { throw AgentError.invalidArgument("features not started for audio_id") }
-                var got = 0
-                var mel: [Float] = []
-                var onset: [Float] = []
-                if let feat = sess.feat {
-                    let res = feat.readMel(frames: req.frames, melBands: req.mel_bands)
-                    got = res.frames; mel = res.mel; onset = res.onset
-                } else if let g = GPUStore.get(req.audio_id) {
-                    // GPU path on-demand: pull raw frames from pump and window them
-                    let fs = g.frameSize, hs = g.hopSize, mb = g.melBands
-                    let framesToMake = min(req.frames, 64)
-                    // read framesToMake * hs frames
-                    var raw = Array(repeating: Float(0), count: framesToMake * hs * sess.cap.spec.channels)
-                    let read = sess.pump.readFrames(into: &raw)
-                    if read > 0 {
-                        // downmix
-                        let chans = sess.cap.spec.channels
-                        let frameCount = read
-                        var mono = [Float](); mono.reserveCapacity(frameCount)
-                        for i in 0..<frameCount {
-                            var acc: Float = 0
-                            for c in 0..<chans { acc += raw[i*chans + c] }
-                            mono.append(acc / Float(chans))
-                        }
-                        // build windows from overlap store
-                        let windows = GPUStore.buildWindowsAppend(audioId: req.audio_id, mono: mono, frameSize: fs, hopSize: hs, maxFrames: framesToMake)
-                        let melFrames = (try? g.gpu.process(frames: windows)) ?? []
-                        // flatten mel and compute onset via GPU if available
-                        mel.reserveCapacity(melFrames.count * mb)
-                        var prev = GPUStore.getPrevMel(req.audio_id)
-                        let onsetFrames = (try? g.gpu.onsetFlux(melFrames: melFrames, prevMel: prev)) ?? []
-                        for (idx, mf) in melFrames.enumerated() {
-                            mel.append(contentsOf: mf)
-                            if idx < onsetFrames.count { onset.append(onsetFrames[idx]) } else { onset.append(0) }
-                            prev = mf
-                        }
-                        GPUStore.setPrevMel(req.audio_id, prev: prev)
-                        got = melFrames.count
-                    }
-                } else {
-                    throw AgentError.invalidArgument("features not started for audio_id")
-                }
+                let (got, mel, onset) = try readMel(audioId: req.audio_id, frames: req.frames, melBands: req.mel_bands)
                 let melData = mel.withUnsafeBufferPointer { Data(buffer: $0) }
                 let onsetData = onset.withUnsafeBufferPointer { Data(buffer: $0) }
                 let out = Res(frames: got, mel_bands: req.mel_bands, mel_base64: melData.base64EncodedString(), onset_base64: onsetData.base64EncodedString())
@@ -317,17 +467,8 @@ public struct SDLKitJSONAgent {
                 let pb = try SDLAudioPlayback(spec: spec, deviceId: req.device_id)
                 let q = SDLAudioPlaybackQueue(playback: pb)
                 let aid = Self._nextAudioId; Self._nextAudioId += 1; Self._playStore[aid] = pb; Self._playQueues[aid] = q
+                AudioSessionLanes.shared.setPlaybackQueue(q, for: aid)
                 return try JSONEncoder().encode(Res(audio_id: aid))
-            case .audioPlaybackQueueEnqueue:
-                struct Req: Codable { let audio_id: Int; let format: String; let channels: Int; let data_base64: String }
-                let req = try JSONDecoder().decode(Req.self, from: body)
-                guard let q = Self._playQueues[req.audio_id] else { throw AgentError.invalidArgument("unknown audio_id or queue not open") }
-                guard req.format.lowercased() == "f32" else { throw AgentError.invalidArgument("only f32 supported") }
-                guard let data = Data(base64Encoded: req.data_base64) else { throw AgentError.invalidArgument("invalid base64") }
-                var samples = Array(repeating: Float(0), count: data.count / MemoryLayout<Float>.size)
-                _ = samples.withUnsafeMutableBytes { dst in data.copyBytes(to: dst) }
-                q.enqueue(samples: samples)
-                return Self.okJSON()
             case .audioPlaybackPlayWAV:
                 struct Req: Codable { let path: String; let audio_id: Int?; let device_id: UInt64?; let sample_rate: Int?; let channels: Int?; let format: String? }
                 struct Res: Codable { let audio_id: Int }
@@ -386,26 +527,6 @@ public struct SDLKitJSONAgent {
                 let msPerFrame = Int((Double(feat.hopSize) / Double(feat.sampleRate)) * 1000.0)
                 let outEvents = events.map { e in EventOut(kind: e.kind.rawValue, note: e.note, velocity: e.velocity, frameIndex: e.frameIndex, timestamp_ms: e.frameIndex * msPerFrame) }
                 return try JSONEncoder().encode(Res(events: outEvents))
-            case .audioA2MTest:
-                struct Req: Codable { let mel_bands: Int; let frames: Int; let mel_base64: String }
-                struct EventOut: Codable { let kind: String; let note: Int; let velocity: Int; let frameIndex: Int }
-                struct Res: Codable { let events: [EventOut] }
-                let req = try JSONDecoder().decode(Req.self, from: body)
-                guard let data = Data(base64Encoded: req.mel_base64) else { throw AgentError.invalidArgument("invalid base64") }
-                let total = data.count / MemoryLayout<Float>.size
-                guard total == req.frames * req.mel_bands else { throw AgentError.invalidArgument("mel data size mismatch") }
-                var mel = Array(repeating: Float(0), count: total)
-                _ = mel.withUnsafeMutableBytes { dst in data.copyBytes(to: dst) }
-                var framesMel: [[Float]] = []
-                framesMel.reserveCapacity(req.frames)
-                for i in 0..<req.frames {
-                    let s = i * req.mel_bands
-                    framesMel.append(Array(mel[s..<(s+req.mel_bands)]))
-                }
-                let stub = AudioA2MStub(melBands: req.mel_bands)
-                let ev = stub.process(melFrames: framesMel, startFrameIndex: 0)
-                let out = ev.map { EventOut(kind: $0.kind.rawValue, note: $0.note, velocity: $0.velocity, frameIndex: $0.frameIndex) }
-                return try JSONEncoder().encode(Res(events: out))
             case .audioA2MStreamStart:
                 #if !HEADLESS_CI
                 struct Req: Codable { let audio_id: Int; let midi: Bool? }
@@ -425,6 +546,10 @@ public struct SDLKitJSONAgent {
                     }
                 }
                 Self._a2mStreams[req.audio_id] = stream
+                // Polls run on the session's lane; derive ms from the CPU pump's hop if present, else the GPU store's.
+                let hop = sess.feat?.hopSize ?? gpuProxy?.hopSize ?? 512
+                let msPerFrame = Int((Double(hop) / Double(sess.cap.spec.sampleRate)) * 1000.0)
+                AudioSessionLanes.shared.setStream(.init(stream: stream, msPerFrame: msPerFrame), for: req.audio_id)
                 return try JSONEncoder().encode(Res(ok: true))
                 #else
                 return Self.errorJSON(code: "not_implemented", details: "A2M stream not available in headless build")
@@ -483,54 +608,36 @@ public struct SDLKitJSONAgent {
                 #else
                 return Self.errorJSON(code: "not_implemented", details: "MIDI channel not available on this platform")
                 #endif
-            case .audioA2MStreamPoll:
-                #if !HEADLESS_CI
-                struct Req: Codable { let audio_id: Int; let since: Int?; let max_events: Int?; let timeout_ms: Int? }
-                struct EventOut: Codable { let kind: String; let note: Int; let velocity: Int; let frameIndex: Int; let timestamp_ms: Int }
-                struct Res: Codable { let events: [EventOut]; let next: Int }
-                let req = try JSONDecoder().decode(Req.self, from: body)
-                guard let stream = Self._a2mStreams[req.audio_id] else { throw AgentError.invalidArgument("stream not started for audio_id") }
-                let since = req.since ?? 0
-                let max = max(1, req.max_events ?? 128)
-                let deadline = (req.timeout_ms ?? 0) > 0 ? Date().addingTimeInterval(Double(req.timeout_ms!) / 1000.0) : Date()
-                var out: [MIDIEvent] = stream.poll(since: since, max: max)
-                while out.isEmpty && Date() < deadline {
-                    Thread.sleep(forTimeInterval: 0.01)
-                    out = stream.poll(since: since, max: max)
-                }
-                // Derive ms from CPU feat if present; else from GPU proxy (uses hopSize from GPU store, sampleRate from capture spec)
-                let sess = Self._capStore[req.audio_id]
-                let sampleRate = sess?.cap.spec.sampleRate ?? 48000
-                let hop = sess?.feat?.hopSize ?? GPUStore.get(req.audio_id)?.hopSize ?? 512
-                let msPerFrame = Int((Double(hop) / Double(sampleRate)) * 1000.0)
-                let enc = out.enumerated().map { (idx, e) in EventOut(kind: e.kind.rawValue, note: e.note, velocity: e.velocity, frameIndex: e.frameIndex, timestamp_ms: e.frameIndex * msPerFrame) }
-                return try JSONEncoder().encode(Res(events: enc, next: since + enc.count))
-                #else
-                return Self.errorJSON(code: "not_implemented", details: "A2M stream not available in headless build")
-                #endif
             case .audioA2MStreamStop:
                 #if !HEADLESS_CI
                 struct Req: Codable { let audio_id: Int }
                 struct Res: Codable { let ok: Bool }
                 let req = try JSONDecoder().decode(Req.self, from: body)
                 if let s = Self._a2mStreams.removeValue(forKey: req.audio_id) { s.stop() }
+                AudioSessionLanes.shared.setStream(nil, for: req.audio_id)
                 return try JSONEncoder().encode(Res(ok: true))
                 #else
                 return Self.errorJSON(code: "not_implemented", details: "A2M stream not available in headless build")
                 #endif
-            case .openapiYAML:
-                if let ext = Self.loadExternalOpenAPIYAML() { return ext }
-                return Data(SDLKitOpenAPI.yaml.utf8)
-            case .openapiJSON:
-                // Prefer converting an external YAML to JSON for exact mirroring
-                if let converted = Self.cachedJSONFromExternalYAML() { return converted }
-                if let ext = Self.loadExternalOpenAPIJSON() { return ext }
-                return SDLKitOpenAPI.json
-            case .health:
-                return try JSONEncoder().encode(["ok": true])
-            case .version:
-                let specVer = Self.externalOpenAPIVersion() ?? SDLKitOpenAPI.specVersion
-                return try JSONEncoder().encode(["agent": SDLKitOpenAPI.agentVersion, "openapi": specVer])
+            case .gpuTimings:
+                struct Req: Codable { let reset: Bool? }
+                struct Scope: Codable { let label: String; let samples: Int; let total_samples: Int; let last_ms: Double; let avg_ms: Double; let min_ms: Double; let max_ms: Double; let p95_ms: Double }
+                struct Backend: Codable { let backend: String; let timestamps_supported: Bool; let labeled_scopes_supported: Bool; let dropped_scopes: Int; let scopes: [Scope] }
+                struct Res: Codable { let backends: [Backend] }
+                let req = body.isEmpty ? Req(reset: nil) : try JSONDecoder().decode(Req.self, from: body)
+                let backends = GPUTimingRegistry.aggregators.map { timings in
+                    Backend(backend: timings.source,
+                            timestamps_supported: timings.timestampsSupported,
+                            labeled_scopes_supported: timings.labeledScopesSupported,
+                            dropped_scopes: timings.droppedScopes,
+                            scopes: timings.snapshot().map { s in
+                                Scope(label: s.label, samples: s.sampleCount, total_samples: s.totalSamples, last_ms: s.lastMilliseconds, avg_ms: s.averageMilliseconds, min_ms: s.minMilliseconds, max_ms: s.maxMilliseconds, p95_ms: s.p95Milliseconds)
+                            })
+                }
+                if req.reset ?? false {
+                    for timings in GPUTimingRegistry.aggregators { timings.reset() }
+                }
+                return try JSONEncoder().encode(Res(backends: backends))
             case .open:
                 let req = try JSONDecoder().decode(OpenWindowReq.self, from: body)
                 let id = try agent.openWindow(title: req.title, width: req.width, height: req.height)
@@ -627,6 +734,11 @@ public struct SDLKitJSONAgent {
                 } else {
                     return try JSONEncoder().encode([String: String]())
                 }
+            case .events:
+                let req = try JSONDecoder().decode(EventsReq.self, from: body)
+                let batch = try agent.events(windowId: req.window_id, since: req.since ?? 0, limit: req.limit)
+                struct R: Codable { let events: [JEvent]; let cursor: UInt64; let gap: Bool }
+                return try JSONEncoder().encode(R(events: batch.events.map(JEvent.init), cursor: batch.cursor, gap: batch.gap))
             case .clipboardGet:
                 // Require a valid window_id to ensure context
                 let req = try JSONDecoder().decode(WindowOnlyReq.self, from: body)
@@ -661,7 +773,11 @@ public struct SDLKitJSONAgent {
                 return try JSONEncoder().encode(R(bounds: b))
             case .textureLoad:
                 let req = try JSONDecoder().decode(TextureLoadReq.self, from: body)
-                try agent.textureLoad(windowId: req.window_id, id: req.id, path: req.path)
+                if req.async == true {
+                    try agent.textureLoadAsync(windowId: req.window_id, id: req.id, path: req.path)
+                } else {
+                    try agent.textureLoad(windowId: req.window_id, id: req.id, path: req.path)
+                }
                 return Self.okJSON()
             case .textureDraw:
                 let req = try JSONDecoder().decode(TextureDrawReq.self, from: body)
@@ -688,6 +804,11 @@ public struct SDLKitJSONAgent {
                 let req = try JSONDecoder().decode(TextureDrawRotatedReq.self, from: body)
                 try agent.textureDrawRotated(windowId: req.window_id, id: req.id, x: req.x, y: req.y, width: req.width, height: req.height, angle: req.angle, cx: req.cx, cy: req.cy)
                 return Self.okJSON()
+            case .textureCache:
+                let req = try JSONDecoder().decode(TextureCacheReq.self, from: body)
+                if let mb = req.budget_mb, mb <= 0 { throw AgentError.invalidArgument("budget_mb must be > 0") }
+                let stats = try agent.textureCacheStats(windowId: req.window_id, budgetBytes: req.budget_mb.map { $0 << 20 })
+                return try JSONEncoder().encode(stats)
             case .screenshot:
                 let req = try JSONDecoder().decode(ScreenshotReq.self, from: body)
                 switch req.format {
@@ -695,13 +816,14 @@ public struct SDLKitJSONAgent {
                     let shot = try agent.screenshotRaw(windowId: req.window_id)
                     return try JSONEncoder().encode(shot)
                 case .png:
-                    do {
-                        let shot = try agent.screenshotPNG(windowId: req.window_id)
-                        return try JSONEncoder().encode(shot)
-                    } catch AgentError.notImplemented {
-                        return Self.errorJSON(code: "not_implemented", details: "PNG screenshots require SDL_image; retry with format \"raw\".")
-                    }
+                    let shot = try agent.screenshotPNG(windowId: req.window_id)
+                    return try JSONEncoder().encode(shot)
                 }
+            case .screenshotPNG:
+                let req = try JSONDecoder().decode(WindowOnlyReq.self, from: body)
+                return try agent.screenshotPNGData(windowId: req.window_id)
+            case .frameStream:
+                return Self.errorJSON(code: "not_implemented", details: "Frame streams need a persistent connection; use the SDLKitNIO server.")
             case .renderGetOutputSize:
                 let req = try JSONDecoder().decode(WindowOnlyReq.self, from: body)
                 let (w, h) = try agent.getRenderOutputSize(windowId: req.window_id)
@@ -764,6 +886,8 @@ public struct SDLKitJSONAgent {
                 let color = try req.color.resolved()
                 try agent.drawRects(windowId: req.window_id, rects: req.rects.map { ($0.x, $0.y, $0.width, $0.height) }, color: color, filled: req.filled ?? true)
                 return Self.okJSON()
+            case .drawBatch:
+                return executeBatch(try DrawBatch.decode(body)).body
             }
         } catch let e as AgentError {
             return Self.errorJSON(from: e)
@@ -772,7 +896,115 @@ public struct SDLKitJSONAgent {
         }
     }
 
-    private static func cachedJSONFromExternalYAML() -> Data? {
+    /// Endpoints that need neither the main actor nor SDL calls (see `affinity(path:body:)`).
+    nonisolated static func handleOffMain(_ ep: Endpoint, body: Data) throws -> Data {
+        switch ep {
+        case .health:
+            return try JSONEncoder().encode(["ok": true])
+        case .version:
+            openAPILock.lock(); defer { openAPILock.unlock() }
+            let specVer = Self.externalOpenAPIVersion() ?? SDLKitOpenAPI.specVersion
+            return try JSONEncoder().encode(["agent": SDLKitOpenAPI.agentVersion, "openapi": specVer])
+        case .openapiYAML:
+            openAPILock.lock(); defer { openAPILock.unlock() }
+            if let ext = Self.loadExternalOpenAPIYAML() { return ext }
+            return Data(SDLKitOpenAPI.yaml.utf8)
+        case .openapiJSON:
+            openAPILock.lock(); defer { openAPILock.unlock() }
+            // Prefer converting an external YAML to JSON for exact mirroring
+            if let converted = Self.cachedJSONFromExternalYAML() { return converted }
+            if let ext = Self.loadExternalOpenAPIJSON() { return ext }
+            return SDLKitOpenAPI.json
+        case .profilerTrace:
+            // The trace only travels in the response body; this endpoint never touches the filesystem.
+            struct Req: Codable { let enable: Bool?; let reset: Bool? }
+            let req = body.isEmpty ? Req(enable: nil, reset: nil) : try JSONDecoder().decode(Req.self, from: body)
+            let trace = try SDLProfiler.chromeTraceJSON()
+            if req.reset ?? false { SDLProfiler.reset() }
+            if let enable = req.enable { SDLProfiler.isEnabled = enable }
+            return trace
+        case .audioA2MTest:
+            struct Req: Codable { let mel_bands: Int; let frames: Int; let mel_base64: String }
+            struct EventOut: Codable { let kind: String; let note: Int; let velocity: Int; let frameIndex: Int }
+            struct Res: Codable { let events: [EventOut] }
+            let req = try JSONDecoder().decode(Req.self, from: body)
+            guard let data = Data(base64Encoded: req.mel_base64) else { throw AgentError.invalidArgument("invalid base64") }
+            let total = data.count / MemoryLayout<Float>.size
+            guard total == req.frames * req.mel_bands else { throw AgentError.invalidArgument("mel data size mismatch") }
+            var mel = Array(repeating: Float(0), count: total)
+            _ = mel.withUnsafeMutableBytes { dst in data.copyBytes(to: dst) }
+            var framesMel: [[Float]] = []
+            framesMel.reserveCapacity(req.frames)
+            for i in 0..<req.frames {
+                let s = i * req.mel_bands
+                framesMel.append(Array(mel[s..<(s+req.mel_bands)]))
+            }
+            let stub = AudioA2MStub(melBands: req.mel_bands)
+            let ev = stub.process(melFrames: framesMel, startFrameIndex: 0)
+            let out = ev.map { EventOut(kind: $0.kind.rawValue, note: $0.note, velocity: $0.velocity, frameIndex: $0.frameIndex) }
+            return try JSONEncoder().encode(Res(events: out))
+        case .audioCaptureRead:
+            struct Req: Codable { let audio_id: Int; let frames: Int }
+            struct Res: Codable { let frames: Int; let channels: Int; let format: String; let data_base64: String }
+            let req = try JSONDecoder().decode(Req.self, from: body)
+            guard let sess = AudioSessionLanes.shared.capture(req.audio_id) else { throw AgentError.invalidArgument("unknown audio_id") }
+            var framesBuf = Array(repeating: Float(0), count: max(0, req.frames) * sess.channels)
+            let gotFrames = sess.pump.readFrames(into: &framesBuf)
+            let data = Data(bytes: framesBuf, count: gotFrames * sess.channels * MemoryLayout<Float>.size)
+            let out = Res(frames: gotFrames, channels: sess.channels, format: "f32", data_base64: data.base64EncodedString())
+            return try JSONEncoder().encode(out)
+        case .audioPlaybackQueueEnqueue:
+            if BinaryPayload.isBinary(body) {
+                struct Meta: Codable { let audio_id: Int; let format: String; let channels: Int }
+                let payload = try BinaryPayload.decode(body)
+                let meta = try payload.decodeMetadata(Meta.self)
+                guard let q = AudioSessionLanes.shared.playbackQueue(meta.audio_id) else { throw AgentError.invalidArgument("unknown audio_id or queue not open") }
+                guard meta.format.lowercased() == "f32" else { throw AgentError.invalidArgument("only f32 supported") }
+                payload.withFloats { q.enqueue(samples: $0) }
+                return Self.okJSON()
+            }
+            struct Req: Codable { let audio_id: Int; let format: String; let channels: Int; let data_base64: String }
+            let req = try JSONDecoder().decode(Req.self, from: body)
+            guard let q = AudioSessionLanes.shared.playbackQueue(req.audio_id) else { throw AgentError.invalidArgument("unknown audio_id or queue not open") }
+            guard req.format.lowercased() == "f32" else { throw AgentError.invalidArgument("only f32 supported") }
+            guard let data = Data(base64Encoded: req.data_base64) else { throw AgentError.invalidArgument("invalid base64") }
+            var samples = Array(repeating: Float(0), count: data.count / MemoryLayout<Float>.size)
+            _ = samples.withUnsafeMutableBytes { dst in data.copyBytes(to: dst) }
+            q.enqueue(samples: samples)
+            return Self.okJSON()
+        case .audioA2MStreamPoll:
+            #if !HEADLESS_CI
+            struct Req: Codable { let audio_id: Int; let since: Int?; let max_events: Int?; let timeout_ms: Int? }
+            struct EventOut: Codable { let kind: String; let note: Int; let velocity: Int; let frameIndex: Int; let timestamp_ms: Int }
+            struct Res: Codable { let events: [EventOut]; let next: Int }
+            let req = try JSONDecoder().decode(Req.self, from: body)
+            guard let lane = AudioSessionLanes.shared.stream(req.audio_id) else { throw AgentError.invalidArgument("stream not started for audio_id") }
+            let stream = lane.stream
+            let since = req.since ?? 0
+            let max = max(1, req.max_events ?? 128)
+            let deadline = (req.timeout_ms ?? 0) > 0 ? Date().addingTimeInterval(Double(req.timeout_ms!) / 1000.0) : Date()
+            var out: [MIDIEvent] = stream.poll(since: since, max: max)
+            while out.isEmpty && Date() < deadline {
+                Thread.sleep(forTimeInterval: 0.01)
+                out = stream.poll(since: since, max: max)
+            }
+            let msPerFrame = lane.msPerFrame
+            let enc = out.enumerated().map { (idx, e) in EventOut(kind: e.kind.rawValue, note: e.note, velocity: e.velocity, frameIndex: e.frameIndex, timestamp_ms: e.frameIndex * msPerFrame) }
+            return try JSONEncoder().encode(Res(events: enc, next: since + enc.count))
+            #else
+            return Self.errorJSON(code: "not_implemented", details: "A2M stream not available in headless build")
+            #endif
+        default:
+            throw AgentError.internalError("\(ep.rawValue) must run on the main actor")
+        }
+    }
+
+    nonisolated static func unknownEndpointJSON(_ path: String) -> Data {
+        if path.hasPrefix("/agent/gui/") { return errorJSON(code: "not_implemented", details: path) }
+        return errorJSON(code: "invalid_endpoint", details: path)
+    }
+
+    private nonisolated static func cachedJSONFromExternalYAML() -> Data? {
         if let envPath = normalizedEnvPath(ProcessInfo.processInfo.environment) {
             let lower = envPath.lowercased()
             if lower.hasSuffix(".json") || lower.hasSuffix(".jsonc") {
@@ -787,15 +1019,15 @@ public struct SDLKitJSONAgent {
         return converted
     }
 
-    private static func loadExternalOpenAPIYAML() -> Data? {
+    private nonisolated static func loadExternalOpenAPIYAML() -> Data? {
         return loadExternalOpenAPIYAMLCacheEntry()?.data
     }
 
-    private static func loadExternalOpenAPIJSON() -> Data? {
+    private nonisolated static func loadExternalOpenAPIJSON() -> Data? {
         return loadExternalOpenAPIJSONCacheEntry()?.data
     }
 
-    private static func loadExternalOpenAPIYAMLCacheEntry() -> CachedFile? {
+    private nonisolated static func loadExternalOpenAPIYAMLCacheEntry() -> CachedFile? {
         let env = ProcessInfo.processInfo.environment
         let envPath = normalizedEnvPath(env)
         refreshEnvPathCacheIfNeeded(envPath)
@@ -820,7 +1052,7 @@ public struct SDLKitJSONAgent {
         return nil
     }
 
-    private static func loadExternalOpenAPIJSONCacheEntry() -> CachedFile? {
+    private nonisolated static func loadExternalOpenAPIJSONCacheEntry() -> CachedFile? {
         let env = ProcessInfo.processInfo.environment
         let envPath = normalizedEnvPath(env)
         refreshEnvPathCacheIfNeeded(envPath)
@@ -845,7 +1077,7 @@ public struct SDLKitJSONAgent {
         return nil
     }
 
-    private static func fetchFile(
+    private nonisolated static func fetchFile(
         at path: String,
         allowedExtensions: [String],
         getCache: () -> CachedFile?,
@@ -875,7 +1107,7 @@ public struct SDLKitJSONAgent {
         return entry
     }
 
-    private static func cacheSignature(for path: String) -> CacheSignature {
+    private nonisolated static func cacheSignature(for path: String) -> CacheSignature {
         var mtime: Date?
         var size: UInt64?
         if let attrs = try? FileManager.default.attributesOfItem(atPath: path) {
@@ -885,7 +1117,7 @@ public struct SDLKitJSONAgent {
         return CacheSignature(path: path, mtime: mtime, size: size)
     }
 
-    private static func setYAMLCache(_ entry: CachedFile?) {
+    private nonisolated static func setYAMLCache(_ entry: CachedFile?) {
         externalYAMLCache = entry
         guard let entry else {
             yamlConversionCache = nil
@@ -896,11 +1128,11 @@ public struct SDLKitJSONAgent {
         }
     }
 
-    private static func setJSONCache(_ entry: CachedFile?) {
+    private nonisolated static func setJSONCache(_ entry: CachedFile?) {
         externalJSONCache = entry
     }
 
-    private static func normalizedEnvPath(_ env: [String: String]) -> String? {
+    private nonisolated static func normalizedEnvPath(_ env: [String: String]) -> String? {
         if let raw = env["SDLKIT_OPENAPI_PATH"]?.trimmingCharacters(in: .whitespacesAndNewlines), !raw.isEmpty {
             return raw
         }
@@ -911,7 +1143,7 @@ public struct SDLKitJSONAgent {
         return raw
     }
 
-    private static func refreshEnvPathCacheIfNeeded(_ envPath: String?) {
+    private nonisolated static func refreshEnvPathCacheIfNeeded(_ envPath: String?) {
         if envPath != cachedOpenAPIEnvPath {
             cachedOpenAPIEnvPath = envPath
             setYAMLCache(nil)
@@ -919,13 +1151,14 @@ public struct SDLKitJSONAgent {
         }
     }
 
-    static func resetOpenAPICacheForTesting() {
+    nonisolated static func resetOpenAPICacheForTesting() {
+        openAPILock.lock(); defer { openAPILock.unlock() }
         cachedOpenAPIEnvPath = nil
         setYAMLCache(nil)
         setJSONCache(nil)
     }
 
-    private static func externalOpenAPIVersion() -> String? {
+    private nonisolated static func externalOpenAPIVersion() -> String? {
         if let jsonEntry = loadExternalOpenAPIJSONCacheEntry() {
             if let obj = try? JSONSerialization.jsonObject(with: jsonEntry.data) as? [String: Any],
                let info = obj["info"] as? [String: Any],
@@ -1031,6 +1264,7 @@ public struct SDLKitJSONAgent {
         let color: UInt32?
     }
     private struct EventReq: Codable { let window_id: Int; let timeout_ms: Int? }
+    private struct EventsReq: Codable { let window_id: Int; let since: UInt64?; let limit: Int? }
     private struct ScreenshotReq: Codable {
         enum Format: String, Codable {
             case raw
@@ -1054,7 +1288,8 @@ public struct SDLKitJSONAgent {
     }
     private struct ClipboardSetReq: Codable { let window_id: Int; let text: String }
     private struct DisplayIndexReq: Codable { let index: Int }
-    private struct TextureLoadReq: Codable { let window_id: Int; let id: String; let path: String }
+    private struct TextureLoadReq: Codable { let window_id: Int; let id: String; let path: String; let async: Bool? }
+    private struct TextureCacheReq: Codable { let window_id: Int; let budget_mb: Int? }
     private struct TextureDrawReq: Codable { let window_id: Int; let id: String; let x: Int; let y: Int; let width: Int?; let height: Int? }
     private struct TextureFreeReq: Codable { let window_id: Int; let id: String }
     private struct TextureDrawTiledReq: Codable { let window_id: Int; let id: String; let x: Int; let y: Int; let width: Int; let height: Int; let tileWidth: Int; let tileHeight: Int }
@@ -1095,12 +1330,12 @@ public struct SDLKitJSONAgent {
     }
 
     // MARK: - Error helpers
-    private static func okJSON() -> Data { try! JSONEncoder().encode(["ok": true]) }
-    private static func errorJSON(code: String, details: String?) -> Data {
+    private nonisolated static func okJSON() -> Data { try! JSONEncoder().encode(["ok": true]) }
+    private nonisolated static func errorJSON(code: String, details: String?) -> Data {
         struct Err: Codable { let error: E; struct E: Codable { let code: String; let details: String? } }
         return try! JSONEncoder().encode(Err(error: .init(code: code, details: details)))
     }
-    private static func errorJSON(from e: AgentError) -> Data {
+    private nonisolated static func errorJSON(from e: AgentError) -> Data {
         switch e {
         case .windowNotFound: return errorJSON(code: "window_not_found", details: nil)
         case .sdlUnavailable: return errorJSON(code: "sdl_unavailable", details: nil)
@@ -0,0 +1,116 @@
+import Foundation
+
+// Where agent requests may execute.
+//
+// Only endpoints that call into SDL windows and renderers (and the audio endpoints that open
+// devices or start pumps) need the main actor. Reads, enqueues and long polls on an audio
+// session touch only that session's ring buffers, playback queue or A2M stream, all of which
+// are thread-safe, so they run on a serial queue per session: a slow poll holds up its own
+// session and nothing else. Pure endpoints — health, version, the OpenAPI documents, profiler
+// traces, offline A2M tests — run wherever the request arrives. Transports route with
+// `SDLKitJSONAgent.affinity(path:body:)` and hop to the main actor only for `.main`.
+
+extension SDLKitJSONAgent {
+    public enum Affinity: Sendable, Equatable {
+        /// SDL window, render and device calls; run on the main actor via `respond(path:body:)`.
+        case main
+        /// Run on `AudioSessionLanes.shared.queue(for:)` via `respondOffMain(path:body:)`.
+        case audioSession(Int)
+        /// Run anywhere via `respondOffMain(path:body:)`.
+        case pure
+    }
+
+    /// Where a request for `path` may execute. Audio session endpoints name the session in
+    /// their body (or its `BinaryPayload` metadata); a body that does not decode is routed to `.main`, which reports the error.
+    public nonisolated static func affinity(path: String, body: Data) -> Affinity {
+        guard let ep = Endpoint(rawValue: path) else { return .pure }
+        switch ep {
+        case .health, .version, .openapiYAML, .openapiJSON, .profilerTrace, .audioA2MTest:
+            return .pure
+        case .audioCaptureRead, .audioPlaybackQueueEnqueue, .audioA2MStreamPoll:
+            struct SessionReq: Decodable { let audio_id: Int }
+            let json = BinaryPayload.isBinary(body) ? (try? BinaryPayload.decode(body))?.metadata : body
+            guard let json, let req = try? JSONDecoder().decode(SessionReq.self, from: json) else { return .main }
+            return .audioSession(req.audio_id)
+        default:
+            return .main
+        }
+    }
+
+    /// Executes a `.pure` or `.audioSession` request without the main actor; `.main`
+    /// requests answer with an internal error. Audio session requests should run on their
+    /// session's queue.
+    public nonisolated static func respondOffMain(path: String, body: Data) -> Response {
+        let profile = SDLProfiler.begin("agent.handleOffMain", detail: path)
+        defer { profile.end() }
+        guard let ep = Endpoint(rawValue: path) else {
+            return Response(body: unknownEndpointJSON(path), contentType: "application/json")
+        }
+        do {
+            return Response(body: try handleOffMain(ep, body: body), contentType: "application/json")
+        } catch {
+            return errorResponse(error)
+        }
+    }
+}
+
+/// Serial queues for audio sessions, plus the thread-safe parts of each session that
+/// off-main handlers may use. Main-actor handlers register sessions as they open them.
+public final class AudioSessionLanes: @unchecked Sendable {
+    public static let shared = AudioSessionLanes()
+
+    struct Capture {
+        let pump: SDLAudioChunkedCapturePump
+        let channels: Int
+    }
+
+    struct Stream {
+        let stream: AudioA2MStream
+        let msPerFrame: Int
+    }
+
+    private let lock = NSLock()
+    private var queues: [Int: DispatchQueue] = [:]
+    private var captures: [Int: Capture] = [:]
+    private var playbackQueues: [Int: SDLAudioPlaybackQueue] = [:]
+    private var streams: [Int: Stream] = [:]
+
+    /// The serial queue requests for `audioId` run on.
+    public func queue(for audioId: Int) -> DispatchQueue {
+        lock.lock(); defer { lock.unlock() }
+        if let queue = queues[audioId] { return queue }
+        let queue = DispatchQueue(label: "sdlkit.audio.session.\(audioId)", qos: .userInitiated)
+        queues[audioId] = queue
+        return queue
+    }
+
+    func setCapture(_ capture: Capture?, for audioId: Int) {
+        lock.lock(); defer { lock.unlock() }
+        captures[audioId] = capture
+    }
+
+    func capture(_ audioId: Int) -> Capture? {
+        lock.lock(); defer { lock.unlock() }
+        return captures[audioId]
+    }
+
+    func setPlaybackQueue(_ queue: SDLAudioPlaybackQueue?, for audioId: Int) {
+        lock.lock(); defer { lock.unlock() }
+        playbackQueues[audioId] = queue
+    }
+
+    func playbackQueue(_ audioId: Int) -> SDLAudioPlaybackQueue? {
+        lock.lock(); defer { lock.unlock() }
+        return playbackQueues[audioId]
+    }
+
+    func setStream(_ stream: Stream?, for audioId: Int) {
+        lock.lock(); defer { lock.unlock() }
+        streams[audioId] = stream
+    }
+
+    func stream(_ audioId: Int) -> Stream? {
+        lock.lock(); defer { lock.unlock() }
+        return streams[audioId]
+    }
+}
@@ -6,8 +6,18 @@ import CSDL3
 @MainActor
 open class SDLKitGUIAgent {
     private var nextID: Int = 1
-    private struct WindowBundle { let window: SDLWindow; let renderer: SDLRenderer }
+    private struct WindowBundle {
+        let window: SDLWindow
+        let renderer: SDLRenderer
+        let sdlWindowID: UInt32
+        init(window: SDLWindow, renderer: SDLRenderer) {
+            self.window = window; self.renderer = renderer; self.sdlWindowID = window.eventWindowID
+        }
+    }
     private var windows: [Int: WindowBundle] = [:]
+    private var eventRings: [Int: AgentEventRing] = [:]
+    // Where `captureEvent` has read up to in each window's ring.
+    private var captureCursors: [Int: UInt64] = [:]
 
     public init() {}
 
@@ -38,6 +48,8 @@ open class SDLKitGUIAgent {
 
     open func closeWindow(windowId: Int) {
         guard let bundle = windows.removeValue(forKey: windowId) else { return }
+        eventRings.removeValue(forKey: windowId)
+        captureCursors.removeValue(forKey: windowId)
         SDLLogger.info("SDLKit.Agent", "Closing window id=\(windowId)")
         bundle.renderer.shutdown()
         bundle.window.close()
@@ -78,10 +90,13 @@ open class SDLKitGUIAgent {
         guard let bundle = windows[windowId] else { throw AgentError.windowNotFound }
         SDLLogger.debug("SDLKit.Agent", "present id=\(windowId)")
         bundle.renderer.present()
+        pumpEvents()
     }
 
     internal func _testingPopulateWindows(count: Int) {
         windows.removeAll()
+        eventRings.removeAll()
+        captureCursors.removeAll()
         nextID = 1
         guard count > 0 else { return }
         for _ in 0..<count {
@@ -179,6 +194,19 @@ open class SDLKitGUIAgent {
         try bundle.renderer.loadTexture(id: id, path: path)
     }
 
+    /// Loads a texture without blocking on decode; draws show a placeholder until it lands.
+    open func textureLoadAsync(windowId: Int, id: String, path: String) throws {
+        guard let bundle = windows[windowId] else { throw AgentError.windowNotFound }
+        try bundle.renderer.loadTextureAsync(id: id, path: path)
+    }
+
+    /// The window's texture cache usage, after optionally replacing its byte budget.
+    open func textureCacheStats(windowId: Int, budgetBytes: Int? = nil) throws -> SDLRenderer.TextureCacheStats {
+        guard let bundle = windows[windowId] else { throw AgentError.windowNotFound }
+        if let budgetBytes { bundle.renderer.setTextureCacheBudget(bytes: budgetBytes) }
+        return bundle.renderer.textureCacheStats()
+    }
+
     open func textureDraw(windowId: Int, id: String, x: Int, y: Int, width: Int?, height: Int?) throws {
         guard let bundle = windows[windowId] else { throw AgentError.windowNotFound }
         try bundle.renderer.drawTexture(id: id, x: x, y: y, width: width, height: height)
@@ -195,6 +223,20 @@ open class SDLKitGUIAgent {
     }
 
     // MARK: - Geometry batches
+    /// Draws tessellated vector shapes in one geometry call; see `SDLRenderer.drawShapes`.
+    open func drawShapes(windowId: Int, antialiased: Bool = true, _ build: (inout VectorBatch) throws -> Void) throws {
+        guard let bundle = windows[windowId] else { throw AgentError.windowNotFound }
+        try bundle.renderer.drawShapes(antialiased: antialiased, build)
+    }
+
+    /// Executes a draw batch on the window it names; returns the draw calls issued.
+    @discardableResult
+    open func executeBatch(_ batch: DrawBatch) throws -> Int {
+        guard let bundle = windows[batch.windowId] else { throw AgentError.windowNotFound }
+        SDLLogger.debug("SDLKit.Agent", "executeBatch id=\(batch.windowId) commands=\(batch.commands.count) ops=\(batch.ops.count)")
+        return try bundle.renderer.execute(batch)
+    }
+
     public func drawPoints(windowId: Int, points: [(Int, Int)], color: UInt32) throws {
         guard let bundle = windows[windowId] else { throw AgentError.windowNotFound }
         try bundle.renderer.drawPoints(points, color: color)
@@ -260,6 +302,19 @@ open class SDLKitGUIAgent {
         return try bundle.renderer.capturePNGScreenshot()
     }
 
+    /// The window's current pixels as ABGR8888 (R, G, B, A bytes on little-endian hosts).
+    open func captureFramePixels(windowId: Int) throws -> (pixels: [UInt8], width: Int, height: Int, pitch: Int) {
+        guard let bundle = windows[windowId] else { throw AgentError.windowNotFound }
+        let capture = try bundle.renderer.capturePixelBuffer()
+        return (capture.buffer, capture.width, capture.height, capture.pitch)
+    }
+
+    /// PNG file bytes for the window, without the base64 envelope.
+    open func screenshotPNGData(windowId: Int) throws -> Data {
+        guard let bundle = windows[windowId] else { throw AgentError.windowNotFound }
+        return try bundle.renderer.capturePNGData().data
+    }
+
     // New tools: clear, line, circle
     public func clear(windowId: Int, color: UInt32) throws {
         guard let bundle = windows[windowId] else { throw AgentError.windowNotFound }
@@ -306,30 +361,98 @@ open class SDLKitGUIAgent {
         }
     }
 
+    /// Returns the next event for `windowId`, waiting up to `timeoutMs` for SDL to deliver one.
+    /// Events for other windows arriving meanwhile are routed to their rings and the wait
+    /// continues until the deadline. Reads the same ring as `events(windowId:since:limit:)`,
+    /// with a cursor of its own.
     public func captureEvent(windowId: Int, timeoutMs: Int? = nil) throws -> Event? {
         guard windows[windowId] != nil else { throw AgentError.windowNotFound }
+        pumpEvents()
+        if let event = takeCapturedEvent(windowId) { return event }
         #if !HEADLESS_CI && canImport(CSDL3)
-        var out = SDLKit_Event(type: 0, x: 0, y: 0, keycode: 0, button: 0)
-        let got: Int32
         if let t = timeoutMs, t > 0 {
-            got = Int32(SDLKit_WaitEventTimeout(&out, Int32(t)))
-        } else {
-            got = Int32(SDLKit_PollEvent(&out))
+            let deadline = DispatchTime.now().uptimeNanoseconds + UInt64(t) * 1_000_000
+            while true {
+                let now = DispatchTime.now().uptimeNanoseconds
+                if now >= deadline { break }
+                let remainingMs = Int32(clamping: (deadline - now + 999_999) / 1_000_000)
+                var out = SDLKit_Event()
+                if SDLKit_WaitEventTimeout(&out, remainingMs) != 0 {
+                    route(out)
+                    pumpEvents()
+                    if let event = takeCapturedEvent(windowId) { return event }
+                }
+            }
         }
-        if got == 0 { return nil }
-        let type = Int32(bitPattern: out.type)
-        switch type {
-        case Int32(SDLKIT_EVENT_KEY_DOWN): return Event(type: .keyDown, key: String(out.keycode))
-        case Int32(SDLKIT_EVENT_KEY_UP): return Event(type: .keyUp, key: String(out.keycode))
-        case Int32(SDLKIT_EVENT_MOUSE_DOWN): return Event(type: .mouseDown, x: Int(out.x), y: Int(out.y), button: Int(out.button))
-        case Int32(SDLKIT_EVENT_MOUSE_UP): return Event(type: .mouseUp, x: Int(out.x), y: Int(out.y), button: Int(out.button))
-        case Int32(SDLKIT_EVENT_MOUSE_MOVE): return Event(type: .mouseMove, x: Int(out.x), y: Int(out.y))
-        case Int32(SDLKIT_EVENT_QUIT): return Event(type: .quit)
-        case Int32(SDLKIT_EVENT_WINDOW_CLOSED): return Event(type: .windowClosed)
-        default: return nil
+        #endif
+        return takeCapturedEvent(windowId)
+    }
+
+    /// Everything that arrived for `windowId` after `cursor` (at most `limit` events), in one
+    /// batch. Pass the returned cursor back to continue; 0 starts at the oldest retained event.
+    public func events(windowId: Int, since cursor: UInt64 = 0, limit: Int? = nil) throws -> EventBatch {
+        guard windows[windowId] != nil else { throw AgentError.windowNotFound }
+        if let limit, limit <= 0 { throw AgentError.invalidArgument("limit must be > 0") }
+        pumpEvents()
+        let batch = (eventRings[windowId] ?? AgentEventRing()).events(since: cursor, limit: limit ?? .max)
+        return EventBatch(events: batch.events, cursor: batch.cursor, gap: batch.gap)
+    }
+
+    public struct EventBatch: Equatable {
+        public var events: [Event]
+        public var cursor: UInt64
+        /// Some events after the requested cursor were evicted before they were read.
+        public var gap: Bool
+    }
+
+    /// Drains SDL's event queue into the per-window rings, up to `eventPollBatch` events per
+    /// FFI call. Runs after every present and before every event read.
+    public func pumpEvents() {
+        #if !HEADLESS_CI && canImport(CSDL3)
+        let profile = SDLProfiler.begin("agent.pumpEvents")
+        defer { profile.end() }
+        var batch = [SDLKit_Event](repeating: SDLKit_Event(), count: Self.eventPollBatch)
+        while true {
+            let count = Int(batch.withUnsafeMutableBufferPointer { SDLKit_PollEvents($0.baseAddress, Int32($0.count)) })
+            for raw in batch.prefix(count) { route(raw) }
+            if count < batch.count { break }
         }
-        #else
-        return nil
         #endif
     }
+
+    static let eventPollBatch = 64
+
+    /// Appends `event` to the ring of the window SDL knows as `sdlWindowID`, or to every ring
+    /// for application-wide events (id 0). Events for windows the agent did not open are dropped.
+    func deliver(_ event: Event, toSDLWindow sdlWindowID: UInt32) {
+        if sdlWindowID == 0 {
+            for id in windows.keys { eventRings[id, default: AgentEventRing()].append(event) }
+        } else if let id = windows.first(where: { $0.value.sdlWindowID == sdlWindowID })?.key {
+            eventRings[id, default: AgentEventRing()].append(event)
+        }
+    }
+
+    private func takeCapturedEvent(_ windowId: Int) -> Event? {
+        guard let ring = eventRings[windowId] else { return nil }
+        let batch = ring.events(since: captureCursors[windowId] ?? 0, limit: 1)
+        captureCursors[windowId] = batch.cursor
+        return batch.events.first
+    }
+
+    #if !HEADLESS_CI && canImport(CSDL3)
+    private func route(_ raw: SDLKit_Event) {
+        let event: Event
+        switch Int32(bitPattern: raw.type) {
+        case Int32(SDLKIT_EVENT_KEY_DOWN): event = Event(type: .keyDown, key: String(raw.keycode))
+        case Int32(SDLKIT_EVENT_KEY_UP): event = Event(type: .keyUp, key: String(raw.keycode))
+        case Int32(SDLKIT_EVENT_MOUSE_DOWN): event = Event(type: .mouseDown, x: Int(raw.x), y: Int(raw.y), button: Int(raw.button))
+        case Int32(SDLKIT_EVENT_MOUSE_UP): event = Event(type: .mouseUp, x: Int(raw.x), y: Int(raw.y), button: Int(raw.button))
+        case Int32(SDLKIT_EVENT_MOUSE_MOVE): event = Event(type: .mouseMove, x: Int(raw.x), y: Int(raw.y))
+        case Int32(SDLKIT_EVENT_QUIT): event = Event(type: .quit)
+        case Int32(SDLKIT_EVENT_WINDOW_CLOSED): event = Event(type: .windowClosed)
+        default: return
+        }
+        deliver(event, toSDLWindow: raw.window_id)
+    }
+    #endif
 }
@@ -53,6 +53,8 @@ final class AudioA2MStream: @unchecked Sendable {
             if let cpu = featCPU {
                 let res = cpu.readMel(frames: 32, melBands: cpu.melBands)
                 if res.frames > 0 {
+                    let profile = SDLProfiler.begin("audio.a2mStream")
+                    defer { profile.end() }
                     var framesMel: [[Float]] = []
                     framesMel.reserveCapacity(res.frames)
                     for i in 0..<res.frames { let s = i * cpu.melBands; framesMel.append(Array(res.mel[s..<(s+cpu.melBands)])) }
@@ -69,6 +71,8 @@ final class AudioA2MStream: @unchecked Sendable {
                 var raw = Array(repeating: Float(0), count: 32 * hs * chans)
                 let read = sess.pump.readFrames(into: &raw)
                 if read > 0 {
+                    let profile = SDLProfiler.begin("audio.a2mStream")
+                    defer { profile.end() }
                     var mono: [Float] = overlapMono; mono.reserveCapacity(overlapMono.count + read)
                     for i in 0..<read { var acc: Float = 0; for c in 0..<chans { acc += raw[i*chans + c] }; mono.append(acc / Float(chans)) }
                     var windows: [[Float]] = []
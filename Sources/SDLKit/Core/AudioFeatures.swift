@@ -229,6 +229,8 @@ public final class AudioFeaturePump: @unchecked Sendable {
             var hop = Array(repeating: Float(0), count: hopSize * channels)
             let got = pump.readFrames(into: &hop)
             if got == 0 { continue }
+            let profile = SDLProfiler.begin("audio.featurePump")
+            defer { profile.end() }
             if got < hopSize {
                 hop.removeSubrange(got*channels..<hop.count)
             }
@@ -77,8 +77,10 @@ public final class AudioGPUFeatureExtractor {
         let total = fcount * nBins
         let tgSize = 64
         let groups = (total + tgSize - 1) / tgSize
-        try backend.dispatchCompute(computeDFT, groupsX: groups, groupsY: 1, groupsZ: 1, bindings: bindings)
-        try backend.waitGPU()
+        // DFT and mel projection go out as one submission; the mel pass waits on the power
+        // buffer through a barrier instead of a CPU round trip.
+        var list = ComputeCommandList(label: "audio_features")
+        list.dispatch(computeDFT, groupsX: groups, bindings: bindings)
 
         // If mel compute is available, run it; else read back power and project on CPU
         if let melPipe = computeMel, let wbuf = melWeightsBuffer {
@@ -94,8 +96,8 @@ public final class AudioGPUFeatureExtractor {
             melBindings.materialConstants = BindingSet.MaterialConstants(data: mpbytes)
             let totalMel = fcount * melBands
             let melGroups = (totalMel + tgSize - 1) / tgSize
-            try backend.dispatchCompute(melPipe, groupsX: melGroups, groupsY: 1, groupsZ: 1, bindings: melBindings)
-            try backend.waitGPU()
+            list.dispatch(melPipe, groupsX: melGroups, bindings: melBindings)
+            try backend.submitCompute(list).wait()
             var flat = Array(repeating: Float(0), count: melCount)
             try flat.withUnsafeMutableBytes { raw in
                 try backend.readback(buffer: outMelBuf, into: raw.baseAddress!, length: melBytes)
@@ -108,6 +110,7 @@ public final class AudioGPUFeatureExtractor {
             for i in 0..<fcount { let s = i * melBands; result.append(Array(flat[s..<(s+melBands)])) }
             return result
         } else {
+            try backend.submitCompute(list).wait()
             var power = Array(repeating: Float(0), count: outputCount)
             try power.withUnsafeMutableBytes { raw in
                 try backend.readback(buffer: powerBuf, into: raw.baseAddress!, length: outputBytes)
@@ -153,9 +156,10 @@ public final class AudioGPUFeatureExtractor {
             var params = [UInt32(melBands), UInt32(fcount), UInt32(hasPrev), 0]
             let pbytes = Data(bytes: &params, count: MemoryLayout<UInt32>.size * 4)
             bindings.materialConstants = BindingSet.MaterialConstants(data: pbytes)
-            // one thread per frame
-            try backend.dispatchCompute(try backend.makeComputePipeline(.init(label: "audio_onset_flux", shader: ShaderID("audio_onset_flux"))), groupsX: fcount, groupsY: 1, groupsZ: 1, bindings: bindings)
-            try backend.waitGPU()
+            // one thread per frame, submitted as a list so the readback waits on its fence alone
+            var list = ComputeCommandList(label: "audio_onset_flux")
+            list.dispatch(try backend.makeComputePipeline(.init(label: "audio_onset_flux", shader: ShaderID("audio_onset_flux"))), groupsX: fcount, bindings: bindings)
+            try backend.submitCompute(list).wait()
             var onset = Array(repeating: Float(0), count: fcount)
             try onset.withUnsafeMutableBytes { raw in
                 try backend.readback(buffer: outBuf, into: raw.baseAddress!, length: outBytes)
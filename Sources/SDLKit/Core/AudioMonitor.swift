@@ -36,6 +36,8 @@ public final class AudioMonitor: @unchecked Sendable {
         while running {
             let got = pump.readFrames(into: &buf)
             if got > 0 {
+                let profile = SDLProfiler.begin("audio.monitor")
+                defer { profile.end() }
                 let samples = Array(buf.prefix(got * cap.spec.channels))
                 if let r = resampler {
                     if let out = try? r.convert(samples: samples) { queue.enqueue(samples: out) }
@@ -132,6 +132,14 @@ public final class SDLAudioChunkedCapturePump: @unchecked Sendable {
         } / channels
     }
 
+    /// Whole frames buffered and ready to read.
+    public var availableFrames: Int { ring.availableToRead / channels }
+
+    /// Reads interleaved frames straight into `dst` (for example, a transport's output buffer).
+    public func readFrames(into dst: UnsafeMutableBufferPointer<Float>) -> Int {
+        ring.read(into: dst) / channels
+    }
+
     private func threadLoop() {
         let temp = Array(repeating: Float(0), count: 4096)
         while running {
@@ -140,6 +148,8 @@ public final class SDLAudioChunkedCapturePump: @unchecked Sendable {
                 Thread.sleep(forTimeInterval: 0.002)
                 continue
             }
+            let profile = SDLProfiler.begin("audio.capturePump")
+            defer { profile.end() }
             let wantFrames = min(availFrames, temp.count / channels)
             if wantFrames > 0 {
                 var arr = Array(repeating: Float(0), count: wantFrames * channels)
@@ -0,0 +1,245 @@
+import Foundation
+
+// Glyph atlases for `SDLRenderer.drawText`.
+//
+// Each (font, size) keeps a few atlas pages. Glyphs are rasterized once, packed into a page
+// with a skyline packer and reused on every draw; strings are laid out as textured quads and
+// submitted as one geometry draw per page. When every page is full the least recently drawn
+// page is cleared and repacked, so the atlas stays bounded however many distinct glyphs an
+// overlay shows over time.
+
+/// Bottom-left skyline rectangle packer. The skyline is the top edge of everything packed so
+/// far, stored as horizontal segments; a rectangle goes where it rests lowest.
+struct SkylinePacker {
+    private struct Segment {
+        var x: Int
+        var y: Int
+        var width: Int
+    }
+
+    let width: Int
+    let height: Int
+    private var skyline: [Segment]
+    private(set) var usedArea = 0
+
+    init(width: Int, height: Int) {
+        self.width = width
+        self.height = height
+        self.skyline = [Segment(x: 0, y: 0, width: width)]
+    }
+
+    mutating func reset() {
+        skyline = [Segment(x: 0, y: 0, width: width)]
+        usedArea = 0
+    }
+
+    /// Reserves a `w`×`h` rectangle and returns its origin, or nil when it does not fit.
+    mutating func pack(width w: Int, height h: Int) -> (x: Int, y: Int)? {
+        guard w > 0, h > 0, w <= width, h <= height else { return nil }
+        var best: (index: Int, y: Int, waste: Int)?
+        for index in skyline.indices {
+            guard let candidate = fit(at: index, width: w, height: h) else { continue }
+            if let current = best, (candidate.y, candidate.waste) >= (current.y, current.waste) { continue }
+            best = (index, candidate.y, candidate.waste)
+        }
+        guard let best else { return nil }
+        let x = skyline[best.index].x
+        place(Segment(x: x, y: best.y + h, width: w), at: best.index)
+        usedArea += w * h
+        return (x, best.y)
+    }
+
+    /// Where a rectangle starting at segment `index` would rest, and the area it would leave
+    /// unusable underneath.
+    private func fit(at index: Int, width w: Int, height h: Int) -> (y: Int, waste: Int)? {
+        let x = skyline[index].x
+        guard x + w <= width else { return nil }
+        var y = 0
+        var remaining = w
+        var i = index
+        while remaining > 0 {
+            y = max(y, skyline[i].y)
+            guard y + h <= height else { return nil }
+            remaining -= skyline[i].width
+            i += 1
+        }
+        var waste = 0
+        remaining = w
+        i = index
+        while remaining > 0 {
+            let span = min(remaining, skyline[i].width)
+            waste += (y - skyline[i].y) * span
+            remaining -= span
+            i += 1
+        }
+        return (y, waste)
+    }
+
+    private mutating func place(_ segment: Segment, at index: Int) {
+        skyline.insert(segment, at: index)
+        let right = segment.x + segment.width
+        // Trim or drop the segments now covered by the new one.
+        let next = index + 1
+        while next < skyline.count, skyline[next].x < right {
+            let overlap = right - skyline[next].x
+            if overlap >= skyline[next].width {
+                skyline.remove(at: next)
+            } else {
+                skyline[next].x += overlap
+                skyline[next].width -= overlap
+                break
+            }
+        }
+        // Merge neighbours at the same height.
+        var i = 0
+        while i + 1 < skyline.count {
+            if skyline[i].y == skyline[i + 1].y {
+                skyline[i].width += skyline[i + 1].width
+                skyline.remove(at: i + 1)
+            } else {
+                i += 1
+            }
+        }
+    }
+}
+
+/// Glyph placement across a bounded set of atlas pages for one (font, size). `Page` is the
+/// backing texture; the atlas only tracks where glyphs live and which page to recycle.
+struct GlyphAtlas<Page> {
+    struct Glyph: Equatable {
+        /// Index into `pages`, or -1 for blank glyphs (spaces) that only advance the pen.
+        let page: Int
+        let x: Int
+        let y: Int
+        let width: Int
+        let height: Int
+        let advance: Int
+    }
+
+    private struct PageState {
+        let page: Page
+        var packer: SkylinePacker
+        var lastUse: UInt64
+        var codepoints: [UInt32] = []
+    }
+
+    /// Transparent border kept around each glyph so filtering never samples a neighbour.
+    static var padding: Int { 1 }
+
+    let pageSize: Int
+    let maxPages: Int
+    private var pageStates: [PageState] = []
+    private var glyphs: [UInt32: Glyph] = [:]
+    private var clock: UInt64 = 0
+    private(set) var evictions = 0
+
+    init(pageSize: Int = 512, maxPages: Int = 4) {
+        self.pageSize = max(16, pageSize)
+        self.maxPages = max(1, maxPages)
+    }
+
+    var pages: [Page] { pageStates.map(\.page) }
+    func page(at index: Int) -> Page { pageStates[index].page }
+    var glyphCount: Int { glyphs.count }
+
+    /// Starts a draw; pages touched from here on count as most recently used.
+    mutating func beginDraw() {
+        clock &+= 1
+    }
+
+    /// A glyph already in the atlas, marking its page as used by the current draw.
+    mutating func glyph(for codepoint: UInt32) -> Glyph? {
+        guard let glyph = glyphs[codepoint] else { return nil }
+        if glyph.page >= 0 { pageStates[glyph.page].lastUse = clock }
+        return glyph
+    }
+
+    /// Reserves room for a `width`×`height` glyph, creating pages up to `maxPages` and then
+    /// recycling the least recently drawn one. `recycle` runs before a page's glyphs are
+    /// forgotten, so the caller can flush pending quads that sample it and clear it. Glyphs
+    /// larger than a page are rejected; empty ones are stored as blanks.
+    mutating func insert(_ codepoint: UInt32, width: Int, height: Int, advance: Int,
+                         makePage: () throws -> Page, recycle: (Int, Page) throws -> Void) throws -> Glyph? {
+        if width <= 0 || height <= 0 { return insertBlank(codepoint, advance: advance) }
+        let padded = (width + 2 * Self.padding, height + 2 * Self.padding)
+        guard padded.0 <= pageSize, padded.1 <= pageSize else { return nil }
+        var placement: (page: Int, x: Int, y: Int)?
+        for index in pageStates.indices {
+            if let origin = pageStates[index].packer.pack(width: padded.0, height: padded.1) {
+                placement = (index, origin.x, origin.y)
+                break
+            }
+        }
+        if placement == nil, pageStates.count < maxPages {
+            pageStates.append(PageState(page: try makePage(), packer: SkylinePacker(width: pageSize, height: pageSize), lastUse: clock))
+            let index = pageStates.count - 1
+            if let origin = pageStates[index].packer.pack(width: padded.0, height: padded.1) {
+                placement = (index, origin.x, origin.y)
+            }
+        }
+        if placement == nil, let index = pageStates.indices.min(by: { pageStates[$0].lastUse < pageStates[$1].lastUse }) {
+            try recycle(index, pageStates[index].page)
+            for codepoint in pageStates[index].codepoints { glyphs[codepoint] = nil }
+            pageStates[index].codepoints.removeAll()
+            pageStates[index].packer.reset()
+            evictions += 1
+            if let origin = pageStates[index].packer.pack(width: padded.0, height: padded.1) {
+                placement = (index, origin.x, origin.y)
+            }
+        }
+        guard let placement else { return nil }
+        let glyph = Glyph(page: placement.page, x: placement.x + Self.padding, y: placement.y + Self.padding,
+                          width: width, height: height, advance: advance)
+        glyphs[codepoint] = glyph
+        pageStates[placement.page].codepoints.append(codepoint)
+        pageStates[placement.page].lastUse = clock
+        return glyph
+    }
+
+    /// Remembers a glyph that only advances the pen.
+    @discardableResult
+    mutating func insertBlank(_ codepoint: UInt32, advance: Int) -> Glyph {
+        let blank = Glyph(page: -1, x: 0, y: 0, width: 0, height: 0, advance: advance)
+        glyphs[codepoint] = blank
+        return blank
+    }
+
+    /// Forgets every glyph and returns the pages for release.
+    mutating func removeAll() -> [Page] {
+        let released = pages
+        pageStates.removeAll()
+        glyphs.removeAll()
+        return released
+    }
+}
+
+/// Textured quads for one geometry draw: interleaved x, y, r, g, b, a, u, v vertices (the
+/// layout `SDLKit_RenderGeometry` expects) and 32-bit triangle indices.
+struct TextQuadBatch {
+    static var floatsPerVertex: Int { 8 }
+
+    private(set) var vertices: [Float] = []
+    private(set) var indices: [Int32] = []
+
+    var isEmpty: Bool { indices.isEmpty }
+    var quadCount: Int { indices.count / 6 }
+    var vertexCount: Int { vertices.count / Self.floatsPerVertex }
+
+    /// Appends a quad covering `rect` on screen and `uv` (normalized) in the texture.
+    mutating func appendQuad(x: Float, y: Float, width: Float, height: Float,
+                             u0: Float, v0: Float, u1: Float, v1: Float, color: SIMD4<Float>) {
+        let base = Int32(vertexCount)
+        let corners: [(Float, Float, Float, Float)] = [
+            (x, y, u0, v0), (x + width, y, u1, v0), (x + width, y + height, u1, v1), (x, y + height, u0, v1)
+        ]
+        for (px, py, u, v) in corners {
+            vertices.append(contentsOf: [px, py, color.x, color.y, color.z, color.w, u, v])
+        }
+        indices.append(contentsOf: [base, base + 1, base + 2, base, base + 2, base + 3])
+    }
+
+    mutating func removeAll() {
+        vertices.removeAll(keepingCapacity: true)
+        indices.removeAll(keepingCapacity: true)
+    }
+}
@@ -254,11 +254,17 @@ public final class SDLAudioPlaybackQueue: @unchecked Sendable {
         samples.withUnsafeBufferPointer { _ = ring.write($0) }
     }
 
+    public func enqueue(samples: UnsafeBufferPointer<Float>) {
+        _ = ring.write(samples)
+    }
+
     private func runLoop() {
         var buf = Array(repeating: Float(0), count: chunkFrames * channels)
         while running {
             let read = buf.withUnsafeMutableBufferPointer { ring.read(into: $0) }
             if read > 0 {
+                let profile = SDLProfiler.begin("audio.playbackQueue")
+                defer { profile.end() }
                 let bytes = read * MemoryLayout<Float>.size
                 buf.withUnsafeBytes { raw in
                     try? playback.queue(samples: UnsafeRawBufferPointer(start: raw.baseAddress, count: bytes))
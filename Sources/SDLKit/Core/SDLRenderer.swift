@@ -17,7 +17,17 @@ public final class SDLRenderer {
     internal private(set) var didShutdown = false
     #if canImport(CSDL3) && !HEADLESS_CI
     internal var handle: UnsafeMutableRawPointer?
+    /// Ids bound to a resident texture.
     internal var textures: [String: UnsafeMutableRawPointer] = [:]
+    private var textureBindings: [String: TextureBinding] = [:]
+    private var textureCache = TextureCache<UnsafeMutableRawPointer>(byteBudget: SDLKitConfig.textureCacheBudgetBytes)
+    private let decodeInbox = TextureDecodeInbox()
+    private var decodeGeneration: UInt64 = 0
+    private var glyphAtlases: [FontKey: GlyphAtlas<UnsafeMutableRawPointer>] = [:]
+    /// Nonzero while a draw batch runs; draws then leave presenting to the batch.
+    private var presentSuppressed = 0
+    /// Reused by `drawShapes`, so per-frame overlays keep their vertex buffers.
+    private var vectorBatch = VectorBatch()
     #endif
 
     public init(width: Int, height: Int, window: SDLWindow) throws {
@@ -43,10 +53,18 @@ public final class SDLRenderer {
     public func shutdown() {
         if didShutdown { return }
         #if canImport(CSDL3) && !HEADLESS_CI
-        for texture in textures.values {
+        for decoded in decodeInbox.close() {
+            if let surface = decoded.surface { SDLKit_DestroySurface(surface) }
+        }
+        for texture in Set(textures.values).union(textureCache.removeAll()) {
             SDLKit_DestroyTexture(texture)
         }
         textures.removeAll(keepingCapacity: false)
+        textureBindings.removeAll(keepingCapacity: false)
+        for key in Array(glyphAtlases.keys) {
+            for page in glyphAtlases[key]?.removeAll() ?? [] { SDLKit_DestroyTexture(page) }
+        }
+        glyphAtlases.removeAll(keepingCapacity: false)
         if let renderer = handle {
             SDLKit_DestroyRenderer(renderer)
             handle = nil
@@ -60,10 +78,18 @@ public final class SDLRenderer {
 
     public func present() {
         #if canImport(CSDL3) && !HEADLESS_CI
+        processPendingTextureUploads()
         if let r = handle { SDLKit_RenderPresent(r) }
         #endif
     }
 
+    #if canImport(CSDL3) && !HEADLESS_CI
+    /// Presents after a draw under the `auto` policy, except while a batch is executing.
+    private func autoPresent(_ r: UnsafeMutableRawPointer) {
+        if presentSuppressed == 0 && SDLKitConfig.presentPolicy == .auto { SDLKit_RenderPresent(r) }
+    }
+    #endif
+
     public func drawRectangle(x: Int, y: Int, width: Int, height: Int, color: UInt32) throws {
         #if canImport(CSDL3) && !HEADLESS_CI
         guard let r = handle else { throw AgentError.internalError("Renderer not created") }
@@ -78,7 +104,7 @@ public final class SDLRenderer {
         if SDLKit_RenderFillRect(r, &rect) != 0 {
             throw AgentError.internalError(SDLCore.lastError())
         }
-        if SDLKitConfig.presentPolicy == .auto { SDLKit_RenderPresent(r) }
+        autoPresent(r)
         #else
         throw AgentError.sdlUnavailable
         #endif
@@ -97,7 +123,7 @@ public final class SDLRenderer {
         if SDLKit_RenderClear(r) != 0 {
             throw AgentError.internalError(SDLCore.lastError())
         }
-        if SDLKitConfig.presentPolicy == .auto { SDLKit_RenderPresent(r) }
+        autoPresent(r)
         #else
         throw AgentError.sdlUnavailable
         #endif
@@ -127,121 +153,294 @@ public final class SDLRenderer {
             if e2 >= dy { err += dy; x0 += sx }
             if e2 <= dx { err += dx; y0 += sy }
         }
-        if SDLKitConfig.presentPolicy == .auto { SDLKit_RenderPresent(r) }
+        autoPresent(r)
         #else
         throw AgentError.sdlUnavailable
         #endif
     }
 
+    /// Fills a circle of `radius` pixels around (cx, cy), tessellated and drawn in one
+    /// geometry call rather than one fill per scanline.
     public func drawCircleFilled(cx: Int, cy: Int, radius: Int, color: UInt32) throws {
-        #if canImport(CSDL3) && !HEADLESS_CI
         guard radius >= 0 else { throw AgentError.invalidArgument("radius must be >= 0") }
-        guard let r = handle else { throw AgentError.internalError("Renderer not created") }
-        let a = UInt8((color >> 24) & 0xFF)
-        let rr = UInt8((color >> 16) & 0xFF)
-        let gg = UInt8((color >> 8) & 0xFF)
-        let bb = UInt8(color & 0xFF)
-        if SDLKit_SetRenderDrawColor(r, rr, gg, bb, a) != 0 {
-            throw AgentError.internalError(SDLCore.lastError())
+        // Pixel centers sit at +0.5; the extra half pixel keeps the rim pixels covered.
+        try drawShapes(antialiased: false) {
+            $0.fillCircle(cx: Float(cx) + 0.5, cy: Float(cy) + 0.5, radius: Float(radius) + 0.5, color: color)
         }
-        var x = radius
-        var y = 0
-        var err = 1 - x
-        func drawSpan(_ cx: Int, _ cy: Int, _ x: Int, _ y: Int) throws {
-            let x0 = cx - x
-            let w0 = 2 * x + 1
-            var rect1 = SDL_FRect(x: Float(x0), y: Float(cy + y), w: Float(w0), h: 1)
-            var rect2 = SDL_FRect(x: Float(x0), y: Float(cy - y), w: Float(w0), h: 1)
-            if SDLKit_RenderFillRect(r, &rect1) != 0 { throw AgentError.internalError(SDLCore.lastError()) }
-            if y != 0 {
-                if SDLKit_RenderFillRect(r, &rect2) != 0 { throw AgentError.internalError(SDLCore.lastError()) }
-            }
-        }
-        while x >= y {
-            try drawSpan(cx, cy, x, y)
-            y += 1
-            if err < 0 {
-                err += 2 * y + 1
-            } else {
-                x -= 1
-                err += 2 * (y - x + 1)
-            }
-        }
-        if SDLKitConfig.presentPolicy == .auto { SDLKit_RenderPresent(r) }
+    }
+
+    // MARK: - Vector shapes
+
+    /// Tessellates the shapes `build` adds (circles, arcs, thick polylines, rounded rects; see
+    /// `VectorBatch`) and draws them in one `SDLKit_RenderGeometry` call, in the order added.
+    /// `antialiased` adds a one-pixel feathered fringe to every edge.
+    public func drawShapes(antialiased: Bool = true, _ build: (inout VectorBatch) throws -> Void) throws {
+        #if canImport(CSDL3) && !HEADLESS_CI
+        guard let r = handle else { throw AgentError.internalError("Renderer not created") }
+        // Work on the stored batch moved out of `self`, so `build` may call back into the
+        // renderer; its buffers keep their capacity from frame to frame.
+        var batch = vectorBatch
+        vectorBatch = VectorBatch()
+        defer { vectorBatch = batch }
+        batch.removeAll()
+        batch.feather = antialiased ? 1 : 0
+        try build(&batch)
+        guard !batch.isEmpty else { return }
+        let profile = SDLProfiler.begin("vector.draw", detail: "\(batch.triangleCount) triangles")
+        defer { profile.end() }
+        try Self.submitGeometry(batch.vertices, vertexCount: batch.vertexCount, indices: batch.indices, texture: nil, renderer: r)
+        autoPresent(r)
         #else
         throw AgentError.sdlUnavailable
         #endif
     }
 
     // MARK: - Textures
+    //
+    // Textures are cached per renderer by path and content hash, so ids that load the same
+    // file share one upload, and resident bytes are held to `SDLKitConfig.textureCacheBudgetBytes`
+    // by evicting the least recently drawn. An id stays valid after its texture is evicted or
+    // while it is still decoding: draws show a placeholder and the file decodes again in the
+    // background.
+
+    private struct TextureBinding {
+        let path: String
+        /// The resident texture; nil while decoding or after eviction.
+        var key: TextureCacheKey?
+        var pendingGeneration: UInt64?
+        var failure: String?
+    }
+
+    public struct TextureCacheStats: Codable, Sendable {
+        public let resident_bytes: Int
+        public let budget_bytes: Int
+        public let cached_textures: Int
+        public let bound_ids: Int
+        public let pending_ids: Int
+    }
+
+    private static let decodeQueue = DispatchQueue(label: "sdlkit.texture.decode", qos: .userInitiated, attributes: .concurrent)
+
     public func loadTexture(id: String, path: String) throws {
         #if canImport(CSDL3) && !HEADLESS_CI
         guard let r = handle else { throw AgentError.internalError("Renderer not created") }
-        if let existing = textures[id] { SDLKit_DestroyTexture(existing) }
-        // Try SDL_image if available for non-BMP formats; fall back to BMP
-        #if canImport(CSDL3IMAGE)
-        let ext = (path as NSString).pathExtension.lowercased()
-        let useIMG = ext != "bmp"
-        let surf: UnsafeMutableRawPointer? = {
-            if useIMG {
-                if let s = SDLKit_IMG_Load(path) { return UnsafeMutableRawPointer(s) } else { return nil }
-            } else {
-                return SDLKit_LoadBMP(path)
-            }
-        }()
+        let key = try TextureCacheKey.forFile(atPath: path)
+        unbindTexture(id)
+        let texture: UnsafeMutableRawPointer
+        if let cached = textureCache.lookup(key) {
+            texture = cached
+        } else {
+            guard let surf = Self.decodeSurface(path: path) else { throw AgentError.internalError(SDLCore.lastError()) }
+            defer { SDLKit_DestroySurface(surf) }
+            texture = try uploadTexture(surf, key: key, renderer: r)
+        }
+        textureBindings[id] = TextureBinding(path: path, key: key)
+        textures[id] = texture
         #else
-        let surf: UnsafeMutableRawPointer? = SDLKit_LoadBMP(path)
+        throw AgentError.sdlUnavailable
         #endif
-        guard let surf else { throw AgentError.internalError(SDLCore.lastError()) }
-        defer { SDLKit_DestroySurface(surf) }
-        guard let tex = SDLKit_CreateTextureFromSurface(r, surf) else { throw AgentError.internalError(SDLCore.lastError()) }
-        textures[id] = tex
+    }
+
+    /// Binds `id` to `path` and returns immediately; the file is read and decoded on a worker
+    /// pool and uploaded by `processPendingTextureUploads`. Until then draws of `id` show a
+    /// placeholder. Decode failures surface on the first draw after they land.
+    public func loadTextureAsync(id: String, path: String) throws {
+        #if canImport(CSDL3) && !HEADLESS_CI
+        guard handle != nil else { throw AgentError.internalError("Renderer not created") }
+        unbindTexture(id)
+        textureBindings[id] = TextureBinding(path: path)
+        enqueueDecode(id: id, path: path)
         #else
         throw AgentError.sdlUnavailable
         #endif
     }
 
+    /// Uploads decoded textures until `timeBudget` seconds have passed (at least one per call,
+    /// so uploads always make progress). Runs on every draw and present; returns the number of
+    /// decode results handled.
+    @discardableResult
+    public func processPendingTextureUploads(timeBudget: TimeInterval = 0.002) -> Int {
+        #if canImport(CSDL3) && !HEADLESS_CI
+        guard let r = handle else { return 0 }
+        let deadline = DispatchTime.now().uptimeNanoseconds + UInt64(max(0, timeBudget) * 1e9)
+        var handled = 0
+        while let decoded = decodeInbox.next() {
+            finishDecode(decoded, renderer: r)
+            handled += 1
+            if DispatchTime.now().uptimeNanoseconds >= deadline { break }
+        }
+        return handled
+        #else
+        return 0
+        #endif
+    }
+
+    public func textureCacheStats() -> TextureCacheStats {
+        #if canImport(CSDL3) && !HEADLESS_CI
+        return TextureCacheStats(resident_bytes: textureCache.residentBytes,
+                                 budget_bytes: textureCache.byteBudget,
+                                 cached_textures: textureCache.count,
+                                 bound_ids: textureBindings.count,
+                                 pending_ids: textureBindings.values.filter { $0.pendingGeneration != nil }.count)
+        #else
+        return TextureCacheStats(resident_bytes: 0, budget_bytes: SDLKitConfig.textureCacheBudgetBytes,
+                                 cached_textures: 0, bound_ids: 0, pending_ids: 0)
+        #endif
+    }
+
+    /// Replaces the cache budget, evicting least recently drawn textures that no longer fit.
+    public func setTextureCacheBudget(bytes: Int) {
+        #if canImport(CSDL3) && !HEADLESS_CI
+        releaseEvicted(textureCache.setByteBudget(bytes))
+        #endif
+    }
+
     public func drawTexture(id: String, x: Int, y: Int, width: Int?, height: Int?) throws {
         #if canImport(CSDL3) && !HEADLESS_CI
         guard let r = handle else { throw AgentError.internalError("Renderer not created") }
-        guard let tex = textures[id] else { throw AgentError.invalidArgument("texture not found: \(id)") }
-        var tw: Int32 = 0, th: Int32 = 0
-        SDLKit_GetTextureSize(tex, &tw, &th)
-        let w = Float(width ?? Int(tw))
-        let h = Float(height ?? Int(th))
-        var dst = SDL_FRect(x: Float(x), y: Float(y), w: w, h: h)
-        if SDLKit_RenderTexture(r, tex, nil, &dst) != 0 { throw AgentError.internalError(SDLCore.lastError()) }
-        if SDLKitConfig.presentPolicy == .auto { SDLKit_RenderPresent(r) }
+        if let tex = try resolveTexture(id, renderer: r, x: x, y: y, width: width, height: height) {
+            var tw: Int32 = 0, th: Int32 = 0
+            SDLKit_GetTextureSize(tex, &tw, &th)
+            let w = Float(width ?? Int(tw))
+            let h = Float(height ?? Int(th))
+            var dst = SDL_FRect(x: Float(x), y: Float(y), w: w, h: h)
+            if SDLKit_RenderTexture(r, tex, nil, &dst) != 0 { throw AgentError.internalError(SDLCore.lastError()) }
+        }
+        autoPresent(r)
         #else
         throw AgentError.sdlUnavailable
         #endif
     }
 
+    /// Unbinds `id`. The texture stays cached for other ids and later loads of the same file
+    /// until the budget evicts it.
     public func freeTexture(id: String) {
         #if canImport(CSDL3) && !HEADLESS_CI
-        if let tex = textures.removeValue(forKey: id) { SDLKit_DestroyTexture(tex) }
+        unbindTexture(id)
         #endif
     }
 
     public func drawTextureRotated(id: String, x: Int, y: Int, width: Int?, height: Int?, angleDegrees: Double, centerX: Float?, centerY: Float?) throws {
         #if canImport(CSDL3) && !HEADLESS_CI
         guard let r = handle else { throw AgentError.internalError("Renderer not created") }
-        guard let tex = textures[id] else { throw AgentError.invalidArgument("texture not found: \(id)") }
-        var tw: Int32 = 0, th: Int32 = 0
-        SDLKit_GetTextureSize(tex, &tw, &th)
-        let w = Float(width ?? Int(tw))
-        let h = Float(height ?? Int(th))
-        var dst = SDL_FRect(x: Float(x), y: Float(y), w: w, h: h)
-        let hasCenter: Int32 = (centerX != nil && centerY != nil) ? 1 : 0
-        let cx = centerX ?? (w * 0.5)
-        let cy = centerY ?? (h * 0.5)
-        if SDLKit_RenderTextureRotated(r, tex, nil, &dst, angleDegrees, hasCenter, cx, cy) != 0 { throw AgentError.internalError(SDLCore.lastError()) }
-        if SDLKitConfig.presentPolicy == .auto { SDLKit_RenderPresent(r) }
+        if let tex = try resolveTexture(id, renderer: r, x: x, y: y, width: width, height: height) {
+            var tw: Int32 = 0, th: Int32 = 0
+            SDLKit_GetTextureSize(tex, &tw, &th)
+            let w = Float(width ?? Int(tw))
+            let h = Float(height ?? Int(th))
+            var dst = SDL_FRect(x: Float(x), y: Float(y), w: w, h: h)
+            let hasCenter: Int32 = (centerX != nil && centerY != nil) ? 1 : 0
+            let cx = centerX ?? (w * 0.5)
+            let cy = centerY ?? (h * 0.5)
+            if SDLKit_RenderTextureRotated(r, tex, nil, &dst, angleDegrees, hasCenter, cx, cy) != 0 { throw AgentError.internalError(SDLCore.lastError()) }
+        }
+        autoPresent(r)
         #else
         throw AgentError.sdlUnavailable
         #endif
     }
 
+    #if canImport(CSDL3) && !HEADLESS_CI
+    /// Decodes an image file to a surface. Safe off the main thread: surfaces are CPU-side.
+    nonisolated private static func decodeSurface(path: String) -> UnsafeMutableRawPointer? {
+        // Try SDL_image if available for non-BMP formats; fall back to BMP
+        #if canImport(CSDL3IMAGE)
+        if (path as NSString).pathExtension.lowercased() != "bmp" {
+            if let s = SDLKit_IMG_Load(path) { return UnsafeMutableRawPointer(s) } else { return nil }
+        }
+        #endif
+        return SDLKit_LoadBMP(path)
+    }
+
+    private func enqueueDecode(id: String, path: String) {
+        decodeGeneration &+= 1
+        let generation = decodeGeneration
+        textureBindings[id]?.pendingGeneration = generation
+        let inbox = decodeInbox
+        Self.decodeQueue.async {
+            let profile = SDLProfiler.begin("texture.decode", detail: path)
+            defer { profile.end() }
+            let decoded: TextureDecodeInbox.Decoded
+            do {
+                let key = try TextureCacheKey.forFile(atPath: path)
+                if let surface = SDLRenderer.decodeSurface(path: path) {
+                    decoded = .init(id: id, generation: generation, key: key, surface: surface, error: nil)
+                } else {
+                    decoded = .init(id: id, generation: generation, key: key, surface: nil, error: String(cString: SDLKit_GetError()))
+                }
+            } catch {
+                decoded = .init(id: id, generation: generation, key: nil, surface: nil, error: "\(error)")
+            }
+            if !inbox.post(decoded), let surface = decoded.surface {
+                SDLKit_DestroySurface(surface)
+            }
+        }
+    }
+
+    private func finishDecode(_ decoded: TextureDecodeInbox.Decoded, renderer r: UnsafeMutableRawPointer) {
+        defer { if let surface = decoded.surface { SDLKit_DestroySurface(surface) } }
+        // Results for ids that were freed or reloaded since are dropped.
+        guard var binding = textureBindings[decoded.id], binding.pendingGeneration == decoded.generation else { return }
+        binding.pendingGeneration = nil
+        if let key = decoded.key, let surface = decoded.surface {
+            do {
+                let texture = try textureCache.lookup(key) ?? uploadTexture(surface, key: key, renderer: r)
+                binding.key = key
+                textures[decoded.id] = texture
+            } catch {
+                binding.failure = "\(error)"
+            }
+        } else {
+            binding.failure = decoded.error ?? "decode failed"
+        }
+        textureBindings[decoded.id] = binding
+    }
+
+    private func uploadTexture(_ surface: UnsafeMutableRawPointer, key: TextureCacheKey, renderer r: UnsafeMutableRawPointer) throws -> UnsafeMutableRawPointer {
+        guard let tex = SDLKit_CreateTextureFromSurface(r, surface) else { throw AgentError.internalError(SDLCore.lastError()) }
+        var tw: Int32 = 0, th: Int32 = 0
+        SDLKit_GetTextureSize(tex, &tw, &th)
+        releaseEvicted(textureCache.insert(tex, bytes: Int(tw) * Int(th) * 4, for: key))
+        return tex
+    }
+
+    private func releaseEvicted(_ evicted: [TextureCache<UnsafeMutableRawPointer>.Eviction]) {
+        guard !evicted.isEmpty else { return }
+        let keys = Set(evicted.map { $0.key })
+        for (id, binding) in textureBindings {
+            guard let key = binding.key, keys.contains(key) else { continue }
+            textureBindings[id]?.key = nil
+            textures[id] = nil
+        }
+        for eviction in evicted { SDLKit_DestroyTexture(eviction.handle) }
+    }
+
+    private func unbindTexture(_ id: String) {
+        textures[id] = nil
+        textureBindings[id] = nil
+    }
+
+    /// The texture to draw for `id`, or nil after drawing a placeholder in its place because
+    /// the texture is still decoding or was evicted (in which case it is decoded again).
+    private func resolveTexture(_ id: String, renderer r: UnsafeMutableRawPointer, x: Int, y: Int, width: Int?, height: Int?) throws -> UnsafeMutableRawPointer? {
+        processPendingTextureUploads()
+        if let tex = textures[id] {
+            if let key = textureBindings[id]?.key { _ = textureCache.lookup(key) }
+            return tex
+        }
+        guard let binding = textureBindings[id] else { throw AgentError.invalidArgument("texture not found: \(id)") }
+        if let failure = binding.failure { throw AgentError.internalError("texture \(id) failed to load: \(failure)") }
+        if binding.pendingGeneration == nil { enqueueDecode(id: id, path: binding.path) }
+        var pr: UInt8 = 0, pg: UInt8 = 0, pb: UInt8 = 0, pa: UInt8 = 0
+        SDLKit_GetRenderDrawColor(r, &pr, &pg, &pb, &pa)
+        defer { _ = SDLKit_SetRenderDrawColor(r, pr, pg, pb, pa) }
+        if SDLKit_SetRenderDrawColor(r, 0x40, 0x40, 0x40, 0xFF) != 0 { throw AgentError.internalError(SDLCore.lastError()) }
+        var rect = SDL_FRect(x: Float(x), y: Float(y), w: Float(width ?? 64), h: Float(height ?? 64))
+        if SDLKit_RenderFillRect(r, &rect) != 0 { throw AgentError.internalError(SDLCore.lastError()) }
+        return nil
+    }
+    #endif
+
     // MARK: - Render state queries
     public func getOutputSize() throws -> (width: Int, height: Int) {
         #if canImport(CSDL3) && !HEADLESS_CI
@@ -354,7 +553,7 @@ public final class SDLRenderer {
         try setDrawColor(color)
         var fpts = points.map { SDL_FPoint(x: Float($0.0), y: Float($0.1)) }
         if SDLKit_RenderPoints(r, &fpts, Int32(fpts.count)) != 0 { throw AgentError.internalError(SDLCore.lastError()) }
-        if SDLKitConfig.presentPolicy == .auto { SDLKit_RenderPresent(r) }
+        autoPresent(r)
         #else
         throw AgentError.sdlUnavailable
         #endif
@@ -367,7 +566,7 @@ public final class SDLRenderer {
         for (x1,y1,x2,y2) in segments {
             if SDLKit_RenderLine(r, Float(x1), Float(y1), Float(x2), Float(y2)) != 0 { throw AgentError.internalError(SDLCore.lastError()) }
         }
-        if SDLKitConfig.presentPolicy == .auto { SDLKit_RenderPresent(r) }
+        autoPresent(r)
         #else
         throw AgentError.sdlUnavailable
         #endif
@@ -380,13 +579,81 @@ public final class SDLRenderer {
         var frects = rects.map { SDL_FRect(x: Float($0.0), y: Float($0.1), w: Float($0.2), h: Float($0.3)) }
         let rc: Int32 = filled ? SDLKit_RenderFillRects(r, &frects, Int32(frects.count)) : SDLKit_RenderRects(r, &frects, Int32(frects.count))
         if rc != 0 { throw AgentError.internalError(SDLCore.lastError()) }
-        if SDLKitConfig.presentPolicy == .auto { SDLKit_RenderPresent(r) }
+        autoPresent(r)
+        #else
+        throw AgentError.sdlUnavailable
+        #endif
+    }
+
+    /// Executes a decoded `DrawBatch`: one SDL call per coalesced op, the draw color set only
+    /// when it changes, and a single present at the end when `batch.present` is set (under
+    /// either present policy). Returns the number of draw calls issued.
+    @discardableResult
+    public func execute(_ batch: DrawBatch) throws -> Int {
+        #if canImport(CSDL3) && !HEADLESS_CI
+        guard let r = handle else { throw AgentError.internalError("Renderer not created") }
+        let profile = SDLProfiler.begin("batch.execute", detail: "\(batch.commands.count) commands, \(batch.ops.count) ops")
+        defer { profile.end() }
+        presentSuppressed += 1
+        defer { presentSuppressed -= 1 }
+        var currentColor: UInt32?
+        func use(_ color: UInt32) throws {
+            guard color != currentColor else { return }
+            try setDrawColor(color)
+            currentColor = color
+        }
+        func check(_ rc: Int32) throws {
+            if rc != 0 { throw AgentError.internalError(SDLCore.lastError()) }
+        }
+        var calls = 0
+        for op in batch.ops {
+            switch op {
+            case .clear(let color):
+                try use(color)
+                try check(SDLKit_RenderClear(r))
+                calls += 1
+            case let .fillRects(color, rects), let .strokeRects(color, rects):
+                try use(color)
+                var frects = rects.map { SDL_FRect(x: $0.x, y: $0.y, w: $0.width, h: $0.height) }
+                if case .fillRects = op {
+                    try check(SDLKit_RenderFillRects(r, &frects, Int32(frects.count)))
+                } else {
+                    try check(SDLKit_RenderRects(r, &frects, Int32(frects.count)))
+                }
+                calls += 1
+            case let .points(color, points):
+                try use(color)
+                var fpts = points.map { SDL_FPoint(x: $0.x, y: $0.y) }
+                try check(SDLKit_RenderPoints(r, &fpts, Int32(fpts.count)))
+                calls += 1
+            case let .lines(color, polylines):
+                try use(color)
+                for polyline in polylines {
+                    var fpts = polyline.map { SDL_FPoint(x: $0.x, y: $0.y) }
+                    try check(SDLKit_RenderLines(r, &fpts, Int32(fpts.count)))
+                    calls += 1
+                }
+            case let .texture(id, x, y, w, h):
+                try drawTexture(id: id, x: x, y: y, width: w, height: h)
+                calls += 1
+            case let .text(text, x, y, color, size, font):
+                guard let fontPath = SDLFontResolver.resolve(fontSpec: font) else {
+                    throw AgentError.invalidArgument("No usable font (set font path or use 'system:default')")
+                }
+                try drawText(text, x: x, y: y, color: color, fontPath: fontPath, size: size ?? 16)
+                // The glyph path may leave a different draw color behind.
+                currentColor = nil
+                calls += 1
+            }
+        }
+        if batch.present { present() }
+        return calls
         #else
         throw AgentError.sdlUnavailable
         #endif
     }
 
-    private func capturePixelBuffer() throws -> (buffer: [UInt8], width: Int, height: Int, pitch: Int) {
+    func capturePixelBuffer() throws -> (buffer: [UInt8], width: Int, height: Int, pitch: Int) {
         #if canImport(CSDL3) && !HEADLESS_CI
         let (ow, oh) = try getOutputSize()
         let pitch = ow * 4
@@ -424,41 +691,44 @@ public final class SDLRenderer {
         return RawScreenshot(raw_base64: b64, width: capture.width, height: capture.height, pitch: capture.pitch, format: "ABGR8888")
     }
 
+    /// Encodes the render target as PNG in memory (see `PNGEncoder`); no SDL_image or
+    /// temporary file involved.
+    public func capturePNGData(options: PNGEncoder.Options = PNGEncoder.Options()) throws -> (data: Data, width: Int, height: Int) {
+        let capture = try capturePixelBuffer()
+        // ABGR8888 is a packed format: R, G, B, A in memory on little-endian hosts.
+        let data = try capture.buffer.withUnsafeBytes { pixels in
+            try PNGEncoder.encode(width: capture.width, height: capture.height, bytesPerRow: capture.pitch,
+                                  layout: .rgba8Unorm, pixels: pixels, options: options)
+        }
+        return (data, capture.width, capture.height)
+    }
+
     public func capturePNGScreenshot() throws -> PNGScreenshot {
+        let png = try capturePNGData()
+        return PNGScreenshot(png_base64: png.data.base64EncodedString(), width: png.width, height: png.height, format: "PNG")
+    }
+
+    /// Draws `text` with its top-left corner at (x, y); newlines start a new line. Glyphs come
+    /// from a per-(font, size) atlas (see `GlyphAtlas`), so only glyphs not drawn before are
+    /// rasterized, and each string is one geometry draw per atlas page it touches.
+    public func drawText(_ text: String, x: Int, y: Int, color: UInt32, fontPath: String, size: Int) throws {
         #if canImport(CSDL3) && !HEADLESS_CI
-        #if canImport(CSDL3IMAGE)
-        var capture = try capturePixelBuffer()
-        var pngData = Data()
-        try capture.buffer.withUnsafeMutableBytes { ptr in
-            guard let base = ptr.baseAddress else { throw AgentError.internalError("Pixel buffer unavailable") }
-            guard let surface = SDLKit_CreateSurfaceFrom(Int32(capture.width), Int32(capture.height), SDLKit_PixelFormat_ABGR8888(), base, Int32(capture.pitch)) else {
-                throw AgentError.internalError(SDLCore.lastError())
-            }
-            defer { SDLKit_DestroySurface(surface) }
-            let tempURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString).appendingPathExtension("png")
-            defer { try? FileManager.default.removeItem(at: tempURL) }
-            guard let rw = SDLKit_RWFromFile(tempURL.path, "wb") else {
-                throw AgentError.internalError(SDLCore.lastError())
-            }
-            if SDLKit_IMG_SavePNG_RW(surface, rw, 1) != 0 {
-                throw AgentError.internalError(SDLCore.lastError())
-            }
-            do {
-                pngData = try Data(contentsOf: tempURL)
-            } catch {
-                throw AgentError.internalError("Failed to read PNG data: \(error)")
-            }
-        }
-        return PNGScreenshot(png_base64: pngData.base64EncodedString(), width: capture.width, height: capture.height, format: "PNG")
-        #else
-        throw AgentError.notImplemented
-        #endif
+        guard let r = handle else { throw AgentError.internalError("Renderer not created") }
+        guard SDLKit_TTF_Available() != 0 else { throw AgentError.notImplemented }
+        try Self.ensureTTFInited()
+        let font = try Self.getFont(path: fontPath, size: size)
+        let profile = SDLProfiler.begin("text.draw", detail: "\(text.unicodeScalars.count) glyphs")
+        defer { profile.end() }
+        try drawGlyphRun(text, x: x, y: y, color: color, font: font, key: FontKey(path: fontPath, size: size), renderer: r)
+        autoPresent(r)
         #else
         throw AgentError.sdlUnavailable
         #endif
     }
 
-    public func drawText(_ text: String, x: Int, y: Int, color: UInt32, fontPath: String, size: Int) throws {
+    /// The pre-atlas text path: rasterizes and uploads the whole string on every call. Kept
+    /// for the labels-per-frame benchmark.
+    internal func drawTextRasterized(_ text: String, x: Int, y: Int, color: UInt32, fontPath: String, size: Int) throws {
         #if canImport(CSDL3) && !HEADLESS_CI
         guard let r = handle else { throw AgentError.internalError("Renderer not created") }
         guard SDLKit_TTF_Available() != 0 else { throw AgentError.notImplemented }
@@ -486,12 +756,121 @@ public final class SDLRenderer {
         if SDLKit_RenderTexture(r, texture, nil, &dst) != 0 {
             throw AgentError.internalError(SDLCore.lastError())
         }
-        if SDLKitConfig.presentPolicy == .auto { SDLKit_RenderPresent(r) }
+        autoPresent(r)
         #else
         throw AgentError.sdlUnavailable
         #endif
     }
 
+    #if canImport(CSDL3) && !HEADLESS_CI
+    private static let glyphAtlasPageSize = 512
+    private static let glyphAtlasMaxPages = 4
+
+    private func drawGlyphRun(_ text: String, x: Int, y: Int, color: UInt32, font: UnsafeMutableRawPointer,
+                              key: FontKey, renderer r: UnsafeMutableRawPointer) throws {
+        var atlas = glyphAtlases[key] ?? GlyphAtlas(pageSize: Self.glyphAtlasPageSize, maxPages: Self.glyphAtlasMaxPages)
+        defer { glyphAtlases[key] = atlas }
+        atlas.beginDraw()
+        let tint = SIMD4<Float>(Float((color >> 16) & 0xFF), Float((color >> 8) & 0xFF),
+                                Float(color & 0xFF), Float((color >> 24) & 0xFF)) / 255
+        let texel = 1 / Float(atlas.pageSize)
+        let lineHeight = Int(SDLKit_TTF_FontHeight(font))
+        // Quads per atlas page; flushed at the end, or early when a page they sample is recycled.
+        var batches: [Int: (texture: UnsafeMutableRawPointer, quads: TextQuadBatch)] = [:]
+        func flush() throws {
+            for batch in batches.values where !batch.quads.isEmpty {
+                try Self.submitGlyphQuads(batch.quads, texture: batch.texture, renderer: r)
+            }
+            batches.removeAll()
+        }
+
+        var penX = x, lineTop = y
+        var previous: UInt32?
+        for scalar in text.unicodeScalars {
+            if scalar == "\n" {
+                penX = x
+                lineTop += lineHeight
+                previous = nil
+                continue
+            }
+            let codepoint = scalar.value
+            if let previous { penX += Int(SDLKit_TTF_GlyphKerning(font, previous, codepoint)) }
+            previous = codepoint
+            var glyph = atlas.glyph(for: codepoint)
+            if glyph == nil {
+                glyph = try Self.rasterizeGlyph(codepoint, font: font, into: &atlas, renderer: r) { texture in
+                    try flush()
+                    try Self.clearAtlasPage(texture, size: Self.glyphAtlasPageSize)
+                }
+            }
+            guard let glyph else { continue }
+            if glyph.page >= 0 {
+                let texture = atlas.page(at: glyph.page)
+                var quads = batches[glyph.page]?.quads ?? TextQuadBatch()
+                quads.appendQuad(x: Float(penX), y: Float(lineTop), width: Float(glyph.width), height: Float(glyph.height),
+                                 u0: Float(glyph.x) * texel, v0: Float(glyph.y) * texel,
+                                 u1: Float(glyph.x + glyph.width) * texel, v1: Float(glyph.y + glyph.height) * texel,
+                                 color: tint)
+                batches[glyph.page] = (texture, quads)
+            }
+            penX += glyph.advance
+        }
+        try flush()
+    }
+
+    /// Renders one glyph in white (the batch tints it) and copies it into the atlas.
+    private static func rasterizeGlyph(_ codepoint: UInt32, font: UnsafeMutableRawPointer,
+                                       into atlas: inout GlyphAtlas<UnsafeMutableRawPointer>,
+                                       renderer r: UnsafeMutableRawPointer,
+                                       recycle: (UnsafeMutableRawPointer) throws -> Void) throws -> GlyphAtlas<UnsafeMutableRawPointer>.Glyph? {
+        var advance: Int32 = 0
+        let hasMetrics = SDLKit_TTF_GlyphAdvance(font, codepoint, &advance) == 0
+        // Whitespace and glyphs the font cannot render only advance the pen.
+        let isBlank = Unicode.Scalar(codepoint)?.properties.isWhitespace ?? false
+        guard !isBlank, let surf = SDLKit_TTF_RenderGlyph_Blended(font, codepoint, 0xFF, 0xFF, 0xFF, 0xFF) else {
+            return atlas.insertBlank(codepoint, advance: Int(advance))
+        }
+        defer { SDLKit_DestroySurface(surf) }
+        var w: Int32 = 0, h: Int32 = 0
+        SDLKit_GetSurfaceSize(surf, &w, &h)
+        let glyph = try atlas.insert(codepoint, width: Int(w), height: Int(h), advance: Int(hasMetrics ? advance : w),
+                                     makePage: {
+                                         guard let page = SDLKit_CreateTextureRGBA32(r, Int32(glyphAtlasPageSize), Int32(glyphAtlasPageSize)) else {
+                                             throw AgentError.internalError(SDLCore.lastError())
+                                         }
+                                         try clearAtlasPage(page, size: glyphAtlasPageSize)
+                                         return page
+                                     },
+                                     recycle: { _, page in try recycle(page) })
+        if let glyph, glyph.page >= 0,
+           SDLKit_UpdateTextureFromSurface(atlas.page(at: glyph.page), Int32(glyph.x), Int32(glyph.y), surf) != 0 {
+            throw AgentError.internalError(SDLCore.lastError())
+        }
+        return glyph
+    }
+
+    private static func clearAtlasPage(_ texture: UnsafeMutableRawPointer, size: Int) throws {
+        let zeros = [UInt8](repeating: 0, count: size * size * 4)
+        let rc = zeros.withUnsafeBytes { SDLKit_UpdateTexture(texture, 0, 0, Int32(size), Int32(size), $0.baseAddress, Int32(size * 4)) }
+        if rc != 0 { throw AgentError.internalError(SDLCore.lastError()) }
+    }
+
+    private static func submitGlyphQuads(_ quads: TextQuadBatch, texture: UnsafeMutableRawPointer, renderer r: UnsafeMutableRawPointer) throws {
+        try submitGeometry(quads.vertices, vertexCount: quads.vertexCount, indices: quads.indices, texture: texture, renderer: r)
+    }
+
+    /// One `SDLKit_RenderGeometry` call over interleaved x, y, r, g, b, a, u, v vertices.
+    private static func submitGeometry(_ vertices: [Float], vertexCount: Int, indices: [Int32],
+                                       texture: UnsafeMutableRawPointer?, renderer r: UnsafeMutableRawPointer) throws {
+        let rc = vertices.withUnsafeBufferPointer { vertices in
+            indices.withUnsafeBufferPointer { indices in
+                SDLKit_RenderGeometry(r, texture, vertices.baseAddress, Int32(vertexCount), indices.baseAddress, Int32(indices.count))
+            }
+        }
+        if rc != 0 { throw AgentError.internalError(SDLCore.lastError()) }
+    }
+    #endif
+
     #if canImport(CSDL3) && !HEADLESS_CI
     private struct FontKey: Hashable { let path: String; let size: Int }
     private static var ttfInitialized = false
@@ -273,6 +273,16 @@ public final class SDLWindow {
         #endif
     }
 
+    /// SDL's id for this window, as carried by its events; 0 while it is not open.
+    var eventWindowID: UInt32 {
+        #if canImport(CSDL3) && !HEADLESS_CI
+        guard let win = handle else { return 0 }
+        return SDLKit_GetWindowID(win)
+        #else
+        return 0
+        #endif
+    }
+
     public func center() throws {
         #if canImport(CSDL3) && !HEADLESS_CI
         guard let win = handle else { throw AgentError.internalError("Window not opened") }
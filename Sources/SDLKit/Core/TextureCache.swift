@@ -0,0 +1,159 @@
+import Foundation
+
+/// Identifies decoded image contents: the same file at the same bytes maps to one texture,
+/// however many ids are bound to it.
+struct TextureCacheKey: Hashable, Sendable {
+    let path: String
+    let contentHash: UInt64
+
+    /// FNV-1a over 64-bit little-endian words (the tail byte by byte). Cheap enough to run
+    /// on every load, and only used to tell file versions apart — not for integrity.
+    static func contentHash(of data: Data) -> UInt64 {
+        var hash: UInt64 = 0xcbf2_9ce4_8422_2325
+        let prime: UInt64 = 0x0000_0100_0000_01b3
+        data.withUnsafeBytes { raw in
+            let words = raw.count / 8
+            for i in 0..<words {
+                hash = (hash ^ UInt64(littleEndian: raw.loadUnaligned(fromByteOffset: i * 8, as: UInt64.self))) &* prime
+            }
+            for i in (words * 8)..<raw.count {
+                hash = (hash ^ UInt64(raw[i])) &* prime
+            }
+        }
+        return hash
+    }
+
+    static func forFile(atPath path: String) throws -> TextureCacheKey {
+        let data: Data
+        do {
+            data = try Data(contentsOf: URL(fileURLWithPath: path), options: .mappedIfSafe)
+        } catch {
+            throw AgentError.invalidArgument("Cannot read texture file \(path): \(error.localizedDescription)")
+        }
+        return TextureCacheKey(path: path, contentHash: contentHash(of: data))
+    }
+}
+
+/// Resident textures under a byte budget with least-recently-used eviction. Handles that
+/// fall out of the cache come back to the caller for release.
+struct TextureCache<Handle> {
+    typealias Eviction = (key: TextureCacheKey, handle: Handle)
+
+    private struct Entry {
+        let handle: Handle
+        let bytes: Int
+        var lastUse: UInt64
+    }
+
+    private(set) var byteBudget: Int
+    private(set) var residentBytes = 0
+    private var entries: [TextureCacheKey: Entry] = [:]
+    private var clock: UInt64 = 0
+
+    init(byteBudget: Int) {
+        self.byteBudget = max(0, byteBudget)
+    }
+
+    var count: Int { entries.count }
+
+    func contains(_ key: TextureCacheKey) -> Bool { entries[key] != nil }
+
+    /// The cached handle for `key`, marked as most recently used.
+    mutating func lookup(_ key: TextureCacheKey) -> Handle? {
+        guard var entry = entries[key] else { return nil }
+        clock &+= 1
+        entry.lastUse = clock
+        entries[key] = entry
+        return entry.handle
+    }
+
+    /// Caches `handle` and evicts least-recently-used entries until the cache fits the budget.
+    /// The new entry itself is never evicted, so a single texture larger than the budget stays
+    /// resident until something else displaces it. Returns the entries to release, including
+    /// a previous handle cached under the same key.
+    mutating func insert(_ handle: Handle, bytes: Int, for key: TextureCacheKey) -> [Eviction] {
+        var released: [Eviction] = []
+        if let previous = entries.removeValue(forKey: key) {
+            residentBytes -= previous.bytes
+            released.append((key, previous.handle))
+        }
+        clock &+= 1
+        entries[key] = Entry(handle: handle, bytes: max(0, bytes), lastUse: clock)
+        residentBytes += max(0, bytes)
+        released += evict(sparing: key)
+        return released
+    }
+
+    mutating func remove(_ key: TextureCacheKey) -> Handle? {
+        guard let entry = entries.removeValue(forKey: key) else { return nil }
+        residentBytes -= entry.bytes
+        return entry.handle
+    }
+
+    /// Changes the budget, returning whatever no longer fits.
+    mutating func setByteBudget(_ bytes: Int) -> [Eviction] {
+        byteBudget = max(0, bytes)
+        return evict(sparing: nil)
+    }
+
+    mutating func removeAll() -> [Handle] {
+        let handles = entries.values.map(\.handle)
+        entries.removeAll()
+        residentBytes = 0
+        return handles
+    }
+
+    private mutating func evict(sparing spared: TextureCacheKey?) -> [Eviction] {
+        guard residentBytes > byteBudget else { return [] }
+        let victims = entries.filter { $0.key != spared }.sorted { $0.value.lastUse < $1.value.lastUse }
+        var released: [Eviction] = []
+        for (key, entry) in victims where residentBytes > byteBudget {
+            entries[key] = nil
+            residentBytes -= entry.bytes
+            released.append((key, entry.handle))
+        }
+        return released
+    }
+}
+
+/// Surfaces decoded on the worker pool, waiting for the main actor to upload them. Whoever
+/// takes an entry owns its surface; once the inbox is closed, `post` refuses new entries and
+/// the worker releases the surface itself.
+final class TextureDecodeInbox: @unchecked Sendable {
+    struct Decoded: @unchecked Sendable {
+        let id: String
+        let generation: UInt64
+        let key: TextureCacheKey?
+        let surface: UnsafeMutableRawPointer?
+        let error: String?
+    }
+
+    private let lock = NSLock()
+    private var items: [Decoded] = []
+    private var closed = false
+
+    func post(_ item: Decoded) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        guard !closed else { return false }
+        items.append(item)
+        return true
+    }
+
+    /// Removes and returns the oldest decoded entry, if any.
+    func next() -> Decoded? {
+        lock.lock()
+        defer { lock.unlock() }
+        return items.isEmpty ? nil : items.removeFirst()
+    }
+
+    /// Stops accepting entries and returns the ones still waiting.
+    func close() -> [Decoded] {
+        lock.lock()
+        defer { lock.unlock() }
+        closed = true
+        let remaining = items
+        items.removeAll()
+        return remaining
+    }
+}
@@ -0,0 +1,266 @@
+import Foundation
+
+// Tessellated vector primitives for `SDLRenderer.drawShapes`.
+//
+// Shapes become colored triangles in one vertex/index buffer that is submitted with a single
+// `SDLKit_RenderGeometry` call, instead of one FFI call per scanline or segment. With a
+// nonzero `feather`, edges get a fringe whose outer vertices are fully transparent; the
+// rasterizer's color interpolation turns it into anti-aliasing. The renderer keeps one batch
+// and clears it with its capacity intact, so overlays redrawn every frame reuse their buffers.
+
+/// Colored triangles in the layout `SDLKit_RenderGeometry` expects: interleaved
+/// x, y, r, g, b, a, u, v vertices and 32-bit indices.
+public struct VectorBatch {
+    public typealias Point = SIMD2<Float>
+
+    public static var floatsPerVertex: Int { 8 }
+    /// Largest number of segments used for one curve.
+    public static var maxCurveSegments: Int { 512 }
+
+    public private(set) var vertices: [Float] = []
+    public private(set) var indices: [Int32] = []
+    /// Width in pixels of the transparent fringe added around edges; 0 draws hard edges.
+    public var feather: Float
+    /// Largest distance, in pixels, a curve's chords may stray from the true curve.
+    public var tolerance: Float
+
+    public init(feather: Float = 1, tolerance: Float = 0.25) {
+        self.feather = max(0, feather)
+        self.tolerance = max(0.01, tolerance)
+    }
+
+    public var isEmpty: Bool { indices.isEmpty }
+    public var vertexCount: Int { vertices.count / Self.floatsPerVertex }
+    public var triangleCount: Int { indices.count / 3 }
+
+    /// Drops the geometry but keeps the buffers' capacity for the next frame.
+    public mutating func removeAll() {
+        vertices.removeAll(keepingCapacity: true)
+        indices.removeAll(keepingCapacity: true)
+    }
+
+    // MARK: - Shapes
+
+    public mutating func fillCircle(cx: Float, cy: Float, radius: Float, color: UInt32) {
+        guard radius > 0 else { return }
+        fillPolygon(arcPoints(cx: cx, cy: cy, radius: radius, from: 0, to: 2 * .pi, closed: true), color: color)
+    }
+
+    public mutating func strokeCircle(cx: Float, cy: Float, radius: Float, thickness: Float, color: UInt32) {
+        guard radius > 0 else { return }
+        strokePolyline(arcPoints(cx: cx, cy: cy, radius: radius, from: 0, to: 2 * .pi, closed: true),
+                       thickness: thickness, color: color, closed: true)
+    }
+
+    /// The arc from `startDegrees` to `endDegrees`, clockwise on screen (y grows downward).
+    public mutating func strokeArc(cx: Float, cy: Float, radius: Float, startDegrees: Float, endDegrees: Float,
+                                   thickness: Float, color: UInt32) {
+        guard radius > 0, endDegrees != startDegrees else { return }
+        let points = arcPoints(cx: cx, cy: cy, radius: radius, from: Self.radians(startDegrees), to: Self.radians(endDegrees), closed: false)
+        strokePolyline(points, thickness: thickness, color: color, closed: false)
+    }
+
+    /// The pie slice between `startDegrees` and `endDegrees`.
+    public mutating func fillArc(cx: Float, cy: Float, radius: Float, startDegrees: Float, endDegrees: Float, color: UInt32) {
+        guard radius > 0, endDegrees != startDegrees else { return }
+        if abs(endDegrees - startDegrees) >= 360 {
+            fillCircle(cx: cx, cy: cy, radius: radius, color: color)
+            return
+        }
+        let rim = arcPoints(cx: cx, cy: cy, radius: radius, from: Self.radians(startDegrees), to: Self.radians(endDegrees), closed: false)
+        fillPolygon([Point(cx, cy)] + rim, color: color)
+    }
+
+    public mutating func fillRoundedRect(x: Float, y: Float, width: Float, height: Float, radius: Float, color: UInt32) {
+        guard width > 0, height > 0 else { return }
+        fillPolygon(roundedRectPoints(x: x, y: y, width: width, height: height, radius: radius), color: color)
+    }
+
+    /// The outline is centered on the rectangle's edge.
+    public mutating func strokeRoundedRect(x: Float, y: Float, width: Float, height: Float, radius: Float,
+                                           thickness: Float, color: UInt32) {
+        guard width > 0, height > 0 else { return }
+        strokePolyline(roundedRectPoints(x: x, y: y, width: width, height: height, radius: radius),
+                       thickness: thickness, color: color, closed: true)
+    }
+
+    /// Fills a polygon that is convex, or at least star-shaped around its first point (pie
+    /// slices). Triangulated as a fan from the first point.
+    public mutating func fillPolygon(_ outline: [Point], color: UInt32) {
+        let points = Self.deduplicated(outline, closed: true)
+        guard points.count >= 3 else { return }
+        let rgba = Self.rgba(color)
+        let area = Self.signedArea(points)
+        guard area != 0 else { return }
+        let count = points.count
+        if feather == 0 {
+            let base = appendVertices(points, color: rgba)
+            for i in 1..<(count - 1) { appendTriangle(base, base + Int32(i), base + Int32(i + 1)) }
+            return
+        }
+        // Core polygon inset by half the feather, fringe outset by the other half.
+        let offsets = Self.miterOffsets(points, closed: true, outward: area > 0)
+        let half = feather / 2
+        let inner = appendVertices(zip(points, offsets).map { $0 - $1 * half }, color: rgba)
+        let outer = appendVertices(zip(points, offsets).map { $0 + $1 * half }, color: rgba * SIMD4(1, 1, 1, 0))
+        for i in 1..<(count - 1) { appendTriangle(inner, inner + Int32(i), inner + Int32(i + 1)) }
+        for i in 0..<count {
+            let j = (i + 1) % count
+            appendQuad(inner + Int32(i), inner + Int32(j), outer + Int32(j), outer + Int32(i))
+        }
+    }
+
+    /// A polyline `thickness` pixels wide with mitered joins (clamped at sharp corners) and
+    /// butt ends. When feathered, lines thinner than a pixel are drawn a pixel wide with
+    /// proportionally less alpha.
+    public mutating func strokePolyline(_ path: [Point], thickness: Float, color: UInt32, closed: Bool = false) {
+        let points = Self.deduplicated(path, closed: closed)
+        guard points.count >= 2, thickness > 0 else { return }
+        var rgba = Self.rgba(color)
+        var half = thickness / 2
+        if thickness < 1 && feather > 0 {
+            rgba.w *= thickness
+            half = 0.5
+        }
+        let offsets = Self.miterOffsets(points, closed: closed, outward: true)
+        let count = points.count
+        let segments = closed ? count : count - 1
+        if feather == 0 {
+            let left = appendVertices(zip(points, offsets).map { $0 + $1 * half }, color: rgba)
+            let right = appendVertices(zip(points, offsets).map { $0 - $1 * half }, color: rgba)
+            for i in 0..<segments {
+                let j = (i + 1) % count
+                appendQuad(left + Int32(i), left + Int32(j), right + Int32(j), right + Int32(i))
+            }
+            return
+        }
+        let core = max(half - feather / 2, 0)
+        let fringe = half + feather / 2
+        let clear = rgba * SIMD4(1, 1, 1, 0)
+        let outerLeft = appendVertices(zip(points, offsets).map { $0 + $1 * fringe }, color: clear)
+        let left = appendVertices(zip(points, offsets).map { $0 + $1 * core }, color: rgba)
+        let right = appendVertices(zip(points, offsets).map { $0 - $1 * core }, color: rgba)
+        let outerRight = appendVertices(zip(points, offsets).map { $0 - $1 * fringe }, color: clear)
+        for i in 0..<segments {
+            let j = (i + 1) % count
+            appendQuad(outerLeft + Int32(i), outerLeft + Int32(j), left + Int32(j), left + Int32(i))
+            if core > 0 { appendQuad(left + Int32(i), left + Int32(j), right + Int32(j), right + Int32(i)) }
+            appendQuad(right + Int32(i), right + Int32(j), outerRight + Int32(j), outerRight + Int32(i))
+        }
+    }
+
+    // MARK: - Outlines
+
+    /// Chords needed to keep a curve of `radius` within `tolerance` over `sweep` radians.
+    func segmentCount(radius: Float, sweep: Float) -> Int {
+        let step = 2 * acos(max(-1, 1 - tolerance / max(radius, tolerance)))
+        let segments = Int((abs(sweep) / max(step, 1e-3)).rounded(.up))
+        return min(max(segments, abs(sweep) >= 2 * .pi ? 8 : 1), Self.maxCurveSegments)
+    }
+
+    func arcPoints(cx: Float, cy: Float, radius: Float, from start: Float, to end: Float, closed: Bool) -> [Point] {
+        let segments = segmentCount(radius: radius, sweep: end - start)
+        // A closed outline repeats its first point at the end, so leave that one out.
+        let count = closed ? segments : segments + 1
+        var points: [Point] = []
+        points.reserveCapacity(count)
+        for k in 0..<count {
+            let angle = start + (end - start) * Float(k) / Float(segments)
+            points.append(Point(cx + radius * cos(angle), cy + radius * sin(angle)))
+        }
+        return points
+    }
+
+    func roundedRectPoints(x: Float, y: Float, width: Float, height: Float, radius: Float) -> [Point] {
+        let r = min(max(radius, 0), width / 2, height / 2)
+        guard r > 0 else { return [Point(x, y), Point(x + width, y), Point(x + width, y + height), Point(x, y + height)] }
+        let corners: [(Float, Float, Float)] = [
+            (x + r, y + r, .pi), (x + width - r, y + r, 1.5 * .pi),
+            (x + width - r, y + height - r, 0), (x + r, y + height - r, 0.5 * .pi)
+        ]
+        return corners.flatMap { arcPoints(cx: $0.0, cy: $0.1, radius: r, from: $0.2, to: $0.2 + .pi / 2, closed: false) }
+    }
+
+    // MARK: - Helpers
+
+    private mutating func appendVertices(_ points: [Point], color: SIMD4<Float>) -> Int32 {
+        let base = Int32(vertexCount)
+        for p in points {
+            vertices.append(p.x); vertices.append(p.y)
+            vertices.append(color.x); vertices.append(color.y); vertices.append(color.z); vertices.append(color.w)
+            vertices.append(0); vertices.append(0)
+        }
+        return base
+    }
+
+    private mutating func appendTriangle(_ a: Int32, _ b: Int32, _ c: Int32) {
+        indices.append(a); indices.append(b); indices.append(c)
+    }
+
+    private mutating func appendQuad(_ a: Int32, _ b: Int32, _ c: Int32, _ d: Int32) {
+        appendTriangle(a, b, c)
+        appendTriangle(a, c, d)
+    }
+
+    static func rgba(_ argb: UInt32) -> SIMD4<Float> {
+        SIMD4(Float((argb >> 16) & 0xFF), Float((argb >> 8) & 0xFF), Float(argb & 0xFF), Float(argb >> 24)) / 255
+    }
+
+    static func radians(_ degrees: Float) -> Float { degrees * .pi / 180 }
+
+    /// Twice the polygon's signed area; positive when it winds counterclockwise in y-up terms.
+    static func signedArea(_ points: [Point]) -> Float {
+        var sum: Float = 0
+        for i in points.indices {
+            let a = points[i], b = points[(i + 1) % points.count]
+            sum += a.x * b.y - b.x * a.y
+        }
+        return sum
+    }
+
+    /// Drops repeated points (and a closing point equal to the first), which would leave
+    /// zero-length edges without a normal.
+    static func deduplicated(_ points: [Point], closed: Bool) -> [Point] {
+        var out: [Point] = []
+        out.reserveCapacity(points.count)
+        func same(_ a: Point, _ b: Point) -> Bool {
+            let d = a - b
+            return d.x * d.x + d.y * d.y <= 1e-8
+        }
+        for p in points where !(out.last.map { same($0, p) } ?? false) {
+            out.append(p)
+        }
+        if closed, out.count > 1, let first = out.first, let last = out.last, same(first, last) {
+            out.removeLast()
+        }
+        return out
+    }
+
+    /// Per-point offset directions whose dot product with each adjacent edge normal is 1, so
+    /// offsetting by `d` moves both edges by `d`. Sharp corners are clamped to avoid spikes.
+    /// With `outward`, normals point out of a polygon of positive `signedArea`; for strokes
+    /// the side only needs to be consistent.
+    static func miterOffsets(_ points: [Point], closed: Bool, outward: Bool) -> [Point] {
+        let count = points.count
+        let edgeCount = closed ? count : count - 1
+        var normals: [Point] = []
+        normals.reserveCapacity(edgeCount)
+        for i in 0..<edgeCount {
+            let d = points[(i + 1) % count] - points[i]
+            let length = (d.x * d.x + d.y * d.y).squareRoot()
+            let n = Point(d.y, -d.x) / length
+            normals.append(outward ? n : -n)
+        }
+        let maxScale: Float = 4
+        return (0..<count).map { i in
+            let previous = closed ? normals[(i + edgeCount - 1) % edgeCount] : normals[max(i - 1, 0)]
+            let next = closed ? normals[i % edgeCount] : normals[min(i, edgeCount - 1)]
+            let sum = previous + next
+            let length = (sum.x * sum.x + sum.y * sum.y).squareRoot()
+            guard length > 1e-4 else { return next }
+            let m = sum / length
+            let dot = m.x * next.x + m.y * next.y
+            return m * min(1 / max(dot, 1e-4), maxScale)
+        }
+    }
+}
@@ -0,0 +1,246 @@
+import Foundation
+
+// Readbacks that do not drain the queue.
+//
+// `enqueueReadback` records a copy into a pooled host-visible staging allocation behind the
+// work already submitted and returns a `ReadbackToken` right away. The token resolves once
+// the backend's fence for that copy has signalled; callers poll `isReady`, block in
+// `wait()`, `await` the value, or register `onComplete`. Backends also pump their pending
+// tokens at `beginFrame()`, so callbacks fire without anyone polling and analysis or
+// capture overlaps the next frame instead of stalling the current one.
+
+/// Completion token for an enqueued readback.
+@MainActor
+public final class ReadbackToken<Value> {
+    private var pollBody: (() -> Bool)?
+    private var resolveBody: (() throws -> Value)?
+    private var result: Result<Value, Error>?
+    private var handlers: [(Result<Value, Error>) -> Void] = []
+
+    /// `poll` reports, without blocking, whether the copy has landed; `resolve` blocks until
+    /// it has and produces the value. Neither is called again once the token resolves.
+    init(poll: @escaping () -> Bool, resolve: @escaping () throws -> Value) {
+        self.pollBody = poll
+        self.resolveBody = resolve
+    }
+
+    /// A token for data that was already available when it was requested.
+    static func resolved(_ value: Value) -> ReadbackToken {
+        let token = ReadbackToken(poll: { true }, resolve: { value })
+        token.complete()
+        return token
+    }
+
+    /// Non-blocking completion check; resolves the token (and runs its callbacks) when the
+    /// copy has finished.
+    public var isReady: Bool {
+        if result == nil, pollBody?() == true { complete() }
+        return result != nil
+    }
+
+    /// Blocks until the copy has finished and returns the data.
+    public func wait() throws -> Value {
+        if result == nil { complete() }
+        guard let result else {
+            throw AgentError.internalError("Readback token resolved without a result")
+        }
+        return try result.get()
+    }
+
+    /// Suspends until the copy has finished. The main actor stays free in between: the token
+    /// is polled with a short, growing back-off rather than blocking on the fence.
+    public func value() async throws -> Value {
+        var delay: UInt64 = 100_000
+        while !isReady {
+            try await Task.sleep(nanoseconds: delay)
+            delay = min(delay * 2, 4_000_000)
+        }
+        return try wait()
+    }
+
+    /// Calls `handler` once the readback resolves; immediately if it already has.
+    public func onComplete(_ handler: @escaping (Result<Value, Error>) -> Void) {
+        if let result {
+            handler(result)
+        } else {
+            handlers.append(handler)
+        }
+    }
+
+    func complete() {
+        guard result == nil, let resolveBody else { return }
+        result = Result { try resolveBody() }
+        pollBody = nil
+        self.resolveBody = nil
+        let pending = handlers
+        handlers.removeAll()
+        for handler in pending { handler(result!) }
+    }
+}
+
+// Optional protocol: backends that copy into staging memory without waiting for the GPU.
+// Other backends get the `RenderBackend` fallbacks below, which read synchronously.
+@MainActor
+public protocol AsyncReadbackProviding: AnyObject {
+    /// Copies `range` of `buffer` (the whole buffer when nil) once prior work has finished.
+    func enqueueReadback(buffer: BufferHandle, range: Range<Int>?) throws -> ReadbackToken<Data>
+    /// Copies mip 0 of `texture` once prior work has finished.
+    func enqueueReadback(texture: TextureHandle) throws -> ReadbackToken<GoldenImageCapture>
+    /// Captures the back buffer of the frame being recorded; resolves after `endFrame()`
+    /// without the frame waiting for it.
+    func enqueueFrameCapture() throws -> ReadbackToken<GoldenImageCapture>
+}
+
+public extension RenderBackend {
+    func enqueueReadback(buffer: BufferHandle, range: Range<Int>? = nil) throws -> ReadbackToken<Data> {
+        if let provider = self as? AsyncReadbackProviding {
+            return try provider.enqueueReadback(buffer: buffer, range: range)
+        }
+        guard let range else {
+            throw AgentError.invalidArgument("Buffer length is unknown to this backend; pass a range to read back")
+        }
+        var data = Data(count: range.upperBound)
+        try data.withUnsafeMutableBytes { raw in
+            guard let base = raw.baseAddress else { return }
+            try readback(buffer: buffer, into: base, length: raw.count)
+        }
+        return .resolved(data.subdata(in: range))
+    }
+
+    func enqueueReadback(texture: TextureHandle) throws -> ReadbackToken<GoldenImageCapture> {
+        guard let provider = self as? AsyncReadbackProviding else { throw AgentError.notImplemented }
+        return try provider.enqueueReadback(texture: texture)
+    }
+
+    func enqueueFrameCapture() throws -> ReadbackToken<GoldenImageCapture> {
+        guard let provider = self as? AsyncReadbackProviding else { throw AgentError.notImplemented }
+        return try provider.enqueueFrameCapture()
+    }
+}
+
+extension Range where Bound == Int {
+    /// Validates a requested readback range against a resource of `length` bytes.
+    static func readbackRange(_ requested: Range<Int>?, length: Int) throws -> Range<Int> {
+        let range = requested ?? 0..<length
+        guard range.lowerBound >= 0, range.upperBound <= length else {
+            throw AgentError.invalidArgument("Readback range \(range) exceeds buffer length \(length)")
+        }
+        return range
+    }
+}
+
+extension GoldenImageCapture.PixelLayout {
+    init(_ format: TextureFormat) {
+        switch format {
+        case .rgba8Unorm: self = .rgba8Unorm
+        case .bgra8Unorm: self = .bgra8Unorm
+        case .depth32Float: self = .depth32Float
+        }
+    }
+}
+
+// MARK: - Backend support
+
+/// Recycles host-visible staging allocations by power-of-two size class, so steady-state
+/// readbacks stop allocating. Allocations beyond `byteBudget` are handed back for release.
+struct ReadbackStagingPool<Allocation> {
+    struct Entry {
+        let allocation: Allocation
+        let capacity: Int
+    }
+
+    static var minimumCapacity: Int { 4096 }
+
+    let byteBudget: Int
+    private var free: [Int: [Allocation]] = [:]
+    private(set) var cachedBytes = 0
+
+    init(byteBudget: Int = 64 << 20) {
+        self.byteBudget = byteBudget
+    }
+
+    static func capacity(for length: Int) -> Int {
+        var capacity = minimumCapacity
+        while capacity < length { capacity <<= 1 }
+        return capacity
+    }
+
+    /// A cached allocation that holds `length` bytes, or a new one from `make`.
+    mutating func acquire(length: Int, make: (Int) throws -> Allocation) rethrows -> Entry {
+        let capacity = Self.capacity(for: length)
+        if var cached = free[capacity], let allocation = cached.popLast() {
+            free[capacity] = cached
+            cachedBytes -= capacity
+            return Entry(allocation: allocation, capacity: capacity)
+        }
+        return Entry(allocation: try make(capacity), capacity: capacity)
+    }
+
+    /// Returns `entry` to the pool; the allocation comes back when the pool is over budget
+    /// and the caller should release it instead.
+    mutating func recycle(_ entry: Entry) -> Allocation? {
+        guard cachedBytes + entry.capacity <= byteBudget else { return entry.allocation }
+        free[entry.capacity, default: []].append(entry.allocation)
+        cachedBytes += entry.capacity
+        return nil
+    }
+
+    /// Empties the pool, returning every cached allocation for release.
+    mutating func drain() -> [Allocation] {
+        let all = free.values.flatMap { $0 }
+        free.removeAll()
+        cachedBytes = 0
+        return all
+    }
+}
+
+/// Tokens a backend resolves on its own at frame boundaries.
+@MainActor
+struct PendingReadbacks {
+    private var entries: [(poll: () -> Bool, wait: () -> Void)] = []
+
+    var count: Int { entries.count }
+
+    mutating func track<Value>(_ token: ReadbackToken<Value>) {
+        entries.append((poll: { token.isReady }, wait: { _ = try? token.wait() }))
+    }
+
+    /// Resolves every token whose copy has finished.
+    mutating func pump() {
+        entries.removeAll { $0.poll() }
+    }
+
+    /// Blocks on and resolves every outstanding token, e.g. before the device goes away.
+    mutating func waitAll() {
+        let pending = entries
+        entries.removeAll()
+        for entry in pending { entry.wait() }
+    }
+}
+
+/// Frame captures requested before `endFrame()`; the backend fulfils them from the frame's
+/// copy of the back buffer.
+@MainActor
+final class FrameCaptureRequest {
+    var capture: GoldenImageCapture?
+    var error: Error?
+    /// Backend hook that lands the copy (waiting on its fence) once the frame was submitted.
+    var land: (() throws -> GoldenImageCapture)?
+    var isLanded: (() -> Bool)?
+
+    func token() -> ReadbackToken<GoldenImageCapture> {
+        ReadbackToken(
+            poll: { self.capture != nil || self.error != nil || self.isLanded?() == true },
+            resolve: {
+                if let error = self.error { throw error }
+                if let capture = self.capture { return capture }
+                guard let land = self.land else {
+                    throw AgentError.invalidArgument("Frame capture resolves after endFrame(); poll or await the token instead")
+                }
+                let capture = try land()
+                self.capture = capture
+                return capture
+            }
+        )
+    }
+}
@@ -60,14 +60,15 @@ final class StubRenderBackendCore {
     }
 
     private let kind: Kind
-    private let surface: RenderSurface
+    /// Nil for offscreen cores, which only rasterize at `currentSize`.
+    private let surface: RenderSurface?
     private(set) var currentSize: (width: Int, height: Int)
-    private var buffers: [BufferHandle: BufferResource] = [:]
-    private var textures: [TextureHandle: TextureResource] = [:]
-    private var samplers: [SamplerHandle: SamplerDescriptor] = [:]
-    private var pipelines: [PipelineHandle: PipelineResource] = [:]
-    private var computePipelines: [ComputePipelineHandle: ComputePipelineResource] = [:]
-    private var meshes: [MeshHandle: MeshResource] = [:]
+    private var buffers = SlotMap<BufferHandle, BufferResource>()
+    private var textures = SlotMap<TextureHandle, TextureResource>()
+    private var samplers = SlotMap<SamplerHandle, SamplerDescriptor>()
+    private var pipelines = SlotMap<PipelineHandle, PipelineResource>()
+    private var computePipelines = SlotMap<ComputePipelineHandle, ComputePipelineResource>()
+    private var meshes = SlotMap<MeshHandle, MeshResource>()
     private var frameActive = false
     private var framebuffer: Data = Data()
     private var depthbuffer: Data = Data()
@@ -75,16 +76,50 @@ final class StubRenderBackendCore {
     private var lastCaptureHash: String?
     private var lastCaptureData: Data?
     private var lastCaptureBytesPerRow: Int = 0
+    private var bindTracker = RenderBindTracker()
+    private var rasterizer = SoftwareRasterizer()
+    // Texel copies for the rasterizer, taken once per texture per frame.
+    private var rasterTextures: [TextureHandle: SoftwareRasterizer.Texture] = [:]
+    let frameArena = FrameArena()
+    // Software timestamps: the stub executes work synchronously, so host uptime stands in
+    // for the GPU clock while the ring reproduces the frames-in-flight readback latency.
+    let gpuTimings: GPUTimingAggregator
+    private var timestampRing: GPUTimestampRing
+    private var timestampTicks: [UInt64]
+    private var timestampSlot = 0
+    private var pendingFrameCaptures: [FrameCaptureRequest] = []
+    private var pendingReadbacks = PendingReadbacks()
 
-    init(kind: Kind, window: SDLWindow) throws {
+    var stateCounters: RenderStateCounters { bindTracker.counters }
+
+    convenience init(kind: Kind, window: SDLWindow) throws {
+        let surface = try RenderSurface(window: window)
+        self.init(kind: kind, surface: surface, size: (width: window.config.width, height: window.config.height))
+    }
+
+    /// A core for a backend without a window, rendering offscreen at `width`x`height`.
+    convenience init(kind: Kind, width: Int, height: Int) throws {
+        guard width > 0, height > 0 else {
+            throw AgentError.invalidArgument("Offscreen target size must be positive (got \(width)x\(height))")
+        }
+        self.init(kind: kind, surface: nil, size: (width: width, height: height))
+    }
+
+    private init(kind: Kind, surface: RenderSurface?, size: (width: Int, height: Int)) {
         self.kind = kind
-        self.surface = try RenderSurface(window: window)
-        self.currentSize = (width: window.config.width, height: window.config.height)
-        SDLLogger.info("SDLKit.Graphics", "Initialized stub \(kind.label) backend")
+        self.surface = surface
+        self.currentSize = size
+        self.gpuTimings = GPUTimingAggregator(source: kind.rawValue)
+        let ring = GPUTimestampRing(frameSlots: 2)
+        self.timestampRing = ring
+        self.timestampTicks = Array(repeating: 0, count: ring.queryCount)
+        GPUTimingRegistry.register(gpuTimings)
+        SDLLogger.info("SDLKit.Graphics", "Initialized stub \(kind.label) backend\(surface == nil ? " (offscreen)" : "")")
         logSurface()
     }
 
     private func logSurface() {
+        guard let surface else { return }
         #if canImport(QuartzCore)
         if let layer = surface.metalLayer {
             SDLLogger.debug("SDLKit.Graphics", "Surface metalLayer=\(layer)")
@@ -107,37 +142,59 @@ final class StubRenderBackendCore {
                                                                  indexFormat: indexFormat) })?.key {
             return existing
         }
-        let handle = MeshHandle()
-        meshes[handle] = MeshResource(
+        return meshes.insert(MeshResource(
             vertexBuffer: vertexBuffer,
             vertexCount: vertexCount,
             indexBuffer: indexBuffer,
             indexCount: indexCount,
             indexFormat: indexFormat
-        )
-        return handle
+        ))
     }
 
     func beginFrame() throws {
+        let profile = SDLProfiler.begin("render.beginFrame")
+        defer { profile.end() }
         guard !frameActive else {
             throw AgentError.internalError("beginFrame called twice without endFrame")
         }
         frameActive = true
         SDLLogger.debug("SDLKit.Graphics", "beginFrame on \(kind.label)")
+        // Targets are cleared in place and only reallocated when the size changes.
         let colorBytes = max(1, currentSize.width * currentSize.height * 4)
-        framebuffer = Data(count: colorBytes)
-        depthbuffer = Data(count: max(1, currentSize.width * currentSize.height * MemoryLayout<Float>.size))
+        let depthBytes = max(1, currentSize.width * currentSize.height * MemoryLayout<Float>.size)
+        if framebuffer.count != colorBytes { framebuffer = Data(count: colorBytes) }
+        if depthbuffer.count != depthBytes { depthbuffer = Data(count: depthBytes) }
+        framebuffer.withUnsafeMutableBytes { color in
+            depthbuffer.withUnsafeMutableBytes { depth in SoftwareRasterizer.clear(color: color, depth: depth) }
+        }
+        rasterizer.beginFrame(width: currentSize.width, height: currentSize.height)
+        rasterTextures.removeAll(keepingCapacity: true)
         lastCaptureHash = nil
         lastCaptureData = nil
         lastCaptureBytesPerRow = 0
+        bindTracker.beginFrame()
+        frameArena.reset()
+        let completed = timestampRing.beginFrame(slot: timestampSlot)
+        resolveTimestamps(completed)
+        beginGPUScope(GPUTimingLabel.frame)
     }
 
     func endFrame() throws {
+        let profile = SDLProfiler.begin("render.endFrame")
+        defer { profile.end() }
         guard frameActive else {
             throw AgentError.internalError("endFrame called without beginFrame")
         }
         frameActive = false
         SDLLogger.debug("SDLKit.Graphics", "endFrame on \(kind.label)")
+        framebuffer.withUnsafeMutableBytes { color in
+            depthbuffer.withUnsafeMutableBytes { depth in rasterizer.flush(color: color, depth: depth) }
+        }
+        for query in timestampRing.endFrame() {
+            writeTimestamp(query)
+        }
+        gpuTimings.noteDroppedScopes(timestampRing.takeDroppedScopes())
+        timestampSlot = (timestampSlot + 1) % timestampRing.frameSlots
         if captureRequested {
             var combined = framebuffer
             combined.append(depthbuffer)
@@ -146,6 +203,16 @@ final class StubRenderBackendCore {
             lastCaptureBytesPerRow = max(1, currentSize.width * 4)
             captureRequested = false
         }
+        if !pendingFrameCaptures.isEmpty {
+            let capture = GoldenImageCapture(width: max(1, currentSize.width),
+                                             height: max(1, currentSize.height),
+                                             bytesPerRow: max(1, currentSize.width * 4),
+                                             layout: .bgra8Unorm,
+                                             data: framebuffer)
+            pendingFrameCaptures.forEach { $0.capture = capture }
+            pendingFrameCaptures.removeAll()
+            pendingReadbacks.pump()
+        }
     }
 
     func resize(width: Int, height: Int) {
@@ -157,13 +224,30 @@ final class StubRenderBackendCore {
         SDLLogger.debug("SDLKit.Graphics", "waitGPU on \(kind.label)")
     }
 
+    func beginGPUScope(_ label: String) {
+        if let query = timestampRing.beginScope(label) { writeTimestamp(query) }
+    }
+
+    func endGPUScope() {
+        if let query = timestampRing.endScope() { writeTimestamp(query) }
+    }
+
+    private func writeTimestamp(_ query: UInt32) {
+        timestampTicks[Int(query)] = DispatchTime.now().uptimeNanoseconds
+    }
+
+    private func resolveTimestamps(_ scopes: [GPUTimestampRing.Scope]) {
+        guard !scopes.isEmpty else { return }
+        let ticks = timestampTicks
+        gpuTimings.record(GPUTimestampRing.durations(of: scopes, nanosecondsPerTick: 1) { ticks[Int($0)] })
+    }
+
     func createBuffer(bytes: UnsafeRawPointer?, length: Int, usage: BufferUsage) -> BufferHandle {
         var data = Data()
         if let bytes, length > 0 {
             data = Data(bytes: bytes, count: length)
         }
-        let handle = BufferHandle()
-        buffers[handle] = BufferResource(data: data, usage: usage)
+        let handle = buffers.insert(BufferResource(data: data, usage: usage))
         SDLLogger.debug("SDLKit.Graphics", "createBuffer id=\(handle.rawValue) bytes=\(length) usage=\(usage)")
         return handle
     }
@@ -174,14 +258,13 @@ final class StubRenderBackendCore {
 
     func withMutableBufferData(_ handle: BufferHandle, _ body: (inout Data) throws -> Void) throws {
         guard var resource = buffers[handle] else {
-            throw AgentError.invalidArgument("Unknown buffer handle \(handle.rawValue)")
+            throw AgentError.invalidArgument("\(buffers.missingDescription(handle)) buffer handle \(handle.rawValue)")
         }
         try body(&resource.data)
         buffers[handle] = resource
     }
 
     func createTexture(descriptor: TextureDescriptor, initialData: TextureInitialData?) -> TextureHandle {
-        let handle = TextureHandle()
         let bytesPerPixel: Int
         switch descriptor.format {
         case .rgba8Unorm, .bgra8Unorm:
@@ -195,14 +278,13 @@ final class StubRenderBackendCore {
             let copyCount = min(storage.count, firstLevel.count)
             storage.replaceSubrange(0..<copyCount, with: firstLevel.prefix(copyCount))
         }
-        textures[handle] = TextureResource(descriptor: descriptor, data: storage)
+        let handle = textures.insert(TextureResource(descriptor: descriptor, data: storage))
         SDLLogger.debug("SDLKit.Graphics", "createTexture id=\(handle.rawValue) size=\(descriptor.width)x\(descriptor.height) format=\(descriptor.format.rawValue)")
         return handle
     }
 
     func createSampler(descriptor: SamplerDescriptor) -> SamplerHandle {
-        let handle = SamplerHandle()
-        samplers[handle] = descriptor
+        let handle = samplers.insert(descriptor)
         SDLLogger.debug("SDLKit.Graphics", "createSampler id=\(handle.rawValue) label=\(descriptor.label ?? "<nil>")")
         return handle
     }
@@ -226,8 +308,7 @@ final class StubRenderBackendCore {
     }
 
     func makePipeline(_ desc: GraphicsPipelineDescriptor) -> PipelineHandle {
-        let handle = PipelineHandle()
-        pipelines[handle] = PipelineResource(descriptor: desc)
+        let handle = pipelines.insert(PipelineResource(descriptor: desc))
         SDLLogger.debug(
             "SDLKit.Graphics",
             "makePipeline id=\(handle.rawValue) label=\(desc.label ?? "<nil>") shader=\(desc.shader.rawValue)"
@@ -239,10 +320,12 @@ final class StubRenderBackendCore {
               pipeline: PipelineHandle,
               bindings: BindingSet,
               transform: float4x4) throws {
+        let profile = SDLProfiler.begin("render.draw")
+        defer { profile.end() }
         guard frameActive else {
             throw AgentError.internalError("draw called outside beginFrame/endFrame")
         }
-        guard pipelines[pipeline] != nil else {
+        guard let pipelineResource = pipelines[pipeline] else {
             throw AgentError.internalError("Unknown pipeline for draw call")
         }
         guard let meshResource = meshes[mesh] else {
@@ -252,17 +335,58 @@ final class StubRenderBackendCore {
             "SDLKit.Graphics",
             "draw mesh=\(mesh.rawValue) pipeline=\(pipeline.rawValue) vertexBuffer=\(meshResource.vertexBuffer.rawValue) vertexCount=\(meshResource.vertexCount) indexBuffer=\(meshResource.indexBuffer?.rawValue ?? 0) indexCount=\(meshResource.indexCount)"
         )
-        if let pipelineResource = pipelines[pipeline], pipelineResource.descriptor.shader.rawValue == "basic_lit" {
-            if let textureHandle = bindings.texture(at: 10), let resource = textures[textureHandle] {
-                blit(texture: resource)
+        // No API state to elide here, but track it so headless runs report the same counters.
+        _ = bindTracker.needsPipeline(pipeline)
+        _ = bindTracker.needsResources(bindings)
+        _ = bindTracker.needsVertexBuffers(mesh)
+        rasterize(meshResource, pipeline: pipelineResource.descriptor, bindings: bindings, transform: transform)
+    }
+
+    private func rasterize(_ mesh: MeshResource, pipeline: GraphicsPipelineDescriptor, bindings: BindingSet, transform: float4x4) {
+        guard let vertexData = buffers[mesh.vertexBuffer]?.data else { return }
+        var constants = SoftwareRasterizer.DrawConstants(mvp: transform)
+        bindings.materialConstants?.withUnsafeBytes { constants.load(from: $0) }
+        var texture = bindings.texture(at: 10).flatMap { rasterTexture($0) }
+        // basic_lit binds a texture but has no UVs; the stub stretches it over the target
+        // by pixel position and modulates the shaded color with it.
+        if !pipeline.vertexLayout.attributes.contains(where: { $0.semantic == "TEXCOORD0" }) {
+            texture?.mapping = .screen
+        }
+        let material = SoftwareRasterizer.Material(
+            shading: pipeline.shader.rawValue == "unlit_triangle" ? .unlit : .lit,
+            constants: constants,
+            depthTest: pipeline.depthFormat != nil,
+            texture: texture
+        )
+        let indexData = mesh.indexBuffer.flatMap { buffers[$0]?.data }
+        vertexData.withUnsafeBytes { vertices in
+            if let indexData {
+                indexData.withUnsafeBytes { indices in
+                    _ = rasterizer.submit(vertices: vertices, layout: pipeline.vertexLayout, vertexCount: mesh.vertexCount,
+                                          indices: indices, indexFormat: mesh.indexFormat, indexCount: mesh.indexCount,
+                                          material: material)
+                }
+            } else {
+                _ = rasterizer.submit(vertices: vertices, layout: pipeline.vertexLayout, vertexCount: mesh.vertexCount,
+                                      indices: nil, indexFormat: mesh.indexFormat, indexCount: 0,
+                                      material: material)
             }
         }
-        _ = transform
+    }
+
+    private func rasterTexture(_ handle: TextureHandle) -> SoftwareRasterizer.Texture? {
+        if let cached = rasterTextures[handle] { return cached }
+        guard let resource = textures[handle], resource.format == .rgba8Unorm || resource.format == .bgra8Unorm else { return nil }
+        let texture = SoftwareRasterizer.Texture(width: resource.width,
+                                                 height: resource.height,
+                                                 isBGRA: resource.format == .bgra8Unorm,
+                                                 texels: [UInt8](resource.data))
+        rasterTextures[handle] = texture
+        return texture
     }
 
     func makeComputePipeline(_ desc: ComputePipelineDescriptor) -> ComputePipelineHandle {
-        let handle = ComputePipelineHandle()
-        computePipelines[handle] = ComputePipelineResource(descriptor: desc)
+        let handle = computePipelines.insert(ComputePipelineResource(descriptor: desc))
         SDLLogger.debug("SDLKit.Graphics", "makeComputePipeline id=\(handle.rawValue) label=\(desc.label ?? "<nil>")")
         return handle
     }
@@ -270,11 +394,98 @@ final class StubRenderBackendCore {
     func dispatchCompute(_ pipeline: ComputePipelineHandle,
                          groupsX: Int, groupsY: Int, groupsZ: Int,
                          bindings: BindingSet) throws {
+        let profile = SDLProfiler.begin("render.dispatchCompute")
+        defer { profile.end() }
         guard computePipelines[pipeline] != nil else {
             throw AgentError.internalError("Unknown compute pipeline")
         }
         SDLLogger.debug("SDLKit.Graphics", "dispatchCompute pipeline=\(pipeline.rawValue) groups=(\(groupsX),\(groupsY),\(groupsZ))")
-        try applyComputeWork(for: pipeline, groupsX: groupsX, groupsY: groupsY, groupsZ: groupsZ, bindings: bindings)
+        let label = GPUTimingLabel.dispatch(computePipelines[pipeline]?.descriptor.shader ?? ShaderID("unknown"))
+        if frameActive {
+            beginGPUScope(label)
+            defer { endGPUScope() }
+            try applyComputeWork(for: pipeline, groupsX: groupsX, groupsY: groupsY, groupsZ: groupsZ, bindings: bindings)
+        } else if let scope = timestampRing.reserveImmediate(label) {
+            // Out-of-frame work completes before returning, so its pair resolves at once.
+            writeTimestamp(scope.begin)
+            try applyComputeWork(for: pipeline, groupsX: groupsX, groupsY: groupsY, groupsZ: groupsZ, bindings: bindings)
+            writeTimestamp(scope.end)
+            resolveTimestamps([scope])
+        } else {
+            try applyComputeWork(for: pipeline, groupsX: groupsX, groupsY: groupsY, groupsZ: groupsZ, bindings: bindings)
+        }
+    }
+
+    func submitCompute(_ list: ComputeCommandList) throws -> ComputeFence {
+        let profile = SDLProfiler.begin("render.submitCompute")
+        defer { profile.end() }
+        var shaders: [ShaderID] = []
+        shaders.reserveCapacity(list.count)
+        for dispatch in list.dispatches {
+            guard let shader = computePipelines[dispatch.pipeline]?.descriptor.shader else {
+                throw AgentError.internalError("Unknown compute pipeline")
+            }
+            shaders.append(shader)
+        }
+        // Kernels run to completion in submission order, so planned barriers are only counted.
+        var planner = ComputeHazardPlanner()
+        for (dispatch, shader) in zip(list.dispatches, shaders) {
+            let slots = (try? ShaderLibrary.shared.computeModule(for: shader))?.bindings
+            _ = planner.barriers(before: ComputeHazardPlanner.accesses(of: dispatch.bindings, slots: slots))
+            try dispatchCompute(dispatch.pipeline,
+                                groupsX: dispatch.groups.x,
+                                groupsY: dispatch.groups.y,
+                                groupsZ: dispatch.groups.z,
+                                bindings: dispatch.bindings)
+        }
+        return ComputeFence.signaled(dispatchCount: list.count, barrierCount: planner.barrierCount)
+    }
+
+    // Work executes synchronously, so a readback taken at enqueue time already reflects
+    // everything submitted before it and the tokens resolve immediately.
+    func enqueueReadback(buffer: BufferHandle, range requested: Range<Int>?) throws -> ReadbackToken<Data> {
+        let profile = SDLProfiler.begin("render.enqueueReadback")
+        defer { profile.end() }
+        guard let data = buffers[buffer]?.data else {
+            throw AgentError.invalidArgument("\(buffers.missingDescription(buffer)) buffer handle \(buffer.rawValue)")
+        }
+        let range = requested ?? 0..<data.count
+        guard range.lowerBound >= 0 else {
+            throw AgentError.invalidArgument("Readback range \(range) starts before the buffer")
+        }
+        // Like `readback`, bytes past the end of the stored data read as zero.
+        var copy = Data(count: range.count)
+        let available = range.clamped(to: 0..<data.count)
+        if !available.isEmpty {
+            copy.replaceSubrange(0..<available.count, with: data[available])
+        }
+        return .resolved(copy)
+    }
+
+    func enqueueReadback(texture: TextureHandle) throws -> ReadbackToken<GoldenImageCapture> {
+        let profile = SDLProfiler.begin("render.enqueueReadback")
+        defer { profile.end() }
+        guard let resource = textures[texture] else {
+            throw AgentError.invalidArgument("\(textures.missingDescription(texture)) texture handle \(texture.rawValue)")
+        }
+        let width = max(1, resource.width)
+        let height = max(1, resource.height)
+        return .resolved(GoldenImageCapture(width: width,
+                                            height: height,
+                                            bytesPerRow: resource.data.count / height,
+                                            layout: GoldenImageCapture.PixelLayout(resource.format),
+                                            data: resource.data))
+    }
+
+    func enqueueFrameCapture() throws -> ReadbackToken<GoldenImageCapture> {
+        guard frameActive else {
+            throw AgentError.invalidArgument("enqueueFrameCapture must be called between beginFrame and endFrame")
+        }
+        let request = FrameCaptureRequest()
+        pendingFrameCaptures.append(request)
+        let token = request.token()
+        pendingReadbacks.track(token)
+        return token
     }
 
     func requestCapture() {
@@ -304,101 +515,97 @@ final class StubRenderBackendCore {
         )
     }
 
+    /// Runs the native kernel for the pipeline's shader (see ComputeKernels.swift) over
+    /// staged copies of the bound resources, then stores the written ones back.
     private func applyComputeWork(for pipeline: ComputePipelineHandle,
                                    groupsX: Int,
                                    groupsY: Int,
                                    groupsZ: Int,
                                    bindings: BindingSet) throws {
         guard let descriptor = computePipelines[pipeline]?.descriptor else { return }
-        let shaderID = descriptor.shader.rawValue
-        guard shaderID == "compute_storage_texture" || shaderID == "ibl_brdf_lut" else { return }
-        guard let textureHandle = bindings.texture(at: 0) else {
-            throw AgentError.invalidArgument("Missing storage texture binding at slot 0")
-        }
-        guard var resource = textures[textureHandle] else {
-            throw AgentError.invalidArgument("Unknown storage texture handle")
+        guard let kernel = ComputeKernelRegistry.kernel(for: descriptor.shader) else {
+            SDLLogger.debug("SDLKit.Graphics", "dispatchCompute: no native kernel for \(descriptor.shader.rawValue); skipping")
+            return
         }
-        guard resource.usage == .shaderWrite else {
-            throw AgentError.invalidArgument("Storage texture binding must have shaderWrite usage")
-        }
-        guard resource.format == .rgba8Unorm || resource.format == .bgra8Unorm else {
-            throw AgentError.invalidArgument("Storage texture must be a color format")
+
+        var bufferStaging: [BufferHandle: UnsafeMutableRawBufferPointer] = [:]
+        var textureStaging: [TextureHandle: UnsafeMutableRawBufferPointer] = [:]
+        var storedBuffers: Set<BufferHandle> = []
+        defer {
+            for (handle, staging) in bufferStaging where !storedBuffers.contains(handle) { staging.deallocate() }
+            for staging in textureStaging.values { staging.deallocate() }
         }
 
-        let width = max(1, resource.width)
-        let height = max(1, resource.height)
-        let totalPixels = width * height
-        if resource.data.count < totalPixels * 4 {
-            resource.data = Data(count: totalPixels * 4)
-        }
-
-        resource.data.withUnsafeMutableBytes { buffer in
-            guard let base = buffer.baseAddress?.assumingMemoryBound(to: UInt8.self) else { return }
-            for y in 0..<height {
-                for x in 0..<width {
-                    let offset = (y * width + x) * 4
-                    let normalizedX = Float(x) / Float(max(1, width - 1))
-                    let normalizedY = Float(y) / Float(max(1, height - 1))
-                    if shaderID == "ibl_brdf_lut" {
-                        // Deterministic BRDF LUT placeholder: pack uv in RG, zero B, opaque A
-                        base[offset + 0] = UInt8(clamping: Int(normalizedX * 255.0))
-                        base[offset + 1] = UInt8(clamping: Int(normalizedY * 255.0))
-                        base[offset + 2] = 0
-                        base[offset + 3] = 255
-                    } else {
-                        // Legacy compute_storage_texture pattern for compatibility
-                        base[offset + 0] = UInt8(clamping: Int(normalizedX * 255.0))
-                        base[offset + 1] = UInt8(clamping: Int(normalizedY * 255.0))
-                        let pattern = UInt8(((x + y + groupsX + groupsY + groupsZ) % 256))
-                        base[offset + 2] = pattern
-                        base[offset + 3] = 255
-                    }
-                }
+        var kernelBuffers: [Int: ComputeKernelBuffer] = [:]
+        for slot in kernel.bufferSlots {
+            guard let handle = bindings.buffer(at: slot) else {
+                throw AgentError.invalidArgument("Missing storage buffer binding at slot \(slot)")
+            }
+            guard let resource = buffers[handle] else {
+                throw AgentError.invalidArgument("Unknown storage buffer handle \(handle.rawValue)")
             }
+            // A buffer bound at several slots shares one staging copy, as it would share memory on the GPU.
+            let staging = bufferStaging[handle] ?? Self.stage(resource.data)
+            bufferStaging[handle] = staging
+            kernelBuffers[slot] = ComputeKernelBuffer(staging)
         }
 
-        textures[textureHandle] = resource
-    }
-
-    private func blit(texture resource: TextureResource) {
-        guard resource.format == .rgba8Unorm || resource.format == .bgra8Unorm else { return }
-        let targetWidth = max(1, currentSize.width)
-        let targetHeight = max(1, currentSize.height)
-        let sourceWidth = max(1, resource.width)
-        let sourceHeight = max(1, resource.height)
-        if framebuffer.count < targetWidth * targetHeight * 4 {
-            framebuffer = Data(count: targetWidth * targetHeight * 4)
-        }
-
-        framebuffer.withUnsafeMutableBytes { dstBuf in
-            resource.data.withUnsafeBytes { srcBuf in
-                guard let dstBase = dstBuf.baseAddress?.assumingMemoryBound(to: UInt8.self) else { return }
-                guard let srcBase = srcBuf.baseAddress?.assumingMemoryBound(to: UInt8.self) else { return }
-                for y in 0..<targetHeight {
-                    let srcY = min(sourceHeight - 1, y * sourceHeight / max(1, targetHeight))
-                    for x in 0..<targetWidth {
-                        let srcX = min(sourceWidth - 1, x * sourceWidth / max(1, targetWidth))
-                        let dstOffset = (y * targetWidth + x) * 4
-                        let srcOffset = (srcY * sourceWidth + srcX) * 4
-                        dstBase[dstOffset + 0] = srcBase[srcOffset + 0]
-                        dstBase[dstOffset + 1] = srcBase[srcOffset + 1]
-                        dstBase[dstOffset + 2] = srcBase[srcOffset + 2]
-                        dstBase[dstOffset + 3] = srcBase[srcOffset + 3]
-                    }
-                }
+        var kernelTextures: [Int: ComputeKernelTexture] = [:]
+        for slot in kernel.textureSlots {
+            guard let handle = bindings.texture(at: slot) else {
+                throw AgentError.invalidArgument("Missing storage texture binding at slot \(slot)")
+            }
+            guard var resource = textures[handle] else {
+                throw AgentError.invalidArgument("Unknown storage texture handle")
+            }
+            guard resource.usage == .shaderWrite else {
+                throw AgentError.invalidArgument("Storage texture binding must have shaderWrite usage")
             }
+            guard resource.format == .rgba8Unorm || resource.format == .bgra8Unorm else {
+                throw AgentError.invalidArgument("Storage texture must be a color format")
+            }
+            let width = max(1, resource.width)
+            let height = max(1, resource.height)
+            if resource.data.count < width * height * 4 {
+                resource.data = Data(count: width * height * 4)
+            }
+            let staging = textureStaging[handle] ?? Self.stage(resource.data)
+            textureStaging[handle] = staging
+            kernelTextures[slot] = ComputeKernelTexture(width: width,
+                                                        height: height,
+                                                        isBGRA: resource.format == .bgra8Unorm,
+                                                        texels: staging.baseAddress?.assumingMemoryBound(to: UInt8.self))
         }
 
-        depthbuffer.withUnsafeMutableBytes { buffer in
-            guard let depthBase = buffer.baseAddress?.assumingMemoryBound(to: Float.self) else { return }
-            let count = targetWidth * targetHeight
-            for index in 0..<count {
-                let x = index % targetWidth
-                depthBase[index] = Float(x) / Float(max(1, targetWidth - 1))
-            }
+        let constants: [UInt32] = bindings.materialConstants?.withUnsafeBytes { raw in
+            (0..<(raw.count / 4)).map { raw.loadUnaligned(fromByteOffset: $0 * 4, as: UInt32.self) }
+        } ?? []
+
+        kernel.execute(ComputeKernelContext(groups: (groupsX, groupsY, groupsZ),
+                                            constants: constants,
+                                            buffers: kernelBuffers,
+                                            textures: kernelTextures))
+
+        for slot in kernel.writtenBufferSlots {
+            guard let handle = bindings.buffer(at: slot), let staging = bufferStaging[handle],
+                  !storedBuffers.contains(handle), let base = staging.baseAddress else { continue }
+            // Hand the staging allocation to the buffer instead of copying it back.
+            buffers[handle]?.data = Data(bytesNoCopy: base, count: staging.count, deallocator: .custom { pointer, _ in pointer.deallocate() })
+            storedBuffers.insert(handle)
+        }
+        for (handle, staging) in textureStaging {
+            guard let base = staging.baseAddress else { continue }
+            textures[handle]?.data = Data(bytes: base, count: staging.count)
+            rasterTextures[handle] = nil
         }
     }
 
+    private static func stage(_ data: Data) -> UnsafeMutableRawBufferPointer {
+        let staging = UnsafeMutableRawBufferPointer.allocate(byteCount: data.count, alignment: MemoryLayout<SIMD4<Float>>.alignment)
+        _ = data.copyBytes(to: staging)
+        return staging
+    }
+
     private static func hashHex(_ data: Data) -> String {
         var hash: UInt64 = 0xcbf29ce484222325
         for byte in data {
@@ -413,11 +620,16 @@ final class StubRenderBackendCore {
 public class StubRenderBackend: RenderBackend {
     fileprivate let core: StubRenderBackendCore
     public var deviceEventHandler: RenderBackendDeviceEventHandler?
+    public var frameArena: FrameArena? { core.frameArena }
 
     fileprivate init(kind: StubRenderBackendCore.Kind, window: SDLWindow) throws {
         self.core = try StubRenderBackendCore(kind: kind, window: window)
     }
 
+    fileprivate init(kind: StubRenderBackendCore.Kind, offscreenWidth width: Int, height: Int) throws {
+        self.core = try StubRenderBackendCore(kind: kind, width: width, height: height)
+    }
+
     required public init(window: SDLWindow) throws {
         fatalError("Use specialized subclass initializers")
     }
@@ -454,6 +666,8 @@ public class StubRenderBackend: RenderBackend {
     }
 
     public func readback(buffer: BufferHandle, into dst: UnsafeMutableRawPointer, length: Int) throws {
+        let profile = SDLProfiler.begin("render.readback")
+        defer { profile.end() }
         guard let data = core.bufferData(buffer) else {
             throw AgentError.invalidArgument("Unknown buffer handle \(buffer.rawValue)")
         }
@@ -471,6 +685,36 @@ public class StubRenderBackend: RenderBackend {
     }
 }
 
+extension StubRenderBackend: RenderStateCounting {
+    public var stateCounters: RenderStateCounters { core.stateCounters }
+}
+
+extension StubRenderBackend: GPUTimingProfiling {
+    public var gpuTimings: GPUTimingAggregator { core.gpuTimings }
+    public func beginGPUScope(_ label: String) { core.beginGPUScope(label) }
+    public func endGPUScope() { core.endGPUScope() }
+}
+
+extension StubRenderBackend: ComputeCommandListSubmitting {
+    public func submitCompute(_ list: ComputeCommandList) throws -> ComputeFence {
+        try core.submitCompute(list)
+    }
+}
+
+extension StubRenderBackend: AsyncReadbackProviding {
+    public func enqueueReadback(buffer: BufferHandle, range: Range<Int>?) throws -> ReadbackToken<Data> {
+        try core.enqueueReadback(buffer: buffer, range: range)
+    }
+
+    public func enqueueReadback(texture: TextureHandle) throws -> ReadbackToken<GoldenImageCapture> {
+        try core.enqueueReadback(texture: texture)
+    }
+
+    public func enqueueFrameCapture() throws -> ReadbackToken<GoldenImageCapture> {
+        try core.enqueueFrameCapture()
+    }
+}
+
 extension StubRenderBackend: GoldenImageCapturable {
     public func requestCapture() {
         core.requestCapture()
@@ -510,6 +754,11 @@ public final class VulkanRenderBackend: StubRenderBackend {
         try super.init(kind: .vulkan, window: window)
     }
 
+    /// Renders into the stub rasterizer's framebuffer at `width`x`height`, with no window.
+    public init(offscreenWidth width: Int, height: Int) throws {
+        try super.init(kind: .vulkan, offscreenWidth: width, height: height)
+    }
+
     public func takeValidationMessages() -> [String] {
         return []
     }
@@ -571,6 +820,29 @@ public enum RenderBackendFactory {
         }
     }
 
+    /// Builds a backend that renders into offscreen targets of `width`x`height` instead of a
+    /// window, for headless capture and CI. Only the Vulkan backend has an offscreen mode.
+    public static func makeOffscreenBackend(width: Int, height: Int, override: String? = nil) throws -> RenderBackend {
+        let overrideValue = override ?? SDLKitConfig.renderBackendOverride
+        let choice: Choice
+        if let overrideValue {
+            guard let parsed = Choice.parse(overrideValue) else {
+                throw AgentError.invalidArgument("Unknown render backend override: \(overrideValue)")
+            }
+            choice = parsed
+        } else {
+            choice = .vulkan
+        }
+        guard choice == .vulkan else {
+            throw AgentError.invalidArgument("Render backend \(choice.rawValue) has no offscreen mode; use vulkan")
+        }
+        if !isChoiceSupported(choice) {
+            throw AgentError.invalidArgument("Render backend \(choice.rawValue) not supported on this platform")
+        }
+        SDLLogger.info("SDLKit.Graphics", "RenderBackendFactory => \(choice.rawValue) (offscreen \(width)x\(height))")
+        return try VulkanRenderBackend(offscreenWidth: width, height: height)
+    }
+
     private static func isChoiceSupported(_ choice: Choice) -> Bool {
         switch choice {
         case .metal:
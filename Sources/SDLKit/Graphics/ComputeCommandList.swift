@@ -0,0 +1,208 @@
+import Foundation
+
+// Recorded compute work submitted as one unit.
+//
+// A `ComputeCommandList` only records; nothing reaches the GPU until a backend submits it.
+// On submit each dispatch's resource accesses come from its pipeline's binding slots
+// (storage slots declared `.read` are inputs, other storage slots are read/write), and a
+// barrier is placed on a resource only where an earlier dispatch in the list wrote it or
+// read it before this one writes it. All dispatches go into one command buffer with a
+// single submission, so dependent stages never round-trip through the CPU; the returned
+// `ComputeFence` reports completion of the whole list.
+//
+// Material constants are copied when the list is submitted, but arena-backed constants
+// must still be recorded and submitted within the same frame.
+
+public struct ComputeCommandList {
+    public struct Dispatch {
+        public let pipeline: ComputePipelineHandle
+        public let groups: (x: Int, y: Int, z: Int)
+        public let bindings: BindingSet
+    }
+
+    public let label: String?
+    public private(set) var dispatches: [Dispatch] = []
+
+    public init(label: String? = nil) {
+        self.label = label
+    }
+
+    public var isEmpty: Bool { dispatches.isEmpty }
+    public var count: Int { dispatches.count }
+
+    public mutating func dispatch(_ pipeline: ComputePipelineHandle,
+                                  groupsX: Int, groupsY: Int = 1, groupsZ: Int = 1,
+                                  bindings: BindingSet) {
+        dispatches.append(Dispatch(pipeline: pipeline, groups: (groupsX, groupsY, groupsZ), bindings: bindings))
+    }
+
+    public mutating func removeAll(keepingCapacity: Bool = false) {
+        dispatches.removeAll(keepingCapacity: keepingCapacity)
+    }
+}
+
+/// Completion token for a submitted `ComputeCommandList`.
+@MainActor
+public final class ComputeFence {
+    public let dispatchCount: Int
+    /// Barriers the hazard planner placed between dispatches of the list.
+    public let barrierCount: Int
+
+    private var pollBody: (() -> Bool)?
+    private var waitBody: (() throws -> Void)?
+    private var completed: Bool
+
+    init(dispatchCount: Int, barrierCount: Int, poll: @escaping () -> Bool, wait: @escaping () throws -> Void) {
+        self.dispatchCount = dispatchCount
+        self.barrierCount = barrierCount
+        self.pollBody = poll
+        self.waitBody = wait
+        self.completed = false
+    }
+
+    /// A fence for work that finished before `submitCompute` returned.
+    static func signaled(dispatchCount: Int, barrierCount: Int) -> ComputeFence {
+        let fence = ComputeFence(dispatchCount: dispatchCount, barrierCount: barrierCount, poll: { true }, wait: {})
+        fence.finish()
+        return fence
+    }
+
+    /// Non-blocking completion check.
+    public var isComplete: Bool {
+        if !completed, pollBody?() == true { finish() }
+        return completed
+    }
+
+    /// Blocks until every dispatch of the list has finished and its writes are visible to
+    /// readbacks.
+    public func wait() throws {
+        guard !completed else { return }
+        try waitBody?()
+        finish()
+    }
+
+    private func finish() {
+        completed = true
+        pollBody = nil
+        waitBody = nil
+    }
+}
+
+// Optional protocol: backends that record a command list into one submission. Other
+// backends get the `RenderBackend.submitCompute` fallback, which dispatches one by one
+// and waits for the GPU before returning.
+@MainActor
+public protocol ComputeCommandListSubmitting: AnyObject {
+    func submitCompute(_ list: ComputeCommandList) throws -> ComputeFence
+}
+
+public extension RenderBackend {
+    /// Submits every dispatch of `list` at once and returns its completion fence.
+    func submitCompute(_ list: ComputeCommandList) throws -> ComputeFence {
+        if let submitting = self as? ComputeCommandListSubmitting {
+            return try submitting.submitCompute(list)
+        }
+        for dispatch in list.dispatches {
+            try dispatchCompute(dispatch.pipeline,
+                                groupsX: dispatch.groups.x,
+                                groupsY: dispatch.groups.y,
+                                groupsZ: dispatch.groups.z,
+                                bindings: dispatch.bindings)
+        }
+        try waitGPU()
+        return ComputeFence.signaled(dispatchCount: list.count, barrierCount: 0)
+    }
+}
+
+// MARK: - Hazard planning
+
+/// Tracks resource accesses across the dispatches of one list and reports the barriers a
+/// dispatch needs. Reads after reads never need one; a barrier clears the resource's
+/// history, since everything before it is then ordered.
+struct ComputeHazardPlanner {
+    enum Resource: Hashable {
+        case buffer(BufferHandle)
+        case texture(TextureHandle)
+    }
+
+    enum Hazard: Equatable {
+        case readAfterWrite
+        case writeAfterRead
+        case writeAfterWrite
+    }
+
+    struct Access: Equatable {
+        let resource: Resource
+        let writes: Bool
+    }
+
+    struct Barrier: Equatable {
+        let resource: Resource
+        let hazard: Hazard
+    }
+
+    private var history: [Resource: (read: Bool, written: Bool)] = [:]
+    /// Resources written anywhere in the list, in first-write order.
+    private(set) var writtenResources: [Resource] = []
+    private(set) var barrierCount = 0
+
+    /// Barriers required before a dispatch with `accesses`, which are then recorded.
+    mutating func barriers(before accesses: [Access]) -> [Barrier] {
+        var barriers: [Barrier] = []
+        for access in Self.merged(accesses) {
+            if let previous = history[access.resource] {
+                if previous.written {
+                    barriers.append(Barrier(resource: access.resource, hazard: access.writes ? .writeAfterWrite : .readAfterWrite))
+                    history[access.resource] = nil
+                } else if access.writes && previous.read {
+                    barriers.append(Barrier(resource: access.resource, hazard: .writeAfterRead))
+                    history[access.resource] = nil
+                }
+            }
+            var state = history[access.resource] ?? (read: false, written: false)
+            if access.writes {
+                state.written = true
+                if !writtenResources.contains(access.resource) { writtenResources.append(access.resource) }
+            } else {
+                state.read = true
+            }
+            history[access.resource] = state
+        }
+        barrierCount += barriers.count
+        return barriers
+    }
+
+    /// Accesses of `bindings` under a pipeline's binding slots. Without slot metadata every
+    /// bound resource is treated as read/write.
+    static func accesses(of bindings: BindingSet, slots: [BindingSlot]?) -> [Access] {
+        guard let slots else {
+            return bindings.resources.sorted { $0.key < $1.key }.map { Access(resource: Resource($0.value), writes: true) }
+        }
+        return slots.compactMap { slot in
+            guard slot.kind != .sampler, let resource = bindings.resource(at: slot.index) else { return nil }
+            return Access(resource: Resource(resource), writes: slot.access == .readWrite)
+        }
+    }
+
+    /// One access per resource; a resource bound at several slots is written if any slot writes.
+    private static func merged(_ accesses: [Access]) -> [Access] {
+        var result: [Access] = []
+        for access in accesses {
+            if let index = result.firstIndex(where: { $0.resource == access.resource }) {
+                result[index] = Access(resource: access.resource, writes: result[index].writes || access.writes)
+            } else {
+                result.append(access)
+            }
+        }
+        return result
+    }
+}
+
+extension ComputeHazardPlanner.Resource {
+    init(_ resource: BindingSet.Resource) {
+        switch resource {
+        case .buffer(let handle): self = .buffer(handle)
+        case .texture(let handle): self = .texture(handle)
+        }
+    }
+}
@@ -0,0 +1,337 @@
+import Foundation
+
+// Native Swift versions of the bundled compute shaders (Shaders/compute).
+//
+// The stub backends have no GPU, so `dispatchCompute` runs the matching kernel here with
+// the shader's semantics: same binding slots, push-constant layout, threadgroup size and
+// dispatch geometry. None of the bundled shaders use groupshared memory or barriers and
+// every invocation writes only its own outputs, so workgroups are split into chunks and
+// run across cores; results do not depend on the core count. Reads past the end of a
+// binding return 0 and writes past it are dropped, like robust buffer access on the GPU.
+
+/// A storage buffer binding viewed as `float` elements.
+struct ComputeKernelBuffer: @unchecked Sendable {
+    let base: UnsafeMutablePointer<Float>?
+    let count: Int
+
+    init(_ raw: UnsafeMutableRawBufferPointer) {
+        count = raw.count / MemoryLayout<Float>.size
+        base = raw.baseAddress?.bindMemory(to: Float.self, capacity: count)
+    }
+
+    subscript(index: Int) -> Float {
+        get { index >= 0 && index < count ? base![index] : 0 }
+        nonmutating set { if index >= 0 && index < count { base![index] = newValue } }
+    }
+}
+
+/// An 8-bit RGBA/BGRA storage texture binding.
+struct ComputeKernelTexture: @unchecked Sendable {
+    let width: Int
+    let height: Int
+    let isBGRA: Bool
+    let texels: UnsafeMutablePointer<UInt8>?
+
+    /// Writes a unorm color; channels are clamped to [0, 1] and NaN stores 0.
+    func store(x: Int, y: Int, _ value: SIMD4<Float>) {
+        guard let texels, x >= 0, y >= 0, x < width, y < height else { return }
+        let finite = value.replacing(with: 0, where: value .!= value)
+        let clamped = finite.clamped(lowerBound: .zero, upperBound: .one) * 255 + 0.5
+        let offset = (y * width + x) * 4
+        texels[offset + 0] = UInt8(isBGRA ? clamped.z : clamped.x)
+        texels[offset + 1] = UInt8(clamped.y)
+        texels[offset + 2] = UInt8(isBGRA ? clamped.x : clamped.z)
+        texels[offset + 3] = UInt8(clamped.w)
+    }
+}
+
+struct ComputeKernelContext {
+    let groups: (x: Int, y: Int, z: Int)
+    /// Push constants as 32-bit words; missing words read as 0.
+    let constants: [UInt32]
+    let buffers: [Int: ComputeKernelBuffer]
+    let textures: [Int: ComputeKernelTexture]
+
+    func word(_ index: Int) -> UInt32 { index < constants.count ? constants[index] : 0 }
+    func int(_ index: Int) -> Int { Int(word(index)) }
+    func buffer(_ slot: Int) -> ComputeKernelBuffer { buffers[slot] ?? ComputeKernelBuffer(UnsafeMutableRawBufferPointer(start: nil, count: 0)) }
+}
+
+struct ComputeKernel: Sendable {
+    /// Global invocation id.
+    typealias Invocation = (_ x: Int, _ y: Int, _ z: Int) -> Void
+
+    enum Domain: Sendable {
+        /// `groups * threadgroupSize` invocations, as on the GPU.
+        case dispatch
+        /// One invocation per texel of the storage texture at slot 0, whatever the group count.
+        case storageTexture
+    }
+
+    let threadgroupSize: (x: Int, y: Int, z: Int)
+    let bufferSlots: [Int]
+    /// Buffer slots the kernel writes; only these are copied back to the backend.
+    let writtenBufferSlots: Set<Int>
+    let textureSlots: [Int]
+    let domain: Domain
+    /// Called once per dispatch to resolve bindings and constants; the returned closure
+    /// runs concurrently for disjoint invocations.
+    let prepare: @Sendable (ComputeKernelContext) -> Invocation
+
+    init(threadgroupSize: (x: Int, y: Int, z: Int),
+         bufferSlots: [Int] = [],
+         writtenBufferSlots: Set<Int> = [],
+         textureSlots: [Int] = [],
+         domain: Domain = .dispatch,
+         prepare: @escaping @Sendable (ComputeKernelContext) -> Invocation) {
+        self.threadgroupSize = threadgroupSize
+        self.bufferSlots = bufferSlots
+        self.writtenBufferSlots = writtenBufferSlots
+        self.textureSlots = textureSlots
+        self.domain = domain
+        self.prepare = prepare
+    }
+
+    /// Runs every invocation of the dispatch, splitting workgroups across cores.
+    func execute(_ context: ComputeKernelContext) {
+        let invocation = prepare(context)
+        let tg: (x: Int, y: Int, z: Int)
+        let groups: (x: Int, y: Int, z: Int)
+        switch domain {
+        case .dispatch:
+            tg = threadgroupSize
+            groups = (max(0, context.groups.x), max(0, context.groups.y), max(0, context.groups.z))
+        case .storageTexture:
+            guard let texture = textureSlots.first.flatMap({ context.textures[$0] }) else { return }
+            tg = (1, 1, 1)
+            groups = (texture.width, texture.height, 1)
+        }
+        let groupCount = groups.x * groups.y * groups.z
+        guard groupCount > 0 else { return }
+
+        let runGroups = { (range: Range<Int>) in
+            for group in range {
+                let gx = group % groups.x
+                let gy = (group / groups.x) % groups.y
+                let gz = group / (groups.x * groups.y)
+                for lz in 0..<tg.z {
+                    for ly in 0..<tg.y {
+                        for lx in 0..<tg.x {
+                            invocation(gx * tg.x + lx, gy * tg.y + ly, gz * tg.z + lz)
+                        }
+                    }
+                }
+            }
+        }
+
+        let invocations = groupCount * tg.x * tg.y * tg.z
+        let chunks = min(groupCount, ProcessInfo.processInfo.activeProcessorCount * 4)
+        guard chunks > 1, invocations >= Self.serialInvocationLimit else {
+            runGroups(0..<groupCount)
+            return
+        }
+        DispatchQueue.concurrentPerform(iterations: chunks) { chunk in
+            runGroups((groupCount * chunk / chunks)..<(groupCount * (chunk + 1) / chunks))
+        }
+    }
+
+    /// Dispatches smaller than this run on the calling thread.
+    static let serialInvocationLimit = 256
+}
+
+enum ComputeKernelRegistry {
+    static func kernel(for shader: ShaderID) -> ComputeKernel? {
+        kernels[shader]
+    }
+
+    static var registeredShaders: [ShaderID] {
+        kernels.keys.sorted { $0.rawValue < $1.rawValue }
+    }
+
+    private static let kernels: [ShaderID: ComputeKernel] = [
+        ShaderID("vector_add"): vectorAdd,
+        ShaderID("audio_dft_power"): audioDFTPower,
+        ShaderID("audio_mel_project"): audioMelProject,
+        ShaderID("audio_onset_flux"): audioOnsetFlux,
+        ShaderID("scenegraph_wave"): scenegraphWave,
+        ShaderID("ibl_brdf_lut"): iblBRDFLUT,
+        ShaderID("compute_storage_texture"): computeStorageTexture
+    ]
+
+    // MARK: - Kernels
+
+    /// C[i] = A[i] + B[i] for i < elementCount.
+    private static let vectorAdd = ComputeKernel(threadgroupSize: (64, 1, 1), bufferSlots: [0, 1, 2], writtenBufferSlots: [2]) { ctx in
+        let count = ctx.int(0)
+        let a = ctx.buffer(0), b = ctx.buffer(1), c = ctx.buffer(2)
+        return { i, _, _ in
+            guard i < count else { return }
+            c[i] = a[i] + b[i]
+        }
+    }
+
+    /// Power spectrum of each windowed frame, one invocation per (frame, bin).
+    private static let audioDFTPower = ComputeKernel(threadgroupSize: (64, 1, 1), bufferSlots: [0, 1], writtenBufferSlots: [1]) { ctx in
+        let frameSize = ctx.int(0), nBins = ctx.int(1), frames = ctx.int(2)
+        let input = ctx.buffer(0), output = ctx.buffer(1)
+        guard frameSize > 0, nBins > 0 else { return { _, _, _ in } }
+        // bin * n is reduced mod N, so one table serves every twiddle of the dispatch.
+        let step = 2 * Double.pi / Double(frameSize)
+        let cosTable = (0..<frameSize).map { Float(cos(step * Double($0))) }
+        let sinTable = (0..<frameSize).map { Float(sin(step * Double($0))) }
+        return { g, _, _ in
+            guard g < frames * nBins else { return }
+            let frame = g / nBins, bin = g % nBins
+            let base = frame * frameSize
+            var re: Float = 0, im: Float = 0
+            let stride = bin % frameSize
+            var k = 0
+            for n in 0..<frameSize {
+                let x = input[base + n]
+                re += x * cosTable[k]
+                im -= x * sinTable[k]
+                k += stride
+                if k >= frameSize { k -= frameSize }
+            }
+            output[frame * nBins + bin] = re * re + im * im
+        }
+    }
+
+    /// out[f][m] = sum_k W[m][k] * P[f][k].
+    private static let audioMelProject = ComputeKernel(threadgroupSize: (64, 1, 1), bufferSlots: [0, 1, 2], writtenBufferSlots: [2]) { ctx in
+        let nBins = ctx.int(0), melBands = ctx.int(1), frames = ctx.int(2)
+        let power = ctx.buffer(0), weights = ctx.buffer(1), output = ctx.buffer(2)
+        guard melBands > 0 else { return { _, _, _ in } }
+        return { g, _, _ in
+            guard g < frames * melBands else { return }
+            let frame = g / melBands, mel = g % melBands
+            let powerBase = frame * nBins, weightBase = mel * nBins
+            var acc: Float = 0
+            for k in 0..<nBins {
+                acc += weights[weightBase + k] * power[powerBase + k]
+            }
+            output[frame * melBands + mel] = acc
+        }
+    }
+
+    /// Positive spectral flux per frame against the previous frame (or `prevMel` for frame 0).
+    private static let audioOnsetFlux = ComputeKernel(threadgroupSize: (1, 1, 1), bufferSlots: [0, 1, 2], writtenBufferSlots: [2]) { ctx in
+        let melBands = ctx.int(0), frames = ctx.int(1), hasPrev = ctx.word(2) != 0
+        let mel = ctx.buffer(0), prev = ctx.buffer(1), output = ctx.buffer(2)
+        return { frame, _, _ in
+            guard frame < frames else { return }
+            let base = frame * melBands
+            var flux: Float = 0
+            if frame == 0 && hasPrev {
+                for i in 0..<melBands { flux += max(mel[base + i] - prev[i], 0) }
+            } else if frame > 0 {
+                let prevBase = base - melBands
+                for i in 0..<melBands { flux += max(mel[base + i] - mel[prevBase + i], 0) }
+            }
+            output[frame] = flux
+        }
+    }
+
+    /// Advances each vertex phase and writes the rotated, pulsing position + color vertex.
+    private static let scenegraphWave = ComputeKernel(threadgroupSize: (1, 1, 1), bufferSlots: [0, 1, 2], writtenBufferSlots: [0, 2]) { ctx in
+        let states = ctx.buffer(0), configs = ctx.buffer(1), vertices = ctx.buffer(2)
+        return { index, _, _ in
+            let state = index * 4
+            let phase = states[state + 3] + configs[state + 3]
+            states[state + 3] = phase
+            let c = cos(phase), s = sin(phase)
+            let x = states[state], y = states[state + 1]
+            let pulse = 0.6 + 0.4 * s
+            let out = index * 6
+            vertices[out + 0] = x * c - y * s
+            vertices[out + 1] = x * s + y * c
+            vertices[out + 2] = states[state + 2]
+            for channel in 0..<3 {
+                vertices[out + 3 + channel] = min(max(configs[state + channel] * pulse, 0), 1)
+            }
+        }
+    }
+
+    /// Split-sum BRDF integration (scale, bias) into RG; B = 0, A = 1 on 8-bit targets.
+    private static let iblBRDFLUT = ComputeKernel(threadgroupSize: (16, 16, 1), textureSlots: [0]) { ctx in
+        guard let target = ctx.textures[0] else { return { _, _, _ in } }
+        // Callers have passed the count as a float bit pattern; bound the CPU cost either way.
+        let sampleCount = min(max(ctx.int(0), 1), maxBRDFSamples)
+        return { x, y, _ in
+            guard x < target.width, y < target.height else { return }
+            let noV = (Float(x) + 0.5) / Float(target.width)
+            let roughness = (Float(y) + 0.5) / Float(target.height)
+            let (a, b) = integrateBRDF(noV: noV, roughness: roughness, sampleCount: sampleCount)
+            target.store(x: x, y: y, SIMD4(a, b, 0, 1))
+        }
+    }
+
+    static let maxBRDFSamples = 1024
+
+    /// Legacy test pattern: uv in RG, a group-count dependent ramp in B.
+    private static let computeStorageTexture = ComputeKernel(threadgroupSize: (1, 1, 1), textureSlots: [0], domain: .storageTexture) { ctx in
+        guard let target = ctx.textures[0], let texels = target.texels else { return { _, _, _ in } }
+        let groupSum = ctx.groups.x + ctx.groups.y + ctx.groups.z
+        return { x, y, _ in
+            let offset = (y * target.width + x) * 4
+            texels[offset + 0] = UInt8(clamping: Int(Float(x) / Float(max(1, target.width - 1)) * 255))
+            texels[offset + 1] = UInt8(clamping: Int(Float(y) / Float(max(1, target.height - 1)) * 255))
+            texels[offset + 2] = UInt8((x + y + groupSum) % 256)
+            texels[offset + 3] = 255
+        }
+    }
+
+    // MARK: - BRDF helpers (Shaders/compute/ibl_brdf_lut.hlsl)
+
+    static func integrateBRDF(noV: Float, roughness: Float, sampleCount: Int) -> (Float, Float) {
+        let v = SIMD3<Float>((1 - noV * noV).squareRoot(), 0, noV)
+        var a: Float = 0, b: Float = 0
+        for i in 0..<sampleCount {
+            let xi = SIMD2<Float>(Float(i) / Float(sampleCount), radicalInverse(UInt32(truncatingIfNeeded: i)))
+            let h = importanceSampleGGX(xi, roughness: roughness)
+            let vDotH = (v * h).sum()
+            let l = 2 * vDotH * h - v
+            let noL = min(max(l.z / (l * l).sum().squareRoot(), 0), 1)
+            let noH = min(max(h.z, 0), 1)
+            let voH = min(max(vDotH, 0), 1)
+            if noL > 0 {
+                let g = geometrySchlickGGX(noV, roughness) * geometrySchlickGGX(noL, roughness)
+                let gVis = (g * voH) / max(noH * noV, 1e-4)
+                let fc = pow(1 - voH, 5)
+                a += (1 - fc) * gVis
+                b += fc * gVis
+            }
+        }
+        return (a / Float(sampleCount), b / Float(sampleCount))
+    }
+
+    private static func radicalInverse(_ value: UInt32) -> Float {
+        Float(value.bitSwapped) * 2.3283064365386963e-10
+    }
+
+    private static func importanceSampleGGX(_ xi: SIMD2<Float>, roughness: Float) -> SIMD3<Float> {
+        let a = roughness * roughness
+        let phi = 2 * Float.pi * xi.x
+        let cosTheta = ((1 - xi.y) / (1 + (a * a - 1) * xi.y)).squareRoot()
+        let sinTheta = max(0, 1 - cosTheta * cosTheta).squareRoot()
+        return SIMD3(cos(phi) * sinTheta, sin(phi) * sinTheta, cosTheta)
+    }
+
+    private static func geometrySchlickGGX(_ nDotV: Float, _ roughness: Float) -> Float {
+        let r = roughness + 1
+        let k = (r * r) / 8
+        return nDotV / max(nDotV * (1 - k) + k, 1e-4)
+    }
+}
+
+private extension UInt32 {
+    /// Bit reversal, as in `RadicalInverse_VdC`.
+    var bitSwapped: UInt32 {
+        var bits = (self << 16) | (self >> 16)
+        bits = ((bits & 0x5555_5555) << 1) | ((bits & 0xAAAA_AAAA) >> 1)
+        bits = ((bits & 0x3333_3333) << 2) | ((bits & 0xCCCC_CCCC) >> 2)
+        bits = ((bits & 0x0F0F_0F0F) << 4) | ((bits & 0xF0F0_F0F0) >> 4)
+        bits = ((bits & 0x00FF_00FF) << 8) | ((bits & 0xFF00_FF00) >> 8)
+        return bits
+    }
+}
@@ -17,7 +17,6 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         let length: Int
         let usage: BufferUsage
         var state: D3D12_RESOURCE_STATES
-        var shadowCopy: Data?
     }
 
     private struct PipelineResource {
@@ -64,9 +63,15 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         let requiresSubmission: Bool
     }
 
+    private struct ImmediateSubmission {
+        let list: UnsafeMutablePointer<ID3D12GraphicsCommandList>
+        let allocator: UnsafeMutablePointer<ID3D12CommandAllocator>
+    }
+
+    private typealias ReadbackStagingEntry = ReadbackStagingPool<UnsafeMutablePointer<ID3D12Resource>>.Entry
+
     private struct TextureResource {
         let descriptor: TextureDescriptor
-        var shadowMipData: [Data]
         let resource: UnsafeMutablePointer<ID3D12Resource>
         var state: D3D12_RESOURCE_STATES
         let srvDescriptorIndex: UINT?
@@ -83,13 +88,11 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         let length: Int
         let usage: BufferUsage
         let state: D3D12_RESOURCE_STATES
-        let shadowCopy: Data?
     }
 
     private struct TextureSnapshot {
         let descriptor: TextureDescriptor
         let state: D3D12_RESOURCE_STATES
-        let shadowMipData: [Data]
     }
 
     private struct SamplerSnapshot {
@@ -142,17 +145,25 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
     private var currentHeight: Int
     private var transformBuffer: UnsafeMutablePointer<ID3D12Resource>?
 
-    private var buffers: [BufferHandle: BufferResource] = [:]
-    private var pipelines: [PipelineHandle: PipelineResource] = [:]
-    private var computePipelines: [ComputePipelineHandle: ComputePipelineResource] = [:]
-    private var meshes: [MeshHandle: MeshResource] = [:]
-    private var textures: [TextureHandle: TextureResource] = [:]
-    private var samplers: [SamplerHandle: SamplerResource] = [:]
+    private var buffers = SlotMap<BufferHandle, BufferResource>()
+    private let recoveryLedger = ResourceRecoveryLedger(component: "SDLKit.Graphics.D3D12")
+    private var pipelines = SlotMap<PipelineHandle, PipelineResource>()
+    private var computePipelines = SlotMap<ComputePipelineHandle, ComputePipelineResource>()
+    private var meshes = SlotMap<MeshHandle, MeshResource>()
+    private var textures = SlotMap<TextureHandle, TextureResource>()
+    private var samplers = SlotMap<SamplerHandle, SamplerResource>()
 
     private var builtinPipeline: PipelineHandle?
     private var builtinVertexBuffer: BufferHandle?
 
     private var frameActive = false
+    private var bindTracker = RenderBindTracker()
+    private let payloadArena = FrameArena()
+    private let timings = GPUTimingAggregator(source: RenderBackendFactory.Choice.d3d12.rawValue)
+    private var timestampHeap: UnsafeMutablePointer<ID3D12QueryHeap>?
+    private var timestampReadback: UnsafeMutablePointer<ID3D12Resource>?
+    private var timestampRing = GPUTimestampRing(frameSlots: Constants.frameCount)
+    private var timestampFrequency: UInt64 = 0
     private var debugLayerEnabled = false
     private let shaderLibrary = ShaderLibrary.shared
     public var deviceEventHandler: RenderBackendDeviceEventHandler?
@@ -181,6 +192,7 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
     private var computeCommandAllocator: UnsafeMutablePointer<ID3D12CommandAllocator>?
     private var computeCommandList: UnsafeMutablePointer<ID3D12GraphicsCommandList>?
     private var pendingComputeFenceValue: UInt64?
+    private var pendingComputeTimestamps: GPUTimestampRing.Scope?
     private var fenceValueCounter: UInt64 = 0
     private var computePushConstantBuffer: UnsafeMutablePointer<ID3D12Resource>?
     private var computePushConstantBufferSize: Int = 0
@@ -193,6 +205,10 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
     private var lastCaptureSize: (width: Int, height: Int) = (0, 0)
     private var readbackBuffer: UnsafeMutablePointer<ID3D12Resource>?
     private var readbackBufferSize: UINT64 = 0
+    // Asynchronous readbacks: pooled READBACK-heap buffers and the tokens waiting on them.
+    private var readbackStaging = ReadbackStagingPool<UnsafeMutablePointer<ID3D12Resource>>()
+    private var pendingReadbacks = PendingReadbacks()
+    private var pendingFrameCapture: FrameCaptureRequest?
     private var recoveringDeviceLoss = false
 #if DEBUG
     private var debugForcedDeviceRemovalReason: HRESULT?
@@ -219,6 +235,7 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
 
         try initializeD3D()
         try createBuiltinTriangleResources()
+        GPUTimingRegistry.register(timings)
         SDLLogger.info("SDLKit.Graphics.D3D12", "Initialized D3D12 backend with size=\(currentWidth)x\(currentHeight)")
     }
 
@@ -230,6 +247,8 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
     // MARK: - RenderBackend
 
     public func beginFrame() throws {
+        let profile = SDLProfiler.begin("render.beginFrame")
+        defer { profile.end() }
         guard !frameActive else {
             throw AgentError.internalError("beginFrame called while a frame is active")
         }
@@ -243,6 +262,7 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         lastCaptureSize = (0, 0)
         do {
             try waitForFrameCompletion(Int(frameIndex))
+            pendingReadbacks.pump()
 
             guard let allocator = frames[Int(frameIndex)].commandAllocator else {
                 throw AgentError.internalError("Missing command allocator for frame")
@@ -250,6 +270,9 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
             try checkHRESULT(allocator.pointee.lpVtbl.pointee.Reset(allocator), "ID3D12CommandAllocator.Reset")
             try checkHRESULT(commandList.pointee.lpVtbl.pointee.Reset(commandList, allocator, nil), "ID3D12GraphicsCommandList.Reset")
 
+            bindTracker.beginFrame()
+            payloadArena.reset()
+            beginTimestampFrame(commandList)
             var vp = viewport
             commandList.pointee.lpVtbl.pointee.RSSetViewports(commandList, 1, &vp)
             var rect = scissorRect
@@ -289,6 +312,8 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
     }
 
     public func endFrame() throws {
+        let profile = SDLProfiler.begin("render.endFrame")
+        defer { profile.end() }
         guard frameActive else {
             throw AgentError.internalError("endFrame called without beginFrame")
         }
@@ -298,8 +323,18 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
 
         defer { frameActive = false }
 
+        // Enqueued frame captures copy into pooled staging and land on the frame fence.
+        var frameCapture: (request: FrameCaptureRequest, staging: ReadbackStagingEntry, width: Int, height: Int, rowPitch: Int)?
+        var frameCaptureLanded = false
+        defer {
+            if let frameCapture, !frameCaptureLanded {
+                frameCapture.request.error = AgentError.internalError("Frame submission failed before the capture landed")
+                recycleReadbackStaging(frameCapture.staging)
+            }
+        }
+
         // Optional capture: transition to COPY_SOURCE, copy to readback buffer, then to PRESENT
-        if captureRequested, let rt = frames[Int(frameIndex)].renderTarget {
+        if captureRequested || pendingFrameCapture != nil, let rt = frames[Int(frameIndex)].renderTarget {
             var desc = D3D12_RESOURCE_DESC()
             desc = rt.pointee.lpVtbl.pointee.GetDesc(rt)
             var footprint = D3D12_PLACED_SUBRESOURCE_FOOTPRINT()
@@ -317,7 +352,18 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
                 }
             }
 
-            if readbackBuffer == nil || readbackBufferSize < totalBytes {
+            if let request = pendingFrameCapture {
+                pendingFrameCapture = nil
+                do {
+                    let length = max(Int(totalBytes), Int(footprint.Footprint.RowPitch) * Int(desc.Height))
+                    let staging = try readbackStaging.acquire(length: length) { try makeReadbackStaging(capacity: $0) }
+                    frameCapture = (request, staging, Int(desc.Width), Int(desc.Height), Int(footprint.Footprint.RowPitch))
+                } catch {
+                    request.error = error
+                }
+            }
+
+            if captureRequested && (readbackBuffer == nil || readbackBufferSize < totalBytes) {
                 if var rb = readbackBuffer { releaseCOM(&rb); readbackBuffer = nil }
                 var heapProps = D3D12_HEAP_PROPERTIES(Type: D3D12_HEAP_TYPE_READBACK, CPUPageProperty: D3D12_CPU_PAGE_PROPERTY_UNKNOWN, MemoryPoolPreference: D3D12_MEMORY_POOL_UNKNOWN, CreationNodeMask: 0, VisibleNodeMask: 0)
                 var bufferDesc = D3D12_RESOURCE_DESC.Buffer(totalBytes)
@@ -340,9 +386,15 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
 
             // Copy texture to readback buffer
             var src = D3D12_TEXTURE_COPY_LOCATION(pResource: rt, Type: D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX, Anonymous: D3D12_TEXTURE_COPY_LOCATION._Anonymous(subresourceIndex: 0))
-            var dst = D3D12_TEXTURE_COPY_LOCATION(pResource: readbackBuffer, Type: D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT, Anonymous: D3D12_TEXTURE_COPY_LOCATION._Anonymous(placedFootprint: footprint))
             var box: D3D12_BOX? = nil
-            commandList.pointee.lpVtbl.pointee.CopyTextureRegion(commandList, &dst, 0, 0, 0, &src, &box)
+            if captureRequested {
+                var dst = D3D12_TEXTURE_COPY_LOCATION(pResource: readbackBuffer, Type: D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT, Anonymous: D3D12_TEXTURE_COPY_LOCATION._Anonymous(placedFootprint: footprint))
+                commandList.pointee.lpVtbl.pointee.CopyTextureRegion(commandList, &dst, 0, 0, 0, &src, &box)
+            }
+            if let frameCapture {
+                var dst = D3D12_TEXTURE_COPY_LOCATION(pResource: frameCapture.staging.allocation, Type: D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT, Anonymous: D3D12_TEXTURE_COPY_LOCATION._Anonymous(placedFootprint: footprint))
+                commandList.pointee.lpVtbl.pointee.CopyTextureRegion(commandList, &dst, 0, 0, 0, &src, &box)
+            }
 
             // Transition COPY_SOURCE -> PRESENT
             var toPresent = D3D12_RESOURCE_BARRIER()
@@ -351,6 +403,8 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
             toPresent.Transition = D3D12_RESOURCE_TRANSITION_BARRIER(pResource: rt, Subresource: D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, StateBefore: D3D12_RESOURCE_STATE_COPY_SOURCE, StateAfter: D3D12_RESOURCE_STATE_PRESENT)
             commandList.pointee.lpVtbl.pointee.ResourceBarrier(commandList, 1, &toPresent)
         } else {
+            pendingFrameCapture?.error = AgentError.internalError("Back buffer unavailable for frame capture")
+            pendingFrameCapture = nil
             var barrier = D3D12_RESOURCE_BARRIER()
             barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION
             barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE
@@ -363,6 +417,7 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
             commandList.pointee.lpVtbl.pointee.ResourceBarrier(commandList, 1, &barrier)
         }
 
+        endTimestampFrame(commandList)
         try checkHRESULT(commandList.pointee.lpVtbl.pointee.Close(commandList), "ID3D12GraphicsCommandList.Close")
 
         var listPointer = UnsafeMutableRawPointer(commandList).assumingMemoryBound(to: ID3D12CommandList.self)
@@ -381,6 +436,18 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         let fenceValue = allocateFenceValue()
         fenceValues[currentFrame] = fenceValue
         try checkHRESULT(commandQueue.pointee.lpVtbl.pointee.Signal(commandQueue, fence, fenceValue), "ID3D12CommandQueue.Signal")
+        if let frameCapture {
+            frameCaptureLanded = true
+            let staging = frameCapture.staging
+            let (width, height, rowPitch) = (frameCapture.width, frameCapture.height, frameCapture.rowPitch)
+            frameCapture.request.isLanded = { [weak self] in self?.isFenceComplete(fenceValue) ?? true }
+            frameCapture.request.land = { [weak self] in
+                try D3D12RenderBackend.completeReadback(self, fenceValue: fenceValue, staging: staging) { mapped in
+                    GoldenImageCapture(width: width, height: height, bytesPerRow: rowPitch, layout: .bgra8Unorm,
+                                       data: Data(bytes: mapped, count: rowPitch * height))
+                }
+            }
+        }
 
         // If capture requested, wait for GPU and compute hash now
         if captureRequested {
@@ -521,24 +588,30 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
             resource: resource,
             length: length,
             usage: usage,
-            state: D3D12_RESOURCE_STATE_GENERIC_READ,
-            shadowCopy: initialData
+            state: D3D12_RESOURCE_STATE_GENERIC_READ
         )
     }
 
     public func createBuffer(bytes: UnsafeRawPointer?, length: Int, usage: BufferUsage) throws -> BufferHandle {
+        try createBuffer(bytes: bytes, length: length, usage: usage, recovery: .shadowCopy)
+    }
+
+    public func createBuffer(bytes: UnsafeRawPointer?, length: Int, usage: BufferUsage, recovery: ResourceRecoveryPolicy) throws -> BufferHandle {
         guard length > 0 else {
             throw AgentError.invalidArgument("Buffer length must be positive")
         }
-        let shadowData: Data?
+        // Upload straight from the caller's bytes; a host copy is only made if the policy keeps one.
+        let initialData: Data?
         if let bytes {
-            shadowData = Data(bytes: bytes, count: length)
+            initialData = Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: bytes), count: length, deallocator: .none)
         } else {
-            shadowData = nil
+            initialData = nil
+        }
+        let resource = try buildBufferResource(length: length, usage: usage, initialData: initialData)
+        let handle = buffers.insert(resource)
+        if let bytes {
+            recoveryLedger.track(.buffer(handle), byteCount: length, policy: recovery) { [Data(bytes: bytes, count: length)] }
         }
-        let resource = try buildBufferResource(length: length, usage: usage, initialData: shadowData)
-        let handle = BufferHandle()
-        buffers[handle] = resource
         return handle
     }
 
@@ -760,7 +833,6 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
 
         return TextureResource(
             descriptor: descriptor,
-            shadowMipData: initialData?.mipLevelData ?? [],
             resource: resource,
             state: finalState,
             srvDescriptorIndex: srvDescriptorIndex,
@@ -775,12 +847,22 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
     }
 
     public func createTexture(descriptor: TextureDescriptor, initialData: TextureInitialData?) throws -> TextureHandle {
+        try createTexture(descriptor: descriptor, initialData: initialData, recovery: .shadowCopy)
+    }
+
+    public func createTexture(descriptor: TextureDescriptor, initialData: TextureInitialData?, recovery: ResourceRecoveryPolicy) throws -> TextureHandle {
         let resource = try buildTextureResource(descriptor: descriptor, initialData: initialData)
-        let handle = TextureHandle()
-        textures[handle] = resource
+        let handle = textures.insert(resource)
+        if let mipData = initialData?.mipLevelData, !mipData.isEmpty {
+            recoveryLedger.track(.texture(handle), byteCount: mipData.reduce(0) { $0 + $1.count }, policy: recovery) { mipData }
+        }
         return handle
     }
 
+    public func setRecoveryPolicy(_ policy: ResourceRecoveryPolicy, for handle: ResourceHandle) throws {
+        try recoveryLedger.setPolicy(policy, for: handle)
+    }
+
     private func buildSamplerResource(descriptor: SamplerDescriptor) throws -> SamplerResource {
         guard let device else {
             throw AgentError.internalError("D3D12 device unavailable for sampler creation")
@@ -821,8 +903,7 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
 
     public func createSampler(descriptor: SamplerDescriptor) throws -> SamplerHandle {
         let resource = try buildSamplerResource(descriptor: descriptor)
-        let handle = SamplerHandle()
-        samplers[handle] = resource
+        let handle = samplers.insert(resource)
         SDLLogger.debug("SDLKit.Graphics.D3D12", "createSampler id=\(handle.rawValue) label=\(descriptor.label ?? "<nil>")")
         return handle
     }
@@ -1104,6 +1185,25 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
     }
 
     private func performImmediateCommand(_ encode: (UnsafeMutablePointer<ID3D12GraphicsCommandList>) throws -> Void) throws {
+        guard let commandQueue else {
+            throw AgentError.internalError("D3D12 device or command queue unavailable for immediate work")
+        }
+        let submission = try executeImmediateCommand(encode)
+        defer { D3D12RenderBackend.releaseImmediateSubmission(submission) }
+
+        guard let fence else {
+            throw AgentError.internalError("D3D12 fence unavailable for immediate work")
+        }
+        let currentFrame = Int(frameIndex)
+        let fenceValue = fenceValues[currentFrame] + 1
+        fenceValues[currentFrame] = fenceValue
+        try checkHRESULT(commandQueue.pointee.lpVtbl.pointee.Signal(commandQueue, fence, fenceValue), "ID3D12CommandQueue.Signal(immediate)")
+        try waitForFence(value: fenceValue)
+    }
+
+    /// Records `encode` on a fresh direct command list and executes it without waiting. The
+    /// caller releases the list and allocator once the queue has moved past them.
+    private func executeImmediateCommand(_ encode: (UnsafeMutablePointer<ID3D12GraphicsCommandList>) throws -> Void) throws -> ImmediateSubmission {
         guard let device, let commandQueue else {
             throw AgentError.internalError("D3D12 device or command queue unavailable for immediate work")
         }
@@ -1124,7 +1224,6 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         guard let allocator else {
             throw AgentError.internalError("Failed to create command allocator for immediate work")
         }
-        defer { var temp: UnsafeMutablePointer<ID3D12CommandAllocator>? = allocator; releaseCOM(&temp) }
 
         var list: UnsafeMutablePointer<ID3D12GraphicsCommandList>?
         try withUnsafeMutablePointer(to: &list) { pointer in
@@ -1144,34 +1243,34 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
             }
         }
         guard let list else {
+            var temp: UnsafeMutablePointer<ID3D12CommandAllocator>? = allocator
+            releaseCOM(&temp)
             throw AgentError.internalError("Failed to create command list for immediate work")
         }
+        let submission = ImmediateSubmission(list: list, allocator: allocator)
         do {
             try encode(list)
+            try checkHRESULT(list.pointee.lpVtbl.pointee.Close(list), "ID3D12GraphicsCommandList.Close(immediate)")
         } catch {
             list.pointee.lpVtbl.pointee.Close(list)
-            var temp: UnsafeMutablePointer<ID3D12GraphicsCommandList>? = list
-            releaseCOM(&temp)
+            D3D12RenderBackend.releaseImmediateSubmission(submission)
             throw error
         }
-        try checkHRESULT(list.pointee.lpVtbl.pointee.Close(list), "ID3D12GraphicsCommandList.Close(immediate)")
 
         var cmdListPointer = UnsafeMutableRawPointer(list).assumingMemoryBound(to: ID3D12CommandList.self)
         commandQueue.pointee.lpVtbl.pointee.ExecuteCommandLists(commandQueue, 1, &cmdListPointer)
+        return submission
+    }
 
-        guard let fence else {
-            var temp: UnsafeMutablePointer<ID3D12GraphicsCommandList>? = list
-            releaseCOM(&temp)
-            throw AgentError.internalError("D3D12 fence unavailable for immediate work")
-        }
-        let currentFrame = Int(frameIndex)
-        let fenceValue = fenceValues[currentFrame] + 1
-        fenceValues[currentFrame] = fenceValue
-        try checkHRESULT(commandQueue.pointee.lpVtbl.pointee.Signal(commandQueue, fence, fenceValue), "ID3D12CommandQueue.Signal(immediate)")
-        try waitForFence(value: fenceValue)
+    private static func releaseImmediateSubmission(_ submission: ImmediateSubmission) {
+        releaseUnknown(submission.list)
+        releaseUnknown(submission.allocator)
+    }
 
-        var tempList: UnsafeMutablePointer<ID3D12GraphicsCommandList>? = list
-        releaseCOM(&tempList)
+    /// `releaseCOM` for objects whose owner may already be gone.
+    private static func releaseUnknown<T>(_ pointer: UnsafeMutablePointer<T>) {
+        let unknown = UnsafeMutableRawPointer(pointer).assumingMemoryBound(to: IUnknown.self)
+        _ = unknown.pointee.lpVtbl.pointee.Release(unknown)
     }
 
     private func ensureFallbackTextureHandle() throws -> TextureHandle {
@@ -1324,6 +1423,7 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         let meshCount: Int
         let graphicsPipelineCount: Int
         let computePipelineCount: Int
+        let recovery: ResourceRecoveryLedger.Stats
     }
 
     internal func debugResourceInventory() -> DebugResourceInventory {
@@ -1333,7 +1433,8 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
             samplerCount: samplers.count,
             meshCount: meshes.count,
             graphicsPipelineCount: pipelines.count,
-            computePipelineCount: computePipelines.count
+            computePipelineCount: computePipelines.count,
+            recovery: recoveryLedger.stats
         )
     }
 
@@ -1399,18 +1500,17 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
             return existing
         }
 
-        let handle = MeshHandle()
-        meshes[handle] = MeshResource(
+        return meshes.insert(MeshResource(
             vertexBuffer: vertexBuffer,
             vertexCount: vertexCount,
             indexBuffer: indexBuffer,
             indexCount: indexCount,
             indexFormat: indexFormat
-        )
-        return handle
+        ))
     }
 
     public func destroy(_ handle: ResourceHandle) {
+        recoveryLedger.release(handle)
         switch handle {
         case .buffer(let buffer):
             if var resource = buffers.removeValue(forKey: buffer)?.resource {
@@ -1470,15 +1570,8 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         let module = try shaderLibrary.module(for: desc.shader)
         try module.validateVertexLayout(desc.vertexLayout)
 
-        let vertexShaderURL = try module.artifacts.requireDXILVertex(for: module.id)
-        let vertexShader = try Data(contentsOf: vertexShaderURL)
-        let pixelShaderURL = try module.artifacts.dxilFragmentURL(for: module.id)
-        let pixelShader: Data?
-        if let url = pixelShaderURL {
-            pixelShader = try Data(contentsOf: url)
-        } else {
-            pixelShader = nil
-        }
+        let vertexShader = try module.artifacts.requireDXILVertex(for: module.id)
+        let pixelShader = try module.artifacts.dxilFragmentData(for: module.id)
 
         // Root signature: CBV at b0 for transform plus descriptor tables for sampled textures.
         var rootParameters: [D3D12_ROOT_PARAMETER] = []
@@ -1717,17 +1810,18 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
             throw AgentError.internalError("Failed to create D3D12 pipeline state")
         }
 
-        let handle = PipelineHandle()
-        pipelines[handle] = PipelineResource(
-            handle: handle,
-            descriptor: desc,
-            module: module,
-            rootSignature: rootSignature,
-            pipelineState: pipelineState,
-            vertexStride: module.vertexLayout.stride,
-            fragmentTextureParameterIndices: textureParameterIndices,
-            samplerParameterIndices: samplerParameterIndices
-        )
+        let handle = pipelines.insert { handle in
+            PipelineResource(
+                handle: handle,
+                descriptor: desc,
+                module: module,
+                rootSignature: rootSignature,
+                pipelineState: pipelineState,
+                vertexStride: module.vertexLayout.stride,
+                fragmentTextureParameterIndices: textureParameterIndices,
+                samplerParameterIndices: samplerParameterIndices
+            )
+        }
         if builtinPipeline == nil {
             builtinPipeline = handle
         }
@@ -1735,6 +1829,8 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
     }
 
     public func draw(mesh: MeshHandle, pipeline: PipelineHandle, bindings: BindingSet, transform: float4x4) throws {
+        let profile = SDLProfiler.begin("render.draw")
+        defer { profile.end() }
         guard frameActive else {
             throw AgentError.internalError("draw called outside beginFrame/endFrame")
         }
@@ -1760,10 +1856,14 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         let vertexCount = (meshResource.vertexCount > 0 ? meshResource.vertexCount : buffer.length / stride)
         guard vertexCount > 0 else { return }
 
-        commandList.pointee.lpVtbl.pointee.SetPipelineState(commandList, pipelineResource.pipelineState)
-        commandList.pointee.lpVtbl.pointee.SetGraphicsRootSignature(commandList, pipelineResource.rootSignature)
-        let needsTextures = !pipelineResource.fragmentTextureParameterIndices.isEmpty
-        let needsSamplers = !pipelineResource.samplerParameterIndices.isEmpty
+        if bindTracker.needsPipeline(pipeline) {
+            commandList.pointee.lpVtbl.pointee.SetPipelineState(commandList, pipelineResource.pipelineState)
+            commandList.pointee.lpVtbl.pointee.SetGraphicsRootSignature(commandList, pipelineResource.rootSignature)
+        }
+        // Descriptor tables survive across draws with the same root signature.
+        let rebindTables = bindTracker.needsResources(bindings)
+        let needsTextures = rebindTables && !pipelineResource.fragmentTextureParameterIndices.isEmpty
+        let needsSamplers = rebindTables && !pipelineResource.samplerParameterIndices.isEmpty
         if needsTextures {
             if srvHeap == nil {
                 try ensureSrvHeap()
@@ -1856,25 +1956,32 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
                 "Material constants of size \(payload.byteCount) bytes provided for shader \(pipelineResource.descriptor.shader.rawValue) which does not declare push constants. Data will be ignored."
             )
         }
-        commandList.pointee.lpVtbl.pointee.IASetPrimitiveTopology(commandList, D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST)
+        let bindMeshBuffers = bindTracker.needsVertexBuffers(mesh)
+        if bindMeshBuffers {
+            commandList.pointee.lpVtbl.pointee.IASetPrimitiveTopology(commandList, D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST)
+        }
 
         transitionBuffer(meshResource.vertexBuffer, to: D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, commandList: commandList)
-        var view = D3D12_VERTEX_BUFFER_VIEW(
-            BufferLocation: buffer.resource.pointee.lpVtbl.pointee.GetGPUVirtualAddress(buffer.resource),
-            SizeInBytes: UINT(buffer.length),
-            StrideInBytes: UINT(stride)
-        )
-        commandList.pointee.lpVtbl.pointee.IASetVertexBuffers(commandList, 0, 1, &view)
+        if bindMeshBuffers {
+            var view = D3D12_VERTEX_BUFFER_VIEW(
+                BufferLocation: buffer.resource.pointee.lpVtbl.pointee.GetGPUVirtualAddress(buffer.resource),
+                SizeInBytes: UINT(buffer.length),
+                StrideInBytes: UINT(stride)
+            )
+            commandList.pointee.lpVtbl.pointee.IASetVertexBuffers(commandList, 0, 1, &view)
+        }
         if let indexHandle = meshResource.indexBuffer,
            meshResource.indexCount > 0,
            let indexBuffer = buffers[indexHandle] {
             transitionBuffer(indexHandle, to: D3D12_RESOURCE_STATE_INDEX_BUFFER, commandList: commandList)
-            var ibView = D3D12_INDEX_BUFFER_VIEW(
-                BufferLocation: indexBuffer.resource.pointee.lpVtbl.pointee.GetGPUVirtualAddress(indexBuffer.resource),
-                SizeInBytes: UINT(indexBuffer.length),
-                Format: convertIndexFormat(meshResource.indexFormat)
-            )
-            commandList.pointee.lpVtbl.pointee.IASetIndexBuffer(commandList, &ibView)
+            if bindMeshBuffers {
+                var ibView = D3D12_INDEX_BUFFER_VIEW(
+                    BufferLocation: indexBuffer.resource.pointee.lpVtbl.pointee.GetGPUVirtualAddress(indexBuffer.resource),
+                    SizeInBytes: UINT(indexBuffer.length),
+                    Format: convertIndexFormat(meshResource.indexFormat)
+                )
+                commandList.pointee.lpVtbl.pointee.IASetIndexBuffer(commandList, &ibView)
+            }
             commandList.pointee.lpVtbl.pointee.DrawIndexedInstanced(commandList, UINT(meshResource.indexCount), 1, 0, 0, 0)
         } else {
             commandList.pointee.lpVtbl.pointee.DrawInstanced(commandList, UINT(vertexCount), 1, 0, 0)
@@ -2057,8 +2164,7 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
             throw AgentError.internalError("Failed to create D3D12 compute root signature")
         }
 
-        let shaderURL = try module.artifacts.requireDXIL(for: module.id)
-        let shaderData = try Data(contentsOf: shaderURL)
+        let shaderData = try module.artifacts.requireDXIL(for: module.id)
         var pipelineState: UnsafeMutablePointer<ID3D12PipelineState>?
         try shaderData.withUnsafeBytes { bytes in
             guard let pointer = bytes.baseAddress else {
@@ -2084,239 +2190,272 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
             throw AgentError.internalError("Failed to create D3D12 compute pipeline state")
         }
 
-        let handle = ComputePipelineHandle()
-        let resource = ComputePipelineResource(
-            handle: handle,
-            descriptor: desc,
-            module: module,
-            rootSignature: rootSignature,
-            pipelineState: pipelineState,
-            uniformParameterIndices: uniformIndices,
-            storageParameterIndices: storageIndices,
-            textureParameterIndices: textureIndices,
-            storageTextureParameterIndices: storageTextureIndices,
-            samplerParameterIndices: samplerIndices,
-            pushConstantBinding: pushConstantBinding
-        )
-        computePipelines[handle] = resource
+        let handle = computePipelines.insert { handle in
+            ComputePipelineResource(
+                handle: handle,
+                descriptor: desc,
+                module: module,
+                rootSignature: rootSignature,
+                pipelineState: pipelineState,
+                uniformParameterIndices: uniformIndices,
+                storageParameterIndices: storageIndices,
+                textureParameterIndices: textureIndices,
+                storageTextureParameterIndices: storageTextureIndices,
+                samplerParameterIndices: samplerIndices,
+                pushConstantBinding: pushConstantBinding
+            )
+        }
         SDLLogger.debug("SDLKit.Graphics.D3D12", "makeComputePipeline id=\(handle.rawValue) shader=\(module.id.rawValue)")
         return handle
     }
 
     public func dispatchCompute(_ pipeline: ComputePipelineHandle, groupsX: Int, groupsY: Int, groupsZ: Int, bindings: BindingSet) throws {
+        let profile = SDLProfiler.begin("render.dispatchCompute")
+        defer { profile.end() }
         guard let resource = computePipelines[pipeline] else {
             throw AgentError.internalError("Unknown compute pipeline handle")
         }
+        // A compute PSO and heap change on a shared command list disturbs graphics state.
+        bindTracker.invalidate()
 
         let context = try acquireComputeCommandContext()
         let commandList = context.commandList
+        let dispatchLabel = GPUTimingLabel.dispatch(resource.module.id)
+        var immediateTimestamps: GPUTimestampRing.Scope? = nil
+        if context.requiresSubmission {
+            immediateTimestamps = timestampHeap != nil ? timestampRing.reserveImmediate(dispatchLabel) : nil
+            if let scope = immediateTimestamps { writeTimestamp(commandList, query: scope.begin) }
+        } else {
+            beginGPUScope(dispatchLabel)
+        }
 
         do {
-            commandList.pointee.lpVtbl.pointee.SetPipelineState(commandList, resource.pipelineState)
-            commandList.pointee.lpVtbl.pointee.SetComputeRootSignature(commandList, resource.rootSignature)
-
-            let needsTextures = !resource.textureParameterIndices.isEmpty
-            let needsStorageTextures = !resource.storageTextureParameterIndices.isEmpty
-            let needsSamplers = !resource.samplerParameterIndices.isEmpty
-            var descriptorHeaps: [UnsafeMutablePointer<ID3D12DescriptorHeap>?] = []
-            if needsTextures || needsStorageTextures {
-                if srvHeap == nil {
-                    try ensureSrvHeap()
-                }
-                if let srvHeap { descriptorHeaps.append(srvHeap) }
+            let written = try encodeComputeDispatch(resource, bindings: bindings, groups: (groupsX, groupsY, groupsZ), commandList: commandList)
+
+            for handle in written.buffers {
+                insertUAVBarrier(handle, commandList: commandList)
             }
-            if needsSamplers {
-                if samplerHeap == nil {
-                    try ensureSamplerHeap()
-                }
-                if let samplerHeap { descriptorHeaps.append(samplerHeap) }
+            for textureHandle in written.textures {
+                insertTextureUAVBarrier(textureHandle, commandList: commandList)
             }
-            if !descriptorHeaps.isEmpty {
-                descriptorHeaps.withUnsafeMutableBufferPointer { buffer in
-                    commandList.pointee.lpVtbl.pointee.SetDescriptorHeaps(commandList, UINT(buffer.count), buffer.baseAddress)
-                }
+        } catch {
+            if context.requiresSubmission {
+                _ = commandList.pointee.lpVtbl.pointee.Close(commandList)
+            } else {
+                endGPUScope()
             }
+            throw error
+        }
+
+        if context.requiresSubmission {
+            if let scope = immediateTimestamps {
+                writeTimestamp(commandList, query: scope.end)
+                resolveTimestampQueries(commandList, first: scope.begin, count: 2)
+            }
+            try finalizeComputeCommandContext(context)
+            pendingComputeTimestamps = immediateTimestamps
+        } else {
+            endGPUScope()
+        }
+    }
+
+    /// Binds `bindings` for `resource` on `commandList`, transitioning resources as needed,
+    /// and records one dispatch. Returns the storage resources it may have written.
+    private func encodeComputeDispatch(_ resource: ComputePipelineResource,
+                                       bindings: BindingSet,
+                                       groups: (x: Int, y: Int, z: Int),
+                                       commandList: UnsafeMutablePointer<ID3D12GraphicsCommandList>) throws -> (buffers: [BufferHandle], textures: [TextureHandle]) {
+        commandList.pointee.lpVtbl.pointee.SetPipelineState(commandList, resource.pipelineState)
+        commandList.pointee.lpVtbl.pointee.SetComputeRootSignature(commandList, resource.rootSignature)
+
+        let needsTextures = !resource.textureParameterIndices.isEmpty
+        let needsStorageTextures = !resource.storageTextureParameterIndices.isEmpty
+        let needsSamplers = !resource.samplerParameterIndices.isEmpty
+        var descriptorHeaps: [UnsafeMutablePointer<ID3D12DescriptorHeap>?] = []
+        if needsTextures || needsStorageTextures {
+            if srvHeap == nil {
+                try ensureSrvHeap()
+            }
+            if let srvHeap { descriptorHeaps.append(srvHeap) }
+        }
+        if needsSamplers {
+            if samplerHeap == nil {
+                try ensureSamplerHeap()
+            }
+            if let samplerHeap { descriptorHeaps.append(samplerHeap) }
+        }
+        if !descriptorHeaps.isEmpty {
+            descriptorHeaps.withUnsafeMutableBufferPointer { buffer in
+                commandList.pointee.lpVtbl.pointee.SetDescriptorHeaps(commandList, UINT(buffer.count), buffer.baseAddress)
+            }
+        }
 
-            for (slot, parameterIndex) in resource.uniformParameterIndices {
+        for (slot, parameterIndex) in resource.uniformParameterIndices {
+            guard let entry = bindings.resource(at: slot) else {
+                throw AgentError.invalidArgument("Missing uniform buffer binding at slot \(slot)")
+            }
+            let handle: BufferHandle
+            switch entry {
+            case .buffer(let bufferHandle):
+                handle = bufferHandle
+            case .texture:
+                throw AgentError.invalidArgument("Texture bound to uniform buffer slot \(slot) in compute dispatch")
+            }
+            guard let buffer = buffers[handle] else {
+                throw AgentError.invalidArgument("Unknown buffer handle bound at slot \(slot)")
+            }
+            transitionBuffer(handle, to: D3D12_RESOURCE_STATE_GENERIC_READ, commandList: commandList)
+            let gpuAddress = buffer.resource.pointee.lpVtbl.pointee.GetGPUVirtualAddress(buffer.resource)
+            commandList.pointee.lpVtbl.pointee.SetComputeRootConstantBufferView(commandList, UINT(parameterIndex), gpuAddress)
+        }
+
+        var storageBindings: [BufferHandle] = []
+        var storageTextureBindings: [TextureHandle] = []
+        for (slot, parameterIndex) in resource.storageParameterIndices {
+            guard let entry = bindings.resource(at: slot) else {
+                throw AgentError.invalidArgument("Missing storage buffer binding at slot \(slot)")
+            }
+            let handle: BufferHandle
+            switch entry {
+            case .buffer(let bufferHandle):
+                handle = bufferHandle
+            case .texture:
+                throw AgentError.invalidArgument("Texture bound to storage buffer slot \(slot) in compute dispatch")
+            }
+            guard let buffer = buffers[handle] else {
+                throw AgentError.invalidArgument("Unknown buffer handle bound at slot \(slot)")
+            }
+            transitionBuffer(handle, to: D3D12_RESOURCE_STATE_UNORDERED_ACCESS, commandList: commandList)
+            let gpuAddress = buffer.resource.pointee.lpVtbl.pointee.GetGPUVirtualAddress(buffer.resource)
+            commandList.pointee.lpVtbl.pointee.SetComputeRootUnorderedAccessView(commandList, UINT(parameterIndex), gpuAddress)
+            storageBindings.append(handle)
+        }
+
+        if needsTextures {
+            for (slot, parameterIndex) in resource.textureParameterIndices.sorted(by: { $0.key < $1.key }) {
                 guard let entry = bindings.resource(at: slot) else {
-                    throw AgentError.invalidArgument("Missing uniform buffer binding at slot \(slot)")
+                    throw AgentError.invalidArgument("Missing texture binding at slot \(slot) for compute dispatch")
                 }
-                let handle: BufferHandle
+                let textureHandle: TextureHandle
                 switch entry {
-                case .buffer(let bufferHandle):
-                    handle = bufferHandle
-                case .texture:
-                    throw AgentError.invalidArgument("Texture bound to uniform buffer slot \(slot) in compute dispatch")
+                case .texture(let handle):
+                    textureHandle = handle
+                case .buffer:
+                    throw AgentError.invalidArgument("Buffer bound to texture slot \(slot) for compute dispatch")
                 }
-                guard let buffer = buffers[handle] else {
-                    throw AgentError.invalidArgument("Unknown buffer handle bound at slot \(slot)")
+                guard let texture = textures[textureHandle] else {
+                    throw AgentError.invalidArgument("Unknown texture handle bound at slot \(slot)")
                 }
-                transitionBuffer(handle, to: D3D12_RESOURCE_STATE_GENERIC_READ, commandList: commandList)
-                let gpuAddress = buffer.resource.pointee.lpVtbl.pointee.GetGPUVirtualAddress(buffer.resource)
-                commandList.pointee.lpVtbl.pointee.SetComputeRootConstantBufferView(commandList, UINT(parameterIndex), gpuAddress)
+                transitionTexture(textureHandle, to: D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, commandList: commandList)
+                guard let gpuHandle = texture.srvGPUHandle else {
+                    throw AgentError.invalidArgument("Texture bound at slot \(slot) is missing a shader resource view")
+                }
+                commandList.pointee.lpVtbl.pointee.SetComputeRootDescriptorTable(commandList, UINT(parameterIndex), gpuHandle)
             }
+        }
 
-            var storageBindings: [BufferHandle] = []
-            var storageTextureBindings: [TextureHandle] = []
-            for (slot, parameterIndex) in resource.storageParameterIndices {
+        if needsStorageTextures {
+            for (slot, parameterIndex) in resource.storageTextureParameterIndices.sorted(by: { $0.key < $1.key }) {
                 guard let entry = bindings.resource(at: slot) else {
-                    throw AgentError.invalidArgument("Missing storage buffer binding at slot \(slot)")
+                    throw AgentError.invalidArgument("Missing storage texture binding at slot \(slot)")
                 }
-                let handle: BufferHandle
+                let textureHandle: TextureHandle
                 switch entry {
-                case .buffer(let bufferHandle):
-                    handle = bufferHandle
-                case .texture:
-                    throw AgentError.invalidArgument("Texture bound to storage buffer slot \(slot) in compute dispatch")
+                case .texture(let handle):
+                    textureHandle = handle
+                case .buffer:
+                    throw AgentError.invalidArgument("Buffer bound to storage texture slot \(slot) in compute dispatch")
                 }
-                guard let buffer = buffers[handle] else {
-                    throw AgentError.invalidArgument("Unknown buffer handle bound at slot \(slot)")
+                guard let texture = textures[textureHandle] else {
+                    throw AgentError.invalidArgument("Unknown texture handle bound at slot \(slot)")
                 }
-                transitionBuffer(handle, to: D3D12_RESOURCE_STATE_UNORDERED_ACCESS, commandList: commandList)
-                let gpuAddress = buffer.resource.pointee.lpVtbl.pointee.GetGPUVirtualAddress(buffer.resource)
-                commandList.pointee.lpVtbl.pointee.SetComputeRootUnorderedAccessView(commandList, UINT(parameterIndex), gpuAddress)
-                storageBindings.append(handle)
-            }
-
-            if needsTextures {
-                for (slot, parameterIndex) in resource.textureParameterIndices.sorted(by: { $0.key < $1.key }) {
-                    guard let entry = bindings.resource(at: slot) else {
-                        throw AgentError.invalidArgument("Missing texture binding at slot \(slot) for compute dispatch")
-                    }
-                    let textureHandle: TextureHandle
-                    switch entry {
-                    case .texture(let handle):
-                        textureHandle = handle
-                    case .buffer:
-                        throw AgentError.invalidArgument("Buffer bound to texture slot \(slot) for compute dispatch")
-                    }
-                    guard let texture = textures[textureHandle] else {
-                        throw AgentError.invalidArgument("Unknown texture handle bound at slot \(slot)")
-                    }
-                    transitionTexture(textureHandle, to: D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, commandList: commandList)
-                    guard let gpuHandle = texture.srvGPUHandle else {
-                        throw AgentError.invalidArgument("Texture bound at slot \(slot) is missing a shader resource view")
-                    }
-                    commandList.pointee.lpVtbl.pointee.SetComputeRootDescriptorTable(commandList, UINT(parameterIndex), gpuHandle)
+                guard let uavHandle = texture.uavGPUHandle else {
+                    throw AgentError.invalidArgument("Texture bound at slot \(slot) does not expose an unordered access view")
                 }
+                transitionTexture(textureHandle, to: D3D12_RESOURCE_STATE_UNORDERED_ACCESS, commandList: commandList)
+                commandList.pointee.lpVtbl.pointee.SetComputeRootDescriptorTable(commandList, UINT(parameterIndex), uavHandle)
+                storageTextureBindings.append(textureHandle)
             }
+        }
 
-            if needsStorageTextures {
-                for (slot, parameterIndex) in resource.storageTextureParameterIndices.sorted(by: { $0.key < $1.key }) {
-                    guard let entry = bindings.resource(at: slot) else {
-                        throw AgentError.invalidArgument("Missing storage texture binding at slot \(slot)")
-                    }
-                    let textureHandle: TextureHandle
-                    switch entry {
-                    case .texture(let handle):
-                        textureHandle = handle
-                    case .buffer:
-                        throw AgentError.invalidArgument("Buffer bound to storage texture slot \(slot) in compute dispatch")
-                    }
-                    guard let texture = textures[textureHandle] else {
-                        throw AgentError.invalidArgument("Unknown texture handle bound at slot \(slot)")
-                    }
-                    guard let uavHandle = texture.uavGPUHandle else {
-                        throw AgentError.invalidArgument("Texture bound at slot \(slot) does not expose an unordered access view")
-                    }
-                    transitionTexture(textureHandle, to: D3D12_RESOURCE_STATE_UNORDERED_ACCESS, commandList: commandList)
-                    commandList.pointee.lpVtbl.pointee.SetComputeRootDescriptorTable(commandList, UINT(parameterIndex), uavHandle)
-                    storageTextureBindings.append(textureHandle)
-                }
+        if needsSamplers {
+            guard let samplerHeap else {
+                throw AgentError.internalError("Sampler descriptor heap unavailable for compute bindings")
             }
-
-            if needsSamplers {
-                guard let samplerHeap else {
-                    throw AgentError.internalError("Sampler descriptor heap unavailable for compute bindings")
+            for (slot, parameterIndex) in resource.samplerParameterIndices.sorted(by: { $0.key < $1.key }) {
+                guard let samplerHandle = bindings.sampler(at: slot) else {
+                    throw AgentError.invalidArgument("Missing sampler binding at slot \(slot) for compute dispatch")
                 }
-                for (slot, parameterIndex) in resource.samplerParameterIndices.sorted(by: { $0.key < $1.key }) {
-                    guard let samplerHandle = bindings.sampler(at: slot) else {
-                        throw AgentError.invalidArgument("Missing sampler binding at slot \(slot) for compute dispatch")
-                    }
-                    guard let sampler = samplers[samplerHandle] else {
-                        throw AgentError.invalidArgument("Unknown sampler handle bound at slot \(slot)")
-                    }
-                    commandList.pointee.lpVtbl.pointee.SetComputeRootDescriptorTable(commandList, UINT(parameterIndex), sampler.gpuHandle)
+                guard let sampler = samplers[samplerHandle] else {
+                    throw AgentError.invalidArgument("Unknown sampler handle bound at slot \(slot)")
                 }
+                commandList.pointee.lpVtbl.pointee.SetComputeRootDescriptorTable(commandList, UINT(parameterIndex), sampler.gpuHandle)
             }
+        }
 
-            let expectedSize = resource.module.pushConstantSize
-            if expectedSize > 0 {
-                guard let payload = bindings.materialConstants else {
-                    let message = "Compute shader \(resource.module.id.rawValue) expects \(expectedSize) bytes of push constants but none were provided."
-                    SDLLogger.error("SDLKit.Graphics.D3D12", message)
-                    throw AgentError.invalidArgument(message)
-                }
-                let byteCount = payload.byteCount
-                guard byteCount == expectedSize else {
-                    let message = "Compute shader \(resource.module.id.rawValue) expects \(expectedSize) bytes of push constants but received \(byteCount)."
-                    SDLLogger.error("SDLKit.Graphics.D3D12", message)
-                    throw AgentError.invalidArgument(message)
+        let expectedSize = resource.module.pushConstantSize
+        if expectedSize > 0 {
+            guard let payload = bindings.materialConstants else {
+                let message = "Compute shader \(resource.module.id.rawValue) expects \(expectedSize) bytes of push constants but none were provided."
+                SDLLogger.error("SDLKit.Graphics.D3D12", message)
+                throw AgentError.invalidArgument(message)
+            }
+            let byteCount = payload.byteCount
+            guard byteCount == expectedSize else {
+                let message = "Compute shader \(resource.module.id.rawValue) expects \(expectedSize) bytes of push constants but received \(byteCount)."
+                SDLLogger.error("SDLKit.Graphics.D3D12", message)
+                throw AgentError.invalidArgument(message)
+            }
+            guard let binding = resource.pushConstantBinding else {
+                throw AgentError.internalError("Missing push constant binding metadata for compute shader \(resource.module.id.rawValue)")
+            }
+            switch binding {
+            case .rootConstants(let parameterIndex, let valueCount):
+                var words = [UInt32](repeating: 0, count: valueCount)
+                payload.withUnsafeBytes { bytes in
+                    if let base = bytes.baseAddress {
+                        memcpy(&words, base, min(bytes.count, valueCount * MemoryLayout<UInt32>.size))
+                    }
                 }
-                guard let binding = resource.pushConstantBinding else {
-                    throw AgentError.internalError("Missing push constant binding metadata for compute shader \(resource.module.id.rawValue)")
+                words.withUnsafeBufferPointer { buffer in
+                    commandList.pointee.lpVtbl.pointee.SetComputeRoot32BitConstants(commandList, UINT(parameterIndex), UINT(valueCount), buffer.baseAddress, 0)
                 }
-                switch binding {
-                case .rootConstants(let parameterIndex, let valueCount):
-                    var words = [UInt32](repeating: 0, count: valueCount)
+            case .constantBuffer(let parameterIndex, let size):
+                let buffer = try ensureComputePushConstantBuffer(minimumSize: size)
+                var mapped: UnsafeMutableRawPointer?
+                try checkHRESULT(buffer.pointee.lpVtbl.pointee.Map(buffer, 0, nil, &mapped), "ID3D12Resource.Map(computePushConstants)")
+                if let mapped {
+                    memset(mapped, 0, size)
                     payload.withUnsafeBytes { bytes in
                         if let base = bytes.baseAddress {
-                            memcpy(&words, base, min(bytes.count, valueCount * MemoryLayout<UInt32>.size))
+                            memcpy(mapped, base, min(bytes.count, size))
                         }
                     }
-                    words.withUnsafeBufferPointer { buffer in
-                        commandList.pointee.lpVtbl.pointee.SetComputeRoot32BitConstants(commandList, UINT(parameterIndex), UINT(valueCount), buffer.baseAddress, 0)
-                    }
-                case .constantBuffer(let parameterIndex, let size):
-                    let buffer = try ensureComputePushConstantBuffer(minimumSize: size)
-                    var mapped: UnsafeMutableRawPointer?
-                    try checkHRESULT(buffer.pointee.lpVtbl.pointee.Map(buffer, 0, nil, &mapped), "ID3D12Resource.Map(computePushConstants)")
-                    if let mapped {
-                        memset(mapped, 0, size)
-                        payload.withUnsafeBytes { bytes in
-                            if let base = bytes.baseAddress {
-                                memcpy(mapped, base, min(bytes.count, size))
-                            }
-                        }
-                    }
-                    buffer.pointee.lpVtbl.pointee.Unmap(buffer, 0, nil)
-                    let gpuAddress = buffer.pointee.lpVtbl.pointee.GetGPUVirtualAddress(buffer)
-                    commandList.pointee.lpVtbl.pointee.SetComputeRootConstantBufferView(commandList, UINT(parameterIndex), gpuAddress)
                 }
-            } else if let payload = bindings.materialConstants, payload.byteCount > 0 {
-                SDLLogger.warn(
-                    "SDLKit.Graphics.D3D12",
-                    "Material constants of size \(payload.byteCount) bytes provided for compute shader \(resource.module.id.rawValue) which does not declare push constants. Data will be ignored."
-                )
-            }
-
-            let dispatchX = max(1, groupsX)
-            let dispatchY = max(1, groupsY)
-            let dispatchZ = max(1, groupsZ)
-            commandList.pointee.lpVtbl.pointee.Dispatch(commandList, UINT(dispatchX), UINT(dispatchY), UINT(dispatchZ))
-
-            for handle in storageBindings {
-                insertUAVBarrier(handle, commandList: commandList)
-            }
-            for textureHandle in storageTextureBindings {
-                insertTextureUAVBarrier(textureHandle, commandList: commandList)
-            }
-        } catch {
-            if context.requiresSubmission {
-                _ = commandList.pointee.lpVtbl.pointee.Close(commandList)
+                buffer.pointee.lpVtbl.pointee.Unmap(buffer, 0, nil)
+                let gpuAddress = buffer.pointee.lpVtbl.pointee.GetGPUVirtualAddress(buffer)
+                commandList.pointee.lpVtbl.pointee.SetComputeRootConstantBufferView(commandList, UINT(parameterIndex), gpuAddress)
             }
-            throw error
+        } else if let payload = bindings.materialConstants, payload.byteCount > 0 {
+            SDLLogger.warn(
+                "SDLKit.Graphics.D3D12",
+                "Material constants of size \(payload.byteCount) bytes provided for compute shader \(resource.module.id.rawValue) which does not declare push constants. Data will be ignored."
+            )
         }
 
-        if context.requiresSubmission {
-            try finalizeComputeCommandContext(context)
-        }
+        let dispatchX = max(1, groups.x)
+        let dispatchY = max(1, groups.y)
+        let dispatchZ = max(1, groups.z)
+        commandList.pointee.lpVtbl.pointee.Dispatch(commandList, UINT(dispatchX), UINT(dispatchY), UINT(dispatchZ))
+        return (storageBindings, storageTextureBindings)
     }
 
     // MARK: - Readback
     public func readback(buffer: BufferHandle, into dst: UnsafeMutableRawPointer, length: Int) throws {
+        let profile = SDLProfiler.begin("render.readback")
+        defer { profile.end() }
         guard let resource = buffers[buffer] else {
-            throw AgentError.invalidArgument("Unknown buffer handle \(buffer.rawValue)")
+            throw AgentError.invalidArgument("\(buffers.missingDescription(buffer)) buffer handle \(buffer.rawValue)")
         }
         // Buffers are allocated on UPLOAD heap (CPU-visible). Map and copy.
         var mapped: UnsafeMutableRawPointer?
@@ -2425,6 +2564,101 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
             try waitForFence(value: pending)
             pendingComputeFenceValue = nil
         }
+        if let scope = pendingComputeTimestamps {
+            pendingComputeTimestamps = nil
+            resolveTimestampScopes([scope])
+        }
+    }
+
+    // MARK: - GPU timestamps
+
+    private func createTimestampResources() throws {
+        guard timestampHeap == nil else { return }
+        guard let device, let commandQueue else { throw AgentError.internalError("Device unavailable for timestamp queries") }
+        var frequency: UInt64 = 0
+        guard commandQueue.pointee.lpVtbl.pointee.GetTimestampFrequency(commandQueue, &frequency) >= 0, frequency > 0 else {
+            timings.timestampsSupported = false
+            SDLLogger.info("SDLKit.Graphics.D3D12", "Command queue reports no timestamp frequency; GPU timing scopes disabled")
+            return
+        }
+        var heapDesc = D3D12_QUERY_HEAP_DESC(Type: D3D12_QUERY_HEAP_TYPE_TIMESTAMP, Count: UINT(timestampRing.queryCount), NodeMask: 0)
+        var heap: UnsafeMutablePointer<ID3D12QueryHeap>?
+        try withUnsafeMutablePointer(to: &heap) { pointer in
+            try pointer.withMemoryRebound(to: Optional<UnsafeMutableRawPointer>.self, capacity: 1) { raw in
+                try checkHRESULT(device.pointee.lpVtbl.pointee.CreateQueryHeap(device, &heapDesc, &IID_ID3D12QueryHeap, raw), "ID3D12Device.CreateQueryHeap(timestamp)")
+            }
+        }
+        var heapProps = D3D12_HEAP_PROPERTIES(Type: D3D12_HEAP_TYPE_READBACK, CPUPageProperty: D3D12_CPU_PAGE_PROPERTY_UNKNOWN, MemoryPoolPreference: D3D12_MEMORY_POOL_UNKNOWN, CreationNodeMask: 0, VisibleNodeMask: 0)
+        var bufferDesc = D3D12_RESOURCE_DESC.Buffer(UINT64(timestampRing.queryCount * MemoryLayout<UInt64>.size))
+        var readback: UnsafeMutablePointer<ID3D12Resource>?
+        do {
+            try withUnsafeMutablePointer(to: &readback) { pointer in
+                try pointer.withMemoryRebound(to: Optional<UnsafeMutableRawPointer>.self, capacity: 1) { raw in
+                    try checkHRESULT(device.pointee.lpVtbl.pointee.CreateCommittedResource(device, &heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc, D3D12_RESOURCE_STATE_COPY_DEST, nil, &IID_ID3D12Resource, raw), "CreateCommittedResource(timestamp readback)")
+                }
+            }
+        } catch {
+            releaseCOM(&heap)
+            throw error
+        }
+        timestampHeap = heap
+        timestampReadback = readback
+        timestampFrequency = frequency
+        timestampRing.reset()
+        timings.timestampsSupported = true
+    }
+
+    /// Reads the previous results of this back buffer's query range (its fence has been
+    /// waited) and opens the frame scope.
+    private func beginTimestampFrame(_ list: UnsafeMutablePointer<ID3D12GraphicsCommandList>) {
+        guard timestampHeap != nil else { return }
+        resolveTimestampScopes(timestampRing.beginFrame(slot: Int(frameIndex)))
+        if let query = timestampRing.beginScope(GPUTimingLabel.frame) {
+            writeTimestamp(list, query: query)
+        }
+    }
+
+    /// Closes scopes left open and resolves the frame's queries into the readback buffer.
+    private func endTimestampFrame(_ list: UnsafeMutablePointer<ID3D12GraphicsCommandList>) {
+        guard timestampHeap != nil else { return }
+        for query in timestampRing.endFrame() {
+            writeTimestamp(list, query: query)
+        }
+        timings.noteDroppedScopes(timestampRing.takeDroppedScopes())
+        let range = timestampRing.frameQueryRange(Int(frameIndex))
+        resolveTimestampQueries(list, first: range.first, count: UInt32(timestampRing.usedQueries))
+    }
+
+    private func writeTimestamp(_ list: UnsafeMutablePointer<ID3D12GraphicsCommandList>, query: UInt32) {
+        guard let timestampHeap else { return }
+        list.pointee.lpVtbl.pointee.EndQuery(list, timestampHeap, D3D12_QUERY_TYPE_TIMESTAMP, UINT(query))
+    }
+
+    private func resolveTimestampQueries(_ list: UnsafeMutablePointer<ID3D12GraphicsCommandList>, first: UInt32, count: UInt32) {
+        guard let timestampHeap, let timestampReadback, count > 0 else { return }
+        let offset = UINT64(first) * UINT64(MemoryLayout<UInt64>.size)
+        list.pointee.lpVtbl.pointee.ResolveQueryData(list, timestampHeap, D3D12_QUERY_TYPE_TIMESTAMP, UINT(first), UINT(count), timestampReadback, offset)
+    }
+
+    private func resolveTimestampScopes(_ scopes: [GPUTimestampRing.Scope]) {
+        guard let timestampReadback, timestampFrequency > 0, !scopes.isEmpty else { return }
+        var mapped: UnsafeMutableRawPointer?
+        guard timestampReadback.pointee.lpVtbl.pointee.Map(timestampReadback, 0, nil, &mapped) >= 0, let mapped else { return }
+        let ticks = mapped.assumingMemoryBound(to: UInt64.self)
+        let samples = GPUTimestampRing.durations(of: scopes, nanosecondsPerTick: 1_000_000_000 / Double(timestampFrequency)) { ticks[Int($0)] }
+        var written = D3D12_RANGE(Begin: 0, End: 0)
+        timestampReadback.pointee.lpVtbl.pointee.Unmap(timestampReadback, 0, &written)
+        timings.record(samples)
+    }
+
+    public func beginGPUScope(_ label: String) {
+        guard frameActive, let commandList, timestampHeap != nil, let query = timestampRing.beginScope(label) else { return }
+        writeTimestamp(commandList, query: query)
+    }
+
+    public func endGPUScope() {
+        guard frameActive, let commandList, timestampHeap != nil, let query = timestampRing.endScope() else { return }
+        writeTimestamp(commandList, query: query)
     }
 
     private func ensureComputePushConstantBuffer(minimumSize: Int) throws -> UnsafeMutablePointer<ID3D12Resource> {
@@ -2505,6 +2739,12 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         try createCommandAllocators()
         try createCommandList()
         try createFence()
+        do {
+            try createTimestampResources()
+        } catch {
+            timings.timestampsSupported = false
+            SDLLogger.warn("SDLKit.Graphics.D3D12", "Timestamp query heap unavailable; GPU timing scopes disabled (\(error))")
+        }
         try createTransformBuffer()
     }
 
@@ -3040,10 +3280,11 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         }
     }
 
-    private func recreateBuffers(from snapshots: [BufferHandle: BufferSnapshot]) throws {
+    private func recreateBuffers(from snapshots: SlotMap<BufferHandle, BufferSnapshot>) throws {
         buffers.removeAll(keepingCapacity: true)
         for (handle, snapshot) in snapshots {
-            var resource = try buildBufferResource(length: snapshot.length, usage: snapshot.usage, initialData: snapshot.shadowCopy)
+            let contents = recoveryLedger.recoveryContents(for: .buffer(handle))?.first
+            var resource = try buildBufferResource(length: snapshot.length, usage: snapshot.usage, initialData: contents)
             if snapshot.state != D3D12_RESOURCE_STATE_GENERIC_READ {
                 try transitionResourceImmediately(resource.resource,
                                                   from: D3D12_RESOURCE_STATE_GENERIC_READ,
@@ -3054,10 +3295,11 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         }
     }
 
-    private func recreateTextures(from snapshots: [TextureHandle: TextureSnapshot]) throws {
+    private func recreateTextures(from snapshots: SlotMap<TextureHandle, TextureSnapshot>) throws {
         textures.removeAll(keepingCapacity: true)
         for (handle, snapshot) in snapshots {
-            let initialData = snapshot.shadowMipData.isEmpty ? nil : TextureInitialData(mipLevelData: snapshot.shadowMipData)
+            let contents = recoveryLedger.recoveryContents(for: .texture(handle)) ?? []
+            let initialData = contents.isEmpty ? nil : TextureInitialData(mipLevelData: contents)
             var resource = try buildTextureResource(descriptor: snapshot.descriptor, initialData: initialData)
             if resource.state != snapshot.state {
                 try transitionResourceImmediately(resource.resource,
@@ -3069,7 +3311,7 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         }
     }
 
-    private func recreateSamplers(from snapshots: [SamplerHandle: SamplerSnapshot]) throws {
+    private func recreateSamplers(from snapshots: SlotMap<SamplerHandle, SamplerSnapshot>) throws {
         samplers.removeAll(keepingCapacity: true)
         for (handle, snapshot) in snapshots {
             let resource = try buildSamplerResource(descriptor: snapshot.descriptor)
@@ -3092,13 +3334,11 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
         let bufferSnapshots = buffers.mapValues { resource in
             BufferSnapshot(length: resource.length,
                            usage: resource.usage,
-                           state: resource.state,
-                           shadowCopy: resource.shadowCopy)
+                           state: resource.state)
         }
         let textureSnapshots = textures.mapValues { resource in
             TextureSnapshot(descriptor: resource.descriptor,
-                            state: resource.state,
-                            shadowMipData: resource.shadowMipData)
+                            state: resource.state)
         }
         let samplerSnapshots = samplers.mapValues { resource in
             SamplerSnapshot(descriptor: resource.descriptor)
@@ -3132,6 +3372,10 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
                 fallbackTextureHandle = previousFallback
             }
             deviceEventHandler?(.didReset)
+            let discarded = recoveryLedger.takeDiscarded()
+            if !discarded.isEmpty {
+                deviceEventHandler?(.resourcesDiscarded(discarded))
+            }
             SDLLogger.info("SDLKit.Graphics.D3D12", "Device reset completed after loss: \(message)")
         } catch {
             deviceEventHandler?(.resetFailed(reason: message))
@@ -3155,6 +3399,13 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
             try? waitForFence(value: pending)
             pendingComputeFenceValue = nil
         }
+        // Outstanding readbacks resolve (or fail) before the resources they read go away.
+        pendingFrameCapture?.error = AgentError.deviceLost("D3D12 device released before the frame was submitted")
+        pendingFrameCapture = nil
+        pendingReadbacks.waitAll()
+        for staging in readbackStaging.drain() {
+            D3D12RenderBackend.releaseUnknown(staging)
+        }
         for (_, resource) in computePipelines {
             var state: UnsafeMutablePointer<ID3D12PipelineState>? = resource.pipelineState
             var signature: UnsafeMutablePointer<ID3D12RootSignature>? = resource.rootSignature
@@ -3193,6 +3444,9 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
             releaseCOM(&rb)
         }
         readbackBuffer = nil
+        releaseCOM(&timestampHeap)
+        releaseCOM(&timestampReadback)
+        pendingComputeTimestamps = nil
         if var computeBuffer = computePushConstantBuffer {
             releaseCOM(&computeBuffer)
         }
@@ -3242,4 +3496,294 @@ public final class D3D12RenderBackend: RenderBackend, GoldenImageCapturable {
     }
 }
 
+extension D3D12RenderBackend: RenderStateCounting {
+    public var stateCounters: RenderStateCounters { bindTracker.counters }
+}
+
+extension D3D12RenderBackend {
+    public var frameArena: FrameArena? { payloadArena }
+}
+
+extension D3D12RenderBackend: ComputeCommandListSubmitting {
+    /// Records the whole list on the compute command list and executes it once. UAV
+    /// barriers go only where the planner reports a hazard; state transitions still come
+    /// from binding each dispatch.
+    public func submitCompute(_ list: ComputeCommandList) throws -> ComputeFence {
+        let profile = SDLProfiler.begin("render.submitCompute")
+        defer { profile.end() }
+        guard !list.isEmpty else { return ComputeFence.signaled(dispatchCount: 0, barrierCount: 0) }
+        if frameActive {
+            throw AgentError.invalidArgument("Compute command lists must be submitted outside beginFrame/endFrame")
+        }
+        var resources: [ComputePipelineResource] = []
+        resources.reserveCapacity(list.count)
+        for dispatch in list.dispatches {
+            guard let resource = computePipelines[dispatch.pipeline] else {
+                throw AgentError.internalError("Unknown compute pipeline handle")
+            }
+            resources.append(resource)
+        }
+        bindTracker.invalidate()
+
+        let context = try acquireComputeCommandContext()
+        let commandList = context.commandList
+        let timestamps = timestampHeap != nil ? timestampRing.reserveImmediate(GPUTimingLabel.computeList(list.label)) : nil
+        if let scope = timestamps { writeTimestamp(commandList, query: scope.begin) }
+
+        var planner = ComputeHazardPlanner()
+        do {
+            for (dispatch, resource) in zip(list.dispatches, resources) {
+                let hazards = planner.barriers(before: ComputeHazardPlanner.accesses(of: dispatch.bindings, slots: resource.module.bindings))
+                insertUAVBarriers(hazards.map(\.resource), commandList: commandList)
+                _ = try encodeComputeDispatch(resource, bindings: dispatch.bindings, groups: dispatch.groups, commandList: commandList)
+            }
+            // Work submitted after the list observes its writes, as with single dispatches.
+            insertUAVBarriers(planner.writtenResources, commandList: commandList)
+        } catch {
+            _ = commandList.pointee.lpVtbl.pointee.Close(commandList)
+            throw error
+        }
+
+        if let scope = timestamps {
+            writeTimestamp(commandList, query: scope.end)
+            resolveTimestampQueries(commandList, first: scope.begin, count: 2)
+        }
+        try finalizeComputeCommandContext(context)
+        pendingComputeTimestamps = timestamps
+        guard let fenceValue = pendingComputeFenceValue else {
+            return ComputeFence.signaled(dispatchCount: list.count, barrierCount: planner.barrierCount)
+        }
+        return ComputeFence(
+            dispatchCount: list.count,
+            barrierCount: planner.barrierCount,
+            poll: { [weak self] in
+                guard let fence = self?.fence else { return true }
+                return fence.pointee.lpVtbl.pointee.GetCompletedValue(fence) >= fenceValue
+            },
+            wait: { [weak self] in
+                guard let self else { return }
+                if self.pendingComputeFenceValue == fenceValue {
+                    try self.waitForPendingComputeWork()
+                } else {
+                    try self.waitForFence(value: fenceValue)
+                }
+            }
+        )
+    }
+
+    private func insertUAVBarriers(_ resources: [ComputeHazardPlanner.Resource],
+                                   commandList: UnsafeMutablePointer<ID3D12GraphicsCommandList>) {
+        var barriers: [D3D12_RESOURCE_BARRIER] = []
+        barriers.reserveCapacity(resources.count)
+        for resource in resources {
+            let pointer: UnsafeMutablePointer<ID3D12Resource>?
+            switch resource {
+            case .buffer(let handle): pointer = buffers[handle]?.resource
+            case .texture(let handle): pointer = textures[handle]?.resource
+            }
+            guard let pointer else { continue }
+            var barrier = D3D12_RESOURCE_BARRIER()
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV
+            barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE
+            barrier.Anonymous.UAV = D3D12_RESOURCE_UAV_BARRIER(pResource: pointer)
+            barriers.append(barrier)
+        }
+        guard !barriers.isEmpty else { return }
+        barriers.withUnsafeMutableBufferPointer { buffer in
+            commandList.pointee.lpVtbl.pointee.ResourceBarrier(commandList, UINT(buffer.count), buffer.baseAddress)
+        }
+    }
+}
+
+extension D3D12RenderBackend: AsyncReadbackProviding {
+    /// Copies `range` into a pooled READBACK-heap buffer on its own direct command list, so
+    /// the token sees the buffer as it was at enqueue: writes made afterwards do not leak in.
+    /// UPLOAD-heap buffers stay in GENERIC_READ, which already allows copying from them.
+    public func enqueueReadback(buffer: BufferHandle, range requested: Range<Int>?) throws -> ReadbackToken<Data> {
+        let profile = SDLProfiler.begin("render.enqueueReadback")
+        defer { profile.end() }
+        guard let resource = buffers[buffer] else {
+            throw AgentError.invalidArgument("\(buffers.missingDescription(buffer)) buffer handle \(buffer.rawValue)")
+        }
+        let range = try Range<Int>.readbackRange(requested, length: resource.length)
+        guard !range.isEmpty else { return .resolved(Data()) }
+        let staging = try readbackStaging.acquire(length: range.count) { try makeReadbackStaging(capacity: $0) }
+
+        let submission: ImmediateSubmission
+        let fenceValue: UInt64
+        do {
+            submission = try executeImmediateCommand { list in
+                list.pointee.lpVtbl.pointee.CopyBufferRegion(list, staging.allocation, 0, resource.resource,
+                                                             UINT64(range.lowerBound), UINT64(range.count))
+            }
+        } catch {
+            recycleReadbackStaging(staging)
+            throw error
+        }
+        do {
+            fenceValue = try signalReadbackFence()
+        } catch {
+            try? waitGPU()
+            D3D12RenderBackend.releaseImmediateSubmission(submission)
+            recycleReadbackStaging(staging)
+            throw error
+        }
+
+        let count = range.count
+        let token = ReadbackToken<Data>(
+            poll: { [weak self] in self?.isFenceComplete(fenceValue) ?? true },
+            resolve: { [weak self] in
+                defer { D3D12RenderBackend.releaseImmediateSubmission(submission) }
+                return try D3D12RenderBackend.completeReadback(self, fenceValue: fenceValue, staging: staging) { mapped in
+                    Data(bytes: mapped, count: count)
+                }
+            }
+        )
+        pendingReadbacks.track(token)
+        return token
+    }
+
+    /// Copies mip 0 into a pooled READBACK-heap buffer on its own direct command list.
+    public func enqueueReadback(texture: TextureHandle) throws -> ReadbackToken<GoldenImageCapture> {
+        let profile = SDLProfiler.begin("render.enqueueReadback")
+        defer { profile.end() }
+        if frameActive {
+            // Tracked states already reflect the open frame, which executes after this copy.
+            throw AgentError.invalidArgument("Texture readbacks must be enqueued outside beginFrame/endFrame")
+        }
+        guard let resource = textures[texture] else {
+            throw AgentError.invalidArgument("\(textures.missingDescription(texture)) texture handle \(texture.rawValue)")
+        }
+        guard let device else {
+            throw AgentError.internalError("D3D12 device unavailable for texture readback")
+        }
+        var desc = resource.resource.pointee.lpVtbl.pointee.GetDesc(resource.resource)
+        var footprint = D3D12_PLACED_SUBRESOURCE_FOOTPRINT()
+        var numRows: UINT = 0
+        var rowSize: UINT64 = 0
+        var totalBytes: UINT64 = 0
+        device.pointee.lpVtbl.pointee.GetCopyableFootprints(device, &desc, 0, 1, &footprint, &numRows, &rowSize, &totalBytes)
+        let width = resource.descriptor.width, height = resource.descriptor.height
+        let rowPitch = Int(footprint.Footprint.RowPitch)
+        let staging = try readbackStaging.acquire(length: max(Int(totalBytes), rowPitch * height)) { try makeReadbackStaging(capacity: $0) }
+
+        let previousState = resource.state
+        let submission: ImmediateSubmission
+        let fenceValue: UInt64
+        do {
+            submission = try executeImmediateCommand { list in
+                transitionTexture(texture, to: D3D12_RESOURCE_STATE_COPY_SOURCE, commandList: list)
+                var src = D3D12_TEXTURE_COPY_LOCATION(pResource: resource.resource, Type: D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX, Anonymous: D3D12_TEXTURE_COPY_LOCATION._Anonymous(subresourceIndex: 0))
+                var dst = D3D12_TEXTURE_COPY_LOCATION(pResource: staging.allocation, Type: D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT, Anonymous: D3D12_TEXTURE_COPY_LOCATION._Anonymous(placedFootprint: footprint))
+                var box: D3D12_BOX? = nil
+                list.pointee.lpVtbl.pointee.CopyTextureRegion(list, &dst, 0, 0, 0, &src, &box)
+                transitionTexture(texture, to: previousState, commandList: list)
+            }
+        } catch {
+            recycleReadbackStaging(staging)
+            throw error
+        }
+        do {
+            fenceValue = try signalReadbackFence()
+        } catch {
+            try? waitGPU()
+            D3D12RenderBackend.releaseImmediateSubmission(submission)
+            recycleReadbackStaging(staging)
+            throw error
+        }
+
+        let layout = GoldenImageCapture.PixelLayout(resource.descriptor.format)
+        let token = ReadbackToken<GoldenImageCapture>(
+            poll: { [weak self] in self?.isFenceComplete(fenceValue) ?? true },
+            resolve: { [weak self] in
+                defer { D3D12RenderBackend.releaseImmediateSubmission(submission) }
+                return try D3D12RenderBackend.completeReadback(self, fenceValue: fenceValue, staging: staging) { mapped in
+                    GoldenImageCapture(width: width, height: height, bytesPerRow: rowPitch, layout: layout,
+                                       data: Data(bytes: mapped, count: rowPitch * height))
+                }
+            }
+        )
+        pendingReadbacks.track(token)
+        return token
+    }
+
+    public func enqueueFrameCapture() throws -> ReadbackToken<GoldenImageCapture> {
+        guard frameActive else {
+            throw AgentError.invalidArgument("enqueueFrameCapture must be called between beginFrame and endFrame")
+        }
+        // Several requests in one frame share its copy.
+        let request = pendingFrameCapture ?? FrameCaptureRequest()
+        pendingFrameCapture = request
+        let token = request.token()
+        pendingReadbacks.track(token)
+        return token
+    }
+
+    private func signalReadbackFence() throws -> UInt64 {
+        guard let commandQueue, let fence else {
+            throw AgentError.internalError("D3D12 command queue unavailable for readback")
+        }
+        let fenceValue = allocateFenceValue()
+        try checkHRESULT(commandQueue.pointee.lpVtbl.pointee.Signal(commandQueue, fence, fenceValue), "ID3D12CommandQueue.Signal(readback)")
+        return fenceValue
+    }
+
+    private func isFenceComplete(_ value: UInt64) -> Bool {
+        guard let fence else { return true }
+        return fence.pointee.lpVtbl.pointee.GetCompletedValue(fence) >= value
+    }
+
+    private func makeReadbackStaging(capacity: Int) throws -> UnsafeMutablePointer<ID3D12Resource> {
+        guard let device else {
+            throw AgentError.internalError("D3D12 device unavailable for readback staging")
+        }
+        var heapProps = D3D12_HEAP_PROPERTIES(Type: D3D12_HEAP_TYPE_READBACK, CPUPageProperty: D3D12_CPU_PAGE_PROPERTY_UNKNOWN, MemoryPoolPreference: D3D12_MEMORY_POOL_UNKNOWN, CreationNodeMask: 0, VisibleNodeMask: 0)
+        var bufferDesc = D3D12_RESOURCE_DESC.Buffer(UINT64(capacity))
+        var staging: UnsafeMutablePointer<ID3D12Resource>?
+        try withUnsafeMutablePointer(to: &staging) { pointer in
+            try pointer.withMemoryRebound(to: Optional<UnsafeMutableRawPointer>.self, capacity: 1) { raw in
+                try checkHRESULT(device.pointee.lpVtbl.pointee.CreateCommittedResource(device, &heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc, D3D12_RESOURCE_STATE_COPY_DEST, nil, &IID_ID3D12Resource, raw), "CreateCommittedResource(readback staging)")
+            }
+        }
+        guard let staging else {
+            throw AgentError.internalError("Failed to create D3D12 readback staging buffer")
+        }
+        return staging
+    }
+
+    private func recycleReadbackStaging(_ entry: ReadbackStagingEntry) {
+        if let evicted = readbackStaging.recycle(entry) {
+            D3D12RenderBackend.releaseUnknown(evicted)
+        }
+    }
+
+    /// Waits for `fenceValue`, reads `staging` and returns it to the pool. Without the backend
+    /// the staging buffer is released instead.
+    private static func completeReadback<Value>(_ backend: D3D12RenderBackend?,
+                                                fenceValue: UInt64,
+                                                staging: ReadbackStagingEntry,
+                                                produce: (UnsafeRawPointer) -> Value) throws -> Value {
+        guard let backend else {
+            releaseUnknown(staging.allocation)
+            throw AgentError.deviceLost("D3D12 backend released before the readback completed")
+        }
+        defer { backend.recycleReadbackStaging(staging) }
+        try backend.waitForFence(value: fenceValue)
+        let resource = staging.allocation
+        var readRange = D3D12_RANGE(Begin: 0, End: SIZE_T(staging.capacity))
+        var mapped: UnsafeMutableRawPointer?
+        try backend.checkHRESULT(resource.pointee.lpVtbl.pointee.Map(resource, 0, &readRange, &mapped), "ID3D12Resource.Map(readback staging)")
+        var written = D3D12_RANGE(Begin: 0, End: 0)
+        defer { resource.pointee.lpVtbl.pointee.Unmap(resource, 0, &written) }
+        guard let mapped else {
+            throw AgentError.internalError("ID3D12Resource.Map(readback staging) returned no data")
+        }
+        return produce(UnsafeRawPointer(mapped))
+    }
+}
+
+extension D3D12RenderBackend: GPUTimingProfiling {
+    public var gpuTimings: GPUTimingAggregator { timings }
+}
+
 #endif
@@ -0,0 +1,76 @@
+import Foundation
+
+/// Per-frame bump allocator for draw payloads (push constants, small uniform blocks).
+///
+/// Memory handed out stays valid until the next `reset()`; backends reset their arena
+/// in `beginFrame()`. Blocks are kept across frames, so once the arena has grown to a
+/// frame's working set every allocation is a pointer bump with no heap traffic.
+public final class FrameArena {
+    public static let defaultBlockSize = 64 * 1024
+
+    private struct Block {
+        let base: UnsafeMutableRawPointer
+        let capacity: Int
+    }
+
+    private let blockSize: Int
+    private var blocks: [Block] = []
+    private var blockIndex = 0
+    private var offset = 0
+
+    /// Incremented by every `reset()`; payloads from an older generation are stale.
+    public private(set) var generation: UInt64 = 0
+    /// Bytes handed out since the last reset (including alignment padding).
+    public private(set) var bytesInUse = 0
+    /// Heap blocks allocated over the arena's lifetime. Stable in steady state.
+    public private(set) var blockAllocations = 0
+
+    public init(blockSize: Int = FrameArena.defaultBlockSize) {
+        self.blockSize = max(256, blockSize)
+    }
+
+    deinit {
+        for block in blocks { block.base.deallocate() }
+    }
+
+    public func reset() {
+        blockIndex = 0
+        offset = 0
+        bytesInUse = 0
+        generation &+= 1
+    }
+
+    /// Returns `byteCount` bytes aligned to `alignment` (a power of two), valid until `reset()`.
+    public func allocate(byteCount: Int, alignment: Int = 16) -> UnsafeMutableRawBufferPointer {
+        precondition(alignment > 0 && alignment & (alignment - 1) == 0, "alignment must be a power of two")
+        let size = max(0, byteCount)
+        while blockIndex < blocks.count {
+            let block = blocks[blockIndex]
+            let aligned = (offset + alignment - 1) & ~(alignment - 1)
+            if aligned + size <= block.capacity {
+                bytesInUse += aligned + size - offset
+                offset = aligned + size
+                return UnsafeMutableRawBufferPointer(start: block.base + aligned, count: size)
+            }
+            blockIndex += 1
+            offset = 0
+        }
+        let capacity = max(blockSize, size + alignment)
+        let base = UnsafeMutableRawPointer.allocate(byteCount: capacity, alignment: max(alignment, 16))
+        blocks.append(Block(base: base, capacity: capacity))
+        blockAllocations += 1
+        blockIndex = blocks.count - 1
+        offset = size
+        bytesInUse += size
+        return UnsafeMutableRawBufferPointer(start: base, count: size)
+    }
+
+    /// Bump-allocates `byteCount` bytes, lets `fill` write them, and wraps the result
+    /// as material constants that reference arena memory without copying.
+    public func makeConstants(byteCount: Int,
+                              _ fill: (UnsafeMutableRawBufferPointer) -> Void) -> BindingSet.MaterialConstants {
+        let buffer = allocate(byteCount: byteCount)
+        fill(buffer)
+        return BindingSet.MaterialConstants(arenaBytes: UnsafeRawBufferPointer(buffer), arena: self)
+    }
+}
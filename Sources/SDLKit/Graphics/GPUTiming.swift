@@ -0,0 +1,422 @@
+import Foundation
+
+// MARK: - Labels
+
+/// Scope labels recorded by the backends themselves. User scopes may use any other label.
+public enum GPUTimingLabel {
+    /// Whole frame command stream, from `beginFrame()` to `endFrame()`.
+    public static let frame = "frame"
+
+    /// Every compute dispatch, in or out of a frame.
+    public static func dispatch(_ shader: ShaderID) -> String { "dispatch:\(shader.rawValue)" }
+
+    /// One submitted `ComputeCommandList`, named by its label.
+    public static func computeList(_ label: String?) -> String { "compute:\(label ?? "list")" }
+}
+
+// MARK: - Statistics
+
+/// Rolling statistics for one scope label over the aggregator's sample window.
+public struct GPUTimingStats: Equatable, Sendable {
+    public var label: String
+    /// Samples currently in the window.
+    public var sampleCount: Int
+    /// Samples recorded since creation or the last `reset()`.
+    public var totalSamples: Int
+    public var lastMilliseconds: Double
+    public var averageMilliseconds: Double
+    public var minMilliseconds: Double
+    public var maxMilliseconds: Double
+    public var p95Milliseconds: Double
+}
+
+/// Thread-safe per-label ring of GPU durations. Backends feed it from readback paths that
+/// may run off the main thread (Metal completion handlers), so all access is locked.
+public final class GPUTimingAggregator: @unchecked Sendable {
+    public static let defaultWindowSize = 120
+
+    private struct Series {
+        var samples: [Double] = []
+        var next = 0
+        var total = 0
+        var last: Double = 0
+    }
+
+    /// Backend name reported by the agent endpoint (e.g. "vulkan").
+    public let source: String
+    public let windowSize: Int
+    private let lock = NSLock()
+    private var series: [String: Series] = [:]
+    private var supported: Bool
+    private var labeledSupported: Bool
+    private var dropped = 0
+
+    public init(source: String,
+                windowSize: Int = GPUTimingAggregator.defaultWindowSize,
+                timestampsSupported: Bool = true,
+                labeledScopesSupported: Bool = true) {
+        self.source = source
+        self.windowSize = max(1, windowSize)
+        self.supported = timestampsSupported
+        self.labeledSupported = labeledScopesSupported
+    }
+
+    /// False when the device cannot write timestamps; scopes are then ignored.
+    public var timestampsSupported: Bool {
+        get { lock.lock(); defer { lock.unlock() }; return supported }
+        set { lock.lock(); supported = newValue; lock.unlock() }
+    }
+
+    /// False when only backend-recorded scopes (frame, dispatches) are timed and
+    /// `beginGPUScope` labels produce no samples, e.g. Metal devices without
+    /// stage-boundary counter sampling.
+    public var labeledScopesSupported: Bool {
+        get { lock.lock(); defer { lock.unlock() }; return labeledSupported }
+        set { lock.lock(); labeledSupported = newValue; lock.unlock() }
+    }
+
+    /// Scopes that did not fit in a frame's query budget.
+    public var droppedScopes: Int {
+        lock.lock(); defer { lock.unlock() }
+        return dropped
+    }
+
+    public func record(_ label: String, milliseconds: Double) {
+        lock.lock(); defer { lock.unlock() }
+        append(label, milliseconds)
+    }
+
+    public func record<S: Sequence>(_ samples: S) where S.Element == (label: String, milliseconds: Double) {
+        lock.lock(); defer { lock.unlock() }
+        for sample in samples { append(sample.label, sample.milliseconds) }
+    }
+
+    func noteDroppedScopes(_ count: Int) {
+        guard count > 0 else { return }
+        lock.lock(); dropped += count; lock.unlock()
+    }
+
+    private func append(_ label: String, _ milliseconds: Double) {
+        guard milliseconds.isFinite, milliseconds >= 0 else { return }
+        var entry = series[label] ?? Series()
+        if entry.samples.count < windowSize {
+            entry.samples.append(milliseconds)
+        } else {
+            entry.samples[entry.next] = milliseconds
+        }
+        entry.next = (entry.next + 1) % windowSize
+        entry.total += 1
+        entry.last = milliseconds
+        series[label] = entry
+    }
+
+    public func stats(for label: String) -> GPUTimingStats? {
+        lock.lock(); defer { lock.unlock() }
+        return series[label].map { Self.summarize(label, $0) }
+    }
+
+    /// Statistics for every label, sorted by label.
+    public func snapshot() -> [GPUTimingStats] {
+        lock.lock(); defer { lock.unlock() }
+        return series.keys.sorted().compactMap { key in series[key].map { Self.summarize(key, $0) } }
+    }
+
+    public func reset() {
+        lock.lock(); defer { lock.unlock() }
+        series.removeAll()
+        dropped = 0
+    }
+
+    private static func summarize(_ label: String, _ entry: Series) -> GPUTimingStats {
+        let sorted = entry.samples.sorted()
+        let count = sorted.count
+        let sum = sorted.reduce(0, +)
+        let p95Index = max(0, Int((Double(count) * 0.95).rounded(.up)) - 1)
+        return GPUTimingStats(
+            label: label,
+            sampleCount: count,
+            totalSamples: entry.total,
+            lastMilliseconds: entry.last,
+            averageMilliseconds: count > 0 ? sum / Double(count) : 0,
+            minMilliseconds: sorted.first ?? 0,
+            maxMilliseconds: sorted.last ?? 0,
+            p95Milliseconds: count > 0 ? sorted[min(p95Index, count - 1)] : 0
+        )
+    }
+}
+
+// MARK: - Backend surface
+
+// Optional protocol: backends that record GPU timestamps. Scopes nest, cover work recorded
+// into the active frame, and their results arrive once the frame's slot comes round again
+// (frames-in-flight later), so statistics lag the current frame.
+@MainActor
+public protocol GPUTimingProfiling: AnyObject {
+    var gpuTimings: GPUTimingAggregator { get }
+    func beginGPUScope(_ label: String)
+    func endGPUScope()
+}
+
+public extension RenderBackend {
+    /// Opens a labeled GPU timing scope; a no-op on backends without timestamp support.
+    func beginGPUScope(_ label: String) {
+        (self as? GPUTimingProfiling)?.beginGPUScope(label)
+    }
+
+    func endGPUScope() {
+        (self as? GPUTimingProfiling)?.endGPUScope()
+    }
+
+    func withGPUScope<T>(_ label: String, _ body: () throws -> T) rethrows -> T {
+        beginGPUScope(label)
+        defer { endGPUScope() }
+        return try body()
+    }
+
+    /// Rolling per-label GPU timings, empty when the backend does not profile.
+    var gpuTimingStats: [GPUTimingStats] {
+        (self as? GPUTimingProfiling)?.gpuTimings.snapshot() ?? []
+    }
+}
+
+/// Live aggregators, so the agent endpoint can report timings without owning the backends.
+@MainActor
+public enum GPUTimingRegistry {
+    private final class WeakEntry {
+        weak var aggregator: GPUTimingAggregator?
+        init(_ aggregator: GPUTimingAggregator) { self.aggregator = aggregator }
+    }
+
+    private static var entries: [WeakEntry] = []
+
+    static func register(_ aggregator: GPUTimingAggregator) {
+        entries.removeAll { $0.aggregator == nil || $0.aggregator === aggregator }
+        entries.append(WeakEntry(aggregator))
+    }
+
+    public static var aggregators: [GPUTimingAggregator] {
+        entries.removeAll { $0.aggregator == nil }
+        return entries.compactMap { $0.aggregator }
+    }
+}
+
+// MARK: - Query bookkeeping
+
+/// CPU-side bookkeeping for timestamp query pools shared by the backends. The pool is
+/// split into one fixed range per frame-in-flight slot plus a small round-robin range for
+/// out-of-frame submissions. Each scope reserves a begin/end query pair when it opens,
+/// so closing a scope never fails; scopes past the frame budget are counted as dropped.
+struct GPUTimestampRing {
+    struct Scope: Sendable {
+        var label: String
+        var begin: UInt32
+        var end: UInt32
+        var closed: Bool
+    }
+
+    let frameSlots: Int
+    let queriesPerFrame: Int
+    let immediateQueries: Int
+
+    private var recorded: [[Scope]]
+    private var slot: Int?
+    /// Queries reserved in the current (or just ended) frame slot, from its first query.
+    private(set) var usedQueries = 0
+    // Indices into `recorded[slot]` of open scopes; -1 marks a dropped scope.
+    private var open: [Int] = []
+    private var nextImmediate = 0
+    private(set) var droppedScopes = 0
+
+    init(frameSlots: Int, queriesPerFrame: Int = 128, immediateQueries: Int = 64) {
+        self.frameSlots = max(1, frameSlots)
+        self.queriesPerFrame = max(2, queriesPerFrame & ~1)
+        self.immediateQueries = max(0, immediateQueries & ~1)
+        self.recorded = Array(repeating: [], count: self.frameSlots)
+    }
+
+    var queryCount: Int { frameSlots * queriesPerFrame + immediateQueries }
+    var immediateCapacity: Int { immediateQueries / 2 }
+    var isRecording: Bool { slot != nil }
+
+    func frameQueryRange(_ slot: Int) -> (first: UInt32, count: UInt32) {
+        (UInt32((slot % frameSlots) * queriesPerFrame), UInt32(queriesPerFrame))
+    }
+
+    /// Starts recording into `slot` and returns the scopes recorded the last time the slot
+    /// was used. Callers wait for that submission first and read its results before
+    /// resetting the slot's queries.
+    mutating func beginFrame(slot: Int) -> [Scope] {
+        let index = slot % frameSlots
+        let completed = recorded[index].filter { $0.closed }
+        recorded[index].removeAll(keepingCapacity: true)
+        self.slot = index
+        usedQueries = 0
+        open.removeAll(keepingCapacity: true)
+        return completed
+    }
+
+    /// Returns the query to write at the start of the scope, or nil when not recording
+    /// or out of budget.
+    mutating func beginScope(_ label: String) -> UInt32? {
+        guard let slot else { return nil }
+        guard usedQueries + 2 <= queriesPerFrame else {
+            droppedScopes += 1
+            open.append(-1)
+            return nil
+        }
+        let base = UInt32(slot * queriesPerFrame + usedQueries)
+        usedQueries += 2
+        recorded[slot].append(Scope(label: label, begin: base, end: base + 1, closed: false))
+        open.append(recorded[slot].count - 1)
+        return base
+    }
+
+    /// Returns the query to write at the end of the innermost open scope.
+    mutating func endScope() -> UInt32? {
+        guard let slot, let index = open.popLast(), index >= 0 else { return nil }
+        recorded[slot][index].closed = true
+        return recorded[slot][index].end
+    }
+
+    /// Stops recording. Returns end queries of scopes left open, which the caller writes
+    /// before closing the command stream.
+    mutating func endFrame() -> [UInt32] {
+        var pending: [UInt32] = []
+        while !open.isEmpty {
+            if let query = endScope() { pending.append(query) }
+        }
+        slot = nil
+        return pending
+    }
+
+    /// Reserves a closed begin/end pair outside any frame. Pairs are reused round-robin, so
+    /// at most `immediateCapacity` may be outstanding.
+    mutating func reserveImmediate(_ label: String) -> Scope? {
+        guard immediateQueries >= 2 else { return nil }
+        let base = UInt32(frameSlots * queriesPerFrame + nextImmediate)
+        nextImmediate = (nextImmediate + 2) % immediateQueries
+        return Scope(label: label, begin: base, end: base + 1, closed: true)
+    }
+
+    /// Forgets everything recorded, e.g. after the query pool was recreated.
+    mutating func reset() {
+        for index in recorded.indices { recorded[index].removeAll() }
+        slot = nil
+        usedQueries = 0
+        open.removeAll()
+        nextImmediate = 0
+    }
+
+    /// Returns and clears the number of scopes dropped since the last call.
+    mutating func takeDroppedScopes() -> Int {
+        defer { droppedScopes = 0 }
+        return droppedScopes
+    }
+
+    /// Converts resolved timestamps into durations. `timestamp` returns nil for queries
+    /// whose result is not available; those scopes are skipped.
+    static func durations(of scopes: [Scope],
+                          nanosecondsPerTick: Double,
+                          validBits: Int = 64,
+                          timestamp: (UInt32) -> UInt64?) -> [(label: String, milliseconds: Double)] {
+        let mask: UInt64 = validBits >= 64 ? .max : (UInt64(1) << UInt64(max(1, validBits))) - 1
+        var out: [(label: String, milliseconds: Double)] = []
+        out.reserveCapacity(scopes.count)
+        for scope in scopes where scope.closed {
+            guard let begin = timestamp(scope.begin), let end = timestamp(scope.end) else { continue }
+            let ticks = (end &- begin) & mask
+            out.append((scope.label, Double(ticks) * nanosecondsPerTick / 1_000_000))
+        }
+        return out
+    }
+}
+
+/// Bookkeeping for backends that can only sample timestamps at encoder boundaries (Metal
+/// counter sample buffers). Every encoder created in a frame reserves a start/end sample
+/// pair; a scope spans from the start sample of the first encoder created inside it to the
+/// end sample of the last one, and records nothing when no encoder ran inside it. The
+/// backend splits its render encoder at scope boundaries so encoders never straddle one.
+struct GPUEncoderSampleRing {
+    private struct OpenScope {
+        var label: String
+        var begin: UInt32?
+        var end: UInt32?
+        var overflowed = false
+    }
+
+    let frameSlots: Int
+    let samplesPerFrame: Int
+
+    private var slot: Int?
+    private var usedSamples = 0
+    private var open: [OpenScope] = []
+    private var closed: [GPUTimestampRing.Scope] = []
+    private(set) var droppedScopes = 0
+
+    init(frameSlots: Int, samplesPerFrame: Int = 128) {
+        self.frameSlots = max(1, frameSlots)
+        self.samplesPerFrame = max(2, samplesPerFrame & ~1)
+    }
+
+    var sampleCount: Int { frameSlots * samplesPerFrame }
+    var isRecording: Bool { slot != nil }
+
+    /// Starts recording into `slot`. The caller must know the slot's previous frame has
+    /// completed before its samples are overwritten.
+    mutating func beginFrame(slot: Int) {
+        self.slot = slot % frameSlots
+        usedSamples = 0
+        open.removeAll(keepingCapacity: true)
+        closed.removeAll(keepingCapacity: true)
+    }
+
+    mutating func beginScope(_ label: String) {
+        guard slot != nil else { return }
+        open.append(OpenScope(label: label))
+    }
+
+    mutating func endScope() {
+        guard slot != nil, let scope = open.popLast() else { return }
+        if scope.overflowed {
+            droppedScopes += 1
+        } else if let begin = scope.begin, let end = scope.end {
+            closed.append(GPUTimestampRing.Scope(label: scope.label, begin: begin, end: end, closed: true))
+        }
+    }
+
+    /// Reserves the start/end samples for an encoder created inside the frame. Returns nil
+    /// when not recording, when no scope is open, or when the frame's budget is spent; open
+    /// scopes then report as dropped rather than with a partial duration.
+    mutating func reserveEncoder() -> (start: UInt32, end: UInt32)? {
+        guard let slot, !open.isEmpty else { return nil }
+        guard usedSamples + 2 <= samplesPerFrame else {
+            for index in open.indices { open[index].overflowed = true }
+            return nil
+        }
+        let start = UInt32(slot * samplesPerFrame + usedSamples)
+        usedSamples += 2
+        for index in open.indices {
+            if open[index].begin == nil { open[index].begin = start }
+            open[index].end = start + 1
+        }
+        return (start, start + 1)
+    }
+
+    /// Stops recording, closing scopes left open. Returns the frame's completed scopes and
+    /// the sample range to resolve once its command buffer finishes.
+    mutating func endFrame() -> (scopes: [GPUTimestampRing.Scope], samples: Range<Int>) {
+        guard let slot else { return ([], 0..<0) }
+        while !open.isEmpty { endScope() }
+        let first = slot * samplesPerFrame
+        let result = (closed, first..<(first + usedSamples))
+        closed.removeAll(keepingCapacity: true)
+        self.slot = nil
+        return result
+    }
+
+    /// Returns and clears the number of scopes dropped since the last call.
+    mutating func takeDroppedScopes() -> Int {
+        defer { droppedScopes = 0 }
+        return droppedScopes
+    }
+}
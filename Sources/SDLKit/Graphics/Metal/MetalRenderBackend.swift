@@ -55,6 +55,13 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
         var access: TextureAccessState
     }
 
+    // Labeled scopes of one submitted frame, resolved when its slot comes round again.
+    private struct PendingScopeSamples {
+        let commandBuffer: MTLCommandBuffer
+        let scopes: [GPUTimestampRing.Scope]
+        let samples: Range<Int>
+    }
+
     private let window: SDLWindow
     private let surface: RenderSurface
     private let layer: CAMetalLayer
@@ -62,16 +69,30 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
     private let commandQueue: MTLCommandQueue
     private let inflightSemaphore = DispatchSemaphore(value: 3)
 
-    private var buffers: [BufferHandle: BufferResource] = [:]
-    private var textures: [TextureHandle: TextureResource] = [:]
-    private var samplers: [SamplerHandle: SamplerResource] = [:]
-    private var pipelines: [PipelineHandle: PipelineResource] = [:]
-    private var computePipelines: [ComputePipelineHandle: ComputePipelineResource] = [:]
-    private var meshes: [MeshHandle: MeshResource] = [:]
+    private var buffers = SlotMap<BufferHandle, BufferResource>()
+    private var textures = SlotMap<TextureHandle, TextureResource>()
+    private var samplers = SlotMap<SamplerHandle, SamplerResource>()
+    private var pipelines = SlotMap<PipelineHandle, PipelineResource>()
+    private var computePipelines = SlotMap<ComputePipelineHandle, ComputePipelineResource>()
+    private var meshes = SlotMap<MeshHandle, MeshResource>()
 
     private var currentDrawable: CAMetalDrawable?
     private var currentCommandBuffer: MTLCommandBuffer?
     private var currentRenderEncoder: MTLRenderCommandEncoder?
+    // Open `beginGPUScope` labels, outermost first; each in-frame encoder carries them as
+    // debug groups so GPU captures show the same nesting as Vulkan and D3D12.
+    private var gpuScopeLabels: [String] = []
+    private var bindTracker = RenderBindTracker()
+    private let payloadArena = FrameArena()
+    private let timings = GPUTimingAggregator(source: RenderBackendFactory.Choice.metal.rawValue)
+    // Stage-boundary timestamps for labeled scopes, one sample range per frame in flight;
+    // nil when the device cannot sample at encoder boundaries.
+    private let scopeSampleBuffer: MTLCounterSampleBuffer?
+    private var encoderSamples: GPUEncoderSampleRing
+    private var pendingScopeSamples: [PendingScopeSamples?]
+    private var scopeSlot = 0
+    private var frameSerial = 0
+    private var scopeClockBase: (cpu: MTLTimestamp, gpu: MTLTimestamp) = (0, 0)
     private var currentRenderPassDescriptor: MTLRenderPassDescriptor?
     private var depthTexture: MTLTexture?
     private var lastSubmittedCommandBuffer: MTLCommandBuffer?
@@ -80,6 +101,9 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
     private var lastCaptureData: Data?
     private var lastCaptureBytesPerRow: Int = 0
     private var lastCaptureSize: (width: Int, height: Int) = (0, 0)
+    private var readbackStaging = ReadbackStagingPool<MTLBuffer>()
+    private var pendingReadbacks = PendingReadbacks()
+    private var pendingFrameCapture: FrameCaptureRequest?
 
     private let shaderLibrary: ShaderLibrary
     public var deviceEventHandler: RenderBackendDeviceEventHandler?
@@ -111,6 +135,15 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             throw AgentError.internalError("Unable to create Metal command queue")
         }
         self.commandQueue = queue
+        let encoderSamples = GPUEncoderSampleRing(frameSlots: 3)
+        self.encoderSamples = encoderSamples
+        self.pendingScopeSamples = Array(repeating: nil, count: encoderSamples.frameSlots)
+        self.scopeSampleBuffer = MetalRenderBackend.makeScopeSampleBuffer(device: device, sampleCount: encoderSamples.sampleCount)
+        timings.labeledScopesSupported = scopeSampleBuffer != nil
+        if scopeSampleBuffer != nil {
+            scopeClockBase = MetalRenderBackend.sampleClocks(device)
+        }
+        GPUTimingRegistry.register(timings)
 
         layer.device = device
         layer.pixelFormat = .bgra8Unorm
@@ -137,9 +170,8 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
         guard let triangle = MetalRenderBackend.makeTriangleVertexBuffer(device: device) else {
             throw AgentError.internalError("Failed to allocate builtin Metal triangle buffer")
         }
-        self.triangleBufferHandle = triangle.handle
+        self.triangleBufferHandle = self.buffers.insert(BufferResource(buffer: triangle.buffer, length: triangle.buffer.length))
         self.triangleVertexCount = triangle.count
-        self.buffers[triangle.handle] = BufferResource(buffer: triangle.buffer, length: triangle.buffer.length)
 
         SDLLogger.info(
             "SDLKit.Graphics.Metal",
@@ -150,11 +182,17 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
     // MARK: - RenderBackend
 
     public func beginFrame() throws {
+        let profile = SDLProfiler.begin("render.beginFrame")
+        defer { profile.end() }
         guard currentCommandBuffer == nil else {
             throw AgentError.internalError("beginFrame called while a frame is already active")
         }
 
         inflightSemaphore.wait()
+        pendingReadbacks.pump()
+        scopeSlot = frameSerial % encoderSamples.frameSlots
+        frameSerial &+= 1
+        resolveScopeSamples(slot: scopeSlot)
         lastCaptureData = nil
         lastCaptureBytesPerRow = 0
         lastCaptureSize = (0, 0)
@@ -169,9 +207,12 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             throw AgentError.internalError("Unable to allocate command buffer")
         }
         commandBuffer.label = "SDLKit.Frame"
+        let timings = self.timings
         commandBuffer.addCompletedHandler { [weak self] buffer in
             if let error = buffer.error {
                 SDLLogger.error("SDLKit.Graphics.Metal", "Metal command buffer error: \(error)")
+            } else {
+                MetalRenderBackend.recordGPUTime(of: buffer, label: GPUTimingLabel.frame, into: timings)
             }
             self?.inflightSemaphore.signal()
         }
@@ -180,19 +221,32 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
         self.currentCommandBuffer = commandBuffer
         self.currentRenderPassDescriptor = makeRenderPassDescriptor(for: drawable)
         self.currentRenderEncoder = nil
+        gpuScopeLabels.removeAll()
+        if scopeSampleBuffer != nil {
+            encoderSamples.beginFrame(slot: scopeSlot)
+        }
+        bindTracker.beginFrame()
+        payloadArena.reset()
     }
 
     public func endFrame() throws {
+        let profile = SDLProfiler.begin("render.endFrame")
+        defer { profile.end() }
         guard let commandBuffer = currentCommandBuffer, let drawable = currentDrawable else {
             throw AgentError.internalError("endFrame called without active frame")
         }
 
-        if let encoder = currentRenderEncoder {
-            encoder.endEncoding()
-            currentRenderEncoder = nil
+        endRenderEncoding()
+        gpuScopeLabels.removeAll()
+        if encoderSamples.isRecording {
+            let frame = encoderSamples.endFrame()
+            timings.noteDroppedScopes(encoderSamples.takeDroppedScopes())
+            pendingScopeSamples[scopeSlot] = frame.scopes.isEmpty
+                ? nil
+                : PendingScopeSamples(commandBuffer: commandBuffer, scopes: frame.scopes, samples: frame.samples)
         }
 
-        if captureRequested {
+        if captureRequested || pendingFrameCapture != nil {
             let width = drawable.texture.width
             let height = drawable.texture.height
             let bpp = 4
@@ -205,11 +259,17 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
                     drawable.texture.getBytes(base, bytesPerRow: bytesPerRow, from: region, mipmapLevel: 0)
                 }
             }
-            lastCaptureHash = MetalRenderBackend.hashHex(data: data)
-            lastCaptureData = data
-            lastCaptureBytesPerRow = bytesPerRow
-            lastCaptureSize = (width, height)
-            captureRequested = false
+            if captureRequested {
+                lastCaptureHash = MetalRenderBackend.hashHex(data: data)
+                lastCaptureData = data
+                lastCaptureBytesPerRow = bytesPerRow
+                lastCaptureSize = (width, height)
+                captureRequested = false
+            }
+            // The drawable is framebuffer-only, so enqueued captures share this copy.
+            pendingFrameCapture?.capture = GoldenImageCapture(width: width, height: height, bytesPerRow: bytesPerRow,
+                                                              layout: .bgra8Unorm, data: data)
+            pendingFrameCapture = nil
         }
 
         commandBuffer.present(drawable)
@@ -256,8 +316,7 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
         }
         buffer.label = "SDLKit.Buffer.\(usage)"
 
-        let handle = BufferHandle()
-        buffers[handle] = BufferResource(buffer: buffer, length: length)
+        let handle = buffers.insert(BufferResource(buffer: buffer, length: length))
         SDLLogger.debug("SDLKit.Graphics.Metal", "createBuffer id=\(handle.rawValue) length=\(length) usage=\(usage)")
         return handle
     }
@@ -308,8 +367,7 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             }
         }
 
-        let handle = TextureHandle()
-        textures[handle] = TextureResource(texture: texture, usage: descriptor.usage, access: .unknown)
+        let handle = textures.insert(TextureResource(texture: texture, usage: descriptor.usage, access: .unknown))
         SDLLogger.debug("SDLKit.Graphics.Metal", "createTexture id=\(handle.rawValue) size=\(descriptor.width)x\(descriptor.height) format=\(descriptor.format.rawValue)")
         return handle
     }
@@ -331,9 +389,7 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             throw AgentError.internalError("Failed to create Metal sampler state")
         }
 
-        let handle = SamplerHandle()
-        let resource = SamplerResource(descriptor: descriptor, state: sampler)
-        samplers[handle] = resource
+        let handle = samplers.insert(SamplerResource(descriptor: descriptor, state: sampler))
         SDLLogger.debug("SDLKit.Graphics.Metal", "createSampler id=\(handle.rawValue) label=\(descriptor.label ?? "<nil>")")
         return handle
     }
@@ -379,15 +435,13 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             return existing
         }
 
-        let handle = MeshHandle()
-        meshes[handle] = MeshResource(
+        return meshes.insert(MeshResource(
             vertexBuffer: vertexBuffer,
             vertexCount: vertexCount,
             indexBuffer: indexBuffer,
             indexCount: indexCount,
             indexFormat: indexFormat
-        )
-        return handle
+        ))
     }
 
     public func makePipeline(_ desc: GraphicsPipelineDescriptor) throws -> PipelineHandle {
@@ -445,7 +499,6 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             throw error
         }
 
-        let handle = PipelineHandle()
         let resource = PipelineResource(
             state: pipelineState,
             descriptor: desc,
@@ -456,7 +509,7 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             fragmentBindings: module.bindings[.fragment] ?? [],
             pushConstantSize: module.pushConstantSize
         )
-        pipelines[handle] = resource
+        let handle = pipelines.insert(resource)
         SDLLogger.debug("SDLKit.Graphics.Metal", "makePipeline id=\(handle.rawValue) label=\(pipelineDescriptor.label ?? "<nil>")")
         return handle
     }
@@ -465,6 +518,8 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
                      pipeline: PipelineHandle,
                      bindings: BindingSet,
                      transform: float4x4) throws {
+        let profile = SDLProfiler.begin("render.draw")
+        defer { profile.end() }
         guard let pipelineResource = pipelines[pipeline] else {
             throw AgentError.internalError("Unknown pipeline handle")
         }
@@ -481,7 +536,7 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
 
         // Prepare material constants first so we don't open an encoder if we're going to error.
         let expectedUniformLength = pipelineResource.pushConstantSize
-        var preparedUniforms: Data? = nil
+        var preparedUniforms: BindingSet.MaterialConstants? = nil
         if expectedUniformLength > 0 {
             if let payload = bindings.materialConstants {
                 let byteCount = payload.byteCount
@@ -490,7 +545,7 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
                     SDLLogger.error("SDLKit.Graphics.Metal", message)
                     throw AgentError.invalidArgument(message)
                 }
-                preparedUniforms = payload.data
+                preparedUniforms = payload
             } else {
                 // Graceful fallback: provide an identity transform in the first 64 bytes
                 // and zero the remaining bytes.
@@ -500,7 +555,7 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
                     let n = min(expectedUniformLength, mat.count)
                     data.replaceSubrange(0..<n, with: mat.prefix(n))
                 }
-                preparedUniforms = data
+                preparedUniforms = BindingSet.MaterialConstants(data: data)
             }
         } else if let payload = bindings.materialConstants, payload.byteCount > 0 {
             SDLLogger.warn(
@@ -512,7 +567,9 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
         let hadEncoder = (currentRenderEncoder != nil)
         let encoder = try obtainRenderEncoder(for: pipelineResource, commandBuffer: commandBuffer)
         do {
-            encoder.setRenderPipelineState(pipelineResource.state)
+            if bindTracker.needsPipeline(pipeline) {
+                encoder.setRenderPipelineState(pipelineResource.state)
+            }
             if let uniforms = preparedUniforms {
                 uniforms.withUnsafeBytes { bytes in
                     guard let base = bytes.baseAddress else { return }
@@ -520,22 +577,26 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
                     encoder.setFragmentBytes(base, length: bytes.count, index: 1)
                 }
             }
-        encoder.setVertexBuffer(vertexResource.buffer, offset: 0, index: 0)
-
-        try bindResources(
-            pipelineResource.vertexBindings,
-            stage: .vertex,
-            shader: pipelineResource.descriptor.shader,
-            encoder: encoder,
-            bindings: bindings
-        )
-        try bindResources(
-            pipelineResource.fragmentBindings,
-            stage: .fragment,
-            shader: pipelineResource.descriptor.shader,
-            encoder: encoder,
-            bindings: bindings
-        )
+        if bindTracker.needsVertexBuffers(mesh) {
+            encoder.setVertexBuffer(vertexResource.buffer, offset: 0, index: 0)
+        }
+
+        if bindTracker.needsResources(bindings) {
+            try bindResources(
+                pipelineResource.vertexBindings,
+                stage: .vertex,
+                shader: pipelineResource.descriptor.shader,
+                encoder: encoder,
+                bindings: bindings
+            )
+            try bindResources(
+                pipelineResource.fragmentBindings,
+                stage: .fragment,
+                shader: pipelineResource.descriptor.shader,
+                encoder: encoder,
+                bindings: bindings
+            )
+        }
 
         let vertexCount = meshResource.vertexCount > 0
             ? meshResource.vertexCount
@@ -557,9 +618,7 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
         }
         } catch {
             // Ensure encoder is closed on error to satisfy Metal's lifetime rules.
-            if !hadEncoder, let active = currentRenderEncoder {
-                active.endEncoding(); currentRenderEncoder = nil
-            }
+            if !hadEncoder { endRenderEncoding() }
             throw error
         }
     }
@@ -576,8 +635,7 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             throw error
         }
 
-        let handle = ComputePipelineHandle()
-        computePipelines[handle] = ComputePipelineResource(state: state, module: module)
+        let handle = computePipelines.insert(ComputePipelineResource(state: state, module: module))
         SDLLogger.debug("SDLKit.Graphics.Metal", "makeComputePipeline id=\(handle.rawValue) label=\(desc.label ?? module.id.rawValue)")
         return handle
     }
@@ -587,6 +645,8 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
                                  groupsY: Int,
                                  groupsZ: Int,
                                  bindings: BindingSet) throws {
+        let profile = SDLProfiler.begin("render.dispatchCompute")
+        defer { profile.end() }
         guard let resource = computePipelines[pipeline] else {
             throw AgentError.internalError("Unknown compute pipeline handle")
         }
@@ -608,12 +668,54 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             ownsCommandBuffer = true
         }
 
-        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+        guard let encoder = makeComputeEncoder(on: commandBuffer) else {
             throw AgentError.internalError("Failed to create Metal compute command encoder")
         }
         encoder.label = "SDLKit.ComputeDispatch"
-        encoder.setComputePipelineState(resource.state)
+        pushGPUScopeLabels(on: encoder)
+
+        let barrierHandles: Set<TextureHandle>
+        do {
+            barrierHandles = try encodeComputeDispatch(resource, bindings: bindings, groups: (groupsX, groupsY, groupsZ), encoder: encoder)
+        } catch {
+            popGPUScopeLabels(from: encoder)
+            encoder.endEncoding()
+            throw error
+        }
+        var barrierTextures: [MTLTexture] = []
+        barrierTextures.reserveCapacity(barrierHandles.count)
+        for handle in barrierHandles {
+            if let texture = textures[handle]?.texture {
+                barrierTextures.append(texture)
+            }
+        }
+        let usedResourceBarriers = encodeTextureBarriers(within: encoder, textures: barrierTextures)
+        encoder.memoryBarrier(scope: .buffers)
+        popGPUScopeLabels(from: encoder)
+        encoder.endEncoding()
+
+        if !usedResourceBarriers, !barrierTextures.isEmpty {
+            if !encodeBlitTextureBarriers(on: commandBuffer, textures: barrierTextures) {
+                let handles = barrierHandles.map { String($0.rawValue) }.sorted().joined(separator: ", ")
+                let message = "Unable to encode texture synchronization barrier for compute-dispatched textures [\(handles)]."
+                SDLLogger.error("SDLKit.Graphics.Metal", message)
+            }
+        }
 
+        if ownsCommandBuffer {
+            commandBuffer.commit()
+            commandBuffer.waitUntilCompleted()
+            MetalRenderBackend.recordGPUTime(of: commandBuffer, label: GPUTimingLabel.dispatch(resource.module.id), into: timings)
+        }
+    }
+
+    /// Binds `bindings` for `resource` on `encoder` and encodes one dispatch. Returns the
+    /// textures the dispatch accessed; textures' tracked access is updated.
+    private func encodeComputeDispatch(_ resource: ComputePipelineResource,
+                                       bindings: BindingSet,
+                                       groups: (x: Int, y: Int, z: Int),
+                                       encoder: MTLComputeCommandEncoder) throws -> Set<TextureHandle> {
+        encoder.setComputePipelineState(resource.state)
         var textureTracker = MetalComputeTextureAccessTracker()
         var updatedTextureResources: [(TextureHandle, TextureResource)] = []
 
@@ -621,36 +723,30 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             switch slot.kind {
             case .uniformBuffer, .storageBuffer:
                 guard let entry = bindings.resource(at: slot.index) else {
-                    encoder.endEncoding()
                     throw AgentError.invalidArgument("Missing buffer binding for compute slot \(slot.index)")
                 }
                 switch entry {
                 case .buffer(let handle):
                     guard let bufferResource = buffers[handle] else {
-                        encoder.endEncoding()
                         throw AgentError.invalidArgument("Unknown buffer handle for compute slot \(slot.index)")
                     }
                     encoder.setBuffer(bufferResource.buffer, offset: 0, index: slot.index)
                 case .texture:
-                    encoder.endEncoding()
                     throw AgentError.invalidArgument("Texture bound to buffer slot \(slot.index) in compute dispatch")
                 }
             case .sampledTexture, .storageTexture:
                 guard let entry = bindings.resource(at: slot.index) else {
-                    encoder.endEncoding()
                     throw AgentError.invalidArgument("Missing texture binding for compute slot \(slot.index)")
                 }
                 switch entry {
                 case .texture(let handle):
                     guard var texture = textures[handle] else {
-                        encoder.endEncoding()
                         throw AgentError.invalidArgument("Unknown texture handle for compute slot \(slot.index)")
                     }
                     let requirement: MetalComputeTextureAccessTracker.Requirement = (slot.kind == .storageTexture) ? .writable : .readable
                     if let reason = textureTracker.register(handle: handle, requirement: requirement, usage: texture.usage) {
                         let message = "Cannot encode compute access for texture \(handle.rawValue): \(reason)"
                         SDLLogger.error("SDLKit.Graphics.Metal", message)
-                        encoder.endEncoding()
                         throw AgentError.invalidArgument(message)
                     }
                     encoder.setTexture(texture.texture, index: slot.index)
@@ -662,7 +758,6 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
                     }
                     updatedTextureResources.append((handle, texture))
                 case .buffer:
-                    encoder.endEncoding()
                     throw AgentError.invalidArgument("Buffer bound to texture slot \(slot.index) in compute dispatch")
                 }
             case .sampler:
@@ -674,7 +769,6 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
                         slot: slot.index,
                         reason: "is missing a sampler"
                     )
-                    encoder.endEncoding()
                     throw error
                 }
                 guard let samplerResource = samplers[samplerHandle] else {
@@ -684,7 +778,6 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
                         slot: slot.index,
                         reason: "references unknown sampler handle \(samplerHandle.rawValue)"
                     )
-                    encoder.endEncoding()
                     throw error
                 }
                 encoder.setSamplerState(samplerResource.state, index: slot.index)
@@ -695,28 +788,17 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             textures[handle] = texture
         }
 
-        let barrierHandles = textureTracker.handlesNeedingBarrier
-        var barrierTextures: [MTLTexture] = []
-        barrierTextures.reserveCapacity(barrierHandles.count)
-        for handle in barrierHandles {
-            if let texture = textures[handle]?.texture {
-                barrierTextures.append(texture)
-            }
-        }
-
         let expectedPushConstantSize = resource.module.pushConstantSize
         if expectedPushConstantSize > 0 {
             guard let payload = bindings.materialConstants else {
                 let message = "Compute shader \(resource.module.id.rawValue) expects \(expectedPushConstantSize) bytes of push constants but none were provided."
                 SDLLogger.error("SDLKit.Graphics.Metal", message)
-                encoder.endEncoding()
                 throw AgentError.invalidArgument(message)
             }
             let byteCount = payload.byteCount
             guard byteCount == expectedPushConstantSize else {
                 let message = "Compute shader \(resource.module.id.rawValue) expects \(expectedPushConstantSize) bytes of push constants but received \(byteCount)."
                 SDLLogger.error("SDLKit.Graphics.Metal", message)
-                encoder.endEncoding()
                 throw AgentError.invalidArgument(message)
             }
             payload.withUnsafeBytes { bytes in
@@ -735,23 +817,17 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
         let tgHeight = max(1, threadgroupSize.1)
         let tgDepth = max(1, threadgroupSize.2)
         let threadsPerThreadgroup = MTLSize(width: tgWidth, height: tgHeight, depth: tgDepth)
-        let threadgroups = MTLSize(width: max(1, groupsX), height: max(1, groupsY), depth: max(1, groupsZ))
+        let threadgroups = MTLSize(width: max(1, groups.x), height: max(1, groups.y), depth: max(1, groups.z))
         encoder.dispatchThreadgroups(threadgroups, threadsPerThreadgroup: threadsPerThreadgroup)
-        let usedResourceBarriers = encodeTextureBarriers(within: encoder, textures: barrierTextures)
-        encoder.memoryBarrier(scope: .buffers)
-        encoder.endEncoding()
-
-        if !usedResourceBarriers, !barrierTextures.isEmpty {
-            if !encodeBlitTextureBarriers(on: commandBuffer, textures: barrierTextures) {
-                let handles = barrierHandles.map { String($0.rawValue) }.sorted().joined(separator: ", ")
-                let message = "Unable to encode texture synchronization barrier for compute-dispatched textures [\(handles)]."
-                SDLLogger.error("SDLKit.Graphics.Metal", message)
-            }
-        }
+        return textureTracker.handlesNeedingBarrier
+    }
 
-        if ownsCommandBuffer {
-            commandBuffer.commit()
-            commandBuffer.waitUntilCompleted()
+    // Frames, out-of-frame dispatches and compute lists are timed from the command buffer's
+    // GPU start/end times; labeled scopes use `scopeSampleBuffer` instead.
+    private nonisolated static func recordGPUTime(of buffer: MTLCommandBuffer, label: String, into timings: GPUTimingAggregator) {
+        if #available(macOS 10.15, iOS 10.3, tvOS 10.3, *) {
+            let seconds = buffer.gpuEndTime - buffer.gpuStartTime
+            if seconds > 0 { timings.record(label, milliseconds: seconds * 1000) }
         }
     }
 
@@ -928,15 +1004,16 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             let width = currentDrawable?.texture.width ?? Int(drawableSize.width * layerScale)
             let height = currentDrawable?.texture.height ?? Int(drawableSize.height * layerScale)
             ensureDepthTexture(width: width, height: height)
-            if let depthTexture {
-                if let depthAttachment = descriptor.depthAttachment {
-                    depthAttachment.texture = depthTexture
-                    depthAttachment.loadAction = .clear
-                    depthAttachment.storeAction = .dontCare
-                    depthAttachment.clearDepth = 1.0
-                }
+            // Only the frame's first encoder clears; encoders split at scope boundaries load
+            // (see `endRenderEncoding`), so depth is stored whenever a split can happen.
+            if let depthTexture, let depthAttachment = descriptor.depthAttachment, depthAttachment.texture == nil {
+                depthAttachment.texture = depthTexture
+                depthAttachment.loadAction = .clear
+                depthAttachment.storeAction = scopeSampleBuffer != nil ? .store : .dontCare
+                depthAttachment.clearDepth = 1.0
             }
         }
+        attachScopeSamples(to: descriptor)
 
         guard let encoder = commandBuffer.makeRenderCommandEncoder(descriptor: descriptor) else {
             throw AgentError.internalError("Failed to create render command encoder")
@@ -951,10 +1028,122 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             znear: 0.0,
             zfar: 1.0
         ))
+        pushGPUScopeLabels(on: encoder)
         currentRenderEncoder = encoder
+        // Encoder state starts empty; nothing bound on a previous encoder carries over.
+        bindTracker.invalidate()
         return encoder
     }
 
+    /// Ends the frame's render encoder, closing the scope debug groups open on it first.
+    /// A later encoder in the same frame loads the attachments instead of clearing them.
+    private func endRenderEncoding() {
+        guard let encoder = currentRenderEncoder else { return }
+        popGPUScopeLabels(from: encoder)
+        encoder.endEncoding()
+        currentRenderEncoder = nil
+        currentRenderPassDescriptor?.colorAttachments[0]?.loadAction = .load
+        currentRenderPassDescriptor?.depthAttachment?.loadAction = .load
+    }
+
+    /// Ends the render encoder at a labeled scope boundary so its work lands on encoders
+    /// whose stage-boundary samples belong to the scope.
+    private func splitRenderEncodingForScope() {
+        guard encoderSamples.isRecording else { return }
+        endRenderEncoding()
+    }
+
+    private func attachScopeSamples(to descriptor: MTLRenderPassDescriptor) {
+        guard let attachment = descriptor.sampleBufferAttachments[0] else { return }
+        guard let sampleBuffer = scopeSampleBuffer, let samples = encoderSamples.reserveEncoder() else {
+            attachment.sampleBuffer = nil
+            return
+        }
+        attachment.sampleBuffer = sampleBuffer
+        attachment.startOfVertexSampleIndex = Int(samples.start)
+        attachment.endOfVertexSampleIndex = MTLCounterDontSample
+        attachment.startOfFragmentSampleIndex = MTLCounterDontSample
+        attachment.endOfFragmentSampleIndex = Int(samples.end)
+    }
+
+    private func makeComputeEncoder(on commandBuffer: MTLCommandBuffer) -> MTLComputeCommandEncoder? {
+        guard let sampleBuffer = scopeSampleBuffer, let samples = encoderSamples.reserveEncoder() else {
+            return commandBuffer.makeComputeCommandEncoder()
+        }
+        let descriptor = MTLComputePassDescriptor()
+        if let attachment = descriptor.sampleBufferAttachments[0] {
+            attachment.sampleBuffer = sampleBuffer
+            attachment.startOfEncoderSampleIndex = Int(samples.start)
+            attachment.endOfEncoderSampleIndex = Int(samples.end)
+        }
+        return commandBuffer.makeComputeCommandEncoder(descriptor: descriptor)
+    }
+
+    /// Records the labeled scopes of the frame that last used `slot`. Its command buffer
+    /// has normally completed already, since `beginFrame` waited for a free frame slot.
+    private func resolveScopeSamples(slot: Int) {
+        guard let pending = pendingScopeSamples[slot], let sampleBuffer = scopeSampleBuffer else { return }
+        pendingScopeSamples[slot] = nil
+        pending.commandBuffer.waitUntilCompleted()
+        guard pending.commandBuffer.error == nil,
+              let data = try? sampleBuffer.resolveCounterRange(pending.samples) else { return }
+        let stride = MemoryLayout<MTLCounterResultTimestamp>.stride
+        let ticks: [UInt64] = data.withUnsafeBytes { raw in
+            (0..<min(pending.samples.count, raw.count / stride)).map {
+                raw.load(fromByteOffset: $0 * stride, as: MTLCounterResultTimestamp.self).timestamp
+            }
+        }
+        let first = pending.samples.lowerBound
+        let durations = GPUTimestampRing.durations(of: pending.scopes, nanosecondsPerTick: scopeNanosecondsPerTick()) { index in
+            let offset = Int(index) - first
+            guard ticks.indices.contains(offset), ticks[offset] != 0, ticks[offset] != MTLCounterErrorValue else { return nil }
+            return ticks[offset]
+        }
+        timings.record(durations)
+    }
+
+    // GPU timestamps tick in a device-specific unit; calibrate against the CPU clock
+    // (nanoseconds) over the backend's lifetime.
+    private func scopeNanosecondsPerTick() -> Double {
+        let now = MetalRenderBackend.sampleClocks(device)
+        guard now.gpu > scopeClockBase.gpu, now.cpu > scopeClockBase.cpu else { return 1 }
+        return Double(now.cpu - scopeClockBase.cpu) / Double(now.gpu - scopeClockBase.gpu)
+    }
+
+    private static func sampleClocks(_ device: MTLDevice) -> (cpu: MTLTimestamp, gpu: MTLTimestamp) {
+        var cpu: MTLTimestamp = 0
+        var gpu: MTLTimestamp = 0
+        device.sampleTimestamps(&cpu, gpuTimestamp: &gpu)
+        return (cpu, gpu)
+    }
+
+    private static func makeScopeSampleBuffer(device: MTLDevice, sampleCount: Int) -> MTLCounterSampleBuffer? {
+        guard device.supportsCounterSampling(.atStageBoundary),
+              let counterSet = device.counterSets?.first(where: { $0.name == MTLCommonCounterSet.timestamp.rawValue }) else {
+            SDLLogger.info("SDLKit.Graphics.Metal", "Device cannot sample timestamps at stage boundaries; labeled GPU scopes are not timed")
+            return nil
+        }
+        let descriptor = MTLCounterSampleBufferDescriptor()
+        descriptor.counterSet = counterSet
+        descriptor.storageMode = .shared
+        descriptor.sampleCount = sampleCount
+        descriptor.label = "SDLKit.GPUScopes"
+        do {
+            return try device.makeCounterSampleBuffer(descriptor: descriptor)
+        } catch {
+            SDLLogger.warn("SDLKit.Graphics.Metal", "Unable to create counter sample buffer: \(error); labeled GPU scopes are not timed")
+            return nil
+        }
+    }
+
+    private func pushGPUScopeLabels(on encoder: MTLCommandEncoder) {
+        for label in gpuScopeLabels { encoder.pushDebugGroup(label) }
+    }
+
+    private func popGPUScopeLabels(from encoder: MTLCommandEncoder) {
+        for _ in gpuScopeLabels { encoder.popDebugGroup() }
+    }
+
     private func makeRenderPassDescriptor(for drawable: CAMetalDrawable) -> MTLRenderPassDescriptor {
         let descriptor = MTLRenderPassDescriptor()
         if let colorAttachment = descriptor.colorAttachments[0] {
@@ -1016,11 +1205,11 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
         if let cached = metalLibraries[module.id] {
             return cached
         }
-        let url = try module.artifacts.requireMetalLibrary(for: module.id)
-        SDLLogger.info("SDLKit.Graphics.Metal", "Loading metallib for \(module.id.rawValue) from \(url.path)")
+        let artifact = try module.artifacts.requireMetalLibrary(for: module.id)
+        SDLLogger.info("SDLKit.Graphics.Metal", "Loading metallib for \(module.id.rawValue) from \(artifact.name)")
         let library: MTLLibrary
         do {
-            library = try device.makeLibrary(URL: url)
+            library = try makeLibrary(from: artifact)
         } catch {
             // Fallback: build a minimal inline Metal library for known shaders so
             // the demo can render even if the prebuilt metallib is incompatible.
@@ -1045,13 +1234,24 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
         if let cached = metalLibraries[module.id] {
             return cached
         }
-        let url = try module.artifacts.requireMetalLibrary(for: module.id)
-        SDLLogger.info("SDLKit.Graphics.Metal", "Loading compute metallib for \(module.id.rawValue) from \(url.path)")
-        let library = try device.makeLibrary(URL: url)
+        let artifact = try module.artifacts.requireMetalLibrary(for: module.id)
+        SDLLogger.info("SDLKit.Graphics.Metal", "Loading compute metallib for \(module.id.rawValue) from \(artifact.name)")
+        let library = try makeLibrary(from: artifact)
         metalLibraries[module.id] = library
         return library
     }
 
+    /// Hands the metallib bytes to Metal without copying them. `Data.withUnsafeBytes` only
+    /// lends its pointer for the closure, so the bytes come from the bridged `NSData`, whose
+    /// `bytes` stay put while it lives; the deallocator keeps it (and, for archived
+    /// artifacts, the archive mapping) alive until Metal is done.
+    private func makeLibrary(from artifact: ShaderArtifact) throws -> MTLLibrary {
+        let data = try artifact.data() as NSData
+        let bytes = UnsafeRawBufferPointer(start: data.bytes, count: data.length)
+        let dispatchData = DispatchData(bytesNoCopy: bytes, deallocator: .custom(nil, { _ = data }))
+        return try device.makeLibrary(data: dispatchData as __DispatchData)
+    }
+
     // Minimal inline shaders as a safety net when metallib loading fails.
     private func inlineMetalSource(for id: ShaderID) -> String? {
         switch id.rawValue {
@@ -1110,7 +1310,7 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
         }
     }
 
-    private static func makeTriangleVertexBuffer(device: MTLDevice) -> (handle: BufferHandle, buffer: MTLBuffer, count: Int)? {
+    private static func makeTriangleVertexBuffer(device: MTLDevice) -> (buffer: MTLBuffer, count: Int)? {
         struct Vertex {
             var position: (Float, Float, Float)
             var color: (Float, Float, Float)
@@ -1127,7 +1327,7 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
             return nil
         }
         buffer.label = "SDLKit.BuiltinTriangle"
-        return (BufferHandle(), buffer, vertices.count)
+        return (buffer, vertices.count)
     }
 
     private func convertTextureFormat(_ format: TextureFormat) throws -> MTLPixelFormat {
@@ -1310,8 +1510,10 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
 
     // MARK: - Readback
     public func readback(buffer: BufferHandle, into dst: UnsafeMutableRawPointer, length: Int) throws {
+        let profile = SDLProfiler.begin("render.readback")
+        defer { profile.end() }
         guard let resource = buffers[buffer] else {
-            throw AgentError.invalidArgument("Unknown buffer handle \(buffer.rawValue)")
+            throw AgentError.invalidArgument("\(buffers.missingDescription(buffer)) buffer handle \(buffer.rawValue)")
         }
         // Buffers are created with .storageModeShared; a direct memcpy is sufficient.
         let srcPtr = resource.buffer.contents()
@@ -1337,6 +1539,254 @@ public final class MetalRenderBackend: RenderBackend, GoldenImageCapturable {
     }
 }
 
+extension MetalRenderBackend: RenderStateCounting {
+    public var stateCounters: RenderStateCounters { bindTracker.counters }
+}
+
+extension MetalRenderBackend {
+    public var frameArena: FrameArena? { payloadArena }
+}
+
+extension MetalRenderBackend: GPUTimingProfiling {
+    public var gpuTimings: GPUTimingAggregator { timings }
+    // Scopes become debug groups on every encoder created inside them. Where the device
+    // samples at stage boundaries, the render encoder is also split at each scope boundary
+    // and the scope is timed from its encoders' samples; otherwise
+    // `labeledScopesSupported` is false and only whole command buffers are timed.
+    public func beginGPUScope(_ label: String) {
+        guard currentCommandBuffer != nil else { return }
+        splitRenderEncodingForScope()
+        encoderSamples.beginScope(label)
+        gpuScopeLabels.append(label)
+        currentRenderEncoder?.pushDebugGroup(label)
+    }
+
+    public func endGPUScope() {
+        guard !gpuScopeLabels.isEmpty else { return }
+        splitRenderEncodingForScope()
+        encoderSamples.endScope()
+        gpuScopeLabels.removeLast()
+        currentRenderEncoder?.popDebugGroup()
+    }
+}
+
+extension MetalRenderBackend: ComputeCommandListSubmitting {
+    /// Encodes the whole list on one concurrent compute encoder in one command buffer.
+    /// Dispatches may overlap except where the planner reports a hazard, which becomes a
+    /// `memoryBarrier(resources:)` on just the resources involved.
+    public func submitCompute(_ list: ComputeCommandList) throws -> ComputeFence {
+        let profile = SDLProfiler.begin("render.submitCompute")
+        defer { profile.end() }
+        guard !list.isEmpty else { return ComputeFence.signaled(dispatchCount: 0, barrierCount: 0) }
+        if let encoder = currentRenderEncoder {
+            throw AgentError.invalidArgument("Cannot submit a compute command list while a render pass is active (encoder=\(encoder))")
+        }
+        var resources: [ComputePipelineResource] = []
+        resources.reserveCapacity(list.count)
+        for dispatch in list.dispatches {
+            guard let resource = computePipelines[dispatch.pipeline] else {
+                throw AgentError.internalError("Unknown compute pipeline handle")
+            }
+            resources.append(resource)
+        }
+
+        guard let commandBuffer = commandQueue.makeCommandBuffer() else {
+            throw AgentError.internalError("Unable to allocate Metal command buffer for compute command list")
+        }
+        commandBuffer.label = list.label.map { "SDLKit.ComputeList.\($0)" } ?? "SDLKit.ComputeList"
+        let concurrent: Bool
+        let madeEncoder: MTLComputeCommandEncoder?
+        if #available(macOS 10.14, iOS 12.0, tvOS 12.0, *) {
+            madeEncoder = commandBuffer.makeComputeCommandEncoder(dispatchType: .concurrent)
+            concurrent = true
+        } else {
+            // Serial encoders order every dispatch already.
+            madeEncoder = commandBuffer.makeComputeCommandEncoder()
+            concurrent = false
+        }
+        guard let encoder = madeEncoder else {
+            throw AgentError.internalError("Failed to create Metal compute command encoder")
+        }
+        encoder.label = "SDLKit.ComputeList"
+
+        var planner = ComputeHazardPlanner()
+        do {
+            for (dispatch, resource) in zip(list.dispatches, resources) {
+                let hazards = planner.barriers(before: ComputeHazardPlanner.accesses(of: dispatch.bindings, slots: resource.module.bindings))
+                if concurrent, !hazards.isEmpty {
+                    encodeHazardBarriers(hazards, within: encoder)
+                }
+                _ = try encodeComputeDispatch(resource, bindings: dispatch.bindings, groups: dispatch.groups, encoder: encoder)
+            }
+        } catch {
+            encoder.endEncoding()
+            throw error
+        }
+        encoder.endEncoding()
+
+        let label = GPUTimingLabel.computeList(list.label)
+        let timings = self.timings
+        commandBuffer.addCompletedHandler { buffer in
+            if let error = buffer.error {
+                SDLLogger.error("SDLKit.Graphics.Metal", "Metal compute command list error: \(error)")
+            } else {
+                MetalRenderBackend.recordGPUTime(of: buffer, label: label, into: timings)
+            }
+        }
+        commandBuffer.commit()
+        lastSubmittedCommandBuffer = commandBuffer
+
+        return ComputeFence(
+            dispatchCount: list.count,
+            barrierCount: planner.barrierCount,
+            poll: { commandBuffer.status == .completed || commandBuffer.status == .error },
+            wait: {
+                commandBuffer.waitUntilCompleted()
+                if let error = commandBuffer.error {
+                    throw AgentError.internalError("Metal compute command list failed: \(error)")
+                }
+            }
+        )
+    }
+
+    private func encodeHazardBarriers(_ hazards: [ComputeHazardPlanner.Barrier], within encoder: MTLComputeCommandEncoder) {
+        guard #available(macOS 10.14, iOS 12.0, tvOS 12.0, *) else { return }
+        var resources: [MTLResource] = []
+        for hazard in hazards {
+            switch hazard.resource {
+            case .buffer(let handle):
+                if let buffer = buffers[handle]?.buffer { resources.append(buffer) }
+            case .texture(let handle):
+                if let texture = textures[handle]?.texture { resources.append(texture) }
+            }
+        }
+        if !resources.isEmpty {
+            encoder.memoryBarrier(resources: resources)
+        }
+    }
+}
+
+extension MetalRenderBackend: AsyncReadbackProviding {
+    /// Blits `range` into a pooled shared buffer on its own command buffer, queued behind the
+    /// work submitted so far, so the token sees the buffer as it was at enqueue: writes made
+    /// afterwards do not leak in.
+    public func enqueueReadback(buffer: BufferHandle, range requested: Range<Int>?) throws -> ReadbackToken<Data> {
+        let profile = SDLProfiler.begin("render.enqueueReadback")
+        defer { profile.end() }
+        guard let resource = buffers[buffer] else {
+            throw AgentError.invalidArgument("\(buffers.missingDescription(buffer)) buffer handle \(buffer.rawValue)")
+        }
+        let range = try Range<Int>.readbackRange(requested, length: resource.length)
+        guard !range.isEmpty else { return .resolved(Data()) }
+        let device = self.device
+        let staging = try readbackStaging.acquire(length: range.count) { capacity in
+            guard let buffer = device.makeBuffer(length: capacity, options: .storageModeShared) else {
+                throw AgentError.internalError("Unable to allocate Metal readback staging buffer")
+            }
+            return buffer
+        }
+        guard let commandBuffer = commandQueue.makeCommandBuffer(), let blit = commandBuffer.makeBlitCommandEncoder() else {
+            _ = readbackStaging.recycle(staging)
+            throw AgentError.internalError("Unable to allocate Metal command buffer for readback")
+        }
+        commandBuffer.label = "SDLKit.Readback"
+        blit.copy(from: resource.buffer, sourceOffset: range.lowerBound,
+                  to: staging.allocation, destinationOffset: 0, size: range.count)
+        blit.endEncoding()
+        commandBuffer.commit()
+        lastSubmittedCommandBuffer = commandBuffer
+
+        let count = range.count
+        let token = ReadbackToken<Data>(
+            poll: { commandBuffer.status == .completed || commandBuffer.status == .error },
+            resolve: { [weak self] in
+                commandBuffer.waitUntilCompleted()
+                defer { _ = self?.readbackStaging.recycle(staging) }
+                if let error = commandBuffer.error {
+                    throw AgentError.internalError("Metal buffer readback failed: \(error)")
+                }
+                return Data(bytes: staging.allocation.contents(), count: count)
+            }
+        )
+        pendingReadbacks.track(token)
+        return token
+    }
+
+    /// Blits mip 0 into a pooled shared buffer on its own command buffer.
+    public func enqueueReadback(texture: TextureHandle) throws -> ReadbackToken<GoldenImageCapture> {
+        let profile = SDLProfiler.begin("render.enqueueReadback")
+        defer { profile.end() }
+        guard let resource = textures[texture] else {
+            throw AgentError.invalidArgument("\(textures.missingDescription(texture)) texture handle \(texture.rawValue)")
+        }
+        let source = resource.texture
+        let width = source.width, height = source.height
+        let bytesPerRow = width * MetalRenderBackend.bytesPerPixel(for: source.pixelFormat)
+        let length = bytesPerRow * height
+        let device = self.device
+        let staging = try readbackStaging.acquire(length: length) { capacity in
+            guard let buffer = device.makeBuffer(length: capacity, options: .storageModeShared) else {
+                throw AgentError.internalError("Unable to allocate Metal readback staging buffer")
+            }
+            return buffer
+        }
+        guard let commandBuffer = commandQueue.makeCommandBuffer(), let blit = commandBuffer.makeBlitCommandEncoder() else {
+            _ = readbackStaging.recycle(staging)
+            throw AgentError.internalError("Unable to allocate Metal command buffer for readback")
+        }
+        commandBuffer.label = "SDLKit.Readback"
+        blit.copy(from: source,
+                  sourceSlice: 0,
+                  sourceLevel: 0,
+                  sourceOrigin: MTLOrigin(x: 0, y: 0, z: 0),
+                  sourceSize: MTLSize(width: width, height: height, depth: 1),
+                  to: staging.allocation,
+                  destinationOffset: 0,
+                  destinationBytesPerRow: bytesPerRow,
+                  destinationBytesPerImage: length)
+        blit.endEncoding()
+        commandBuffer.commit()
+        lastSubmittedCommandBuffer = commandBuffer
+
+        let layout = MetalRenderBackend.captureLayout(for: source.pixelFormat)
+        let token = ReadbackToken<GoldenImageCapture>(
+            poll: { commandBuffer.status == .completed || commandBuffer.status == .error },
+            resolve: { [weak self] in
+                commandBuffer.waitUntilCompleted()
+                defer { _ = self?.readbackStaging.recycle(staging) }
+                if let error = commandBuffer.error {
+                    throw AgentError.internalError("Metal texture readback failed: \(error)")
+                }
+                return GoldenImageCapture(width: width, height: height, bytesPerRow: bytesPerRow, layout: layout,
+                                          data: Data(bytes: staging.allocation.contents(), count: length))
+            }
+        )
+        pendingReadbacks.track(token)
+        return token
+    }
+
+    /// The drawable cannot be blitted from (`framebufferOnly`), so the frame is still copied
+    /// with `getBytes` at `endFrame()`; the token is ready once that frame has ended.
+    public func enqueueFrameCapture() throws -> ReadbackToken<GoldenImageCapture> {
+        guard currentCommandBuffer != nil else {
+            throw AgentError.invalidArgument("enqueueFrameCapture must be called between beginFrame and endFrame")
+        }
+        let request = pendingFrameCapture ?? FrameCaptureRequest()
+        pendingFrameCapture = request
+        let token = request.token()
+        pendingReadbacks.track(token)
+        return token
+    }
+
+    private static func captureLayout(for format: MTLPixelFormat) -> GoldenImageCapture.PixelLayout {
+        switch format {
+        case .bgra8Unorm: return .bgra8Unorm
+        case .depth32Float: return .depth32Float
+        default: return .rgba8Unorm
+        }
+    }
+}
+
 struct MetalComputeTextureAccessTracker {
     enum Requirement {
         case readable
@@ -7,17 +7,48 @@ import CVulkan
 
 public struct float4x4 {
     public typealias Column = (Float, Float, Float, Float)
-    public var columns: (Column, Column, Column, Column)
+
+    // Column storage is SIMD-backed; `columns` exposes the same values as tuples.
+    public var c0: SIMD4<Float>
+    public var c1: SIMD4<Float>
+    public var c2: SIMD4<Float>
+    public var c3: SIMD4<Float>
+
+    public var columns: (Column, Column, Column, Column) {
+        get {
+            ((c0.x, c0.y, c0.z, c0.w),
+             (c1.x, c1.y, c1.z, c1.w),
+             (c2.x, c2.y, c2.z, c2.w),
+             (c3.x, c3.y, c3.z, c3.w))
+        }
+        set {
+            c0 = SIMD4(newValue.0.0, newValue.0.1, newValue.0.2, newValue.0.3)
+            c1 = SIMD4(newValue.1.0, newValue.1.1, newValue.1.2, newValue.1.3)
+            c2 = SIMD4(newValue.2.0, newValue.2.1, newValue.2.2, newValue.2.3)
+            c3 = SIMD4(newValue.3.0, newValue.3.1, newValue.3.2, newValue.3.3)
+        }
+    }
+
     public init(_ c0: Column, _ c1: Column, _ c2: Column, _ c3: Column) {
-        self.columns = (c0, c1, c2, c3)
+        self.c0 = SIMD4(c0.0, c0.1, c0.2, c0.3)
+        self.c1 = SIMD4(c1.0, c1.1, c1.2, c1.3)
+        self.c2 = SIMD4(c2.0, c2.1, c2.2, c2.3)
+        self.c3 = SIMD4(c3.0, c3.1, c3.2, c3.3)
+    }
+
+    public init(columns c0: SIMD4<Float>, _ c1: SIMD4<Float>, _ c2: SIMD4<Float>, _ c3: SIMD4<Float>) {
+        self.c0 = c0
+        self.c1 = c1
+        self.c2 = c2
+        self.c3 = c3
     }
 
     public init() {
         self.init(
-            (1, 0, 0, 0),
-            (0, 1, 0, 0),
-            (0, 0, 1, 0),
-            (0, 0, 0, 1)
+            columns: SIMD4(1, 0, 0, 0),
+            SIMD4(0, 1, 0, 0),
+            SIMD4(0, 0, 1, 0),
+            SIMD4(0, 0, 0, 1)
         )
     }
 
@@ -63,6 +94,9 @@ public enum RenderBackendDeviceEvent: Sendable {
     case willReset(reason: String)
     case didReset
     case resetFailed(reason: String)
+    /// Sent after `didReset` for buffers and textures that came back empty under
+    /// `ResourceRecoveryPolicy.discard` (or whose regeneration failed); their owners refill them.
+    case resourcesDiscarded([ResourceHandle])
 }
 
 public typealias RenderBackendDeviceEventHandler = @Sendable (RenderBackendDeviceEvent) -> Void
@@ -200,9 +234,18 @@ public enum ShaderStage: Sendable {
 public struct BindingSlot: Sendable {
     public let index: Int
     public let kind: Kind
-    public init(index: Int, kind: Kind) {
+    /// Whether the shader writes through the slot. Storage slots default to read/write;
+    /// declaring inputs `.read` lets compute command lists skip barriers between readers.
+    public let access: Access
+    public init(index: Int, kind: Kind, access: Access? = nil) {
         self.index = index
         self.kind = kind
+        self.access = access ?? (kind == .storageBuffer || kind == .storageTexture ? .readWrite : .read)
+    }
+
+    public enum Access: Sendable {
+        case read
+        case readWrite
     }
 
     public enum Kind: Sendable {
@@ -215,66 +258,238 @@ public struct BindingSlot: Sendable {
 }
 
 public struct BindingSet {
-    public struct MaterialConstants: Sendable {
-        public private(set) var data: Data
+    public struct MaterialConstants: @unchecked Sendable {
+        // Heap payloads own their bytes. Arena payloads point into a FrameArena block
+        // and are only valid until that arena is reset (the next beginFrame); they keep
+        // the arena generation they were allocated in so stale reads are caught.
+        private enum Storage {
+            case heap(Data)
+            case arena(UnsafeRawBufferPointer, FrameArena, generation: UInt64)
+        }
+
+        private var storage: Storage
 
-        public init(data: Data) { self.data = data }
+        public init(data: Data) { self.storage = .heap(data) }
 
         public init(bytes: UnsafeRawPointer, length: Int) {
             if length > 0 {
-                self.data = Data(bytes: bytes, count: length)
+                self.storage = .heap(Data(bytes: bytes, count: length))
             } else {
-                self.data = Data()
+                self.storage = .heap(Data())
+            }
+        }
+
+        init(arenaBytes: UnsafeRawBufferPointer, arena: FrameArena) {
+            self.storage = .arena(arenaBytes, arena, generation: arena.generation)
+        }
+
+        /// The payload bytes. Arena-backed payloads are copied; prefer `withUnsafeBytes`.
+        public var data: Data {
+            switch storage {
+            case .heap(let data): return data
+            case .arena(let bytes, _, _):
+                assertLive()
+                return Data(bytes)
+            }
+        }
+
+        public var byteCount: Int {
+            switch storage {
+            case .heap(let data): return data.count
+            case .arena(let bytes, _, _): return bytes.count
             }
         }
 
-        public var byteCount: Int { data.count }
+        /// False once the arena behind an arena-backed payload has been reset.
+        public var isLive: Bool {
+            if case .arena(_, let arena, let generation) = storage { return arena.generation == generation }
+            return true
+        }
+
+        public var isArenaBacked: Bool {
+            if case .arena = storage { return true }
+            return false
+        }
 
         public func withUnsafeBytes<R>(_ body: (UnsafeRawBufferPointer) throws -> R) rethrows -> R {
-            try data.withUnsafeBytes(body)
+            switch storage {
+            case .heap(let data): return try data.withUnsafeBytes(body)
+            case .arena(let bytes, _, _):
+                assertLive()
+                return try body(bytes)
+            }
+        }
+
+        private func assertLive() {
+            assert(isLive, "Arena-backed material constants read after their FrameArena was reset")
         }
     }
 
-    public enum Resource: Sendable {
+    public enum Resource: Hashable, Sendable {
         case buffer(BufferHandle)
         case texture(TextureHandle)
     }
 
-    public private(set) var resources: [Int: Resource]
-    public private(set) var samplers: [Int: SamplerHandle]
+    private var resourceSlots = BindingSlotTable<Resource>()
+    private var samplerSlots = BindingSlotTable<SamplerHandle>()
     public var materialConstants: MaterialConstants?
+
+    /// Dictionary views of the slot tables. These allocate; hot paths should use the per-slot accessors.
+    public var resources: [Int: Resource] { resourceSlots.dictionary }
+    public var samplers: [Int: SamplerHandle] { samplerSlots.dictionary }
+
+    /// True when every binding fits the inline slot tables (no heap spill).
+    public var isInline: Bool { !resourceSlots.hasSpilled && !samplerSlots.hasSpilled }
+
     public init(resources: [Int: Resource] = [:],
                 samplers: [Int: SamplerHandle] = [:],
                 materialConstants: MaterialConstants? = nil) {
-        self.resources = resources
-        self.samplers = samplers
+        for (index, resource) in resources { resourceSlots.set(resource, at: index) }
+        for (index, sampler) in samplers { samplerSlots.set(sampler, at: index) }
         self.materialConstants = materialConstants
     }
     public mutating func setBuffer(_ handle: BufferHandle, at index: Int) {
-        resources[index] = .buffer(handle)
+        resourceSlots.set(.buffer(handle), at: index)
     }
     public mutating func setTexture(_ handle: TextureHandle, at index: Int) {
-        resources[index] = .texture(handle)
+        resourceSlots.set(.texture(handle), at: index)
     }
     public mutating func setSampler(_ handle: SamplerHandle, at index: Int) {
-        samplers[index] = handle
+        samplerSlots.set(handle, at: index)
     }
     public mutating func removeResource(at index: Int) {
-        resources.removeValue(forKey: index)
+        resourceSlots.remove(at: index)
     }
     public mutating func removeSampler(at index: Int) {
-        samplers.removeValue(forKey: index)
+        samplerSlots.remove(at: index)
     }
-    public func resource(at index: Int) -> Resource? { resources[index] }
+    public func resource(at index: Int) -> Resource? { resourceSlots.value(at: index) }
     public func buffer(at index: Int) -> BufferHandle? {
-        if case let .buffer(handle) = resources[index] { return handle }
+        if case let .buffer(handle) = resourceSlots.value(at: index) { return handle }
         return nil
     }
     public func texture(at index: Int) -> TextureHandle? {
-        if case let .texture(handle) = resources[index] { return handle }
+        if case let .texture(handle) = resourceSlots.value(at: index) { return handle }
         return nil
     }
-    public func sampler(at index: Int) -> SamplerHandle? { samplers[index] }
+    public func sampler(at index: Int) -> SamplerHandle? { samplerSlots.value(at: index) }
+
+    /// True when both sets bind the same resources and samplers (material constants are ignored).
+    public func hasSameResources(as other: BindingSet) -> Bool {
+        resourceSlots == other.resourceSlots && samplerSlots == other.samplerSlots
+    }
+}
+
+/// Small fixed-capacity slot table stored inline in `BindingSet`. The first
+/// `inlineCapacity` slots live in a tuple inside the struct; further slots spill to
+/// a dictionary so unusual layouts still work, at the cost of an allocation.
+struct BindingSlotTable<Value: Hashable>: Equatable {
+    struct Entry: Equatable {
+        var index: Int
+        var value: Value
+    }
+
+    static var inlineCapacity: Int { 8 }
+
+    private var inline: (Entry?, Entry?, Entry?, Entry?, Entry?, Entry?, Entry?, Entry?) =
+        (nil, nil, nil, nil, nil, nil, nil, nil)
+    private var inlineCount = 0
+    private var spill: [Int: Value]?
+
+    var count: Int { inlineCount + (spill?.count ?? 0) }
+    var hasSpilled: Bool { spill != nil }
+
+    func value(at index: Int) -> Value? {
+        var tuple = inline
+        let count = inlineCount
+        let found: Value? = withUnsafeMutablePointer(to: &tuple) { ptr in
+            ptr.withMemoryRebound(to: Entry?.self, capacity: Self.inlineCapacity) { entries in
+                for i in 0..<count where entries[i]?.index == index {
+                    return entries[i]?.value
+                }
+                return nil
+            }
+        }
+        return found ?? spill?[index]
+    }
+
+    mutating func set(_ value: Value, at index: Int) {
+        enum Outcome { case replaced, appended, full }
+        let count = inlineCount
+        let outcome: Outcome = withUnsafeMutablePointer(to: &inline) { ptr in
+            ptr.withMemoryRebound(to: Entry?.self, capacity: Self.inlineCapacity) { entries in
+                for i in 0..<count where entries[i]?.index == index {
+                    entries[i] = Entry(index: index, value: value)
+                    return .replaced
+                }
+                guard count < Self.inlineCapacity else { return .full }
+                entries[count] = Entry(index: index, value: value)
+                return .appended
+            }
+        }
+        switch outcome {
+        case .replaced:
+            break
+        case .appended:
+            inlineCount += 1
+            spill?.removeValue(forKey: index)
+            if spill?.isEmpty == true { spill = nil }
+        case .full:
+            if spill == nil { spill = [:] }
+            spill?[index] = value
+        }
+    }
+
+    mutating func remove(at index: Int) {
+        let count = inlineCount
+        let removed: Bool = withUnsafeMutablePointer(to: &inline) { ptr in
+            ptr.withMemoryRebound(to: Entry?.self, capacity: Self.inlineCapacity) { entries in
+                for i in 0..<count where entries[i]?.index == index {
+                    // Keep the live entries dense: move the last one into the hole.
+                    entries[i] = entries[count - 1]
+                    entries[count - 1] = nil
+                    return true
+                }
+                return false
+            }
+        }
+        if removed {
+            inlineCount -= 1
+        } else {
+            spill?.removeValue(forKey: index)
+            if spill?.isEmpty == true { spill = nil }
+        }
+    }
+
+    var dictionary: [Int: Value] {
+        var result = spill ?? [:]
+        forEachInline { result[$0.index] = $0.value }
+        return result
+    }
+
+    static func == (lhs: BindingSlotTable, rhs: BindingSlotTable) -> Bool {
+        guard lhs.count == rhs.count else { return false }
+        var equal = true
+        lhs.forEachInline { entry in
+            if equal && rhs.value(at: entry.index) != entry.value { equal = false }
+        }
+        if equal, let spill = lhs.spill {
+            for (index, value) in spill where rhs.value(at: index) != value { return false }
+        }
+        return equal
+    }
+
+    private func forEachInline(_ body: (Entry) -> Void) {
+        var tuple = inline
+        let count = inlineCount
+        withUnsafeMutablePointer(to: &tuple) { ptr in
+            ptr.withMemoryRebound(to: Entry?.self, capacity: Self.inlineCapacity) { entries in
+                for i in 0..<count {
+                    if let entry = entries[i] { body(entry) }
+                }
+            }
+        }
+    }
 }
 
 public enum TextureUsage: Sendable {
@@ -315,7 +530,7 @@ public struct ComputePipelineDescriptor {
     }
 }
 
-public enum ResourceHandle: Hashable {
+public enum ResourceHandle: Hashable, Sendable {
     case buffer(BufferHandle)
     case texture(TextureHandle)
     case sampler(SamplerHandle)
@@ -337,37 +552,38 @@ public struct GoldenImageCapture: Sendable {
     public let layout: PixelLayout
     public let data: Data
 
+    /// The capture as an in-memory PNG (RGBA, or 8-bit gray for depth).
+    public func pngData(options: PNGEncoder.Options = PNGEncoder.Options()) throws -> Data {
+        try data.withUnsafeBytes { pixels in
+            try PNGEncoder.encode(width: width, height: height, bytesPerRow: bytesPerRow,
+                                  layout: layout, pixels: pixels, options: options)
+        }
+    }
+
+    public func writePNG(to url: URL) throws {
+        try pngData().write(to: url)
+    }
+
     public func writePPM(to url: URL) throws {
         guard width > 0, height > 0 else { return }
         let header = "P6\n\(width) \(height)\n255\n"
+        let channels = layout == .depth32Float ? 1 : 4
         var body = Data(count: width * height * 3)
+        var row = [UInt8](repeating: 0, count: width * channels)
         data.withUnsafeBytes { src in
             body.withUnsafeMutableBytes { dst in
                 guard let srcBase = src.baseAddress, let dstBase = dst.baseAddress else { return }
-                let srcBytes = srcBase.assumingMemoryBound(to: UInt8.self)
                 let dstBytes = dstBase.assumingMemoryBound(to: UInt8.self)
-                for y in 0..<height {
-                    let srcRow = srcBytes.advanced(by: y * bytesPerRow)
-                    let dstRow = dstBytes.advanced(by: y * width * 3)
-                    for x in 0..<width {
-                        let srcPixel = srcRow.advanced(by: x * 4)
-                        let dstPixel = dstRow.advanced(by: x * 3)
-                        switch layout {
-                        case .rgba8Unorm:
-                            dstPixel[0] = srcPixel[0]
-                            dstPixel[1] = srcPixel[1]
-                            dstPixel[2] = srcPixel[2]
-                        case .bgra8Unorm:
-                            dstPixel[0] = srcPixel[2]
-                            dstPixel[1] = srcPixel[1]
-                            dstPixel[2] = srcPixel[0]
-                        case .depth32Float:
-                            let floatValue = srcPixel.withMemoryRebound(to: Float.self, capacity: 1) { $0.pointee }
-                            let clamped = max(0.0, min(1.0, floatValue))
-                            let byte = UInt8(clamped * 255)
-                            dstPixel[0] = byte
-                            dstPixel[1] = byte
-                            dstPixel[2] = byte
+                row.withUnsafeMutableBufferPointer { row in
+                    guard let rowBase = row.baseAddress else { return }
+                    for y in 0..<height {
+                        PNGEncoder.swizzleRow(srcBase + y * bytesPerRow, width: width, layout: layout, into: rowBase)
+                        let dstRow = dstBytes + y * width * 3
+                        for x in 0..<width {
+                            let pixel = rowBase + x * channels
+                            dstRow[x * 3 + 0] = pixel[0]
+                            dstRow[x * 3 + 1] = pixel[channels == 4 ? 1 : 0]
+                            dstRow[x * 3 + 2] = pixel[channels == 4 ? 2 : 0]
                         }
                     }
                 }
@@ -388,6 +604,82 @@ public protocol GoldenImageCapturable {
     func takeCapturePayload() throws -> GoldenImageCapture
 }
 
+/// Per-frame bind counters. Backends that skip redundant state changes report
+/// both the binds they issued and the ones they avoided.
+public struct RenderStateCounters: Equatable, Sendable {
+    public var pipelineBinds = 0
+    public var pipelineBindsAvoided = 0
+    public var resourceBinds = 0
+    public var resourceBindsAvoided = 0
+    public var vertexBufferBinds = 0
+    public var vertexBufferBindsAvoided = 0
+    public init() {}
+
+    public var bindsAvoided: Int { pipelineBindsAvoided + resourceBindsAvoided + vertexBufferBindsAvoided }
+}
+
+// Optional protocol: backends that elide redundant binds expose their counters.
+// Counters cover the current (or most recently ended) frame and reset in `beginFrame()`.
+@MainActor
+public protocol RenderStateCounting {
+    var stateCounters: RenderStateCounters { get }
+}
+
+/// Last-bound graphics state within one command stream. Backends call `invalidate()`
+/// whenever API state is disturbed outside `draw` (new encoder, compute PSO on a shared list).
+struct RenderBindTracker {
+    private(set) var counters = RenderStateCounters()
+    private var pipeline: PipelineHandle?
+    private var mesh: MeshHandle?
+    private var bindings: BindingSet?
+
+    mutating func beginFrame() {
+        counters = RenderStateCounters()
+        invalidate()
+    }
+
+    mutating func invalidate() {
+        pipeline = nil
+        mesh = nil
+        bindings = nil
+    }
+
+    /// Returns true when `handle` must be bound. A pipeline change also drops the
+    /// resource state because the new pipeline may use a different layout.
+    mutating func needsPipeline(_ handle: PipelineHandle) -> Bool {
+        if pipeline == handle {
+            counters.pipelineBindsAvoided += 1
+            return false
+        }
+        pipeline = handle
+        bindings = nil
+        counters.pipelineBinds += 1
+        return true
+    }
+
+    mutating func needsResources(_ set: BindingSet) -> Bool {
+        if let bound = bindings, bound.hasSameResources(as: set) {
+            counters.resourceBindsAvoided += 1
+            return false
+        }
+        var stored = set
+        stored.materialConstants = nil
+        bindings = stored
+        counters.resourceBinds += 1
+        return true
+    }
+
+    mutating func needsVertexBuffers(_ handle: MeshHandle) -> Bool {
+        if mesh == handle {
+            counters.vertexBufferBindsAvoided += 1
+            return false
+        }
+        mesh = handle
+        counters.vertexBufferBinds += 1
+        return true
+    }
+}
+
 @MainActor
 public struct RenderSurface {
     public let window: SDLWindow
@@ -413,8 +705,19 @@ public protocol RenderBackend {
 
     var deviceEventHandler: RenderBackendDeviceEventHandler? { get set }
 
+    /// Arena for per-draw payloads, reset by the backend in `beginFrame()`.
+    /// Material constants allocated from it are consumed in `draw` without copying.
+    var frameArena: FrameArena? { get }
+
     func createBuffer(bytes: UnsafeRawPointer?, length: Int, usage: BufferUsage) throws -> BufferHandle
     func createTexture(descriptor: TextureDescriptor, initialData: TextureInitialData?) throws -> TextureHandle
+    /// Creates a resource whose initial contents are restored after device loss per `recovery`.
+    /// The plain overloads use `.shadowCopy`.
+    func createBuffer(bytes: UnsafeRawPointer?, length: Int, usage: BufferUsage, recovery: ResourceRecoveryPolicy) throws -> BufferHandle
+    func createTexture(descriptor: TextureDescriptor, initialData: TextureInitialData?, recovery: ResourceRecoveryPolicy) throws -> TextureHandle
+    /// Changes how an existing buffer or texture is restored; switching away from `.shadowCopy`
+    /// frees its host copy.
+    func setRecoveryPolicy(_ policy: ResourceRecoveryPolicy, for handle: ResourceHandle) throws
     func createSampler(descriptor: SamplerDescriptor) throws -> SamplerHandle
     func destroy(_ handle: ResourceHandle)
 
@@ -439,3 +742,18 @@ public protocol RenderBackend {
     // Implementations should block until GPU writes to the buffer are visible to CPU.
     func readback(buffer: BufferHandle, into dst: UnsafeMutableRawPointer, length: Int) throws
 }
+
+public extension RenderBackend {
+    var frameArena: FrameArena? { nil }
+
+    // Backends without device-loss recovery keep nothing to restore, so the policy is moot.
+    func createBuffer(bytes: UnsafeRawPointer?, length: Int, usage: BufferUsage, recovery: ResourceRecoveryPolicy) throws -> BufferHandle {
+        try createBuffer(bytes: bytes, length: length, usage: usage)
+    }
+
+    func createTexture(descriptor: TextureDescriptor, initialData: TextureInitialData?, recovery: ResourceRecoveryPolicy) throws -> TextureHandle {
+        try createTexture(descriptor: descriptor, initialData: initialData)
+    }
+
+    func setRecoveryPolicy(_ policy: ResourceRecoveryPolicy, for handle: ResourceHandle) throws {}
+}
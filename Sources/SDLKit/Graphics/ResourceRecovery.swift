@@ -0,0 +1,195 @@
+import Foundation
+
+/// How a buffer's or texture's initial contents come back after the device is lost and the
+/// backend recreates it.
+public enum ResourceRecoveryPolicy {
+    /// Keep a host copy of the initial contents and upload it again. This is the default; when
+    /// the copy does not fit `ShadowCopyBudget`, the resource falls back to `.discard`, which is
+    /// logged and counted in the backend's recovery stats.
+    case shadowCopy
+    /// Ask the caller for the contents again: one `Data` for a buffer, one per mip level for a
+    /// texture. If the closure throws, the resource is treated as discarded.
+    case regenerate(@MainActor () throws -> [Data])
+    /// Recreate the resource empty and report it in `RenderBackendDeviceEvent.resourcesDiscarded`.
+    case discard
+}
+
+/// Host memory held in shadow copies for device-loss recovery, shared by every backend in the
+/// process so large asset sets do not pay for their contents twice without limit.
+public final class ShadowCopyBudget: @unchecked Sendable {
+    public static let shared = ShadowCopyBudget(limitBytes: SDLKitConfig.shadowCopyBudgetBytes)
+
+    private let lock = NSLock()
+    private var limit: Int
+    private var used = 0
+    private var denied = 0
+
+    public init(limitBytes: Int) {
+        self.limit = limitBytes
+    }
+
+    public var limitBytes: Int {
+        get { lock.lock(); defer { lock.unlock() }; return limit }
+        set { lock.lock(); limit = newValue; lock.unlock() }
+    }
+
+    public var usedBytes: Int {
+        lock.lock(); defer { lock.unlock() }
+        return used
+    }
+
+    /// Bytes that did not fit and were left to `.discard` instead.
+    public var deniedBytes: Int {
+        lock.lock(); defer { lock.unlock() }
+        return denied
+    }
+
+    func reserve(_ bytes: Int) -> Bool {
+        lock.lock(); defer { lock.unlock() }
+        guard used + bytes <= limit else {
+            denied += bytes
+            return false
+        }
+        used += bytes
+        return true
+    }
+
+    func release(_ bytes: Int) {
+        lock.lock(); defer { lock.unlock() }
+        used = max(0, used - bytes)
+    }
+}
+
+/// A backend's record of how each buffer and texture is restored after device loss. Backends
+/// own one, consult it while recreating resources, and release entries when handles are
+/// destroyed.
+@MainActor
+final class ResourceRecoveryLedger {
+    struct Stats: Equatable {
+        var shadowCopyCount = 0
+        var shadowCopyBytes = 0
+        var regenerateCount = 0
+        var discardCount = 0
+        /// Of `discardCount`, resources that asked for `.shadowCopy` but did not fit the budget.
+        var shadowCopyDowngradeCount = 0
+    }
+
+    private enum Entry {
+        case shadow([Data], bytes: Int)
+        case regenerate(@MainActor () throws -> [Data])
+        case discard(downgraded: Bool)
+    }
+
+    private let component: String
+    private let budget: ShadowCopyBudget
+    private var entries: [ResourceHandle: Entry] = [:]
+    private var discarded: [ResourceHandle] = []
+    private var heldBytes = 0
+
+    init(component: String, budget: ShadowCopyBudget = .shared) {
+        self.component = component
+        self.budget = budget
+    }
+
+    deinit {
+        budget.release(heldBytes)
+    }
+
+    /// Records a new resource with initial contents. `contents` is only evaluated, and only
+    /// retained, for `.shadowCopy` when its bytes fit the budget.
+    func track(_ handle: ResourceHandle, byteCount: Int, policy: ResourceRecoveryPolicy, contents: () -> [Data]) {
+        release(handle)
+        switch policy {
+        case .shadowCopy:
+            if budget.reserve(byteCount) {
+                heldBytes += byteCount
+                entries[handle] = .shadow(contents(), bytes: byteCount)
+            } else {
+                entries[handle] = .discard(downgraded: true)
+                let downgrades = stats.shadowCopyDowngradeCount
+                SDLLogger.warn(component, "Shadow copy budget (\(budget.limitBytes) bytes) exhausted; \(byteCount) bytes will come back empty after device loss (\(downgrades) resources downgraded to .discard; use .regenerate to restore them)")
+            }
+        case .regenerate(let closure):
+            entries[handle] = .regenerate(closure)
+        case .discard:
+            entries[handle] = .discard(downgraded: false)
+        }
+    }
+
+    /// Changes the policy of a tracked resource. Moving to `.shadowCopy` keeps an existing copy;
+    /// the initial contents are not kept for other policies, so there is nothing to copy later.
+    func setPolicy(_ policy: ResourceRecoveryPolicy, for handle: ResourceHandle) throws {
+        guard let entry = entries[handle] else {
+            throw AgentError.invalidArgument("Resource has no initial contents to recover")
+        }
+        switch (policy, entry) {
+        case (.shadowCopy, .shadow):
+            return
+        case (.shadowCopy, _):
+            throw AgentError.invalidArgument("Shadow copies can only be kept from creation; pass .shadowCopy when creating the resource")
+        case (.regenerate(let closure), _):
+            release(handle)
+            entries[handle] = .regenerate(closure)
+        case (.discard, _):
+            release(handle)
+            entries[handle] = .discard(downgraded: false)
+        }
+    }
+
+    func release(_ handle: ResourceHandle) {
+        if case .shadow(_, let bytes)? = entries.removeValue(forKey: handle) {
+            heldBytes -= bytes
+            budget.release(bytes)
+        }
+    }
+
+    func releaseAll() {
+        for handle in Array(entries.keys) { release(handle) }
+        discarded.removeAll()
+    }
+
+    /// Contents to upload while recreating `handle`, or nil to recreate it empty. Discarded
+    /// resources are collected for `takeDiscarded()`.
+    func recoveryContents(for handle: ResourceHandle) -> [Data]? {
+        switch entries[handle] {
+        case .shadow(let contents, _)?:
+            return contents
+        case .regenerate(let closure)?:
+            do {
+                return try closure()
+            } catch {
+                SDLLogger.warn(component, "Regenerating resource contents after device loss failed: \(error)")
+                discarded.append(handle)
+                return nil
+            }
+        case .discard?:
+            discarded.append(handle)
+            return nil
+        case nil:
+            return nil
+        }
+    }
+
+    /// Resources recreated empty since the last call.
+    func takeDiscarded() -> [ResourceHandle] {
+        defer { discarded.removeAll() }
+        return discarded
+    }
+
+    var stats: Stats {
+        var stats = Stats()
+        for entry in entries.values {
+            switch entry {
+            case .shadow(_, let bytes):
+                stats.shadowCopyCount += 1
+                stats.shadowCopyBytes += bytes
+            case .regenerate:
+                stats.regenerateCount += 1
+            case .discard(let downgraded):
+                stats.discardCount += 1
+                if downgraded { stats.shadowCopyDowngradeCount += 1 }
+            }
+        }
+        return stats
+    }
+}
@@ -0,0 +1,135 @@
+import Foundation
+
+// Packed shader archive (`Generated/shaders.pack`), written by Scripts/ShaderBuild/pack_shaders.py
+// next to the per-file artifacts:
+//
+//     "SDLS"  u32 version  u32 entryCount  u32 reserved
+//     entryCount x { name[56] (UTF-8, NUL padded)  u64 offset  u64 length  u64 fnv1a64 }
+//     blobs, each 16-byte aligned
+//
+// The file is memory-mapped and only the index is parsed up front. A blob is a slice of the
+// mapping, so modules reach the backend without base64 decoding or a write to disk; its hash
+// is checked the first time it is read.
+public final class ShaderArchive: @unchecked Sendable {
+    public static let fileName = "shaders.pack"
+    public static let magic: [UInt8] = Array("SDLS".utf8)
+    public static let version: UInt32 = 1
+    static let headerSize = 16
+    static let nameSize = 56
+    static let entrySize = nameSize + 24
+    static let alignment = 16
+
+    struct Entry {
+        let offset: Int
+        let length: Int
+        let hash: UInt64
+    }
+
+    private let data: Data
+    private let entries: [String: Entry]
+    private let lock = NSLock()
+    private var verified: Set<String> = []
+
+    /// Maps the archive at `url`; returns nil when there is none.
+    public static func open(at url: URL) throws -> ShaderArchive? {
+        guard FileManager.default.fileExists(atPath: url.path) else { return nil }
+        return try ShaderArchive(data: Data(contentsOf: url, options: .alwaysMapped), source: url.path)
+    }
+
+    public init(data bytes: Data, source: String = "shader archive") throws {
+        guard bytes.count >= Self.headerSize, bytes.starts(with: Self.magic) else {
+            throw AgentError.invalidArgument("\(source) is not a shader archive")
+        }
+        let version = UInt32(truncatingIfNeeded: Self.readInteger(bytes, at: 4, size: 4))
+        guard version == Self.version else {
+            throw AgentError.invalidArgument("\(source) has archive version \(version); expected \(Self.version)")
+        }
+        let count = Int(Self.readInteger(bytes, at: 8, size: 4))
+        guard count <= (bytes.count - Self.headerSize) / Self.entrySize else {
+            throw AgentError.invalidArgument("\(source) declares \(count) entries but is \(bytes.count) bytes")
+        }
+        var entries: [String: Entry] = [:]
+        entries.reserveCapacity(count)
+        for index in 0..<count {
+            let base = Self.headerSize + index * Self.entrySize
+            let nameStart = bytes.startIndex + base
+            let nameBytes = bytes[nameStart..<(nameStart + Self.nameSize)].prefix { $0 != 0 }
+            let offset = Self.readInteger(bytes, at: base + Self.nameSize, size: 8)
+            let length = Self.readInteger(bytes, at: base + Self.nameSize + 8, size: 8)
+            guard let name = String(bytes: nameBytes, encoding: .utf8), !name.isEmpty,
+                  offset <= UInt64(bytes.count), length <= UInt64(bytes.count) - offset else {
+                throw AgentError.invalidArgument("\(source) has a malformed index entry at \(index)")
+            }
+            entries[name] = Entry(offset: bytes.startIndex + Int(offset), length: Int(length),
+                                  hash: Self.readInteger(bytes, at: base + Self.nameSize + 16, size: 8))
+        }
+        self.data = bytes
+        self.entries = entries
+    }
+
+    public var names: [String] { entries.keys.sorted() }
+
+    public func contains(_ name: String) -> Bool { entries[name] != nil }
+
+    /// The blob for `name` (e.g. "spirv/basic_lit.vert.spv") as a slice of the mapping, or nil
+    /// when the archive has no such entry. Throws if its bytes do not match the indexed hash.
+    public func blob(named name: String) throws -> Data? {
+        guard let entry = entries[name] else { return nil }
+        let blob = data[entry.offset..<(entry.offset + entry.length)]
+        lock.lock(); defer { lock.unlock() }
+        if !verified.contains(name) {
+            guard Self.fnv1a64(blob) == entry.hash else {
+                throw AgentError.internalError("Shader archive entry \(name) failed its hash check. Rebuild the shaders.")
+            }
+            verified.insert(name)
+        }
+        return blob
+    }
+
+    /// Packs `artifacts` (name -> bytes) in the layout above, in name order.
+    public static func encode(_ artifacts: [String: Data]) throws -> Data {
+        func aligned(_ value: Int) -> Int { (value + alignment - 1) / alignment * alignment }
+        let sorted = artifacts.sorted { $0.key < $1.key }
+        var out = Data(magic)
+        appendInteger(UInt64(version), size: 4, to: &out)
+        appendInteger(UInt64(sorted.count), size: 4, to: &out)
+        appendInteger(0, size: 4, to: &out)
+        var offset = aligned(headerSize + entrySize * sorted.count)
+        for (name, blob) in sorted {
+            let nameBytes = Array(name.utf8)
+            guard !nameBytes.isEmpty, nameBytes.count < nameSize else {
+                throw AgentError.invalidArgument("Shader artifact name does not fit the archive index: \(name)")
+            }
+            out.append(contentsOf: nameBytes)
+            out.append(contentsOf: repeatElement(UInt8(0), count: nameSize - nameBytes.count))
+            appendInteger(UInt64(offset), size: 8, to: &out)
+            appendInteger(UInt64(blob.count), size: 8, to: &out)
+            appendInteger(fnv1a64(blob), size: 8, to: &out)
+            offset += aligned(blob.count)
+        }
+        out.append(contentsOf: repeatElement(UInt8(0), count: aligned(out.count) - out.count))
+        for (_, blob) in sorted {
+            out.append(blob)
+            out.append(contentsOf: repeatElement(UInt8(0), count: aligned(blob.count) - blob.count))
+        }
+        return out
+    }
+
+    static func fnv1a64(_ bytes: Data) -> UInt64 {
+        var hash: UInt64 = 0xcbf2_9ce4_8422_2325
+        for byte in bytes {
+            hash ^= UInt64(byte)
+            hash = hash &* 0x0000_0100_0000_01b3
+        }
+        return hash
+    }
+
+    private static func readInteger(_ bytes: Data, at offset: Int, size: Int) -> UInt64 {
+        let start = bytes.startIndex + offset
+        return bytes[start..<(start + size)].reversed().reduce(UInt64(0)) { $0 << 8 | UInt64($1) }
+    }
+
+    private static func appendInteger(_ value: UInt64, size: Int, to out: inout Data) {
+        withUnsafeBytes(of: value.littleEndian) { out.append(contentsOf: $0.prefix(size)) }
+    }
+}
@@ -1,63 +1,82 @@
 import Foundation
 
+/// One compiled shader: a blob in the mapped shader archive, or a loose file under `Generated/`.
+public struct ShaderArtifact: Sendable {
+    /// Path relative to `Generated/`, e.g. "spirv/basic_lit.vert.spv".
+    public let name: String
+    /// The loose file, when the artifact is not in the archive.
+    public let url: URL?
+    let archive: ShaderArchive?
+
+    /// The artifact's bytes; for archived artifacts a slice of the mapping, with nothing copied.
+    public func data() throws -> Data {
+        if let archive, let blob = try archive.blob(named: name) { return blob }
+        if let url { return try Data(contentsOf: url, options: .mappedIfSafe) }
+        throw AgentError.internalError("Shader artifact \(name) not found. Run the shader build plugin.")
+    }
+}
+
 public struct ShaderModuleArtifacts: Sendable {
-    public let dxilVertex: URL?
-    public let dxilFragment: URL?
-    public let spirvVertex: URL?
-    public let spirvFragment: URL?
-    public let metalLibrary: URL?
-
-    func requireDXILVertex(for id: ShaderID) throws -> URL {
-        guard let url = dxilVertex else {
+    public let dxilVertex: ShaderArtifact?
+    public let dxilFragment: ShaderArtifact?
+    public let spirvVertex: ShaderArtifact?
+    public let spirvFragment: ShaderArtifact?
+    public let metalLibrary: ShaderArtifact?
+
+    func requireDXILVertex(for id: ShaderID) throws -> Data {
+        guard let artifact = dxilVertex else {
             throw AgentError.internalError("DXIL vertex shader for \(id.rawValue) not found. Run the shader build plugin.")
         }
-        return url
+        return try artifact.data()
     }
 
-    func dxilFragmentURL(for id: ShaderID) throws -> URL? {
-        if let url = dxilFragment, FileManager.default.fileExists(atPath: url.path) { return url }
-        return nil
+    func dxilFragmentData(for id: ShaderID) throws -> Data? {
+        try dxilFragment?.data()
     }
 
-    func requireMetalLibrary(for id: ShaderID) throws -> URL {
-        guard let url = metalLibrary else {
+    func requireMetalLibrary(for id: ShaderID) throws -> ShaderArtifact {
+        guard let artifact = metalLibrary else {
             throw AgentError.internalError("Metal library for \(id.rawValue) not found. Run the shader build plugin.")
         }
-        return url
+        return artifact
     }
 
-    func requireSPIRVVertex(for id: ShaderID) throws -> URL {
-        guard let url = spirvVertex else {
+    func requireSPIRVVertex(for id: ShaderID) throws -> Data {
+        guard let artifact = spirvVertex else {
             throw AgentError.internalError("SPIR-V vertex shader for \(id.rawValue) not found. Run the shader build plugin.")
         }
-        return url
+        return try artifact.data()
+    }
+
+    func spirvFragmentData(for id: ShaderID) throws -> Data? {
+        try spirvFragment?.data()
     }
 }
 
 public struct ComputeShaderModuleArtifacts: Sendable {
-    public let dxil: URL?
-    public let spirv: URL?
-    public let metalLibrary: URL?
+    public let dxil: ShaderArtifact?
+    public let spirv: ShaderArtifact?
+    public let metalLibrary: ShaderArtifact?
 
-    func requireDXIL(for id: ShaderID) throws -> URL {
-        guard let url = dxil else {
+    func requireDXIL(for id: ShaderID) throws -> Data {
+        guard let artifact = dxil else {
             throw AgentError.internalError("DXIL compute shader for \(id.rawValue) not found. Run the shader build plugin.")
         }
-        return url
+        return try artifact.data()
     }
 
-    func requireSPIRV(for id: ShaderID) throws -> URL {
-        guard let url = spirv else {
+    func requireSPIRV(for id: ShaderID) throws -> Data {
+        guard let artifact = spirv else {
             throw AgentError.internalError("SPIR-V compute shader for \(id.rawValue) not found. Run the shader build plugin.")
         }
-        return url
+        return try artifact.data()
     }
 
-    func requireMetalLibrary(for id: ShaderID) throws -> URL {
-        guard let url = metalLibrary else {
+    func requireMetalLibrary(for id: ShaderID) throws -> ShaderArtifact {
+        guard let artifact = metalLibrary else {
             throw AgentError.internalError("Metal library for compute shader \(id.rawValue) not found. Run the shader build plugin.")
         }
-        return url
+        return artifact
     }
 }
 
@@ -86,40 +105,46 @@ public struct ShaderModule: Sendable {
     }
 }
 
+/// Shader modules by id. Only the archive index is read at startup; a module is built the
+/// first time it is asked for, and its artifacts are read when a backend creates a pipeline.
 @MainActor
 public final class ShaderLibrary {
     public static let shared = ShaderLibrary()
 
-    private var modules: [ShaderID: ShaderModule]
-    private var computeModules: [ShaderID: ComputeShaderModule]
+    private let source: ShaderArtifactSource
+    private var modules: [ShaderID: ShaderModule] = [:]
+    private var computeModules: [ShaderID: ComputeShaderModule] = [:]
     private init() {
-        let root = ShaderLibrary.resolveGeneratedRoot()
-        self.modules = ShaderLibrary.loadModules(root: root)
-        self.computeModules = ShaderLibrary.loadComputeModules(root: root)
+        self.source = ShaderArtifactSource(root: ShaderLibrary.resolveGeneratedRoot())
     }
 
     public func module(for id: ShaderID) throws -> ShaderModule {
-        guard let module = modules[id] else {
+        if let module = modules[id] { return module }
+        guard let module = ShaderLibrary.makeModule(id, source: source) else {
             throw AgentError.invalidArgument("Unknown shader id: \(id.rawValue)")
         }
+        modules[id] = module
         return module
     }
 
     public func computeModule(for id: ShaderID) throws -> ComputeShaderModule {
-        guard let module = computeModules[id] else {
+        if let module = computeModules[id] { return module }
+        guard let module = ShaderLibrary.makeComputeModule(id, source: source) else {
             throw AgentError.invalidArgument("Unknown compute shader id: \(id.rawValue)")
         }
+        computeModules[id] = module
         return module
     }
 
+    /// The metallib as a file, decoding it from its committed payload if needed.
     public func metalLibraryURL(for id: ShaderID) throws -> URL {
         let module = try module(for: id)
-        return try module.artifacts.requireMetalLibrary(for: id)
+        return try source.fileURL(for: module.artifacts.requireMetalLibrary(for: id))
     }
 
     public func metalLibraryURLForComputeShader(_ id: ShaderID) throws -> URL {
         let module = try computeModule(for: id)
-        return try module.artifacts.requireMetalLibrary(for: id)
+        return try source.fileURL(for: module.artifacts.requireMetalLibrary(for: id))
     }
 
 #if DEBUG
@@ -162,63 +187,37 @@ public final class ShaderLibrary {
         return cwd.appendingPathComponent("Sources/SDLKit/Generated", isDirectory: true)
     }
 
-    private static func loadModules(root: URL) -> [ShaderID: ShaderModule] {
-        var modules: [ShaderID: ShaderModule] = [:]
-
-        let unlit = makeUnlitTriangleModule(root: root)
-        modules[unlit.id] = unlit
-
-        let lit = makeBasicLitModule(root: root)
-        modules[lit.id] = lit
-
-        if let directional = makeDirectionalLitModule(root: root) {
-            modules[directional.id] = directional
-        }
-
-        if let pbr = makePBRForwardModule(root: root) {
-            modules[pbr.id] = pbr
+    private static func makeModule(_ id: ShaderID, source: ShaderArtifactSource) -> ShaderModule? {
+        switch id.rawValue {
+        case "unlit_triangle": return makeUnlitTriangleModule(source: source)
+        case "basic_lit": return makeBasicLitModule(source: source)
+        case "directional_lit": return makeDirectionalLitModule(source: source)
+        case "pbr_forward": return makePBRForwardModule(source: source)
+        default: return nil
         }
-
-        return modules
     }
 
-    private static func loadComputeModules(root: URL) -> [ShaderID: ComputeShaderModule] {
-        var result: [ShaderID: ComputeShaderModule] = [:]
-        if let sceneWave = makeScenegraphWaveComputeModule(root: root) {
-            result[sceneWave.id] = sceneWave
-        }
-        if let vectorAdd = makeVectorAddComputeModule(root: root) {
-            result[vectorAdd.id] = vectorAdd
-        }
-        if let prefilter = makeIBLPrefilterEnvComputeModule(root: root) {
-            result[prefilter.id] = prefilter
-        }
-        if let brdf = makeIBLBRDFLUTComputeModule(root: root) {
-            result[brdf.id] = brdf
-        }
-        if let audio = makeAudioDFTPowerComputeModule(root: root) {
-            result[audio.id] = audio
+    private static func makeComputeModule(_ id: ShaderID, source: ShaderArtifactSource) -> ComputeShaderModule? {
+        switch id.rawValue {
+        case "scenegraph_wave": return makeScenegraphWaveComputeModule(source: source)
+        case "vector_add": return makeVectorAddComputeModule(source: source)
+        case "ibl_prefilter_env": return makeIBLPrefilterEnvComputeModule(source: source)
+        case "ibl_brdf_lut": return makeIBLBRDFLUTComputeModule(source: source)
+        case "audio_dft_power": return makeAudioDFTPowerComputeModule(source: source)
+        case "audio_mel_project": return makeAudioMelProjectComputeModule(source: source)
+        case "audio_onset_flux": return makeAudioOnsetFluxComputeModule(source: source)
+        default: return nil
         }
-        if let audioMel = makeAudioMelProjectComputeModule(root: root) {
-            result[audioMel.id] = audioMel
-        }
-        if let onset = makeAudioOnsetFluxComputeModule(root: root) {
-            result[onset.id] = onset
-        }
-        return result
     }
 
-    private static func makeUnlitTriangleModule(root: URL) -> ShaderModule {
+    private static func makeUnlitTriangleModule(source: ShaderArtifactSource) -> ShaderModule {
         let id = ShaderID("unlit_triangle")
-        let dxilRoot = root.appendingPathComponent("dxil", isDirectory: true)
-        let spirvRoot = root.appendingPathComponent("spirv", isDirectory: true)
-        let metalRoot = root.appendingPathComponent("metal", isDirectory: true)
         let artifacts = ShaderModuleArtifacts(
-            dxilVertex: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("unlit_triangle_vs.dxil")),
-            dxilFragment: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("unlit_triangle_ps.dxil")),
-            spirvVertex: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("unlit_triangle.vert.spv")),
-            spirvFragment: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("unlit_triangle.frag.spv")),
-            metalLibrary: ShaderLibrary.existingFile(metalRoot.appendingPathComponent("unlit_triangle.metallib"))
+            dxilVertex: source.artifact("dxil/unlit_triangle_vs.dxil"),
+            dxilFragment: source.artifact("dxil/unlit_triangle_ps.dxil"),
+            spirvVertex: source.artifact("spirv/unlit_triangle.vert.spv"),
+            spirvFragment: source.artifact("spirv/unlit_triangle.frag.spv"),
+            metalLibrary: source.artifact("metal/unlit_triangle.metallib")
         )
 
         let layout = VertexLayout(
@@ -250,17 +249,14 @@ public final class ShaderLibrary {
         )
     }
 
-    private static func makeBasicLitModule(root: URL) -> ShaderModule {
+    private static func makeBasicLitModule(source: ShaderArtifactSource) -> ShaderModule {
         let id = ShaderID("basic_lit")
-        let dxilRoot = root.appendingPathComponent("dxil", isDirectory: true)
-        let spirvRoot = root.appendingPathComponent("spirv", isDirectory: true)
-        let metalRoot = root.appendingPathComponent("metal", isDirectory: true)
         let artifacts = ShaderModuleArtifacts(
-            dxilVertex: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("basic_lit_vs.dxil")),
-            dxilFragment: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("basic_lit_ps.dxil")),
-            spirvVertex: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("basic_lit.vert.spv")),
-            spirvFragment: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("basic_lit.frag.spv")),
-            metalLibrary: ShaderLibrary.existingFile(metalRoot.appendingPathComponent("basic_lit.metallib"))
+            dxilVertex: source.artifact("dxil/basic_lit_vs.dxil"),
+            dxilFragment: source.artifact("dxil/basic_lit_ps.dxil"),
+            spirvVertex: source.artifact("spirv/basic_lit.vert.spv"),
+            spirvFragment: source.artifact("spirv/basic_lit.frag.spv"),
+            metalLibrary: source.artifact("metal/basic_lit.metallib")
         )
 
         let layout = VertexLayout(
@@ -288,17 +284,14 @@ public final class ShaderLibrary {
         )
     }
 
-    private static func makeDirectionalLitModule(root: URL) -> ShaderModule? {
+    private static func makeDirectionalLitModule(source: ShaderArtifactSource) -> ShaderModule? {
         let id = ShaderID("directional_lit")
-        let dxilRoot = root.appendingPathComponent("dxil", isDirectory: true)
-        let spirvRoot = root.appendingPathComponent("spirv", isDirectory: true)
-        let metalRoot = root.appendingPathComponent("metal", isDirectory: true)
         let artifacts = ShaderModuleArtifacts(
-            dxilVertex: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("directional_lit_vs.dxil")),
-            dxilFragment: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("directional_lit_ps.dxil")),
-            spirvVertex: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("directional_lit.vert.spv")),
-            spirvFragment: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("directional_lit.frag.spv")),
-            metalLibrary: ShaderLibrary.existingFile(metalRoot.appendingPathComponent("directional_lit.metallib"))
+            dxilVertex: source.artifact("dxil/directional_lit_vs.dxil"),
+            dxilFragment: source.artifact("dxil/directional_lit_ps.dxil"),
+            spirvVertex: source.artifact("spirv/directional_lit.vert.spv"),
+            spirvFragment: source.artifact("spirv/directional_lit.frag.spv"),
+            metalLibrary: source.artifact("metal/directional_lit.metallib")
         )
 
         if artifacts.dxilVertex == nil && artifacts.spirvVertex == nil && artifacts.metalLibrary == nil {
@@ -335,17 +328,14 @@ public final class ShaderLibrary {
         )
     }
 
-    private static func makePBRForwardModule(root: URL) -> ShaderModule? {
+    private static func makePBRForwardModule(source: ShaderArtifactSource) -> ShaderModule? {
         let id = ShaderID("pbr_forward")
-        let dxilRoot = root.appendingPathComponent("dxil", isDirectory: true)
-        let spirvRoot = root.appendingPathComponent("spirv", isDirectory: true)
-        let metalRoot = root.appendingPathComponent("metal", isDirectory: true)
         let artifacts = ShaderModuleArtifacts(
-            dxilVertex: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("pbr_forward_vs.dxil")),
-            dxilFragment: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("pbr_forward_ps.dxil")),
-            spirvVertex: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("pbr_forward.vert.spv")),
-            spirvFragment: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("pbr_forward.frag.spv")),
-            metalLibrary: ShaderLibrary.existingFile(metalRoot.appendingPathComponent("pbr_forward.metallib"))
+            dxilVertex: source.artifact("dxil/pbr_forward_vs.dxil"),
+            dxilFragment: source.artifact("dxil/pbr_forward_ps.dxil"),
+            spirvVertex: source.artifact("spirv/pbr_forward.vert.spv"),
+            spirvFragment: source.artifact("spirv/pbr_forward.frag.spv"),
+            metalLibrary: source.artifact("metal/pbr_forward.metallib")
         )
 
         if artifacts.dxilVertex == nil && artifacts.spirvVertex == nil && artifacts.metalLibrary == nil {
@@ -391,16 +381,13 @@ public final class ShaderLibrary {
         )
     }
 
-    private static func makeVectorAddComputeModule(root: URL) -> ComputeShaderModule? {
+    private static func makeVectorAddComputeModule(source: ShaderArtifactSource) -> ComputeShaderModule? {
         let id = ShaderID("vector_add")
-        let dxilRoot = root.appendingPathComponent("dxil", isDirectory: true)
-        let spirvRoot = root.appendingPathComponent("spirv", isDirectory: true)
-        let metalRoot = root.appendingPathComponent("metal", isDirectory: true)
 
         let artifacts = ComputeShaderModuleArtifacts(
-            dxil: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("vector_add_cs.dxil")),
-            spirv: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("vector_add.comp.spv")),
-            metalLibrary: ShaderLibrary.existingFile(metalRoot.appendingPathComponent("vector_add.metallib"))
+            dxil: source.artifact("dxil/vector_add_cs.dxil"),
+            spirv: source.artifact("spirv/vector_add.comp.spv"),
+            metalLibrary: source.artifact("metal/vector_add.metallib")
         )
 
         if artifacts.dxil == nil && artifacts.spirv == nil && artifacts.metalLibrary == nil {
@@ -408,8 +395,8 @@ public final class ShaderLibrary {
         }
 
         let bindings: [BindingSlot] = [
-            BindingSlot(index: 0, kind: .storageBuffer),
-            BindingSlot(index: 1, kind: .storageBuffer),
+            BindingSlot(index: 0, kind: .storageBuffer, access: .read),
+            BindingSlot(index: 1, kind: .storageBuffer, access: .read),
             BindingSlot(index: 2, kind: .storageBuffer)
         ]
 
@@ -423,16 +410,13 @@ public final class ShaderLibrary {
         )
     }
 
-    private static func makeScenegraphWaveComputeModule(root: URL) -> ComputeShaderModule? {
+    private static func makeScenegraphWaveComputeModule(source: ShaderArtifactSource) -> ComputeShaderModule? {
         let id = ShaderID("scenegraph_wave")
-        let dxilRoot = root.appendingPathComponent("dxil", isDirectory: true)
-        let spirvRoot = root.appendingPathComponent("spirv", isDirectory: true)
-        let metalRoot = root.appendingPathComponent("metal", isDirectory: true)
 
         let artifacts = ComputeShaderModuleArtifacts(
-            dxil: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("scenegraph_wave_cs.dxil")),
-            spirv: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("scenegraph_wave.comp.spv")),
-            metalLibrary: ShaderLibrary.existingFile(metalRoot.appendingPathComponent("scenegraph_wave.metallib"))
+            dxil: source.artifact("dxil/scenegraph_wave_cs.dxil"),
+            spirv: source.artifact("spirv/scenegraph_wave.comp.spv"),
+            metalLibrary: source.artifact("metal/scenegraph_wave.metallib")
         )
 
         if artifacts.dxil == nil && artifacts.spirv == nil && artifacts.metalLibrary == nil {
@@ -441,7 +425,7 @@ public final class ShaderLibrary {
 
         let bindings: [BindingSlot] = [
             BindingSlot(index: 0, kind: .storageBuffer),
-            BindingSlot(index: 1, kind: .storageBuffer),
+            BindingSlot(index: 1, kind: .storageBuffer, access: .read),
             BindingSlot(index: 2, kind: .storageBuffer)
         ]
 
@@ -455,16 +439,13 @@ public final class ShaderLibrary {
         )
     }
 
-    private static func makeIBLPrefilterEnvComputeModule(root: URL) -> ComputeShaderModule? {
+    private static func makeIBLPrefilterEnvComputeModule(source: ShaderArtifactSource) -> ComputeShaderModule? {
         let id = ShaderID("ibl_prefilter_env")
-        let dxilRoot = root.appendingPathComponent("dxil", isDirectory: true)
-        let spirvRoot = root.appendingPathComponent("spirv", isDirectory: true)
-        let metalRoot = root.appendingPathComponent("metal", isDirectory: true)
 
         let artifacts = ComputeShaderModuleArtifacts(
-            dxil: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("ibl_prefilter_env_cs.dxil")),
-            spirv: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("ibl_prefilter_env.comp.spv")),
-            metalLibrary: ShaderLibrary.existingFile(metalRoot.appendingPathComponent("ibl_prefilter_env.metallib"))
+            dxil: source.artifact("dxil/ibl_prefilter_env_cs.dxil"),
+            spirv: source.artifact("spirv/ibl_prefilter_env.comp.spv"),
+            metalLibrary: source.artifact("metal/ibl_prefilter_env.metallib")
         )
 
         if artifacts.dxil == nil && artifacts.spirv == nil && artifacts.metalLibrary == nil {
@@ -487,16 +468,13 @@ public final class ShaderLibrary {
         )
     }
 
-    private static func makeIBLBRDFLUTComputeModule(root: URL) -> ComputeShaderModule? {
+    private static func makeIBLBRDFLUTComputeModule(source: ShaderArtifactSource) -> ComputeShaderModule? {
         let id = ShaderID("ibl_brdf_lut")
-        let dxilRoot = root.appendingPathComponent("dxil", isDirectory: true)
-        let spirvRoot = root.appendingPathComponent("spirv", isDirectory: true)
-        let metalRoot = root.appendingPathComponent("metal", isDirectory: true)
 
         let artifacts = ComputeShaderModuleArtifacts(
-            dxil: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("ibl_brdf_lut_cs.dxil")),
-            spirv: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("ibl_brdf_lut.comp.spv")),
-            metalLibrary: ShaderLibrary.existingFile(metalRoot.appendingPathComponent("ibl_brdf_lut.metallib"))
+            dxil: source.artifact("dxil/ibl_brdf_lut_cs.dxil"),
+            spirv: source.artifact("spirv/ibl_brdf_lut.comp.spv"),
+            metalLibrary: source.artifact("metal/ibl_brdf_lut.metallib")
         )
 
         if artifacts.dxil == nil && artifacts.spirv == nil && artifacts.metalLibrary == nil {
@@ -517,16 +495,13 @@ public final class ShaderLibrary {
         )
     }
 
-    private static func makeAudioDFTPowerComputeModule(root: URL) -> ComputeShaderModule? {
+    private static func makeAudioDFTPowerComputeModule(source: ShaderArtifactSource) -> ComputeShaderModule? {
         let id = ShaderID("audio_dft_power")
-        let dxilRoot = root.appendingPathComponent("dxil", isDirectory: true)
-        let spirvRoot = root.appendingPathComponent("spirv", isDirectory: true)
-        let metalRoot = root.appendingPathComponent("metal", isDirectory: true)
 
         let artifacts = ComputeShaderModuleArtifacts(
-            dxil: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("audio_dft_power_cs.dxil")),
-            spirv: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("audio_dft_power.comp.spv")),
-            metalLibrary: ShaderLibrary.existingFile(metalRoot.appendingPathComponent("audio_dft_power.metallib"))
+            dxil: source.artifact("dxil/audio_dft_power_cs.dxil"),
+            spirv: source.artifact("spirv/audio_dft_power.comp.spv"),
+            metalLibrary: source.artifact("metal/audio_dft_power.metallib")
         )
 
         if artifacts.dxil == nil && artifacts.spirv == nil && artifacts.metalLibrary == nil {
@@ -534,7 +509,7 @@ public final class ShaderLibrary {
         }
 
         let bindings: [BindingSlot] = [
-            BindingSlot(index: 0, kind: .storageBuffer), // input samples
+            BindingSlot(index: 0, kind: .storageBuffer, access: .read), // input samples
             BindingSlot(index: 1, kind: .storageBuffer)  // output power
         ]
 
@@ -548,16 +523,13 @@ public final class ShaderLibrary {
         )
     }
 
-    private static func makeAudioMelProjectComputeModule(root: URL) -> ComputeShaderModule? {
+    private static func makeAudioMelProjectComputeModule(source: ShaderArtifactSource) -> ComputeShaderModule? {
         let id = ShaderID("audio_mel_project")
-        let dxilRoot = root.appendingPathComponent("dxil", isDirectory: true)
-        let spirvRoot = root.appendingPathComponent("spirv", isDirectory: true)
-        let metalRoot = root.appendingPathComponent("metal", isDirectory: true)
 
         let artifacts = ComputeShaderModuleArtifacts(
-            dxil: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("audio_mel_project_cs.dxil")),
-            spirv: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("audio_mel_project.comp.spv")),
-            metalLibrary: ShaderLibrary.existingFile(metalRoot.appendingPathComponent("audio_mel_project.metallib"))
+            dxil: source.artifact("dxil/audio_mel_project_cs.dxil"),
+            spirv: source.artifact("spirv/audio_mel_project.comp.spv"),
+            metalLibrary: source.artifact("metal/audio_mel_project.metallib")
         )
 
         if artifacts.dxil == nil && artifacts.spirv == nil && artifacts.metalLibrary == nil {
@@ -565,8 +537,8 @@ public final class ShaderLibrary {
         }
 
         let bindings: [BindingSlot] = [
-            BindingSlot(index: 0, kind: .storageBuffer), // input power spectra
-            BindingSlot(index: 1, kind: .storageBuffer), // mel weights matrix
+            BindingSlot(index: 0, kind: .storageBuffer, access: .read), // input power spectra
+            BindingSlot(index: 1, kind: .storageBuffer, access: .read), // mel weights matrix
             BindingSlot(index: 2, kind: .storageBuffer)  // output mel energies
         ]
 
@@ -580,16 +552,13 @@ public final class ShaderLibrary {
         )
     }
 
-    private static func makeAudioOnsetFluxComputeModule(root: URL) -> ComputeShaderModule? {
+    private static func makeAudioOnsetFluxComputeModule(source: ShaderArtifactSource) -> ComputeShaderModule? {
         let id = ShaderID("audio_onset_flux")
-        let dxilRoot = root.appendingPathComponent("dxil", isDirectory: true)
-        let spirvRoot = root.appendingPathComponent("spirv", isDirectory: true)
-        let metalRoot = root.appendingPathComponent("metal", isDirectory: true)
 
         let artifacts = ComputeShaderModuleArtifacts(
-            dxil: ShaderLibrary.existingFile(dxilRoot.appendingPathComponent("audio_onset_flux_cs.dxil")),
-            spirv: ShaderLibrary.existingFile(spirvRoot.appendingPathComponent("audio_onset_flux.comp.spv")),
-            metalLibrary: ShaderLibrary.existingFile(metalRoot.appendingPathComponent("audio_onset_flux.metallib"))
+            dxil: source.artifact("dxil/audio_onset_flux_cs.dxil"),
+            spirv: source.artifact("spirv/audio_onset_flux.comp.spv"),
+            metalLibrary: source.artifact("metal/audio_onset_flux.metallib")
         )
 
         if artifacts.dxil == nil && artifacts.spirv == nil && artifacts.metalLibrary == nil {
@@ -597,8 +566,8 @@ public final class ShaderLibrary {
         }
 
         let bindings: [BindingSlot] = [
-            BindingSlot(index: 0, kind: .storageBuffer), // mel frames
-            BindingSlot(index: 1, kind: .storageBuffer), // prev mel
+            BindingSlot(index: 0, kind: .storageBuffer, access: .read), // mel frames
+            BindingSlot(index: 1, kind: .storageBuffer, access: .read), // prev mel
             BindingSlot(index: 2, kind: .storageBuffer)  // onset out
         ]
 
@@ -611,8 +580,37 @@ public final class ShaderLibrary {
             artifacts: artifacts
         )
     }
+}
+
+/// Resolves artifact names against the mapped archive, falling back to loose files.
+struct ShaderArtifactSource: Sendable {
+    let root: URL
+    let archive: ShaderArchive?
+
+    init(root: URL) {
+        self.root = root
+        do {
+            archive = try ShaderArchive.open(at: root.appendingPathComponent(ShaderArchive.fileName))
+        } catch {
+            SDLLogger.warn("SDLKit.Graphics", "Ignoring shader archive under \(root.path): \(error)")
+            archive = nil
+        }
+    }
+
+    func artifact(_ name: String) -> ShaderArtifact? {
+        if let archive, archive.contains(name) {
+            return ShaderArtifact(name: name, url: nil, archive: archive)
+        }
+        guard let url = existingFile(root.appendingPathComponent(name)) else { return nil }
+        return ShaderArtifact(name: name, url: url, archive: nil)
+    }
+
+    func fileURL(for artifact: ShaderArtifact) throws -> URL {
+        if let url = artifact.url ?? existingFile(root.appendingPathComponent(artifact.name)) { return url }
+        throw AgentError.internalError("Shader artifact \(artifact.name) has no file under \(root.path)")
+    }
 
-    private static func existingFile(_ url: URL) -> URL? {
+    private func existingFile(_ url: URL) -> URL? {
         do {
             if let realized = try ShaderArtifactMaterializer.materializeArtifactIfNeeded(at: url) {
                 return realized
@@ -0,0 +1,203 @@
+import Foundation
+
+/// A resource handle a `SlotMap` can mint: its `rawValue` packs the slot index into the low
+/// 32 bits and the slot's generation into the high 32.
+public protocol SlotMapHandle: Hashable {
+    var rawValue: UInt64 { get }
+    init(rawValue: UInt64)
+}
+
+extension BufferHandle: SlotMapHandle {}
+extension TextureHandle: SlotMapHandle {}
+extension SamplerHandle: SlotMapHandle {}
+extension PipelineHandle: SlotMapHandle {}
+extension ComputePipelineHandle: SlotMapHandle {}
+extension MeshHandle: SlotMapHandle {}
+
+/// Generational slot map: the backends' resource tables.
+///
+/// Values live densely in insertion order (with swap-remove), so iteration is a linear walk; a
+/// lookup is an index into `slots` plus a generation compare, with no hashing. Destroying a
+/// resource bumps its slot's generation, so a stale handle is told apart from a live one
+/// (`isStale`) instead of aliasing whatever reuses the slot. Each map starts its generations
+/// at a random seed, so handles minted by another backend's table almost never resolve here.
+///
+/// `removeAll` keeps every slot reserved at its current generation: a device reset snapshots
+/// the table (`mapValues`), clears it, and puts resources back under their old handles with
+/// the subscript setter.
+struct SlotMap<Handle: SlotMapHandle, Value> {
+    private struct Slot {
+        var generation: UInt32
+        /// Index into the dense arrays, or -1 when the slot holds nothing.
+        var dense: Int
+        /// On `freeSlots`; its next generation has not been handed out yet.
+        var isFree: Bool
+    }
+
+    private var slots: [Slot] = []
+    private var freeSlots: [Int] = []
+    private var denseHandles: ContiguousArray<Handle> = []
+    private var denseValues: ContiguousArray<Value> = []
+    private let seed: UInt32
+
+    init() {
+        seed = UInt32.random(in: 1...UInt32.max)
+    }
+
+    private init(slots: [Slot], freeSlots: [Int], denseHandles: ContiguousArray<Handle>, denseValues: ContiguousArray<Value>, seed: UInt32) {
+        self.slots = slots
+        self.freeSlots = freeSlots
+        self.denseHandles = denseHandles
+        self.denseValues = denseValues
+        self.seed = seed
+    }
+
+    var count: Int { denseValues.count }
+    var isEmpty: Bool { denseValues.isEmpty }
+    var keys: ContiguousArray<Handle> { denseHandles }
+    var values: ContiguousArray<Value> { denseValues }
+
+    /// Stores `value` in a free slot and returns its new handle.
+    mutating func insert(_ value: Value) -> Handle {
+        insert(with: { _ in value })
+    }
+
+    /// Stores the value built from its own handle, for resources that record it.
+    mutating func insert(with makeValue: (Handle) throws -> Value) rethrows -> Handle {
+        let index = freeSlots.last ?? slots.count
+        let generation = index < slots.count ? slots[index].generation : seed
+        let handle = Handle(rawValue: UInt64(generation) << 32 | UInt64(index))
+        let value = try makeValue(handle)
+        if index < slots.count {
+            freeSlots.removeLast()
+            slots[index] = Slot(generation: generation, dense: denseValues.count, isFree: false)
+        } else {
+            slots.append(Slot(generation: generation, dense: denseValues.count, isFree: false))
+        }
+        denseHandles.append(handle)
+        denseValues.append(value)
+        return handle
+    }
+
+    subscript(handle: Handle) -> Value? {
+        get {
+            guard let index = slotIndex(handle), slots[index].dense >= 0 else { return nil }
+            return denseValues[slots[index].dense]
+        }
+        set {
+            guard let newValue else {
+                removeValue(forKey: handle)
+                return
+            }
+            guard let index = slotIndex(handle), !slots[index].isFree else {
+                assertionFailure("\(Handle.self) \(String(handle.rawValue, radix: 16)) was not minted by this table; use insert(_:)")
+                return
+            }
+            if slots[index].dense >= 0 {
+                denseValues[slots[index].dense] = newValue
+            } else {
+                // A reserved slot being restored after `removeAll`.
+                slots[index].dense = denseValues.count
+                denseHandles.append(handle)
+                denseValues.append(newValue)
+            }
+        }
+    }
+
+    func contains(_ handle: Handle) -> Bool {
+        self[handle] != nil
+    }
+
+    /// Whether `handle` came from this table but its resource has since been destroyed, or
+    /// was cleared by `removeAll` and not stored again.
+    func isStale(_ handle: Handle) -> Bool {
+        let index = Int(truncatingIfNeeded: handle.rawValue & 0xFFFF_FFFF)
+        guard index < slots.count else { return false }
+        let generation = UInt32(truncatingIfNeeded: handle.rawValue >> 32)
+        let current = slots[index].generation
+        if generation == current {
+            return slots[index].dense < 0 && !slots[index].isFree
+        }
+        // Generations only move forward from the seed, so every one between it and the
+        // current generation was issued here and retired.
+        let age = current &- generation
+        return age > 0 && age <= current &- seed
+    }
+
+    /// "Destroyed" or "Unknown", to open the error for a handle that does not resolve.
+    func missingDescription(_ handle: Handle) -> String {
+        isStale(handle) ? "Destroyed" : "Unknown"
+    }
+
+    /// Removes the value and retires the handle; the slot is reused under a new generation.
+    @discardableResult
+    mutating func removeValue(forKey handle: Handle) -> Value? {
+        guard let index = slotIndex(handle), !slots[index].isFree else { return nil }
+        var removed: Value?
+        let dense = slots[index].dense
+        if dense >= 0 {
+            removed = denseValues[dense]
+            let last = denseValues.count - 1
+            if dense != last {
+                denseValues[dense] = denseValues[last]
+                denseHandles[dense] = denseHandles[last]
+                slots[Int(truncatingIfNeeded: denseHandles[dense].rawValue & 0xFFFF_FFFF)].dense = dense
+            }
+            denseValues.removeLast()
+            denseHandles.removeLast()
+        }
+        var next = slots[index].generation &+ 1
+        if next == 0 { next = 1 }
+        slots[index] = Slot(generation: next, dense: -1, isFree: true)
+        freeSlots.append(index)
+        return removed
+    }
+
+    /// Drops every value but keeps the slots reserved, so the same handles can be stored again.
+    /// Slots that are never refilled stay reserved: their old handles keep failing to resolve
+    /// rather than aliasing a newer resource.
+    mutating func removeAll(keepingCapacity keepCapacity: Bool = false) {
+        for handle in denseHandles {
+            slots[Int(truncatingIfNeeded: handle.rawValue & 0xFFFF_FFFF)].dense = -1
+        }
+        denseHandles.removeAll(keepingCapacity: keepCapacity)
+        denseValues.removeAll(keepingCapacity: keepCapacity)
+    }
+
+    /// The same handles mapped to new values.
+    func mapValues<T>(_ transform: (Value) throws -> T) rethrows -> SlotMap<Handle, T> {
+        var mapped = ContiguousArray<T>()
+        mapped.reserveCapacity(denseValues.count)
+        for value in denseValues { mapped.append(try transform(value)) }
+        return SlotMap<Handle, T>(slots: slots.map { .init(generation: $0.generation, dense: $0.dense, isFree: $0.isFree) },
+                                  freeSlots: freeSlots, denseHandles: denseHandles, denseValues: mapped, seed: seed)
+    }
+
+    private func slotIndex(_ handle: Handle) -> Int? {
+        let index = Int(truncatingIfNeeded: handle.rawValue & 0xFFFF_FFFF)
+        guard index < slots.count, slots[index].generation == UInt32(truncatingIfNeeded: handle.rawValue >> 32) else {
+            return nil
+        }
+        return index
+    }
+}
+
+extension SlotMap: Sequence {
+    struct Iterator: IteratorProtocol {
+        fileprivate let handles: ContiguousArray<Handle>
+        fileprivate let values: ContiguousArray<Value>
+        fileprivate var position = 0
+
+        mutating func next() -> (key: Handle, value: Value)? {
+            guard position < values.count else { return nil }
+            defer { position += 1 }
+            return (handles[position], values[position])
+        }
+    }
+
+    func makeIterator() -> Iterator {
+        Iterator(handles: denseHandles, values: denseValues)
+    }
+
+    var underestimatedCount: Int { denseValues.count }
+}
@@ -0,0 +1,510 @@
+import Foundation
+
+// CPU rasterizer behind the stub backends.
+//
+// Draws are vertex-processed and near-clipped when submitted; `flush` bins the resulting
+// screen-space triangles into 64x64 tiles and shades the tiles in parallel. Each tile
+// walks its bin in submission order, so the image is identical for any core count.
+// Shading follows the built-in shader contract (Shaders/graphics/*.hlsl): a constant
+// block of column-major MVP, light direction and base color; `unlit_triangle` outputs
+// `color * baseColor`, lit shaders `color * (0.15 + 0.85 * N·L) * baseColor`. Depth is
+// D3D/Metal style: clip z in [0, w], LESS test against a 1.0 clear.
+struct SoftwareRasterizer {
+    static let tileSize = 64
+    /// Matches the clear color of the native backends.
+    static let clearColor = SIMD4<Float>(0.05, 0.05, 0.08, 1.0)
+    static let defaultLightDirection = SIMD3<Float>(0.3, -0.5, 0.8)
+
+    enum Shading: Sendable {
+        case unlit
+        case lit
+    }
+
+    /// Contents of the built-in 96-byte constant block. Missing trailing fields keep
+    /// their defaults.
+    struct DrawConstants {
+        var mvp: float4x4
+        var lightDirection = SoftwareRasterizer.defaultLightDirection
+        var baseColor = SIMD4<Float>(1, 1, 1, 1)
+
+        init(mvp: float4x4) { self.mvp = mvp }
+
+        mutating func load(from raw: UnsafeRawBufferPointer) {
+            let vec = MemoryLayout<SIMD4<Float>>.size
+            if raw.count >= float4x4.packedByteCount {
+                mvp = float4x4(columns: raw.loadUnaligned(fromByteOffset: 0, as: SIMD4<Float>.self),
+                               raw.loadUnaligned(fromByteOffset: vec, as: SIMD4<Float>.self),
+                               raw.loadUnaligned(fromByteOffset: vec * 2, as: SIMD4<Float>.self),
+                               raw.loadUnaligned(fromByteOffset: vec * 3, as: SIMD4<Float>.self))
+            }
+            if raw.count >= float4x4.packedByteCount + vec {
+                let light = raw.loadUnaligned(fromByteOffset: float4x4.packedByteCount, as: SIMD4<Float>.self)
+                lightDirection = SIMD3(light.x, light.y, light.z)
+            }
+            if raw.count >= float4x4.packedByteCount + vec * 2 {
+                baseColor = raw.loadUnaligned(fromByteOffset: float4x4.packedByteCount + vec, as: SIMD4<Float>.self)
+            }
+        }
+    }
+
+    /// 8-bit color texture (nearest, repeat).
+    struct Texture {
+        enum Mapping: Sendable {
+            /// Sampled through the TEXCOORD0 varying.
+            case texcoord
+            /// Stretched over the whole target by pixel position, for layouts without
+            /// TEXCOORD0 that still bind a texture (`basic_lit`).
+            case screen
+        }
+
+        var width: Int
+        var height: Int
+        var isBGRA: Bool
+        var texels: [UInt8]
+        var mapping: Mapping = .texcoord
+    }
+
+    struct Material {
+        var shading: Shading
+        var constants: DrawConstants
+        var depthTest: Bool
+        var texture: Texture?
+        fileprivate var light = SIMD3<Float>(0, 0, 1)
+
+        init(shading: Shading, constants: DrawConstants, depthTest: Bool, texture: Texture? = nil) {
+            self.shading = shading
+            self.constants = constants
+            self.depthTest = depthTest
+            self.texture = texture
+            let length = (constants.lightDirection * constants.lightDirection).sum().squareRoot()
+            if length > 0, length.isFinite { light = constants.lightDirection / length }
+        }
+    }
+
+    private struct Vertex {
+        var clip: SIMD4<Float>
+        var color: SIMD3<Float>
+        var normal: SIMD3<Float>
+        var uv: SIMD2<Float>
+
+        static func lerp(_ a: Vertex, _ b: Vertex, _ t: Float) -> Vertex {
+            Vertex(clip: a.clip + (b.clip - a.clip) * t,
+                   color: a.color + (b.color - a.color) * t,
+                   normal: a.normal + (b.normal - a.normal) * t,
+                   uv: a.uv + (b.uv - a.uv) * t)
+        }
+    }
+
+    /// Screen-space triangle with positive area; varyings are pre-divided by w.
+    struct Triangle {
+        var x: SIMD3<Float>
+        var y: SIMD3<Float>
+        var z: SIMD3<Float>
+        var invW: SIMD3<Float>
+        var area: Float
+        var color: (SIMD3<Float>, SIMD3<Float>, SIMD3<Float>)
+        var normal: (SIMD3<Float>, SIMD3<Float>, SIMD3<Float>)
+        var uv: (SIMD2<Float>, SIMD2<Float>, SIMD2<Float>)
+        var material: Int32
+        var minX: Int32
+        var minY: Int32
+        var maxX: Int32
+        var maxY: Int32
+    }
+
+    // Clip-space outcodes. Only near and w are clipped geometrically; x/y are handled by
+    // the screen bounding box and far depth per pixel.
+    private static let outNear: UInt8 = 1 << 0
+    private static let outW: UInt8 = 1 << 1
+    private static let outLeft: UInt8 = 1 << 2
+    private static let outRight: UInt8 = 1 << 3
+    private static let outBottom: UInt8 = 1 << 4
+    private static let outTop: UInt8 = 1 << 5
+    private static let clipEpsilon: Float = 1e-5
+
+    private(set) var width = 1
+    private(set) var height = 1
+    private(set) var triangles: [Triangle] = []
+    private var materials: [Material] = []
+    private var vertexCache: [Vertex] = []
+    private var bins: [[Int32]] = []
+
+    var tilesX: Int { (width + Self.tileSize - 1) / Self.tileSize }
+    var tilesY: Int { (height + Self.tileSize - 1) / Self.tileSize }
+
+    mutating func beginFrame(width: Int, height: Int) {
+        self.width = max(1, width)
+        self.height = max(1, height)
+        triangles.removeAll(keepingCapacity: true)
+        materials.removeAll(keepingCapacity: true)
+    }
+
+    /// Fills a BGRA8 color target with `clearColor` and a Float depth target with 1.0.
+    static func clear(color: UnsafeMutableRawBufferPointer, depth: UnsafeMutableRawBufferPointer) {
+        let c = clearColor
+        let pattern = UInt32(quantize(c.z)) | UInt32(quantize(c.y)) << 8 | UInt32(quantize(c.x)) << 16 | UInt32(quantize(c.w)) << 24
+        for offset in stride(from: 0, to: color.count - 3, by: 4) {
+            color.storeBytes(of: pattern.littleEndian, toByteOffset: offset, as: UInt32.self)
+        }
+        for offset in stride(from: 0, to: depth.count - 3, by: 4) {
+            depth.storeBytes(of: Float(1), toByteOffset: offset, as: Float.self)
+        }
+    }
+
+    // MARK: - Vertex processing
+
+    /// Transforms, clips and sets up one draw. Attributes are fetched by semantic
+    /// (POSITION, COLOR, NORMAL, TEXCOORD0) so any float layout works. Returns the number
+    /// of triangles queued.
+    @discardableResult
+    mutating func submit(vertices: UnsafeRawBufferPointer,
+                         layout: VertexLayout,
+                         vertexCount: Int,
+                         indices: UnsafeRawBufferPointer?,
+                         indexFormat: IndexFormat,
+                         indexCount: Int,
+                         material: Material) -> Int {
+        guard let position = layout.attributes.first(where: { $0.semantic == "POSITION" }) else { return 0 }
+        let color = layout.attributes.first { $0.semantic == "COLOR" }
+        let normal = layout.attributes.first { $0.semantic == "NORMAL" }
+        let uv = layout.attributes.first { $0.semantic == "TEXCOORD0" }
+
+        let stride = max(1, layout.stride)
+        let footprint = layout.attributes.map { $0.offset + Self.byteSize($0.format) }.max() ?? 0
+        let available = vertices.count < footprint ? 0 : min(vertexCount, (vertices.count - footprint) / stride + 1)
+        guard available > 0 else { return 0 }
+
+        // Lit draws without normals are lit head-on rather than left dark.
+        let defaultNormal = material.light
+        let mvp = material.constants.mvp
+        vertexCache.removeAll(keepingCapacity: true)
+        for i in 0..<available {
+            let base = i * stride
+            let p = Self.fetch(vertices, base + position.offset, position.format)
+            var vertex = Vertex(clip: mvp.transform(SIMD4(p.x, p.y, p.z, 1)),
+                                color: SIMD3(1, 1, 1),
+                                normal: defaultNormal,
+                                uv: .zero)
+            if let color {
+                let c = Self.fetch(vertices, base + color.offset, color.format)
+                vertex.color = SIMD3(c.x, c.y, c.z)
+            }
+            if let normal {
+                let n = Self.fetch(vertices, base + normal.offset, normal.format)
+                vertex.normal = SIMD3(n.x, n.y, n.z)
+            }
+            if let uv {
+                let t = Self.fetch(vertices, base + uv.offset, uv.format)
+                vertex.uv = SIMD2(t.x, t.y)
+            }
+            vertexCache.append(vertex)
+        }
+
+        let materialIndex = Int32(materials.count)
+        materials.append(material)
+        var emitted = 0
+        if let indices {
+            let indexSize = indexFormat == .uint16 ? 2 : 4
+            let count = min(indexCount, indices.count / indexSize)
+            var t = 0
+            while t + 2 < count {
+                let a = Self.index(indices, t, indexFormat)
+                let b = Self.index(indices, t + 1, indexFormat)
+                let c = Self.index(indices, t + 2, indexFormat)
+                if a < available, b < available, c < available {
+                    emitted += emit(vertexCache[a], vertexCache[b], vertexCache[c], material: materialIndex)
+                }
+                t += 3
+            }
+        } else {
+            var t = 0
+            while t + 2 < available {
+                emitted += emit(vertexCache[t], vertexCache[t + 1], vertexCache[t + 2], material: materialIndex)
+                t += 3
+            }
+        }
+        return emitted
+    }
+
+    private static func byteSize(_ format: VertexFormat) -> Int {
+        switch format {
+        case .float2: return 8
+        case .float3: return 12
+        case .float4: return 16
+        }
+    }
+
+    private static func fetch(_ raw: UnsafeRawBufferPointer, _ offset: Int, _ format: VertexFormat) -> SIMD4<Float> {
+        let x = raw.loadUnaligned(fromByteOffset: offset, as: Float.self)
+        let y = raw.loadUnaligned(fromByteOffset: offset + 4, as: Float.self)
+        switch format {
+        case .float2:
+            return SIMD4(x, y, 0, 0)
+        case .float3:
+            return SIMD4(x, y, raw.loadUnaligned(fromByteOffset: offset + 8, as: Float.self), 0)
+        case .float4:
+            return raw.loadUnaligned(fromByteOffset: offset, as: SIMD4<Float>.self)
+        }
+    }
+
+    private static func index(_ raw: UnsafeRawBufferPointer, _ i: Int, _ format: IndexFormat) -> Int {
+        switch format {
+        case .uint16: return Int(raw.loadUnaligned(fromByteOffset: i * 2, as: UInt16.self))
+        case .uint32: return Int(raw.loadUnaligned(fromByteOffset: i * 4, as: UInt32.self))
+        }
+    }
+
+    private static func outcode(_ v: Vertex) -> UInt8 {
+        let c = v.clip
+        var code: UInt8 = 0
+        if c.z < 0 { code |= outNear }
+        if c.w < clipEpsilon { code |= outW }
+        if c.x < -c.w { code |= outLeft }
+        if c.x > c.w { code |= outRight }
+        if c.y < -c.w { code |= outBottom }
+        if c.y > c.w { code |= outTop }
+        return code
+    }
+
+    private mutating func emit(_ a: Vertex, _ b: Vertex, _ c: Vertex, material: Int32) -> Int {
+        let ca = Self.outcode(a), cb = Self.outcode(b), cc = Self.outcode(c)
+        guard ca & cb & cc == 0 else { return 0 }
+        let clipMask = Self.outNear | Self.outW
+        guard (ca | cb | cc) & clipMask != 0 else {
+            return setup(a, b, c, material: material) ? 1 : 0
+        }
+        // Sutherland-Hodgman against the near plane (z >= 0) and w >= epsilon.
+        var polygon = [a, b, c]
+        for plane in 0..<2 {
+            var clipped: [Vertex] = []
+            clipped.reserveCapacity(polygon.count + 1)
+            for i in polygon.indices {
+                let current = polygon[i]
+                let next = polygon[(i + 1) % polygon.count]
+                let dc = plane == 0 ? current.clip.z : current.clip.w - Self.clipEpsilon
+                let dn = plane == 0 ? next.clip.z : next.clip.w - Self.clipEpsilon
+                if dc >= 0 { clipped.append(current) }
+                if (dc >= 0) != (dn >= 0) {
+                    clipped.append(Vertex.lerp(current, next, dc / (dc - dn)))
+                }
+            }
+            polygon = clipped
+            if polygon.count < 3 { return 0 }
+        }
+        var emitted = 0
+        for i in 1..<(polygon.count - 1) {
+            if setup(polygon[0], polygon[i], polygon[i + 1], material: material) { emitted += 1 }
+        }
+        return emitted
+    }
+
+    private mutating func setup(_ v0: Vertex, _ v1: Vertex, _ v2: Vertex, material: Int32) -> Bool {
+        let invW = 1 / SIMD3(v0.clip.w, v1.clip.w, v2.clip.w)
+        let fw = Float(width), fh = Float(height)
+        var x = (SIMD3(v0.clip.x, v1.clip.x, v2.clip.x) * invW * 0.5 + 0.5) * fw
+        var y = (0.5 - SIMD3(v0.clip.y, v1.clip.y, v2.clip.y) * invW * 0.5) * fh
+        var z = SIMD3(v0.clip.z, v1.clip.z, v2.clip.z) * invW
+        var area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0])
+        guard area.isFinite, abs(area) > 1e-12 else { return false }
+
+        var w = invW
+        var verts = (v0, v1, v2)
+        // No culling: flip clockwise triangles so every edge function is positive inside.
+        if area < 0 {
+            area = -area
+            x = SIMD3(x[0], x[2], x[1])
+            y = SIMD3(y[0], y[2], y[1])
+            z = SIMD3(z[0], z[2], z[1])
+            w = SIMD3(w[0], w[2], w[1])
+            verts = (v0, v2, v1)
+        }
+
+        let minX = max(0, min(fw, x.min()).rounded(.down))
+        let maxX = min(fw - 1, max(0, x.max()).rounded(.up))
+        let minY = max(0, min(fh, y.min()).rounded(.down))
+        let maxY = min(fh - 1, max(0, y.max()).rounded(.up))
+        guard minX <= maxX, minY <= maxY else { return false }
+
+        triangles.append(Triangle(
+            x: x, y: y, z: z, invW: w, area: area,
+            color: (verts.0.color * w[0], verts.1.color * w[1], verts.2.color * w[2]),
+            normal: (verts.0.normal * w[0], verts.1.normal * w[1], verts.2.normal * w[2]),
+            uv: (verts.0.uv * w[0], verts.1.uv * w[1], verts.2.uv * w[2]),
+            material: material,
+            minX: Int32(minX), minY: Int32(minY), maxX: Int32(maxX), maxY: Int32(maxY)
+        ))
+        return true
+    }
+
+    // MARK: - Rasterization
+
+    /// Shades every queued triangle into a `width * height` BGRA8 color target and Float
+    /// depth target, one tile per work item, then empties the queue.
+    mutating func flush(color: UnsafeMutableRawBufferPointer, depth: UnsafeMutableRawBufferPointer) {
+        defer { triangles.removeAll(keepingCapacity: true) }
+        let pixels = width * height
+        guard !triangles.isEmpty,
+              color.count >= pixels * 4,
+              depth.count >= pixels * MemoryLayout<Float>.size,
+              let colorBase = color.baseAddress?.assumingMemoryBound(to: UInt8.self),
+              let depthBase = depth.baseAddress?.assumingMemoryBound(to: Float.self) else { return }
+
+        let tilesX = self.tilesX
+        let tileCount = tilesX * tilesY
+        if bins.count != tileCount { bins = Array(repeating: [], count: tileCount) }
+        for i in bins.indices { bins[i].removeAll(keepingCapacity: true) }
+        let shift = Self.tileSize.trailingZeroBitCount
+        for (index, triangle) in triangles.enumerated() {
+            for ty in (Int(triangle.minY) >> shift)...(Int(triangle.maxY) >> shift) {
+                for tx in (Int(triangle.minX) >> shift)...(Int(triangle.maxX) >> shift) {
+                    bins[ty * tilesX + tx].append(Int32(index))
+                }
+            }
+        }
+
+        let width = self.width, height = self.height
+        let bins = self.bins
+        triangles.withUnsafeBufferPointer { triangles in
+            materials.withUnsafeBufferPointer { materials in
+                DispatchQueue.concurrentPerform(iterations: tileCount) { tile in
+                    guard !bins[tile].isEmpty else { return }
+                    let x0 = (tile % tilesX) * Self.tileSize
+                    let y0 = (tile / tilesX) * Self.tileSize
+                    let bounds = (minX: x0, minY: y0, maxX: min(width, x0 + Self.tileSize) - 1, maxY: min(height, y0 + Self.tileSize) - 1)
+                    for index in bins[tile] {
+                        let triangle = triangles[Int(index)]
+                        Self.rasterize(triangle, material: materials[Int(triangle.material)], tile: bounds,
+                                       size: (width, height), color: colorBase, depth: depthBase)
+                    }
+                }
+            }
+        }
+    }
+
+    private static func rasterize(_ t: Triangle,
+                                  material: Material,
+                                  tile: (minX: Int, minY: Int, maxX: Int, maxY: Int),
+                                  size: (width: Int, height: Int),
+                                  color: UnsafeMutablePointer<UInt8>,
+                                  depth: UnsafeMutablePointer<Float>) {
+        let x0 = max(Int(t.minX), tile.minX), x1 = min(Int(t.maxX), tile.maxX)
+        let y0 = max(Int(t.minY), tile.minY), y1 = min(Int(t.maxY), tile.maxY)
+        guard x0 <= x1, y0 <= y1 else { return }
+
+        // Edge i runs between the two vertices opposite vertex i: E_i(p) = A*x + B*y + C,
+        // positive inside, and E_i / area is the barycentric weight of vertex i.
+        let edge0 = edgeFunction(t.x[1], t.y[1], t.x[2], t.y[2])
+        let edge1 = edgeFunction(t.x[2], t.y[2], t.x[0], t.y[0])
+        let edge2 = edgeFunction(t.x[0], t.y[0], t.x[1], t.y[1])
+        let a = SIMD3(edge0.x, edge1.x, edge2.x)
+        let b = SIMD3(edge0.y, edge1.y, edge2.y)
+        let c = SIMD3(edge0.z, edge1.z, edge2.z)
+        // Tie-break pixels exactly on an edge so shared edges are drawn once.
+        let owns0 = a[0] > 0 || (a[0] == 0 && b[0] > 0)
+        let owns1 = a[1] > 0 || (a[1] == 0 && b[1] > 0)
+        let owns2 = a[2] > 0 || (a[2] == 0 && b[2] > 0)
+        let invArea = 1 / t.area
+        let lanes = SIMD4<Float>(0.5, 1.5, 2.5, 3.5)
+        let limit = Float(x1 + 1)
+
+        for py in y0...y1 {
+            let fy = Float(py) + 0.5
+            let row = b * fy + c
+            var px = x0
+            while px <= x1 {
+                let fx = lanes + Float(px)
+                let e0 = fx * a[0] + row[0]
+                let e1 = fx * a[1] + row[1]
+                let e2 = fx * a[2] + row[2]
+                var inside = (e0 .> 0) .| ((e0 .== 0) .& owns0)
+                inside .&= (e1 .> 0) .| ((e1 .== 0) .& owns1)
+                inside .&= (e2 .> 0) .| ((e2 .== 0) .& owns2)
+                inside .&= fx .< limit
+                if any(inside) {
+                    for lane in 0..<4 where inside[lane] {
+                        let weights = SIMD3(e0[lane], e1[lane], e2[lane]) * invArea
+                        shade(t, material: material, weights: weights, x: px + lane, y: py, size: size, color: color, depth: depth)
+                    }
+                }
+                px += 4
+            }
+        }
+    }
+
+    /// (A, B, C) of the edge from (x0, y0) to (x1, y1). Endpoints are taken in a fixed
+    /// order, so the neighbour sharing an edge gets exactly negated coefficients and
+    /// every pixel on it lands in one triangle only.
+    @inline(__always)
+    private static func edgeFunction(_ x0: Float, _ y0: Float, _ x1: Float, _ y1: Float) -> SIMD3<Float> {
+        if x0 > x1 || (x0 == x1 && y0 > y1) { return -edgeFunction(x1, y1, x0, y0) }
+        let a = y0 - y1
+        let b = x1 - x0
+        return SIMD3(a, b, -(a * x0 + b * y0))
+    }
+
+    @inline(__always)
+    private static func shade(_ t: Triangle,
+                              material: Material,
+                              weights: SIMD3<Float>,
+                              x: Int,
+                              y: Int,
+                              size: (width: Int, height: Int),
+                              color: UnsafeMutablePointer<UInt8>,
+                              depth: UnsafeMutablePointer<Float>) {
+        let pixel = y * size.width + x
+        let z = (weights * t.z).sum()
+        guard z >= 0, z <= 1 else { return }
+        if material.depthTest {
+            guard z < depth[pixel] else { return }
+            depth[pixel] = z
+        }
+        let w = 1 / (weights * t.invW).sum()
+        let vertexColor = (t.color.0 * weights[0] + t.color.1 * weights[1] + t.color.2 * weights[2]) * w
+        let base = material.constants.baseColor
+        var rgb: SIMD3<Float>
+        switch material.shading {
+        case .unlit:
+            rgb = vertexColor * SIMD3(base.x, base.y, base.z)
+        case .lit:
+            let n = (t.normal.0 * weights[0] + t.normal.1 * weights[1] + t.normal.2 * weights[2]) * w
+            let length = (n * n).sum().squareRoot()
+            let ndotl = length > 0 ? max((n * material.light).sum() / length, 0) : 0
+            rgb = vertexColor * (0.15 + 0.85 * ndotl) * SIMD3(base.x, base.y, base.z)
+        }
+        if let texture = material.texture {
+            let uv: SIMD2<Float>
+            switch texture.mapping {
+            case .texcoord:
+                uv = (t.uv.0 * weights[0] + t.uv.1 * weights[1] + t.uv.2 * weights[2]) * w
+            case .screen:
+                uv = SIMD2(Float(x) / Float(size.width), Float(y) / Float(size.height))
+            }
+            rgb *= sample(texture, uv)
+        }
+        let offset = pixel * 4
+        color[offset + 0] = quantize(rgb.z)
+        color[offset + 1] = quantize(rgb.y)
+        color[offset + 2] = quantize(rgb.x)
+        color[offset + 3] = 255
+    }
+
+    private static func sample(_ texture: Texture, _ uv: SIMD2<Float>) -> SIMD3<Float> {
+        guard texture.width > 0, texture.height > 0, texture.texels.count >= texture.width * texture.height * 4 else {
+            return SIMD3(1, 1, 1)
+        }
+        let u = uv.x - uv.x.rounded(.down), v = uv.y - uv.y.rounded(.down)
+        let x = min(texture.width - 1, Int(u * Float(texture.width)))
+        let y = min(texture.height - 1, Int(v * Float(texture.height)))
+        let offset = (y * texture.width + x) * 4
+        let r = Float(texture.texels[offset + (texture.isBGRA ? 2 : 0)])
+        let g = Float(texture.texels[offset + 1])
+        let b = Float(texture.texels[offset + (texture.isBGRA ? 0 : 2)])
+        return SIMD3(r, g, b) / 255
+    }
+
+    @inline(__always)
+    private static func quantize(_ value: Float) -> UInt8 {
+        guard value.isFinite else { return 0 }
+        return UInt8(min(max(value, 0), 1) * 255 + 0.5)
+    }
+}
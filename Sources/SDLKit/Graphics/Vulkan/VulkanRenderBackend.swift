@@ -1,6 +1,7 @@
 // Linux Vulkan backend scaffold: creates a VkInstance with SDL-required extensions
 // and an SDL-created VkSurfaceKHR. Other operations are currently delegated to the
-// stub core until full Vulkan rendering is implemented.
+// stub core until full Vulkan rendering is implemented. Offscreen backends skip the
+// surface and swapchain and render into a ring of images they own.
 
 #if os(Linux) && canImport(VulkanMinimal)
 import Foundation
@@ -24,8 +25,9 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
     }()
     private static var capturedValidationMessages: [String] = []
 
-    private let window: SDLWindow
-    private let surface: RenderSurface
+    /// Nil for offscreen backends, which have no surface, swapchain or present queue of their own.
+    private let window: SDLWindow?
+    private let surface: RenderSurface?
     private var core: StubRenderBackendCore
     public var deviceEventHandler: RenderBackendDeviceEventHandler?
 
@@ -43,10 +45,18 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
     private var graphicsQueue: VkQueue? = nil
     private var presentQueue: VkQueue? = nil
 
-    // Swapchain and render targets
+    // Swapchain and render targets. Offscreen backends keep one color image per frame in
+    // flight in `swapchainImages`, backed by `offscreenColorMemory`, and leave `swapchain` nil.
     private var swapchain: VkSwapchainKHR? = nil
     private var swapchainImages: [VkImage?] = []
     private var swapchainImageViews: [VkImageView?] = []
+    private var offscreenColorMemory: [VkDeviceMemory?] = []
+    private var offscreenSize: (width: UInt32, height: UInt32) = (1, 1)
+    private var isOffscreen: Bool { window == nil }
+    /// Where the render pass leaves color targets: ready to present, or ready to copy out.
+    private var colorTargetFinalLayout: VkImageLayout {
+        isOffscreen ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+    }
     private var renderPass: VkRenderPass? = nil
     private var framebuffers: [VkFramebuffer?] = []
     private var colorFormat: VkFormat = VK_FORMAT_B8G8R8A8_UNORM
@@ -68,6 +78,14 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
     private var maxFramesInFlight: Int = 2
     private var currentFrame: Int = 0
     private var frameActive: Bool = false
+    private var bindTracker = RenderBindTracker()
+    private let payloadArena = FrameArena()
+
+    // GPU timestamps: one query range per frame in flight plus an out-of-frame range.
+    private var timestampQueryPool: VkQueryPool? = nil
+    private var timestampRing = GPUTimestampRing(frameSlots: 2)
+    private var timestampPeriod: Double = 1
+    private var timestampValidBits: Int = 0
     private enum DeviceResetState {
         case healthy
         case recovering(reason: String)
@@ -98,7 +116,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         var descriptorPools: [VkDescriptorPool?]
         var descriptorBindings: [DescriptorBindingInfo]
     }
-    private var pipelines: [PipelineHandle: PipelineResource] = [:]
+    private var pipelines = SlotMap<PipelineHandle, PipelineResource>()
     private var builtinPipeline: PipelineHandle? = nil
 
     private struct ComputePipelineResource {
@@ -109,7 +127,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         var descriptorPool: VkDescriptorPool?
         var module: ComputeShaderModule
     }
-    private var computePipelines: [ComputePipelineHandle: ComputePipelineResource] = [:]
+    private var computePipelines = SlotMap<ComputePipelineHandle, ComputePipelineResource>()
 
     private struct PendingComputeDescriptor {
         var pool: VkDescriptorPool?
@@ -121,8 +139,14 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         var fence: VkFence?
         var commandBuffer: VkCommandBuffer?
         var descriptor: PendingComputeDescriptor?
+        var timestamps: GPUTimestampRing.Scope?
+        /// Identifies command-list submissions to their `ComputeFence`; 0 for single dispatches.
+        var serial: UInt64 = 0
+        /// Descriptor pool owned by a command-list submission, destroyed with it.
+        var transientPool: VkDescriptorPool? = nil
     }
     private var pendingOutOfFrameComputeSubmissions: [PendingComputeSubmission] = []
+    private var computeSubmissionSerial: UInt64 = 0
 
     private struct MeshResource {
         let vertexBuffer: BufferHandle
@@ -131,7 +155,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         let indexCount: Int
         let indexFormat: IndexFormat
     }
-    private var meshes: [MeshHandle: MeshResource] = [:]
+    private var meshes = SlotMap<MeshHandle, MeshResource>()
 
     // Builtin vertex buffer (pos.xyz + color.xyz)
     private var builtinVertexBuffer: VkBuffer? = nil
@@ -148,14 +172,33 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
     private var lastCaptureBytesPerRow: Int = 0
     private var lastCaptureSize: (width: Int, height: Int) = (0, 0)
 
+    // Asynchronous readbacks: persistently mapped staging buffers and the tokens waiting on them.
+    private struct ReadbackStagingBuffer {
+        var buffer: VkBuffer?
+        var memory: VkDeviceMemory?
+        var mapped: UnsafeMutableRawPointer?
+    }
+    private struct InFlightReadback {
+        var fence: VkFence?
+        var commandBuffer: VkCommandBuffer?
+        /// False for the frame fence, which the frame loop owns and reuses.
+        var ownsFence: Bool
+        var staging: ReadbackStagingPool<ReadbackStagingBuffer>.Entry
+    }
+    private var readbackStaging = ReadbackStagingPool<ReadbackStagingBuffer>()
+    private var inFlightReadbacks: [UInt64: InFlightReadback] = [:]
+    private var readbackSerial: UInt64 = 0
+    private var pendingReadbacks = PendingReadbacks()
+    private var pendingFrameCapture: FrameCaptureRequest?
+
     private struct BufferResource {
         var buffer: VkBuffer?
         var memory: VkDeviceMemory?
         var length: Int
         var usage: BufferUsage
-        var shadowCopy: Data?
     }
-    private var buffers: [BufferHandle: BufferResource] = [:]
+    private var buffers = SlotMap<BufferHandle, BufferResource>()
+    private let recoveryLedger = ResourceRecoveryLedger(component: "SDLKit.Graphics.Vulkan")
 
     private struct TextureResource {
         var descriptor: TextureDescriptor
@@ -166,9 +209,8 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         var layout: VkImageLayout
         var format: VkFormat
         var aspectMask: UInt32
-        var shadowMipData: [Data]
     }
-    private var textures: [TextureHandle: TextureResource] = [:]
+    private var textures = SlotMap<TextureHandle, TextureResource>()
     private var fallbackWhiteTexture: TextureHandle? = nil
     private var supportsStorageImages: Bool = false
 
@@ -176,12 +218,11 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         var descriptor: SamplerDescriptor
         var sampler: VkSampler?
     }
-    private var samplers: [SamplerHandle: SamplerResource] = [:]
+    private var samplers = SlotMap<SamplerHandle, SamplerResource>()
 
     private struct BufferSnapshot {
         var length: Int
         var usage: BufferUsage
-        var shadowCopy: Data?
     }
 
     private struct TextureSnapshot {
@@ -189,7 +230,6 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         var layout: VkImageLayout
         var format: VkFormat
         var aspectMask: UInt32
-        var shadowMipData: [Data]
     }
 
     private struct SamplerSnapshot {
@@ -211,6 +251,19 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         #endif
     }
 
+    /// Creates a backend without a window: the device is created without a surface and frames
+    /// render into a ring of offscreen color/depth targets of `width`x`height` that are never
+    /// presented. Captures and readbacks work as they do for a windowed backend.
+    public init(offscreenWidth width: Int, height: Int) throws {
+        self.window = nil
+        self.surface = nil
+        self.core = try StubRenderBackendCore(kind: .vulkan, width: width, height: height)
+        self.offscreenSize = (UInt32(width), UInt32(height))
+
+        try initializeVulkan()
+        try initializeDeviceAndQueues()
+    }
+
     deinit {
         #if canImport(CVulkan)
         releaseVulkanDeviceResources()
@@ -223,8 +276,10 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
 
     // MARK: - RenderBackend
     public func beginFrame() throws {
+        let profile = SDLProfiler.begin("render.beginFrame")
+        defer { profile.end() }
         #if canImport(CVulkan)
-        guard let dev = device, let sc = swapchain, let gq = graphicsQueue else {
+        guard let dev = device, let gq = graphicsQueue, isOffscreen || swapchain != nil else {
             throw AgentError.internalError("Vulkan device/swapchain not initialized")
         }
         switch deviceResetState {
@@ -243,22 +298,31 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         if var fence = inFlightFences[currentFrame] {
             withUnsafePointer(to: &fence) { fptr in
                 _ = vkWaitForFences(dev, 1, fptr, VK_TRUE, UInt64.max)
+            }
+            // Frame captures landed on this fence must resolve before it is reset.
+            pendingReadbacks.pump()
+            withUnsafePointer(to: &fence) { fptr in
                 _ = vkResetFences(dev, 1, fptr)
             }
             resetDescriptorPoolsForFrame(currentFrame)
             releasePendingComputeDescriptors(for: currentFrame)
         }
 
-        // Acquire next image
-        var imgIndex: UInt32 = 0
-        let acquireRes = vkAcquireNextImageKHR(dev, sc, UInt64.max, imageAvailableSemaphores[currentFrame], nil, &imgIndex)
-        if acquireRes == VK_ERROR_OUT_OF_DATE_KHR {
-            try recreateSwapchain(width: surfaceExtent.width, height: surfaceExtent.height)
-            return try beginFrame() // retry once
-        } else if acquireRes != VK_SUCCESS && acquireRes != VK_SUBOPTIMAL_KHR {
-            throw AgentError.internalError("vkAcquireNextImageKHR failed (res=\(acquireRes))")
+        if let sc = swapchain {
+            // Acquire next image
+            var imgIndex: UInt32 = 0
+            let acquireRes = vkAcquireNextImageKHR(dev, sc, UInt64.max, imageAvailableSemaphores[currentFrame], nil, &imgIndex)
+            if acquireRes == VK_ERROR_OUT_OF_DATE_KHR {
+                try recreateSwapchain(width: surfaceExtent.width, height: surfaceExtent.height)
+                return try beginFrame() // retry once
+            } else if acquireRes != VK_SUCCESS && acquireRes != VK_SUBOPTIMAL_KHR {
+                throw AgentError.internalError("vkAcquireNextImageKHR failed (res=\(acquireRes))")
+            }
+            currentImageIndex = imgIndex
+        } else {
+            // Offscreen targets are indexed by frame slot, so the frame fence guards reuse.
+            currentImageIndex = UInt32(currentFrame)
         }
-        currentImageIndex = imgIndex
 
         // Begin command buffer
         guard let cmd = commandBuffers[currentFrame] else {
@@ -268,6 +332,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO
         beginInfo.flags = UInt32(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT)
         _ = withUnsafePointer(to: beginInfo) { ptr in vkBeginCommandBuffer(cmd, ptr) }
+        beginTimestampFrame(cmd)
 
         // Begin render pass
         guard let rp = renderPass, Int(currentImageIndex) < framebuffers.count, let fb = framebuffers[Int(currentImageIndex)] else {
@@ -296,6 +361,8 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         var scissor = VkRect2D(offset: VkOffset2D(x: 0, y: 0), extent: surfaceExtent)
         withUnsafePointer(to: &scissor) { sptr in vkCmdSetScissor(cmd, 0, 1, sptr) }
 
+        bindTracker.beginFrame()
+        payloadArena.reset()
         frameActive = true
         #else
         try core.beginFrame()
@@ -303,6 +370,8 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
     }
 
     public func endFrame() throws {
+        let profile = SDLProfiler.begin("render.endFrame")
+        defer { profile.end() }
         #if canImport(CVulkan)
         guard frameActive, let dev = device, let gq = graphicsQueue, let pq = presentQueue else {
             throw AgentError.internalError("endFrame called without active frame")
@@ -310,12 +379,29 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         defer { frameActive = false }
         guard let cmd = commandBuffers[currentFrame] else { throw AgentError.internalError("Missing command buffer") }
         vkCmdEndRenderPass(cmd)
+        for query in timestampRing.endFrame() {
+            writeTimestamp(cmd, query: query, stage: VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT)
+        }
+        core.gpuTimings.noteDroppedScopes(timestampRing.takeDroppedScopes())
+
+        // Frame captures enqueued this frame copy into pooled staging and land on the frame fence.
+        var frameCapture: (request: FrameCaptureRequest, staging: ReadbackStagingPool<ReadbackStagingBuffer>.Entry)? = nil
+        if let request = pendingFrameCapture {
+            pendingFrameCapture = nil
+            let length = Int(surfaceExtent.width) * Int(surfaceExtent.height) * 4
+            do {
+                frameCapture = (request, try readbackStaging.acquire(length: length) { try makeReadbackStaging(capacity: $0) })
+            } catch {
+                request.error = error
+            }
+        }
+        let captureExtent = surfaceExtent
 
         // Optional capture: copy swapchain image to host-visible buffer
-        if captureRequested, let scImages = swapchainImages[Int(currentImageIndex)], let dev = device {
+        if captureRequested || frameCapture != nil, let scImages = swapchainImages[Int(currentImageIndex)], let dev = device {
             let pixelSize: VkDeviceSize = 4
             let bytesNeeded = VkDeviceSize(surfaceExtent.width) * VkDeviceSize(surfaceExtent.height) * pixelSize
-            if captureBuffer == nil || captureBufferSize < bytesNeeded {
+            if captureRequested && (captureBuffer == nil || captureBufferSize < bytesNeeded) {
                 if let oldB = captureBuffer { vkDestroyBuffer(dev, oldB, nil); captureBuffer = nil }
                 if let oldM = captureMemory { vkFreeMemory(dev, oldM, nil); captureMemory = nil }
                 var buf: VkBuffer? = nil
@@ -326,12 +412,12 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
                 captureBufferSize = bytesNeeded
             }
 
-            // Barrier: PRESENT -> TRANSFER_SRC
+            // Barrier: PRESENT -> TRANSFER_SRC (offscreen targets already end the pass in TRANSFER_SRC)
             var barrier = VkImageMemoryBarrier()
             barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER
             barrier.srcAccessMask = 0
             barrier.dstAccessMask = UInt32(VK_ACCESS_TRANSFER_READ_BIT)
-            barrier.oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+            barrier.oldLayout = colorTargetFinalLayout
             barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
             barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED
             barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED
@@ -349,18 +435,32 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             region.imageSubresource = VkImageSubresourceLayers(aspectMask: UInt32(VK_IMAGE_ASPECT_COLOR_BIT), mipLevel: 0, baseArrayLayer: 0, layerCount: 1)
             region.imageOffset = VkOffset3D(x: 0, y: 0, z: 0)
             region.imageExtent = VkExtent3D(width: surfaceExtent.width, height: surfaceExtent.height, depth: 1)
-            withUnsafePointer(to: &region) { rptr in
-                vkCmdCopyImageToBuffer(cmd, scImages, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, captureBuffer, 1, rptr)
+            if captureRequested {
+                withUnsafePointer(to: &region) { rptr in
+                    vkCmdCopyImageToBuffer(cmd, scImages, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, captureBuffer, 1, rptr)
+                }
+            }
+            if let frameCapture {
+                withUnsafePointer(to: &region) { rptr in
+                    vkCmdCopyImageToBuffer(cmd, scImages, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, frameCapture.staging.allocation.buffer, 1, rptr)
+                }
             }
 
             // Barrier: TRANSFER_SRC -> PRESENT
             barrier.srcAccessMask = UInt32(VK_ACCESS_TRANSFER_READ_BIT)
             barrier.dstAccessMask = 0
             barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-            barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+            barrier.newLayout = colorTargetFinalLayout
             withUnsafePointer(to: &barrier) { bptr in
                 vkCmdPipelineBarrier(cmd, UInt32(VK_PIPELINE_STAGE_TRANSFER_BIT), UInt32(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT), 0, 0, nil, 0, nil, 1, bptr)
             }
+            if frameCapture != nil {
+                recordReadbackHostBarrier(cmd)
+            }
+        } else if let pending = frameCapture {
+            pending.request.error = AgentError.internalError("Swapchain image unavailable for frame capture")
+            recycleReadbackStaging(pending.staging)
+            frameCapture = nil
         }
         _ = vkEndCommandBuffer(cmd)
 
@@ -371,12 +471,14 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         var cmdLocal = cmd
         var submit = VkSubmitInfo()
         submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO
-        submit.waitSemaphoreCount = 1
+        // Offscreen frames have no acquire to wait on and no present to signal.
+        let presents = swapchain != nil
+        submit.waitSemaphoreCount = presents ? 1 : 0
         withUnsafePointer(to: &waitSemaphore) { ws in submit.pWaitSemaphores = ws }
         submit.pWaitDstStageMask = &waitStageMask
         submit.commandBufferCount = 1
         withUnsafePointer(to: &cmdLocal) { cp in submit.pCommandBuffers = cp }
-        submit.signalSemaphoreCount = 1
+        submit.signalSemaphoreCount = presents ? 1 : 0
         withUnsafePointer(to: &signalSemaphore) { sp in submit.pSignalSemaphores = sp }
 
 #if DEBUG
@@ -386,36 +488,54 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         }
 #endif
         let submitResult = withUnsafePointer(to: submit) { ptr in vkQueueSubmit(gq, 1, ptr, inFlightFences[currentFrame]) }
+        if submitResult != VK_SUCCESS, let frameCapture {
+            frameCapture.request.error = AgentError.internalError("Frame submission failed before the capture landed (res=\(submitResult))")
+            recycleReadbackStaging(frameCapture.staging)
+        }
         if submitResult == VK_ERROR_DEVICE_LOST {
             try handleDeviceLoss(context: "vkQueueSubmit", result: submitResult)
         } else if submitResult != VK_SUCCESS {
             throw AgentError.internalError("vkQueueSubmit failed (res=\(submitResult))")
         }
+        if let frameCapture {
+            let width = Int(captureExtent.width), height = Int(captureExtent.height)
+            let serial = registerReadback(InFlightReadback(fence: inFlightFences[currentFrame], commandBuffer: nil,
+                                                           ownsFence: false, staging: frameCapture.staging))
+            frameCapture.request.isLanded = { [weak self] in self?.isReadbackComplete(serial) ?? true }
+            frameCapture.request.land = { [weak self] in
+                guard let self else { throw AgentError.deviceLost("Vulkan backend released before the frame capture landed") }
+                return try self.completeReadback(serial) { mapped in
+                    GoldenImageCapture(width: width, height: height, bytesPerRow: width * 4, layout: .bgra8Unorm,
+                                       data: Data(bytes: mapped, count: width * height * 4))
+                }
+            }
+        }
 
-        // Present
-        var pi = VkPresentInfoKHR()
-        pi.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR
-        pi.waitSemaphoreCount = 1
-        withUnsafePointer(to: &signalSemaphore) { sp in pi.pWaitSemaphores = sp }
-        pi.swapchainCount = 1
-        guard let scNonOpt = swapchain else { throw AgentError.internalError("Swapchain missing") }
-        var scLocal = scNonOpt
-        withUnsafePointer(to: &scLocal) { scPtr in pi.pSwapchains = scPtr }
-        var imageIndexCopy = currentImageIndex
-        withUnsafePointer(to: &imageIndexCopy) { idxPtr in pi.pImageIndices = idxPtr }
+        // Present (offscreen frames stay in their target for capture)
+        if let scNonOpt = swapchain {
+            var pi = VkPresentInfoKHR()
+            pi.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR
+            pi.waitSemaphoreCount = 1
+            withUnsafePointer(to: &signalSemaphore) { sp in pi.pWaitSemaphores = sp }
+            pi.swapchainCount = 1
+            var scLocal = scNonOpt
+            withUnsafePointer(to: &scLocal) { scPtr in pi.pSwapchains = scPtr }
+            var imageIndexCopy = currentImageIndex
+            withUnsafePointer(to: &imageIndexCopy) { idxPtr in pi.pImageIndices = idxPtr }
 #if DEBUG
-        if debugSimulatedDeviceLossRequested && !debugDeviceLossInProgress {
-            debugSimulatedDeviceLossRequested = false
-            try handleDeviceLoss(context: "debugSimulateDeviceLoss(present)", result: VK_ERROR_DEVICE_LOST)
-        }
+            if debugSimulatedDeviceLossRequested && !debugDeviceLossInProgress {
+                debugSimulatedDeviceLossRequested = false
+                try handleDeviceLoss(context: "debugSimulateDeviceLoss(present)", result: VK_ERROR_DEVICE_LOST)
+            }
 #endif
-        let presentRes = withUnsafePointer(to: pi) { ptr in vkQueuePresentKHR(pq, ptr) }
-        if presentRes == VK_ERROR_OUT_OF_DATE_KHR || presentRes == VK_SUBOPTIMAL_KHR {
-            try recreateSwapchain(width: surfaceExtent.width, height: surfaceExtent.height)
-        } else if presentRes == VK_ERROR_DEVICE_LOST {
-            try handleDeviceLoss(context: "vkQueuePresentKHR", result: presentRes)
-        } else if presentRes != VK_SUCCESS {
-            throw AgentError.internalError("vkQueuePresentKHR failed (res=\(presentRes))")
+            let presentRes = withUnsafePointer(to: pi) { ptr in vkQueuePresentKHR(pq, ptr) }
+            if presentRes == VK_ERROR_OUT_OF_DATE_KHR || presentRes == VK_SUBOPTIMAL_KHR {
+                try recreateSwapchain(width: surfaceExtent.width, height: surfaceExtent.height)
+            } else if presentRes == VK_ERROR_DEVICE_LOST {
+                try handleDeviceLoss(context: "vkQueuePresentKHR", result: presentRes)
+            } else if presentRes != VK_SUCCESS {
+                throw AgentError.internalError("vkQueuePresentKHR failed (res=\(presentRes))")
+            }
         }
 
         if captureRequested {
@@ -453,7 +573,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         core.resize(width: width, height: height)
         #if canImport(CVulkan)
         if device != nil {
-            try recreateSwapchain(width: UInt32(max(1, width)), height: UInt32(max(1, height)))
+            try recreateRenderTargets(width: UInt32(max(1, width)), height: UInt32(max(1, height)))
         }
         #endif
     }
@@ -509,6 +629,10 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             do {
                 try resetVulkanDevice()
                 deviceEventHandler?(.didReset)
+                let discarded = recoveryLedger.takeDiscarded()
+                if !discarded.isEmpty {
+                    deviceEventHandler?(.resourcesDiscarded(discarded))
+                }
                 SDLLogger.info("SDLKit.Graphics.Vulkan", "Device reset completed after loss: \(finalReason)")
                 throw AgentError.deviceLost(finalReason)
             } catch {
@@ -534,8 +658,8 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         #if canImport(CVulkan)
         SDLLogger.warn("SDLKit.Graphics.Vulkan", "Attempting Vulkan device reset")
 
-        let bufferSnapshots = buffers.mapValues { BufferSnapshot(length: $0.length, usage: $0.usage, shadowCopy: $0.shadowCopy) }
-        let textureSnapshots = textures.mapValues { TextureSnapshot(descriptor: $0.descriptor, layout: $0.layout, format: $0.format, aspectMask: $0.aspectMask, shadowMipData: $0.shadowMipData) }
+        let bufferSnapshots = buffers.mapValues { BufferSnapshot(length: $0.length, usage: $0.usage) }
+        let textureSnapshots = textures.mapValues { TextureSnapshot(descriptor: $0.descriptor, layout: $0.layout, format: $0.format, aspectMask: $0.aspectMask) }
         let samplerSnapshots = samplers.mapValues { SamplerSnapshot(descriptor: $0.descriptor) }
         let meshSnapshots = meshes
         let previousFallback = fallbackWhiteTexture
@@ -568,13 +692,17 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             try ensureCommandPoolAndSync()
 
             let windowSize: (UInt32, UInt32)
-            if let info = try? window.info() {
-                windowSize = (UInt32(max(1, info.width)), UInt32(max(1, info.height)))
+            if let window {
+                if let info = try? window.info() {
+                    windowSize = (UInt32(max(1, info.width)), UInt32(max(1, info.height)))
+                } else {
+                    windowSize = (UInt32(max(1, window.config.width)), UInt32(max(1, window.config.height)))
+                }
             } else {
-                windowSize = (UInt32(max(1, window.config.width)), UInt32(max(1, window.config.height)))
+                windowSize = (offscreenSize.width, offscreenSize.height)
             }
             if windowSize.0 != surfaceExtent.width || windowSize.1 != surfaceExtent.height {
-                try recreateSwapchain(width: windowSize.0, height: windowSize.1)
+                try recreateRenderTargets(width: windowSize.0, height: windowSize.1)
             }
 
             if let freshFallback = fallbackWhiteTexture {
@@ -599,6 +727,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
 
         if let error = resetError {
             releaseVulkanDeviceResources()
+            recoveryLedger.releaseAll()
             buffers.removeAll()
             textures.removeAll()
             samplers.removeAll()
@@ -633,12 +762,19 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
     #endif
 
     public func createBuffer(bytes: UnsafeRawPointer?, length: Int, usage: BufferUsage) throws -> BufferHandle {
+        try createBuffer(bytes: bytes, length: length, usage: usage, recovery: .shadowCopy)
+    }
+
+    public func createBuffer(bytes: UnsafeRawPointer?, length: Int, usage: BufferUsage, recovery: ResourceRecoveryPolicy) throws -> BufferHandle {
         #if canImport(CVulkan)
         guard length > 0 else { throw AgentError.invalidArgument("Buffer length must be > 0") }
-        let handle = BufferHandle()
-        let shadowCopy: Data? = bytes.map { Data(bytes: $0, count: length) }
-        let resource = try buildBufferResource(length: length, usage: usage, initialData: shadowCopy)
-        buffers[handle] = resource
+        // Upload straight from the caller's bytes; a host copy is only made if the policy keeps one.
+        let initialData: Data? = bytes.map { Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: $0), count: length, deallocator: .none) }
+        let resource = try buildBufferResource(length: length, usage: usage, initialData: initialData)
+        let handle = buffers.insert(resource)
+        if let bytes {
+            recoveryLedger.track(.buffer(handle), byteCount: length, policy: recovery) { [Data(bytes: bytes, count: length)] }
+        }
         return handle
         #else
         return try core.createBuffer(bytes: bytes, length: length, usage: usage)
@@ -711,7 +847,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             }
         }
 
-        return BufferResource(buffer: buffer, memory: memory, length: length, usage: usage, shadowCopy: initialData)
+        return BufferResource(buffer: buffer, memory: memory, length: length, usage: usage)
     }
     #endif
 
@@ -757,13 +893,20 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         return String(format: "%016llx", hash)
     }
     public func createTexture(descriptor: TextureDescriptor, initialData: TextureInitialData?) throws -> TextureHandle {
+        try createTexture(descriptor: descriptor, initialData: initialData, recovery: .shadowCopy)
+    }
+
+    public func createTexture(descriptor: TextureDescriptor, initialData: TextureInitialData?, recovery: ResourceRecoveryPolicy) throws -> TextureHandle {
         #if canImport(CVulkan)
         guard descriptor.width > 0, descriptor.height > 0 else {
             throw AgentError.invalidArgument("Texture dimensions must be greater than zero")
         }
-        let handle = TextureHandle()
-        let resource = try buildTextureResource(descriptor: descriptor, initialMipData: initialData?.mipLevelData ?? [])
-        textures[handle] = resource
+        let mipData = initialData?.mipLevelData ?? []
+        let resource = try buildTextureResource(descriptor: descriptor, initialMipData: mipData)
+        let handle = textures.insert(resource)
+        if !mipData.isEmpty {
+            recoveryLedger.track(.texture(handle), byteCount: mipData.reduce(0) { $0 + $1.count }, policy: recovery) { mipData }
+        }
         SDLLogger.debug("SDLKit.Graphics.Vulkan", "createTexture id=\(handle.rawValue) size=\(descriptor.width)x\(descriptor.height) format=\(descriptor.format.rawValue)")
         return handle
         #else
@@ -902,23 +1045,24 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             sampler: sampler,
             layout: finalLayout,
             format: vkFormat,
-            aspectMask: aspectMask,
-            shadowMipData: initialMipData
+            aspectMask: aspectMask
         )
     }
 
-    private func recreateBuffers(from snapshots: [BufferHandle: BufferSnapshot]) throws {
+    private func recreateBuffers(from snapshots: SlotMap<BufferHandle, BufferSnapshot>) throws {
         buffers.removeAll(keepingCapacity: true)
         for (handle, snapshot) in snapshots {
-            let resource = try buildBufferResource(length: snapshot.length, usage: snapshot.usage, initialData: snapshot.shadowCopy)
+            let contents = recoveryLedger.recoveryContents(for: .buffer(handle))?.first
+            let resource = try buildBufferResource(length: snapshot.length, usage: snapshot.usage, initialData: contents)
             buffers[handle] = resource
         }
     }
 
-    private func recreateTextures(from snapshots: [TextureHandle: TextureSnapshot]) throws {
-        var rebuilt: [TextureHandle: TextureResource] = [:]
+    private func recreateTextures(from snapshots: SlotMap<TextureHandle, TextureSnapshot>) throws {
+        textures.removeAll(keepingCapacity: true)
         for (handle, snapshot) in snapshots {
-            var resource = try buildTextureResource(descriptor: snapshot.descriptor, initialMipData: snapshot.shadowMipData)
+            let contents = recoveryLedger.recoveryContents(for: .texture(handle)) ?? []
+            var resource = try buildTextureResource(descriptor: snapshot.descriptor, initialMipData: contents)
             if let image = resource.image, resource.layout != snapshot.layout {
                 let mipLevels = Int(max(1, snapshot.descriptor.mipLevels))
                 try transitionImageLayout(image: image, aspectMask: snapshot.aspectMask, mipLevels: mipLevels, oldLayout: resource.layout, newLayout: snapshot.layout)
@@ -928,12 +1072,11 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             }
             resource.format = snapshot.format
             resource.aspectMask = snapshot.aspectMask
-            rebuilt[handle] = resource
+            textures[handle] = resource
         }
-        textures = rebuilt
     }
 
-    private func recreateSamplers(from snapshots: [SamplerHandle: SamplerSnapshot]) throws {
+    private func recreateSamplers(from snapshots: SlotMap<SamplerHandle, SamplerSnapshot>) throws {
         samplers.removeAll(keepingCapacity: true)
         for (handle, snapshot) in snapshots {
             let sampler = try allocateSampler(descriptor: snapshot.descriptor)
@@ -942,12 +1085,16 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
     }
 #endif
 
+    public func setRecoveryPolicy(_ policy: ResourceRecoveryPolicy, for handle: ResourceHandle) throws {
+        #if canImport(CVulkan)
+        try recoveryLedger.setPolicy(policy, for: handle)
+        #endif
+    }
+
     public func createSampler(descriptor: SamplerDescriptor) throws -> SamplerHandle {
         #if canImport(CVulkan)
         let sampler = try allocateSampler(descriptor: descriptor)
-        let handle = SamplerHandle()
-        samplers[handle] = SamplerResource(descriptor: descriptor, sampler: sampler)
-        return handle
+        return samplers.insert(SamplerResource(descriptor: descriptor, sampler: sampler))
         #else
         return try core.createSampler(descriptor: descriptor)
         #endif
@@ -992,6 +1139,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         let meshCount: Int
         let graphicsPipelineCount: Int
         let computePipelineCount: Int
+        let recovery: ResourceRecoveryLedger.Stats
     }
 
     internal func debugResourceInventory() -> DebugResourceInventory {
@@ -1002,7 +1150,8 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             samplerCount: samplers.count,
             meshCount: meshes.count,
             graphicsPipelineCount: pipelines.count,
-            computePipelineCount: computePipelines.count
+            computePipelineCount: computePipelines.count,
+            recovery: recoveryLedger.stats
         )
         #else
         return DebugResourceInventory(
@@ -1011,7 +1160,8 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             samplerCount: 0,
             meshCount: 0,
             graphicsPipelineCount: 0,
-            computePipelineCount: 0
+            computePipelineCount: 0,
+            recovery: ResourceRecoveryLedger.Stats()
         )
         #endif
     }
@@ -1042,19 +1192,13 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             }
         }
 
-        let handle = core.registerMesh(vertexBuffer: vertexBuffer,
-                                        vertexCount: vertexCount,
-                                        indexBuffer: indexBuffer,
-                                        indexCount: indexCount,
-                                        indexFormat: indexFormat)
-        meshes[handle] = MeshResource(
+        return meshes.insert(MeshResource(
             vertexBuffer: vertexBuffer,
             vertexCount: vertexCount,
             indexBuffer: indexBuffer,
             indexCount: indexCount,
             indexFormat: indexFormat
-        )
-        return handle
+        ))
         #else
         return core.registerMesh(vertexBuffer: vertexBuffer,
                                   vertexCount: vertexCount,
@@ -1065,6 +1209,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
     }
     public func destroy(_ handle: ResourceHandle) {
         #if canImport(CVulkan)
+        recoveryLedger.release(handle)
         switch handle {
         case .buffer(let h):
             if let res = buffers.removeValue(forKey: h), let dev = device {
@@ -1207,9 +1352,8 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         }
 
         // Shader modules
-        let vsURL = try module.artifacts.requireSPIRVVertex(for: module.id)
-        let fsURL = module.artifacts.spirvFragment
-        let vsData = try Data(contentsOf: vsURL)
+        let vsData = try module.artifacts.requireSPIRVVertex(for: module.id)
+        let fsData = try module.artifacts.spirvFragmentData(for: module.id)
         var vsModule: VkShaderModule? = nil
         var fsModule: VkShaderModule? = nil
         try vsData.withUnsafeBytes { bytes in
@@ -1220,8 +1364,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             let r = withUnsafePointer(to: smi) { ptr in vkCreateShaderModule(dev, ptr, nil, &vsModule) }
             if r != VK_SUCCESS || vsModule == nil { throw AgentError.internalError("vkCreateShaderModule(VS) failed (res=\(r))") }
         }
-        if let fsURL {
-            let fsData = try Data(contentsOf: fsURL)
+        if let fsData {
             try fsData.withUnsafeBytes { bytes in
                 var smi = VkShaderModuleCreateInfo()
                 smi.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO
@@ -1451,18 +1594,18 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         if let m = vsModule { vkDestroyShaderModule(dev, m, nil) }
         if let m = fsModule { vkDestroyShaderModule(dev, m, nil) }
 
-        let handle = PipelineHandle()
-        let resource = PipelineResource(
-            handle: handle,
-            pipelineLayout: layout,
-            pipeline: pipeline,
-            vertexStride: UInt32(desc.vertexLayout.stride),
-            module: module,
-            descriptorSetLayout: descriptorSetLayout,
-            descriptorPools: descriptorPools,
-            descriptorBindings: descriptorBindings
-        )
-        pipelines[handle] = resource
+        let handle = pipelines.insert { handle in
+            PipelineResource(
+                handle: handle,
+                pipelineLayout: layout,
+                pipeline: pipeline,
+                vertexStride: UInt32(desc.vertexLayout.stride),
+                module: module,
+                descriptorSetLayout: descriptorSetLayout,
+                descriptorPools: descriptorPools,
+                descriptorBindings: descriptorBindings
+            )
+        }
         if builtinPipeline == nil { builtinPipeline = handle }
         shouldCleanupDescriptors = false
         return handle
@@ -1472,6 +1615,8 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
     }
 
     public func draw(mesh: MeshHandle, pipeline: PipelineHandle, bindings: BindingSet, transform: float4x4) throws {
+        let profile = SDLProfiler.begin("render.draw")
+        defer { profile.end() }
         #if canImport(CVulkan)
         guard frameActive, let cmd = commandBuffers[currentFrame] else {
             throw AgentError.internalError("draw called outside of beginFrame/endFrame")
@@ -1481,10 +1626,12 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         }
         guard let pipe = resource.pipeline else { throw AgentError.internalError("Pipeline incomplete") }
         guard let dev = device else { throw AgentError.internalError("Vulkan device not ready") }
-        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe)
+        if bindTracker.needsPipeline(pipeline) {
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe)
+        }
         _ = transform
-        // Bind descriptor sets if required
-        if !resource.descriptorBindings.isEmpty {
+        // Bind descriptor sets if required; identical bindings under the same pipeline reuse the bound set.
+        if !resource.descriptorBindings.isEmpty && bindTracker.needsResources(bindings) {
             guard currentFrame < resource.descriptorPools.count, let pool = resource.descriptorPools[currentFrame] else {
                 throw AgentError.internalError("Descriptor pool unavailable for Vulkan pipeline")
             }
@@ -1669,11 +1816,14 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             ? UInt32(meshResource.vertexCount)
             : UInt32(max(1, vertexRes.length / max(1, Int(resource.vertexStride))))
 
-        var vertexBuffers = [vertexBuffer]
-        var offsets: [VkDeviceSize] = [0]
-        vertexBuffers.withUnsafeMutableBufferPointer { bptr in
-            offsets.withUnsafeMutableBufferPointer { optr in
-                vkCmdBindVertexBuffers(cmd, 0, 1, bptr.baseAddress, optr.baseAddress)
+        let bindMeshBuffers = bindTracker.needsVertexBuffers(mesh)
+        if bindMeshBuffers {
+            var vertexBuffers = [vertexBuffer]
+            var offsets: [VkDeviceSize] = [0]
+            vertexBuffers.withUnsafeMutableBufferPointer { bptr in
+                offsets.withUnsafeMutableBufferPointer { optr in
+                    vkCmdBindVertexBuffers(cmd, 0, 1, bptr.baseAddress, optr.baseAddress)
+                }
             }
         }
 
@@ -1681,8 +1831,10 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
            meshResource.indexCount > 0,
            let indexRes = buffers[indexHandle],
            let indexBuffer = indexRes.buffer {
-            let indexType = convertIndexFormat(meshResource.indexFormat)
-            vkCmdBindIndexBuffer(cmd, indexBuffer, 0, indexType)
+            if bindMeshBuffers {
+                let indexType = convertIndexFormat(meshResource.indexFormat)
+                vkCmdBindIndexBuffer(cmd, indexBuffer, 0, indexType)
+            }
             vkCmdDrawIndexed(cmd, UInt32(meshResource.indexCount), 1, 0, 0, 0)
         } else {
             vkCmdDraw(cmd, vertexCount, 1, 0, 0)
@@ -1699,8 +1851,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             return existing.handle
         }
 
-        let spirvURL = try module.artifacts.requireSPIRV(for: module.id)
-        let spirvData = try Data(contentsOf: spirvURL)
+        let spirvData = try module.artifacts.requireSPIRV(for: module.id)
         var shaderModule: VkShaderModule? = nil
         try spirvData.withUnsafeBytes { bytes in
             var info = VkShaderModuleCreateInfo()
@@ -1819,16 +1970,16 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             }
         }
 
-        let handle = ComputePipelineHandle()
-        let resource = ComputePipelineResource(
-            handle: handle,
-            pipelineLayout: pipelineLayout,
-            pipeline: pipeline,
-            descriptorSetLayout: descriptorSetLayout,
-            descriptorPool: descriptorPool,
-            module: module
-        )
-        computePipelines[handle] = resource
+        let handle = computePipelines.insert { handle in
+            ComputePipelineResource(
+                handle: handle,
+                pipelineLayout: pipelineLayout,
+                pipeline: pipeline,
+                descriptorSetLayout: descriptorSetLayout,
+                descriptorPool: descriptorPool,
+                module: module
+            )
+        }
         SDLLogger.debug("SDLKit.Graphics.Vulkan", "makeComputePipeline id=\(handle.rawValue) shader=\(module.id.rawValue)")
         return handle
         #else
@@ -1837,6 +1988,8 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
     }
 
     public func dispatchCompute(_ pipeline: ComputePipelineHandle, groupsX: Int, groupsY: Int, groupsZ: Int, bindings: BindingSet) throws {
+        let profile = SDLProfiler.begin("render.dispatchCompute")
+        defer { profile.end() }
         #if canImport(CVulkan)
         guard let dev = device else {
             throw AgentError.internalError("Vulkan compute resources not initialized")
@@ -1852,36 +2005,20 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         if isFrameDispatch && commandBuffers.isEmpty {
             throw AgentError.internalError("Vulkan command buffers unavailable for in-frame compute dispatch")
         }
+        if isFrameDispatch {
+            // Compute recording may suspend the render pass; rebind graphics state on the next draw.
+            bindTracker.invalidate()
+        }
         guard let pool = commandPool else {
             throw AgentError.internalError("Vulkan command pool unavailable for compute dispatch")
         }
 
-        struct BufferBindingRecord {
-            enum Role { case uniform, storage }
-            var buffer: VkBuffer
-            var role: Role
-        }
-
-        struct ImageBindingRecord {
-            enum Role { case sampled, storage }
-            var handle: TextureHandle
-            var image: VkImage
-            var aspectMask: UInt32
-            var mipLevels: Int
-            var layout: VkImageLayout
-            var role: Role
-        }
-
-        var descriptorSet: VkDescriptorSet? = nil
-        var bufferInfos: [VkDescriptorBufferInfo] = []
-        var imageInfos: [VkDescriptorImageInfo] = []
-        var bufferIndices: [Int?] = []
-        var imageIndices: [Int?] = []
-        var writes: [VkWriteDescriptorSet] = []
-        var bufferBindings: [BufferBindingRecord] = []
-        var imageBindings: [ImageBindingRecord] = []
-        var descriptorAllocation: PendingComputeDescriptor? = nil
-        var descriptorOwned = false
+        let prepared = try prepareComputeDescriptors(resource, bindings: bindings, device: dev)
+        let bufferBindings = prepared.buffers
+        let imageBindings = prepared.images
+        let descriptorAllocation = prepared.allocation
+        let descriptorSet = descriptorAllocation?.set
+        var descriptorOwned = descriptorAllocation != nil
 
         defer {
             if descriptorOwned, let allocation = descriptorAllocation, var set = allocation.set, let pool = allocation.pool {
@@ -1889,163 +2026,6 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             }
         }
 
-        if !resource.module.bindings.isEmpty {
-            guard let layout = resource.descriptorSetLayout, let descriptorPool = resource.descriptorPool else {
-                throw AgentError.internalError("Descriptor resources missing for Vulkan compute pipeline")
-            }
-            var allocInfo = VkDescriptorSetAllocateInfo()
-            allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO
-            allocInfo.descriptorPool = descriptorPool
-            var layouts: [VkDescriptorSetLayout?] = [layout]
-            let allocResult = layouts.withUnsafeMutableBufferPointer { buf -> VkResult in
-                allocInfo.descriptorSetCount = UInt32(buf.count)
-                allocInfo.pSetLayouts = buf.baseAddress
-                return withUnsafePointer(to: allocInfo) { ptr in vkAllocateDescriptorSets(dev, ptr, &descriptorSet) }
-            }
-            if allocResult != VK_SUCCESS || descriptorSet == nil {
-                throw AgentError.internalError("vkAllocateDescriptorSets failed (res=\(allocResult))")
-            }
-            guard let descriptorSetHandle = descriptorSet else {
-                throw AgentError.internalError("Descriptor set allocation returned nil handle")
-            }
-            descriptorAllocation = PendingComputeDescriptor(pool: descriptorPool, set: descriptorSetHandle)
-            descriptorOwned = true
-
-            for slot in resource.module.bindings {
-                let descriptorType = try descriptorType(for: slot.kind)
-                var write = VkWriteDescriptorSet()
-                write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET
-                write.dstSet = descriptorSetHandle
-                write.dstBinding = UInt32(slot.index)
-                write.descriptorCount = 1
-                write.descriptorType = descriptorType
-
-                switch slot.kind {
-                case .uniformBuffer, .storageBuffer:
-                    guard let entry = bindings.resource(at: slot.index) else {
-                        throw AgentError.invalidArgument("Missing buffer binding for compute slot \(slot.index)")
-                    }
-                    let handle: BufferHandle
-                    switch entry {
-                    case .buffer(let bufferHandle):
-                        handle = bufferHandle
-                    case .texture:
-                        throw AgentError.invalidArgument("Texture bound to buffer slot \(slot.index) in Vulkan compute dispatch")
-                    }
-                    guard let bufferRes = buffers[handle], let buffer = bufferRes.buffer else {
-                        throw AgentError.invalidArgument("Unknown buffer handle for compute slot \(slot.index)")
-                    }
-                    var info = VkDescriptorBufferInfo()
-                    info.buffer = buffer
-                    info.offset = 0
-                    info.range = VkDeviceSize(bufferRes.length)
-                    bufferIndices.append(bufferInfos.count)
-                    imageIndices.append(nil)
-                    bufferInfos.append(info)
-                    let role: BufferBindingRecord.Role = slot.kind == .uniformBuffer ? .uniform : .storage
-                    bufferBindings.append(BufferBindingRecord(buffer: buffer, role: role))
-                case .sampledTexture:
-                    guard let entry = bindings.resource(at: slot.index) else {
-                        throw AgentError.invalidArgument("Missing texture binding for compute slot \(slot.index)")
-                    }
-                    let textureHandle: TextureHandle
-                    switch entry {
-                    case .texture(let handle):
-                        textureHandle = handle
-                    case .buffer:
-                        throw AgentError.invalidArgument("Buffer bound to texture slot \(slot.index) in Vulkan compute dispatch")
-                    }
-                    guard let texture = textures[textureHandle] else {
-                        throw AgentError.invalidArgument("Unknown texture handle for compute slot \(slot.index)")
-                    }
-                    guard let imageView = texture.view else {
-                        throw AgentError.invalidArgument("Texture view missing for compute slot \(slot.index)")
-                    }
-                    guard let image = texture.image else {
-                        throw AgentError.invalidArgument("Texture image missing for compute slot \(slot.index)")
-                    }
-                    var info = VkDescriptorImageInfo()
-                    if let samplerHandle = bindings.sampler(at: slot.index),
-                       let samplerRes = samplers[samplerHandle],
-                       let sampler = samplerRes.sampler {
-                        info.sampler = sampler
-                    } else {
-                        info.sampler = texture.sampler
-                    }
-                    guard info.sampler != nil else {
-                        throw AgentError.invalidArgument("Missing sampler for combined image slot \(slot.index) in Vulkan compute dispatch")
-                    }
-                    info.imageView = imageView
-                    info.imageLayout = texture.layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : texture.layout
-                    bufferIndices.append(nil)
-                    imageIndices.append(imageInfos.count)
-                    imageInfos.append(info)
-                    let mipLevels = max(1, texture.descriptor.mipLevels)
-                    imageBindings.append(ImageBindingRecord(handle: textureHandle, image: image, aspectMask: texture.aspectMask, mipLevels: mipLevels, layout: texture.layout, role: .sampled))
-                case .storageTexture:
-                    guard let entry = bindings.resource(at: slot.index) else {
-                        throw AgentError.invalidArgument("Missing storage texture binding for compute slot \(slot.index)")
-                    }
-                    let textureHandle: TextureHandle
-                    switch entry {
-                    case .texture(let handle):
-                        textureHandle = handle
-                    case .buffer:
-                        throw AgentError.invalidArgument("Buffer bound to storage texture slot \(slot.index)")
-                    }
-                    guard let texture = textures[textureHandle] else {
-                        throw AgentError.invalidArgument("Unknown storage texture handle for compute slot \(slot.index)")
-                    }
-                    guard let imageView = texture.view else {
-                        throw AgentError.invalidArgument("Storage texture view missing for compute slot \(slot.index)")
-                    }
-                    guard let image = texture.image else {
-                        throw AgentError.invalidArgument("Storage texture image missing for compute slot \(slot.index)")
-                    }
-                    var info = VkDescriptorImageInfo()
-                    info.sampler = nil
-                    info.imageView = imageView
-                    info.imageLayout = texture.layout
-                    bufferIndices.append(nil)
-                    imageIndices.append(imageInfos.count)
-                    imageInfos.append(info)
-                    let mipLevels = max(1, texture.descriptor.mipLevels)
-                    imageBindings.append(ImageBindingRecord(handle: textureHandle, image: image, aspectMask: texture.aspectMask, mipLevels: mipLevels, layout: texture.layout, role: .storage))
-                case .sampler:
-                    guard let samplerHandle = bindings.sampler(at: slot.index),
-                          let samplerRes = samplers[samplerHandle],
-                          let sampler = samplerRes.sampler else {
-                        throw AgentError.invalidArgument("Missing sampler binding for compute slot \(slot.index)")
-                    }
-                    var info = VkDescriptorImageInfo()
-                    info.sampler = sampler
-                    info.imageView = nil
-                    info.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED
-                    bufferIndices.append(nil)
-                    imageIndices.append(imageInfos.count)
-                    imageInfos.append(info)
-                }
-
-                writes.append(write)
-            }
-
-            bufferInfos.withUnsafeMutableBufferPointer { bufferPtr in
-                imageInfos.withUnsafeMutableBufferPointer { imagePtr in
-                    for index in 0..<writes.count {
-                        if let bufferOffset = bufferIndices[index] {
-                            writes[index].pBufferInfo = bufferPtr.baseAddress?.advanced(by: bufferOffset)
-                        }
-                        if let imageOffset = imageIndices[index] {
-                            writes[index].pImageInfo = imagePtr.baseAddress?.advanced(by: imageOffset)
-                        }
-                    }
-                    writes.withUnsafeMutableBufferPointer { writePtr in
-                        vkUpdateDescriptorSets(dev, UInt32(writePtr.count), writePtr.baseAddress, 0, nil)
-                    }
-                }
-            }
-        }
-
         let commandBufferHandle: VkCommandBuffer
         var submissionQueue: VkQueue? = nil
         var allocatedCommandBuffer: VkCommandBuffer? = nil
@@ -2083,6 +2063,22 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             _ = withUnsafePointer(to: beginInfo) { ptr in vkBeginCommandBuffer(commandBufferHandle, ptr) }
         }
 
+        let dispatchLabel = GPUTimingLabel.dispatch(resource.module.id)
+        var immediateTimestamps: GPUTimestampRing.Scope? = nil
+        var frameScopeOpened = false
+        if isFrameDispatch {
+            if let query = timestampQueryPool != nil ? timestampRing.beginScope(dispatchLabel) : nil {
+                writeTimestamp(commandBufferHandle, query: query, stage: VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT)
+            }
+            frameScopeOpened = timestampQueryPool != nil
+        } else if let pool = timestampQueryPool,
+                  pendingOutOfFrameComputeSubmissions.count < timestampRing.immediateCapacity,
+                  let scope = timestampRing.reserveImmediate(dispatchLabel) {
+            vkCmdResetQueryPool(commandBufferHandle, pool, scope.begin, 2)
+            writeTimestamp(commandBufferHandle, query: scope.begin, stage: VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT)
+            immediateTimestamps = scope
+        }
+
         defer {
             if ownsAllocatedCommandBuffer, let cmd = allocatedCommandBuffer {
                 withUnsafePointer(to: &cmd) { ptr in vkFreeCommandBuffers(dev, pool, 1, ptr) }
@@ -2210,43 +2206,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             }
         }
 
-        let expectedComputePushConstantSize = resource.module.pushConstantSize
-        let computePayload = bindings.materialConstants
-        if expectedComputePushConstantSize > 0 {
-            guard let payload = computePayload else {
-                let message = "Compute shader \(resource.module.id.rawValue) expects \(expectedComputePushConstantSize) bytes of push constants but none were provided."
-                SDLLogger.error("SDLKit.Graphics.Vulkan", message)
-                throw AgentError.invalidArgument(message)
-            }
-            guard payload.byteCount == expectedComputePushConstantSize else {
-                let message = "Compute shader \(resource.module.id.rawValue) expects \(expectedComputePushConstantSize) bytes of push constants but received \(payload.byteCount)."
-                SDLLogger.error("SDLKit.Graphics.Vulkan", message)
-                throw AgentError.invalidArgument(message)
-            }
-        } else if let payload = computePayload, payload.byteCount > 0 {
-            SDLLogger.warn(
-                "SDLKit.Graphics.Vulkan",
-                "Material constants of size \(payload.byteCount) bytes provided for compute shader \(resource.module.id.rawValue) which does not declare push constants. Data will be ignored."
-            )
-        }
-
-        if let pipelineHandle = resource.pipeline {
-            vkCmdBindPipeline(commandBufferHandle, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineHandle)
-        }
-        if let layout = resource.pipelineLayout, let descriptorSet = descriptorSet {
-            var sets = [descriptorSet]
-            sets.withUnsafeMutableBufferPointer { buf in
-                vkCmdBindDescriptorSets(commandBufferHandle, VK_PIPELINE_BIND_POINT_COMPUTE, layout, 0, UInt32(buf.count), buf.baseAddress, 0, nil)
-            }
-        }
-        if let layout = resource.pipelineLayout, expectedComputePushConstantSize > 0, let payload = computePayload {
-            payload.withUnsafeBytes { bytes in
-                guard let base = bytes.baseAddress else { return }
-                _ = vkCmdPushConstants(commandBufferHandle, layout, UInt32(VK_SHADER_STAGE_COMPUTE_BIT), 0, UInt32(bytes.count), base)
-            }
-        }
-
-        vkCmdDispatch(commandBufferHandle, UInt32(max(1, groupsX)), UInt32(max(1, groupsY)), UInt32(max(1, groupsZ)))
+        try encodeComputeDispatch(commandBufferHandle, resource: resource, descriptorSet: descriptorSet, bindings: bindings, groups: (groupsX, groupsY, groupsZ))
 
         var postMemoryBarriers: [VkMemoryBarrier] = []
         if !isFrameDispatch {
@@ -2278,6 +2238,13 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             }
         }
 
+        if frameScopeOpened, let query = timestampRing.endScope() {
+            writeTimestamp(commandBufferHandle, query: query, stage: VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT)
+        }
+        if let scope = immediateTimestamps {
+            writeTimestamp(commandBufferHandle, query: scope.end, stage: VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT)
+        }
+
         if !isFrameDispatch {
             _ = vkEndCommandBuffer(commandBufferHandle)
 
@@ -2316,7 +2283,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
                 throw AgentError.internalError("vkQueueSubmit(compute) failed (res=\(submitResult))")
             }
 
-            pendingOutOfFrameComputeSubmissions.append(PendingComputeSubmission(fence: fence, commandBuffer: commandBufferHandle, descriptor: descriptorAllocation))
+            pendingOutOfFrameComputeSubmissions.append(PendingComputeSubmission(fence: fence, commandBuffer: commandBufferHandle, descriptor: descriptorAllocation, timestamps: immediateTimestamps))
             descriptorOwned = false
             ownsAllocatedCommandBuffer = false
         } else if let allocation = descriptorAllocation {
@@ -2331,12 +2298,577 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         #endif
     }
 
+    private struct BufferBindingRecord {
+        enum Role { case uniform, storage }
+        var buffer: VkBuffer
+        var role: Role
+    }
+
+    private struct ImageBindingRecord {
+        enum Role { case sampled, storage }
+        var handle: TextureHandle
+        var image: VkImage
+        var aspectMask: UInt32
+        var mipLevels: Int
+        var layout: VkImageLayout
+        var role: Role
+    }
+
+    private struct PreparedComputeDescriptors {
+        var allocation: PendingComputeDescriptor?
+        var buffers: [BufferBindingRecord]
+        var images: [ImageBindingRecord]
+    }
+
+    /// Allocates and writes the descriptor set for one dispatch, from `pool` when given
+    /// (command lists) or the pipeline's own pool. `layoutOverrides` names the layout an
+    /// image will be in when the dispatch runs, if not its current one. The caller owns the
+    /// returned set.
+    private func prepareComputeDescriptors(_ resource: ComputePipelineResource,
+                                           bindings: BindingSet,
+                                           device dev: VkDevice,
+                                           pool: VkDescriptorPool? = nil,
+                                           layoutOverrides: [TextureHandle: VkImageLayout] = [:]) throws -> PreparedComputeDescriptors {
+        var descriptorSet: VkDescriptorSet? = nil
+        var bufferInfos: [VkDescriptorBufferInfo] = []
+        var imageInfos: [VkDescriptorImageInfo] = []
+        var bufferIndices: [Int?] = []
+        var imageIndices: [Int?] = []
+        var writes: [VkWriteDescriptorSet] = []
+        var bufferBindings: [BufferBindingRecord] = []
+        var imageBindings: [ImageBindingRecord] = []
+        var descriptorAllocation: PendingComputeDescriptor? = nil
+        var descriptorOwned = false
+
+        defer {
+            if descriptorOwned, let allocation = descriptorAllocation, var set = allocation.set, let pool = allocation.pool {
+                withUnsafePointer(to: &set) { ptr in _ = vkFreeDescriptorSets(dev, pool, 1, ptr) }
+            }
+        }
+
+        if !resource.module.bindings.isEmpty {
+            guard let layout = resource.descriptorSetLayout, let descriptorPool = pool ?? resource.descriptorPool else {
+                throw AgentError.internalError("Descriptor resources missing for Vulkan compute pipeline")
+            }
+            var allocInfo = VkDescriptorSetAllocateInfo()
+            allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO
+            allocInfo.descriptorPool = descriptorPool
+            var layouts: [VkDescriptorSetLayout?] = [layout]
+            let allocResult = layouts.withUnsafeMutableBufferPointer { buf -> VkResult in
+                allocInfo.descriptorSetCount = UInt32(buf.count)
+                allocInfo.pSetLayouts = buf.baseAddress
+                return withUnsafePointer(to: allocInfo) { ptr in vkAllocateDescriptorSets(dev, ptr, &descriptorSet) }
+            }
+            if allocResult != VK_SUCCESS || descriptorSet == nil {
+                throw AgentError.internalError("vkAllocateDescriptorSets failed (res=\(allocResult))")
+            }
+            guard let descriptorSetHandle = descriptorSet else {
+                throw AgentError.internalError("Descriptor set allocation returned nil handle")
+            }
+            descriptorAllocation = PendingComputeDescriptor(pool: descriptorPool, set: descriptorSetHandle)
+            descriptorOwned = true
+
+            for slot in resource.module.bindings {
+                let descriptorType = try descriptorType(for: slot.kind)
+                var write = VkWriteDescriptorSet()
+                write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET
+                write.dstSet = descriptorSetHandle
+                write.dstBinding = UInt32(slot.index)
+                write.descriptorCount = 1
+                write.descriptorType = descriptorType
+
+                switch slot.kind {
+                case .uniformBuffer, .storageBuffer:
+                    guard let entry = bindings.resource(at: slot.index) else {
+                        throw AgentError.invalidArgument("Missing buffer binding for compute slot \(slot.index)")
+                    }
+                    let handle: BufferHandle
+                    switch entry {
+                    case .buffer(let bufferHandle):
+                        handle = bufferHandle
+                    case .texture:
+                        throw AgentError.invalidArgument("Texture bound to buffer slot \(slot.index) in Vulkan compute dispatch")
+                    }
+                    guard let bufferRes = buffers[handle], let buffer = bufferRes.buffer else {
+                        throw AgentError.invalidArgument("Unknown buffer handle for compute slot \(slot.index)")
+                    }
+                    var info = VkDescriptorBufferInfo()
+                    info.buffer = buffer
+                    info.offset = 0
+                    info.range = VkDeviceSize(bufferRes.length)
+                    bufferIndices.append(bufferInfos.count)
+                    imageIndices.append(nil)
+                    bufferInfos.append(info)
+                    let role: BufferBindingRecord.Role = slot.kind == .uniformBuffer ? .uniform : .storage
+                    bufferBindings.append(BufferBindingRecord(buffer: buffer, role: role))
+                case .sampledTexture:
+                    guard let entry = bindings.resource(at: slot.index) else {
+                        throw AgentError.invalidArgument("Missing texture binding for compute slot \(slot.index)")
+                    }
+                    let textureHandle: TextureHandle
+                    switch entry {
+                    case .texture(let handle):
+                        textureHandle = handle
+                    case .buffer:
+                        throw AgentError.invalidArgument("Buffer bound to texture slot \(slot.index) in Vulkan compute dispatch")
+                    }
+                    guard let texture = textures[textureHandle] else {
+                        throw AgentError.invalidArgument("Unknown texture handle for compute slot \(slot.index)")
+                    }
+                    guard let imageView = texture.view else {
+                        throw AgentError.invalidArgument("Texture view missing for compute slot \(slot.index)")
+                    }
+                    guard let image = texture.image else {
+                        throw AgentError.invalidArgument("Texture image missing for compute slot \(slot.index)")
+                    }
+                    var info = VkDescriptorImageInfo()
+                    if let samplerHandle = bindings.sampler(at: slot.index),
+                       let samplerRes = samplers[samplerHandle],
+                       let sampler = samplerRes.sampler {
+                        info.sampler = sampler
+                    } else {
+                        info.sampler = texture.sampler
+                    }
+                    guard info.sampler != nil else {
+                        throw AgentError.invalidArgument("Missing sampler for combined image slot \(slot.index) in Vulkan compute dispatch")
+                    }
+                    info.imageView = imageView
+                    info.imageLayout = layoutOverrides[textureHandle] ?? (texture.layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : texture.layout)
+                    bufferIndices.append(nil)
+                    imageIndices.append(imageInfos.count)
+                    imageInfos.append(info)
+                    let mipLevels = max(1, texture.descriptor.mipLevels)
+                    imageBindings.append(ImageBindingRecord(handle: textureHandle, image: image, aspectMask: texture.aspectMask, mipLevels: mipLevels, layout: texture.layout, role: .sampled))
+                case .storageTexture:
+                    guard let entry = bindings.resource(at: slot.index) else {
+                        throw AgentError.invalidArgument("Missing storage texture binding for compute slot \(slot.index)")
+                    }
+                    let textureHandle: TextureHandle
+                    switch entry {
+                    case .texture(let handle):
+                        textureHandle = handle
+                    case .buffer:
+                        throw AgentError.invalidArgument("Buffer bound to storage texture slot \(slot.index)")
+                    }
+                    guard let texture = textures[textureHandle] else {
+                        throw AgentError.invalidArgument("Unknown storage texture handle for compute slot \(slot.index)")
+                    }
+                    guard let imageView = texture.view else {
+                        throw AgentError.invalidArgument("Storage texture view missing for compute slot \(slot.index)")
+                    }
+                    guard let image = texture.image else {
+                        throw AgentError.invalidArgument("Storage texture image missing for compute slot \(slot.index)")
+                    }
+                    var info = VkDescriptorImageInfo()
+                    info.sampler = nil
+                    info.imageView = imageView
+                    info.imageLayout = layoutOverrides[textureHandle] ?? texture.layout
+                    bufferIndices.append(nil)
+                    imageIndices.append(imageInfos.count)
+                    imageInfos.append(info)
+                    let mipLevels = max(1, texture.descriptor.mipLevels)
+                    imageBindings.append(ImageBindingRecord(handle: textureHandle, image: image, aspectMask: texture.aspectMask, mipLevels: mipLevels, layout: texture.layout, role: .storage))
+                case .sampler:
+                    guard let samplerHandle = bindings.sampler(at: slot.index),
+                          let samplerRes = samplers[samplerHandle],
+                          let sampler = samplerRes.sampler else {
+                        throw AgentError.invalidArgument("Missing sampler binding for compute slot \(slot.index)")
+                    }
+                    var info = VkDescriptorImageInfo()
+                    info.sampler = sampler
+                    info.imageView = nil
+                    info.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED
+                    bufferIndices.append(nil)
+                    imageIndices.append(imageInfos.count)
+                    imageInfos.append(info)
+                }
+
+                writes.append(write)
+            }
+
+            bufferInfos.withUnsafeMutableBufferPointer { bufferPtr in
+                imageInfos.withUnsafeMutableBufferPointer { imagePtr in
+                    for index in 0..<writes.count {
+                        if let bufferOffset = bufferIndices[index] {
+                            writes[index].pBufferInfo = bufferPtr.baseAddress?.advanced(by: bufferOffset)
+                        }
+                        if let imageOffset = imageIndices[index] {
+                            writes[index].pImageInfo = imagePtr.baseAddress?.advanced(by: imageOffset)
+                        }
+                    }
+                    writes.withUnsafeMutableBufferPointer { writePtr in
+                        vkUpdateDescriptorSets(dev, UInt32(writePtr.count), writePtr.baseAddress, 0, nil)
+                    }
+                }
+            }
+        }
+
+        descriptorOwned = false
+        return PreparedComputeDescriptors(allocation: descriptorAllocation, buffers: bufferBindings, images: imageBindings)
+    }
+
+    /// Validates push constants, binds the pipeline state and records the dispatch.
+    private func encodeComputeDispatch(_ commandBuffer: VkCommandBuffer,
+                                       resource: ComputePipelineResource,
+                                       descriptorSet: VkDescriptorSet?,
+                                       bindings: BindingSet,
+                                       groups: (x: Int, y: Int, z: Int)) throws {
+        let expectedComputePushConstantSize = resource.module.pushConstantSize
+        let computePayload = bindings.materialConstants
+        if expectedComputePushConstantSize > 0 {
+            guard let payload = computePayload else {
+                let message = "Compute shader \(resource.module.id.rawValue) expects \(expectedComputePushConstantSize) bytes of push constants but none were provided."
+                SDLLogger.error("SDLKit.Graphics.Vulkan", message)
+                throw AgentError.invalidArgument(message)
+            }
+            guard payload.byteCount == expectedComputePushConstantSize else {
+                let message = "Compute shader \(resource.module.id.rawValue) expects \(expectedComputePushConstantSize) bytes of push constants but received \(payload.byteCount)."
+                SDLLogger.error("SDLKit.Graphics.Vulkan", message)
+                throw AgentError.invalidArgument(message)
+            }
+        } else if let payload = computePayload, payload.byteCount > 0 {
+            SDLLogger.warn(
+                "SDLKit.Graphics.Vulkan",
+                "Material constants of size \(payload.byteCount) bytes provided for compute shader \(resource.module.id.rawValue) which does not declare push constants. Data will be ignored."
+            )
+        }
+
+        if let pipelineHandle = resource.pipeline {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineHandle)
+        }
+        if let layout = resource.pipelineLayout, let descriptorSet = descriptorSet {
+            var sets = [descriptorSet]
+            sets.withUnsafeMutableBufferPointer { buf in
+                vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, layout, 0, UInt32(buf.count), buf.baseAddress, 0, nil)
+            }
+        }
+        if let layout = resource.pipelineLayout, expectedComputePushConstantSize > 0, let payload = computePayload {
+            payload.withUnsafeBytes { bytes in
+                guard let base = bytes.baseAddress else { return }
+                _ = vkCmdPushConstants(commandBuffer, layout, UInt32(VK_SHADER_STAGE_COMPUTE_BIT), 0, UInt32(bytes.count), base)
+            }
+        }
+
+        vkCmdDispatch(commandBuffer, UInt32(max(1, groups.x)), UInt32(max(1, groups.y)), UInt32(max(1, groups.z)))
+    }
+
+    // MARK: - Compute command lists
+
+    /// Records every dispatch of `list` into one command buffer and submits it once. Images
+    /// keep one layout for the whole list (GENERAL if any dispatch writes them), so the only
+    /// barriers between dispatches are the hazards `ComputeHazardPlanner` reports.
+    public func submitCompute(_ list: ComputeCommandList) throws -> ComputeFence {
+        let profile = SDLProfiler.begin("render.submitCompute")
+        defer { profile.end() }
+        guard !list.isEmpty else { return ComputeFence.signaled(dispatchCount: 0, barrierCount: 0) }
+        guard let dev = device else {
+            throw AgentError.internalError("Vulkan compute resources not initialized")
+        }
+        if frameActive {
+            throw AgentError.invalidArgument("Compute command lists must be submitted outside beginFrame/endFrame")
+        }
+        try ensureCommandPoolAndSync()
+        drainPendingComputeSubmissions(waitAll: false)
+        guard let commandPoolHandle = commandPool, let queue = graphicsQueue else {
+            throw AgentError.internalError("Vulkan command pool or queue unavailable for compute command list")
+        }
+
+        var resources: [ComputePipelineResource] = []
+        resources.reserveCapacity(list.count)
+        var listLayouts: [TextureHandle: VkImageLayout] = [:]
+        for dispatch in list.dispatches {
+            guard let resource = computePipelines[dispatch.pipeline] else {
+                throw AgentError.internalError("Unknown Vulkan compute pipeline")
+            }
+            resources.append(resource)
+            for slot in resource.module.bindings {
+                guard case .texture(let handle)? = dispatch.bindings.resource(at: slot.index) else { continue }
+                if slot.kind == .storageTexture {
+                    listLayouts[handle] = VK_IMAGE_LAYOUT_GENERAL
+                } else if slot.kind == .sampledTexture, listLayouts[handle] == nil {
+                    listLayouts[handle] = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                }
+            }
+        }
+
+        let descriptorPool = try makeTransientComputeDescriptorPool(for: resources, device: dev)
+        var commandBuffer: VkCommandBuffer? = nil
+        var submitted = false
+        defer {
+            if !submitted {
+                if commandBuffer != nil {
+                    withUnsafePointer(to: &commandBuffer) { ptr in vkFreeCommandBuffers(dev, commandPoolHandle, 1, ptr) }
+                }
+                // Destroying the pool frees every set allocated from it.
+                if let descriptorPool { vkDestroyDescriptorPool(dev, descriptorPool, nil) }
+            }
+        }
+
+        var prepared: [PreparedComputeDescriptors] = []
+        prepared.reserveCapacity(list.count)
+        for (dispatch, resource) in zip(list.dispatches, resources) {
+            prepared.append(try prepareComputeDescriptors(resource, bindings: dispatch.bindings, device: dev,
+                                                          pool: descriptorPool, layoutOverrides: listLayouts))
+        }
+
+        var allocInfo = VkCommandBufferAllocateInfo()
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO
+        allocInfo.commandPool = commandPoolHandle
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY
+        allocInfo.commandBufferCount = 1
+        let allocRes = withUnsafePointer(to: allocInfo) { ptr in vkAllocateCommandBuffers(dev, ptr, &commandBuffer) }
+        guard allocRes == VK_SUCCESS, let cmd = commandBuffer else {
+            throw AgentError.internalError("vkAllocateCommandBuffers(compute list) failed (res=\(allocRes))")
+        }
+        var beginInfo = VkCommandBufferBeginInfo()
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO
+        beginInfo.flags = UInt32(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT)
+        _ = withUnsafePointer(to: beginInfo) { ptr in vkBeginCommandBuffer(cmd, ptr) }
+
+        var timestamps: GPUTimestampRing.Scope? = nil
+        if let queryPool = timestampQueryPool,
+           pendingOutOfFrameComputeSubmissions.count < timestampRing.immediateCapacity,
+           let scope = timestampRing.reserveImmediate(GPUTimingLabel.computeList(list.label)) {
+            vkCmdResetQueryPool(cmd, queryPool, scope.begin, 2)
+            writeTimestamp(cmd, query: scope.begin, stage: VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT)
+            timestamps = scope
+        }
+
+        // Entry: host, transfer and earlier GPU writes become visible, and each image moves
+        // once into its list layout.
+        var entryMemory = VkMemoryBarrier()
+        entryMemory.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER
+        entryMemory.srcAccessMask = UInt32(VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT)
+        entryMemory.dstAccessMask = UInt32(VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT)
+        var entryImages: [VkImageMemoryBarrier] = []
+        var transitioned = Set<TextureHandle>()
+        for image in prepared.flatMap(\.images) where transitioned.insert(image.handle).inserted {
+            guard let layout = listLayouts[image.handle], layout != image.layout else { continue }
+            entryImages.append(computeImageBarrier(image, from: image.layout, to: layout,
+                                                   srcAccess: UInt32(VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT),
+                                                   dstAccess: UInt32(VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT)))
+        }
+        recordComputeBarrier(cmd,
+                             srcStage: UInt32(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_HOST_BIT),
+                             dstStage: UInt32(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT),
+                             memory: [entryMemory], buffers: [], images: entryImages)
+
+        var planner = ComputeHazardPlanner()
+        for index in list.dispatches.indices {
+            let dispatch = list.dispatches[index]
+            let resource = resources[index]
+            let hazards = planner.barriers(before: ComputeHazardPlanner.accesses(of: dispatch.bindings, slots: resource.module.bindings))
+            if !hazards.isEmpty {
+                var bufferBarriers: [VkBufferMemoryBarrier] = []
+                var imageBarriers: [VkImageMemoryBarrier] = []
+                for hazard in hazards {
+                    // A write after reads only needs the reads to finish: execution-only.
+                    let (srcAccess, dstAccess): (UInt32, UInt32)
+                    switch hazard.hazard {
+                    case .readAfterWrite:
+                        (srcAccess, dstAccess) = (UInt32(VK_ACCESS_SHADER_WRITE_BIT), UInt32(VK_ACCESS_SHADER_READ_BIT))
+                    case .writeAfterWrite:
+                        (srcAccess, dstAccess) = (UInt32(VK_ACCESS_SHADER_WRITE_BIT), UInt32(VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT))
+                    case .writeAfterRead:
+                        (srcAccess, dstAccess) = (0, 0)
+                    }
+                    switch hazard.resource {
+                    case .buffer(let handle):
+                        guard let buffer = buffers[handle]?.buffer else { continue }
+                        var barrier = VkBufferMemoryBarrier()
+                        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER
+                        barrier.srcQueueFamilyIndex = UInt32(VK_QUEUE_FAMILY_IGNORED)
+                        barrier.dstQueueFamilyIndex = UInt32(VK_QUEUE_FAMILY_IGNORED)
+                        barrier.buffer = buffer
+                        barrier.offset = 0
+                        barrier.size = VkDeviceSize.max
+                        barrier.srcAccessMask = srcAccess
+                        barrier.dstAccessMask = dstAccess
+                        bufferBarriers.append(barrier)
+                    case .texture(let handle):
+                        guard let image = prepared[index].images.first(where: { $0.handle == handle }) else { continue }
+                        let layout = listLayouts[handle] ?? image.layout
+                        imageBarriers.append(computeImageBarrier(image, from: layout, to: layout, srcAccess: srcAccess, dstAccess: dstAccess))
+                    }
+                }
+                recordComputeBarrier(cmd,
+                                     srcStage: UInt32(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT),
+                                     dstStage: UInt32(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT),
+                                     memory: [], buffers: bufferBarriers, images: imageBarriers)
+            }
+            try encodeComputeDispatch(cmd, resource: resource, descriptorSet: prepared[index].allocation?.set,
+                                      bindings: dispatch.bindings, groups: dispatch.groups)
+        }
+
+        if !planner.writtenResources.isEmpty {
+            var exitMemory = VkMemoryBarrier()
+            exitMemory.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER
+            exitMemory.srcAccessMask = UInt32(VK_ACCESS_SHADER_WRITE_BIT)
+            exitMemory.dstAccessMask = UInt32(VK_ACCESS_HOST_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT)
+            recordComputeBarrier(cmd,
+                                 srcStage: UInt32(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT),
+                                 dstStage: UInt32(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_HOST_BIT),
+                                 memory: [exitMemory], buffers: [], images: [])
+        }
+        if let scope = timestamps {
+            writeTimestamp(cmd, query: scope.end, stage: VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT)
+        }
+        _ = vkEndCommandBuffer(cmd)
+
+        var fenceInfo = VkFenceCreateInfo()
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO
+        var fence: VkFence? = nil
+        let fenceResult = vkCreateFence(dev, &fenceInfo, nil, &fence)
+        if fenceResult != VK_SUCCESS || fence == nil {
+            throw AgentError.internalError("vkCreateFence(compute list) failed (res=\(fenceResult))")
+        }
+        var submitInfo = VkSubmitInfo()
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO
+        var cmdBuffers: [VkCommandBuffer?] = [cmd]
+        let submitResult = cmdBuffers.withUnsafeMutableBufferPointer { buf -> VkResult in
+            submitInfo.commandBufferCount = UInt32(buf.count)
+            submitInfo.pCommandBuffers = UnsafePointer(buf.baseAddress)
+#if DEBUG
+            if debugSimulatedDeviceLossRequested && !debugDeviceLossInProgress {
+                debugSimulatedDeviceLossRequested = false
+                return VK_ERROR_DEVICE_LOST
+            }
+#endif
+            return withUnsafePointer(to: submitInfo) { ptr in vkQueueSubmit(queue, 1, ptr, fence) }
+        }
+        if submitResult == VK_ERROR_DEVICE_LOST {
+            vkDestroyFence(dev, fence, nil)
+            try handleDeviceLoss(context: "vkQueueSubmit(compute list)", result: submitResult)
+        } else if submitResult != VK_SUCCESS {
+            vkDestroyFence(dev, fence, nil)
+            throw AgentError.internalError("vkQueueSubmit(compute list) failed (res=\(submitResult))")
+        }
+
+        for (handle, layout) in listLayouts {
+            if var texture = textures[handle] {
+                texture.layout = layout
+                textures[handle] = texture
+            }
+        }
+        computeSubmissionSerial &+= 1
+        let serial = computeSubmissionSerial
+        pendingOutOfFrameComputeSubmissions.append(PendingComputeSubmission(fence: fence, commandBuffer: cmd, descriptor: nil,
+                                                                            timestamps: timestamps, serial: serial,
+                                                                            transientPool: descriptorPool))
+        submitted = true
+        return ComputeFence(dispatchCount: list.count,
+                            barrierCount: planner.barrierCount,
+                            poll: { [weak self] in self?.isComputeSubmissionComplete(serial) ?? true },
+                            wait: { [weak self] in try self?.waitForComputeSubmission(serial) })
+    }
+
+    /// One pool sized for every descriptor set of a command list; nil when no dispatch binds anything.
+    private func makeTransientComputeDescriptorPool(for resources: [ComputePipelineResource], device dev: VkDevice) throws -> VkDescriptorPool? {
+        var descriptorTypeCounts: [VkDescriptorType: UInt32] = [:]
+        var setCount: UInt32 = 0
+        for resource in resources where !resource.module.bindings.isEmpty {
+            setCount += 1
+            for slot in resource.module.bindings {
+                descriptorTypeCounts[try descriptorType(for: slot.kind), default: 0] += 1
+            }
+        }
+        guard setCount > 0 else { return nil }
+        var poolSizes: [VkDescriptorPoolSize] = []
+        for (key, value) in descriptorTypeCounts {
+            var size = VkDescriptorPoolSize()
+            size.type = key
+            size.descriptorCount = value
+            poolSizes.append(size)
+        }
+        var poolInfo = VkDescriptorPoolCreateInfo()
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO
+        // Sets are freed individually if recording fails part-way.
+        poolInfo.flags = UInt32(VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT)
+        poolInfo.maxSets = setCount
+        var pool: VkDescriptorPool? = nil
+        let result = poolSizes.withUnsafeMutableBufferPointer { buf -> VkResult in
+            poolInfo.poolSizeCount = UInt32(buf.count)
+            poolInfo.pPoolSizes = UnsafePointer(buf.baseAddress)
+            return withUnsafePointer(to: poolInfo) { ptr in vkCreateDescriptorPool(dev, ptr, nil, &pool) }
+        }
+        guard result == VK_SUCCESS, let pool else {
+            throw AgentError.internalError("vkCreateDescriptorPool(compute list) failed (res=\(result))")
+        }
+        return pool
+    }
+
+    private func computeImageBarrier(_ image: ImageBindingRecord,
+                                     from oldLayout: VkImageLayout,
+                                     to newLayout: VkImageLayout,
+                                     srcAccess: UInt32,
+                                     dstAccess: UInt32) -> VkImageMemoryBarrier {
+        var barrier = VkImageMemoryBarrier()
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER
+        barrier.srcQueueFamilyIndex = UInt32(VK_QUEUE_FAMILY_IGNORED)
+        barrier.dstQueueFamilyIndex = UInt32(VK_QUEUE_FAMILY_IGNORED)
+        barrier.image = image.image
+        barrier.subresourceRange = VkImageSubresourceRange(aspectMask: image.aspectMask, baseMipLevel: 0, levelCount: UInt32(image.mipLevels), baseArrayLayer: 0, layerCount: 1)
+        barrier.oldLayout = oldLayout
+        barrier.newLayout = newLayout
+        barrier.srcAccessMask = srcAccess
+        barrier.dstAccessMask = dstAccess
+        return barrier
+    }
+
+    private func recordComputeBarrier(_ cmd: VkCommandBuffer,
+                                      srcStage: UInt32,
+                                      dstStage: UInt32,
+                                      memory: [VkMemoryBarrier],
+                                      buffers bufferBarriers: [VkBufferMemoryBarrier],
+                                      images imageBarriers: [VkImageMemoryBarrier]) {
+        var memory = memory
+        var bufferBarriers = bufferBarriers
+        var imageBarriers = imageBarriers
+        memory.withUnsafeMutableBufferPointer { memPtr in
+            bufferBarriers.withUnsafeMutableBufferPointer { bufPtr in
+                imageBarriers.withUnsafeMutableBufferPointer { imgPtr in
+                    vkCmdPipelineBarrier(cmd, srcStage, dstStage, 0,
+                                         UInt32(memPtr.count), memPtr.baseAddress,
+                                         UInt32(bufPtr.count), bufPtr.baseAddress,
+                                         UInt32(imgPtr.count), imgPtr.baseAddress)
+                }
+            }
+        }
+    }
+
+    private func isComputeSubmissionComplete(_ serial: UInt64) -> Bool {
+        guard let dev = device,
+              let submission = pendingOutOfFrameComputeSubmissions.first(where: { $0.serial == serial }) else {
+            return true
+        }
+        guard let fence = submission.fence, vkGetFenceStatus(dev, fence) == VK_SUCCESS else { return false }
+        drainPendingComputeSubmissions(waitAll: false)
+        return true
+    }
+
+    private func waitForComputeSubmission(_ serial: UInt64) throws {
+        guard let dev = device,
+              let submission = pendingOutOfFrameComputeSubmissions.first(where: { $0.serial == serial }) else {
+            return
+        }
+        var fence = submission.fence
+        if fence != nil {
+            let result = withUnsafePointer(to: &fence) { ptr in vkWaitForFences(dev, 1, ptr, VK_TRUE, UInt64.max) }
+            if result == VK_ERROR_DEVICE_LOST {
+                try handleDeviceLoss(context: "vkWaitForFences(compute list)", result: result)
+            }
+        }
+        drainPendingComputeSubmissions(waitAll: false)
+    }
+
     // MARK: - Readback
     public func readback(buffer: BufferHandle, into dst: UnsafeMutableRawPointer, length: Int) throws {
+        let profile = SDLProfiler.begin("render.readback")
+        defer { profile.end() }
         #if canImport(CVulkan)
         guard let dev = device else { throw AgentError.internalError("Vulkan device not ready") }
         guard let srcRes = buffers[buffer], let srcBuffer = srcRes.buffer else {
-            throw AgentError.invalidArgument("Unknown buffer handle \(buffer.rawValue)")
+            throw AgentError.invalidArgument("\(buffers.missingDescription(buffer)) buffer handle \(buffer.rawValue)")
         }
         try ensureCommandPoolAndSync()
         // Create host-visible staging buffer
@@ -2366,19 +2898,278 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         throw AgentError.missingDependency("Vulkan headers unavailable; readback not supported in this build")
         #endif
     }
-    // MARK: - Vulkan init
-    private func initializeVulkan() throws {
-        // Query SDL-required instance extensions via the window’s native handles
-        let requiredExtensions: [String]
+    // MARK: - Asynchronous readback
+    public func enqueueReadback(buffer: BufferHandle, range requested: Range<Int>?) throws -> ReadbackToken<Data> {
+        let profile = SDLProfiler.begin("render.enqueueReadback")
+        defer { profile.end() }
+        guard let srcRes = buffers[buffer], let srcBuffer = srcRes.buffer else {
+            throw AgentError.invalidArgument("\(buffers.missingDescription(buffer)) buffer handle \(buffer.rawValue)")
+        }
+        let range = try Range<Int>.readbackRange(requested, length: srcRes.length)
+        guard !range.isEmpty else { return .resolved(Data()) }
+        try ensureCommandPoolAndSync()
+        let staging = try readbackStaging.acquire(length: range.count) { try makeReadbackStaging(capacity: $0) }
+        let serial = try submitReadback(staging: staging, context: "buffer") { cmd in
+            var toTransfer = VkMemoryBarrier()
+            toTransfer.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER
+            toTransfer.srcAccessMask = UInt32(VK_ACCESS_MEMORY_WRITE_BIT)
+            toTransfer.dstAccessMask = UInt32(VK_ACCESS_TRANSFER_READ_BIT)
+            recordComputeBarrier(cmd,
+                                 srcStage: UInt32(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT),
+                                 dstStage: UInt32(VK_PIPELINE_STAGE_TRANSFER_BIT),
+                                 memory: [toTransfer], buffers: [], images: [])
+            var region = VkBufferCopy(srcOffset: VkDeviceSize(range.lowerBound), dstOffset: 0, size: VkDeviceSize(range.count))
+            withUnsafePointer(to: &region) { rp in vkCmdCopyBuffer(cmd, srcBuffer, staging.allocation.buffer, 1, rp) }
+        }
+        let count = range.count
+        return trackReadback(serial) { Data(bytes: $0, count: count) }
+    }
+
+    public func enqueueReadback(texture: TextureHandle) throws -> ReadbackToken<GoldenImageCapture> {
+        let profile = SDLProfiler.begin("render.enqueueReadback")
+        defer { profile.end() }
+        guard let resource = textures[texture], let image = resource.image else {
+            throw AgentError.invalidArgument("\(textures.missingDescription(texture)) texture handle \(texture.rawValue)")
+        }
+        let width = resource.descriptor.width, height = resource.descriptor.height
+        let bytesPerRow = width * 4
+        let layout = GoldenImageCapture.PixelLayout(resource.descriptor.format)
+        // Never written: there is nothing to copy, and no layout to return the image to.
+        guard resource.layout != VK_IMAGE_LAYOUT_UNDEFINED else {
+            return .resolved(GoldenImageCapture(width: width, height: height, bytesPerRow: bytesPerRow, layout: layout,
+                                                data: Data(count: bytesPerRow * height)))
+        }
+        try ensureCommandPoolAndSync()
+        let staging = try readbackStaging.acquire(length: bytesPerRow * height) { try makeReadbackStaging(capacity: $0) }
+        let serial = try submitReadback(staging: staging, context: "texture") { cmd in
+            var barrier = VkImageMemoryBarrier()
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER
+            barrier.srcQueueFamilyIndex = UInt32(VK_QUEUE_FAMILY_IGNORED)
+            barrier.dstQueueFamilyIndex = UInt32(VK_QUEUE_FAMILY_IGNORED)
+            barrier.image = image
+            barrier.subresourceRange = VkImageSubresourceRange(aspectMask: resource.aspectMask, baseMipLevel: 0, levelCount: UInt32(max(1, resource.descriptor.mipLevels)), baseArrayLayer: 0, layerCount: 1)
+            barrier.oldLayout = resource.layout
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+            barrier.srcAccessMask = UInt32(VK_ACCESS_MEMORY_WRITE_BIT)
+            barrier.dstAccessMask = UInt32(VK_ACCESS_TRANSFER_READ_BIT)
+            recordComputeBarrier(cmd,
+                                 srcStage: UInt32(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT),
+                                 dstStage: UInt32(VK_PIPELINE_STAGE_TRANSFER_BIT),
+                                 memory: [], buffers: [], images: [barrier])
+
+            var region = VkBufferImageCopy()
+            region.imageSubresource = VkImageSubresourceLayers(aspectMask: resource.aspectMask, mipLevel: 0, baseArrayLayer: 0, layerCount: 1)
+            region.imageExtent = VkExtent3D(width: UInt32(width), height: UInt32(height), depth: 1)
+            withUnsafePointer(to: &region) { rptr in
+                vkCmdCopyImageToBuffer(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, staging.allocation.buffer, 1, rptr)
+            }
+
+            // Back to the tracked layout, so later work sees the texture as before.
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+            barrier.newLayout = resource.layout
+            barrier.srcAccessMask = 0
+            barrier.dstAccessMask = UInt32(VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT)
+            recordComputeBarrier(cmd,
+                                 srcStage: UInt32(VK_PIPELINE_STAGE_TRANSFER_BIT),
+                                 dstStage: UInt32(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT),
+                                 memory: [], buffers: [], images: [barrier])
+        }
+        return trackReadback(serial) { mapped in
+            GoldenImageCapture(width: width, height: height, bytesPerRow: bytesPerRow, layout: layout,
+                               data: Data(bytes: mapped, count: bytesPerRow * height))
+        }
+    }
+
+    public func enqueueFrameCapture() throws -> ReadbackToken<GoldenImageCapture> {
+        guard frameActive else {
+            throw AgentError.invalidArgument("enqueueFrameCapture must be called between beginFrame and endFrame")
+        }
+        // Several requests in one frame share its copy.
+        let request = pendingFrameCapture ?? FrameCaptureRequest()
+        pendingFrameCapture = request
+        let token = request.token()
+        pendingReadbacks.track(token)
+        return token
+    }
+
+    private func makeReadbackStaging(capacity: Int) throws -> ReadbackStagingBuffer {
+        guard let dev = device else { throw AgentError.internalError("Vulkan device not ready") }
+        var buffer: VkBuffer? = nil
+        var memory: VkDeviceMemory? = nil
+        try createBuffer(size: VkDeviceSize(capacity),
+                         usage: UInt32(VK_BUFFER_USAGE_TRANSFER_DST_BIT),
+                         properties: UInt32(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+                         bufferOut: &buffer,
+                         memoryOut: &memory)
+        // Staging stays mapped for its lifetime; completed copies are read straight out of it.
+        var mapped: UnsafeMutableRawPointer? = nil
+        let result = vkMapMemory(dev, memory, 0, VkDeviceSize(capacity), 0, &mapped)
+        let staging = ReadbackStagingBuffer(buffer: buffer, memory: memory, mapped: mapped)
+        guard result == VK_SUCCESS, mapped != nil else {
+            releaseReadbackStaging(staging, device: dev)
+            throw AgentError.internalError("vkMapMemory(readback staging) failed (res=\(result))")
+        }
+        return staging
+    }
+
+    private func releaseReadbackStaging(_ staging: ReadbackStagingBuffer, device dev: VkDevice) {
+        if let buffer = staging.buffer { vkDestroyBuffer(dev, buffer, nil) }
+        if let memory = staging.memory {
+            if staging.mapped != nil { vkUnmapMemory(dev, memory) }
+            vkFreeMemory(dev, memory, nil)
+        }
+    }
+
+    private func recycleReadbackStaging(_ entry: ReadbackStagingPool<ReadbackStagingBuffer>.Entry) {
+        guard let evicted = readbackStaging.recycle(entry), let dev = device else { return }
+        releaseReadbackStaging(evicted, device: dev)
+    }
+
+    /// Makes transfer writes into staging visible to the host once the submission's fence signals.
+    private func recordReadbackHostBarrier(_ cmd: VkCommandBuffer) {
+        var toHost = VkMemoryBarrier()
+        toHost.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER
+        toHost.srcAccessMask = UInt32(VK_ACCESS_TRANSFER_WRITE_BIT)
+        toHost.dstAccessMask = UInt32(VK_ACCESS_HOST_READ_BIT)
+        recordComputeBarrier(cmd,
+                             srcStage: UInt32(VK_PIPELINE_STAGE_TRANSFER_BIT),
+                             dstStage: UInt32(VK_PIPELINE_STAGE_HOST_BIT),
+                             memory: [toHost], buffers: [], images: [])
+    }
+
+    /// Records `body` plus the host barrier into a one-shot command buffer and submits it with
+    /// its own fence, without waiting. `staging` is recycled if anything fails.
+    private func submitReadback(staging: ReadbackStagingPool<ReadbackStagingBuffer>.Entry,
+                                context: String,
+                                _ body: (VkCommandBuffer) throws -> Void) throws -> UInt64 {
+        guard let dev = device, let pool = commandPool, let queue = graphicsQueue else {
+            recycleReadbackStaging(staging)
+            throw AgentError.internalError("Vulkan command context unavailable")
+        }
+        var alloc = VkCommandBufferAllocateInfo()
+        alloc.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO
+        alloc.commandPool = pool
+        alloc.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY
+        alloc.commandBufferCount = 1
+        var commandBuffer: VkCommandBuffer? = nil
+        let allocResult = withUnsafePointer(to: alloc) { ptr in vkAllocateCommandBuffers(dev, ptr, &commandBuffer) }
+        guard allocResult == VK_SUCCESS, let cmd = commandBuffer else {
+            recycleReadbackStaging(staging)
+            throw AgentError.internalError("vkAllocateCommandBuffers(readback \(context)) failed (res=\(allocResult))")
+        }
+        var fenceInfo = VkFenceCreateInfo()
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO
+        var fence: VkFence? = nil
+        let fenceResult = vkCreateFence(dev, &fenceInfo, nil, &fence)
+        let readback = InFlightReadback(fence: fence, commandBuffer: cmd, ownsFence: true, staging: staging)
+        guard fenceResult == VK_SUCCESS, fence != nil else {
+            finishReadbackSubmission(readback, device: dev)
+            recycleReadbackStaging(staging)
+            throw AgentError.internalError("vkCreateFence(readback \(context)) failed (res=\(fenceResult))")
+        }
+
+        var begin = VkCommandBufferBeginInfo()
+        begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO
+        begin.flags = UInt32(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT)
+        _ = withUnsafePointer(to: begin) { ptr in vkBeginCommandBuffer(cmd, ptr) }
         do {
-            requiredExtensions = try surface.handles.vulkanInstanceExtensions()
-        } catch AgentError.sdlUnavailable {
-            SDLLogger.warn("SDLKit.Graphics.Vulkan", "SDL unavailable; skipping Vulkan instance creation")
-            throw AgentError.sdlUnavailable
+            try body(cmd)
         } catch {
-            SDLLogger.warn("SDLKit.Graphics.Vulkan", "Failed to query Vulkan instance extensions: \(error)")
+            _ = vkEndCommandBuffer(cmd)
+            finishReadbackSubmission(readback, device: dev)
+            recycleReadbackStaging(staging)
             throw error
         }
+        recordReadbackHostBarrier(cmd)
+        _ = vkEndCommandBuffer(cmd)
+
+        var submit = VkSubmitInfo()
+        submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO
+        submit.commandBufferCount = 1
+        var cmdLocal: VkCommandBuffer? = cmd
+        let submitResult = withUnsafePointer(to: &cmdLocal) { cp -> VkResult in
+            submit.pCommandBuffers = cp
+            return withUnsafePointer(to: submit) { sp in vkQueueSubmit(queue, 1, sp, fence) }
+        }
+        if submitResult != VK_SUCCESS {
+            finishReadbackSubmission(readback, device: dev)
+            recycleReadbackStaging(staging)
+            if submitResult == VK_ERROR_DEVICE_LOST {
+                try handleDeviceLoss(context: "vkQueueSubmit(readback \(context))", result: submitResult)
+            }
+            throw AgentError.internalError("vkQueueSubmit(readback \(context)) failed (res=\(submitResult))")
+        }
+        return registerReadback(readback)
+    }
+
+    private func registerReadback(_ readback: InFlightReadback) -> UInt64 {
+        readbackSerial &+= 1
+        inFlightReadbacks[readbackSerial] = readback
+        return readbackSerial
+    }
+
+    private func trackReadback<Value>(_ serial: UInt64, produce: @escaping (UnsafeRawPointer) -> Value) -> ReadbackToken<Value> {
+        let token = ReadbackToken<Value>(
+            poll: { [weak self] in self?.isReadbackComplete(serial) ?? true },
+            resolve: { [weak self] in
+                guard let self else { throw AgentError.deviceLost("Vulkan backend released before the readback completed") }
+                return try self.completeReadback(serial, produce: produce)
+            }
+        )
+        pendingReadbacks.track(token)
+        return token
+    }
+
+    private func isReadbackComplete(_ serial: UInt64) -> Bool {
+        guard let dev = device, let readback = inFlightReadbacks[serial], let fence = readback.fence else { return true }
+        return vkGetFenceStatus(dev, fence) != VK_NOT_READY
+    }
+
+    /// Waits for the copy (normally already finished when polled), reads the staging memory
+    /// and returns it to the pool.
+    private func completeReadback<Value>(_ serial: UInt64, produce: (UnsafeRawPointer) -> Value) throws -> Value {
+        guard let dev = device, let readback = inFlightReadbacks.removeValue(forKey: serial) else {
+            throw AgentError.deviceLost("Vulkan device released before the readback completed")
+        }
+        var result = VK_SUCCESS
+        var fence: VkFence? = readback.fence
+        if fence != nil {
+            result = withUnsafePointer(to: &fence) { ptr in vkWaitForFences(dev, 1, ptr, VK_TRUE, UInt64.max) }
+        }
+        finishReadbackSubmission(readback, device: dev)
+        guard result == VK_SUCCESS, let mapped = readback.staging.allocation.mapped else {
+            releaseReadbackStaging(readback.staging.allocation, device: dev)
+            throw AgentError.deviceLost("vkWaitForFences(readback) returned \(result)")
+        }
+        let value = produce(UnsafeRawPointer(mapped))
+        recycleReadbackStaging(readback.staging)
+        return value
+    }
+
+    private func finishReadbackSubmission(_ readback: InFlightReadback, device dev: VkDevice) {
+        if let pool = commandPool, readback.commandBuffer != nil {
+            var cmd: VkCommandBuffer? = readback.commandBuffer
+            withUnsafePointer(to: &cmd) { ptr in vkFreeCommandBuffers(dev, pool, 1, ptr) }
+        }
+        if readback.ownsFence, let fence = readback.fence { vkDestroyFence(dev, fence, nil) }
+    }
+
+    // MARK: - Vulkan init
+    private func initializeVulkan() throws {
+        // Query SDL-required instance extensions via the window’s native handles;
+        // an offscreen instance needs none.
+        var requiredExtensions: [String] = []
+        if let surface {
+            do {
+                requiredExtensions = try surface.handles.vulkanInstanceExtensions()
+            } catch AgentError.sdlUnavailable {
+                SDLLogger.warn("SDLKit.Graphics.Vulkan", "SDL unavailable; skipping Vulkan instance creation")
+                throw AgentError.sdlUnavailable
+            } catch {
+                SDLLogger.warn("SDLKit.Graphics.Vulkan", "Failed to query Vulkan instance extensions: \(error)")
+                throw error
+            }
+        }
 
         var extensions = requiredExtensions
         var layers: [String] = []
@@ -2427,12 +3218,14 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         }
 
         // Create presentation surface via SDL
-        do {
-            vkSurface = try surface.createVulkanSurface(instance: vkInstance.handle)
-        } catch {
-            // Destroy instance on failure to avoid leaks
-            VulkanMinimalDestroyInstance(&vkInstance)
-            throw error
+        if let surface {
+            do {
+                vkSurface = try surface.createVulkanSurface(instance: vkInstance.handle)
+            } catch {
+                // Destroy instance on failure to avoid leaks
+                VulkanMinimalDestroyInstance(&vkInstance)
+                throw error
+            }
         }
 
         SDLLogger.info(
@@ -2480,6 +3273,16 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             qProps.withUnsafeMutableBufferPointer { buf in
                 vkGetPhysicalDeviceQueueFamilyProperties(pd, &qCount, buf.baseAddress)
             }
+            if isOffscreen {
+                // Nothing is presented; any graphics queue will do.
+                if let gi = (0..<qCount).first(where: { (qProps[Int($0)].queueFlags & UInt32(VK_QUEUE_GRAPHICS_BIT)) != 0 }) {
+                    chosenPhys = pd
+                    graphicsIndex = gi
+                    presentIndex = gi
+                    break outer
+                }
+                continue
+            }
             for i in 0..<qCount {
                 let props = qProps[Int(i)]
                 let supportsGraphics = (props.queueFlags & UInt32(VK_QUEUE_GRAPHICS_BIT)) != 0
@@ -2516,7 +3319,9 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         }
 
         guard let physicalDevice = chosenPhys else {
-            throw AgentError.internalError("No suitable Vulkan physical device with graphics+present found")
+            throw AgentError.internalError(isOffscreen
+                ? "No Vulkan physical device with a graphics queue found"
+                : "No suitable Vulkan physical device with graphics+present found")
         }
 
         // Create logical device with VK_KHR_swapchain
@@ -2555,9 +3360,9 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
             dci.pEnabledFeatures = feats
         }
 
-        // Enable swapchain extension
+        // Enable swapchain extension (not needed, and possibly absent, on headless devices)
         let swapchainExt = VK_KHR_SWAPCHAIN_EXTENSION_NAME
-        var extNames: [UnsafePointer<CChar>?] = [swapchainExt]
+        var extNames: [UnsafePointer<CChar>?] = isOffscreen ? [] : [swapchainExt]
 
         var deviceOpt: VkDevice? = nil
         res = queueCreateInfos.withUnsafeMutableBufferPointer { qciBuf in
@@ -2596,6 +3401,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         self.presentQueueFamilyIndex = presentIndex
         self.graphicsQueue = gq
         self.presentQueue = pq
+        createTimestampQueryPool(physicalDevice: physicalDevice, queueFamilyProperties: queueFamilyProperties(physicalDevice))
 
         SDLLogger.info(
             "SDLKit.Graphics.Vulkan",
@@ -2603,7 +3409,11 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         )
 
         // Create swapchain and render targets at initial size, then command/sync and builtin geometry
-        try recreateSwapchain(width: UInt32(window.config.width), height: UInt32(window.config.height))
+        if let window {
+            try recreateSwapchain(width: UInt32(window.config.width), height: UInt32(window.config.height))
+        } else {
+            try recreateOffscreenTargets(width: offscreenSize.width, height: offscreenSize.height)
+        }
         try ensureCommandPoolAndSync()
         try createBuiltinTriangleResources()
         do {
@@ -2794,6 +3604,89 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         SDLLogger.info("SDLKit.Graphics.Vulkan", "Swapchain created: images=\(swapchainImages.count) extent=\(surfaceExtent.width)x\(surfaceExtent.height)")
     }
 
+    private func recreateRenderTargets(width: UInt32, height: UInt32) throws {
+        if isOffscreen {
+            try recreateOffscreenTargets(width: width, height: height)
+        } else {
+            try recreateSwapchain(width: width, height: height)
+        }
+    }
+
+    /// Offscreen counterpart of `recreateSwapchain`: one device-local color image per frame in
+    /// flight, plus the shared depth target and framebuffers, at exactly the requested size.
+    private func recreateOffscreenTargets(width: UInt32, height: UInt32) throws {
+        guard let dev = device, let pd = physicalDevice else {
+            throw AgentError.internalError("Vulkan device not ready for offscreen targets")
+        }
+        // Frames in flight may still render into or copy out of the old targets.
+        _ = vkDeviceWaitIdle(dev)
+        destroySwapchainResources()
+
+        colorFormat = VK_FORMAT_B8G8R8A8_UNORM
+        surfaceExtent = VkExtent2D(width: max(1, width), height: max(1, height))
+        offscreenSize = (surfaceExtent.width, surfaceExtent.height)
+
+        var memProps = VkPhysicalDeviceMemoryProperties()
+        vkGetPhysicalDeviceMemoryProperties(pd, &memProps)
+        for _ in 0..<maxFramesInFlight {
+            var imgInfo = VkImageCreateInfo()
+            imgInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO
+            imgInfo.imageType = VK_IMAGE_TYPE_2D
+            imgInfo.extent = VkExtent3D(width: surfaceExtent.width, height: surfaceExtent.height, depth: 1)
+            imgInfo.mipLevels = 1
+            imgInfo.arrayLayers = 1
+            imgInfo.format = colorFormat
+            imgInfo.tiling = VK_IMAGE_TILING_OPTIMAL
+            imgInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+            imgInfo.usage = UInt32(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+            imgInfo.samples = VK_SAMPLE_COUNT_1_BIT
+            imgInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE
+            var img: VkImage? = nil
+            var res = withUnsafePointer(to: imgInfo) { ptr in
+                vkCreateImage(dev, ptr, nil, &img)
+            }
+            if res != VK_SUCCESS || img == nil { throw AgentError.internalError("vkCreateImage(offscreen color) failed (res=\(res))") }
+            swapchainImages.append(img)
+
+            var memReq = VkMemoryRequirements()
+            vkGetImageMemoryRequirements(dev, img, &memReq)
+            var alloc = VkMemoryAllocateInfo()
+            alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO
+            alloc.allocationSize = memReq.size
+            alloc.memoryTypeIndex = findMemoryTypeIndex(requirements: memReq, properties: memProps, required: UInt32(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT))
+            var memory: VkDeviceMemory? = nil
+            res = withUnsafePointer(to: alloc) { ptr in
+                vkAllocateMemory(dev, ptr, nil, &memory)
+            }
+            if res != VK_SUCCESS || memory == nil { throw AgentError.internalError("vkAllocateMemory(offscreen color) failed (res=\(res))") }
+            offscreenColorMemory.append(memory)
+            vkBindImageMemory(dev, img, memory, 0)
+
+            var viewInfo = VkImageViewCreateInfo()
+            viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO
+            viewInfo.image = img
+            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D
+            viewInfo.format = colorFormat
+            viewInfo.components = VkComponentMapping(r: VK_COMPONENT_SWIZZLE_IDENTITY, g: VK_COMPONENT_SWIZZLE_IDENTITY, b: VK_COMPONENT_SWIZZLE_IDENTITY, a: VK_COMPONENT_SWIZZLE_IDENTITY)
+            viewInfo.subresourceRange = VkImageSubresourceRange(aspectMask: UInt32(VK_IMAGE_ASPECT_COLOR_BIT), baseMipLevel: 0, levelCount: 1, baseArrayLayer: 0, layerCount: 1)
+            var view: VkImageView? = nil
+            res = withUnsafePointer(to: viewInfo) { ptr in
+                vkCreateImageView(dev, ptr, nil, &view)
+            }
+            if res != VK_SUCCESS || view == nil { throw AgentError.internalError("vkCreateImageView(offscreen color) failed (res=\(res))") }
+            swapchainImageViews.append(view)
+        }
+
+        depthFormat = pickSupportedDepthFormat(physicalDevice: pd)
+        try createDepthResources(device: dev, physicalDevice: pd)
+        if renderPass == nil {
+            try createRenderPass(device: dev)
+        }
+        try createFramebuffers(device: dev)
+
+        SDLLogger.info("SDLKit.Graphics.Vulkan", "Offscreen targets created: images=\(swapchainImages.count) extent=\(surfaceExtent.width)x\(surfaceExtent.height)")
+    }
+
     private func ensureCommandPoolAndSync() throws {
         guard let dev = device else { throw AgentError.internalError("Device not ready for command pool") }
         if commandPool == nil {
@@ -2861,6 +3754,20 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
 
         drainPendingComputeSubmissions(waitAll: true)
 
+        // Outstanding readbacks resolve (or fail) against the device they were recorded on.
+        pendingFrameCapture?.error = AgentError.deviceLost("Vulkan device released before the frame was submitted")
+        pendingFrameCapture = nil
+        pendingReadbacks.waitAll()
+        let cachedStaging = readbackStaging.drain()
+        if let dev = device {
+            for readback in inFlightReadbacks.values {
+                finishReadbackSubmission(readback, device: dev)
+                releaseReadbackStaging(readback.staging.allocation, device: dev)
+            }
+            for staging in cachedStaging { releaseReadbackStaging(staging, device: dev) }
+        }
+        inFlightReadbacks.removeAll()
+
         for frame in 0..<pendingComputeDescriptorSets.count {
             releasePendingComputeDescriptors(for: frame)
         }
@@ -2871,6 +3778,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
                 if let descriptor = submission.descriptor, var set = descriptor.set, let pool = descriptor.pool {
                     withUnsafePointer(to: &set) { ptr in _ = vkFreeDescriptorSets(dev, pool, 1, ptr) }
                 }
+                if let pool = submission.transientPool { vkDestroyDescriptorPool(dev, pool, nil) }
                 if let fence = submission.fence { vkDestroyFence(dev, fence, nil) }
                 if let pool = commandPool, let cmd = submission.commandBuffer {
                     withUnsafePointer(to: &cmd) { ptr in vkFreeCommandBuffers(dev, pool, 1, ptr) }
@@ -2879,6 +3787,12 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         }
         pendingOutOfFrameComputeSubmissions.removeAll()
 
+        if let dev = device, let pool = timestampQueryPool {
+            vkDestroyQueryPool(dev, pool, nil)
+        }
+        timestampQueryPool = nil
+        timestampRing.reset()
+
         destroySwapchainResources()
 
         if let dev = device {
@@ -3108,6 +4022,98 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         pendingComputeDescriptorSets[frameIndex] = descriptors
     }
 
+    // MARK: - GPU timestamps
+
+    private func queueFamilyProperties(_ physicalDevice: VkPhysicalDevice) -> [VkQueueFamilyProperties] {
+        var count: UInt32 = 0
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count, nil)
+        var props = Array<VkQueueFamilyProperties>(repeating: VkQueueFamilyProperties(), count: Int(count))
+        props.withUnsafeMutableBufferPointer { buf in
+            vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count, buf.baseAddress)
+        }
+        return props
+    }
+
+    /// Creates the timestamp pool, or marks timing unsupported when the graphics queue reports
+    /// no valid timestamp bits (some software implementations).
+    private func createTimestampQueryPool(physicalDevice: VkPhysicalDevice, queueFamilyProperties: [VkQueueFamilyProperties]) {
+        guard let dev = device else { return }
+        var properties = VkPhysicalDeviceProperties()
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties)
+        let family = Int(graphicsQueueFamilyIndex)
+        let validBits = family < queueFamilyProperties.count ? Int(queueFamilyProperties[family].timestampValidBits) : 0
+        let period = Double(properties.limits.timestampPeriod)
+        guard validBits > 0, period > 0 else {
+            core.gpuTimings.timestampsSupported = false
+            SDLLogger.info("SDLKit.Graphics.Vulkan", "Timestamp queries unsupported on graphics queue; GPU timing scopes disabled")
+            return
+        }
+
+        let ring = GPUTimestampRing(frameSlots: maxFramesInFlight)
+        var info = VkQueryPoolCreateInfo()
+        info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO
+        info.queryType = VK_QUERY_TYPE_TIMESTAMP
+        info.queryCount = UInt32(ring.queryCount)
+        var pool: VkQueryPool? = nil
+        let res = withUnsafePointer(to: info) { ptr in vkCreateQueryPool(dev, ptr, nil, &pool) }
+        guard res == VK_SUCCESS, pool != nil else {
+            core.gpuTimings.timestampsSupported = false
+            SDLLogger.warn("SDLKit.Graphics.Vulkan", "vkCreateQueryPool(timestamp) failed (res=\(res)); GPU timing scopes disabled")
+            return
+        }
+        timestampQueryPool = pool
+        timestampRing = ring
+        timestampPeriod = period
+        timestampValidBits = validBits
+        core.gpuTimings.timestampsSupported = true
+    }
+
+    /// Reads the results left in this frame slot's range by its previous submission (already
+    /// fenced), resets the range and opens the frame scope. Must run outside a render pass.
+    private func beginTimestampFrame(_ cmd: VkCommandBuffer) {
+        guard let pool = timestampQueryPool else { return }
+        resolveTimestampScopes(timestampRing.beginFrame(slot: currentFrame))
+        let range = timestampRing.frameQueryRange(currentFrame)
+        vkCmdResetQueryPool(cmd, pool, range.first, range.count)
+        if let query = timestampRing.beginScope(GPUTimingLabel.frame) {
+            writeTimestamp(cmd, query: query, stage: VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT)
+        }
+    }
+
+    private func writeTimestamp(_ cmd: VkCommandBuffer?, query: UInt32, stage: VkPipelineStageFlagBits) {
+        guard let cmd, let pool = timestampQueryPool else { return }
+        vkCmdWriteTimestamp(cmd, stage, pool, query)
+    }
+
+    private func resolveTimestampScopes(_ scopes: [GPUTimestampRing.Scope]) {
+        guard let dev = device, let pool = timestampQueryPool, !scopes.isEmpty else { return }
+        let first = scopes.reduce(UInt32.max) { min($0, $1.begin) }
+        let last = scopes.reduce(UInt32(0)) { max($0, $1.end) }
+        let count = Int(last - first) + 1
+        // Each query yields a 64-bit value followed by a 64-bit availability word.
+        var results = [UInt64](repeating: 0, count: count * 2)
+        let flags = UInt32(VK_QUERY_RESULT_64_BIT.rawValue | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT.rawValue)
+        let res = results.withUnsafeMutableBytes { raw in
+            vkGetQueryPoolResults(dev, pool, first, UInt32(count), raw.count, raw.baseAddress, VkDeviceSize(16), flags)
+        }
+        guard res == VK_SUCCESS || res == VK_NOT_READY else { return }
+        let samples = GPUTimestampRing.durations(of: scopes, nanosecondsPerTick: timestampPeriod, validBits: timestampValidBits) { query in
+            let index = Int(query - first) * 2
+            return results[index + 1] != 0 ? results[index] : nil
+        }
+        core.gpuTimings.record(samples)
+    }
+
+    public func beginGPUScope(_ label: String) {
+        guard frameActive, timestampQueryPool != nil, let query = timestampRing.beginScope(label) else { return }
+        writeTimestamp(commandBuffers[currentFrame], query: query, stage: VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT)
+    }
+
+    public func endGPUScope() {
+        guard frameActive, timestampQueryPool != nil, let query = timestampRing.endScope() else { return }
+        writeTimestamp(commandBuffers[currentFrame], query: query, stage: VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT)
+    }
+
     private func drainPendingComputeSubmissions(waitAll: Bool) {
         guard let dev = device else { return }
         var remaining: [PendingComputeSubmission] = []
@@ -3119,9 +4125,13 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
                 if status != VK_SUCCESS {
                     withUnsafePointer(to: &fence) { ptr in _ = vkWaitForFences(dev, 1, ptr, VK_TRUE, UInt64.max) }
                 }
+                if let scope = submission.timestamps {
+                    resolveTimestampScopes([scope])
+                }
                 if let descriptor = submission.descriptor, var set = descriptor.set, let pool = descriptor.pool {
                     withUnsafePointer(to: &set) { ptr in _ = vkFreeDescriptorSets(dev, pool, 1, ptr) }
                 }
+                if let pool = submission.transientPool { vkDestroyDescriptorPool(dev, pool, nil) }
                 if let pool = commandPool, let cmd = submission.commandBuffer {
                     withUnsafePointer(to: &cmd) { ptr in vkFreeCommandBuffers(dev, pool, 1, ptr) }
                 }
@@ -3244,6 +4254,8 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         if hasInitialData {
             flags |= UInt32(VK_IMAGE_USAGE_TRANSFER_DST_BIT)
         }
+        // Any texture can be read back with enqueueReadback(texture:).
+        flags |= UInt32(VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
         return (flags, layout)
     }
 
@@ -3504,7 +4516,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE
         colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE
         colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
-        colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+        colorAttachment.finalLayout = colorTargetFinalLayout
 
         // Depth attachment
         var depthAttachment = VkAttachmentDescription()
@@ -3707,10 +4719,43 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         if let di = depthImage { vkDestroyImage(dev, di, nil); depthImage = nil }
         if let dm = depthMemory { vkFreeMemory(dev, dm, nil); depthMemory = nil }
         if let sc = swapchain { vkDestroySwapchainKHR(dev, sc, nil); swapchain = nil }
+        if isOffscreen {
+            // Offscreen targets are ours to destroy; swapchain images belong to the swapchain.
+            for image in swapchainImages { if let image { vkDestroyImage(dev, image, nil) } }
+        }
+        for memory in offscreenColorMemory { if let memory { vkFreeMemory(dev, memory, nil) } }
+        offscreenColorMemory.removeAll()
         swapchainImages.removeAll()
     }
     #endif
 }
+
+extension VulkanRenderBackend: RenderStateCounting {
+    public var stateCounters: RenderStateCounters {
+        #if canImport(CVulkan)
+        return bindTracker.counters
+        #else
+        return core.stateCounters
+        #endif
+    }
+}
+
+extension VulkanRenderBackend {
+    public var frameArena: FrameArena? {
+        #if canImport(CVulkan)
+        return payloadArena
+        #else
+        return core.frameArena
+        #endif
+    }
+}
+
+extension VulkanRenderBackend: ComputeCommandListSubmitting {}
+extension VulkanRenderBackend: AsyncReadbackProviding {}
+
+extension VulkanRenderBackend: GPUTimingProfiling {
+    public var gpuTimings: GPUTimingAggregator { core.gpuTimings }
+}
 #else
 @MainActor
 public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
@@ -3720,6 +4765,10 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         throw AgentError.missingDependency(missingVulkanDependencyMessage)
     }
 
+    public init(offscreenWidth width: Int, height: Int) throws {
+        throw AgentError.missingDependency(missingVulkanDependencyMessage)
+    }
+
     private func missingDependencyError() -> AgentError {
         AgentError.missingDependency(missingVulkanDependencyMessage)
     }
@@ -3807,6 +4856,7 @@ public final class VulkanRenderBackend: RenderBackend, GoldenImageCapturable {
         let meshCount: Int
         let graphicsPipelineCount: Int
         let computePipelineCount: Int
+        let recovery: ResourceRecoveryLedger.Stats
     }
 
     internal func debugResourceInventory() -> DebugResourceInventory {
@@ -31,6 +31,37 @@ public enum SDLKitConfig {
         return parsed
     }
 
+    /// Byte budget for each renderer's texture cache (`texture.cache.budget_mb` setting or
+    /// `SDLKIT_TEXTURE_BUDGET_MB`, in megabytes; 256 by default).
+    public static var textureCacheBudgetBytes: Int {
+        let defaultValue = 256
+        var megabytes = defaultValue
+        if let s = SettingsStore.getString("texture.cache.budget_mb"),
+           let parsed = Int(s.trimmingCharacters(in: .whitespacesAndNewlines)), parsed > 0 {
+            megabytes = parsed
+        } else if let raw = ProcessInfo.processInfo.environment["SDLKIT_TEXTURE_BUDGET_MB"],
+                  let parsed = Int(raw.trimmingCharacters(in: .whitespacesAndNewlines)), parsed > 0 {
+            megabytes = parsed
+        }
+        return megabytes << 20
+    }
+
+    /// Byte budget for host copies kept to restore resources after device loss, shared by every
+    /// backend (`render.recovery.shadow_budget_mb` setting or `SDLKIT_SHADOW_BUDGET_MB`, in
+    /// megabytes; 256 by default).
+    public static var shadowCopyBudgetBytes: Int {
+        let defaultValue = 256
+        var megabytes = defaultValue
+        if let s = SettingsStore.getString("render.recovery.shadow_budget_mb"),
+           let parsed = Int(s.trimmingCharacters(in: .whitespacesAndNewlines)), parsed >= 0 {
+            megabytes = parsed
+        } else if let raw = ProcessInfo.processInfo.environment["SDLKIT_SHADOW_BUDGET_MB"],
+                  let parsed = Int(raw.trimmingCharacters(in: .whitespacesAndNewlines)), parsed >= 0 {
+            megabytes = parsed
+        }
+        return megabytes << 20
+    }
+
     public static var renderBackendOverride: String? {
         // Prefer persisted setting; fallback to env
         if let s = SettingsStore.getString("render.backend.override"), !s.trimmingCharacters(in: .whitespacesAndNewlines).isEmpty {
@@ -0,0 +1,138 @@
+import Foundation
+
+/// 64-bit draw sort key. Fields from most to least significant:
+///
+///     opaque:      pass (2 bits) | pipeline (12) | material (16) | mesh (16) | depth (18)
+///     transparent: pass (2 bits) | inverted depth (18) | pipeline (12) | material (16) | mesh (16)
+///
+/// Pipeline, material and mesh are small per-frame ordinals, so opaque sorting groups
+/// draws that share state and orders each group front to back. Blended draws must
+/// composite back to front whatever their state, so depth leads and state only breaks ties.
+public struct DrawSortKey: Comparable, Hashable, Sendable {
+    public enum Pass: UInt64, Sendable {
+        case opaque = 0
+        case transparent = 1
+    }
+
+    public let rawValue: UInt64
+
+    public init(rawValue: UInt64) { self.rawValue = rawValue }
+
+    public init(pass: Pass, pipeline: Int, material: Int, mesh: Int, depth: Float) {
+        let depthBits = DrawSortKey.quantize(depth: depth)
+        let state = (UInt64(pipeline) & 0xFFF) << 32
+            | (UInt64(material) & 0xFFFF) << 16
+            | (UInt64(mesh) & 0xFFFF)
+        switch pass {
+        case .opaque:
+            rawValue = pass.rawValue << 62 | state << 18 | depthBits
+        case .transparent:
+            rawValue = pass.rawValue << 62 | (DrawSortKey.depthMask - depthBits) << 44 | state
+        }
+    }
+
+    public var pass: Pass { Pass(rawValue: rawValue >> 62) ?? .opaque }
+    public var pipeline: Int { Int((stateBits >> 32) & 0xFFF) }
+    public var material: Int { Int((stateBits >> 16) & 0xFFFF) }
+    public var mesh: Int { Int(stateBits & 0xFFFF) }
+
+    // Pipeline, material and mesh packed as 44 bits, wherever the pass put them.
+    private var stateBits: UInt64 {
+        pass == .transparent ? rawValue & ((1 << 44) - 1) : (rawValue >> 18) & ((1 << 44) - 1)
+    }
+
+    public static func < (lhs: DrawSortKey, rhs: DrawSortKey) -> Bool { lhs.rawValue < rhs.rawValue }
+
+    static let depthMask: UInt64 = (1 << 18) - 1
+
+    // Non-negative IEEE floats order the same as their bit patterns; keep the top
+    // 18 bits (8 exponent + 9 mantissa, sign is always zero) for ~0.2% precision.
+    static func quantize(depth: Float) -> UInt64 {
+        let clamped = depth.isFinite ? max(0, depth) : (depth > 0 ? Float.greatestFiniteMagnitude : 0)
+        return UInt64(clamped.bitPattern >> 13) & depthMask
+    }
+}
+
+/// Flat per-frame draw list. Items are appended in any order and submitted in
+/// ascending key order (stable, so equal keys keep their insertion order).
+struct DrawList {
+    struct Item {
+        var key: DrawSortKey
+        var mesh: MeshHandle
+        var pipeline: PipelineHandle
+        var bindings: BindingSet
+        var transform: float4x4
+    }
+
+    private(set) var items: [Item] = []
+    /// Submission order produced by `sort()`: indices into `items`.
+    private(set) var order: [Int] = []
+    // Sort scratch kept across frames so a steady-state frame does not reallocate.
+    private var keys: [UInt64] = []
+    private var scratch: [Int] = []
+    private var histogram: [Int] = []
+
+    var isEmpty: Bool { items.isEmpty }
+    var count: Int { items.count }
+
+    mutating func append(_ item: Item) { items.append(item) }
+
+    mutating func removeAll() {
+        items.removeAll(keepingCapacity: true)
+        order.removeAll(keepingCapacity: true)
+    }
+
+    /// Fills `order` with the indices of `items` in ascending key order.
+    mutating func sort() {
+        keys.removeAll(keepingCapacity: true)
+        for item in items { keys.append(item.key.rawValue) }
+        DrawList.radixSort(keys, order: &order, scratch: &scratch, histogram: &histogram)
+    }
+
+    static func radixSort(_ keys: [UInt64]) -> [Int] {
+        var order: [Int] = []
+        var scratch: [Int] = []
+        var histogram: [Int] = []
+        radixSort(keys, order: &order, scratch: &scratch, histogram: &histogram)
+        return order
+    }
+
+    /// Stable LSD radix sort over 8-bit digits. Digits on which every key agrees
+    /// are skipped, which drops most passes for small lists with few pipelines.
+    static func radixSort(_ keys: [UInt64], order: inout [Int], scratch: inout [Int], histogram: inout [Int]) {
+        let count = keys.count
+        order.removeAll(keepingCapacity: true)
+        order.append(contentsOf: 0..<count)
+        guard count > 1 else { return }
+        if scratch.count < count {
+            scratch.append(contentsOf: repeatElement(0, count: count - scratch.count))
+        }
+        if histogram.count != 256 {
+            histogram = [Int](repeating: 0, count: 256)
+        }
+        var differing: UInt64 = 0
+        let first = keys[0]
+        for key in keys { differing |= key ^ first }
+
+        var shift: UInt64 = 0
+        while shift < 64 {
+            defer { shift += 8 }
+            guard (differing >> shift) & 0xFF != 0 else { continue }
+            for i in 0..<256 { histogram[i] = 0 }
+            for key in keys { histogram[Int((key >> shift) & 0xFF)] += 1 }
+            var running = 0
+            for i in 0..<256 {
+                let c = histogram[i]
+                histogram[i] = running
+                running += c
+            }
+            for i in 0..<count {
+                let index = order[i]
+                let digit = Int((keys[index] >> shift) & 0xFF)
+                scratch[histogram[digit]] = index
+                histogram[digit] += 1
+            }
+            for i in 0..<count { order[i] = scratch[i] }
+        }
+    }
+}
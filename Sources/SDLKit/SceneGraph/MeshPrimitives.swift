@@ -1,11 +1,32 @@
 import Foundation
 
+// Meshes are created with `.regenerate`: the geometry is cheap to rebuild from its size, so
+// a device reset restores it without holding a shadow copy against the budget.
 @MainActor
 public enum MeshFactory {
+    private struct V { var px: Float; var py: Float; var pz: Float; var nx: Float; var ny: Float; var nz: Float; var r: Float; var g: Float; var b: Float }
+
     public static func makeLitPlane(backend: RenderBackend, size: Float = 1.0) throws -> Mesh {
+        try makeMesh(backend: backend) { litPlaneVertices(size: size) }
+    }
+
+    public static func makeLitCube(backend: RenderBackend, size: Float = 1.0) throws -> Mesh {
+        try makeMesh(backend: backend) { litCubeVertices(size: size) }
+    }
+
+    private static func makeMesh(backend: RenderBackend, vertices: @escaping @MainActor () -> [V]) throws -> Mesh {
+        let verts = vertices()
+        let vb = try verts.withUnsafeBytes { buf in
+            try backend.createBuffer(bytes: buf.baseAddress, length: buf.count, usage: .vertex,
+                                     recovery: .regenerate { [vertices().withUnsafeBytes { Data($0) }] })
+        }
+        let bounds = verts.withUnsafeBytes { BoundingBox(vertexBytes: $0, stride: MemoryLayout<V>.stride) }
+        return Mesh(vertexBuffer: vb, vertexCount: verts.count, localBounds: bounds)
+    }
+
+    private static func litPlaneVertices(size: Float) -> [V] {
         let hs = size * 0.5
-        struct V { var px: Float; var py: Float; var pz: Float; var nx: Float; var ny: Float; var nz: Float; var r: Float; var g: Float; var b: Float }
-        let verts: [V] = [
+        return [
             V(px: -hs, py: -hs, pz: 0, nx: 0, ny: 0, nz: 1, r: 1, g: 1, b: 1),
             V(px:  hs, py: -hs, pz: 0, nx: 0, ny: 0, nz: 1, r: 1, g: 1, b: 1),
             V(px:  hs, py:  hs, pz: 0, nx: 0, ny: 0, nz: 1, r: 1, g: 1, b: 1),
@@ -13,16 +34,11 @@ public enum MeshFactory {
             V(px:  hs, py:  hs, pz: 0, nx: 0, ny: 0, nz: 1, r: 1, g: 1, b: 1),
             V(px: -hs, py:  hs, pz: 0, nx: 0, ny: 0, nz: 1, r: 1, g: 1, b: 1)
         ]
-        let vb = try verts.withUnsafeBytes { buf in
-            try backend.createBuffer(bytes: buf.baseAddress, length: buf.count, usage: .vertex)
-        }
-        return Mesh(vertexBuffer: vb, vertexCount: verts.count)
     }
 
-    public static func makeLitCube(backend: RenderBackend, size: Float = 1.0) throws -> Mesh {
+    private static func litCubeVertices(size: Float) -> [V] {
         let hs = size * 0.5
         // 6 faces, each with 2 triangles, 6 vertices per face => 36
-        struct V { var px: Float; var py: Float; var pz: Float; var nx: Float; var ny: Float; var nz: Float; var r: Float; var g: Float; var b: Float }
         var verts: [V] = []
         func face(_ nx: Float, _ ny: Float, _ nz: Float, _ corners: [(Float, Float, Float)], _ color: (Float, Float, Float)) {
             let (r,g,b) = color
@@ -47,11 +63,7 @@ public enum MeshFactory {
         face(0,1,0, [(-hs,hs,-hs),(-hs,hs,hs),(hs,hs,hs),(hs,hs,-hs)], (1,0,1))
         // -Y face
         face(0,-1,0, [(-hs,-hs,-hs),(hs,-hs,-hs),(hs,-hs,hs),(-hs,-hs,hs)], (0,1,1))
-
-        let vb = try verts.withUnsafeBytes { buf in
-            try backend.createBuffer(bytes: buf.baseAddress, length: buf.count, usage: .vertex)
-        }
-        return Mesh(vertexBuffer: vb, vertexCount: verts.count)
+        return verts
     }
 }
 
@@ -0,0 +1,261 @@
+import Foundation
+
+// MARK: - Bounds
+
+/// Axis-aligned bounding box. An empty box has `min > max` on every axis.
+public struct BoundingBox: Equatable, Sendable {
+    public var min: SIMD3<Float>
+    public var max: SIMD3<Float>
+
+    public init(min: SIMD3<Float>, max: SIMD3<Float>) {
+        self.min = min
+        self.max = max
+    }
+
+    public static var empty: BoundingBox {
+        BoundingBox(min: SIMD3(repeating: .infinity), max: SIMD3(repeating: -.infinity))
+    }
+
+    public init<S: Sequence>(points: S) where S.Element == SIMD3<Float> {
+        self = .empty
+        for p in points { include(p) }
+    }
+
+    /// Computes bounds from interleaved vertex data whose position is three floats
+    /// at `positionOffset` inside each `stride`-byte vertex.
+    public init(vertexBytes: UnsafeRawBufferPointer, stride: Int, positionOffset: Int = 0) {
+        self = .empty
+        guard stride > 0, let base = vertexBytes.baseAddress else { return }
+        let posSize = MemoryLayout<Float>.size * 3
+        var offset = positionOffset
+        while offset + posSize <= vertexBytes.count {
+            let x = base.loadUnaligned(fromByteOffset: offset, as: Float.self)
+            let y = base.loadUnaligned(fromByteOffset: offset + 4, as: Float.self)
+            let z = base.loadUnaligned(fromByteOffset: offset + 8, as: Float.self)
+            include(SIMD3(x, y, z))
+            offset += stride
+        }
+    }
+
+    public var isEmpty: Bool { any(min .> max) }
+    public var center: SIMD3<Float> { (min + max) * 0.5 }
+    public var extents: SIMD3<Float> { (max - min) * 0.5 }
+
+    public var surfaceArea: Float {
+        guard !isEmpty else { return 0 }
+        let d = max - min
+        return 2 * (d.x * d.y + d.y * d.z + d.z * d.x)
+    }
+
+    public mutating func include(_ p: SIMD3<Float>) {
+        min = pointwiseMin(min, p)
+        max = pointwiseMax(max, p)
+    }
+
+    public func union(_ other: BoundingBox) -> BoundingBox {
+        BoundingBox(min: pointwiseMin(min, other.min), max: pointwiseMax(max, other.max))
+    }
+
+    /// Bounds of this box after an affine transform (centre/extent form, no corner loop).
+    public func transformed(by m: float4x4) -> BoundingBox {
+        guard !isEmpty else { return self }
+        let c = m.transformPoint(center)
+        let e = extents
+        let ax = SIMD3(abs(m.c0.x), abs(m.c0.y), abs(m.c0.z))
+        let ay = SIMD3(abs(m.c1.x), abs(m.c1.y), abs(m.c1.z))
+        let az = SIMD3(abs(m.c2.x), abs(m.c2.y), abs(m.c2.z))
+        let r = ax * e.x + ay * e.y + az * e.z
+        return BoundingBox(min: c - r, max: c + r)
+    }
+}
+
+// MARK: - Frustum
+
+/// Six normalized planes (xyz = inward normal, w = distance) extracted from a
+/// column-vector clip transform (`clip = matrix * point`, depth in [0, 1]).
+public struct Frustum: Sendable {
+    public enum Containment { case outside, intersecting, inside }
+
+    public var planes: [SIMD4<Float>]
+
+    public init(clipFromWorld m: float4x4) {
+        let r0 = SIMD4(m.c0.x, m.c1.x, m.c2.x, m.c3.x)
+        let r1 = SIMD4(m.c0.y, m.c1.y, m.c2.y, m.c3.y)
+        let r2 = SIMD4(m.c0.z, m.c1.z, m.c2.z, m.c3.z)
+        let r3 = SIMD4(m.c0.w, m.c1.w, m.c2.w, m.c3.w)
+        let raw = [r3 + r0, r3 - r0, r3 + r1, r3 - r1, r2, r3 - r2]
+        planes = raw.map { p in
+            let len = (p.x * p.x + p.y * p.y + p.z * p.z).squareRoot()
+            return len > 0 ? p / len : p
+        }
+    }
+
+    public func classify(_ box: BoundingBox) -> Containment {
+        guard !box.isEmpty else { return .outside }
+        let c = box.center
+        let e = box.extents
+        var result = Containment.inside
+        for p in planes {
+            let n = SIMD3(p.x, p.y, p.z)
+            let d = (n * c).sum() + p.w
+            let r = (SIMD3(abs(n.x), abs(n.y), abs(n.z)) * e).sum()
+            if d < -r { return .outside }
+            if d < r { result = .intersecting }
+        }
+        return result
+    }
+}
+
+public extension Camera {
+    /// Culling frustum for this camera, from the same `clipFromWorld` the renderer uploads.
+    var frustum: Frustum { Frustum(clipFromWorld: clipFromWorld) }
+}
+
+// MARK: - Stats
+
+/// Per-frame visibility counters published by `SceneGraphRenderer`.
+public struct SceneCullingStats: Equatable, Sendable {
+    /// Nodes with both a mesh and a material.
+    public var drawableCount: Int = 0
+    public var visibleCount: Int = 0
+    public var culledCount: Int = 0
+    /// Drawables without mesh bounds; these are never culled.
+    public var unboundedCount: Int = 0
+    public var bvhRefitted: Bool = false
+    public var bvhRebuilt: Bool = false
+    public init() {}
+}
+
+// MARK: - Dynamic BVH
+
+/// Bounding volume hierarchy over scene drawables. Leaves are refit in place
+/// when nodes move; the tree is rebuilt when the drawable set changes or when
+/// refitting has inflated the total internal surface area past
+/// `rebuildSurfaceAreaRatio` times the value at the last build.
+final class SceneBVH {
+    struct Node {
+        var bounds: BoundingBox
+        var left: Int32
+        var right: Int32
+        // Range into `leafOrder` covered by this subtree.
+        var leafStart: Int32
+        var leafCount: Int32
+    }
+
+    var rebuildSurfaceAreaRatio: Float = 2.0
+    private(set) var nodes: [Node] = []
+    private(set) var rebuildCount = 0
+    private(set) var refitCount = 0
+
+    private var leafIDs: [ObjectIdentifier] = []
+    private var leafBounds: [BoundingBox] = []
+    private var leafOrder: [Int32] = []
+    private var builtSurfaceArea: Float = 0
+
+    /// Brings the tree up to date with `bounds` (indexed like `ids`).
+    /// Returns which maintenance step was needed.
+    @discardableResult
+    func update(ids: [ObjectIdentifier], bounds: [BoundingBox]) -> (refitted: Bool, rebuilt: Bool) {
+        if ids != leafIDs {
+            leafIDs = ids
+            leafBounds = bounds
+            rebuild()
+            return (false, true)
+        }
+        guard bounds != leafBounds else { return (false, false) }
+        leafBounds = bounds
+        let area = refit()
+        if builtSurfaceArea > 0, area > builtSurfaceArea * rebuildSurfaceAreaRatio {
+            rebuild()
+            return (false, true)
+        }
+        return (true, false)
+    }
+
+    /// Marks `visible[i] = true` for every leaf whose bounds touch the frustum.
+    func query(_ frustum: Frustum, visible: inout [Bool]) {
+        guard !nodes.isEmpty else { return }
+        var stack: [Int32] = [0]
+        stack.reserveCapacity(64)
+        while let index = stack.popLast() {
+            let node = nodes[Int(index)]
+            switch frustum.classify(node.bounds) {
+            case .outside:
+                continue
+            case .inside:
+                markAll(node, visible: &visible)
+            case .intersecting:
+                if node.left < 0 {
+                    markAll(node, visible: &visible)
+                } else {
+                    stack.append(node.left)
+                    stack.append(node.right)
+                }
+            }
+        }
+    }
+
+    private func markAll(_ node: Node, visible: inout [Bool]) {
+        let start = Int(node.leafStart)
+        for i in start..<(start + Int(node.leafCount)) {
+            visible[Int(leafOrder[i])] = true
+        }
+    }
+
+    private func rebuild() {
+        nodes.removeAll(keepingCapacity: true)
+        leafOrder = (0..<Int32(leafBounds.count)).map { $0 }
+        if !leafOrder.isEmpty {
+            nodes.reserveCapacity(leafOrder.count * 2)
+            _ = build(start: 0, count: leafOrder.count)
+        }
+        builtSurfaceArea = internalSurfaceArea()
+        rebuildCount += 1
+    }
+
+    // Top-down median split along the longest centroid axis. Nodes are emitted
+    // in pre-order, so every child has a larger index than its parent.
+    private func build(start: Int, count: Int) -> Int32 {
+        var bounds = BoundingBox.empty
+        var centroids = BoundingBox.empty
+        for i in start..<(start + count) {
+            let b = leafBounds[Int(leafOrder[i])]
+            bounds = bounds.union(b)
+            centroids.include(b.center)
+        }
+        let index = Int32(nodes.count)
+        nodes.append(Node(bounds: bounds, left: -1, right: -1, leafStart: Int32(start), leafCount: Int32(count)))
+        guard count > 1 else { return index }
+
+        let span = centroids.max - centroids.min
+        let axis = span.x >= span.y && span.x >= span.z ? 0 : (span.y >= span.z ? 1 : 2)
+        leafOrder[start..<(start + count)].sort { a, b in
+            leafBounds[Int(a)].center[axis] < leafBounds[Int(b)].center[axis]
+        }
+        let half = count / 2
+        let left = build(start: start, count: half)
+        let right = build(start: start + half, count: count - half)
+        nodes[Int(index)].left = left
+        nodes[Int(index)].right = right
+        return index
+    }
+
+    private func refit() -> Float {
+        var area: Float = 0
+        for i in stride(from: nodes.count - 1, through: 0, by: -1) {
+            let node = nodes[i]
+            if node.left < 0 {
+                nodes[i].bounds = leafBounds[Int(leafOrder[Int(node.leafStart)])]
+            } else {
+                nodes[i].bounds = nodes[Int(node.left)].bounds.union(nodes[Int(node.right)].bounds)
+                area += nodes[i].bounds.surfaceArea
+            }
+        }
+        refitCount += 1
+        return area
+    }
+
+    private func internalSurfaceArea() -> Float {
+        nodes.reduce(0) { $1.left < 0 ? $0 : $0 + $1.bounds.surfaceArea }
+    }
+}
@@ -4,18 +4,24 @@ public struct MaterialParams: Equatable {
     public var lightDirection: (Float, Float, Float)?
     public var baseColor: (Float, Float, Float, Float)?
     public var texture: TextureHandle?
+    /// Draw in the blended pass, back to front after opaque geometry. `baseColor`'s alpha
+    /// does not imply this: the shaders read it as the has-texture flag.
+    public var isTransparent: Bool
     public init(lightDirection: (Float, Float, Float)? = nil,
                 baseColor: (Float, Float, Float, Float)? = nil,
-                texture: TextureHandle? = nil) {
+                texture: TextureHandle? = nil,
+                isTransparent: Bool = false) {
         self.lightDirection = lightDirection
         self.baseColor = baseColor
         self.texture = texture
+        self.isTransparent = isTransparent
     }
 
     public static func == (lhs: MaterialParams, rhs: MaterialParams) -> Bool {
         Self.vec3Equal(lhs.lightDirection, rhs.lightDirection) &&
         Self.vec4Equal(lhs.baseColor, rhs.baseColor) &&
-        lhs.texture == rhs.texture
+        lhs.texture == rhs.texture &&
+        lhs.isTransparent == rhs.isTransparent
     }
 
     private static func vec3Equal(_ lhs: (Float, Float, Float)?, _ rhs: (Float, Float, Float)?) -> Bool {
@@ -70,14 +76,18 @@ public struct Mesh {
         didSet { registrationCache = nil }
     }
 
+    /// Object-space bounds used for frustum culling. Meshes without bounds are always drawn.
+    public var localBounds: BoundingBox?
+
     fileprivate var registrationCache: MeshRegistrationCache?
 
-    public init(vertexBuffer: BufferHandle, vertexCount: Int, indexBuffer: BufferHandle? = nil, indexCount: Int = 0, indexFormat: IndexFormat = .uint16) {
+    public init(vertexBuffer: BufferHandle, vertexCount: Int, indexBuffer: BufferHandle? = nil, indexCount: Int = 0, indexFormat: IndexFormat = .uint16, localBounds: BoundingBox? = nil) {
         self.vertexBuffer = vertexBuffer
         self.vertexCount = vertexCount
         self.indexBuffer = indexBuffer
         self.indexCount = indexCount
         self.indexFormat = indexFormat
+        self.localBounds = localBounds
         self.registrationCache = nil
     }
 
@@ -115,9 +125,13 @@ public final class SceneNode {
     public var name: String
     public var localTransform: float4x4
     public private(set) var worldTransform: float4x4
+    /// World-space bounds of this node's mesh, refreshed by `updateWorldTransform`.
+    public private(set) var worldBounds: BoundingBox?
     public var mesh: Mesh?
     public var material: Material?
     public private(set) var children: [SceneNode] = []
+    // Culling hierarchy owned by the root node that was last rendered.
+    var spatialIndex: SceneBVH?
 
     public init(name: String = "node", transform: float4x4 = .identity, mesh: Mesh? = nil, material: Material? = nil) {
         self.name = name
@@ -131,6 +145,7 @@ public final class SceneNode {
 
     public func updateWorldTransform(parent: float4x4) {
         worldTransform = parent * localTransform
+        worldBounds = mesh?.localBounds?.transformed(by: worldTransform)
         for child in children { child.updateWorldTransform(parent: worldTransform) }
     }
 }
@@ -140,6 +155,10 @@ public struct Camera {
     public var view: float4x4
     public var projection: float4x4
     public init(view: float4x4, projection: float4x4) { self.view = view; self.projection = projection }
+    /// World to clip space. `lookAt`/`perspective` and `float4x4.*` follow the column-vector
+    /// convention, so this is applied after a node's world transform: the renderer uploads
+    /// `clipFromWorld * worldTransform`, and culling and sort depth use the same matrix.
+    public var clipFromWorld: float4x4 { projection * view }
     public static func identity(aspect: Float = 1.0) -> Camera {
         let view = float4x4.identity
         let proj = float4x4.perspective(fovYRadians: .pi/3, aspect: aspect, zNear: 0.1, zFar: 100.0)
@@ -152,6 +171,8 @@ public struct Scene {
     public var root: SceneNode
     public var camera: Camera?
     public var lightDirection: (Float, Float, Float) // world-space direction
+    /// Skip drawables whose world bounds fall outside the camera frustum.
+    public var cullingEnabled: Bool = true
     public init(root: SceneNode, camera: Camera? = nil, lightDirection: (Float, Float, Float) = (0.3, -0.5, 0.8)) {
         self.root = root; self.camera = camera; self.lightDirection = lightDirection
     }
@@ -162,6 +183,19 @@ public enum SceneGraphRenderer {
     // Simple cache of pipelines per shader id
     private static var pipelineCache: [ShaderID: PipelineHandle] = [:]
 
+    /// Visibility counters from the most recent `updateAndRender` call.
+    public private(set) static var lastCullingStats = SceneCullingStats()
+
+    /// Bind counters reported by the backend for the most recent frame, when it implements `RenderStateCounting`.
+    public private(set) static var lastStateCounters: RenderStateCounters?
+
+    // Per-frame working storage, reused so steady-state frames do not allocate per draw.
+    private static var frameDrawables: [SceneNode] = []
+    private(set) static var frameDrawList = DrawList()
+    private static var frameOrdinals = DrawOrdinals()
+    // Used when the backend does not provide its own frame arena.
+    private static let fallbackArena = FrameArena()
+
     public static func resetPipelineCache() {
         pipelineCache.removeAll()
     }
@@ -182,6 +216,8 @@ public enum SceneGraphRenderer {
         depthFormat: TextureFormat? = .depth32Float,
         beforeRender: (() throws -> Void)? = nil
     ) throws {
+        let profile = SDLProfiler.begin("scene.updateAndRender")
+        defer { profile.end() }
         var backend = backend
         if backend.deviceEventHandler == nil {
             backend.deviceEventHandler = { event in
@@ -192,6 +228,12 @@ public enum SceneGraphRenderer {
                     }
                 case .didReset:
                     break
+                case .resourcesDiscarded(let handles):
+                    // MeshFactory geometry regenerates itself; anything listed here came back
+                    // empty and is up to its owner to refill.
+                    Task { @MainActor in
+                        SDLLogger.warn("SDLKit.SceneGraph", "\(handles.count) resources came back empty after device reset; their owners must refill them")
+                    }
                 }
             }
         }
@@ -203,26 +245,106 @@ public enum SceneGraphRenderer {
         if let beforeRender {
             try propagateDeviceLoss { try beforeRender() }
         }
-        let vp: float4x4
-        if let cam = scene.camera {
-            vp = cam.view * cam.projection
+        let clipFromWorld = scene.camera?.clipFromWorld ?? .identity
+        frameDrawables.removeAll(keepingCapacity: true)
+        collectDrawables(scene.root, into: &frameDrawables)
+        let visible = visibility(of: frameDrawables, scene: scene)
+        let arena: FrameArena
+        if let backendArena = backend.frameArena {
+            arena = backendArena
         } else {
-            vp = .identity
+            fallbackArena.reset()
+            arena = fallbackArena
         }
+        // Phase 1: build a flat, keyed draw list. Phase 2: sort it and submit in key order
+        // so draws sharing pipeline, material and mesh are adjacent.
+        frameDrawList.removeAll()
+        frameOrdinals.removeAll()
         try propagateDeviceLoss {
-            try renderNode(scene.root,
-                            backend: backend,
-                            colorFormat: colorFormat,
-                            depthFormat: depthFormat,
-                            vp: vp,
-                            lightDir: scene.lightDirection)
+            for (index, node) in frameDrawables.enumerated() where visible[index] {
+                try enqueueDraw(node,
+                                into: &frameDrawList,
+                                ordinals: &frameOrdinals,
+                                arena: arena,
+                                backend: backend,
+                                colorFormat: colorFormat,
+                                depthFormat: depthFormat,
+                                clipFromWorld: clipFromWorld,
+                                lightDir: scene.lightDirection)
+            }
+            frameDrawList.sort()
+            try backend.withGPUScope("scene") {
+                for index in frameDrawList.order {
+                    let item = frameDrawList.items[index]
+                    try backend.draw(mesh: item.mesh,
+                                     pipeline: item.pipeline,
+                                     bindings: item.bindings,
+                                     transform: item.transform)
+                }
+            }
         }
         try propagateDeviceLoss {
             try backend.endFrame()
         }
+        lastStateCounters = (backend as? RenderStateCounting)?.stateCounters
+    }
+
+    // Pre-order traversal so draw order matches the previous recursive walk.
+    private static func collectDrawables(_ node: SceneNode, into out: inout [SceneNode]) {
+        if node.mesh != nil && node.material != nil { out.append(node) }
+        for child in node.children { collectDrawables(child, into: &out) }
     }
 
-    private static func renderNode(_ node: SceneNode, backend: RenderBackend, colorFormat: TextureFormat, depthFormat: TextureFormat?, vp: float4x4, lightDir: (Float, Float, Float)) throws {
+    private static func visibility(of drawables: [SceneNode], scene: Scene) -> [Bool] {
+        var stats = SceneCullingStats()
+        stats.drawableCount = drawables.count
+        defer { lastCullingStats = stats }
+        guard scene.cullingEnabled, let camera = scene.camera else {
+            stats.visibleCount = drawables.count
+            return [Bool](repeating: true, count: drawables.count)
+        }
+
+        var visible = [Bool](repeating: false, count: drawables.count)
+        var bounded: [Int] = []
+        var ids: [ObjectIdentifier] = []
+        var bounds: [BoundingBox] = []
+        bounded.reserveCapacity(drawables.count)
+        for (index, node) in drawables.enumerated() {
+            if let b = node.worldBounds {
+                bounded.append(index)
+                ids.append(ObjectIdentifier(node))
+                bounds.append(b)
+            } else {
+                visible[index] = true
+                stats.unboundedCount += 1
+            }
+        }
+
+        let bvh = scene.root.spatialIndex ?? SceneBVH()
+        scene.root.spatialIndex = bvh
+        let maintenance = bvh.update(ids: ids, bounds: bounds)
+        stats.bvhRefitted = maintenance.refitted
+        stats.bvhRebuilt = maintenance.rebuilt
+
+        var leafVisible = [Bool](repeating: false, count: bounded.count)
+        bvh.query(camera.frustum, visible: &leafVisible)
+        for (leaf, index) in bounded.enumerated() where leafVisible[leaf] {
+            visible[index] = true
+        }
+        stats.visibleCount = visible.reduce(0) { $1 ? $0 + 1 : $0 }
+        stats.culledCount = drawables.count - stats.visibleCount
+        return visible
+    }
+
+    private static func enqueueDraw(_ node: SceneNode,
+                                    into drawList: inout DrawList,
+                                    ordinals: inout DrawOrdinals,
+                                    arena: FrameArena,
+                                    backend: RenderBackend,
+                                    colorFormat: TextureFormat,
+                                    depthFormat: TextureFormat?,
+                                    clipFromWorld: float4x4,
+                                    lightDir: (Float, Float, Float)) throws {
         if var mesh = node.mesh, let material = node.material {
             let pipeline = try pipelineFor(material: material, backend: backend, colorFormat: colorFormat, depthFormat: depthFormat)
             let meshHandle = try mesh.ensureHandle(with: backend)
@@ -241,25 +363,62 @@ public enum SceneGraphRenderer {
                     }
                 }
             }
-            let mvp = node.worldTransform * vp
+            let mvp = clipFromWorld * node.worldTransform
             // Determine light direction preference: material overrides scene
             let matLight = material.params.lightDirection ?? lightDir
             // Determine base color: default white if none; alpha encodes hasTexture (1 => texture bound)
             let base = material.params.baseColor ?? (1,1,1,1)
             // Build push constants block: 16 floats (MVP) + 4 floats (lightDir) + 4 floats (baseColor)
-            var data = mvp.toFloatArray()
-            data.append(contentsOf: [matLight.0, matLight.1, matLight.2, 0.0])
-            data.append(contentsOf: [base.0, base.1, base.2, base.3])
-            let constantsData = data.withUnsafeBytes { buffer in Data(buffer) }
-            bindings.materialConstants = BindingSet.MaterialConstants(data: constantsData)
-            try backend.draw(
-                mesh: meshHandle,
-                pipeline: pipeline,
-                bindings: bindings,
-                transform: mvp
-            )
+            let constantsSize = float4x4.packedByteCount + MemoryLayout<SIMD4<Float>>.size * 2
+            bindings.materialConstants = arena.makeConstants(byteCount: constantsSize) { raw in
+                guard let dst = raw.baseAddress else { return }
+                mvp.write(to: dst)
+                dst.storeBytes(of: SIMD4<Float>(matLight.0, matLight.1, matLight.2, 0.0),
+                                 toByteOffset: float4x4.packedByteCount,
+                                 as: SIMD4<Float>.self)
+                dst.storeBytes(of: SIMD4<Float>(base.0, base.1, base.2, base.3),
+                                 toByteOffset: float4x4.packedByteCount + MemoryLayout<SIMD4<Float>>.size,
+                                 as: SIMD4<Float>.self)
+            }
+
+            // View depth is clip w; without a camera it is 1 for every draw.
+            let center = node.worldBounds?.center ?? SIMD3(node.worldTransform.c3.x, node.worldTransform.c3.y, node.worldTransform.c3.z)
+            let depth = clipFromWorld.transform(SIMD4(center, 1)).w
+            let key = DrawSortKey(pass: material.params.isTransparent ? .transparent : .opaque,
+                                  pipeline: ordinals.pipeline(pipeline),
+                                  material: ordinals.material(material.params.texture),
+                                  mesh: ordinals.mesh(meshHandle),
+                                  depth: depth)
+            drawList.append(DrawList.Item(key: key,
+                                          mesh: meshHandle,
+                                          pipeline: pipeline,
+                                          bindings: bindings,
+                                          transform: mvp))
+        }
+    }
+
+    // Per-frame dense ordinals for sort-key fields, assigned in first-seen order.
+    private struct DrawOrdinals {
+        private var pipelines: [PipelineHandle: Int] = [:]
+        private var materials: [TextureHandle?: Int] = [:]
+        private var meshes: [MeshHandle: Int] = [:]
+
+        mutating func pipeline(_ handle: PipelineHandle) -> Int { Self.ordinal(handle, in: &pipelines) }
+        mutating func material(_ texture: TextureHandle?) -> Int { Self.ordinal(texture, in: &materials) }
+        mutating func mesh(_ handle: MeshHandle) -> Int { Self.ordinal(handle, in: &meshes) }
+
+        mutating func removeAll() {
+            pipelines.removeAll(keepingCapacity: true)
+            materials.removeAll(keepingCapacity: true)
+            meshes.removeAll(keepingCapacity: true)
+        }
+
+        private static func ordinal<K: Hashable>(_ key: K, in table: inout [K: Int]) -> Int {
+            if let existing = table[key] { return existing }
+            let next = table.count
+            table[key] = next
+            return next
         }
-        for child in node.children { try renderNode(child, backend: backend, colorFormat: colorFormat, depthFormat: depthFormat, vp: vp, lightDir: lightDir) }
     }
 
     private static func pipelineFor(material: Material, backend: RenderBackend, colorFormat: TextureFormat, depthFormat: TextureFormat?) throws -> PipelineHandle {
@@ -74,19 +74,25 @@ public enum SceneGraphComputeInterop {
         return (node, resources)
     }
 
-    public static func dispatchCompute(backend: RenderBackend, resources: Resources) throws {
+    /// Records the wave update into `list`, for callers that batch it with other compute work.
+    public static func recordCompute(into list: inout ComputeCommandList, resources: Resources) {
         var bindings = BindingSet()
         bindings.setBuffer(resources.stateBuffer, at: 0)
         bindings.setBuffer(resources.configBuffer, at: 1)
         bindings.setBuffer(resources.vertexBuffer, at: 2)
-        try backend.dispatchCompute(
-            resources.computePipeline,
-            groupsX: resources.vertexCount,
-            groupsY: 1,
-            groupsZ: 1,
-            bindings: bindings
-        )
+        list.dispatch(resources.computePipeline, groupsX: resources.vertexCount, bindings: bindings)
+    }
+
+    /// Submits the wave update as one compute command list. Call it before `beginFrame`
+    /// (not from `beforeRender`): the list ends with a barrier that makes the vertex writes
+    /// visible to the frame drawn next, so the returned fence only needs waiting for readbacks.
+    @discardableResult
+    public static func dispatchCompute(backend: RenderBackend, resources: Resources) throws -> ComputeFence {
+        var list = ComputeCommandList(label: "scenegraph_wave")
+        recordCompute(into: &list, resources: resources)
+        let fence = try backend.submitCompute(list)
         try applyCPUFallbackIfNeeded(backend: backend, resources: resources)
+        return fence
     }
 
     private static func applyCPUFallbackIfNeeded(backend: RenderBackend, resources: Resources) throws {
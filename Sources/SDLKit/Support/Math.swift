@@ -22,47 +22,48 @@ public extension float4x4 {
     }
 
     static func *(lhs: float4x4, rhs: float4x4) -> float4x4 {
-        let a = lhs.columns
-        let b = rhs.columns
-        func dot(_ a: float4x4.Column, _ b: float4x4.Column) -> Float {
-            return a.0*b.0 + a.1*b.1 + a.2*b.2 + a.3*b.3
-        }
-        // Column-major multiplication
-        let c0 = (
-            dot((a.0.0, a.1.0, a.2.0, a.3.0), b.0),
-            dot((a.0.1, a.1.1, a.2.1, a.3.1), b.0),
-            dot((a.0.2, a.1.2, a.2.2, a.3.2), b.0),
-            dot((a.0.3, a.1.3, a.2.3, a.3.3), b.0)
-        )
-        let c1 = (
-            dot((a.0.0, a.1.0, a.2.0, a.3.0), b.1),
-            dot((a.0.1, a.1.1, a.2.1, a.3.1), b.1),
-            dot((a.0.2, a.1.2, a.2.2, a.3.2), b.1),
-            dot((a.0.3, a.1.3, a.2.3, a.3.3), b.1)
-        )
-        let c2 = (
-            dot((a.0.0, a.1.0, a.2.0, a.3.0), b.2),
-            dot((a.0.1, a.1.1, a.2.1, a.3.1), b.2),
-            dot((a.0.2, a.1.2, a.2.2, a.3.2), b.2),
-            dot((a.0.3, a.1.3, a.2.3, a.3.3), b.2)
-        )
-        let c3 = (
-            dot((a.0.0, a.1.0, a.2.0, a.3.0), b.3),
-            dot((a.0.1, a.1.1, a.2.1, a.3.1), b.3),
-            dot((a.0.2, a.1.2, a.2.2, a.3.2), b.3),
-            dot((a.0.3, a.1.3, a.2.3, a.3.3), b.3)
+        // Column-major multiplication: each result column is a linear
+        // combination of lhs columns weighted by the matching rhs column.
+        return float4x4(
+            columns: lhs.transform(rhs.c0),
+            lhs.transform(rhs.c1),
+            lhs.transform(rhs.c2),
+            lhs.transform(rhs.c3)
         )
-        return float4x4(c0, c1, c2, c3)
+    }
+
+    @inline(__always)
+    func transform(_ v: SIMD4<Float>) -> SIMD4<Float> {
+        return c0 * v.x + c1 * v.y + c2 * v.z + c3 * v.w
+    }
+
+    @inline(__always)
+    func transformPoint(_ p: SIMD3<Float>) -> SIMD3<Float> {
+        let r = c0 * p.x + c1 * p.y + c2 * p.z + c3
+        return SIMD3(r.x, r.y, r.z)
     }
 
     func toFloatArray() -> [Float] {
-        let c = columns
-        return [c.0.0, c.0.1, c.0.2, c.0.3,
-                c.1.0, c.1.1, c.1.2, c.1.3,
-                c.2.0, c.2.1, c.2.2, c.2.3,
-                c.3.0, c.3.1, c.3.2, c.3.3]
+        return [c0.x, c0.y, c0.z, c0.w,
+                c1.x, c1.y, c1.z, c1.w,
+                c2.x, c2.y, c2.z, c2.w,
+                c3.x, c3.y, c3.z, c3.w]
+    }
+
+    /// Stores the 16 floats in column-major order at `dst + offset` without allocating.
+    /// The destination does not need to be 16-byte aligned.
+    @inline(__always)
+    func write(to dst: UnsafeMutableRawPointer, byteOffset offset: Int = 0) {
+        let stride = MemoryLayout<SIMD4<Float>>.size
+        dst.storeBytes(of: c0, toByteOffset: offset, as: SIMD4<Float>.self)
+        dst.storeBytes(of: c1, toByteOffset: offset + stride, as: SIMD4<Float>.self)
+        dst.storeBytes(of: c2, toByteOffset: offset + stride * 2, as: SIMD4<Float>.self)
+        dst.storeBytes(of: c3, toByteOffset: offset + stride * 3, as: SIMD4<Float>.self)
     }
 
+    /// Size in bytes of a matrix written by `write(to:byteOffset:)`.
+    static var packedByteCount: Int { MemoryLayout<Float>.size * 16 }
+
     static func perspective(fovYRadians: Float, aspect: Float, zNear: Float, zFar: Float) -> float4x4 {
         let f = 1.0 / tanf(fovYRadians * 0.5)
         let a = f / max(0.0001, aspect)
@@ -108,3 +109,43 @@ public extension float4x4 {
         )
     }
 }
+
+// MARK: - Batch kernels
+// These operate on caller-owned storage and never allocate, so they can run on
+// per-frame hot paths (scene transform propagation, constant buffer uploads).
+public enum MatrixKernels {
+    /// out[i] = parent * matrices[i]. `out` may alias `matrices`.
+    public static func multiply(_ matrices: UnsafeBufferPointer<float4x4>,
+                                by parent: float4x4,
+                                into out: UnsafeMutableBufferPointer<float4x4>) {
+        let count = min(matrices.count, out.count)
+        guard count > 0, let src = matrices.baseAddress, let dst = out.baseAddress else { return }
+        for i in 0..<count {
+            dst[i] = parent * src[i]
+        }
+    }
+
+    /// out[i] = matrix * (points[i], 1). `out` may alias `points`.
+    public static func transformPoints(_ points: UnsafeBufferPointer<SIMD3<Float>>,
+                                       by matrix: float4x4,
+                                       into out: UnsafeMutableBufferPointer<SIMD3<Float>>) {
+        let count = min(points.count, out.count)
+        guard count > 0, let src = points.baseAddress, let dst = out.baseAddress else { return }
+        for i in 0..<count {
+            dst[i] = matrix.transformPoint(src[i])
+        }
+    }
+
+    /// Writes each matrix as 16 column-major floats into a raw constant buffer,
+    /// starting at `dst` and advancing by `stride` bytes per matrix.
+    /// `stride` defaults to the packed size (64 bytes).
+    public static func write(_ matrices: UnsafeBufferPointer<float4x4>,
+                             to dst: UnsafeMutableRawPointer,
+                             stride: Int = float4x4.packedByteCount) {
+        precondition(stride >= float4x4.packedByteCount, "stride must be at least 64 bytes")
+        guard let src = matrices.baseAddress else { return }
+        for i in 0..<matrices.count {
+            src[i].write(to: dst, byteOffset: i * stride)
+        }
+    }
+}
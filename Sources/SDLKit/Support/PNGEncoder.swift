@@ -0,0 +1,537 @@
+import Foundation
+
+// In-memory PNG encoding for screenshots and golden captures.
+//
+// Rows are split into chunks that are swizzled to RGBA (gray for depth), filtered and
+// deflated independently across cores. Every chunk but the last ends on a byte-aligned
+// empty stored block, so the compressed chunks concatenate into one zlib stream; each goes
+// out as its own IDAT as soon as its wave of chunks finishes, and the stream's Adler-32 is
+// combined from the per-chunk sums. Deflate uses the fixed Huffman codes over greedy LZ77
+// matches and falls back to stored blocks for chunks that do not compress. There is no
+// zlib or SDL_image dependency and nothing touches the disk.
+
+public enum PNGEncoder {
+    public static let signature: [UInt8] = [0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A]
+
+    public struct Options: Sendable {
+        /// Filtered bytes per parallel chunk. Matches never span chunks, so larger chunks
+        /// compress slightly better and parallelize worse.
+        public var chunkBytes: Int
+        /// Hash-chain candidates tried per position; 0 stores the filtered rows uncompressed.
+        public var matchEffort: Int
+
+        public init(chunkBytes: Int = 256 << 10, matchEffort: Int = 16) {
+            self.chunkBytes = chunkBytes
+            self.matchEffort = matchEffort
+        }
+    }
+
+    /// Encodes `pixels` (rows of `bytesPerRow`, 4 bytes per pixel in `layout`) and passes
+    /// the file to `sink` piece by piece: signature and header first, then IDAT chunks in
+    /// order as they are compressed, then IEND.
+    public static func encode(width: Int,
+                              height: Int,
+                              bytesPerRow: Int,
+                              layout: GoldenImageCapture.PixelLayout,
+                              pixels: UnsafeRawBufferPointer,
+                              options: Options = Options(),
+                              sink: (Data) throws -> Void) throws {
+        let profile = SDLProfiler.begin("png.encode", detail: "\(width)x\(height)")
+        defer { profile.end() }
+        guard width > 0, height > 0, width <= Int(Int32.max), height <= Int(Int32.max) else {
+            throw AgentError.invalidArgument("PNG dimensions must be positive (got \(width)x\(height))")
+        }
+        guard bytesPerRow >= width * 4, pixels.count >= bytesPerRow * (height - 1) + width * 4,
+              let source = pixels.baseAddress else {
+            throw AgentError.invalidArgument("Pixel buffer too small for \(width)x\(height) with \(bytesPerRow) bytes per row")
+        }
+
+        let channels = layout == .depth32Float ? 1 : 4
+        let rowBytes = width * channels
+        let rowsPerChunk = max(1, options.chunkBytes / (rowBytes + 1))
+        let chunkCount = (height + rowsPerChunk - 1) / rowsPerChunk
+
+        try sink(Data(signature))
+        var header = [UInt8]()
+        header.appendBigEndian(UInt32(width))
+        header.appendBigEndian(UInt32(height))
+        header += [8, channels == 4 ? 6 : 0, 0, 0, 0] // 8-bit RGBA or gray, deflate, adaptive filters, no interlace
+        try sink(chunk("IHDR", header))
+
+        let wave = max(1, ProcessInfo.processInfo.activeProcessorCount)
+        var adler: UInt32 = 1
+        var first = 0
+        while first < chunkCount {
+            let count = min(wave, chunkCount - first)
+            var results = [CompressedChunk?](repeating: nil, count: count)
+            let base = first
+            results.withUnsafeMutableBufferPointer { buffer in
+                let out = buffer
+                DispatchQueue.concurrentPerform(iterations: count) { i in
+                    let index = base + i
+                    let rows = (index * rowsPerChunk)..<min(height, (index + 1) * rowsPerChunk)
+                    out[i] = compressChunk(rows: rows, source: source, bytesPerRow: bytesPerRow, width: width,
+                                           layout: layout, channels: channels,
+                                           isFirst: index == 0, isLast: index == chunkCount - 1,
+                                           effort: options.matchEffort)
+                }
+            }
+            for case let result? in results {
+                adler = Adler32.combine(adler, result.adler, length: result.filteredLength)
+                var payload = result.deflated
+                var crc = result.crc
+                if result.isLast {
+                    var trailer = [UInt8]()
+                    trailer.appendBigEndian(adler)
+                    payload += trailer
+                    crc = CRC32.update(crc, trailer)
+                }
+                var data = Data(capacity: payload.count + 12)
+                data.appendBigEndian(UInt32(payload.count))
+                data.append(contentsOf: Array("IDAT".utf8))
+                data.append(contentsOf: payload)
+                data.appendBigEndian(crc ^ 0xFFFF_FFFF)
+                try sink(data)
+            }
+            first += count
+        }
+        try sink(chunk("IEND", []))
+    }
+
+    /// Encodes into a single `Data`.
+    public static func encode(width: Int,
+                              height: Int,
+                              bytesPerRow: Int,
+                              layout: GoldenImageCapture.PixelLayout,
+                              pixels: UnsafeRawBufferPointer,
+                              options: Options = Options()) throws -> Data {
+        var png = Data()
+        try encode(width: width, height: height, bytesPerRow: bytesPerRow, layout: layout,
+                   pixels: pixels, options: options) { png.append($0) }
+        return png
+    }
+
+    // MARK: - Chunks
+
+    private struct CompressedChunk {
+        let deflated: [UInt8]
+        /// Running (non-finalized) CRC over the chunk type and `deflated`.
+        let crc: UInt32
+        let adler: UInt32
+        let filteredLength: Int
+        let isLast: Bool
+    }
+
+    private static func compressChunk(rows: Range<Int>,
+                                      source: UnsafeRawPointer,
+                                      bytesPerRow: Int,
+                                      width: Int,
+                                      layout: GoldenImageCapture.PixelLayout,
+                                      channels: Int,
+                                      isFirst: Bool,
+                                      isLast: Bool,
+                                      effort: Int) -> CompressedChunk {
+        let profile = SDLProfiler.begin("png.chunk")
+        defer { profile.end() }
+        let rowBytes = width * channels
+        var previous = [UInt8](repeating: 0, count: rowBytes)
+        var current = [UInt8](repeating: 0, count: rowBytes)
+        if rows.lowerBound > 0 {
+            previous.withUnsafeMutableBufferPointer {
+                swizzleRow(source + (rows.lowerBound - 1) * bytesPerRow, width: width, layout: layout, into: $0.baseAddress!)
+            }
+        }
+        var filtered = [UInt8]()
+        filtered.reserveCapacity(rows.count * (rowBytes + 1))
+        for y in rows {
+            current.withUnsafeMutableBufferPointer {
+                swizzleRow(source + y * bytesPerRow, width: width, layout: layout, into: $0.baseAddress!)
+            }
+            current.withUnsafeBufferPointer { row in
+                previous.withUnsafeBufferPointer { above in
+                    appendFiltered(row: row.baseAddress!, above: above.baseAddress!, count: rowBytes, bpp: channels, into: &filtered)
+                }
+            }
+            swap(&previous, &current)
+        }
+
+        var deflated: [UInt8] = isFirst ? [0x78, 0x01] : []
+        let adler = filtered.withUnsafeBufferPointer { input -> UInt32 in
+            Deflate.compress(input, isFinal: isLast, effort: effort, into: &deflated)
+            return Adler32.checksum(input)
+        }
+        let crc = CRC32.update(CRC32.update(0xFFFF_FFFF, Array("IDAT".utf8)), deflated)
+        return CompressedChunk(deflated: deflated, crc: crc, adler: adler, filteredLength: filtered.count, isLast: isLast)
+    }
+
+    private static func chunk(_ type: String, _ payload: [UInt8]) -> Data {
+        let typeBytes = Array(type.utf8)
+        var data = Data(capacity: payload.count + 12)
+        data.appendBigEndian(UInt32(payload.count))
+        data.append(contentsOf: typeBytes)
+        data.append(contentsOf: payload)
+        data.appendBigEndian(CRC32.update(CRC32.update(0xFFFF_FFFF, typeBytes), payload) ^ 0xFFFF_FFFF)
+        return data
+    }
+
+    // MARK: - Swizzle
+
+    /// Converts one row of `width` pixels to RGBA8 (`.rgba8Unorm`, `.bgra8Unorm`) or 8-bit
+    /// gray (`.depth32Float`, clamped to [0, 1]; NaN is 0), eight pixels per SIMD step.
+    static func swizzleRow(_ source: UnsafeRawPointer,
+                           width: Int,
+                           layout: GoldenImageCapture.PixelLayout,
+                           into destination: UnsafeMutablePointer<UInt8>) {
+        let out = UnsafeMutableRawPointer(destination)
+        var x = 0
+        switch layout {
+        case .rgba8Unorm:
+            out.copyMemory(from: source, byteCount: width * 4)
+        case .bgra8Unorm:
+            // Byte 0 (B) and byte 2 (R) trade places within each 32-bit pixel.
+            while x + 8 <= width {
+                let v = SIMD8<UInt32>(littleEndianPixels: source.loadUnaligned(fromByteOffset: x * 4, as: SIMD8<UInt32>.self))
+                let swapped = (v & 0xFF00_FF00) | ((v &>> 16) & 0xFF) | ((v & 0xFF) &<< 16)
+                out.storeBytes(of: SIMD8<UInt32>(littleEndianPixels: swapped), toByteOffset: x * 4, as: SIMD8<UInt32>.self)
+                x += 8
+            }
+            let src = source.assumingMemoryBound(to: UInt8.self)
+            while x < width {
+                let o = x * 4
+                destination[o + 0] = src[o + 2]
+                destination[o + 1] = src[o + 1]
+                destination[o + 2] = src[o + 0]
+                destination[o + 3] = src[o + 3]
+                x += 1
+            }
+        case .depth32Float:
+            while x + 8 <= width {
+                let v = source.loadUnaligned(fromByteOffset: x * 4, as: SIMD8<Float>.self)
+                let clamped = v.replacing(with: 0, where: v .!= v).clamped(lowerBound: .zero, upperBound: .one) * 255
+                out.storeBytes(of: SIMD8<UInt8>(truncatingIfNeeded: SIMD8<Int32>(clamped, rounding: .towardZero)),
+                               toByteOffset: x, as: SIMD8<UInt8>.self)
+                x += 8
+            }
+            while x < width {
+                let value = source.loadUnaligned(fromByteOffset: x * 4, as: Float.self)
+                destination[x] = value.isNaN ? 0 : UInt8(max(0, min(1, value)) * 255)
+                x += 1
+            }
+        }
+    }
+
+    // MARK: - Filters
+
+    /// Appends the filter type byte and the filtered row, choosing the filter with the
+    /// smallest sum of absolute signed residuals (the libpng heuristic).
+    static func appendFiltered(row: UnsafePointer<UInt8>,
+                               above: UnsafePointer<UInt8>,
+                               count: Int,
+                               bpp: Int,
+                               into out: inout [UInt8]) {
+        @inline(__always) func cost(_ v: UInt8) -> Int { v < 128 ? Int(v) : 256 - Int(v) }
+        var sums = (none: 0, sub: 0, up: 0, average: 0, paeth: 0)
+        for i in 0..<count {
+            let x = row[i], b = above[i]
+            let a = i >= bpp ? row[i - bpp] : 0
+            let c = i >= bpp ? above[i - bpp] : 0
+            sums.none += cost(x)
+            sums.sub += cost(x &- a)
+            sums.up += cost(x &- b)
+            sums.average += cost(x &- UInt8((Int(a) + Int(b)) >> 1))
+            sums.paeth += cost(x &- paeth(a, b, c))
+        }
+        let costs = [sums.none, sums.sub, sums.up, sums.average, sums.paeth]
+        let filter = costs.indices.min { costs[$0] < costs[$1] } ?? 0
+        out.append(UInt8(filter))
+        for i in 0..<count {
+            let x = row[i], b = above[i]
+            let a = i >= bpp ? row[i - bpp] : 0
+            let c = i >= bpp ? above[i - bpp] : 0
+            switch filter {
+            case 1: out.append(x &- a)
+            case 2: out.append(x &- b)
+            case 3: out.append(x &- UInt8((Int(a) + Int(b)) >> 1))
+            case 4: out.append(x &- paeth(a, b, c))
+            default: out.append(x)
+            }
+        }
+    }
+
+    @inline(__always)
+    static func paeth(_ a: UInt8, _ b: UInt8, _ c: UInt8) -> UInt8 {
+        let pa = abs(Int(b) - Int(c))
+        let pb = abs(Int(a) - Int(c))
+        let pc = abs(Int(a) + Int(b) - 2 * Int(c))
+        if pa <= pb && pa <= pc { return a }
+        return pb <= pc ? b : c
+    }
+}
+
+// MARK: - Deflate
+
+/// Raw deflate (RFC 1951) with fixed Huffman codes.
+enum Deflate {
+    static let windowSize = 32768
+    static let maxMatch = 258
+    private static let hashBits = 15
+
+    private static let lengthBase: [Int] = [3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258]
+    private static let lengthExtra: [Int] = [0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0]
+    private static let distanceBase: [Int] = [1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577]
+    private static let distanceExtra: [Int] = [0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13]
+
+    /// Fixed literal/length codes, bit-reversed for the LSB-first stream.
+    private static let literalCodes: [(code: UInt32, length: Int)] = (0..<288).map { symbol in
+        switch symbol {
+        case ..<144: return (reversed(UInt32(0x30 + symbol), 8), 8)
+        case ..<256: return (reversed(UInt32(0x190 + symbol - 144), 9), 9)
+        case ..<280: return (reversed(UInt32(symbol - 256), 7), 7)
+        default: return (reversed(UInt32(0xC0 + symbol - 280), 8), 8)
+        }
+    }
+    /// Length code index for every match length 0...258 (entries below 3 are unused).
+    private static let lengthCodes: [UInt8] = (0...maxMatch).map { length in
+        UInt8(lengthBase.lastIndex { $0 <= length } ?? 0)
+    }
+    /// Distance code index for every distance - 1.
+    private static let distanceCodes: [UInt8] = {
+        var table = [UInt8](repeating: 0, count: windowSize)
+        var code = 0
+        for distance in 1...windowSize {
+            while code + 1 < distanceBase.count && distanceBase[code + 1] <= distance { code += 1 }
+            table[distance - 1] = UInt8(code)
+        }
+        return table
+    }()
+
+    private static func reversed(_ code: UInt32, _ length: Int) -> UInt32 {
+        var code = code, result: UInt32 = 0
+        for _ in 0..<length {
+            result = (result << 1) | (code & 1)
+            code >>= 1
+        }
+        return result
+    }
+
+    /// Appends `input` as deflate blocks. Unless `isFinal`, the output ends byte-aligned
+    /// with the final bit clear, so another compressed segment can follow it directly.
+    static func compress(_ input: UnsafeBufferPointer<UInt8>, isFinal: Bool, effort: Int, into out: inout [UInt8]) {
+        let count = input.count
+        let storedSize = count + 5 * max(1, (count + 65534) / 65535)
+        if effort > 0, let base = input.baseAddress {
+            let fixed = compressFixed(base, count: count, isFinal: isFinal, effort: effort)
+            if fixed.count <= storedSize {
+                out += fixed
+                return
+            }
+        }
+        var offset = 0
+        repeat {
+            let length = min(65535, count - offset)
+            let isLastBlock = offset + length == count
+            out.append(isLastBlock && isFinal ? 1 : 0)
+            out += [UInt8(length & 0xFF), UInt8(length >> 8), UInt8(~length & 0xFF), UInt8((~length >> 8) & 0xFF)]
+            out += input[offset..<(offset + length)]
+            offset += length
+        } while offset < count
+    }
+
+    private static func compressFixed(_ p: UnsafePointer<UInt8>, count: Int, isFinal: Bool, effort: Int) -> [UInt8] {
+        var writer = BitWriter(capacity: count / 2 + 16)
+        writer.write(isFinal ? 1 : 0, bits: 1)
+        writer.write(1, bits: 2)
+
+        var head = [Int32](repeating: -1, count: 1 << hashBits)
+        var chain = [Int32](repeating: -1, count: count)
+        @inline(__always) func hash(_ i: Int) -> Int {
+            let v = UInt32(p[i]) | UInt32(p[i + 1]) << 8 | UInt32(p[i + 2]) << 16
+            return Int((v &* 0x9E37_79B1) >> UInt32(32 - hashBits))
+        }
+
+        var i = 0
+        while i < count {
+            var bestLength = 0
+            var bestDistance = 0
+            if i + 3 <= count {
+                let h = hash(i)
+                let limit = min(maxMatch, count - i)
+                var candidate = Int(head[h])
+                var tries = effort
+                while candidate >= 0, i - candidate <= windowSize, tries > 0 {
+                    if p[candidate + bestLength] == p[i + bestLength] {
+                        let length = matchLength(p, candidate, i, limit: limit)
+                        if length > bestLength {
+                            bestLength = length
+                            bestDistance = i - candidate
+                            if length == limit { break }
+                        }
+                    }
+                    candidate = Int(chain[candidate])
+                    tries -= 1
+                }
+                chain[i] = head[h]
+                head[h] = Int32(i)
+            }
+            if bestLength >= 3 {
+                let lengthCode = Int(lengthCodes[bestLength])
+                let symbol = literalCodes[257 + lengthCode]
+                writer.write(symbol.code, bits: symbol.length)
+                writer.write(UInt32(bestLength - lengthBase[lengthCode]), bits: lengthExtra[lengthCode])
+                let distanceCode = Int(distanceCodes[bestDistance - 1])
+                writer.write(reversed(UInt32(distanceCode), 5), bits: 5)
+                writer.write(UInt32(bestDistance - distanceBase[distanceCode]), bits: distanceExtra[distanceCode])
+                let end = i + bestLength
+                var j = i + 1
+                while j < end, j + 3 <= count {
+                    let h = hash(j)
+                    chain[j] = head[h]
+                    head[h] = Int32(j)
+                    j += 1
+                }
+                i = end
+            } else {
+                let symbol = literalCodes[Int(p[i])]
+                writer.write(symbol.code, bits: symbol.length)
+                i += 1
+            }
+        }
+        let endOfBlock = literalCodes[256]
+        writer.write(endOfBlock.code, bits: endOfBlock.length)
+        if isFinal {
+            writer.align()
+        } else {
+            // Empty stored block: byte-aligns the segment and leaves the stream open.
+            writer.write(0, bits: 3)
+            writer.align()
+            writer.bytes += [0x00, 0x00, 0xFF, 0xFF]
+        }
+        return writer.bytes
+    }
+
+    /// Length of the common prefix of `p[a...]` and `p[b...]`, up to `limit`; compares
+    /// eight bytes at a time.
+    @inline(__always)
+    private static func matchLength(_ p: UnsafePointer<UInt8>, _ a: Int, _ b: Int, limit: Int) -> Int {
+        let raw = UnsafeRawPointer(p)
+        var length = 0
+        while length + 8 <= limit {
+            let lhs = raw.loadUnaligned(fromByteOffset: a + length, as: UInt64.self)
+            let rhs = raw.loadUnaligned(fromByteOffset: b + length, as: UInt64.self)
+            let diff = (lhs ^ rhs).littleEndian
+            if diff != 0 { return length + diff.trailingZeroBitCount >> 3 }
+            length += 8
+        }
+        while length < limit && p[a + length] == p[b + length] { length += 1 }
+        return length
+    }
+
+    private struct BitWriter {
+        var bytes: [UInt8] = []
+        private var buffer: UInt64 = 0
+        private var bitCount = 0
+
+        init(capacity: Int) {
+            bytes.reserveCapacity(capacity)
+        }
+
+        /// Appends the low `bits` bits of `value`, least significant first.
+        mutating func write(_ value: UInt32, bits: Int) {
+            buffer |= UInt64(value) << UInt64(bitCount)
+            bitCount += bits
+            if bitCount >= 32 {
+                bytes += [UInt8(truncatingIfNeeded: buffer), UInt8(truncatingIfNeeded: buffer >> 8),
+                          UInt8(truncatingIfNeeded: buffer >> 16), UInt8(truncatingIfNeeded: buffer >> 24)]
+                buffer >>= 32
+                bitCount -= 32
+            }
+        }
+
+        mutating func align() {
+            while bitCount > 0 {
+                bytes.append(UInt8(truncatingIfNeeded: buffer))
+                buffer >>= 8
+                bitCount -= 8
+            }
+            buffer = 0
+            bitCount = 0
+        }
+    }
+}
+
+// MARK: - Checksums
+
+enum Adler32 {
+    private static let modulus: UInt32 = 65521
+
+    static func checksum(_ bytes: UnsafeBufferPointer<UInt8>) -> UInt32 {
+        var a: UInt32 = 1, b: UInt32 = 0
+        var i = 0
+        while i < bytes.count {
+            // 5552 is the longest run before `b` can overflow 32 bits.
+            let end = min(bytes.count, i + 5552)
+            while i < end {
+                a &+= UInt32(bytes[i])
+                b &+= a
+                i += 1
+            }
+            a %= modulus
+            b %= modulus
+        }
+        return b << 16 | a
+    }
+
+    /// The checksum of two concatenated sequences from their checksums and the length of
+    /// the second (zlib's `adler32_combine`).
+    static func combine(_ first: UInt32, _ second: UInt32, length: Int) -> UInt32 {
+        let base = UInt64(modulus)
+        let remainder = UInt64(length) % base
+        var sum1 = UInt64(first & 0xFFFF)
+        var sum2 = (remainder * sum1) % base
+        sum1 += UInt64(second & 0xFFFF) + base - 1
+        sum2 += UInt64(first >> 16) + UInt64(second >> 16) + base - remainder
+        if sum1 >= base { sum1 -= base }
+        if sum1 >= base { sum1 -= base }
+        if sum2 >= base << 1 { sum2 -= base << 1 }
+        if sum2 >= base { sum2 -= base }
+        return UInt32(sum1 | sum2 << 16)
+    }
+}
+
+enum CRC32 {
+    private static let table: [UInt32] = (0..<256).map { n in
+        var c = UInt32(n)
+        for _ in 0..<8 { c = c & 1 != 0 ? 0xEDB8_8320 ^ (c >> 1) : c >> 1 }
+        return c
+    }
+
+    /// Continues a running CRC; start from `0xFFFFFFFF` and XOR the result with it to finish.
+    static func update<Bytes: Sequence>(_ crc: UInt32, _ bytes: Bytes) -> UInt32 where Bytes.Element == UInt8 {
+        var c = crc
+        for byte in bytes { c = table[Int((c ^ UInt32(byte)) & 0xFF)] ^ (c >> 8) }
+        return c
+    }
+}
+
+private extension SIMD8 where Scalar == UInt32 {
+    /// Pixels loaded from memory, viewed as little-endian words (a no-op on little-endian hosts).
+    init(littleEndianPixels v: SIMD8<UInt32>) {
+        #if _endian(big)
+        self.init((0..<8).map { v[$0].byteSwapped })
+        #else
+        self = v
+        #endif
+    }
+}
+
+private extension Array where Element == UInt8 {
+    mutating func appendBigEndian(_ value: UInt32) {
+        append(contentsOf: [UInt8(value >> 24), UInt8((value >> 16) & 0xFF), UInt8((value >> 8) & 0xFF), UInt8(value & 0xFF)])
+    }
+}
+
+private extension Data {
+    mutating func appendBigEndian(_ value: UInt32) {
+        append(contentsOf: [UInt8(value >> 24), UInt8((value >> 16) & 0xFF), UInt8((value >> 8) & 0xFF), UInt8(value & 0xFF)])
+    }
+}
@@ -0,0 +1,298 @@
+import Foundation
+#if canImport(Atomics)
+import Atomics
+#endif
+#if canImport(Darwin)
+import Darwin
+#elseif canImport(Glibc)
+import Glibc
+#endif
+
+// Scoped CPU zone profiler.
+//
+// Each thread records into its own fixed-size ring (oldest zones are overwritten), so a
+// zone costs two monotonic clock reads and an uncontended lock. Recording is off unless
+// `SDLKIT_PROFILE=1` or `SDLKIT_PROFILE_TRACE=<path>` is set, or `SDLProfiler.isEnabled`
+// is toggled at runtime; a disabled zone is a single relaxed atomic load. Building with
+// `SDLKIT_PROFILER_DISABLED=1` (see Package.swift) compiles zones out entirely.
+//
+// With `SDLKIT_PROFILE_TRACE` the capture is written as Chrome trace JSON at process
+// exit; `/agent/profiler/trace` returns it in the response body on demand. Open the
+// file in chrome://tracing or https://ui.perfetto.dev.
+
+/// Token for an open zone; call `end()` exactly once, typically from `defer`.
+public struct SDLProfileZone {
+    @usableFromInline let name: StaticString
+    @usableFromInline let detail: String?
+    @usableFromInline let start: UInt64
+
+    @usableFromInline
+    init(name: StaticString, detail: String?, start: UInt64) {
+        self.name = name
+        self.detail = detail
+        self.start = start
+    }
+
+    @inlinable
+    public func end() {
+        #if !SDLKIT_PROFILER_DISABLED
+        if start != 0 { SDLProfiler.record(name, detail: detail, start: start) }
+        #endif
+    }
+}
+
+public enum SDLProfiler {
+    /// Zones kept per thread before the oldest are overwritten.
+    public static let eventsPerThread = 8192
+
+    public static var isEnabled: Bool {
+        get {
+            #if SDLKIT_PROFILER_DISABLED
+            return false
+            #else
+            return state.enabled
+            #endif
+        }
+        set { state.enabled = newValue }
+    }
+
+    /// Opens a zone. `name` reads as "category.zone"; the part before the first dot
+    /// becomes the trace category. `detail` is attached to the event's args.
+    @inlinable
+    public static func begin(_ name: StaticString, detail: @autoclosure () -> String? = nil) -> SDLProfileZone {
+        #if SDLKIT_PROFILER_DISABLED
+        return SDLProfileZone(name: name, detail: nil, start: 0)
+        #else
+        guard isEnabled else { return SDLProfileZone(name: name, detail: nil, start: 0) }
+        return SDLProfileZone(name: name, detail: detail(), start: now())
+        #endif
+    }
+
+    @inlinable
+    public static func zone<T>(_ name: StaticString, _ body: () throws -> T) rethrows -> T {
+        let zone = begin(name)
+        defer { zone.end() }
+        return try body()
+    }
+
+    /// Monotonic nanoseconds; never returns 0, which marks a disabled zone.
+    @usableFromInline
+    static func now() -> UInt64 { max(1, DispatchTime.now().uptimeNanoseconds) }
+
+    @usableFromInline
+    static func record(_ name: StaticString, detail: String?, start: UInt64) {
+        let end = now()
+        currentBuffer().append(ProfilerEvent(name: name, detail: detail, start: start, end: end))
+    }
+
+    /// Number of zones currently held across all threads.
+    public static var eventCount: Int {
+        state.buffers().reduce(0) { $0 + $1.count }
+    }
+
+    /// Drops every recorded zone; threads keep their buffers.
+    public static func reset() {
+        for buffer in state.buffers() { buffer.clear() }
+    }
+
+    /// Chrome trace ("Trace Event Format") JSON of everything recorded so far.
+    public static func chromeTraceJSON() throws -> Data {
+        let pid = Int(ProcessInfo.processInfo.processIdentifier)
+        var events: [ChromeTraceEvent] = []
+        for buffer in state.buffers() {
+            events.append(ChromeTraceEvent(name: "thread_name", cat: nil, ph: "M", ts: nil, dur: nil, pid: pid, tid: buffer.threadID,
+                                           args: ["name": buffer.threadName]))
+            for event in buffer.snapshot() {
+                let name = event.name.description
+                let category = name.split(separator: ".", maxSplits: 1).first.map(String.init) ?? name
+                let ts = Double(event.start &- state.origin) / 1000
+                let dur = Double(event.end &- event.start) / 1000
+                events.append(ChromeTraceEvent(name: name, cat: category, ph: "X", ts: ts, dur: dur, pid: pid, tid: buffer.threadID,
+                                               args: event.detail.map { ["detail": $0] }))
+            }
+        }
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.sortedKeys]
+        return try encoder.encode(ChromeTrace(traceEvents: events, displayTimeUnit: "ms"))
+    }
+
+    public static func writeChromeTrace(to url: URL) throws {
+        try chromeTraceJSON().write(to: url, options: .atomic)
+    }
+
+    // MARK: - Internals
+
+    @usableFromInline
+    static let state = ProfilerState()
+
+    private static func currentBuffer() -> ProfilerThreadBuffer {
+        #if canImport(Darwin) || canImport(Glibc)
+        if let raw = pthread_getspecific(state.threadKey) {
+            return Unmanaged<ProfilerThreadBuffer>.fromOpaque(raw).takeUnretainedValue()
+        }
+        let buffer = state.makeBuffer()
+        // The registry keeps the buffer alive, so the slot holds an unretained reference.
+        pthread_setspecific(state.threadKey, Unmanaged.passUnretained(buffer).toOpaque())
+        return buffer
+        #else
+        let key = "SDLKit.ProfilerBuffer"
+        if let buffer = Thread.current.threadDictionary[key] as? ProfilerThreadBuffer { return buffer }
+        let buffer = state.makeBuffer()
+        Thread.current.threadDictionary[key] = buffer
+        return buffer
+        #endif
+    }
+
+    fileprivate static func writeEnvironmentTrace() {
+        guard let path = ProcessInfo.processInfo.environment["SDLKIT_PROFILE_TRACE"], !path.isEmpty else { return }
+        do {
+            try writeChromeTrace(to: URL(fileURLWithPath: path))
+        } catch {
+            FileHandle.standardError.write(Data("SDLKit profiler: failed to write \(path): \(error)\n".utf8))
+        }
+    }
+}
+
+// MARK: - Storage
+
+@usableFromInline
+struct ProfilerEvent {
+    let name: StaticString
+    let detail: String?
+    let start: UInt64
+    let end: UInt64
+}
+
+final class ProfilerThreadBuffer: @unchecked Sendable {
+    let threadID: Int
+    let threadName: String
+    private let lock = NSLock()
+    private var events: [ProfilerEvent] = []
+    private var next = 0
+
+    init(threadID: Int, threadName: String) {
+        self.threadID = threadID
+        self.threadName = threadName
+        events.reserveCapacity(SDLProfiler.eventsPerThread)
+    }
+
+    var count: Int {
+        lock.lock(); defer { lock.unlock() }
+        return events.count
+    }
+
+    func append(_ event: ProfilerEvent) {
+        lock.lock(); defer { lock.unlock() }
+        if events.count < SDLProfiler.eventsPerThread {
+            events.append(event)
+        } else {
+            events[next] = event
+        }
+        next = (next + 1) % SDLProfiler.eventsPerThread
+    }
+
+    /// Events in recording order.
+    func snapshot() -> [ProfilerEvent] {
+        lock.lock(); defer { lock.unlock() }
+        guard events.count == SDLProfiler.eventsPerThread else { return events }
+        return Array(events[next...] + events[..<next])
+    }
+
+    func clear() {
+        lock.lock(); defer { lock.unlock() }
+        events.removeAll(keepingCapacity: true)
+        next = 0
+    }
+}
+
+@usableFromInline
+final class ProfilerState: @unchecked Sendable {
+    let origin = DispatchTime.now().uptimeNanoseconds
+    #if canImport(Darwin) || canImport(Glibc)
+    let threadKey: pthread_key_t
+    #endif
+    #if canImport(Atomics)
+    private let flag: ManagedAtomic<Bool>
+    #else
+    private var flagValue: Bool
+    #endif
+    private let lock = NSLock()
+    private var registered: [ProfilerThreadBuffer] = []
+
+    init() {
+        let env = ProcessInfo.processInfo.environment
+        let raw = env["SDLKIT_PROFILE"]?.lowercased()
+        let tracePath = env["SDLKIT_PROFILE_TRACE"] ?? ""
+        let enabled = raw == "1" || raw == "true" || raw == "yes" || !tracePath.isEmpty
+        #if canImport(Atomics)
+        flag = ManagedAtomic(enabled)
+        #else
+        flagValue = enabled
+        #endif
+        #if canImport(Darwin) || canImport(Glibc)
+        var key = pthread_key_t()
+        pthread_key_create(&key, nil)
+        threadKey = key
+        #endif
+        if !tracePath.isEmpty {
+            atexit { SDLProfiler.writeEnvironmentTrace() }
+        }
+    }
+
+    @usableFromInline
+    var enabled: Bool {
+        get {
+            #if canImport(Atomics)
+            return flag.load(ordering: .relaxed)
+            #else
+            lock.lock(); defer { lock.unlock() }
+            return flagValue
+            #endif
+        }
+        set {
+            #if canImport(Atomics)
+            flag.store(newValue, ordering: .relaxed)
+            #else
+            lock.lock(); flagValue = newValue; lock.unlock()
+            #endif
+        }
+    }
+
+    func makeBuffer() -> ProfilerThreadBuffer {
+        let name: String
+        if Thread.isMainThread {
+            name = "main"
+        } else if let threadName = Thread.current.name, !threadName.isEmpty {
+            name = threadName
+        } else {
+            name = "thread"
+        }
+        lock.lock(); defer { lock.unlock() }
+        let buffer = ProfilerThreadBuffer(threadID: registered.count + 1, threadName: name)
+        registered.append(buffer)
+        return buffer
+    }
+
+    func buffers() -> [ProfilerThreadBuffer] {
+        lock.lock(); defer { lock.unlock() }
+        return registered
+    }
+}
+
+// MARK: - Chrome trace encoding
+
+private struct ChromeTrace: Encodable {
+    let traceEvents: [ChromeTraceEvent]
+    let displayTimeUnit: String
+}
+
+private struct ChromeTraceEvent: Encodable {
+    let name: String
+    let cat: String?
+    let ph: String
+    let ts: Double?
+    let dur: Double?
+    let pid: Int
+    let tid: Int
+    let args: [String: String]?
+}
@@ -348,11 +348,11 @@ public enum RenderBackendTestHarness {
         let fm = FileManager.default
         try fm.createDirectory(at: backendDirectory, withIntermediateDirectories: true)
         let base = sanitizedFilenameComponent(result.test.rawValue)
-        let imageName = (base.isEmpty ? result.test.rawValue : base) + ".ppm"
+        let imageName = (base.isEmpty ? result.test.rawValue : base) + ".png"
         let hashName = (base.isEmpty ? result.test.rawValue : base) + ".hash.txt"
         let imageURL = backendDirectory.appendingPathComponent(imageName)
         let hashURL = backendDirectory.appendingPathComponent(hashName)
-        try capture.writePPM(to: imageURL)
+        try capture.writePNG(to: imageURL)
         let body = "hash=\(result.hash)\nkey=\(result.goldenKey)\n"
         if let data = body.data(using: .utf8) {
             try data.write(to: hashURL)
@@ -387,7 +387,7 @@ public enum RenderBackendTestHarness {
             return SummaryEntry(test: result.test.rawValue,
                                 hash: result.hash,
                                 goldenKey: result.goldenKey,
-                                image: "\(filenameBase).ppm",
+                                image: "\(filenameBase).png",
                                 hashFile: "\(filenameBase).hash.txt")
         }
         guard !entries.isEmpty else { return }
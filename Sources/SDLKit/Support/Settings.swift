@@ -6,19 +6,18 @@ import FountainStore
 
 // Centralized non-secret settings persistence backed by FountainStore.
 // Keys: simple names like "render.backend.override", "vk.validation", etc.
+//
+// The process keeps one store handle and an in-memory copy of every setting: the first read
+// loads them (call `prewarm()` at launch to do that in the background), later reads are a
+// dictionary lookup, and writes update the copy at once and reach disk in coalesced batches
+// a moment later. `flush()` waits for those batches, and runs at exit.
 @preconcurrency public enum SettingsStore {
     public static func getString(_ key: String) -> String? {
-#if canImport(FountainStore)
-        if let value = FSSettingsBridge.get(key) { return value }
-#endif
-        return FallbackSettingsBridge.get(key)
+        SettingsCache.shared.get(key)
     }
 
     public static func setString(_ key: String, _ value: String) {
-#if canImport(FountainStore)
-        FSSettingsBridge.set(key, value)
-#endif
-        FallbackSettingsBridge.set(key, value)
+        SettingsCache.shared.set(key, value)
     }
 
     public static func getBool(_ key: String) -> Bool? {
@@ -34,102 +33,204 @@ import FountainStore
         setString(key, value ? "1" : "0")
     }
 
-    // Dump all settings into a map (key -> value) using FountainStore scan.
+    // Dump all settings into a map (key -> value).
     public static func dumpAll() -> [String: String] {
-#if canImport(FountainStore)
-        let persisted = FSSettingsBridge.list()
-        let fallback = FallbackSettingsBridge.list()
-        if persisted.isEmpty { return fallback }
-        return persisted.merging(fallback) { current, _ in current }
-#else
-        return FallbackSettingsBridge.list()
-#endif
+        SettingsCache.shared.snapshot()
+    }
+
+    /// Starts loading persisted settings in the background so the first read does not wait.
+    public static func prewarm() {
+        SettingsCache.shared.startLoading()
+    }
+
+    /// Blocks until every setting written so far is on disk. Do not call from an async context.
+    public static func flush() {
+        SettingsCache.shared.flush()
     }
 }
 
-#if canImport(FountainStore)
-import FountainStore
+/// Settings in memory, plus the writes not yet committed.
+final class SettingsCache: @unchecked Sendable {
+    static let shared = SettingsCache(backend: SettingsCache.persistentBackend())
 
-private struct SettingDoc: Codable, Identifiable { let id: String; let value: String }
+    /// How long writes gather before one batch commits them, by default.
+    static let defaultCommitDelay: TimeInterval = 0.05
 
-private enum FSSettingsBridge {
-    static func path() -> URL {
-        let cwd = URL(fileURLWithPath: FileManager.default.currentDirectoryPath, isDirectory: true)
-        return cwd.appendingPathComponent(".fountain/sdlkit", isDirectory: true)
+    /// Loads every persisted setting, and commits a batch of changes.
+    struct Backend: Sendable {
+        let load: @Sendable () async -> [String: String]
+        let commit: @Sendable ([String: String]) async -> Void
+    }
+
+    private enum LoadState { case idle, loading, loaded }
+
+    private let backend: Backend?
+    private let commitDelay: TimeInterval
+    private let condition = NSCondition()
+    private var values: [String: String] = [:]
+    private var loadState = LoadState.idle
+    private var pending: [String: String] = [:]
+    private var commitScheduled = false
+    private var committing = false
+    private var exitHookInstalled = false
+    private var commitCount = 0
+
+    init(backend: Backend?, commitDelay: TimeInterval = SettingsCache.defaultCommitDelay) {
+        self.backend = backend
+        self.commitDelay = commitDelay
+        if backend == nil { loadState = .loaded }
+    }
+
+    /// Batches committed so far.
+    var commits: Int {
+        condition.lock(); defer { condition.unlock() }
+        return commitCount
+    }
+
+    func get(_ key: String) -> String? {
+        condition.lock(); defer { condition.unlock() }
+        waitUntilLoaded()
+        return values[key]
+    }
+
+    func snapshot() -> [String: String] {
+        condition.lock(); defer { condition.unlock() }
+        waitUntilLoaded()
+        return values
+    }
+
+    func set(_ key: String, _ value: String) {
+        condition.lock(); defer { condition.unlock() }
+        values[key] = value
+        guard backend != nil else { return }
+        pending[key] = value
+        if !exitHookInstalled {
+            exitHookInstalled = true
+            atexit { SettingsStore.flush() }
+        }
+        if !commitScheduled && !committing {
+            commitScheduled = true
+            DispatchQueue.global(qos: .utility).asyncAfter(deadline: .now() + commitDelay) { self.commitPending() }
+        }
+    }
+
+    func startLoading() {
+        condition.lock(); defer { condition.unlock() }
+        beginLoadLocked()
     }
-    static func get(_ key: String) -> String? {
-        runBlocking {
-            let store = try await FountainStore.open(.init(path: path()))
-            let coll = await store.collection("settings", of: SettingDoc.self)
-            return try await coll.get(id: key)?.value
+
+    func flush() {
+        condition.lock(); defer { condition.unlock() }
+        if !pending.isEmpty && !committing {
+            commitScheduled = false
+            beginCommitLocked()
         }
+        while committing || !pending.isEmpty { condition.wait() }
+    }
+
+    // MARK: - Internals (call with `condition` held)
+
+    private func waitUntilLoaded() {
+        beginLoadLocked()
+        while loadState != .loaded { condition.wait() }
     }
-    static func set(_ key: String, _ value: String) {
-        _ = runBlocking {
-            let store = try await FountainStore.open(.init(path: path()))
-            let coll = await store.collection("settings", of: SettingDoc.self)
-            try await coll.put(SettingDoc(id: key, value: value))
-            return true
+
+    private func beginLoadLocked() {
+        guard loadState == .idle, let backend else { return }
+        loadState = .loading
+        Task.detached(priority: .userInitiated) {
+            let persisted = await backend.load()
+            self.condition.lock()
+            // Writes made while loading are newer than what was on disk.
+            self.values = persisted.merging(self.values) { _, written in written }
+            self.loadState = .loaded
+            self.condition.broadcast()
+            self.condition.unlock()
         }
     }
-    static func list() -> [String: String] {
-        runBlocking {
-            let store = try await FountainStore.open(.init(path: path()))
-            let coll = await store.collection("settings", of: SettingDoc.self)
-            // Scan all (up to a reasonable limit)
-            let docs = try await coll.scan(prefix: nil, limit: 1000, snapshot: nil)
-            var out: [String: String] = [:]
-            for d in docs { out[d.id] = d.value }
-            return out
-        } ?? [:]
-    }
-    private static func runBlocking<T: Sendable>(_ body: @escaping @Sendable () async throws -> T?) -> T? {
-        let sem = DispatchSemaphore(value: 0)
-        var result: T?
-        Task {
-            defer { sem.signal() }
-            do {
-                result = try await body()
-            } catch {
-                result = nil
-            }
+
+    private func commitPending() {
+        condition.lock(); defer { condition.unlock() }
+        guard commitScheduled else { return }
+        commitScheduled = false
+        if !committing { beginCommitLocked() }
+    }
+
+    /// Commits one batch at a time, so batches land in write order; whatever arrives while
+    /// one is in flight goes in the next.
+    private func beginCommitLocked() {
+        guard let backend, !pending.isEmpty else { return }
+        let batch = pending
+        pending.removeAll()
+        committing = true
+        Task.detached(priority: .utility) {
+            await backend.commit(batch)
+            self.condition.lock()
+            self.committing = false
+            self.commitCount += 1
+            if !self.pending.isEmpty { self.beginCommitLocked() }
+            self.condition.broadcast()
+            self.condition.unlock()
         }
-        sem.wait()
-        return result
     }
-}
-#endif
 
-private actor FallbackSettingsActor {
-    private var storage: [String: String] = [:]
-    func get(_ key: String) -> String? { storage[key] }
-    func set(_ key: String, value: String) { storage[key] = value }
-    func list() -> [String: String] { storage }
+    private static func persistentBackend() -> Backend? {
+#if canImport(FountainStore)
+        let handle = FSSettingsHandle()
+        return Backend(load: { await handle.load() }, commit: { await handle.commit($0) })
+#else
+        return nil
+#endif
+    }
 }
 
-private enum FallbackSettingsBridge {
-    static let actor = FallbackSettingsActor()
+#if canImport(FountainStore)
+private struct SettingDoc: Codable, Identifiable { let id: String; let value: String }
+
+/// The process's one FountainStore handle for settings, opened (and its WAL replayed) once.
+private actor FSSettingsHandle {
+    private var opening: Task<Void, Never>?
+    private var scan: (@Sendable () async throws -> [SettingDoc])?
+    private var putAll: (@Sendable ([SettingDoc]) async throws -> Void)?
 
-    static func get(_ key: String) -> String? {
-        runBlocking { await actor.get(key) }
+    static func path() -> URL {
+        let cwd = URL(fileURLWithPath: FileManager.default.currentDirectoryPath, isDirectory: true)
+        return cwd.appendingPathComponent(".fountain/sdlkit", isDirectory: true)
     }
 
-    static func set(_ key: String, _ value: String) {
-        runBlocking { await actor.set(key, value: value) }
+    /// Opens once; callers that arrive while the WAL replays wait for the same open.
+    private func open() async {
+        if opening == nil { opening = Task { await self.openStore() } }
+        await opening?.value
     }
 
-    static func list() -> [String: String] {
-        runBlocking { await actor.list() }
+    private func openStore() async {
+        guard let store = try? await FountainStore.open(.init(path: Self.path())) else {
+            SDLLogger.warn("SDLKit.Settings", "FountainStore unavailable; settings stay in memory")
+            return
+        }
+        let coll = await store.collection("settings", of: SettingDoc.self)
+        // Scan all (up to a reasonable limit)
+        scan = { try await coll.scan(prefix: nil, limit: 1000, snapshot: nil) }
+        putAll = { docs in try await coll.batch(docs.map { .put($0) }) }
     }
 
-    private static func runBlocking<T: Sendable>(_ body: @escaping @Sendable () async -> T) -> T {
-        let semaphore = DispatchSemaphore(value: 0)
-        var result: T!
-        Task.detached {
-            result = await body()
-            semaphore.signal()
+    func load() async -> [String: String] {
+        await open()
+        guard let scan, let docs = try? await scan() else { return [:] }
+        var out: [String: String] = [:]
+        for d in docs { out[d.id] = d.value }
+        return out
+    }
+
+    func commit(_ changes: [String: String]) async {
+        await open()
+        guard let putAll else { return }
+        do {
+            try await putAll(changes.map { SettingDoc(id: $0.key, value: $0.value) })
+        } catch {
+            SDLLogger.warn("SDLKit.Settings", "Failed to persist \(changes.count) settings: \(error)")
         }
-        semaphore.wait()
-        return result
     }
 }
+#endif
@@ -8,16 +8,29 @@ import SDLKit
 // Generated-server adapter that forwards OpenAPI operations to SDLKitJSONAgent.
 public struct SDLKitAPIServerAdapter: APIProtocol {
     public init() {}
-    private func onMain<T: Sendable>(_ body: @MainActor @escaping () -> T) -> T {
-        var result: T! = nil
-        DispatchQueue.main.sync { result = MainActor.assumeIsolated { body() } }
-        return result
-    }
-    private func call(_ path: String, body: Data) -> OpenAPIRuntime.UndocumentedPayload {
-        let data: Data = onMain { SDLKitJSONAgent().handle(path: path, body: body) }
+    /// One agent for the server's lifetime, so windows opened by one request are visible to later ones.
+    @MainActor private static let agent = SDLKitJSONAgent()
+
+    /// Runs the request where its affinity allows (see `SDLKitJSONAgent.affinity(path:body:)`):
+    /// only SDL window and render work awaits the main actor; audio session requests run on
+    /// their session's serial queue and pure ones inline.
+    private func call(_ path: String, body: Data) async -> OpenAPIRuntime.UndocumentedPayload {
+        let response: SDLKitJSONAgent.Response
+        switch SDLKitJSONAgent.affinity(path: path, body: body) {
+        case .pure:
+            response = SDLKitJSONAgent.respondOffMain(path: path, body: body)
+        case .audioSession(let audioId):
+            response = await withCheckedContinuation { continuation in
+                AudioSessionLanes.shared.queue(for: audioId).async {
+                    continuation.resume(returning: SDLKitJSONAgent.respondOffMain(path: path, body: body))
+                }
+            }
+        case .main:
+            response = await MainActor.run { Self.agent.respond(path: path, body: body) }
+        }
         var fields = HTTPFields()
-        fields[.contentType] = "application/json"
-        return .init(headerFields: fields, body: HTTPBody(data))
+        fields[.contentType] = response.contentType
+        return .init(headerFields: fields, body: HTTPBody(response.body))
     }
     public func openWindow(_ input: Operations.openWindow.Input) async throws -> Operations.openWindow.Output {
         let req: Data
@@ -25,7 +38,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/open", body: req)
+        let payload = await call("/agent/gui/window/open", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max) {
             if let win = try? JSONDecoder().decode(Components.Schemas.WindowId.self, from: data) {
                 return .ok(.init(body: .json(win)))
@@ -43,7 +56,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/close", body: req)
+        let payload = await call("/agent/gui/window/close", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -54,7 +67,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/show", body: req)
+        let payload = await call("/agent/gui/window/show", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -65,7 +78,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/hide", body: req)
+        let payload = await call("/agent/gui/window/hide", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -76,7 +89,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/resize", body: req)
+        let payload = await call("/agent/gui/window/resize", body: req)
         return .undocumented(statusCode: 200, payload)
     }
 
@@ -86,7 +99,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/getInfo", body: req)
+        let payload = await call("/agent/gui/window/getInfo", body: req)
         return .undocumented(statusCode: 200, payload)
     }
 
@@ -96,7 +109,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/setTitle", body: req)
+        let payload = await call("/agent/gui/window/setTitle", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -107,7 +120,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/setPosition", body: req)
+        let payload = await call("/agent/gui/window/setPosition", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -118,7 +131,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/maximize", body: req)
+        let payload = await call("/agent/gui/window/maximize", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -129,7 +142,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/minimize", body: req)
+        let payload = await call("/agent/gui/window/minimize", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -140,7 +153,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/restore", body: req)
+        let payload = await call("/agent/gui/window/restore", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -151,7 +164,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/center", body: req)
+        let payload = await call("/agent/gui/window/center", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -162,7 +175,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/setFullscreen", body: req)
+        let payload = await call("/agent/gui/window/setFullscreen", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -173,7 +186,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/setOpacity", body: req)
+        let payload = await call("/agent/gui/window/setOpacity", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -184,7 +197,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/window/setAlwaysOnTop", body: req)
+        let payload = await call("/agent/gui/window/setAlwaysOnTop", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -195,7 +208,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/clear", body: req)
+        let payload = await call("/agent/gui/clear", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -206,7 +219,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/drawRectangle", body: req)
+        let payload = await call("/agent/gui/drawRectangle", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -217,7 +230,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/drawLine", body: req)
+        let payload = await call("/agent/gui/drawLine", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -228,7 +241,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/drawCircleFilled", body: req)
+        let payload = await call("/agent/gui/drawCircleFilled", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -239,7 +252,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/present", body: req)
+        let payload = await call("/agent/gui/present", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -250,7 +263,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/drawText", body: req)
+        let payload = await call("/agent/gui/drawText", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max) {
             if let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) {
                 return .ok(.init(body: .json(ok)))
@@ -268,7 +281,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/screenshot/capture", body: req)
+        let payload = await call("/agent/gui/screenshot/capture", body: req)
         return .undocumented(statusCode: 200, payload)
     }
 
@@ -278,13 +291,13 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/captureEvent", body: req)
+        let payload = await call("/agent/gui/captureEvent", body: req)
         return .undocumented(statusCode: 200, payload)
     }
 
     public func clipboardGet(_ input: Operations.clipboardGet.Input) async throws -> Operations.clipboardGet.Output {
         let req = Data("{}".utf8)
-        let payload = call("/agent/gui/clipboard/get", body: req)
+        let payload = await call("/agent/gui/clipboard/get", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let got = try? JSONDecoder().decode(Operations.clipboardGet.Output.Ok.Body.jsonPayload.self, from: data) {
             return .ok(.init(body: .json(got)))
         }
@@ -297,14 +310,14 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/clipboard/set", body: req)
+        let payload = await call("/agent/gui/clipboard/set", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
 
     public func getKeyboardState(_ input: Operations.getKeyboardState.Input) async throws -> Operations.getKeyboardState.Output {
         let req = Data("{}".utf8)
-        let payload = call("/agent/gui/input/getKeyboardState", body: req)
+        let payload = await call("/agent/gui/input/getKeyboardState", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ks = try? JSONDecoder().decode(Components.Schemas.KeyboardState.self, from: data) {
             return .ok(.init(body: .json(ks)))
         }
@@ -313,7 +326,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
 
     public func getMouseState(_ input: Operations.getMouseState.Input) async throws -> Operations.getMouseState.Output {
         let req = Data("{}".utf8)
-        let payload = call("/agent/gui/input/getMouseState", body: req)
+        let payload = await call("/agent/gui/input/getMouseState", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ms = try? JSONDecoder().decode(Components.Schemas.MouseState.self, from: data) {
             return .ok(.init(body: .json(ms)))
         }
@@ -322,7 +335,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
 
     public func listDisplays(_ input: Operations.listDisplays.Input) async throws -> Operations.listDisplays.Output {
         let req = Data("{}".utf8)
-        let payload = call("/agent/gui/display/list", body: req)
+        let payload = await call("/agent/gui/display/list", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let out = try? JSONDecoder().decode(Operations.listDisplays.Output.Ok.Body.jsonPayload.self, from: data) {
             return .ok(.init(body: .json(out)))
         }
@@ -335,7 +348,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/display/getInfo", body: req)
+        let payload = await call("/agent/gui/display/getInfo", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let info = try? JSONDecoder().decode(Components.Schemas.DisplayInfo.self, from: data) {
             return .ok(.init(body: .json(info)))
         }
@@ -348,7 +361,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/texture/load", body: req)
+        let payload = await call("/agent/gui/texture/load", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -359,7 +372,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/texture/draw", body: req)
+        let payload = await call("/agent/gui/texture/draw", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -370,7 +383,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/texture/drawTiled", body: req)
+        let payload = await call("/agent/gui/texture/drawTiled", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -381,7 +394,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/texture/drawRotated", body: req)
+        let payload = await call("/agent/gui/texture/drawRotated", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -392,7 +405,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/texture/free", body: req)
+        let payload = await call("/agent/gui/texture/free", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -403,7 +416,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/render/getOutputSize", body: req)
+        let payload = await call("/agent/gui/render/getOutputSize", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let val = try? JSONDecoder().decode(Operations.renderGetOutputSize.Output.Ok.Body.jsonPayload.self, from: data) {
             return .ok(.init(body: .json(val)))
         }
@@ -416,7 +429,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/render/getScale", body: req)
+        let payload = await call("/agent/gui/render/getScale", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let val = try? JSONDecoder().decode(Operations.renderGetScale.Output.Ok.Body.jsonPayload.self, from: data) {
             return .ok(.init(body: .json(val)))
         }
@@ -429,7 +442,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/render/setScale", body: req)
+        let payload = await call("/agent/gui/render/setScale", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -440,7 +453,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/render/getDrawColor", body: req)
+        let payload = await call("/agent/gui/render/getDrawColor", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let val = try? JSONDecoder().decode(Operations.renderGetDrawColor.Output.Ok.Body.jsonPayload.self, from: data) {
             return .ok(.init(body: .json(val)))
         }
@@ -453,7 +466,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/render/setDrawColor", body: req)
+        let payload = await call("/agent/gui/render/setDrawColor", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -464,7 +477,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/render/getViewport", body: req)
+        let payload = await call("/agent/gui/render/getViewport", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let rect = try? JSONDecoder().decode(Components.Schemas.Rect.self, from: data) {
             return .ok(.init(body: .json(rect)))
         }
@@ -477,7 +490,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/render/setViewport", body: req)
+        let payload = await call("/agent/gui/render/setViewport", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -488,7 +501,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/render/getClipRect", body: req)
+        let payload = await call("/agent/gui/render/getClipRect", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let rect = try? JSONDecoder().decode(Components.Schemas.Rect.self, from: data) {
             return .ok(.init(body: .json(rect)))
         }
@@ -501,7 +514,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/render/setClipRect", body: req)
+        let payload = await call("/agent/gui/render/setClipRect", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -512,7 +525,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/render/disableClipRect", body: req)
+        let payload = await call("/agent/gui/render/disableClipRect", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -523,7 +536,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/drawPoints", body: req)
+        let payload = await call("/agent/gui/drawPoints", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -534,7 +547,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/drawLines", body: req)
+        let payload = await call("/agent/gui/drawLines", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -545,7 +558,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/gui/drawRects", body: req)
+        let payload = await call("/agent/gui/drawRects", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) { return .ok(.init(body: .json(ok))) }
         return .undocumented(statusCode: 200, payload)
     }
@@ -556,7 +569,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/audio/devices", body: req)
+        let payload = await call("/agent/audio/devices", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max) {
             if let out = try? JSONDecoder().decode(Operations.audioDevices.Output.Ok.Body.jsonPayload.self, from: data) {
                 return .ok(.init(body: .json(out)))
@@ -573,7 +586,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .none:
             req = Data("{}".utf8)
         }
-        let payload = call("/agent/audio/capture/open", body: req)
+        let payload = await call("/agent/audio/capture/open", body: req)
         return .undocumented(statusCode: 200, payload)
     }
 
@@ -583,7 +596,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/audio/capture/read", body: req)
+        let payload = await call("/agent/audio/capture/read", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max) {
             if let out = try? JSONDecoder().decode(Components.Schemas.AudioFrames.self, from: data) {
                 return .ok(.init(body: .json(out)))
@@ -600,7 +613,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .none:
             req = Data("{}".utf8)
         }
-        let payload = call("/agent/audio/playback/open", body: req)
+        let payload = await call("/agent/audio/playback/open", body: req)
         return .undocumented(statusCode: 200, payload)
     }
 
@@ -610,7 +623,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/audio/playback/sine", body: req)
+        let payload = await call("/agent/audio/playback/sine", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max) {
             if let out = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) {
                 return .ok(.init(body: .json(out)))
@@ -625,7 +638,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/audio/playback/queue/open", body: req)
+        let payload = await call("/agent/audio/playback/queue/open", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max) {
             if let out = try? JSONDecoder().decode(Operations.audioPlaybackQueueOpen.Output.Ok.Body.jsonPayload.self, from: data) {
                 return .ok(.init(body: .json(out)))
@@ -640,7 +653,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/audio/playback/queue/enqueue", body: req)
+        let payload = await call("/agent/audio/playback/queue/enqueue", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max) {
             if let out = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) {
                 return .ok(.init(body: .json(out)))
@@ -655,7 +668,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/audio/playback/play_wav", body: req)
+        let payload = await call("/agent/audio/playback/play_wav", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max) {
             if let out = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) {
                 return .ok(.init(body: .json(out)))
@@ -670,7 +683,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/audio/monitor/start", body: req)
+        let payload = await call("/agent/audio/monitor/start", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max) {
             if let out = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) {
                 return .ok(.init(body: .json(out)))
@@ -685,7 +698,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/audio/monitor/stop", body: req)
+        let payload = await call("/agent/audio/monitor/stop", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max) {
             if let out = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) {
                 return .ok(.init(body: .json(out)))
@@ -702,7 +715,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .none:
             req = Data("{}".utf8)
         }
-        let payload = call("/agent/midi/start", body: req)
+        let payload = await call("/agent/midi/start", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) {
             return .ok(.init(body: .json(ok)))
         }
@@ -711,7 +724,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
 
     public func midiStop(_ input: Operations.midiStop.Input) async throws -> Operations.midiStop.Output {
         let req = Data("{}".utf8)
-        let payload = call("/agent/midi/stop", body: req)
+        let payload = await call("/agent/midi/stop", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) {
             return .ok(.init(body: .json(ok)))
         }
@@ -720,7 +733,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
 
     public func midiDestinations(_ input: Operations.midiDestinations.Input) async throws -> Operations.midiDestinations.Output {
         let req = Data("{}".utf8)
-        let payload = call("/agent/midi/destinations", body: req)
+        let payload = await call("/agent/midi/destinations", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let out = try? JSONDecoder().decode(Operations.midiDestinations.Output.Ok.Body.jsonPayload.self, from: data) {
             return .ok(.init(body: .json(out)))
         }
@@ -733,7 +746,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/midi/select", body: req)
+        let payload = await call("/agent/midi/select", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) {
             return .ok(.init(body: .json(ok)))
         }
@@ -746,7 +759,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/midi/selectByName", body: req)
+        let payload = await call("/agent/midi/selectByName", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) {
             return .ok(.init(body: .json(ok)))
         }
@@ -759,16 +772,46 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
         case .json(let payload):
             req = try JSONEncoder().encode(payload)
         }
-        let payload = call("/agent/midi/channel", body: req)
+        let payload = await call("/agent/midi/channel", body: req)
         if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let ok = try? JSONDecoder().decode(Components.Schemas.Ok.self, from: data) {
             return .ok(.init(body: .json(ok)))
         }
         return .undocumented(statusCode: 200, payload)
     }
 
+    public func gpuTimings(_ input: Operations.gpuTimings.Input) async throws -> Operations.gpuTimings.Output {
+        let req: Data
+        switch input.body {
+        case .some(.json(let payload)):
+            req = try JSONEncoder().encode(payload)
+        case .none:
+            req = Data("{}".utf8)
+        }
+        let payload = await call("/agent/gpu/timings", body: req)
+        if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let out = try? JSONDecoder().decode(Operations.gpuTimings.Output.Ok.Body.jsonPayload.self, from: data) {
+            return .ok(.init(body: .json(out)))
+        }
+        return .undocumented(statusCode: 200, payload)
+    }
+
+    public func profilerTrace(_ input: Operations.profilerTrace.Input) async throws -> Operations.profilerTrace.Output {
+        let req: Data
+        switch input.body {
+        case .some(.json(let payload)):
+            req = try JSONEncoder().encode(payload)
+        case .none:
+            req = Data("{}".utf8)
+        }
+        let payload = await call("/agent/profiler/trace", body: req)
+        if let body = payload.body, let data = try? await Data(collecting: body, upTo: .max), let out = try? JSONDecoder().decode(Operations.profilerTrace.Output.Ok.Body.jsonPayload.self, from: data) {
+            return .ok(.init(body: .json(out)))
+        }
+        return .undocumented(statusCode: 200, payload)
+    }
+
     public func health(_ input: Operations.health.Input) async throws -> Operations.health.Output {
         let req = Data("{}".utf8)
-        let payload = call("/health", body: req)
+        let payload = await call("/health", body: req)
         if let body = payload.body {
             if let data = try? await Data(collecting: body, upTo: .max),
                let obj = try? JSONDecoder().decode([String: Bool].self, from: data),
@@ -781,7 +824,7 @@ public struct SDLKitAPIServerAdapter: APIProtocol {
 
     public func version(_ input: Operations.version.Input) async throws -> Operations.version.Output {
         let req = Data("{}".utf8)
-        let payload = call("/version", body: req)
+        let payload = await call("/version", body: req)
         if let body = payload.body {
             if let data = try? await Data(collecting: body, upTo: .max),
                let obj = try? JSONDecoder().decode([String: String].self, from: data),
@@ -32,6 +32,8 @@ struct DemoApp {
             print("GUI disabled. Set SDLKIT_GUI_ENABLED=1 to enable.")
             return
         }
+        // Load persisted settings while SDL and the backend start up.
+        SettingsStore.prewarm()
 
         #if os(macOS)
         let platform: DemoPlatform = .macOS
@@ -351,11 +353,10 @@ struct DemoApp {
             litNode.localTransform = float4x4.rotationZ(-t) * float4x4.translation(x: 0.8, y: 0, z: 0)
             // Animate light direction subtly
             scene.lightDirection = (0.3 * cosf(t) + 0.3, -0.5, 0.8 * sinf(t) + 0.2)
-            try SceneGraphRenderer.updateAndRender(scene: scene, backend: backend, beforeRender: {
-                if let resources = computeResources {
-                    try SceneGraphComputeInterop.dispatchCompute(backend: backend, resources: resources)
-                }
-            })
+            if let resources = computeResources {
+                try SceneGraphComputeInterop.dispatchCompute(backend: backend, resources: resources)
+            }
+            try SceneGraphRenderer.updateAndRender(scene: scene, backend: backend)
             Thread.sleep(forTimeInterval: 1.0 / 60.0)
         }
     }
@@ -0,0 +1,427 @@
+import Foundation
+import NIOCore
+import NIOPosix
+import NIOHTTP1
+import SDLKit
+
+// Loopback load generator for SDLKitNIO.
+//
+// Starts the server (or targets one with --url) with SDL's dummy video and audio drivers, so
+// no display, sound card or GPU is needed; stub builds answer SDL endpoints with errors, which
+// are counted. Each connection is a closed loop over keep-alive HTTP/1.1: pick an endpoint
+// from the weighted mix, send it, wait for the response, repeat. After a warmup the harness
+// reports throughput and p50/p95/p99 latency per endpoint as JSON.
+//
+//     swift run SDLKitLoad --connections 32 --duration 10 --mix health=4,draw=4,capture_read=1,a2m_poll=1,screenshot=1
+
+struct Options {
+    var host = "127.0.0.1"
+    var port = 18723
+    var external = false
+    var serverPath: String?
+    var connections = 16
+    var duration = 10.0
+    var warmup = 1.0
+    var binary = false
+    var mix: [(Scenario, Int)] = [(.health, 4), (.draw, 4), (.captureRead, 1), (.a2mPoll, 1), (.screenshot, 1)]
+    var output: String?
+
+    static let usage = """
+    usage: SDLKitLoad [--url host:port | --server <SDLKitNIO path>] [--port N] [--connections N]
+                      [--duration seconds] [--warmup seconds] [--mix name=weight,...] [--binary] [--out file]
+    endpoints: \(Scenario.allCases.map(\.rawValue).joined(separator: ", "))
+    """
+
+    static func parse(_ args: [String]) -> Options? {
+        var options = Options()
+        var it = args.makeIterator()
+        while let a = it.next() {
+            switch a {
+            case "--url":
+                guard let raw = it.next() else { return nil }
+                let hostPort = raw.replacingOccurrences(of: "http://", with: "").split(separator: "/").first.map(String.init) ?? raw
+                let parts = hostPort.split(separator: ":")
+                guard parts.count == 2, let port = Int(parts[1]) else { return nil }
+                options.host = String(parts[0]); options.port = port; options.external = true
+            case "--server": options.serverPath = it.next()
+            case "--port": guard let v = it.next().flatMap(Int.init) else { return nil }; options.port = v
+            case "--connections", "-c": guard let v = it.next().flatMap(Int.init), v > 0 else { return nil }; options.connections = v
+            case "--duration", "-d": guard let v = it.next().flatMap(Double.init), v > 0 else { return nil }; options.duration = v
+            case "--warmup": guard let v = it.next().flatMap(Double.init), v >= 0 else { return nil }; options.warmup = v
+            case "--binary": options.binary = true
+            case "--out", "-o": options.output = it.next()
+            case "--mix":
+                guard let raw = it.next() else { return nil }
+                var mix: [(Scenario, Int)] = []
+                for entry in raw.split(separator: ",") {
+                    let kv = entry.split(separator: "=")
+                    guard let scenario = Scenario(rawValue: String(kv[0])) else { return nil }
+                    let weight = kv.count > 1 ? Int(kv[1]) ?? -1 : 1
+                    guard weight >= 0 else { return nil }
+                    if weight > 0 { mix.append((scenario, weight)) }
+                }
+                guard !mix.isEmpty else { return nil }
+                options.mix = mix
+            default: return nil
+            }
+        }
+        return options
+    }
+}
+
+enum Scenario: String, CaseIterable {
+    case health
+    case draw
+    case captureRead = "capture_read"
+    case a2mPoll = "a2m_poll"
+    case screenshot
+
+    var path: String {
+        switch self {
+        case .health: return SDLKitJSONAgent.Endpoint.health.rawValue
+        case .draw: return SDLKitJSONAgent.Endpoint.drawRect.rawValue
+        case .captureRead: return SDLKitJSONAgent.Endpoint.audioCaptureRead.rawValue
+        case .a2mPoll: return SDLKitJSONAgent.Endpoint.audioA2MStreamPoll.rawValue
+        case .screenshot: return SDLKitJSONAgent.Endpoint.screenshot.rawValue
+        }
+    }
+
+    func request(_ setup: Setup, binary: Bool) -> LoadRequest {
+        let windowId = setup.windowId ?? 1, audioId = setup.audioId ?? 1
+        let body: String
+        switch self {
+        case .health: body = "{}"
+        case .draw: body = #"{"window_id":\#(windowId),"x":8,"y":8,"width":32,"height":32,"color":4282664004}"#
+        case .captureRead: body = #"{"audio_id":\#(audioId),"frames":256}"#
+        case .a2mPoll: body = #"{"audio_id":\#(audioId),"since":0,"max_events":64,"timeout_ms":0}"#
+        case .screenshot: body = #"{"window_id":\#(windowId),"format":"raw"}"#
+        }
+        let bulk = self == .captureRead || self == .screenshot
+        return LoadRequest(path: path, body: body, accept: binary && bulk ? BinaryPayload.contentType : nil)
+    }
+}
+
+struct LoadRequest {
+    let path: String
+    let body: ByteBuffer
+    let accept: String?
+    var keepBody = false
+
+    init(path: String, body: String, accept: String? = nil) {
+        self.path = path
+        self.body = ByteBuffer(string: body)
+        self.accept = accept
+    }
+}
+
+struct Reply {
+    var status = 0
+    var bytes = 0
+    /// Non-200, or a JSON error body.
+    var isError = false
+    var body = ByteBuffer()
+}
+
+/// One keep-alive client connection carrying one request at a time.
+final class LoadConnection: ChannelInboundHandler, @unchecked Sendable {
+    typealias InboundIn = HTTPClientResponsePart
+    typealias OutboundOut = HTTPClientRequestPart
+
+    private static let errorPrefix = Array(#"{"error""#.utf8)
+
+    // Touched only on the channel's event loop.
+    private var context: ChannelHandlerContext?
+    private var pending: EventLoopPromise<Reply>?
+    private var reply = Reply()
+    private var keepBody = false
+    private var prefix: [UInt8] = []
+
+    func handlerAdded(context: ChannelHandlerContext) { self.context = context }
+
+    func send(_ request: LoadRequest, host: String) -> EventLoopFuture<Reply> {
+        guard let eventLoop = context?.eventLoop else {
+            return MultiThreadedEventLoopGroup.singleton.next().makeFailedFuture(ChannelError.ioOnClosedChannel)
+        }
+        let promise = eventLoop.makePromise(of: Reply.self)
+        if eventLoop.inEventLoop {
+            write(request, host: host, promise: promise)
+        } else {
+            eventLoop.execute { self.write(request, host: host, promise: promise) }
+        }
+        return promise.futureResult
+    }
+
+    private func write(_ request: LoadRequest, host: String, promise: EventLoopPromise<Reply>) {
+        guard let context, pending == nil else { return promise.fail(ChannelError.inappropriateOperationForState) }
+        pending = promise
+        reply = Reply()
+        keepBody = request.keepBody
+        prefix.removeAll(keepingCapacity: true)
+        var headers = HTTPHeaders()
+        headers.add(name: "host", value: host)
+        headers.add(name: "content-type", value: "application/json")
+        headers.add(name: "content-length", value: String(request.body.readableBytes))
+        if let accept = request.accept { headers.add(name: "accept", value: accept) }
+        let head = HTTPRequestHead(version: .http1_1, method: .POST, uri: request.path, headers: headers)
+        context.write(wrapOutboundOut(.head(head)), promise: nil)
+        context.write(wrapOutboundOut(.body(.byteBuffer(request.body))), promise: nil)
+        context.writeAndFlush(wrapOutboundOut(.end(nil))).whenFailure { self.failPending($0) }
+    }
+
+    func channelRead(context: ChannelHandlerContext, data: NIOAny) {
+        switch unwrapInboundIn(data) {
+        case .head(let head):
+            reply.status = Int(head.status.code)
+        case .body(var buf):
+            if prefix.count < Self.errorPrefix.count {
+                prefix += buf.getBytes(at: buf.readerIndex, length: min(buf.readableBytes, Self.errorPrefix.count - prefix.count)) ?? []
+            }
+            reply.bytes += buf.readableBytes
+            if keepBody { reply.body.writeBuffer(&buf) }
+        case .end:
+            reply.isError = reply.status != 200 || prefix == Self.errorPrefix
+            let promise = pending
+            pending = nil
+            promise?.succeed(reply)
+        }
+    }
+
+    func errorCaught(context: ChannelHandlerContext, error: Error) {
+        failPending(error)
+        context.close(promise: nil)
+    }
+
+    func channelInactive(context: ChannelHandlerContext) {
+        failPending(ChannelError.ioOnClosedChannel)
+        context.fireChannelInactive()
+    }
+
+    private func failPending(_ error: Error) {
+        let promise = pending
+        pending = nil
+        promise?.fail(error)
+    }
+
+    static func connect(group: EventLoopGroup, host: String, port: Int) throws -> (Channel, LoadConnection) {
+        let channel = try ClientBootstrap(group: group)
+            .channelOption(ChannelOptions.socketOption(.tcp_nodelay), value: 1)
+            .channelInitializer { channel in
+                channel.pipeline.addHTTPClientHandlers().flatMap {
+                    channel.pipeline.addHandler(LoadConnection())
+                }
+            }
+            .connect(host: host, port: port)
+            .wait()
+        return (channel, try channel.pipeline.handler(type: LoadConnection.self).wait())
+    }
+}
+
+/// Ids the mix runs against; nil when opening the resource failed (stub builds).
+struct Setup {
+    var windowId: Int?
+    var audioId: Int?
+    var a2mStream = false
+}
+
+/// Drives one connection until the deadline, recording latencies after warmup.
+final class LoadWorker: @unchecked Sendable {
+    let connection: LoadConnection
+    let host: String
+    let requests: [LoadRequest]
+    let cumulativeWeights: [Int]
+    let measureFrom: NIODeadline
+    let deadline: NIODeadline
+    let done: EventLoopPromise<Void>
+
+    // Touched only on the connection's event loop until `done` completes.
+    var latencies: [[Int64]]
+    var errors: [Int]
+    var failures: [Int]
+    private var rng = SystemRandomNumberGenerator()
+
+    init(connection: LoadConnection, channel: Channel, host: String, requests: [LoadRequest], weights: [Int], measureFrom: NIODeadline, deadline: NIODeadline) {
+        self.connection = connection
+        self.host = host
+        self.requests = requests
+        var running = 0
+        self.cumulativeWeights = weights.map { running += $0; return running }
+        self.measureFrom = measureFrom
+        self.deadline = deadline
+        self.done = channel.eventLoop.makePromise()
+        self.latencies = Array(repeating: [], count: requests.count)
+        self.errors = Array(repeating: 0, count: requests.count)
+        self.failures = Array(repeating: 0, count: requests.count)
+        channel.eventLoop.execute { self.next() }
+    }
+
+    private func next() {
+        let start = NIODeadline.now()
+        guard start < deadline else { return done.succeed(()) }
+        let pick = Int.random(in: 0..<cumulativeWeights[cumulativeWeights.count - 1], using: &rng)
+        let index = cumulativeWeights.firstIndex { pick < $0 } ?? 0
+        connection.send(requests[index], host: host).whenComplete { result in
+            let measured = start >= self.measureFrom
+            switch result {
+            case .success(let reply):
+                if measured {
+                    self.latencies[index].append((NIODeadline.now() - start).nanoseconds)
+                    if reply.isError { self.errors[index] += 1 }
+                }
+                self.next()
+            case .failure:
+                // The connection is gone; stop this worker rather than spin.
+                if measured { self.failures[index] += 1 }
+                self.done.succeed(())
+            }
+        }
+    }
+}
+
+func percentile(_ sorted: [Int64], _ p: Double) -> Double {
+    guard !sorted.isEmpty else { return 0 }
+    let rank = Int((p * Double(sorted.count)).rounded(.up)) - 1
+    return Double(sorted[min(max(rank, 0), sorted.count - 1)]) / 1_000_000
+}
+
+func rounded(_ value: Double) -> Double { (value * 1000).rounded() / 1000 }
+
+func call(_ connection: LoadConnection, host: String, _ path: String, _ body: String) -> [String: Any]? {
+    var request = LoadRequest(path: path, body: body)
+    request.keepBody = true
+    guard let reply = try? connection.send(request, host: host).wait(), !reply.isError,
+          let bytes = reply.body.getBytes(at: reply.body.readerIndex, length: reply.body.readableBytes) else { return nil }
+    return (try? JSONSerialization.jsonObject(with: Data(bytes))) as? [String: Any]
+}
+
+func prepare(_ connection: LoadConnection, host: String) -> Setup {
+    var setup = Setup()
+    setup.windowId = call(connection, host: host, SDLKitJSONAgent.Endpoint.open.rawValue, #"{"title":"SDLKitLoad","width":320,"height":240}"#)?["window_id"] as? Int
+    if let windowId = setup.windowId {
+        _ = call(connection, host: host, SDLKitJSONAgent.Endpoint.clear.rawValue, #"{"window_id":\#(windowId),"color":4278190080}"#)
+    }
+    setup.audioId = call(connection, host: host, SDLKitJSONAgent.Endpoint.audioCaptureOpen.rawValue, "{}")?["audio_id"] as? Int
+    if let audioId = setup.audioId {
+        let session = #"{"audio_id":\#(audioId)}"#
+        setup.a2mStream = call(connection, host: host, SDLKitJSONAgent.Endpoint.audioFeaturesStart.rawValue, session) != nil
+            && call(connection, host: host, SDLKitJSONAgent.Endpoint.audioA2MStart.rawValue, #"{"audio_id":\#(audioId),"mel_bands":64}"#) != nil
+            && call(connection, host: host, SDLKitJSONAgent.Endpoint.audioA2MStreamStart.rawValue, session) != nil
+    }
+    return setup
+}
+
+func teardown(_ connection: LoadConnection, host: String, _ setup: Setup) {
+    if let audioId = setup.audioId, setup.a2mStream {
+        _ = call(connection, host: host, SDLKitJSONAgent.Endpoint.audioA2MStreamStop.rawValue, #"{"audio_id":\#(audioId)}"#)
+    }
+    if let windowId = setup.windowId {
+        _ = call(connection, host: host, SDLKitJSONAgent.Endpoint.close.rawValue, #"{"window_id":\#(windowId)}"#)
+    }
+}
+
+func startServer(_ options: Options) throws -> Process {
+    let path = options.serverPath ?? URL(fileURLWithPath: CommandLine.arguments[0])
+        .deletingLastPathComponent().appendingPathComponent("SDLKitNIO").path
+    let process = Process()
+    process.executableURL = URL(fileURLWithPath: path)
+    var env = ProcessInfo.processInfo.environment
+    env["SDLKIT_NIO_PORT"] = String(options.port)
+    env["SDL_VIDEO_DRIVER"] = env["SDL_VIDEO_DRIVER"] ?? "dummy"
+    env["SDL_AUDIO_DRIVER"] = env["SDL_AUDIO_DRIVER"] ?? "dummy"
+    process.environment = env
+    process.standardOutput = FileHandle.nullDevice
+    try process.run()
+    return process
+}
+
+/// Waits for `/health` so the first measured requests do not include server start-up.
+func connectWhenReady(group: EventLoopGroup, options: Options, timeout: TimeInterval = 15) throws -> (Channel, LoadConnection) {
+    let limit = Date().addingTimeInterval(timeout)
+    while true {
+        do {
+            let (channel, connection) = try LoadConnection.connect(group: group, host: options.host, port: options.port)
+            if call(connection, host: options.host, SDLKitJSONAgent.Endpoint.health.rawValue, "{}") != nil { return (channel, connection) }
+            channel.close(promise: nil)
+        } catch where Date() < limit {
+        }
+        guard Date() < limit else { throw ChannelError.connectTimeout(.seconds(Int64(timeout))) }
+        Thread.sleep(forTimeInterval: 0.1)
+    }
+}
+
+guard let options = Options.parse(Array(CommandLine.arguments.dropFirst())) else {
+    FileHandle.standardError.write(Data((Options.usage + "\n").utf8))
+    exit(2)
+}
+
+let group = MultiThreadedEventLoopGroup(numberOfThreads: min(System.coreCount, options.connections))
+var server: Process?
+do {
+    if !options.external { server = try startServer(options) }
+    let (controlChannel, control) = try connectWhenReady(group: group, options: options)
+    let setup = prepare(control, host: options.host)
+
+    let scenarios = options.mix.map { $0.0 }
+    let requests = scenarios.map { $0.request(setup, binary: options.binary) }
+    var channels: [Channel] = []
+    var workers: [LoadWorker] = []
+    let begin = NIODeadline.now()
+    let measureFrom = begin + .nanoseconds(Int64(options.warmup * 1e9))
+    let deadline = measureFrom + .nanoseconds(Int64(options.duration * 1e9))
+    for _ in 0..<options.connections {
+        let (channel, connection) = try LoadConnection.connect(group: group, host: options.host, port: options.port)
+        channels.append(channel)
+        workers.append(LoadWorker(connection: connection, channel: channel, host: options.host, requests: requests,
+                                  weights: options.mix.map { $0.1 }, measureFrom: measureFrom, deadline: deadline))
+    }
+    for worker in workers { try worker.done.futureResult.wait() }
+    let elapsed = Double((NIODeadline.now() - measureFrom).nanoseconds) / 1e9
+    for channel in channels { channel.close(promise: nil) }
+    teardown(control, host: options.host, setup)
+    controlChannel.close(promise: nil)
+
+    // Merge per-connection samples by endpoint (a scenario may appear in the mix once).
+    var endpoints: [String: Any] = [:]
+    var totalRequests = 0, totalErrors = 0
+    for (index, scenario) in scenarios.enumerated() {
+        let samples = workers.flatMap { $0.latencies[index] }.sorted()
+        let errors = workers.reduce(0) { $0 + $1.errors[index] + $1.failures[index] }
+        let mean = samples.isEmpty ? 0 : Double(samples.reduce(0, +)) / Double(samples.count) / 1_000_000
+        totalRequests += samples.count
+        totalErrors += errors
+        endpoints[scenario.rawValue] = [
+            "path": scenario.path,
+            "requests": samples.count,
+            "errors": errors,
+            "throughput_rps": rounded(Double(samples.count) / elapsed),
+            "mean_ms": rounded(mean),
+            "p50_ms": rounded(percentile(samples, 0.50)),
+            "p95_ms": rounded(percentile(samples, 0.95)),
+            "p99_ms": rounded(percentile(samples, 0.99)),
+            "max_ms": rounded(samples.last.map { Double($0) / 1_000_000 } ?? 0)
+        ] as [String: Any]
+    }
+    var setupReport: [String: Any] = ["a2m_stream": setup.a2mStream]
+    setupReport["window_id"] = setup.windowId ?? NSNull()
+    setupReport["audio_id"] = setup.audioId ?? NSNull()
+    let report: [String: Any] = [
+        "target": "\(options.host):\(options.port)",
+        "connections": options.connections,
+        "duration_s": rounded(elapsed),
+        "warmup_s": options.warmup,
+        "binary": options.binary,
+        "setup": setupReport,
+        "total": ["requests": totalRequests, "errors": totalErrors, "throughput_rps": rounded(Double(totalRequests) / elapsed)] as [String: Any],
+        "endpoints": endpoints
+    ]
+    let json = try JSONSerialization.data(withJSONObject: report, options: [.sortedKeys, .prettyPrinted])
+    print(String(decoding: json, as: UTF8.self))
+    if let output = options.output { try json.write(to: URL(fileURLWithPath: output)) }
+    server?.terminate()
+    try? group.syncShutdownGracefully()
+    exit(totalRequests > 0 ? 0 : 1)
+} catch {
+    FileHandle.standardError.write(Data("SDLKitLoad: \(error)\n".utf8))
+    server?.terminate()
+    try? group.syncShutdownGracefully()
+    exit(1)
+}
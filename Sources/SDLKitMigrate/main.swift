@@ -42,6 +42,9 @@ struct SDLKitMigrateCLI {
         // Golden flow
         migrateBool(envKey: "SDLKIT_GOLDEN_AUTO_WRITE", settingsKey: SDLKitConfigStore.Keys.goldenAutoWrite)
 
+        // All migrated settings in one batch, on disk before the summary
+        SettingsStore.flush()
+
         // Print summary JSON
         var dict: [String: String] = [:]
         for (k,v) in changes { dict[k] = v }
@@ -4,13 +4,28 @@ import NIOPosix
 import NIOHTTP1
 import SDLKit
 
+/// One agent for the server's lifetime, so windows opened by one request are visible to
+/// later ones (and to frame streams).
+@MainActor
+enum ServerAgent {
+    static let shared = SDLKitJSONAgent()
+}
+
 final class HTTPHandler: ChannelInboundHandler, @unchecked Sendable {
     typealias InboundIn = HTTPServerRequestPart
     typealias OutboundOut = HTTPServerResponsePart
 
     private var bodyData = Data()
     private var currentPath: String?
-    // Helper to hop to main actor synchronously
+    private var currentQuery: String?
+    private var currentAccept: String?
+
+    // Frame stream state; touched only on the channel's event loop.
+    private var stream: FrameStreamSession?
+    private var streamTask: RepeatedTask?
+    private var frameInFlight = false
+    private var droppedFrames = 0
+    // Hops to the main actor synchronously; used only to set up frame streams.
     private func onMain<T: Sendable>(_ body: @MainActor @escaping () -> T) -> T {
         var result: T! = nil
         DispatchQueue.main.sync {
@@ -27,9 +42,12 @@ final class HTTPHandler: ChannelInboundHandler, @unchecked Sendable {
             // Parse URI path only (ignore query for now)
             if let qidx = request.uri.firstIndex(of: "?") {
                 currentPath = String(request.uri[..<qidx])
+                currentQuery = String(request.uri[request.uri.index(after: qidx)...])
             } else {
                 currentPath = request.uri
+                currentQuery = nil
             }
+            currentAccept = request.headers.first(name: "accept")
         case .body(let buf):
             var b = buf
             if let bytes = b.readBytes(length: b.readableBytes) {
@@ -39,21 +57,205 @@ final class HTTPHandler: ChannelInboundHandler, @unchecked Sendable {
             // Route by path; forward to SDLKitJSONAgent
             let reqBody = bodyData
             let path = currentPath ?? "/health"
-            let responseData: Data = onMain { SDLKitJSONAgent().handle(path: path, body: reqBody) }
+            if path == SDLKitJSONAgent.Endpoint.frameStream.rawValue {
+                startFrameStream(context: context, body: reqBody.isEmpty ? Self.queryBody(currentQuery) : reqBody)
+                return
+            }
+            let loopBound = NIOLoopBound(context, eventLoop: context.eventLoop)
+            let accept = currentAccept
+            if BinaryPayload.accepts(accept), path == SDLKitJSONAgent.Endpoint.audioCaptureRead.rawValue,
+               case .audioSession(let audioId) = SDLKitJSONAgent.affinity(path: path, body: reqBody) {
+                // Samples go from the capture ring straight into the response buffer.
+                let allocator = context.channel.allocator
+                AudioSessionLanes.shared.queue(for: audioId).async {
+                    var buf = allocator.buffer(capacity: 0)
+                    do {
+                        try SDLKitJSONAgent.writeCaptureRead(body: reqBody, into: &buf)
+                        let out = buf
+                        loopBound.eventLoop.execute { self.writeBody(out, contentType: BinaryPayload.contentType, context: loopBound.value) }
+                    } catch {
+                        let response = SDLKitJSONAgent.errorResponse(error)
+                        loopBound.eventLoop.execute { self.writeResponse(response, context: loopBound.value) }
+                    }
+                }
+                return
+            }
+            Self.dispatch(path: path, body: reqBody, accept: accept) { response in
+                loopBound.eventLoop.execute { self.writeResponse(response, context: loopBound.value) }
+            }
+        }
+    }
+
+    /// Runs a request where its affinity allows (see `SDLKitJSONAgent.affinity(path:body:)`)
+    /// and hands the response to `completion` on the queue it ran on. Pure requests run on
+    /// the event loop, audio session requests on their session's serial queue, and only SDL
+    /// window and render work hops to the main thread — asynchronously, so a busy renderer
+    /// never stalls the event loop. `accept` selects binary bodies for the bulk endpoints.
+    private static func dispatch(path: String, body: Data, accept: String?, completion: @escaping @Sendable (SDLKitJSONAgent.Response) -> Void) {
+        if path == SDLKitJSONAgent.Endpoint.drawBatch.rawValue {
+            // Decode and coalesce on the event loop; the main thread only executes.
+            let batch: DrawBatch
+            do {
+                batch = try DrawBatch.decode(body)
+            } catch {
+                completion(SDLKitJSONAgent.errorResponse(error))
+                return
+            }
+            DispatchQueue.main.async {
+                completion(MainActor.assumeIsolated { ServerAgent.shared.executeBatch(batch) })
+            }
+            return
+        }
+        switch SDLKitJSONAgent.affinity(path: path, body: body) {
+        case .pure:
+            completion(SDLKitJSONAgent.respondOffMain(path: path, body: body, accept: accept))
+        case .audioSession(let audioId):
+            AudioSessionLanes.shared.queue(for: audioId).async {
+                completion(SDLKitJSONAgent.respondOffMain(path: path, body: body, accept: accept))
+            }
+        case .main:
+            DispatchQueue.main.async {
+                completion(MainActor.assumeIsolated { ServerAgent.shared.respond(path: path, body: body, accept: accept) })
+            }
+        }
+    }
+
+    private func writeResponse(_ response: SDLKitJSONAgent.Response, context: ChannelHandlerContext) {
+        var buf = context.channel.allocator.buffer(capacity: response.body.count)
+        buf.writeBytes(response.body)
+        writeBody(buf, contentType: response.contentType, context: context)
+    }
+
+    private func writeBody(_ buf: ByteBuffer, contentType: String, context: ChannelHandlerContext) {
+        var headers = HTTPHeaders()
+        headers.add(name: "content-type", value: contentType)
+        headers.add(name: "content-length", value: String(buf.readableBytes))
+        context.write(self.wrapOutboundOut(.head(.init(version: .http1_1, status: .ok, headers: headers))), promise: nil)
+        context.write(self.wrapOutboundOut(.body(.byteBuffer(buf))), promise: nil)
+        context.writeAndFlush(self.wrapOutboundOut(.end(nil)), promise: nil)
+    }
+
+    func channelInactive(context: ChannelHandlerContext) {
+        stopFrameStream()
+        context.fireChannelInactive()
+    }
+
+    // MARK: - Frame streams
+
+    /// Answers with a chunked `application/x-sdlkit-frames` body that stays open: one
+    /// message per changed frame (see `FrameDeltaEncoder`). A capture is skipped, and
+    /// counted as dropped, while the previous message is still being written or the socket
+    /// is above its write watermark, so a slow client never builds up a queue.
+    private func startFrameStream(context: ChannelHandlerContext, body: Data) {
+        let opened: (session: FrameStreamSession?, error: SDLKitJSONAgent.Response?) = onMain {
+            do {
+                return (try ServerAgent.shared.openFrameStream(body: body), nil)
+            } catch {
+                return (nil, SDLKitJSONAgent.errorResponse(error))
+            }
+        }
+        guard let session = opened.session else {
+            let error = opened.error?.body ?? Data()
             var headers = HTTPHeaders()
             headers.add(name: "content-type", value: "application/json")
-            headers.add(name: "content-length", value: String(responseData.count))
+            headers.add(name: "content-length", value: String(error.count))
             context.write(self.wrapOutboundOut(.head(.init(version: .http1_1, status: .ok, headers: headers))), promise: nil)
-            var buf = context.channel.allocator.buffer(capacity: responseData.count)
-            buf.writeBytes(responseData)
-            context.write(self.wrapOutboundOut(.body(.byteBuffer(buf))), promise: nil)
+            context.write(self.wrapOutboundOut(.body(.byteBuffer(context.channel.allocator.buffer(bytes: error)))), promise: nil)
             context.writeAndFlush(self.wrapOutboundOut(.end(nil)), promise: nil)
+            return
+        }
+        var headers = HTTPHeaders()
+        headers.add(name: "content-type", value: "application/x-sdlkit-frames")
+        headers.add(name: "cache-control", value: "no-store")
+        context.writeAndFlush(self.wrapOutboundOut(.head(.init(version: .http1_1, status: .ok, headers: headers))), promise: nil)
+
+        stream = session
+        frameInFlight = false
+        droppedFrames = 0
+        let interval = onMain { session.interval }
+        let loopBound = NIOLoopBound(context, eventLoop: context.eventLoop)
+        streamTask = context.eventLoop.scheduleRepeatedTask(initialDelay: .zero,
+                                                            delay: .nanoseconds(Int64(interval * 1_000_000_000))) { _ in
+            self.streamTick(context: loopBound.value)
+        }
+    }
+
+    private func streamTick(context: ChannelHandlerContext) {
+        guard let session = stream else { return }
+        guard !frameInFlight, context.channel.isWritable else {
+            droppedFrames += 1
+            return
+        }
+        frameInFlight = true
+        let dropped = droppedFrames
+        let loopBound = NIOLoopBound(context, eventLoop: context.eventLoop)
+        DispatchQueue.main.async {
+            let result: Result<Data?, Error> = MainActor.assumeIsolated {
+                Result { try session.nextMessage(droppedFrames: dropped) }
+            }
+            loopBound.eventLoop.execute {
+                self.deliverFrame(result, reportedDrops: dropped, context: loopBound.value)
+            }
+        }
+    }
+
+    private func deliverFrame(_ result: Result<Data?, Error>, reportedDrops: Int, context: ChannelHandlerContext) {
+        guard stream != nil else { return }
+        switch result {
+        case .success(nil):
+            frameInFlight = false
+        case .success(let message?):
+            droppedFrames -= reportedDrops
+            let buffer = context.channel.allocator.buffer(bytes: message)
+            context.writeAndFlush(self.wrapOutboundOut(.body(.byteBuffer(buffer)))).whenComplete { _ in
+                self.frameInFlight = false
+            }
+        case .failure:
+            // The window went away (or capture failed): finish the response and hang up.
+            stopFrameStream()
+            let channel = context.channel
+            context.writeAndFlush(self.wrapOutboundOut(.end(nil))).whenComplete { _ in
+                channel.close(promise: nil)
+            }
         }
     }
+
+    private func stopFrameStream() {
+        streamTask?.cancel()
+        streamTask = nil
+        stream = nil
+    }
+
+    /// `?window_id=1&fps=15&tile_size=32&encoding=raw` as a JSON request body.
+    private static func queryBody(_ query: String?) -> Data {
+        var components = URLComponents()
+        components.percentEncodedQuery = query
+        var request = FrameStreamRequest(window_id: 0)
+        for item in components.queryItems ?? [] {
+            guard let value = item.value else { continue }
+            switch item.name {
+            case "window_id": request.window_id = Int(value) ?? 0
+            case "fps": request.fps = Double(value)
+            case "tile_size": request.tile_size = Int(value)
+            case "encoding": request.encoding = value
+            default: break
+            }
+        }
+        return (try? JSONEncoder().encode(request)) ?? Data()
+    }
 }
 
+/// Lets binary capture reads write samples straight into the response buffer.
+extension ByteBuffer: @retroactive BinaryPayloadSink {
+    public mutating func append(capacity: Int, _ body: (UnsafeMutableRawBufferPointer) throws -> Int) rethrows {
+        _ = try writeWithUnsafeMutableBytes(minimumWritableBytes: capacity) { dst in
+            try body(UnsafeMutableRawBufferPointer(rebasing: dst.prefix(capacity)))
+        }
+    }
+}
+
+SettingsStore.prewarm()
 let group = MultiThreadedEventLoopGroup(numberOfThreads: System.coreCount)
-defer { try? group.syncShutdownGracefully() }
 let port = Int(ProcessInfo.processInfo.environment["SDLKIT_NIO_PORT"] ?? "8723") ?? 8723
 
 let bootstrap = ServerBootstrap(group: group)
@@ -70,4 +272,10 @@ let bootstrap = ServerBootstrap(group: group)
 
 let channel = try bootstrap.bind(host: "127.0.0.1", port: port).wait()
 print("SDLKitNIO listening on http://127.0.0.1:\(port)")
-try channel.closeFuture.wait()
+// The main thread serves main-actor requests, so it runs the main dispatch queue instead of
+// blocking on the channel.
+channel.closeFuture.whenComplete { _ in
+    group.shutdownGracefully { _ in exit(0) }
+}
+dispatchMain()
+
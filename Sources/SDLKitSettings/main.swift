@@ -23,11 +23,13 @@ struct SDLKitSettingsCLI {
         case "set":
             guard let k = key, let v = value else { return printUsage() }
             SettingsStore.setString(k, v)
+            SettingsStore.flush()
             print("OK")
         case "set-bool":
             guard let k = key, let v = value else { return printUsage() }
             let b = ["1","true","yes","on"].contains(v.lowercased())
             SettingsStore.setBool(k, b)
+            SettingsStore.flush()
             print("OK")
         case "list":
             // List known keys and current values
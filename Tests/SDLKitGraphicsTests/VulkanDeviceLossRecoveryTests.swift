@@ -55,6 +55,17 @@ final class VulkanDeviceLossRecoveryTests: XCTestCase {
             let textureHandle = try backend.createTexture(descriptor: textureDescriptor,
                                                            initialData: TextureInitialData(mipLevelData: [textureData]))
             let sampler = try backend.createSampler(descriptor: SamplerDescriptor(label: "Linear"))
+            var regenerations = 0
+            let regeneratedBuffer = try backend.createBuffer(bytes: vertexData.withUnsafeBytes { $0.baseAddress },
+                                                             length: vertexData.count,
+                                                             usage: .vertex,
+                                                             recovery: .regenerate {
+                                                                 regenerations += 1
+                                                                 return [vertexData]
+                                                             })
+            let discardedTexture = try backend.createTexture(descriptor: textureDescriptor,
+                                                             initialData: TextureInitialData(mipLevelData: [textureData]),
+                                                             recovery: .discard)
 
             let pipelineDescriptor = GraphicsPipelineDescriptor(label: "VulkanDeviceLoss",
                                                                 shader: module.id,
@@ -65,6 +76,11 @@ final class VulkanDeviceLossRecoveryTests: XCTestCase {
 
 #if DEBUG
             let baselineInventory = backend.debugResourceInventory()
+            // The backend's own fallback texture may be shadow-copied as well.
+            XCTAssertGreaterThanOrEqual(baselineInventory.recovery.shadowCopyCount, 2)
+            XCTAssertGreaterThanOrEqual(baselineInventory.recovery.shadowCopyBytes, vertexData.count + textureData.count)
+            XCTAssertEqual(baselineInventory.recovery.regenerateCount, 1)
+            XCTAssertEqual(baselineInventory.recovery.discardCount, 1)
 #endif
 
             try backend.beginFrame()
@@ -80,6 +96,11 @@ final class VulkanDeviceLossRecoveryTests: XCTestCase {
 
             XCTAssertTrue(events.contains { if case .willReset = $0 { return true } else { return false } })
             XCTAssertTrue(events.contains { if case .didReset = $0 { return true } else { return false } })
+            XCTAssertEqual(regenerations, 1)
+            XCTAssertTrue(events.contains {
+                if case .resourcesDiscarded(let handles) = $0 { return handles == [.texture(discardedTexture)] } else { return false }
+            })
+            XCTAssertEqual(backend.debugBufferLength(for: regeneratedBuffer), vertexData.count)
 #if DEBUG
             XCTAssertFalse(events.contains { if case .resetFailed = $0 { return true } else { return false } })
             let recoveredInventory = backend.debugResourceInventory()
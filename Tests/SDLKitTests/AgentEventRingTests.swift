@@ -0,0 +1,58 @@
+import XCTest
+@testable import SDLKit
+
+@MainActor
+final class AgentEventRingTests: XCTestCase {
+    func testConsecutiveMovesCoalesceAndCursorsResume() {
+        var ring = AgentEventRing(capacity: 8)
+        ring.append(.init(type: .mouseMove, x: 1, y: 1))
+        ring.append(.init(type: .mouseMove, x: 2, y: 2))
+        ring.append(.init(type: .mouseDown, x: 2, y: 2, button: 1))
+        ring.append(.init(type: .mouseMove, x: 3, y: 3))
+        ring.append(.init(type: .mouseMove, x: 4, y: 4))
+        ring.append(.init(type: .mouseMove, x: 5, y: 5))
+        XCTAssertEqual(ring.count, 3)
+        XCTAssertEqual(ring.coalescedMoves, 3)
+
+        let first = ring.events(since: 0, limit: 2)
+        XCTAssertEqual(first.events, [.init(type: .mouseMove, x: 2, y: 2), .init(type: .mouseDown, x: 2, y: 2, button: 1)])
+        let rest = ring.events(since: first.cursor)
+        XCTAssertEqual(rest.events, [.init(type: .mouseMove, x: 5, y: 5)])
+        XCTAssertEqual(rest.cursor, ring.lastCursor)
+        XCTAssertFalse(rest.gap)
+
+        // A reader that already saw the previous position still gets the coalesced update.
+        ring.append(.init(type: .mouseMove, x: 6, y: 6))
+        XCTAssertEqual(ring.events(since: rest.cursor).events, [.init(type: .mouseMove, x: 6, y: 6)])
+        XCTAssertTrue(ring.events(since: ring.lastCursor).events.isEmpty)
+    }
+
+    func testEvictionIsReportedAsAGap() {
+        var ring = AgentEventRing(capacity: 2)
+        for key in 1...3 { ring.append(.init(type: .keyDown, key: String(key))) }
+        let batch = ring.events(since: 0)
+        XCTAssertEqual(batch.events.map(\.key), ["2", "3"])
+        XCTAssertTrue(batch.gap)
+        XCTAssertFalse(ring.events(since: 1).gap)
+    }
+
+    func testAgentBatchesAndCaptureShareTheRing() throws {
+        let agent = SDLKitGUIAgent()
+        agent._testingPopulateWindows(count: 2)
+        agent.deliver(.init(type: .mouseMove, x: 1, y: 1), toSDLWindow: 0)
+        agent.deliver(.init(type: .mouseMove, x: 9, y: 9), toSDLWindow: 0)
+        agent.deliver(.init(type: .keyUp, key: "32"), toSDLWindow: 0)
+        agent.deliver(.init(type: .quit), toSDLWindow: 4242)
+
+        let batch = try agent.events(windowId: 2)
+        XCTAssertEqual(batch.events, [.init(type: .mouseMove, x: 9, y: 9), .init(type: .keyUp, key: "32")])
+        XCTAssertTrue(try agent.events(windowId: 2, since: batch.cursor).events.isEmpty)
+        XCTAssertThrowsError(try agent.events(windowId: 3))
+        XCTAssertThrowsError(try agent.events(windowId: 1, limit: 0))
+
+        XCTAssertEqual(try agent.captureEvent(windowId: 1), .init(type: .mouseMove, x: 9, y: 9))
+        XCTAssertEqual(try agent.captureEvent(windowId: 1), .init(type: .keyUp, key: "32"))
+        XCTAssertNil(try agent.captureEvent(windowId: 1))
+        XCTAssertEqual(try agent.events(windowId: 1).events.count, 2, "batch readers keep their own cursor")
+    }
+}
@@ -0,0 +1,107 @@
+import XCTest
+@testable import SDLKit
+
+final class AsyncReadbackTests: XCTestCase {
+    func testStagingPoolReusesSizeClassesWithinBudget() {
+        var made: [Int] = []
+        var pool = ReadbackStagingPool<Int>(byteBudget: 8192)
+        let first = pool.acquire(length: 100) { made.append($0); return made.count }
+        XCTAssertEqual(first.capacity, 4096)
+        let second = pool.acquire(length: 5000) { made.append($0); return made.count }
+        XCTAssertEqual(second.capacity, 8192)
+
+        XCTAssertNil(pool.recycle(first))
+        // Caching the 8 KB allocation too would exceed the budget; it comes back for release.
+        XCTAssertEqual(pool.recycle(second), 2)
+        XCTAssertEqual(pool.cachedBytes, 4096)
+
+        let reused = pool.acquire(length: 4096) { made.append($0); return made.count }
+        XCTAssertEqual(reused.allocation, 1)
+        XCTAssertEqual(made, [4096, 8192])
+        XCTAssertNil(pool.recycle(reused))
+        XCTAssertEqual(pool.drain(), [1])
+        XCTAssertEqual(pool.cachedBytes, 0)
+    }
+
+    func testReadbackRangeValidation() throws {
+        XCTAssertEqual(try Range<Int>.readbackRange(nil, length: 16), 0..<16)
+        XCTAssertEqual(try Range<Int>.readbackRange(4..<8, length: 16), 4..<8)
+        XCTAssertThrowsError(try Range<Int>.readbackRange(8..<20, length: 16))
+    }
+
+    func testTokenResolvesOnceThroughPollWaitAndCallbacks() async throws {
+        try await MainActor.run {
+            var landed = false
+            var resolveCount = 0
+            let token = ReadbackToken<Int>(poll: { landed }, resolve: { resolveCount += 1; return 42 })
+            var results: [Int] = []
+            token.onComplete { results.append((try? $0.get()) ?? -1) }
+
+            var pending = PendingReadbacks()
+            pending.track(token)
+            pending.pump()
+            XCTAssertFalse(token.isReady)
+            XCTAssertEqual(pending.count, 1)
+
+            landed = true
+            pending.pump()
+            XCTAssertEqual(pending.count, 0)
+            XCTAssertTrue(token.isReady)
+            XCTAssertEqual(try token.wait(), 42)
+            token.onComplete { results.append((try? $0.get()) ?? -1) }
+            XCTAssertEqual(results, [42, 42])
+            XCTAssertEqual(resolveCount, 1)
+        }
+    }
+
+    func testTokenValueAwaitsCompletion() async throws {
+        let token = await MainActor.run { () -> ReadbackToken<String> in
+            var polls = 0
+            return ReadbackToken<String>(poll: { polls += 1; return polls > 2 }, resolve: { "done" })
+        }
+        let value = try await token.value()
+        XCTAssertEqual(value, "done")
+    }
+
+    func testStubReadbacksAndFrameCapture() async throws {
+        try await MainActor.run {
+            let window = SDLWindow(config: .init(title: "AsyncReadback", width: 16, height: 8))
+            do {
+                try window.open()
+            } catch AgentError.sdlUnavailable {
+                throw XCTSkip("SDL unavailable; skipping")
+            }
+            defer { window.close() }
+
+            let backend = try RenderBackendFactory.makeBackend(window: window, override: "vulkan")
+            guard backend is StubRenderBackend else {
+                throw XCTSkip("Native backend active; stub readback test not applicable")
+            }
+            let bytes = [UInt8](0..<64)
+            let buffer = try bytes.withUnsafeBytes { try backend.createBuffer(bytes: $0.baseAddress, length: $0.count, usage: .storage) }
+            XCTAssertEqual(try backend.enqueueReadback(buffer: buffer, range: 8..<12).wait(), Data([8, 9, 10, 11]))
+            XCTAssertEqual(try backend.enqueueReadback(buffer: buffer).wait(), Data(bytes))
+
+            let texels = Data((0..<(4 * 2 * 4)).map { UInt8($0) })
+            let texture = try backend.createTexture(descriptor: TextureDescriptor(width: 4, height: 2, format: .rgba8Unorm, usage: .shaderRead),
+                                                    initialData: TextureInitialData(mipLevelData: [texels]))
+            let image = try backend.enqueueReadback(texture: texture).wait()
+            XCTAssertEqual(image.width, 4)
+            XCTAssertEqual(image.bytesPerRow, 16)
+            XCTAssertEqual(image.layout, .rgba8Unorm)
+            XCTAssertEqual(image.data, texels)
+
+            XCTAssertThrowsError(try backend.enqueueFrameCapture())
+            try backend.beginFrame()
+            let capture = try backend.enqueueFrameCapture()
+            var delivered: GoldenImageCapture?
+            capture.onComplete { delivered = try? $0.get() }
+            XCTAssertFalse(capture.isReady)
+            try backend.endFrame()
+            XCTAssertNotNil(delivered, "frame captures resolve at endFrame without being polled")
+            let frame = try capture.wait()
+            XCTAssertEqual(frame.layout, .bgra8Unorm)
+            XCTAssertEqual(frame.data.count, frame.bytesPerRow * frame.height)
+        }
+    }
+}
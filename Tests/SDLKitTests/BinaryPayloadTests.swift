@@ -0,0 +1,60 @@
+import XCTest
+@testable import SDLKit
+
+final class BinaryPayloadTests: XCTestCase {
+    func testRoundTripPadsMetadataToAlignSamples() throws {
+        struct Meta: Codable, Equatable { let frames: Int; let channels: Int; let format: String }
+        let samples: [Float] = [0, 0.5, -1, 0.25]
+        let payload = try BinaryPayload(metadata: Meta(frames: 2, channels: 2, format: "f32"),
+                                        payload: samples.withUnsafeBufferPointer { Data(buffer: $0) })
+        let encoded = payload.encoded()
+        XCTAssertTrue(BinaryPayload.isBinary(encoded))
+        XCTAssertEqual((encoded.count - samples.count * 4) % 4, 0, "the payload starts 4-byte aligned")
+
+        let decoded = try BinaryPayload.decode(encoded)
+        XCTAssertEqual(try decoded.decodeMetadata(Meta.self), Meta(frames: 2, channels: 2, format: "f32"))
+        XCTAssertEqual(decoded.withFloats { Array($0) }, samples)
+        XCTAssertEqual(decoded.payload.count, 16)
+
+        XCTAssertThrowsError(try BinaryPayload.decode(encoded.prefix(6)))
+        var overlong = Data(BinaryPayload.magic)
+        overlong.append(contentsOf: [0xFF, 0xFF, 0, 0])
+        XCTAssertThrowsError(try BinaryPayload.decode(overlong))
+        XCTAssertThrowsError(try BinaryPayload.decode(Data(#"{"audio_id": 1}"#.utf8)))
+    }
+
+    func testAcceptNegotiationAndSessionRouting() throws {
+        XCTAssertTrue(BinaryPayload.accepts("application/octet-stream"))
+        XCTAssertTrue(BinaryPayload.accepts("application/json;q=0.5, Application/Octet-Stream; q=1"))
+        XCTAssertFalse(BinaryPayload.accepts("application/json"))
+        XCTAssertFalse(BinaryPayload.accepts(nil))
+
+        struct Meta: Codable { let audio_id: Int; let format: String; let channels: Int }
+        let enqueue = try BinaryPayload(metadata: Meta(audio_id: 7, format: "f32", channels: 1), payload: Data(count: 8)).encoded()
+        XCTAssertEqual(SDLKitJSONAgent.affinity(path: "/agent/audio/playback/queue/enqueue", body: enqueue), .audioSession(7))
+
+        let missing = SDLKitJSONAgent.respondOffMain(path: "/agent/audio/capture/read", body: Data(#"{"audio_id": 999, "frames": 8}"#.utf8),
+                                                     accept: BinaryPayload.contentType)
+        XCTAssertEqual(missing.contentType, "application/json", "errors stay JSON")
+    }
+
+    func testShorterMetadataFillsAReservedPrefix() throws {
+        struct Meta: Codable, Equatable { let frames: Int }
+        let reserved = BinaryPayload.prefix(metadata: try JSONEncoder().encode(Meta(frames: 4096))).count
+        var encoded = BinaryPayload.prefix(metadata: try JSONEncoder().encode(Meta(frames: 7)), length: reserved)
+        XCTAssertEqual(encoded.count, reserved)
+        encoded.append(Data(count: 8))
+        let decoded = try BinaryPayload.decode(encoded)
+        XCTAssertEqual(try decoded.decodeMetadata(Meta.self), Meta(frames: 7))
+        XCTAssertEqual(decoded.payload.count, 8)
+    }
+
+    func testDataSinkKeepsOnlyWrittenBytes() {
+        var sink = Data([1, 2])
+        sink.append(capacity: 8) { dst in
+            dst[0] = 3; dst[1] = 4
+            return 2
+        }
+        XCTAssertEqual(sink, Data([1, 2, 3, 4]))
+    }
+}
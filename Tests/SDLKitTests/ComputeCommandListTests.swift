@@ -0,0 +1,98 @@
+import XCTest
+@testable import SDLKit
+
+final class ComputeCommandListTests: XCTestCase {
+    private typealias Planner = ComputeHazardPlanner
+
+    private let a = Planner.Resource.buffer(BufferHandle())
+    private let b = Planner.Resource.buffer(BufferHandle())
+    private let c = Planner.Resource.buffer(BufferHandle())
+
+    private func read(_ resource: Planner.Resource) -> Planner.Access { .init(resource: resource, writes: false) }
+    private func write(_ resource: Planner.Resource) -> Planner.Access { .init(resource: resource, writes: true) }
+
+    func testPlannerBarriersOnlyOnHazards() {
+        var planner = Planner()
+        // a -> b, then b -> c: the second dispatch reads what the first wrote.
+        XCTAssertEqual(planner.barriers(before: [read(a), write(b)]), [])
+        XCTAssertEqual(planner.barriers(before: [read(b), write(c)]), [.init(resource: b, hazard: .readAfterWrite)])
+        // Another reader of a and b needs nothing new: b's write is already ordered.
+        XCTAssertEqual(planner.barriers(before: [read(a), read(b)]), [])
+        // Overwriting a after it was read, and c after it was written.
+        XCTAssertEqual(planner.barriers(before: [write(a), write(c)]),
+                       [.init(resource: a, hazard: .writeAfterRead), .init(resource: c, hazard: .writeAfterWrite)])
+        XCTAssertEqual(planner.barrierCount, 3)
+        XCTAssertEqual(planner.writtenResources, [b, c, a])
+    }
+
+    func testPlannerMergesAliasedSlots() {
+        var planner = Planner()
+        // The same buffer read at one slot and written at another counts once, as a write.
+        XCTAssertEqual(planner.barriers(before: [read(a), write(a)]), [])
+        XCTAssertEqual(planner.barriers(before: [read(a)]), [.init(resource: a, hazard: .readAfterWrite)])
+    }
+
+    func testAccessesFollowSlotDeclarations() throws {
+        let input = BufferHandle(), output = BufferHandle()
+        var bindings = BindingSet()
+        bindings.setBuffer(input, at: 0)
+        bindings.setBuffer(output, at: 1)
+        let slots = [BindingSlot(index: 0, kind: .storageBuffer, access: .read), BindingSlot(index: 1, kind: .storageBuffer)]
+        XCTAssertEqual(Planner.accesses(of: bindings, slots: slots),
+                       [.init(resource: .buffer(input), writes: false), .init(resource: .buffer(output), writes: true)])
+        // Without slot metadata everything bound is assumed written.
+        XCTAssertEqual(Planner.accesses(of: bindings, slots: nil).map(\.writes), [true, true])
+    }
+
+    func testStubSubmitsChainedDispatchesWithOneFence() async throws {
+        try await MainActor.run {
+            let window = SDLWindow(config: .init(title: "ComputeCommandList", width: 32, height: 32))
+            do {
+                try window.open()
+            } catch AgentError.sdlUnavailable {
+                throw XCTSkip("SDL unavailable; skipping")
+            }
+            defer { window.close() }
+
+            let backend = try RenderBackendFactory.makeBackend(window: window, override: "vulkan")
+            guard backend is StubRenderBackend else {
+                throw XCTSkip("Native backend active; stub compute test not applicable")
+            }
+            let pipeline = try backend.makeComputePipeline(ComputePipelineDescriptor(label: "vector_add", shader: ShaderID("vector_add")))
+            let count = 256
+            let x = (0..<count).map { Float($0) }
+            let buffers = try [x, x, [Float](repeating: 0, count: count), [Float](repeating: 0, count: count)].map { values in
+                try values.withUnsafeBytes { try backend.createBuffer(bytes: $0.baseAddress, length: $0.count, usage: .storage) }
+            }
+            var constants = Data(count: MemoryLayout<UInt32>.size * 4)
+            constants.withUnsafeMutableBytes { $0.storeBytes(of: UInt32(count), as: UInt32.self) }
+            func bindings(_ lhs: Int, _ rhs: Int, _ out: Int) -> BindingSet {
+                var set = BindingSet()
+                set.setBuffer(buffers[lhs], at: 0)
+                set.setBuffer(buffers[rhs], at: 1)
+                set.setBuffer(buffers[out], at: 2)
+                set.materialConstants = BindingSet.MaterialConstants(data: constants)
+                return set
+            }
+
+            // sum = x + x; result = sum + x. The second dispatch depends on the first.
+            var list = ComputeCommandList(label: "chain")
+            list.dispatch(pipeline, groupsX: count / 64, bindings: bindings(0, 1, 2))
+            list.dispatch(pipeline, groupsX: count / 64, bindings: bindings(2, 0, 3))
+            let fence = try backend.submitCompute(list)
+            try fence.wait()
+            XCTAssertTrue(fence.isComplete)
+            XCTAssertEqual(fence.dispatchCount, 2)
+            XCTAssertEqual(fence.barrierCount, 1)
+
+            var out = [Float](repeating: 0, count: count)
+            try out.withUnsafeMutableBytes { try backend.readback(buffer: buffers[3], into: $0.baseAddress!, length: $0.count) }
+            XCTAssertEqual(out, x.map { $0 * 3 })
+
+            var unknown = ComputeCommandList()
+            unknown.dispatch(ComputePipelineHandle(), groupsX: 1, bindings: bindings(0, 1, 2))
+            XCTAssertThrowsError(try backend.submitCompute(unknown))
+            XCTAssertTrue(try backend.submitCompute(ComputeCommandList()).isComplete)
+        }
+    }
+}
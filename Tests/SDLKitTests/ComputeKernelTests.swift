@@ -0,0 +1,168 @@
+import XCTest
+@testable import SDLKit
+
+final class ComputeKernelTests: XCTestCase {
+    /// Runs the registered kernel for `shader` over float buffers bound at slots 0..<n and
+    /// returns their contents afterwards.
+    private func run(_ shader: String,
+                     groups: (Int, Int, Int),
+                     constants: [UInt32] = [],
+                     buffers: [[Float]]) throws -> [[Float]] {
+        let kernel = try XCTUnwrap(ComputeKernelRegistry.kernel(for: ShaderID(shader)))
+        var storage = buffers
+        var pointers: [Int: ComputeKernelBuffer] = [:]
+        let staging = storage.map { UnsafeMutableBufferPointer<Float>.allocate(capacity: max(1, $0.count)) }
+        defer { staging.forEach { $0.deallocate() } }
+        for (slot, values) in storage.enumerated() {
+            _ = staging[slot].initialize(from: values)
+            pointers[slot] = ComputeKernelBuffer(UnsafeMutableRawBufferPointer(start: staging[slot].baseAddress, count: values.count * 4))
+        }
+        kernel.execute(ComputeKernelContext(groups: groups, constants: constants, buffers: pointers, textures: [:]))
+        for slot in storage.indices {
+            storage[slot] = Array(staging[slot].prefix(storage[slot].count))
+        }
+        return storage
+    }
+
+    func testVectorAddHonorsElementCount() throws {
+        let count = 1000
+        let a = (0..<count).map { Float($0) * 0.5 }
+        let b = (0..<count).map { Float($0) * 1.5 + 1 }
+        let out = try run("vector_add", groups: (16, 1, 1), constants: [UInt32(count - 10), 0, 0, 0],
+                          buffers: [a, b, [Float](repeating: -1, count: count)])
+        for i in 0..<(count - 10) {
+            XCTAssertEqual(out[2][i], a[i] + b[i], "index \(i)")
+        }
+        XCTAssertEqual(out[2][count - 1], -1, "invocations past elementCount must not write")
+    }
+
+    func testDFTPowerMatchesDirectTransform() throws {
+        let frameSize = 64, nBins = frameSize / 2 + 1, frames = 3
+        var samples: [Float] = []
+        for frame in 0..<frames {
+            for n in 0..<frameSize {
+                samples.append(sin(2 * .pi * Float((frame + 1) * 4 * n) / Float(frameSize)) + 0.25)
+            }
+        }
+        let total = frames * nBins
+        let out = try run("audio_dft_power", groups: ((total + 63) / 64, 1, 1),
+                          constants: [UInt32(frameSize), UInt32(nBins), UInt32(frames), 0],
+                          buffers: [samples, [Float](repeating: 0, count: total)])
+        for frame in 0..<frames {
+            for bin in 0..<nBins {
+                var re = 0.0, im = 0.0
+                for n in 0..<frameSize {
+                    let angle = 2 * Double.pi * Double(bin * n) / Double(frameSize)
+                    re += Double(samples[frame * frameSize + n]) * cos(angle)
+                    im -= Double(samples[frame * frameSize + n]) * sin(angle)
+                }
+                let expected = re * re + im * im
+                XCTAssertEqual(Double(out[1][frame * nBins + bin]), expected, accuracy: max(1e-3, expected * 1e-3), "frame \(frame) bin \(bin)")
+            }
+        }
+        // A pure tone at bin 4(f+1) dominates its frame.
+        XCTAssertGreaterThan(out[1][4], 1000)
+        XCTAssertGreaterThan(out[1][nBins + 8], 1000)
+    }
+
+    func testMelProjectionAndOnsetFlux() throws {
+        let nBins = 5, melBands = 2, frames = 2
+        let power: [Float] = [1, 2, 3, 4, 5,  5, 4, 3, 2, 1]
+        let weights: [Float] = [1, 1, 0, 0, 0,  0, 0, 0, 1, 1]
+        let mel = try run("audio_mel_project", groups: (1, 1, 1),
+                          constants: [UInt32(nBins), UInt32(melBands), UInt32(frames), 0],
+                          buffers: [power, weights, [0, 0, 0, 0]])
+        XCTAssertEqual(mel[2], [3, 9, 9, 3])
+
+        let onset = try run("audio_onset_flux", groups: (frames, 1, 1),
+                            constants: [UInt32(melBands), UInt32(frames), 1, 0],
+                            buffers: [mel[2], [1, 10], [0, 0]])
+        // Frame 0 against prev: max(3-1,0) + max(9-10,0); frame 1: max(9-3,0) + max(3-9,0).
+        XCTAssertEqual(onset[2], [2, 6])
+
+        let noPrev = try run("audio_onset_flux", groups: (frames, 1, 1),
+                             constants: [UInt32(melBands), UInt32(frames), 0, 0],
+                             buffers: [mel[2], [0, 0], [-1, -1]])
+        XCTAssertEqual(noPrev[2], [0, 6])
+    }
+
+    func testScenegraphWaveAdvancesPhaseAndWritesVertices() throws {
+        let states: [Float] = [1, 0, 0.5, 0,  0, 2, 0, .pi / 2]
+        let configs: [Float] = [1, 0.5, 0, .pi / 2,  1, 1, 1, .pi / 2]
+        let out = try run("scenegraph_wave", groups: (2, 1, 1),
+                          buffers: [states, configs, [Float](repeating: 0, count: 12)])
+        XCTAssertEqual(out[0][3], .pi / 2, accuracy: 1e-6)
+        XCTAssertEqual(out[0][7], .pi, accuracy: 1e-6)
+        let v = out[2]
+        // Vertex 0: (1, 0) rotated by 90 degrees, color scaled by 0.6 + 0.4 * sin(pi/2).
+        XCTAssertEqual(v[0], 0, accuracy: 1e-6)
+        XCTAssertEqual(v[1], 1, accuracy: 1e-6)
+        XCTAssertEqual(v[2], 0.5)
+        XCTAssertEqual(v[3], 1, accuracy: 1e-6)
+        XCTAssertEqual(v[4], 0.5, accuracy: 1e-6)
+        XCTAssertEqual(v[5], 0)
+        // Vertex 1: (0, 2) rotated by 180 degrees, color scaled by 0.6.
+        XCTAssertEqual(v[6], 0, accuracy: 1e-5)
+        XCTAssertEqual(v[7], -2, accuracy: 1e-5)
+        XCTAssertEqual(v[9], 0.6, accuracy: 1e-5)
+    }
+
+    func testBRDFIntegrationMatchesKnownValues() {
+        // Smooth surface viewed head-on reflects everything through the scale term.
+        let (smoothA, smoothB) = ComputeKernelRegistry.integrateBRDF(noV: 1, roughness: 0.05, sampleCount: 256)
+        XCTAssertEqual(smoothA, 1, accuracy: 0.05)
+        XCTAssertEqual(smoothB, 0, accuracy: 0.05)
+        // Grazing, rough: the Fresnel bias grows and the total falls.
+        let (roughA, roughB) = ComputeKernelRegistry.integrateBRDF(noV: 0.1, roughness: 0.9, sampleCount: 256)
+        XCTAssertLessThan(roughA + roughB, smoothA + smoothB)
+        XCTAssertGreaterThan(roughB, smoothB)
+    }
+
+    func testStubDispatchRunsKernelAcrossWorkgroups() async throws {
+        try await MainActor.run {
+            let window = SDLWindow(config: .init(title: "ComputeKernels", width: 32, height: 32))
+            do {
+                try window.open()
+            } catch AgentError.sdlUnavailable {
+                throw XCTSkip("SDL unavailable; skipping")
+            }
+            defer { window.close() }
+
+            let backend = try RenderBackendFactory.makeBackend(window: window, override: "vulkan")
+            guard backend is StubRenderBackend else {
+                throw XCTSkip("Native backend active; stub compute test not applicable")
+            }
+            let pipeline = try backend.makeComputePipeline(ComputePipelineDescriptor(label: "vector_add", shader: ShaderID("vector_add")))
+            let count = 64 * 64
+            let a = (0..<count).map { Float($0) }
+            let buffers = try [a, a, [Float](repeating: 0, count: count)].map { values in
+                try values.withUnsafeBytes { try backend.createBuffer(bytes: $0.baseAddress, length: $0.count, usage: .storage) }
+            }
+            var bindings = BindingSet()
+            for (index, buffer) in buffers.enumerated() { bindings.setBuffer(buffer, at: index) }
+            var constants = Data(count: MemoryLayout<UInt32>.size * 4)
+            constants.withUnsafeMutableBytes { $0.storeBytes(of: UInt32(count), as: UInt32.self) }
+            bindings.materialConstants = BindingSet.MaterialConstants(data: constants)
+            try backend.dispatchCompute(pipeline, groupsX: 64, groupsY: 1, groupsZ: 1, bindings: bindings)
+
+            var out = [Float](repeating: 0, count: count)
+            try out.withUnsafeMutableBytes { try backend.readback(buffer: buffers[2], into: $0.baseAddress!, length: $0.count) }
+            XCTAssertEqual(out, a.map { $0 * 2 })
+
+            var missing = BindingSet()
+            missing.setBuffer(buffers[0], at: 0)
+            XCTAssertThrowsError(try backend.dispatchCompute(pipeline, groupsX: 1, groupsY: 1, groupsZ: 1, bindings: missing))
+        }
+    }
+
+    func testBenchmarkDFTPower() throws {
+        let frameSize = 1024, nBins = frameSize / 2 + 1, frames = 16
+        let samples = (0..<(frameSize * frames)).map { sin(Float($0) * 0.05) }
+        let total = frames * nBins
+        measure {
+            _ = try? run("audio_dft_power", groups: ((total + 63) / 64, 1, 1),
+                         constants: [UInt32(frameSize), UInt32(nBins), UInt32(frames), 0],
+                         buffers: [samples, [Float](repeating: 0, count: total)])
+        }
+    }
+}
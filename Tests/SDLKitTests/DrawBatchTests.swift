@@ -0,0 +1,92 @@
+import XCTest
+@testable import SDLKit
+
+final class DrawBatchTests: XCTestCase {
+    func testCompactJSONCoalescesSameColorRuns() throws {
+        let body = """
+        {"window_id": 3, "commands": [
+            ["clear", "#000000"],
+            ["rect", 0, 0, 10, 10, 4278190335], ["rect", 10, 0, 10, 10, 4278190335],
+            ["circle", 50, 50, 2, 4278190335],
+            ["rect", 0, 20, 5, 5, "#ff0000"],
+            ["line", 0, 0, 10, 0, 4294967295], ["line", 10, 0, 10, 10, 4294967295], ["line", 20, 20, 30, 30, 4294967295],
+            ["point", 1, 1, 4294967295], ["point", 2, 2, 4294967295],
+            ["text", "hi", 4, 4]
+        ]}
+        """
+        let batch = try DrawBatch.decode(Data(body.utf8))
+        XCTAssertEqual(batch.windowId, 3)
+        XCTAssertTrue(batch.present)
+        XCTAssertEqual(batch.commands.count, 11)
+        XCTAssertEqual(batch.ops.count, 6)
+
+        guard case .fillRects(0xFF0000FF, let blue) = batch.ops[1] else { return XCTFail("\(batch.ops[1])") }
+        XCTAssertEqual(blue.count, 2 + 5, "two rects and one span per circle row share a call")
+        XCTAssertEqual(blue.last, DrawBatch.Rect(x: 50, y: 52, width: 1, height: 1))
+        guard case .lines(0xFFFFFFFF, let polylines) = batch.ops[3] else { return XCTFail("\(batch.ops[3])") }
+        XCTAssertEqual(polylines.map { $0.count }, [3, 2], "connected segments chain into one polyline")
+        XCTAssertEqual(batch.ops[4], .points(0xFFFFFFFF, [DrawBatch.Point(x: 1, y: 1), DrawBatch.Point(x: 2, y: 2)]))
+        XCTAssertEqual(batch.ops[5], .text("hi", x: 4, y: 4, color: 0xFFFFFFFF, size: nil, font: nil))
+    }
+
+    func testBinaryRoundTripMatchesCommands() throws {
+        let commands: [DrawBatch.Command] = [
+            .clear(color: 0xFF101010),
+            .fillRect(x: -4, y: 2, width: 8, height: 8, color: 0x80FFFFFF),
+            .strokeRect(x: 1, y: 1, width: 3, height: 3, color: 0xFF00FF00),
+            .line(x1: 0, y1: 0, x2: 5, y2: 5, color: 1),
+            .point(x: 7, y: 8, color: 2),
+            .circle(cx: 9, cy: 9, radius: 3, color: 3),
+            .texture(id: "sprite", x: 1, y: 2, width: nil, height: 16),
+            .text("ünïcode", x: 3, y: 4, color: 0xFFFFFFFF, size: 12, font: nil)
+        ]
+        let batch = try DrawBatch(windowId: 9, commands: commands, present: false)
+        let encoded = batch.encoded()
+        XCTAssertTrue(encoded.starts(with: DrawBatch.magic))
+        let decoded = try DrawBatch.decode(encoded)
+        XCTAssertEqual(decoded.windowId, 9)
+        XCTAssertFalse(decoded.present)
+        XCTAssertEqual(decoded.commands, commands)
+        XCTAssertEqual(decoded.ops, batch.ops)
+    }
+
+    func testMalformedBatchesAreRejected() throws {
+        let valid = try DrawBatch(windowId: 1, commands: [.point(x: 0, y: 0, color: 0)]).encoded()
+        XCTAssertThrowsError(try DrawBatch.decode(valid.dropLast()))
+        var hugeCount = Data(valid.prefix(9))
+        hugeCount.append(contentsOf: [0xFF, 0xFF, 0xFF, 0x7F])
+        XCTAssertThrowsError(try DrawBatch.decode(hugeCount))
+        XCTAssertThrowsError(try DrawBatch.decode(Data(#"{"window_id": 1, "commands": [["spiral", 1]]}"#.utf8)))
+        XCTAssertThrowsError(try DrawBatch.decode(Data(#"{"window_id": 1, "commands": [["rect", 0, 0, 1]]}"#.utf8)))
+        XCTAssertThrowsError(try DrawBatch.decode(Data(#"{"commands": []}"#.utf8)))
+        XCTAssertThrowsError(try DrawBatch.decode(Data(#"{"window_id": 1, "commands": [["circle", 0, 0, 999999999999, 1]]}"#.utf8)))
+        var hugeCircle = try DrawBatch(windowId: 1, commands: [.circle(cx: 0, cy: 0, radius: 1, color: 0)]).encoded()
+        hugeCircle.replaceSubrange(hugeCircle.count - 8..<hugeCircle.count - 4, with: [0xFF, 0xFF, 0xFF, 0x7F])
+        XCTAssertThrowsError(try DrawBatch.decode(hugeCircle))
+    }
+
+    func testBatchesAreBoundedByTotalPrimitives() throws {
+        let big = DrawBatch.Command.circle(cx: 8192, cy: 8192, radius: DrawBatch.maxTargetExtent, color: 0xFFFFFFFF)
+        let rowsPerCircle = DrawBatch.maxTargetExtent
+        let tooMany = DrawBatch.maxPrimitives / rowsPerCircle + 1
+        XCTAssertThrowsError(try DrawBatch(windowId: 1, commands: Array(repeating: big, count: tooMany)))
+        var json = #"{"window_id": 1, "commands": ["#
+        json += Array(repeating: #"["circle", 8192, 8192, 16384, 1]"#, count: tooMany).joined(separator: ",")
+        json += "]}"
+        XCTAssertThrowsError(try DrawBatch.decode(Data(json.utf8)))
+        // Circles entirely off the target cost nothing.
+        let offTarget = DrawBatch.Command.circle(cx: -40000, cy: -40000, radius: 10, color: 0)
+        XCTAssertNoThrow(try DrawBatch(windowId: 1, commands: Array(repeating: offTarget, count: tooMany)))
+    }
+
+    func testCircleSpansAreClippedToTheTarget() throws {
+        XCTAssertEqual(DrawBatch.circleSpans(cx: 0, cy: 0, radius: 2), [
+            DrawBatch.Rect(x: 0, y: 0, width: 3, height: 1),
+            DrawBatch.Rect(x: 0, y: 1, width: 2, height: 1),
+            DrawBatch.Rect(x: 0, y: 2, width: 1, height: 1)
+        ])
+        XCTAssertTrue(DrawBatch.circleSpans(cx: Int.min, cy: Int.max, radius: DrawBatch.maxTargetExtent).isEmpty)
+        let full = DrawBatch.circleSpans(cx: 100, cy: 100, radius: DrawBatch.maxTargetExtent)
+        XCTAssertEqual(full.count, DrawBatch.maxTargetExtent, "one span per target row, none outside")
+    }
+}
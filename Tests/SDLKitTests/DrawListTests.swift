@@ -0,0 +1,97 @@
+import XCTest
+@testable import SDLKit
+
+final class DrawListTests: XCTestCase {
+    func testRadixSortIsStableAndOrdered() {
+        var generator = SystemRandomNumberGenerator()
+        let keys: [UInt64] = (0..<500).map { _ in
+            // Few distinct high fields and a narrow depth range, like a real frame.
+            UInt64.random(in: 0..<4, using: &generator) << 50 | UInt64.random(in: 0..<64, using: &generator)
+        }
+        let order = DrawList.radixSort(keys)
+        let expected = keys.indices.sorted { keys[$0] == keys[$1] ? $0 < $1 : keys[$0] < keys[$1] }
+        XCTAssertEqual(order, expected)
+        XCTAssertEqual(DrawList.radixSort([]), [])
+        XCTAssertEqual(DrawList.radixSort([7]), [0])
+    }
+
+    func testSortKeyFieldOrdering() {
+        let near = DrawSortKey(pass: .opaque, pipeline: 1, material: 2, mesh: 3, depth: 1.0)
+        let far = DrawSortKey(pass: .opaque, pipeline: 1, material: 2, mesh: 3, depth: 50.0)
+        XCTAssertLessThan(near, far)
+        XCTAssertEqual(near.pipeline, 1)
+        XCTAssertEqual(near.material, 2)
+        XCTAssertEqual(near.mesh, 3)
+
+        let otherPipeline = DrawSortKey(pass: .opaque, pipeline: 2, material: 0, mesh: 0, depth: 0)
+        XCTAssertLessThan(far, otherPipeline)
+
+        let blendedNear = DrawSortKey(pass: .transparent, pipeline: 0, material: 0, mesh: 0, depth: 1.0)
+        let blendedFar = DrawSortKey(pass: .transparent, pipeline: 0, material: 0, mesh: 0, depth: 50.0)
+        XCTAssertLessThan(otherPipeline, blendedFar)
+        XCTAssertLessThan(blendedFar, blendedNear)
+
+        // Blended draws composite back to front across meshes and materials too.
+        let glassNear = DrawSortKey(pass: .transparent, pipeline: 0, material: 1, mesh: 1, depth: 2.0)
+        let glassFar = DrawSortKey(pass: .transparent, pipeline: 3, material: 7, mesh: 9, depth: 40.0)
+        XCTAssertLessThan(glassFar, glassNear)
+        XCTAssertEqual(glassFar.pipeline, 3)
+        XCTAssertEqual(glassFar.material, 7)
+        XCTAssertEqual(glassFar.mesh, 9)
+        XCTAssertEqual(glassFar.pass, .transparent)
+    }
+
+    func testRendererGroupsDrawsAndAvoidsBinds() async throws {
+        try await MainActor.run {
+            let window = SDLWindow(config: .init(title: "Sort", width: 64, height: 64))
+            let backend = try RecordingRenderBackend(window: window)
+            SceneGraphRenderer.resetPipelineCache()
+            let cube = try MeshFactory.makeLitCube(backend: backend, size: 0.2)
+            let plane = try MeshFactory.makeLitPlane(backend: backend, size: 0.2)
+            let material = Material(shader: ShaderID("basic_lit"))
+            let root = SceneNode(name: "Root")
+            for i in 0..<8 {
+                root.addChild(SceneNode(name: "N\(i)",
+                                        transform: .translation(x: Float(i) * 0.05 - 0.2, y: 0, z: 0),
+                                        mesh: i % 2 == 0 ? cube : plane,
+                                        material: material))
+            }
+            let scene = Scene(root: root, camera: nil)
+
+            try SceneGraphRenderer.updateAndRender(scene: scene, backend: backend)
+
+            XCTAssertEqual(backend.drawnMeshes.count, 8)
+            let transitions = zip(backend.drawnMeshes, backend.drawnMeshes.dropFirst()).filter { $0.0 != $0.1 }.count
+            XCTAssertEqual(transitions, 1, "Sorted submission should group draws by mesh")
+            guard let counters = SceneGraphRenderer.lastStateCounters else {
+                XCTFail("Expected bind counters from a RenderStateCounting backend")
+                return
+            }
+            XCTAssertEqual(counters.pipelineBinds, 1)
+            XCTAssertEqual(counters.pipelineBindsAvoided, 7)
+            XCTAssertEqual(counters.vertexBufferBinds, 2)
+            XCTAssertEqual(counters.vertexBufferBindsAvoided, 6)
+            XCTAssertEqual(counters.bindsAvoided, 7 + 6 + counters.resourceBindsAvoided)
+        }
+    }
+
+    func testPassComesFromTheTransparencyFlagNotBaseColorAlpha() async throws {
+        try await MainActor.run {
+            let window = SDLWindow(config: .init(title: "Pass", width: 64, height: 64))
+            let backend = try RecordingRenderBackend(window: window)
+            SceneGraphRenderer.resetPipelineCache()
+            let cube = try MeshFactory.makeLitCube(backend: backend, size: 0.2)
+            // Alpha 0 is the untextured flag for the lit shader, not translucency.
+            let untextured = Material(shader: ShaderID("basic_lit"), params: MaterialParams(baseColor: (1, 0, 0, 0)))
+            let glass = Material(shader: ShaderID("basic_lit"), params: MaterialParams(baseColor: (1, 1, 1, 1), isTransparent: true))
+            let root = SceneNode(name: "Root")
+            root.addChild(SceneNode(name: "Solid", transform: .identity, mesh: cube, material: untextured))
+            root.addChild(SceneNode(name: "Glass", transform: .identity, mesh: cube, material: glass))
+
+            try SceneGraphRenderer.updateAndRender(scene: Scene(root: root, camera: nil), backend: backend)
+
+            let passes = SceneGraphRenderer.frameDrawList.items.map(\.key.pass)
+            XCTAssertEqual(passes, [.opaque, .transparent])
+        }
+    }
+}
@@ -0,0 +1,107 @@
+import XCTest
+@testable import SDLKit
+
+final class FrameArenaTests: XCTestCase {
+    func testArenaAlignsAndReusesBlocks() {
+        let arena = FrameArena(blockSize: 1024)
+        let a = arena.allocate(byteCount: 3, alignment: 4)
+        let b = arena.allocate(byteCount: 96, alignment: 16)
+        XCTAssertEqual(Int(bitPattern: b.baseAddress) % 16, 0)
+        XCTAssertGreaterThanOrEqual(b.baseAddress! - UnsafeMutableRawPointer(a.baseAddress!), 3)
+        let big = arena.allocate(byteCount: 4096)
+        XCTAssertEqual(big.count, 4096)
+        XCTAssertEqual(arena.blockAllocations, 2)
+
+        let generation = arena.generation
+        arena.reset()
+        XCTAssertEqual(arena.generation, generation + 1)
+        XCTAssertEqual(arena.bytesInUse, 0)
+        _ = arena.allocate(byteCount: 3, alignment: 4)
+        _ = arena.allocate(byteCount: 96, alignment: 16)
+        _ = arena.allocate(byteCount: 4096)
+        XCTAssertEqual(arena.blockAllocations, 2, "A repeated frame should reuse the existing blocks")
+    }
+
+    func testArenaConstantsAreReadInPlace() {
+        let arena = FrameArena()
+        let constants = arena.makeConstants(byteCount: 8) { raw in
+            raw.storeBytes(of: Float(1.5), toByteOffset: 0, as: Float.self)
+            raw.storeBytes(of: Float(-2), toByteOffset: 4, as: Float.self)
+        }
+        XCTAssertTrue(constants.isArenaBacked)
+        XCTAssertEqual(constants.byteCount, 8)
+        let floats = constants.withUnsafeBytes { Array($0.bindMemory(to: Float.self)) }
+        XCTAssertEqual(floats, [1.5, -2])
+        XCTAssertEqual(constants.data.count, 8)
+        XCTAssertTrue(constants.isLive)
+        arena.reset()
+        XCTAssertFalse(constants.isLive, "constants must not outlive their arena generation")
+        XCTAssertTrue(BindingSet.MaterialConstants(data: Data([1])).isLive)
+    }
+
+    func testBindingSetInlineSlots() {
+        var a = BindingSet()
+        let texture = TextureHandle()
+        let sampler = SamplerHandle()
+        a.setTexture(texture, at: 10)
+        a.setSampler(sampler, at: 10)
+        a.setBuffer(BufferHandle(rawValue: 1), at: 0)
+        a.setBuffer(BufferHandle(rawValue: 2), at: 0)
+        XCTAssertTrue(a.isInline)
+        XCTAssertEqual(a.texture(at: 10), texture)
+        XCTAssertEqual(a.buffer(at: 0), BufferHandle(rawValue: 2))
+        XCTAssertEqual(a.resources.count, 2)
+
+        var b = BindingSet()
+        b.setBuffer(BufferHandle(rawValue: 2), at: 0)
+        b.setTexture(texture, at: 10)
+        b.setSampler(sampler, at: 10)
+        XCTAssertTrue(a.hasSameResources(as: b), "Slot order must not affect equality")
+
+        b.removeResource(at: 0)
+        XCTAssertNil(b.buffer(at: 0))
+        XCTAssertEqual(b.texture(at: 10), texture)
+        XCTAssertFalse(a.hasSameResources(as: b))
+
+        var wide = BindingSet()
+        for slot in 0..<12 { wide.setBuffer(BufferHandle(rawValue: UInt64(slot)), at: slot) }
+        XCTAssertFalse(wide.isInline)
+        for slot in 0..<12 { XCTAssertEqual(wide.buffer(at: slot), BufferHandle(rawValue: UInt64(slot))) }
+        XCTAssertEqual(wide.resources.count, 12)
+    }
+
+    func testSteadyStateDrawsDoNotAllocate() async throws {
+        try await MainActor.run {
+            let window = SDLWindow(config: .init(title: "Arena", width: 64, height: 64))
+            let backend = try RecordingRenderBackend(window: window)
+            SceneGraphRenderer.resetPipelineCache()
+            let mesh = try MeshFactory.makeLitCube(backend: backend, size: 0.1)
+            let material = Material(shader: ShaderID("basic_lit"))
+            let root = SceneNode(name: "Root")
+            for i in 0..<64 {
+                root.addChild(SceneNode(name: "N\(i)",
+                                        transform: .translation(x: Float(i % 8) * 0.1 - 0.4, y: Float(i / 8) * 0.1 - 0.4, z: 0),
+                                        mesh: mesh,
+                                        material: material))
+            }
+            let scene = Scene(root: root, camera: nil)
+
+            for _ in 0..<3 {
+                try SceneGraphRenderer.updateAndRender(scene: scene, backend: backend)
+            }
+            let warmBlocks = backend.recordingArena.blockAllocations
+            let warmBytes = backend.recordingArena.bytesInUse
+            for _ in 0..<50 {
+                try SceneGraphRenderer.updateAndRender(scene: scene, backend: backend)
+            }
+
+            // Push constants come from the reused arena and bindings stay in their inline
+            // slots, so the per-draw path never reaches the heap once warmed up.
+            XCTAssertEqual(backend.recordingArena.blockAllocations, warmBlocks)
+            XCTAssertEqual(backend.recordingArena.bytesInUse, warmBytes)
+            XCTAssertEqual(backend.heapBackedPayloads, 0)
+            XCTAssertEqual(backend.spilledBindingSets, 0)
+            XCTAssertEqual(backend.drawCallCount, 64 * 53)
+        }
+    }
+}
@@ -0,0 +1,110 @@
+import XCTest
+@testable import SDLKit
+
+final class FrameStreamTests: XCTestCase {
+    private static func frame(width: Int, height: Int, fill: UInt8 = 0x20) -> [UInt8] {
+        [UInt8](repeating: fill, count: width * height * 4)
+    }
+
+    private func encode(_ encoder: inout FrameDeltaEncoder, _ pixels: [UInt8], width: Int, height: Int) throws -> FrameDeltaEncoder.Delta? {
+        try pixels.withUnsafeBytes { try encoder.encode(pixels: $0, width: width, height: height, bytesPerRow: width * 4) }
+    }
+
+    func testOnlyChangedTilesAreSent() throws {
+        var encoder = FrameDeltaEncoder(tileSize: 32, encoding: .raw)
+        var pixels = Self.frame(width: 100, height: 70)
+        let key = try XCTUnwrap(try encode(&encoder, pixels, width: 100, height: 70))
+        XCTAssertTrue(key.isKeyframe)
+        XCTAssertEqual(key.tiles.count, 4 * 3)
+        XCTAssertEqual(key.tiles.last.map { [$0.x, $0.y, $0.width, $0.height] }, [96, 64, 4, 6])
+
+        XCTAssertNil(try encode(&encoder, pixels, width: 100, height: 70), "unchanged frames produce no message")
+
+        pixels[(40 * 100 + 70) * 4] = 0xFF
+        let delta = try XCTUnwrap(try encode(&encoder, pixels, width: 100, height: 70))
+        XCTAssertFalse(delta.isKeyframe)
+        XCTAssertEqual(delta.sequence, key.sequence + 1)
+        XCTAssertEqual(delta.tiles.map { [$0.x, $0.y, $0.width, $0.height] }, [[64, 32, 32, 32]])
+        let tile = try XCTUnwrap(delta.tiles.first)
+        XCTAssertEqual(tile.encoding, .raw)
+        XCTAssertEqual(tile.payload.count, 32 * 32 * 4)
+        XCTAssertEqual(tile.payload[(8 * 32 + 6) * 4], 0xFF)
+
+        // A resize starts over with a keyframe.
+        let resized = try XCTUnwrap(try encode(&encoder, Self.frame(width: 40, height: 40), width: 40, height: 40))
+        XCTAssertTrue(resized.isKeyframe)
+        XCTAssertEqual(resized.tiles.count, 4)
+    }
+
+    func testPNGTilesOnlyWhenSmaller() throws {
+        var encoder = FrameDeltaEncoder(tileSize: 16, encoding: .png)
+        var pixels = Self.frame(width: 32, height: 16)
+        var state: UInt32 = 9
+        for y in 0..<16 {
+            for i in (y * 128 + 64)..<(y * 128 + 128) {
+                state = state &* 1_664_525 &+ 1_013_904_223
+                pixels[i] = UInt8(truncatingIfNeeded: state >> 24)
+            }
+        }
+        let key = try XCTUnwrap(try encode(&encoder, pixels, width: 32, height: 16))
+        XCTAssertEqual(key.tiles.map(\.encoding), [.png, .raw], "flat tile compresses; noise tile stays raw")
+        XCTAssertEqual([UInt8](key.tiles[0].payload.prefix(8)), PNGEncoder.signature)
+    }
+
+    func testSerializedMessageLayout() throws {
+        var encoder = FrameDeltaEncoder(tileSize: 64, encoding: .raw)
+        let delta = try XCTUnwrap(try encode(&encoder, Self.frame(width: 2, height: 2), width: 2, height: 2))
+        let message = [UInt8](delta.serialized(droppedFrames: 3))
+        func u32(_ at: Int) -> Int { Int(message[at]) | Int(message[at + 1]) << 8 | Int(message[at + 2]) << 16 | Int(message[at + 3]) << 24 }
+        func u16(_ at: Int) -> Int { Int(message[at]) | Int(message[at + 1]) << 8 }
+        XCTAssertEqual(Array(message[0..<4]), FrameDeltaEncoder.magic)
+        XCTAssertEqual(u32(4), message.count - 8)
+        XCTAssertEqual(u32(8), 1)       // sequence
+        XCTAssertEqual(u32(12), 3)      // dropped frames
+        XCTAssertEqual([u32(16), u32(20)], [2, 2])
+        XCTAssertEqual(message[24], 1)  // keyframe
+        XCTAssertEqual(u32(26), 1)      // tile count
+        XCTAssertEqual([u16(30), u16(32), u16(34), u16(36)], [0, 0, 2, 2])
+        XCTAssertEqual(message[38], FrameDeltaEncoder.TileEncoding.raw.rawValue)
+        XCTAssertEqual(u32(39), 16)
+        XCTAssertEqual(message.count, 43 + 16)
+    }
+
+    func testSessionStreamsFromAgentCaptures() async throws {
+        try await MainActor.run {
+            let agent = MockFrameAgent(frames: [Self.frame(width: 8, height: 8), Self.frame(width: 8, height: 8), Self.frame(width: 8, height: 8, fill: 0x30)])
+            let session = try FrameStreamSession(agent: agent, request: FrameStreamRequest(window_id: 1, fps: 20, encoding: "raw"))
+            XCTAssertEqual(session.interval, 0.05, accuracy: 1e-9)
+            XCTAssertEqual(agent.captures, 1, "the first frame is captured when the session opens")
+            XCTAssertNotNil(try session.nextMessage())
+            XCTAssertNil(try session.nextMessage())
+            XCTAssertNotNil(try session.nextMessage(droppedFrames: 2))
+            XCTAssertEqual(session.messagesSent, 2)
+
+            XCTAssertThrowsError(try FrameStreamSession(agent: agent, request: FrameStreamRequest(window_id: 404)))
+            XCTAssertThrowsError(try FrameStreamSession(agent: agent, request: FrameStreamRequest(window_id: 1, fps: 0)))
+            XCTAssertThrowsError(try FrameStreamSession(agent: agent, request: FrameStreamRequest(window_id: 1, encoding: "jpeg")))
+
+            let response = SDLKitJSONAgent(agent: agent).handle(path: SDLKitJSONAgent.Endpoint.frameStream.rawValue, body: Data())
+            XCTAssertTrue(String(decoding: response, as: UTF8.self).contains("not_implemented"))
+        }
+    }
+}
+
+@MainActor
+private final class MockFrameAgent: SDLKitGUIAgent {
+    private var frames: [[UInt8]]
+    private(set) var captures = 0
+
+    init(frames: [[UInt8]]) {
+        self.frames = frames
+        super.init()
+    }
+
+    override func captureFramePixels(windowId: Int) throws -> (pixels: [UInt8], width: Int, height: Int, pitch: Int) {
+        guard windowId == 1 else { throw AgentError.windowNotFound }
+        captures += 1
+        let pixels = frames.count > 1 ? frames.removeFirst() : frames[0]
+        return (pixels, 8, 8, 32)
+    }
+}
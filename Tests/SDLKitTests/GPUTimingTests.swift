@@ -0,0 +1,169 @@
+import XCTest
+@testable import SDLKit
+
+final class GPUTimingTests: XCTestCase {
+    func testRingResolvesSlotOnReuseAndDropsOverBudget() {
+        var ring = GPUTimestampRing(frameSlots: 2, queriesPerFrame: 4, immediateQueries: 4)
+        XCTAssertEqual(ring.queryCount, 12)
+        XCTAssertEqual(ring.immediateCapacity, 2)
+
+        XCTAssertTrue(ring.beginFrame(slot: 0).isEmpty)
+        XCTAssertEqual(ring.beginScope("frame"), 0)
+        XCTAssertEqual(ring.beginScope("scene"), 2)
+        XCTAssertNil(ring.beginScope("over budget"))
+        XCTAssertNil(ring.endScope(), "dropped scope must close without a query")
+        XCTAssertEqual(ring.endScope(), 3)
+        XCTAssertEqual(ring.endFrame(), [1], "frame scope left open is closed at endFrame")
+        XCTAssertEqual(ring.takeDroppedScopes(), 1)
+        XCTAssertEqual(ring.takeDroppedScopes(), 0)
+
+        XCTAssertTrue(ring.beginFrame(slot: 1).isEmpty)
+        XCTAssertEqual(ring.beginScope("frame"), 4)
+        _ = ring.endFrame()
+
+        let completed = ring.beginFrame(slot: 0)
+        XCTAssertEqual(completed.map(\.label), ["frame", "scene"])
+        XCTAssertEqual(completed.map(\.begin), [0, 2])
+
+        let first = ring.reserveImmediate("dispatch:a")
+        let second = ring.reserveImmediate("dispatch:b")
+        let third = ring.reserveImmediate("dispatch:c")
+        XCTAssertEqual(first?.begin, 8)
+        XCTAssertEqual(second?.begin, 10)
+        XCTAssertEqual(third?.begin, 8, "immediate pairs are reused round-robin")
+    }
+
+    func testEncoderSamplesSpanScopeEncodersAndDropOverBudget() {
+        var ring = GPUEncoderSampleRing(frameSlots: 2, samplesPerFrame: 6)
+        XCTAssertEqual(ring.sampleCount, 12)
+        XCTAssertNil(ring.reserveEncoder(), "no samples outside a frame")
+
+        ring.beginFrame(slot: 1)
+        XCTAssertNil(ring.reserveEncoder(), "encoders outside any scope are not sampled")
+        ring.beginScope("scene")
+        XCTAssertEqual(ring.reserveEncoder()?.start, 6)
+        ring.beginScope("shadows")
+        XCTAssertEqual(ring.reserveEncoder()?.start, 8)
+        ring.endScope()
+        ring.beginScope("empty")
+        ring.endScope()
+        XCTAssertEqual(ring.reserveEncoder()?.end, 11)
+        let frame = ring.endFrame()
+        XCTAssertEqual(frame.samples, 6..<12)
+        XCTAssertEqual(frame.scopes.map(\.label), ["shadows", "scene"])
+        XCTAssertEqual(frame.scopes.map(\.begin), [8, 6])
+        XCTAssertEqual(frame.scopes.map(\.end), [9, 11], "scene spans from its first to its last encoder")
+        XCTAssertEqual(ring.takeDroppedScopes(), 0)
+
+        ring.beginFrame(slot: 0)
+        ring.beginScope("scene")
+        for _ in 0..<3 { XCTAssertNotNil(ring.reserveEncoder()) }
+        XCTAssertNil(ring.reserveEncoder())
+        let overBudget = ring.endFrame()
+        XCTAssertTrue(overBudget.scopes.isEmpty, "a scope missing encoders is dropped, not shortened")
+        XCTAssertEqual(overBudget.samples, 0..<6)
+        XCTAssertEqual(ring.takeDroppedScopes(), 1)
+    }
+
+    func testDurationsMaskValidBitsAndSkipUnavailable() {
+        let scopes = [
+            GPUTimestampRing.Scope(label: "wrap", begin: 0, end: 1, closed: true),
+            GPUTimestampRing.Scope(label: "missing", begin: 2, end: 3, closed: true),
+            GPUTimestampRing.Scope(label: "open", begin: 4, end: 5, closed: false)
+        ]
+        // 8 valid bits: the counter wraps from 250 to 4, a 10-tick interval.
+        let ticks: [UInt32: UInt64] = [0: 250, 1: 4, 2: 7, 4: 1, 5: 2]
+        let out = GPUTimestampRing.durations(of: scopes, nanosecondsPerTick: 100_000, validBits: 8) { ticks[$0] }
+        XCTAssertEqual(out.count, 1)
+        XCTAssertEqual(out.first?.label, "wrap")
+        XCTAssertEqual(out.first?.milliseconds ?? 0, 1.0, accuracy: 1e-9)
+    }
+
+    func testAggregatorKeepsRollingWindow() {
+        let timings = GPUTimingAggregator(source: "test", windowSize: 20)
+        for value in 1...40 {
+            timings.record("frame", milliseconds: Double(value))
+        }
+        timings.record("frame", milliseconds: .nan)
+        let stats = timings.stats(for: "frame")
+        XCTAssertEqual(stats?.sampleCount, 20)
+        XCTAssertEqual(stats?.totalSamples, 40)
+        XCTAssertEqual(stats?.lastMilliseconds, 40)
+        XCTAssertEqual(stats?.minMilliseconds, 21)
+        XCTAssertEqual(stats?.maxMilliseconds, 40)
+        XCTAssertEqual(stats?.averageMilliseconds ?? 0, 30.5, accuracy: 1e-9)
+        XCTAssertEqual(stats?.p95Milliseconds, 39)
+
+        timings.record([(label: "b", milliseconds: 1), (label: "a", milliseconds: 2)])
+        XCTAssertEqual(timings.snapshot().map(\.label), ["a", "b", "frame"])
+        timings.reset()
+        XCTAssertTrue(timings.snapshot().isEmpty)
+    }
+
+    func testStubBackendRecordsFrameSceneAndDispatchScopes() async throws {
+        try await MainActor.run {
+            let window = SDLWindow(config: .init(title: "GPUTiming", width: 32, height: 32))
+            do {
+                try window.open()
+            } catch AgentError.sdlUnavailable {
+                throw XCTSkip("SDL unavailable; skipping")
+            }
+            defer { window.close() }
+
+            let backend = try RenderBackendFactory.makeBackend(window: window, override: "vulkan")
+            guard backend is StubRenderBackend else {
+                throw XCTSkip("Native backend active; stub timing test not applicable")
+            }
+            for _ in 0..<4 {
+                try backend.beginFrame()
+                backend.withGPUScope("scene") {}
+                try backend.endFrame()
+            }
+            let frameStats = backend.gpuTimingStats.first { $0.label == GPUTimingLabel.frame }
+            let sceneStats = backend.gpuTimingStats.first { $0.label == "scene" }
+            // Two frames in flight: only the first two frames have been read back.
+            XCTAssertEqual(frameStats?.sampleCount, 2)
+            XCTAssertEqual(sceneStats?.sampleCount, 2)
+
+            let module = try ShaderLibrary.shared.computeModule(for: ShaderID("vector_add"))
+            let pipeline = try backend.makeComputePipeline(ComputePipelineDescriptor(label: "vector_add", shader: module.id))
+            let zeros = [Float](repeating: 0, count: 16)
+            let buffers = try (0..<3).map { _ in
+                try zeros.withUnsafeBytes { try backend.createBuffer(bytes: $0.baseAddress, length: $0.count, usage: .storage) }
+            }
+            var bindings = BindingSet()
+            for (index, buffer) in buffers.enumerated() { bindings.setBuffer(buffer, at: index) }
+            var constants = Data(count: MemoryLayout<UInt32>.size * 4)
+            constants.withUnsafeMutableBytes { $0.storeBytes(of: UInt32(zeros.count), as: UInt32.self) }
+            bindings.materialConstants = BindingSet.MaterialConstants(data: constants)
+            try backend.dispatchCompute(pipeline, groupsX: 1, groupsY: 1, groupsZ: 1, bindings: bindings)
+
+            let dispatchStats = backend.gpuTimingStats.first { $0.label == GPUTimingLabel.dispatch(module.id) }
+            XCTAssertEqual(dispatchStats?.sampleCount, 1, "out-of-frame dispatches resolve immediately")
+        }
+    }
+
+    func testTimingsEndpointReportsRegisteredAggregators() async throws {
+        try await MainActor.run {
+            let timings = GPUTimingAggregator(source: "endpoint-test")
+            GPUTimingRegistry.register(timings)
+            timings.record("frame", milliseconds: 2)
+            timings.record("frame", milliseconds: 4)
+
+            let agent = SDLKitJSONAgent()
+            let data = agent.handle(path: SDLKitJSONAgent.Endpoint.gpuTimings.rawValue, body: Data())
+            let object = try JSONSerialization.jsonObject(with: data) as? [String: Any]
+            let backends = object?["backends"] as? [[String: Any]] ?? []
+            let entry = backends.first { $0["backend"] as? String == "endpoint-test" }
+            XCTAssertEqual(entry?["timestamps_supported"] as? Bool, true)
+            XCTAssertEqual(entry?["labeled_scopes_supported"] as? Bool, true)
+            let scopes = entry?["scopes"] as? [[String: Any]] ?? []
+            XCTAssertEqual(scopes.first?["label"] as? String, "frame")
+            XCTAssertEqual(scopes.first?["samples"] as? Int, 2)
+            XCTAssertEqual(scopes.first?["avg_ms"] as? Double ?? 0, 3, accuracy: 1e-9)
+
+            _ = agent.handle(path: SDLKitJSONAgent.Endpoint.gpuTimings.rawValue, body: Data(#"{"reset":true}"#.utf8))
+            XCTAssertTrue(timings.snapshot().isEmpty)
+        }
+    }
+}
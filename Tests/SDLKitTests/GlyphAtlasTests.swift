@@ -0,0 +1,106 @@
+import XCTest
+@testable import SDLKit
+
+final class GlyphAtlasTests: XCTestCase {
+    func testSkylinePackerKeepsRectanglesDisjointAndInBounds() {
+        var packer = SkylinePacker(width: 64, height: 64)
+        var placed: [(x: Int, y: Int, w: Int, h: Int)] = []
+        var state: UInt32 = 7
+        while true {
+            state = state &* 1_664_525 &+ 1_013_904_223
+            let w = 3 + Int(state >> 28), h = 5 + Int((state >> 24) & 0x7)
+            guard let origin = packer.pack(width: w, height: h) else { break }
+            placed.append((origin.x, origin.y, w, h))
+        }
+        XCTAssertGreaterThan(placed.count, 20)
+        for (i, a) in placed.enumerated() {
+            XCTAssertTrue(a.x >= 0 && a.y >= 0 && a.x + a.w <= 64 && a.y + a.h <= 64)
+            for b in placed[(i + 1)...] {
+                let disjoint = a.x + a.w <= b.x || b.x + b.w <= a.x || a.y + a.h <= b.y || b.y + b.h <= a.y
+                XCTAssertTrue(disjoint, "\(a) overlaps \(b)")
+            }
+        }
+        XCTAssertEqual(packer.usedArea, placed.reduce(0) { $0 + $1.w * $1.h })
+        XCTAssertGreaterThan(Double(packer.usedArea) / Double(64 * 64), 0.6, "skyline packing stays dense")
+
+        packer.reset()
+        XCTAssertEqual(packer.pack(width: 64, height: 64).map { [$0.x, $0.y] }, [0, 0])
+        XCTAssertNil(packer.pack(width: 1, height: 1))
+    }
+
+    func testAtlasRecyclesLeastRecentlyDrawnPage() throws {
+        var made = 0
+        var recycled: [Int] = []
+        var atlas = GlyphAtlas<Int>(pageSize: 16, maxPages: 2)
+        func insert(_ codepoint: UInt32) throws -> GlyphAtlas<Int>.Glyph? {
+            try atlas.insert(codepoint, width: 14, height: 14, advance: 9,
+                             makePage: { made += 1; return made }, recycle: { _, page in recycled.append(page) })
+        }
+        atlas.beginDraw()
+        let a = try XCTUnwrap(try insert(65))
+        XCTAssertEqual([a.page, a.x, a.y, a.advance], [0, 1, 1, 9], "glyphs sit inside a one-texel border")
+        atlas.beginDraw()
+        XCTAssertEqual(try insert(66)?.page, 1)
+        XCTAssertEqual(atlas.pages, [1, 2])
+
+        atlas.beginDraw()
+        XCTAssertNotNil(atlas.glyph(for: 65))
+        atlas.beginDraw()
+        XCTAssertEqual(try insert(67)?.page, 1, "page 1 was drawn least recently")
+        XCTAssertEqual(recycled, [2])
+        XCTAssertNil(atlas.glyph(for: 66))
+        XCTAssertNotNil(atlas.glyph(for: 65))
+        XCTAssertEqual(atlas.evictions, 1)
+        XCTAssertEqual(made, 2)
+
+        XCTAssertNil(try atlas.insert(68, width: 40, height: 4, advance: 0, makePage: { 0 }, recycle: { _, _ in }),
+                     "glyphs larger than a page are rejected")
+        XCTAssertEqual(atlas.insertBlank(32, advance: 4).page, -1)
+        XCTAssertEqual(atlas.glyph(for: 32)?.advance, 4)
+        XCTAssertEqual(atlas.removeAll(), [1, 2])
+        XCTAssertEqual(atlas.glyphCount, 0)
+    }
+
+    func testQuadBatchLayout() {
+        var batch = TextQuadBatch()
+        batch.appendQuad(x: 10, y: 20, width: 4, height: 8, u0: 0, v0: 0, u1: 0.5, v1: 0.25, color: SIMD4(1, 0.5, 0, 1))
+        batch.appendQuad(x: 14, y: 20, width: 4, height: 8, u0: 0.5, v0: 0, u1: 1, v1: 0.25, color: SIMD4(1, 1, 1, 1))
+        XCTAssertEqual(batch.quadCount, 2)
+        XCTAssertEqual(batch.vertexCount, 8)
+        XCTAssertEqual(batch.indices, [0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7])
+        XCTAssertEqual(Array(batch.vertices[0..<8]), [10, 20, 1, 0.5, 0, 1, 0, 0])
+        XCTAssertEqual(Array(batch.vertices[16..<24]), [14, 28, 1, 0.5, 0, 1, 0.5, 0.25])
+    }
+
+    /// Labels that fit in a 60 Hz frame with the per-call rasterizing path versus the atlas.
+    /// Needs a real SDL renderer with SDL_ttf and a system font; skipped otherwise.
+    func testBenchmarkLabelsPerFrame() async throws {
+        try await MainActor.run {
+            guard SDLKitState.isTextRenderingEnabled, let font = SDLFontResolver.defaultFontPath() else {
+                throw XCTSkip("SDL_ttf or a system font unavailable; skipping")
+            }
+            let window = SDLWindow(config: .init(title: "GlyphAtlasBenchmark", width: 640, height: 480))
+            do {
+                try window.open()
+            } catch AgentError.sdlUnavailable {
+                throw XCTSkip("SDL unavailable; skipping")
+            }
+            defer { window.close() }
+            let renderer = try SDLRenderer(width: 640, height: 480, window: window)
+            defer { renderer.shutdown() }
+
+            let labels = (0..<200).map { "ch\($0 % 16) note \(36 + $0 % 48) vel \(($0 * 37) % 128)" }
+            func labelsPerFrame(_ draw: (String, Int) throws -> Void) rethrows -> Double {
+                for (i, label) in labels.prefix(20).enumerated() { try draw(label, i) } // warm up
+                let start = DispatchTime.now().uptimeNanoseconds
+                for (i, label) in labels.enumerated() { try draw(label, i) }
+                let seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+                return Double(labels.count) / seconds / 60
+            }
+            let before = try labelsPerFrame { try renderer.drawTextRasterized($0, x: 4, y: ($1 % 30) * 16, color: 0xFFFFFFFF, fontPath: font, size: 14) }
+            let after = try labelsPerFrame { try renderer.drawText($0, x: 4, y: ($1 % 30) * 16, color: 0xFFFFFFFF, fontPath: font, size: 14) }
+            print("labels per 60 Hz frame: rasterized \(Int(before)), glyph atlas \(Int(after))")
+            XCTAssertGreaterThan(after, 0)
+        }
+    }
+}
@@ -0,0 +1,129 @@
+import XCTest
+@testable import SDLKit
+
+final class MatrixKernelTests: XCTestCase {
+    // Tuple-of-tuples reference matching the pre-SIMD implementation.
+    private typealias Column = (Float, Float, Float, Float)
+    private typealias TupleMatrix = (Column, Column, Column, Column)
+
+    private static func referenceMultiply(_ a: TupleMatrix, _ b: TupleMatrix) -> TupleMatrix {
+        func dot(_ a: Column, _ b: Column) -> Float {
+            return a.0*b.0 + a.1*b.1 + a.2*b.2 + a.3*b.3
+        }
+        func column(_ bc: Column) -> Column {
+            return (
+                dot((a.0.0, a.1.0, a.2.0, a.3.0), bc),
+                dot((a.0.1, a.1.1, a.2.1, a.3.1), bc),
+                dot((a.0.2, a.1.2, a.2.2, a.3.2), bc),
+                dot((a.0.3, a.1.3, a.2.3, a.3.3), bc)
+            )
+        }
+        return (column(b.0), column(b.1), column(b.2), column(b.3))
+    }
+
+    private static func referenceFloats(_ m: TupleMatrix) -> [Float] {
+        return [m.0.0, m.0.1, m.0.2, m.0.3,
+                m.1.0, m.1.1, m.1.2, m.1.3,
+                m.2.0, m.2.1, m.2.2, m.2.3,
+                m.3.0, m.3.1, m.3.2, m.3.3]
+    }
+
+    private func sampleMatrices(count: Int) -> [float4x4] {
+        (0..<count).map { i in
+            let f = Float(i)
+            return float4x4.translation(x: f * 0.5, y: -f, z: 2) * float4x4.rotationZ(f * 0.1)
+        }
+    }
+
+    func testMultiplyMatchesTupleReference() {
+        let a = float4x4.perspective(fovYRadians: .pi / 3, aspect: 1.5, zNear: 0.1, zFar: 100)
+        let b = float4x4.lookAt(eye: (1, 2, 3), center: (0, 0, 0), up: (0, 1, 0)) * float4x4.translation(x: 4, y: 5, z: 6)
+        let simd = (a * b).toFloatArray()
+        let reference = Self.referenceFloats(Self.referenceMultiply(a.columns, b.columns))
+        XCTAssertEqual(simd, reference)
+    }
+
+    func testColumnsRoundTrip() {
+        var m = float4x4.identity
+        m.columns = ((1, 2, 3, 4), (5, 6, 7, 8), (9, 10, 11, 12), (13, 14, 15, 16))
+        XCTAssertEqual(m.toFloatArray(), (1...16).map(Float.init))
+        XCTAssertEqual(m.c3, SIMD4<Float>(13, 14, 15, 16))
+        XCTAssertEqual(m.columns.1.2, 7)
+    }
+
+    func testBatchMultiplyAndWrite() {
+        let parent = float4x4.translation(x: 1, y: 2, z: 3)
+        let locals = sampleMatrices(count: 8)
+        var worlds = [float4x4](repeating: .identity, count: locals.count)
+        locals.withUnsafeBufferPointer { src in
+            worlds.withUnsafeMutableBufferPointer { dst in
+                MatrixKernels.multiply(src, by: parent, into: dst)
+            }
+        }
+        for (local, world) in zip(locals, worlds) {
+            XCTAssertEqual(world.toFloatArray(), (parent * local).toFloatArray())
+        }
+
+        let stride = 96
+        var raw = [UInt8](repeating: 0, count: stride * worlds.count)
+        raw.withUnsafeMutableBytes { bytes in
+            worlds.withUnsafeBufferPointer { src in
+                MatrixKernels.write(src, to: bytes.baseAddress!, stride: stride)
+            }
+        }
+        raw.withUnsafeBytes { bytes in
+            for (index, world) in worlds.enumerated() {
+                let floats = (0..<16).map { bytes.load(fromByteOffset: index * stride + $0 * 4, as: Float.self) }
+                XCTAssertEqual(floats, world.toFloatArray())
+            }
+        }
+    }
+
+    func testTransformPoints() {
+        let m = float4x4.translation(x: 1, y: -1, z: 0.5)
+        let points: [SIMD3<Float>] = [SIMD3(0, 0, 0), SIMD3(1, 2, 3)]
+        var out = [SIMD3<Float>](repeating: .zero, count: points.count)
+        points.withUnsafeBufferPointer { src in
+            out.withUnsafeMutableBufferPointer { dst in
+                MatrixKernels.transformPoints(src, by: m, into: dst)
+            }
+        }
+        XCTAssertEqual(out[0], SIMD3(1, -1, 0.5))
+        XCTAssertEqual(out[1], SIMD3(2, 1, 3.5))
+    }
+
+    // MARK: - Benchmarks
+
+    func testBenchmarkTupleReferenceMultiply() {
+        let locals = sampleMatrices(count: 4096).map { $0.columns }
+        let parent = float4x4.translation(x: 1, y: 2, z: 3).columns
+        var sink: Float = 0
+        measure {
+            for local in locals {
+                let world = Self.referenceMultiply(parent, local)
+                sink += Self.referenceFloats(world)[12]
+            }
+        }
+        XCTAssertFalse(sink.isNaN)
+    }
+
+    func testBenchmarkSIMDBatchMultiplyAndWrite() {
+        let locals = sampleMatrices(count: 4096)
+        let parent = float4x4.translation(x: 1, y: 2, z: 3)
+        var worlds = [float4x4](repeating: .identity, count: locals.count)
+        let constants = UnsafeMutableRawPointer.allocate(byteCount: locals.count * float4x4.packedByteCount,
+                                                         alignment: MemoryLayout<SIMD4<Float>>.alignment)
+        defer { constants.deallocate() }
+        measure {
+            locals.withUnsafeBufferPointer { src in
+                worlds.withUnsafeMutableBufferPointer { dst in
+                    MatrixKernels.multiply(src, by: parent, into: dst)
+                }
+            }
+            worlds.withUnsafeBufferPointer { src in
+                MatrixKernels.write(src, to: constants)
+            }
+        }
+        XCTAssertEqual(constants.load(fromByteOffset: 12 * 4, as: Float.self), worlds[0].c3.x)
+    }
+}
@@ -0,0 +1,42 @@
+import XCTest
+@testable import SDLKit
+
+@MainActor
+final class OffscreenBackendTests: XCTestCase {
+    func testFactoryOnlyBuildsOffscreenVulkan() {
+        XCTAssertThrowsError(try RenderBackendFactory.makeOffscreenBackend(width: 64, height: 64, override: "metal"))
+        XCTAssertThrowsError(try RenderBackendFactory.makeOffscreenBackend(width: 64, height: 64, override: "d3d12"))
+        XCTAssertThrowsError(try RenderBackendFactory.makeOffscreenBackend(width: 0, height: 64, override: "vulkan"))
+    }
+
+    func testOffscreenFramesCaptureAtTheRequestedSize() throws {
+        let backend: RenderBackend
+        do {
+            backend = try RenderBackendFactory.makeOffscreenBackend(width: 32, height: 16, override: "vulkan")
+        } catch {
+            throw XCTSkip("Offscreen Vulkan backend unavailable: \(error)")
+        }
+        guard let capture = backend as? GoldenImageCapturable else {
+            throw XCTSkip("Backend not capture-capable")
+        }
+
+        for _ in 0..<3 {
+            capture.requestCapture()
+            try backend.beginFrame()
+            try backend.endFrame()
+            let payload = try capture.takeCapturePayload()
+            XCTAssertEqual(payload.width, 32)
+            XCTAssertEqual(payload.height, 16)
+            XCTAssertGreaterThanOrEqual(payload.data.count, 32 * 16 * 4)
+        }
+
+        try backend.resize(width: 8, height: 4)
+        capture.requestCapture()
+        try backend.beginFrame()
+        try backend.endFrame()
+        let resized = try capture.takeCapturePayload()
+        XCTAssertEqual(resized.width, 8)
+        XCTAssertEqual(resized.height, 4)
+        try backend.waitGPU()
+    }
+}
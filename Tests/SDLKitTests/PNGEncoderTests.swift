@@ -0,0 +1,254 @@
+import XCTest
+@testable import SDLKit
+
+final class PNGEncoderTests: XCTestCase {
+    func testRGBARoundTripsAcrossParallelChunks() throws {
+        let width = 37, height = 23, bytesPerRow = width * 4 + 12
+        var random = SeededBytes(seed: 7)
+        var pixels = [UInt8](repeating: 0xEE, count: bytesPerRow * height)
+        for y in 0..<height {
+            for x in 0..<width {
+                let o = y * bytesPerRow + x * 4
+                pixels[o] = UInt8(x * 6)
+                pixels[o + 1] = UInt8(y * 11)
+                pixels[o + 2] = x % 5 == 0 ? random.next() : 0x40
+                pixels[o + 3] = 0xFF
+            }
+        }
+        // Tiny chunks: several waves of parallel chunks, each its own IDAT.
+        let png = try pixels.withUnsafeBytes {
+            try PNGEncoder.encode(width: width, height: height, bytesPerRow: bytesPerRow, layout: .rgba8Unorm,
+                                  pixels: $0, options: PNGEncoder.Options(chunkBytes: 300))
+        }
+        let image = try DecodedPNG(png)
+        XCTAssertEqual(image.width, width)
+        XCTAssertEqual(image.height, height)
+        XCTAssertEqual(image.colorType, 6)
+        XCTAssertEqual(image.idatCount, height / 2 + 1)
+        XCTAssertEqual(image.pixels, (0..<height).flatMap { pixels[($0 * bytesPerRow)..<($0 * bytesPerRow + width * 4)] })
+    }
+
+    func testStreamsSignatureAndHeaderBeforeImageData() throws {
+        let pixels = [UInt8](repeating: 0x80, count: 16 * 16 * 4)
+        var pieces: [Data] = []
+        try pixels.withUnsafeBytes {
+            try PNGEncoder.encode(width: 16, height: 16, bytesPerRow: 64, layout: .rgba8Unorm, pixels: $0,
+                                  options: PNGEncoder.Options(chunkBytes: 130)) { pieces.append($0) }
+        }
+        XCTAssertEqual(pieces.first.map { [UInt8]($0) }, PNGEncoder.signature)
+        XCTAssertEqual(pieces.count, 2 + 8 + 1)
+        // IEND's CRC is fixed by the spec.
+        XCTAssertEqual([UInt8](pieces.last ?? Data()), [0, 0, 0, 0, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82])
+        XCTAssertEqual(try DecodedPNG(pieces.reduce(Data(), +)).pixels, pixels)
+    }
+
+    func testSwizzlesBGRAAndDepthCaptures() throws {
+        let width = 19, height = 3
+        var random = SeededBytes(seed: 3)
+        let bgra = (0..<(width * height * 4)).map { _ in random.next() }
+        let capture = GoldenImageCapture(width: width, height: height, bytesPerRow: width * 4, layout: .bgra8Unorm, data: Data(bgra))
+        let decoded = try DecodedPNG(try capture.pngData())
+        var expected = bgra
+        for i in stride(from: 0, to: expected.count, by: 4) { expected.swapAt(i, i + 2) }
+        XCTAssertEqual(decoded.pixels, expected)
+
+        let samples: [Float] = [0, 0.5, 1, 2, -1, .nan]
+        let depths = (0..<(width * height)).map { samples[$0 % samples.count] }
+        let depth = GoldenImageCapture(width: width, height: height, bytesPerRow: width * 4, layout: .depth32Float,
+                                       data: depths.withUnsafeBytes { Data($0) })
+        let gray = try DecodedPNG(try depth.pngData())
+        XCTAssertEqual(gray.colorType, 0)
+        XCTAssertEqual(gray.pixels, depths.map { $0.isNaN ? 0 : UInt8(max(0, min(1, $0)) * 255) })
+    }
+
+    func testIncompressibleDataFallsBackToStoredBlocks() throws {
+        var random = SeededBytes(seed: 11)
+        let pixels = (0..<(64 * 64 * 4)).map { _ in random.next() }
+        for effort in [0, 16] {
+            let png = try pixels.withUnsafeBytes {
+                try PNGEncoder.encode(width: 64, height: 64, bytesPerRow: 256, layout: .rgba8Unorm, pixels: $0,
+                                      options: PNGEncoder.Options(chunkBytes: 4096, matchEffort: effort))
+            }
+            XCTAssertLessThan(png.count, pixels.count + 64 + 200)
+            XCTAssertEqual(try DecodedPNG(png).pixels, pixels)
+        }
+    }
+
+    func testRejectsUndersizedBuffers() {
+        let pixels = [UInt8](repeating: 0, count: 15)
+        pixels.withUnsafeBytes { raw in
+            XCTAssertThrowsError(try PNGEncoder.encode(width: 2, height: 2, bytesPerRow: 8, layout: .rgba8Unorm, pixels: raw))
+            XCTAssertThrowsError(try PNGEncoder.encode(width: 0, height: 2, bytesPerRow: 8, layout: .rgba8Unorm, pixels: raw))
+        }
+    }
+
+    func testAdlerCombineMatchesWholeStream() {
+        var random = SeededBytes(seed: 5)
+        let bytes = (0..<20000).map { _ in random.next() }
+        let whole = bytes.withUnsafeBufferPointer { Adler32.checksum($0) }
+        let head = bytes[..<7001].withUnsafeBufferPointer { Adler32.checksum($0) }
+        let tail = bytes[7001...].withUnsafeBufferPointer { Adler32.checksum($0) }
+        XCTAssertEqual(Adler32.combine(head, tail, length: bytes.count - 7001), whole)
+    }
+}
+
+/// Deterministic byte source for test images.
+private struct SeededBytes {
+    var state: UInt32
+    init(seed: UInt32) { state = seed }
+    mutating func next() -> UInt8 {
+        state = state &* 1_664_525 &+ 1_013_904_223
+        return UInt8(truncatingIfNeeded: state >> 24)
+    }
+}
+
+/// Minimal PNG reader for the encoder's output: 8-bit RGBA or gray, stored and
+/// fixed-Huffman deflate blocks only. Verifies chunk CRCs and the zlib Adler-32.
+private struct DecodedPNG {
+    struct DecodeError: Error { let reason: String }
+
+    var width = 0
+    var height = 0
+    var colorType = 0
+    var idatCount = 0
+    var pixels: [UInt8] = []
+
+    init(_ png: Data) throws {
+        let bytes = [UInt8](png)
+        guard bytes.starts(with: PNGEncoder.signature) else { throw DecodeError(reason: "signature") }
+        func be32(_ at: Int) -> Int { Int(bytes[at]) << 24 | Int(bytes[at + 1]) << 16 | Int(bytes[at + 2]) << 8 | Int(bytes[at + 3]) }
+        var stream: [UInt8] = []
+        var offset = 8
+        var sawEnd = false
+        while offset < bytes.count {
+            let length = be32(offset)
+            let type = String(decoding: bytes[(offset + 4)..<(offset + 8)], as: UTF8.self)
+            let payload = Array(bytes[(offset + 8)..<(offset + 8 + length)])
+            let crc = CRC32.update(0xFFFF_FFFF, bytes[(offset + 4)..<(offset + 8 + length)]) ^ 0xFFFF_FFFF
+            guard crc == UInt32(be32(offset + 8 + length)) else { throw DecodeError(reason: "\(type) CRC") }
+            switch type {
+            case "IHDR":
+                width = be32(offset + 8)
+                height = be32(offset + 12)
+                colorType = Int(payload[9])
+            case "IDAT":
+                stream += payload
+                idatCount += 1
+            case "IEND":
+                sawEnd = true
+            default:
+                break
+            }
+            offset += 12 + length
+        }
+        guard sawEnd, stream.count > 6, (Int(stream[0]) << 8 | Int(stream[1])) % 31 == 0 else { throw DecodeError(reason: "zlib header") }
+        var inflater = Inflater(bytes: Array(stream.dropFirst(2)))
+        let filtered = try inflater.inflate()
+        var a: UInt32 = 1, b: UInt32 = 0
+        for byte in filtered { a = (a + UInt32(byte)) % 65521; b = (b + a) % 65521 }
+        let trailer = stream.suffix(4).reduce(UInt32(0)) { $0 << 8 | UInt32($1) }
+        guard trailer == b << 16 | a else { throw DecodeError(reason: "adler32") }
+
+        let bpp = colorType == 6 ? 4 : 1
+        let rowBytes = width * bpp
+        guard filtered.count == height * (rowBytes + 1) else { throw DecodeError(reason: "length") }
+        var previous = [UInt8](repeating: 0, count: rowBytes)
+        for y in 0..<height {
+            let start = y * (rowBytes + 1)
+            let filter = filtered[start]
+            var row = Array(filtered[(start + 1)...(start + rowBytes)])
+            for i in 0..<rowBytes {
+                let a = i >= bpp ? Int(row[i - bpp]) : 0
+                let b = Int(previous[i])
+                let c = i >= bpp ? Int(previous[i - bpp]) : 0
+                let predictor: Int
+                switch filter {
+                case 0: predictor = 0
+                case 1: predictor = a
+                case 2: predictor = b
+                case 3: predictor = (a + b) / 2
+                case 4:
+                    let p = a + b - c
+                    let pa = abs(p - a), pb = abs(p - b), pc = abs(p - c)
+                    predictor = pa <= pb && pa <= pc ? a : (pb <= pc ? b : c)
+                default: throw DecodeError(reason: "filter \(filter)")
+                }
+                row[i] = row[i] &+ UInt8(predictor)
+            }
+            pixels += row
+            previous = row
+        }
+    }
+}
+
+private struct Inflater {
+    private static let lengthBase = [3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258]
+    private static let lengthExtra = [0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0]
+    private static let distanceBase = [1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577]
+    private static let distanceExtra = [0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13]
+
+    let bytes: [UInt8]
+    var position = 0
+
+    mutating func bits(_ count: Int) -> Int {
+        var value = 0
+        for i in 0..<count {
+            value |= Int((bytes[position >> 3] >> UInt8(position & 7)) & 1) << i
+            position += 1
+        }
+        return value
+    }
+
+    /// Huffman codes are packed most significant bit first.
+    mutating func code(_ count: Int, after prefix: Int = 0) -> Int {
+        var value = prefix
+        for _ in 0..<count { value = value << 1 | bits(1) }
+        return value
+    }
+
+    mutating func fixedSymbol() -> Int {
+        let seven = code(7)
+        if seven <= 0x17 { return 256 + seven }
+        let eight = code(1, after: seven)
+        if eight >= 0x30 && eight <= 0xBF { return eight - 0x30 }
+        if eight >= 0xC0 && eight <= 0xC7 { return 280 + eight - 0xC0 }
+        return code(1, after: eight) - 0x190 + 144
+    }
+
+    mutating func inflate() throws -> [UInt8] {
+        var out: [UInt8] = []
+        var isFinal = false
+        while !isFinal {
+            isFinal = bits(1) == 1
+            switch bits(2) {
+            case 0:
+                position = (position + 7) & ~7
+                let at = position >> 3
+                let length = Int(bytes[at]) | Int(bytes[at + 1]) << 8
+                guard length ^ 0xFFFF == Int(bytes[at + 2]) | Int(bytes[at + 3]) << 8 else {
+                    throw DecodedPNG.DecodeError(reason: "stored length")
+                }
+                out += bytes[(at + 4)..<(at + 4 + length)]
+                position = (at + 4 + length) << 3
+            case 1:
+                while true {
+                    let symbol = fixedSymbol()
+                    if symbol < 256 {
+                        out.append(UInt8(symbol))
+                        continue
+                    }
+                    if symbol == 256 { break }
+                    let lengthCode = symbol - 257
+                    let length = Self.lengthBase[lengthCode] + bits(Self.lengthExtra[lengthCode])
+                    let distanceCode = code(5)
+                    let distance = Self.distanceBase[distanceCode] + bits(Self.distanceExtra[distanceCode])
+                    guard distance <= out.count else { throw DecodedPNG.DecodeError(reason: "distance") }
+                    for _ in 0..<length { out.append(out[out.count - distance]) }
+                }
+            default:
+                throw DecodedPNG.DecodeError(reason: "block type")
+            }
+        }
+        return out
+    }
+}
@@ -0,0 +1,90 @@
+import XCTest
+@testable import SDLKit
+
+final class ProfilerTests: XCTestCase {
+    override func tearDown() {
+        SDLProfiler.isEnabled = false
+        SDLProfiler.reset()
+        super.tearDown()
+    }
+
+    func testZonesRecordOnlyWhileEnabled() {
+        SDLProfiler.isEnabled = false
+        SDLProfiler.reset()
+        SDLProfiler.begin("test.disabled").end()
+        XCTAssertEqual(SDLProfiler.eventCount, 0)
+
+        SDLProfiler.isEnabled = true
+        let value = SDLProfiler.zone("test.enabled") { 42 }
+        XCTAssertEqual(value, 42)
+        XCTAssertEqual(SDLProfiler.eventCount, 1)
+    }
+
+    func testThreadBufferWrapsKeepingNewestInOrder() {
+        let buffer = ProfilerThreadBuffer(threadID: 99, threadName: "wrap")
+        let total = SDLProfiler.eventsPerThread + 10
+        for i in 0..<total {
+            buffer.append(ProfilerEvent(name: "test.wrap", detail: nil, start: UInt64(i + 1), end: UInt64(i + 2)))
+        }
+        let events = buffer.snapshot()
+        XCTAssertEqual(events.count, SDLProfiler.eventsPerThread)
+        XCTAssertEqual(events.first?.start, 11)
+        XCTAssertEqual(events.last?.start, UInt64(total))
+        buffer.clear()
+        XCTAssertEqual(buffer.count, 0)
+    }
+
+    func testChromeTraceSeparatesThreads() throws {
+        SDLProfiler.reset()
+        SDLProfiler.isEnabled = true
+        let main = SDLProfiler.begin("test.main", detail: "/agent/health")
+        main.end()
+
+        let done = expectation(description: "worker")
+        let worker = Thread {
+            SDLProfiler.zone("test.worker") { Thread.sleep(forTimeInterval: 0.001) }
+            done.fulfill()
+        }
+        worker.name = "ProfilerTests.Worker"
+        worker.start()
+        wait(for: [done], timeout: 5)
+
+        let object = try JSONSerialization.jsonObject(with: SDLProfiler.chromeTraceJSON()) as? [String: Any]
+        let events = object?["traceEvents"] as? [[String: Any]] ?? []
+        let zones = events.filter { $0["ph"] as? String == "X" }
+        let mainZone = zones.first { $0["name"] as? String == "test.main" }
+        let workerZone = zones.first { $0["name"] as? String == "test.worker" }
+        XCTAssertEqual(mainZone?["cat"] as? String, "test")
+        XCTAssertEqual((mainZone?["args"] as? [String: Any])?["detail"] as? String, "/agent/health")
+        XCTAssertGreaterThan(workerZone?["dur"] as? Double ?? 0, 0)
+        let mainTid = mainZone?["tid"] as? Int
+        let workerTid = workerZone?["tid"] as? Int
+        XCTAssertNotNil(workerTid)
+        XCTAssertNotEqual(mainTid, workerTid)
+
+        let names = events.filter { $0["ph"] as? String == "M" && $0["tid"] as? Int == workerTid }
+        XCTAssertEqual((names.first?["args"] as? [String: Any])?["name"] as? String, "ProfilerTests.Worker")
+    }
+
+    func testTraceEndpointReturnsCaptureAndAppliesFlags() async throws {
+        try await MainActor.run {
+            SDLProfiler.reset()
+            SDLProfiler.isEnabled = true
+            let agent = SDLKitJSONAgent()
+            let endpoint = SDLKitJSONAgent.Endpoint.profilerTrace.rawValue
+            _ = agent.handle(path: SDLKitJSONAgent.Endpoint.health.rawValue, body: Data())
+
+            let url = FileManager.default.temporaryDirectory.appendingPathComponent("sdlkit-trace-\(UUID().uuidString).json")
+            defer { try? FileManager.default.removeItem(at: url) }
+            // A client-supplied path is ignored: the trace is only returned in the body.
+            let body = try JSONSerialization.data(withJSONObject: ["path": url.path, "reset": true, "enable": false])
+            let data = agent.handle(path: endpoint, body: body)
+            let object = try JSONSerialization.jsonObject(with: data) as? [String: Any]
+            let events = object?["traceEvents"] as? [[String: Any]] ?? []
+            let handled = events.first { $0["name"] as? String == "agent.handle" }
+            XCTAssertEqual((handled?["args"] as? [String: Any])?["detail"] as? String, SDLKitJSONAgent.Endpoint.health.rawValue)
+            XCTAssertFalse(FileManager.default.fileExists(atPath: url.path))
+            XCTAssertFalse(SDLProfiler.isEnabled)
+        }
+    }
+}
@@ -0,0 +1,26 @@
+import XCTest
+@testable import SDLKit
+
+final class RequestAffinityTests: XCTestCase {
+    func testEndpointsAreClassifiedByWhatTheyTouch() {
+        let empty = Data()
+        XCTAssertEqual(SDLKitJSONAgent.affinity(path: "/health", body: empty), .pure)
+        XCTAssertEqual(SDLKitJSONAgent.affinity(path: "/openapi.yaml", body: empty), .pure)
+        XCTAssertEqual(SDLKitJSONAgent.affinity(path: "/agent/audio/capture/read", body: Data(#"{"audio_id": 3, "frames": 64}"#.utf8)), .audioSession(3))
+        XCTAssertEqual(SDLKitJSONAgent.affinity(path: "/agent/audio/capture/read", body: Data("{}".utf8)), .main, "undecodable bodies report their error from main")
+        XCTAssertEqual(SDLKitJSONAgent.affinity(path: "/agent/gui/drawRectangle", body: empty), .main)
+        XCTAssertEqual(SDLKitJSONAgent.affinity(path: "/agent/gui/window/open", body: empty), .main)
+    }
+
+    func testOffMainResponsesDoNotNeedTheMainActor() throws {
+        let health = SDLKitJSONAgent.respondOffMain(path: "/health", body: Data())
+        XCTAssertEqual(health.contentType, "application/json")
+        XCTAssertEqual(try JSONSerialization.jsonObject(with: health.body) as? [String: Bool], ["ok": true])
+
+        let unknown = SDLKitJSONAgent.respondOffMain(path: "/nope", body: Data())
+        XCTAssertTrue(String(decoding: unknown.body, as: UTF8.self).contains("invalid_endpoint"))
+
+        let missing = SDLKitJSONAgent.respondOffMain(path: "/agent/audio/capture/read", body: Data(#"{"audio_id": 999, "frames": 8}"#.utf8))
+        XCTAssertTrue(String(decoding: missing.body, as: UTF8.self).contains("invalid_argument"))
+    }
+}
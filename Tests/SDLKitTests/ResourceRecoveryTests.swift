@@ -0,0 +1,49 @@
+import XCTest
+@testable import SDLKit
+
+@MainActor
+final class ResourceRecoveryTests: XCTestCase {
+    func testPoliciesAndBudgetAccounting() throws {
+        let budget = ShadowCopyBudget(limitBytes: 64)
+        let ledger = ResourceRecoveryLedger(component: "test", budget: budget)
+        let kept = ResourceHandle.buffer(BufferHandle())
+        let tooLarge = ResourceHandle.buffer(BufferHandle())
+        let regenerated = ResourceHandle.texture(TextureHandle())
+        let dropped = ResourceHandle.texture(TextureHandle())
+
+        ledger.track(kept, byteCount: 48, policy: .shadowCopy) { [Data(repeating: 1, count: 48)] }
+        var copied = false
+        ledger.track(tooLarge, byteCount: 32, policy: .shadowCopy) { copied = true; return [Data(count: 32)] }
+        ledger.track(regenerated, byteCount: 16, policy: .regenerate { [Data([7]), Data([8])] }) { XCTFail("not copied"); return [] }
+        ledger.track(dropped, byteCount: 16, policy: .discard) { XCTFail("not copied"); return [] }
+
+        XCTAssertFalse(copied, "over-budget contents are never copied")
+        XCTAssertEqual(budget.usedBytes, 48)
+        XCTAssertEqual(budget.deniedBytes, 32)
+        XCTAssertEqual(ledger.stats, .init(shadowCopyCount: 1, shadowCopyBytes: 48, regenerateCount: 1, discardCount: 2,
+                                           shadowCopyDowngradeCount: 1))
+
+        XCTAssertEqual(ledger.recoveryContents(for: kept), [Data(repeating: 1, count: 48)])
+        XCTAssertEqual(ledger.recoveryContents(for: regenerated), [Data([7]), Data([8])])
+        XCTAssertNil(ledger.recoveryContents(for: dropped))
+        XCTAssertNil(ledger.recoveryContents(for: tooLarge))
+        XCTAssertNil(ledger.recoveryContents(for: .buffer(BufferHandle())), "untracked resources come back empty silently")
+        XCTAssertEqual(Set(ledger.takeDiscarded()), [dropped, tooLarge])
+        XCTAssertTrue(ledger.takeDiscarded().isEmpty)
+
+        try ledger.setPolicy(.discard, for: kept)
+        XCTAssertEqual(budget.usedBytes, 0, "leaving .shadowCopy frees the copy")
+        XCTAssertThrowsError(try ledger.setPolicy(.shadowCopy, for: kept))
+        ledger.release(dropped)
+        XCTAssertEqual(ledger.stats.discardCount, 2)
+    }
+
+    func testFailedRegenerationIsReportedAsDiscarded() {
+        struct Failure: Error {}
+        let ledger = ResourceRecoveryLedger(component: "test", budget: ShadowCopyBudget(limitBytes: 0))
+        let handle = ResourceHandle.buffer(BufferHandle())
+        ledger.track(handle, byteCount: 4, policy: .regenerate { throw Failure() }) { [] }
+        XCTAssertNil(ledger.recoveryContents(for: handle))
+        XCTAssertEqual(ledger.takeDiscarded(), [handle])
+    }
+}
@@ -38,7 +38,7 @@ final class SDLKitScreenshotTests: XCTestCase {
         XCTAssertEqual(decoded.format, "PNG")
     }
 
-    func testPNGScreenshotNotImplementedErrorDetails() async throws {
+    func testPNGScreenshotErrorsPassThrough() async throws {
         let fallback = Self.fallbackRaw()
         let response = try await MainActor.run { () -> Data in
             let agent = SDLKitJSONAgent(agent: MockScreenshotAgent(raw: fallback, png: .failure(.notImplemented)))
@@ -47,7 +47,23 @@ final class SDLKitScreenshotTests: XCTestCase {
         }
         let error = try JSONDecoder().decode(ErrorEnvelope.self, from: response)
         XCTAssertEqual(error.error.code, "not_implemented")
-        XCTAssertEqual(error.error.details, "PNG screenshots require SDL_image; retry with format \"raw\".")
+        XCTAssertNil(error.error.details, "PNG encoding is in-process; no SDL_image hint")
+    }
+
+    func testPNGEndpointReturnsFileBytes() async throws {
+        let fallback = Self.fallbackRaw()
+        let (png, missing) = try await MainActor.run { () -> (SDLKitJSONAgent.Response, SDLKitJSONAgent.Response) in
+            let agent = SDLKitJSONAgent(agent: MockScreenshotAgent(raw: fallback, png: .failure(.notImplemented)))
+            let path = SDLKitJSONAgent.Endpoint.screenshotPNG.rawValue
+            let png = agent.respond(path: path, body: try JSONEncoder().encode(RawReq(window_id: 2)))
+            let missing = agent.respond(path: path, body: try JSONEncoder().encode(RawReq(window_id: 404)))
+            return (png, missing)
+        }
+        XCTAssertEqual(png.contentType, "image/png")
+        XCTAssertEqual([UInt8](png.body.prefix(8)), PNGEncoder.signature)
+        XCTAssertEqual(missing.contentType, "application/json")
+        let error = try JSONDecoder().decode(ErrorEnvelope.self, from: missing.body)
+        XCTAssertEqual(error.error.code, "window_not_found")
     }
 
     private static func fallbackRaw() -> SDLRenderer.RawScreenshot {
@@ -70,6 +86,14 @@ private final class MockScreenshotAgent: SDLKitGUIAgent {
         return raw
     }
 
+    override func screenshotPNGData(windowId: Int) throws -> Data {
+        guard windowId != 404 else { throw AgentError.windowNotFound }
+        let pixels = [UInt8](repeating: 0xFF, count: 4 * 4 * 4)
+        return try pixels.withUnsafeBytes {
+            try PNGEncoder.encode(width: 4, height: 4, bytesPerRow: 16, layout: .rgba8Unorm, pixels: $0)
+        }
+    }
+
     override func screenshotPNG(windowId: Int) throws -> SDLRenderer.PNGScreenshot {
         switch png {
         case .success(let shot):
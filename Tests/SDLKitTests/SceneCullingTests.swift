@@ -0,0 +1,134 @@
+import XCTest
+@testable import SDLKit
+
+final class SceneCullingTests: XCTestCase {
+    @MainActor
+    private static func makeCamera() -> Camera {
+        Camera(view: float4x4.lookAt(eye: (0, 0, 5), center: (0, 0, 0), up: (0, 1, 0)),
+               projection: float4x4.perspective(fovYRadians: .pi / 3, aspect: 1, zNear: 0.1, zFar: 100))
+    }
+
+    func testBoundingBoxTransform() {
+        let box = BoundingBox(min: SIMD3(-1, -1, -1), max: SIMD3(1, 1, 1))
+        let moved = box.transformed(by: float4x4.translation(x: 3, y: 0, z: -2))
+        XCTAssertEqual(moved.min, SIMD3(2, -1, -3))
+        XCTAssertEqual(moved.max, SIMD3(4, 1, -1))
+        let rotated = box.transformed(by: float4x4.rotationZ(.pi / 4))
+        XCTAssertEqual(rotated.max.x, Float(2).squareRoot(), accuracy: 1e-5)
+        XCTAssertEqual(rotated.max.z, 1, accuracy: 1e-6)
+    }
+
+    func testFrustumClassification() async throws {
+        let frustum = await MainActor.run { Self.makeCamera().frustum }
+        let unit = BoundingBox(min: SIMD3(-0.5, -0.5, -0.5), max: SIMD3(0.5, 0.5, 0.5))
+        XCTAssertEqual(frustum.classify(unit), .inside)
+        XCTAssertEqual(frustum.classify(unit.transformed(by: .translation(x: 0, y: 0, z: 10))), .outside)
+        XCTAssertEqual(frustum.classify(unit.transformed(by: .translation(x: 40, y: 0, z: 0))), .outside)
+        XCTAssertEqual(frustum.classify(unit.transformed(by: .translation(x: 0, y: 0, z: -200))), .outside)
+        XCTAssertEqual(frustum.classify(BoundingBox(min: SIMD3(-50, -0.5, -0.5), max: SIMD3(50, 0.5, 0.5))), .intersecting)
+    }
+
+    // Whether any part of the unit cube lands inside the clip volume of `mvp`: not every
+    // corner is outside the same clip plane.
+    private static func cubeMayBeVisible(_ mvp: float4x4) -> Bool {
+        var corners: [SIMD4<Float>] = []
+        for x in [-0.5, 0.5] as [Float] { for y in [-0.5, 0.5] as [Float] { for z in [-0.5, 0.5] as [Float] {
+            corners.append(mvp.transform(SIMD4(x, y, z, 1)))
+        } } }
+        let outside: [(SIMD4<Float>) -> Bool] = [
+            { $0.x < -$0.w }, { $0.x > $0.w }, { $0.y < -$0.w }, { $0.y > $0.w }, { $0.z < 0 }, { $0.z > $0.w }
+        ]
+        return !outside.contains { test in corners.allSatisfy(test) }
+    }
+
+    func testCullingAgreesWithTheUploadedTransform() async throws {
+        try await MainActor.run {
+            let window = SDLWindow(config: .init(title: "Cull", width: 64, height: 64))
+            let backend = try RecordingRenderBackend(window: window)
+            SceneGraphRenderer.resetPipelineCache()
+            let mesh = try MeshFactory.makeLitCube(backend: backend, size: 1.0)
+            let material = Material(shader: ShaderID("basic_lit"))
+            let root = SceneNode(name: "Root")
+            for i in 0..<32 {
+                let x = Float(i % 8 - 4) * 3, z = Float(i / 8) * -6 + 3
+                root.addChild(SceneNode(name: "Cube\(i)", transform: .translation(x: x, y: 0, z: z), mesh: mesh, material: material))
+            }
+            let camera = Camera(view: float4x4.lookAt(eye: (2, 1, 8), center: (0, 0, -4), up: (0, 1, 0)),
+                                projection: float4x4.perspective(fovYRadians: .pi / 4, aspect: 1.5, zNear: 0.5, zFar: 30))
+            var scene = Scene(root: root, camera: camera)
+
+            // Unculled, every draw's uploaded transform says whether the cube is on screen.
+            scene.cullingEnabled = false
+            try SceneGraphRenderer.updateAndRender(scene: scene, backend: backend)
+            XCTAssertEqual(backend.drawnTransforms.count, 32)
+            let onScreen = backend.drawnTransforms.filter(Self.cubeMayBeVisible).count
+            XCTAssertGreaterThan(onScreen, 0)
+            XCTAssertLessThan(onScreen, 32)
+
+            scene.cullingEnabled = true
+            backend.drawnTransforms.removeAll()
+            try SceneGraphRenderer.updateAndRender(scene: scene, backend: backend)
+            XCTAssertEqual(SceneGraphRenderer.lastCullingStats.visibleCount, onScreen)
+            XCTAssertTrue(backend.drawnTransforms.allSatisfy(Self.cubeMayBeVisible))
+        }
+    }
+
+    func testBVHRefitAndRebuild() {
+        let bvh = SceneBVH()
+        let owners = (0..<4).map { _ in NSObject() }
+        let ids = owners.map { ObjectIdentifier($0) }
+        var bounds = (0..<4).map { i in
+            BoundingBox(min: SIMD3(Float(i), 0, 0), max: SIMD3(Float(i) + 1, 1, 1))
+        }
+        XCTAssertTrue(bvh.update(ids: ids, bounds: bounds).rebuilt)
+        let unchanged = bvh.update(ids: ids, bounds: bounds)
+        XCTAssertFalse(unchanged.refitted || unchanged.rebuilt)
+        bounds[1].max.x += 0.1
+        XCTAssertTrue(bvh.update(ids: ids, bounds: bounds).refitted)
+        bounds[0] = bounds[0].transformed(by: .translation(x: 1000, y: 0, z: 0))
+        XCTAssertTrue(bvh.update(ids: ids, bounds: bounds).rebuilt)
+        XCTAssertEqual(bvh.rebuildCount, 2)
+    }
+
+    func testRendererCullsOffscreenNodes() async throws {
+        try await MainActor.run {
+            let window = SDLWindow(config: .init(title: "Cull", width: 64, height: 64))
+            let backend = try RecordingRenderBackend(window: window)
+            SceneGraphRenderer.resetPipelineCache()
+            let mesh = try MeshFactory.makeLitCube(backend: backend, size: 1.0)
+            let material = Material(shader: ShaderID("basic_lit"))
+            let root = SceneNode(name: "Root")
+            var nodes: [SceneNode] = []
+            for i in 0..<64 {
+                let node = SceneNode(name: "Cube\(i)",
+                                     transform: .translation(x: Float(i - 32) * 3, y: 0, z: 0),
+                                     mesh: mesh,
+                                     material: material)
+                root.addChild(node)
+                nodes.append(node)
+            }
+            var scene = Scene(root: root, camera: Self.makeCamera())
+
+            try SceneGraphRenderer.updateAndRender(scene: scene, backend: backend)
+            var stats = SceneGraphRenderer.lastCullingStats
+            XCTAssertEqual(stats.drawableCount, 64)
+            XCTAssertTrue(stats.bvhRebuilt)
+            XCTAssertGreaterThan(stats.visibleCount, 0)
+            XCTAssertGreaterThan(stats.culledCount, 32)
+            XCTAssertEqual(stats.visibleCount + stats.culledCount, 64)
+            XCTAssertEqual(backend.drawCallCount, stats.visibleCount)
+
+            nodes[0].localTransform = .translation(x: 0, y: 0, z: -1)
+            try SceneGraphRenderer.updateAndRender(scene: scene, backend: backend)
+            let previousVisible = stats.visibleCount
+            stats = SceneGraphRenderer.lastCullingStats
+            XCTAssertTrue(stats.bvhRefitted || stats.bvhRebuilt)
+            XCTAssertEqual(stats.visibleCount, previousVisible + 1)
+
+            scene.cullingEnabled = false
+            try SceneGraphRenderer.updateAndRender(scene: scene, backend: backend)
+            XCTAssertEqual(SceneGraphRenderer.lastCullingStats.visibleCount, 64)
+            XCTAssertEqual(SceneGraphRenderer.lastCullingStats.culledCount, 0)
+        }
+    }
+}
@@ -29,9 +29,8 @@ final class SceneGraphComputeInteropTests: XCTestCase {
                 let scene = Scene(root: root, camera: Camera.identity(aspect: aspect))
 
                 for _ in 0..<180 {
-                    try SceneGraphRenderer.updateAndRender(scene: scene, backend: backend, beforeRender: {
-                        try SceneGraphComputeInterop.dispatchCompute(backend: backend, resources: resources)
-                    })
+                    try SceneGraphComputeInterop.dispatchCompute(backend: backend, resources: resources)
+                    try SceneGraphRenderer.updateAndRender(scene: scene, backend: backend)
                 }
             }
         } catch let skip as XCTSkip {
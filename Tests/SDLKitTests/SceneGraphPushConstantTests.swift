@@ -3,7 +3,7 @@ import XCTest
 @testable import SDLKit
 
 @MainActor
-private final class RecordingRenderBackend: RenderBackend {
+final class RecordingRenderBackend: RenderBackend, RenderStateCounting {
     private struct BufferResource { var data: Data; var usage: BufferUsage }
     private struct TextureResource { var descriptor: TextureDescriptor; var data: TextureInitialData? }
     private struct MeshResource {
@@ -19,12 +19,20 @@ private final class RecordingRenderBackend: RenderBackend {
     private var meshes: [MeshHandle: MeshResource] = [:]
     private var pipelines: [PipelineHandle: GraphicsPipelineDescriptor] = [:]
     private var frameActive = false
+    private var bindTracker = RenderBindTracker()
 
     var deviceEventHandler: RenderBackendDeviceEventHandler?
 
     var drawCallCount = 0
     var lastBindings: BindingSet?
     var lastPushConstants: [Float]?
+    var drawnMeshes: [MeshHandle] = []
+    var drawnTransforms: [float4x4] = []
+    var spilledBindingSets = 0
+    var heapBackedPayloads = 0
+    let recordingArena = FrameArena()
+    var frameArena: FrameArena? { recordingArena }
+    var stateCounters: RenderStateCounters { bindTracker.counters }
 
     required init(window: SDLWindow) throws {
         _ = window
@@ -33,6 +41,8 @@ private final class RecordingRenderBackend: RenderBackend {
     func beginFrame() throws {
         guard !frameActive else { throw AgentError.internalError("beginFrame called twice") }
         frameActive = true
+        bindTracker.beginFrame()
+        recordingArena.reset()
     }
 
     func endFrame() throws {
@@ -113,8 +123,14 @@ private final class RecordingRenderBackend: RenderBackend {
         guard frameActive else { throw AgentError.internalError("draw outside beginFrame/endFrame") }
         guard meshes[mesh] != nil else { throw AgentError.internalError("Unknown mesh handle") }
         guard pipelines[pipeline] != nil else { throw AgentError.internalError("Unknown pipeline handle") }
-        _ = transform
         drawCallCount += 1
+        drawnMeshes.append(mesh)
+        drawnTransforms.append(transform)
+        if !bindings.isInline { spilledBindingSets += 1 }
+        if let payload = bindings.materialConstants, !payload.isArenaBacked { heapBackedPayloads += 1 }
+        _ = bindTracker.needsPipeline(pipeline)
+        _ = bindTracker.needsResources(bindings)
+        _ = bindTracker.needsVertexBuffers(mesh)
         lastBindings = bindings
         if let payload = bindings.materialConstants {
             payload.withUnsafeBytes { bytes in
@@ -13,5 +13,38 @@ final class SettingsStoreTests: XCTestCase {
         SettingsStore.setBool("unit.test.bool", false)
         XCTAssertEqual(SettingsStore.getBool("unit.test.bool"), false)
     }
+
+    private final class Recorder: @unchecked Sendable {
+        private let lock = NSLock()
+        private var _batches: [[String: String]] = []
+        var batches: [[String: String]] { lock.lock(); defer { lock.unlock() }; return _batches }
+        func record(_ batch: [String: String]) { lock.lock(); _batches.append(batch); lock.unlock() }
+    }
+
+    func testWritesCoalesceIntoOneBatchUntilFlushed() {
+        let recorder = Recorder()
+        // A delay no test run reaches, so only the flush can commit.
+        let cache = SettingsCache(backend: .init(load: { [:] }, commit: { recorder.record($0) }), commitDelay: 3600)
+        for i in 0..<100 { cache.set("unit.test.counter", String(i)) }
+        cache.set("unit.test.other", "x")
+        XCTAssertEqual(cache.get("unit.test.counter"), "99", "reads see writes before they commit")
+        cache.flush()
+        XCTAssertEqual(recorder.batches, [["unit.test.counter": "99", "unit.test.other": "x"]])
+        XCTAssertEqual(cache.commits, 1)
+    }
+
+    func testFirstReadLoadsOnceAndKeepsEarlierWrites() {
+        let loads = Recorder()
+        let cache = SettingsCache(backend: .init(load: {
+            loads.record([:])
+            return ["unit.test.a": "disk", "unit.test.b": "disk"]
+        }, commit: { _ in }))
+        cache.set("unit.test.b", "memory")
+        XCTAssertEqual(cache.get("unit.test.a"), "disk")
+        XCTAssertEqual(cache.get("unit.test.b"), "memory")
+        XCTAssertEqual(cache.snapshot().count, 2)
+        XCTAssertEqual(loads.batches.count, 1)
+        cache.flush()
+    }
 }
 
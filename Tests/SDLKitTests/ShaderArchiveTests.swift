@@ -0,0 +1,63 @@
+import XCTest
+@testable import SDLKit
+
+final class ShaderArchiveTests: XCTestCase {
+    func testRoundTripSlicesBlobsInPlace() throws {
+        let spirv = Data([0x03, 0x02, 0x23, 0x07, 1, 2, 3])
+        let dxil = Data(repeating: 0xAB, count: 33)
+        let packed = try ShaderArchive.encode(["spirv/a.vert.spv": spirv, "dxil/a_vs.dxil": dxil])
+        let archive = try ShaderArchive(data: packed)
+
+        XCTAssertEqual(archive.names, ["dxil/a_vs.dxil", "spirv/a.vert.spv"])
+        let blob = try XCTUnwrap(archive.blob(named: "spirv/a.vert.spv"))
+        XCTAssertEqual(blob, spirv)
+        XCTAssertEqual((blob.startIndex - packed.startIndex) % ShaderArchive.alignment, 0, "blobs start aligned")
+        XCTAssertEqual(try archive.blob(named: "dxil/a_vs.dxil"), dxil)
+        XCTAssertNil(try archive.blob(named: "metal/a.metallib"))
+
+        let artifact = ShaderArtifact(name: "spirv/a.vert.spv", url: nil, archive: archive)
+        XCTAssertEqual(try artifact.data(), spirv)
+    }
+
+    func testRejectsCorruptArchives() throws {
+        var packed = try ShaderArchive.encode(["spirv/a.comp.spv": Data([1, 2, 3, 4])])
+        packed[packed.count - ShaderArchive.alignment] ^= 0xFF
+        let archive = try ShaderArchive(data: packed)
+        XCTAssertThrowsError(try archive.blob(named: "spirv/a.comp.spv"), "hash mismatch")
+
+        XCTAssertThrowsError(try ShaderArchive(data: Data("not a pack".utf8)))
+        var truncated = try ShaderArchive.encode(["dxil/a_cs.dxil": Data(count: 64)])
+        truncated.removeLast(32)
+        XCTAssertThrowsError(try ShaderArchive(data: truncated), "blob past end of file")
+        XCTAssertThrowsError(try ShaderArchive.encode([String(repeating: "x", count: 80): Data()]))
+    }
+
+    func testGeneratedArchiveMatchesCommittedPayloads() throws {
+        let root = URL(fileURLWithPath: #filePath)
+            .deletingLastPathComponent().deletingLastPathComponent().deletingLastPathComponent()
+            .appendingPathComponent("Sources/SDLKit/Generated", isDirectory: true)
+        guard let archive = try ShaderArchive.open(at: root.appendingPathComponent(ShaderArchive.fileName)) else {
+            throw XCTSkip("shaders.pack has not been generated; run Scripts/ShaderBuild/pack_shaders.py")
+        }
+        for name in archive.names {
+            let expected = try Self.packedSource(compiled: root.appendingPathComponent(name),
+                                                 payload: root.appendingPathComponent(name + ".b64"))
+            XCTAssertEqual(try archive.blob(named: name), expected, name)
+        }
+    }
+
+    /// The bytes pack_shaders.py selects for an artifact: the compiled file when it is at
+    /// least as new as its .b64 payload, otherwise the decoded payload.
+    private static func packedSource(compiled: URL, payload: URL) throws -> Data? {
+        func modified(_ url: URL) -> Date? {
+            (try? FileManager.default.attributesOfItem(atPath: url.path))?[.modificationDate] as? Date
+        }
+        let payloadDate = modified(payload)
+        if let compiledDate = modified(compiled), payloadDate.map({ compiledDate >= $0 }) ?? true {
+            return try Data(contentsOf: compiled)
+        }
+        guard payloadDate != nil else { return nil }
+        let encoded = try String(contentsOf: payload, encoding: .utf8).filter { !$0.isWhitespace }
+        return Data(base64Encoded: encoded)
+    }
+}
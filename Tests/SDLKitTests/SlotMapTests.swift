@@ -0,0 +1,71 @@
+import XCTest
+@testable import SDLKit
+
+final class SlotMapTests: XCTestCase {
+    func testSwapRemoveKeepsHandlesResolvingAndRetiresTheRemovedOne() {
+        var map = SlotMap<BufferHandle, String>()
+        let a = map.insert("a")
+        let b = map.insert("b")
+        let c = map.insert("c")
+        XCTAssertEqual(map.count, 3)
+        XCTAssertEqual(Array(map.values), ["a", "b", "c"], "values are dense, in insertion order")
+
+        XCTAssertEqual(map.removeValue(forKey: a), "a")
+        XCTAssertNil(map[a])
+        XCTAssertTrue(map.isStale(a))
+        XCTAssertEqual(map.missingDescription(a), "Destroyed")
+        XCTAssertEqual(map[b], "b")
+        XCTAssertEqual(map[c], "c", "the swapped-in last value still resolves")
+        XCTAssertNil(map.removeValue(forKey: a), "removing twice is a no-op")
+
+        let d = map.insert("d")
+        XCTAssertEqual(d.rawValue & 0xFFFF_FFFF, a.rawValue & 0xFFFF_FFFF, "the freed slot is reused")
+        XCTAssertNotEqual(d, a)
+        XCTAssertNil(map[a], "a stale handle never aliases the slot's new resource")
+        XCTAssertEqual(map[d], "d")
+        XCTAssertEqual(Set(map.keys), [b, c, d])
+        XCTAssertEqual(Set(map.map { $0.value }), ["b", "c", "d"])
+    }
+
+    func testForeignHandlesDoNotResolve() {
+        var mine = SlotMap<TextureHandle, Int>()
+        var other = SlotMap<TextureHandle, Int>()
+        let handle = mine.insert(1)
+        let foreign = other.insert(2)
+
+        XCTAssertNil(mine[TextureHandle()])
+        XCTAssertNil(mine[TextureHandle(rawValue: 0)])
+        XCTAssertFalse(mine.isStale(TextureHandle(rawValue: UInt64.max)))
+        XCTAssertEqual(mine.missingDescription(TextureHandle(rawValue: UInt64.max)), "Unknown")
+        if foreign != handle {
+            XCTAssertNil(mine[foreign])
+            XCTAssertNil(mine.removeValue(forKey: foreign))
+        }
+        XCTAssertEqual(mine[handle], 1)
+    }
+
+    func testSnapshotClearAndRestoreUnderTheSameHandles() {
+        var map = SlotMap<PipelineHandle, Int>()
+        let handles = (0..<4).map { map.insert($0) }
+        let snapshot = map.mapValues { $0 * 10 }
+        XCTAssertEqual(snapshot[handles[2]], 20)
+
+        map.removeAll(keepingCapacity: true)
+        XCTAssertTrue(map.isEmpty)
+        XCTAssertTrue(map.isStale(handles[0]), "a cleared handle reads as destroyed until it is restored")
+
+        let fresh = map.insert(99)
+        XCTAssertFalse(handles.contains(fresh), "cleared slots stay reserved for their old handles")
+        for (handle, value) in snapshot where value != 30 {
+            map[handle] = value
+        }
+        XCTAssertEqual(map[handles[0]], 0)
+        XCTAssertEqual(map[handles[2]], 20)
+        XCTAssertNil(map[handles[3]], "a handle that is not restored stays unresolved")
+        XCTAssertEqual(map[fresh], 99)
+        XCTAssertEqual(map.count, 4)
+
+        let built = map.insert { handle in Int(truncatingIfNeeded: handle.rawValue) }
+        XCTAssertEqual(map[built], Int(truncatingIfNeeded: built.rawValue), "values can record their own handle")
+    }
+}
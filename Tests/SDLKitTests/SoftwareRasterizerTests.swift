@@ -0,0 +1,195 @@
+import XCTest
+@testable import SDLKit
+
+final class SoftwareRasterizerTests: XCTestCase {
+    private struct Target {
+        let width: Int
+        let height: Int
+        var color: Data
+        var depth: Data
+        var rasterizer = SoftwareRasterizer()
+
+        init(width: Int, height: Int) {
+            self.width = width
+            self.height = height
+            color = Data(count: width * height * 4)
+            depth = Data(count: width * height * MemoryLayout<Float>.size)
+            color.withUnsafeMutableBytes { c in depth.withUnsafeMutableBytes { d in SoftwareRasterizer.clear(color: c, depth: d) } }
+            rasterizer.beginFrame(width: width, height: height)
+        }
+
+        /// Position + color triangles (`unlit_triangle` layout), non-indexed.
+        @discardableResult
+        mutating func draw(_ vertices: [Float],
+                           shading: SoftwareRasterizer.Shading = .unlit,
+                           constants: SoftwareRasterizer.DrawConstants = .init(mvp: .identity),
+                           depthTest: Bool = true,
+                           layout: VertexLayout = SoftwareRasterizerTests.unlitLayout) -> Int {
+            let material = SoftwareRasterizer.Material(shading: shading, constants: constants, depthTest: depthTest)
+            return vertices.withUnsafeBytes { raw in
+                rasterizer.submit(vertices: raw, layout: layout, vertexCount: raw.count / layout.stride,
+                                  indices: nil, indexFormat: .uint16, indexCount: 0, material: material)
+            }
+        }
+
+        mutating func flush() {
+            color.withUnsafeMutableBytes { c in depth.withUnsafeMutableBytes { d in rasterizer.flush(color: c, depth: d) } }
+        }
+
+        /// (r, g, b, a) at a pixel; the target is BGRA8.
+        func pixel(_ x: Int, _ y: Int) -> [UInt8] {
+            let offset = (y * width + x) * 4
+            return [color[offset + 2], color[offset + 1], color[offset], color[offset + 3]]
+        }
+    }
+
+    static let unlitLayout = VertexLayout(
+        stride: MemoryLayout<Float>.size * 6,
+        attributes: [
+            .init(index: 0, semantic: "POSITION", format: .float3, offset: 0),
+            .init(index: 1, semantic: "COLOR", format: .float3, offset: MemoryLayout<Float>.size * 3)
+        ]
+    )
+
+    private static let clear: [UInt8] = [13, 13, 20, 255]
+
+    /// Two triangles covering the NDC rectangle [x0, x1] x [y0, y1] at depth z.
+    private func quad(_ x0: Float, _ y0: Float, _ x1: Float, _ y1: Float, z: Float, rgb: (Float, Float, Float)) -> [Float] {
+        let (r, g, b) = rgb
+        return [
+            x0, y0, z, r, g, b,  x1, y0, z, r, g, b,  x1, y1, z, r, g, b,
+            x0, y0, z, r, g, b,  x1, y1, z, r, g, b,  x0, y1, z, r, g, b
+        ]
+    }
+
+    func testTriangleCoversInteriorAndKeepsClearOutside() {
+        var target = Target(width: 32, height: 32)
+        // Lower-left half of the screen (NDC y up, so the bottom rows).
+        XCTAssertEqual(target.draw([-1, -1, 0.5, 1, 0, 0,  1, -1, 0.5, 1, 0, 0,  -1, 1, 0.5, 1, 0, 0]), 1)
+        target.flush()
+        XCTAssertEqual(target.pixel(2, 29), [255, 0, 0, 255])
+        XCTAssertEqual(target.pixel(29, 2), Self.clear)
+    }
+
+    func testBaseColorModulatesUnlitOutput() {
+        var target = Target(width: 8, height: 8)
+        var constants = SoftwareRasterizer.DrawConstants(mvp: .identity)
+        constants.baseColor = SIMD4(0.5, 1, 0, 1)
+        target.draw(quad(-1, -1, 1, 1, z: 0.5, rgb: (1, 1, 1)), constants: constants)
+        target.flush()
+        XCTAssertEqual(target.pixel(4, 4), [128, 255, 0, 255])
+    }
+
+    func testDepthTestKeepsNearestRegardlessOfOrder() {
+        var target = Target(width: 16, height: 16)
+        target.draw(quad(-1, -1, 1, 1, z: 0.2, rgb: (0, 1, 0)))
+        target.draw(quad(-1, -1, 1, 1, z: 0.8, rgb: (1, 0, 0)))
+        target.flush()
+        XCTAssertEqual(target.pixel(8, 8), [0, 255, 0, 255])
+
+        var unsorted = Target(width: 16, height: 16)
+        unsorted.draw(quad(-1, -1, 1, 1, z: 0.8, rgb: (1, 0, 0)), depthTest: false)
+        unsorted.draw(quad(-1, -1, 1, 1, z: 0.2, rgb: (0, 0, 1)), depthTest: false)
+        unsorted.flush()
+        XCTAssertEqual(unsorted.pixel(8, 8), [0, 0, 255, 255], "without depth testing the last draw wins")
+    }
+
+    func testSharedEdgesLeaveNoGapsAcrossTiles() {
+        // 200x130 spans several 64-pixel tiles in both directions.
+        var target = Target(width: 200, height: 130)
+        target.draw(quad(-1, -1, 1, 1, z: 0.5, rgb: (1, 1, 1)), depthTest: false)
+        target.flush()
+        var covered = 0
+        for y in 0..<target.height {
+            for x in 0..<target.width where target.pixel(x, y) == [255, 255, 255, 255] {
+                covered += 1
+            }
+        }
+        XCTAssertEqual(covered, target.width * target.height)
+    }
+
+    func testNearPlaneClipsTrianglesCrossingTheCamera() {
+        var target = Target(width: 32, height: 32)
+        // One vertex behind the near plane: the visible part is still drawn.
+        let kept = target.draw([-1, -1, 0.5, 1, 1, 1,  1, -1, 0.5, 1, 1, 1,  0, 1, -0.5, 1, 1, 1])
+        XCTAssertEqual(kept, 2, "clipping a single vertex leaves a quad")
+        XCTAssertEqual(target.draw([-1, -1, -0.1, 1, 1, 1,  1, -1, -0.1, 1, 1, 1,  0, 1, -0.1, 1, 1, 1]), 0)
+        target.flush()
+        XCTAssertEqual(target.pixel(16, 30), [255, 255, 255, 255])
+        XCTAssertEqual(target.pixel(16, 1), Self.clear)
+    }
+
+    func testLitShadingFollowsLambertContract() {
+        let layout = VertexLayout(
+            stride: MemoryLayout<Float>.size * 9,
+            attributes: [
+                .init(index: 0, semantic: "POSITION", format: .float3, offset: 0),
+                .init(index: 1, semantic: "NORMAL", format: .float3, offset: MemoryLayout<Float>.size * 3),
+                .init(index: 2, semantic: "COLOR", format: .float3, offset: MemoryLayout<Float>.size * 6)
+            ]
+        )
+        func litQuad(normal: (Float, Float, Float)) -> [Float] {
+            let v: [(Float, Float)] = [(-1, -1), (1, -1), (1, 1), (-1, -1), (1, 1), (-1, 1)]
+            return v.flatMap { [$0.0, $0.1, 0.5, normal.0, normal.1, normal.2, 1, 1, 1] }
+        }
+        var constants = SoftwareRasterizer.DrawConstants(mvp: .identity)
+        constants.lightDirection = SIMD3(0, 0, 2)
+
+        var facing = Target(width: 8, height: 8)
+        facing.draw(litQuad(normal: (0, 0, 1)), shading: .lit, constants: constants, layout: layout)
+        facing.flush()
+        XCTAssertEqual(facing.pixel(4, 4), [255, 255, 255, 255])
+
+        var away = Target(width: 8, height: 8)
+        away.draw(litQuad(normal: (0, 0, -1)), shading: .lit, constants: constants, layout: layout)
+        away.flush()
+        XCTAssertEqual(away.pixel(4, 4), [38, 38, 38, 255], "ambient term only")
+    }
+
+    func testScreenMappedTextureStretchesOverTarget() {
+        var target = Target(width: 8, height: 8)
+        // 2x2 texture: red, green / blue, white.
+        let texture = SoftwareRasterizer.Texture(width: 2, height: 2, isBGRA: false,
+                                                 texels: [255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255, 255, 255, 255, 255],
+                                                 mapping: .screen)
+        let material = SoftwareRasterizer.Material(shading: .unlit, constants: .init(mvp: .identity), depthTest: true, texture: texture)
+        quad(-1, -1, 1, 1, z: 0.5, rgb: (1, 1, 1)).withUnsafeBytes { raw in
+            _ = target.rasterizer.submit(vertices: raw, layout: Self.unlitLayout, vertexCount: 6,
+                                         indices: nil, indexFormat: .uint16, indexCount: 0, material: material)
+        }
+        target.flush()
+        XCTAssertEqual(target.pixel(1, 1), [255, 0, 0, 255])
+        XCTAssertEqual(target.pixel(6, 1), [0, 255, 0, 255])
+        XCTAssertEqual(target.pixel(1, 6), [0, 0, 255, 255])
+        XCTAssertEqual(target.pixel(6, 6), [255, 255, 255, 255])
+    }
+
+    func testConstantBlockMatchesSceneGraphPacking() {
+        let mvp = float4x4.translation(x: 1, y: 2, z: 3)
+        var bytes = [UInt8](repeating: 0, count: float4x4.packedByteCount + 32)
+        bytes.withUnsafeMutableBytes { raw in
+            mvp.write(to: raw.baseAddress!)
+            raw.storeBytes(of: SIMD4<Float>(0, 1, 0, 0), toByteOffset: float4x4.packedByteCount, as: SIMD4<Float>.self)
+            raw.storeBytes(of: SIMD4<Float>(0.25, 0.5, 0.75, 1), toByteOffset: float4x4.packedByteCount + 16, as: SIMD4<Float>.self)
+        }
+        var constants = SoftwareRasterizer.DrawConstants(mvp: .identity)
+        bytes.withUnsafeBytes { constants.load(from: $0) }
+        XCTAssertEqual(constants.mvp.c3, SIMD4(1, 2, 3, 1))
+        XCTAssertEqual(constants.lightDirection, SIMD3(0, 1, 0))
+        XCTAssertEqual(constants.baseColor, SIMD4(0.25, 0.5, 0.75, 1))
+    }
+
+    func testBenchmarkLitCubeGrid1080p() {
+        // 1080p frame of 400 overlapping quads exercises binning, depth and shading on all cores.
+        var vertices: [Float] = []
+        for i in 0..<400 {
+            let x = Float(i % 20) / 10 - 1, y = Float(i / 20) / 10 - 1
+            vertices += quad(x, y, x + 0.3, y + 0.3, z: Float(i % 7) / 8 + 0.05, rgb: (Float(i % 3) / 2, 0.5, 1))
+        }
+        measure {
+            var target = Target(width: 1920, height: 1080)
+            target.draw(vertices)
+            target.flush()
+        }
+    }
+}
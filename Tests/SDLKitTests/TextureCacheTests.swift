@@ -0,0 +1,62 @@
+import XCTest
+@testable import SDLKit
+
+final class TextureCacheTests: XCTestCase {
+    private func key(_ path: String, _ hash: UInt64 = 1) -> TextureCacheKey {
+        TextureCacheKey(path: path, contentHash: hash)
+    }
+
+    func testEvictsLeastRecentlyUsedOverBudget() {
+        var cache = TextureCache<Int>(byteBudget: 300)
+        XCTAssertTrue(cache.insert(1, bytes: 100, for: key("a")).isEmpty)
+        XCTAssertTrue(cache.insert(2, bytes: 100, for: key("b")).isEmpty)
+        XCTAssertTrue(cache.insert(3, bytes: 100, for: key("c")).isEmpty)
+        XCTAssertEqual(cache.lookup(key("a")), 1)
+
+        let evicted = cache.insert(4, bytes: 150, for: key("d"))
+        XCTAssertEqual(evicted.map { $0.handle }, [2, 3], "b and c were used least recently")
+        XCTAssertEqual(cache.residentBytes, 250)
+        XCTAssertTrue(cache.contains(key("a")))
+        XCTAssertNil(cache.lookup(key("b")))
+
+        XCTAssertEqual(cache.setByteBudget(100).map { $0.key }, [key("a"), key("d")])
+        XCTAssertEqual(cache.count, 0)
+    }
+
+    func testOversizedEntryStaysUntilDisplaced() {
+        var cache = TextureCache<Int>(byteBudget: 100)
+        XCTAssertTrue(cache.insert(1, bytes: 500, for: key("huge")).isEmpty)
+        XCTAssertEqual(cache.lookup(key("huge")), 1)
+        XCTAssertEqual(cache.insert(2, bytes: 10, for: key("small")).map { $0.handle }, [1])
+        XCTAssertEqual(cache.residentBytes, 10)
+    }
+
+    func testContentHashSeparatesFileVersions() throws {
+        var cache = TextureCache<Int>(byteBudget: 1 << 20)
+        let old = key("hero.png", TextureCacheKey.contentHash(of: Data("v1".utf8)))
+        let new = key("hero.png", TextureCacheKey.contentHash(of: Data("v2".utf8)))
+        XCTAssertNotEqual(old, new)
+        _ = cache.insert(1, bytes: 10, for: old)
+        XCTAssertNil(cache.lookup(new))
+        XCTAssertEqual(cache.insert(2, bytes: 10, for: old).map { $0.handle }, [1], "reinserting a key releases the previous handle")
+        XCTAssertEqual(cache.remove(old), 2)
+        XCTAssertEqual(cache.residentBytes, 0)
+
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("texture-cache-\(UUID().uuidString).bin")
+        defer { try? FileManager.default.removeItem(at: url) }
+        let bytes = Data((0..<37).map { UInt8($0) })
+        try bytes.write(to: url)
+        XCTAssertEqual(try TextureCacheKey.forFile(atPath: url.path).contentHash, TextureCacheKey.contentHash(of: bytes))
+        XCTAssertThrowsError(try TextureCacheKey.forFile(atPath: url.path + ".missing"))
+    }
+
+    func testDecodeInboxRefusesPostsAfterClose() {
+        let inbox = TextureDecodeInbox()
+        XCTAssertTrue(inbox.post(.init(id: "a", generation: 1, key: nil, surface: nil, error: "x")))
+        XCTAssertTrue(inbox.post(.init(id: "b", generation: 2, key: nil, surface: nil, error: "y")))
+        XCTAssertEqual(inbox.next()?.id, "a")
+        XCTAssertEqual(inbox.close().map(\.id), ["b"])
+        XCTAssertFalse(inbox.post(.init(id: "c", generation: 3, key: nil, surface: nil, error: nil)))
+        XCTAssertNil(inbox.next())
+    }
+}
@@ -0,0 +1,91 @@
+import XCTest
+@testable import SDLKit
+
+final class VectorGeometryTests: XCTestCase {
+    /// Total area of the batch's triangles, from the x, y of each indexed vertex.
+    private static func area(_ batch: VectorBatch) -> Float {
+        func point(_ index: Int32) -> SIMD2<Float> {
+            let base = Int(index) * VectorBatch.floatsPerVertex
+            return SIMD2(batch.vertices[base], batch.vertices[base + 1])
+        }
+        var total: Float = 0
+        for t in 0..<batch.triangleCount {
+            let a = point(batch.indices[3 * t]), b = point(batch.indices[3 * t + 1]), c = point(batch.indices[3 * t + 2])
+            total += abs((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y)) / 2
+        }
+        return total
+    }
+
+    func testFilledCircleIsOneFanWithinTolerance() {
+        var batch = VectorBatch(feather: 0)
+        let segments = batch.segmentCount(radius: 40, sweep: 2 * .pi)
+        batch.fillCircle(cx: 50, cy: 50, radius: 40, color: 0xFF00FF00)
+        XCTAssertEqual(batch.vertexCount, segments)
+        XCTAssertEqual(batch.triangleCount, segments - 2)
+        XCTAssertEqual(Self.area(batch), .pi * 1600, accuracy: .pi * 1600 * 0.01)
+        XCTAssertEqual(Array(batch.vertices[2..<6]), [0, 1, 0, 1], "vertex colors are normalized RGBA")
+
+        batch.removeAll()
+        batch.feather = 1
+        batch.fillCircle(cx: 50, cy: 50, radius: 40, color: 0xFF00FF00)
+        XCTAssertEqual(batch.vertexCount, 2 * segments, "feathering adds a transparent outer ring")
+        XCTAssertEqual(batch.triangleCount, segments - 2 + 2 * segments)
+        XCTAssertEqual(batch.vertices[segments * VectorBatch.floatsPerVertex + 5], 0)
+    }
+
+    func testThickPolylineUsesMiterJoins() {
+        var batch = VectorBatch(feather: 0)
+        batch.strokePolyline([SIMD2(0, 0), SIMD2(10, 0), SIMD2(10, 10)], thickness: 4, color: 0xFFFFFFFF)
+        XCTAssertEqual(batch.vertexCount, 6)
+        XCTAssertEqual(batch.triangleCount, 4)
+        func assertVertex(_ i: Int, _ x: Float, _ y: Float, _ message: String) {
+            XCTAssertEqual(batch.vertices[i * 8], x, accuracy: 1e-4, message)
+            XCTAssertEqual(batch.vertices[i * 8 + 1], y, accuracy: 1e-4, message)
+        }
+        assertVertex(1, 12, -2, "outer corner of the miter")
+        assertVertex(4, 8, 2, "inner corner of the miter")
+        XCTAssertEqual(Self.area(batch), 80, accuracy: 0.01)
+
+        batch.removeAll()
+        batch.feather = 1
+        batch.strokeCircle(cx: 0, cy: 0, radius: 20, thickness: 3, color: 0xFFFFFFFF)
+        let n = batch.segmentCount(radius: 20, sweep: 2 * .pi)
+        XCTAssertEqual(batch.vertexCount, 4 * n)
+        XCTAssertEqual(batch.triangleCount, 6 * n)
+
+        batch.removeAll()
+        batch.strokePolyline([SIMD2(0, 0), SIMD2(10, 0)], thickness: 0.5, color: 0xFFFFFFFF)
+        XCTAssertEqual(batch.triangleCount, 4, "hairlines are fringe only")
+        XCTAssertEqual(batch.vertices[2 * 8 + 5], 0.5, accuracy: 1e-6, "and fade with their width")
+    }
+
+    func testRoundedRectsArcsAndDegenerateInput() {
+        var batch = VectorBatch(feather: 0)
+        batch.fillRoundedRect(x: 0, y: 0, width: 20, height: 10, radius: 0, color: 0xFFFFFFFF)
+        XCTAssertEqual(batch.vertexCount, 4)
+        XCTAssertEqual(Self.area(batch), 200, accuracy: 1e-3)
+
+        batch.removeAll()
+        batch.fillRoundedRect(x: 0, y: 0, width: 40, height: 40, radius: 50, color: 0xFFFFFFFF)
+        XCTAssertEqual(Self.area(batch), .pi * 400, accuracy: .pi * 400 * 0.03, "radius clamps to a circle")
+
+        batch.removeAll()
+        batch.fillArc(cx: 0, cy: 0, radius: 10, startDegrees: 0, endDegrees: 90, color: 0xFFFFFFFF)
+        XCTAssertEqual(Self.area(batch), .pi * 25, accuracy: .pi * 25 * 0.03)
+
+        batch.removeAll()
+        batch.strokePolyline([SIMD2(1, 1), SIMD2(1, 1)], thickness: 2, color: 0xFFFFFFFF)
+        batch.fillPolygon([SIMD2(0, 0), SIMD2(5, 0), SIMD2(10, 0)], color: 0xFFFFFFFF)
+        batch.fillCircle(cx: 0, cy: 0, radius: 0, color: 0xFFFFFFFF)
+        XCTAssertTrue(batch.isEmpty)
+    }
+
+    func testBuffersAreReusedAcrossFrames() {
+        var batch = VectorBatch()
+        for i in 0..<1000 { batch.fillCircle(cx: Float(i), cy: 10, radius: 6, color: 0xFF336699) }
+        let capacity = batch.vertices.capacity
+        batch.removeAll()
+        XCTAssertTrue(batch.isEmpty)
+        XCTAssertEqual(batch.vertices.capacity, capacity)
+    }
+}